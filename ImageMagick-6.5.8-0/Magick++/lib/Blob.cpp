@@ -35,21 +35,23 @@ Magick::Blob::Blob ( const Magick::Blob& blob_ )
   : _blobRef(blob_._blobRef)
 {
   // Increase reference count
-  Lock( &_blobRef->_mutexLock );
-  ++_blobRef->_refCount;
+  _blobRef->_refCount.increment();
 }
 
+#if defined(MagickCplusPlusMoveSupported)
+// Move constructor (takes over reference)
+Magick::Blob::Blob ( Magick::Blob&& blob_ )
+  : _blobRef(blob_._blobRef)
+{
+  // Leave the moved-from blob empty, as the default constructor does
+  blob_._blobRef=new Magick::BlobRef( 0, 0 );
+}
+#endif
+
 // Destructor (reference counted)
 Magick::Blob::~Blob ()
 {
-  bool doDelete = false;
-  {
-    Lock( &_blobRef->_mutexLock );
-    if ( --_blobRef->_refCount == 0 )
-      doDelete = true;
-  }
-
-  if ( doDelete )
+  if ( _blobRef && _blobRef->_refCount.decrement() == 0 )
     {
       // Delete old blob reference with associated data
       delete _blobRef;
@@ -62,17 +64,8 @@ Magick::Blob& Magick::Blob::operator= ( const Magick::Blob& blob_ )
 {
   if(this != &blob_)
     {
-      {
-        Lock( &blob_._blobRef->_mutexLock );
-        ++blob_._blobRef->_refCount;
-      }
-      bool doDelete = false;
-      {
-        Lock( &_blobRef->_mutexLock );
-        if ( --_blobRef->_refCount == 0 )
-          doDelete = true;
-      }
-      if ( doDelete )
+      blob_._blobRef->_refCount.increment();
+      if ( _blobRef && _blobRef->_refCount.decrement() == 0 )
         {
           delete _blobRef;
         }
@@ -81,6 +74,17 @@ Magick::Blob& Magick::Blob::operator= ( const Magick::Blob& blob_ )
   return *this;
 }
 
+#if defined(MagickCplusPlusMoveSupported)
+// Move assignment operator (exchanges references)
+Magick::Blob& Magick::Blob::operator= ( Magick::Blob&& blob_ ) throw()
+{
+  BlobRef *blobRef = _blobRef;
+  _blobRef = blob_._blobRef;
+  blob_._blobRef = blobRef;
+  return *this;
+}
+#endif
+
 // Update object contents from Base64-encoded string representation.
 void Magick::Blob::base64 ( const std::string base64_ )
 {
@@ -116,13 +120,7 @@ std::string Magick::Blob::base64 ( void )
 // Any existing data in the object is deallocated.
 void Magick::Blob::update ( const void* data_, size_t length_ )
 {
-  bool doDelete = false;
-  {
-    Lock( &_blobRef->_mutexLock );
-    if ( --_blobRef->_refCount == 0 )
-      doDelete = true;
-  }
-  if ( doDelete )
+  if ( _blobRef && _blobRef->_refCount.decrement() == 0 )
     {
       // Delete old blob reference with associated data
       delete _blobRef;
@@ -138,13 +136,7 @@ void Magick::Blob::update ( const void* data_, size_t length_ )
 void Magick::Blob::updateNoCopy ( void* data_, size_t length_,
                                   Magick::Blob::Allocator allocator_  )
 {
-  bool doDelete = false;
-  {
-    Lock( &_blobRef->_mutexLock );
-    if ( --_blobRef->_refCount == 0 )
-      doDelete = true;
-  }
-  if ( doDelete )
+  if ( _blobRef && _blobRef->_refCount.decrement() == 0 )
     {
       // Delete old blob reference with associated data
       delete _blobRef;
@@ -114,6 +114,30 @@ Magick::Color::Color ( const Magick::Color & color_ )
   *_pixel    = *color_._pixel;
 }
 
+#if defined(MagickCplusPlusMoveSupported)
+// Move constructor
+Magick::Color::Color ( Magick::Color && color_ )
+  : _pixel( color_._pixel ),
+    _pixelOwn( color_._pixelOwn ),
+    _isValid( color_._isValid ),
+    _pixelType( color_._pixelType )
+{
+  if ( _pixelOwn )
+    {
+      // Take over the pixel the source allocated
+      color_._pixel = 0;
+      color_._pixelOwn = false;
+    }
+  else
+    {
+      // Source refers to an image pixel, so copy its value
+      _pixel = new PixelPacket;
+      _pixelOwn = true;
+      *_pixel = *color_._pixel;
+    }
+}
+#endif
+
 // Construct from color expressed as C++ string
 Magick::Color::Color ( const std::string &x11color_ )
   : _pixel(new PixelPacket),
@@ -177,6 +201,13 @@ Magick::Color& Magick::Color::operator = ( const Magick::Color& color_ )
   // If not being set to ourself
   if ( this != &color_ )
     {
+      // Moved-from colors have no pixel
+      if ( _pixel == 0 )
+        {
+          _pixel = new PixelPacket;
+          _pixelOwn = true;
+        }
+
       // Copy pixel value
       *_pixel = *color_._pixel;
 
@@ -189,6 +220,27 @@ Magick::Color& Magick::Color::operator = ( const Magick::Color& color_ )
   return *this;
 }
 
+#if defined(MagickCplusPlusMoveSupported)
+// Move assignment operator
+Magick::Color& Magick::Color::operator = ( Magick::Color && color_ )
+{
+  // Exchange pixels only when both colors own them.  A color that
+  // refers to an image pixel must keep writing through to the image.
+  if ( this != &color_ && color_._pixelOwn && ( _pixelOwn || _pixel == 0 ) )
+    {
+      PixelPacket *pixel = _pixel;
+      _pixel = color_._pixel;
+      color_._pixel = pixel;
+      color_._pixelOwn = ( pixel != 0 );
+      _pixelOwn = true;
+      _isValid = color_._isValid;
+      _pixelType = color_._pixelType;
+      return *this;
+    }
+  return operator=( static_cast<const Color&>( color_ ) );
+}
+#endif
+
 // Set color via X11 color specification string
 const Magick::Color& Magick::Color::operator = ( const std::string &x11color_ )
 {
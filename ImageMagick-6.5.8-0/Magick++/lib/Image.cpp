@@ -284,14 +284,7 @@ Magick::Image::Image( void )
 /* virtual */
 Magick::Image::~Image()
 {
-  bool doDelete = false;
-  {
-    Lock( &_imgRef->_mutexLock );
-    if ( --_imgRef->_refCount == 0 )
-      doDelete = true;
-  }
-
-  if ( doDelete )
+  if ( _imgRef && _imgRef->_refCount.decrement() == 0 )
     {
       delete _imgRef;
     }
@@ -705,6 +698,13 @@ void Magick::Image::convolve ( const unsigned int order_,
 void Magick::Image::crop ( const Geometry &geometry_ )
 {
   RectangleInfo cropInfo = geometry_;
+  if ( deferred() )
+    {
+      if ( AppendCropOperation( operations(), &cropInfo ) == MagickFalse )
+        throwExceptionExplicit( ResourceLimitError,
+                                "Unable to record deferred operation" );
+      return;
+    }
   ExceptionInfo exceptionInfo;
   GetExceptionInfo( &exceptionInfo );
   MagickCore::Image* newImage =
@@ -1112,12 +1112,51 @@ void Magick::Image::fx ( const std::string expression,
   (void) DestroyExceptionInfo( &exceptionInfo );
 }
 
+// Record a gamma correction, parsing the levels as GammaImage() does
+void Magick::Image::deferGamma ( const char *gamma_ )
+{
+  GeometryInfo geometry_info;
+  MagickStatusType flags = ParseGeometry( gamma_, &geometry_info );
+  double red = geometry_info.rho;
+  double green = red;
+  if ( (flags & SigmaValue) != 0 )
+    green = geometry_info.sigma;
+  double blue = red;
+  if ( (flags & XiValue) != 0 )
+    blue = geometry_info.xi;
+  if ( (red == 1.0) && (green == 1.0) && (blue == 1.0) )
+    return;
+
+  MagickBooleanType status;
+  if ( (red == green) && (green == blue) )
+    status = AppendGammaOperation( operations(),
+      static_cast<MagickCore::ChannelType>(RedChannel | GreenChannel |
+        BlueChannel), red );
+  else
+    {
+      status = AppendGammaOperation( operations(), RedChannel, red );
+      if ( status != MagickFalse )
+        status = AppendGammaOperation( operations(), GreenChannel, green );
+      if ( status != MagickFalse )
+        status = AppendGammaOperation( operations(), BlueChannel, blue );
+    }
+  if ( status == MagickFalse )
+    throwExceptionExplicit( ResourceLimitError,
+                            "Unable to record deferred operation" );
+}
+
 // Gamma correct image
 void Magick::Image::gamma ( const double gamma_ )
 {
   char gamma[MaxTextExtent + 1];
   FormatMagickString( gamma, MaxTextExtent, "%3.6f", gamma_);
 
+  if ( deferred() )
+    {
+      deferGamma( gamma );
+      return;
+    }
+
   modifyImage();
   GammaImage ( image(), gamma );
 }
@@ -1130,6 +1169,12 @@ void Magick::Image::gamma ( const double gammaRed_,
   FormatMagickString( gamma, MaxTextExtent, "%3.6f/%3.6f/%3.6f/",
 		gammaRed_, gammaGreen_, gammaBlue_);
 
+  if ( deferred() )
+    {
+      deferGamma( gamma );
+      return;
+    }
+
   modifyImage();
   GammaImage ( image(), gamma );
   throwImageException();
@@ -1222,9 +1267,27 @@ void Magick::Image::level ( const double black_point,
                             const double white_point,
                             const double gamma )
 {
-  modifyImage();
   char levels[MaxTextExtent];
   FormatMagickString( levels, MaxTextExtent, "%g,%g,%g",black_point,white_point,gamma);
+  if ( deferred() )
+    {
+      // Parse the levels as LevelImage() does
+      GeometryInfo geometry_info;
+      MagickStatusType flags = ParseGeometry( levels, &geometry_info );
+      double black = geometry_info.rho;
+      double white = (double) QuantumRange-black;
+      if ( (flags & SigmaValue) != 0 )
+        white = geometry_info.sigma;
+      double mid = 1.0;
+      if ( (flags & XiValue) != 0 )
+        mid = geometry_info.xi;
+      if ( AppendLevelOperation( operations(), DefaultChannels, black, white,
+                                 mid ) == MagickFalse )
+        throwExceptionExplicit( ResourceLimitError,
+                                "Unable to record deferred operation" );
+      return;
+    }
+  modifyImage();
   (void) LevelImage( image(), levels );
   throwImageException();
 }
@@ -1245,6 +1308,14 @@ void  Magick::Image::levelChannel ( const Magick::ChannelType channel,
                                     const double white_point,
                                     const double gamma )
 {
+  if ( deferred() )
+    {
+      if ( AppendLevelOperation( operations(), channel, black_point,
+                                 white_point, gamma ) == MagickFalse )
+        throwExceptionExplicit( ResourceLimitError,
+                                "Unable to record deferred operation" );
+      return;
+    }
   modifyImage();
   (void) LevelImageChannel( image(), channel, black_point, white_point,
                             gamma );
@@ -1352,6 +1423,14 @@ void            Magick::Image::motionBlur ( const double radius_,
 // only
 void Magick::Image::negate ( const bool grayscale_ )
 {
+  if ( deferred() )
+    {
+      if ( AppendNegateOperation( operations(), DefaultChannels,
+             grayscale_ == true ? MagickTrue : MagickFalse ) == MagickFalse )
+        throwExceptionExplicit( ResourceLimitError,
+                                "Unable to record deferred operation" );
+      return;
+    }
   modifyImage();
   NegateImage ( image(), grayscale_ == true ? MagickTrue : MagickFalse );
   throwImageException();
@@ -1715,9 +1794,31 @@ void Magick::Image::resize( const Geometry &geometry_ )
   // in the ImageMagick library.
   long x = 0;
   long y = 0;
-  unsigned long width = columns();
-  unsigned long height = rows();
+  unsigned long width;
+  unsigned long height;
+
+  if ( deferred() )
+    {
+      // Size the image will have, without running the operations
+      if ( GetImageOperationsSize( _imgRef->image(), _imgRef->_operations,
+                                   &width, &height ) == MagickFalse )
+        {
+          width = columns();
+          height = rows();
+        }
+      ParseMetaGeometry (static_cast<std::string>(geometry_).c_str(),
+                         &x, &y,
+                         &width, &height );
+      if ( AppendResizeOperation( operations(), width, height,
+                                  _imgRef->image()->filter,
+                                  1.0 ) == MagickFalse )
+        throwExceptionExplicit( ResourceLimitError,
+                                "Unable to record deferred operation" );
+      return;
+    }
 
+  width = columns();
+  height = rows();
   ParseMetaGeometry (static_cast<std::string>(geometry_).c_str(),
                      &x, &y,
                      &width, &height );
@@ -1860,6 +1961,14 @@ void Magick::Image::shade ( const double azimuth_,
 // Sharpen pixels in image
 void Magick::Image::sharpen ( const double radius_, const double sigma_ )
 {
+  if ( deferred() )
+    {
+      if ( AppendSharpenOperation( operations(), DefaultChannels, radius_,
+                                   sigma_ ) == MagickFalse )
+        throwExceptionExplicit( ResourceLimitError,
+                                "Unable to record deferred operation" );
+      return;
+    }
   ExceptionInfo exceptionInfo;
   GetExceptionInfo( &exceptionInfo );
   MagickCore::Image* newImage =
@@ -1875,6 +1984,14 @@ void Magick::Image::sharpen ( const double radius_, const double sigma_ )
 void Magick::Image::sharpenChannel ( const ChannelType channel_,
                                      const double radius_, const double sigma_ )
 {
+  if ( deferred() )
+    {
+      if ( AppendSharpenOperation( operations(), channel_, radius_,
+                                   sigma_ ) == MagickFalse )
+        throwExceptionExplicit( ResourceLimitError,
+                                "Unable to record deferred operation" );
+      return;
+    }
   ExceptionInfo exceptionInfo;
   GetExceptionInfo( &exceptionInfo );
   MagickCore::Image* newImage =
@@ -2757,6 +2874,29 @@ bool Magick::Image::debug ( void ) const
   return constOptions()->debug();
 }
 
+// Record operations instead of running them
+void Magick::Image::deferred ( const bool deferred_ )
+{
+  if ( deferred_ == deferred() )
+    return;
+
+  if ( deferred_ )
+    {
+      modifyImage();
+      _imgRef->_operations = AcquireOperationInfo();
+      return;
+    }
+
+  applyOperations();
+  modifyImage();
+  DestroyOperationInfo( _imgRef->_operations );
+  _imgRef->_operations = 0;
+}
+bool Magick::Image::deferred ( void ) const
+{
+  return _imgRef->_operations != 0;
+}
+
 // Tagged image format define (set/access coder-specific option) The
 // magick_ option specifies the coder the define applies to.  The key_
 // option provides the key specific to that coder.  The value_ option
@@ -3934,30 +4074,28 @@ double Magick::Image::yResolution ( void ) const
 Magick::Image::Image( const Image & image_ )
   : _imgRef(image_._imgRef)
 {
-  Lock( &_imgRef->_mutexLock );
-
   // Increase reference count
-  ++_imgRef->_refCount;
+  _imgRef->_refCount.increment();
 }
 
+#if defined(MagickCplusPlusMoveSupported)
+// Move constructor (takes over reference)
+Magick::Image::Image( Image && image_ )
+  : _imgRef(image_._imgRef)
+{
+  // Leave the moved-from image empty, as the default constructor does
+  image_._imgRef = new ImageRef;
+}
+#endif
+
 // Assignment operator
 Magick::Image& Magick::Image::operator=( const Magick::Image &image_ )
 {
   if( this != &image_ )
     {
-      {
-        Lock( &image_._imgRef->_mutexLock );
-        ++image_._imgRef->_refCount;
-      }
-
-      bool doDelete = false;
-      {
-        Lock( &_imgRef->_mutexLock );
-        if ( --_imgRef->_refCount == 0 )
-          doDelete = true;
-      }
+      image_._imgRef->_refCount.increment();
 
-      if ( doDelete )
+      if ( _imgRef && _imgRef->_refCount.decrement() == 0 )
         {
           // Delete old image reference with associated image and options.
           delete _imgRef;
@@ -3970,6 +4108,17 @@ Magick::Image& Magick::Image::operator=( const Magick::Image &image_ )
   return *this;
 }
 
+#if defined(MagickCplusPlusMoveSupported)
+// Move assignment operator (exchanges references)
+Magick::Image& Magick::Image::operator=( Magick::Image &&image_ ) throw()
+{
+  ImageRef *imgRef = _imgRef;
+  _imgRef = image_._imgRef;
+  image_._imgRef = imgRef;
+  return *this;
+}
+#endif
+
 //////////////////////////////////////////////////////////////////////    
 //
 // Low-level Pixel Access Routines
@@ -4134,10 +4283,14 @@ const Magick::Options* Magick::Image::constOptions( void ) const
 // Get MagickCore::Image*
 MagickCore::Image*& Magick::Image::image( void )
 {
+  if ( _imgRef->_operations )
+    applyOperations();
   return _imgRef->image();
 }
 const MagickCore::Image* Magick::Image::constImage( void ) const
 {
+  if ( _imgRef->_operations )
+    const_cast<Magick::Image*>(this)->applyOperations();
   return _imgRef->image();
 }
 
@@ -4174,22 +4327,27 @@ MagickCore::Image * Magick::Image::replaceImage
   else
     image = AcquireImage(constImageInfo());
 
-  {
-    Lock( &_imgRef->_mutexLock );
-
-    if ( _imgRef->_refCount == 1 )
-      {
-        // We own the image, just replace it, and de-register
-        _imgRef->id( -1 );
-        _imgRef->image(image);
-      }
-    else
-      {
-        // We don't own the image, dereference and replace with copy
-        --_imgRef->_refCount;
-        _imgRef = new ImageRef( image, constOptions() );
-      }
-  }
+  if ( _imgRef->_refCount.count() == 1 )
+    {
+      // We own the image, just replace it, and de-register.  Operations
+      // recorded for the old image do not apply to the new one.
+      _imgRef->id( -1 );
+      _imgRef->image(image);
+      if ( _imgRef->_operations )
+        ResetOperationInfo( _imgRef->_operations );
+    }
+  else
+    {
+      // We don't own the image, dereference and replace with copy.
+      // Other owners may have let go meanwhile, so the old reference
+      // is deleted if ours turns out to be the last.
+      ImageRef *imgRef = _imgRef;
+      _imgRef = new ImageRef( image, imgRef->options() );
+      if ( imgRef->_operations )
+        _imgRef->_operations = AcquireOperationInfo();
+      if ( imgRef->_refCount.decrement() == 0 )
+        delete imgRef;
+    }
 
   return _imgRef->_image;
 }
@@ -4200,15 +4358,12 @@ MagickCore::Image * Magick::Image::replaceImage
 //
 void Magick::Image::modifyImage( void )
 {
-  {
-    Lock( &_imgRef->_mutexLock );
-    if ( _imgRef->_refCount == 1 )
-      {
-        // De-register image and return
-        _imgRef->id( -1 );
-        return;
-      }
-  }
+  if ( _imgRef->_refCount.count() == 1 )
+    {
+      // De-register image and return
+      _imgRef->id( -1 );
+      return;
+    }
 
   ExceptionInfo exceptionInfo;
   GetExceptionInfo( &exceptionInfo );
@@ -4222,6 +4377,60 @@ void Magick::Image::modifyImage( void )
   return;
 }
 
+//
+// Run deferred operations.  Every holder of the reference sees the
+// same image, so the result replaces the shared image.
+//
+void Magick::Image::applyOperations( void )
+{
+  Lock lock( &_imgRef->_mutexLock );
+  if ( GetNumberOfOperations( _imgRef->_operations ) == 0 )
+    return;
+
+  ExceptionInfo exceptionInfo;
+  GetExceptionInfo( &exceptionInfo );
+  MagickCore::Image* newImage =
+    ApplyImageOperations( _imgRef->_image,
+                          _imgRef->_operations,
+                          &exceptionInfo );
+  ResetOperationInfo( _imgRef->_operations );
+  if ( newImage )
+    {
+      _imgRef->id( -1 );
+      _imgRef->image( newImage );
+    }
+  throwException( exceptionInfo );
+  (void) DestroyExceptionInfo( &exceptionInfo );
+}
+
+//
+// Prepare to record a deferred operation.  Copies the image as it
+// stands, with the operations recorded so far, if the reference is
+// shared.
+//
+MagickCore::OperationInfo* Magick::Image::operations( void )
+{
+  if ( _imgRef->_refCount.count() == 1 )
+    {
+      _imgRef->id( -1 );
+      return _imgRef->_operations;
+    }
+
+  ExceptionInfo exceptionInfo;
+  GetExceptionInfo( &exceptionInfo );
+  MagickCore::Image* image =
+    CloneImage( _imgRef->image(), 0, 0, MagickTrue, &exceptionInfo );
+  throwException( exceptionInfo );
+  (void) DestroyExceptionInfo( &exceptionInfo );
+
+  ImageRef *imgRef = _imgRef;
+  _imgRef = new ImageRef( image, imgRef->options() );
+  _imgRef->_operations = CloneOperationInfo( imgRef->_operations );
+  if ( imgRef->_refCount.decrement() == 0 )
+    delete imgRef;
+  return _imgRef->_operations;
+}
+
 //
 // Test for an ImageMagick reported error and throw exception if one
 // has been reported.  Secretly resets image->exception back to default
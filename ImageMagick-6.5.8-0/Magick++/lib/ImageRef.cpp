@@ -18,6 +18,7 @@
 Magick::ImageRef::ImageRef ( MagickCore::Image * image_ )
   : _image(image_),
     _options(new Options),
+    _operations(0),
     _id(-1),
     _refCount(1),
     _mutexLock()
@@ -30,6 +31,7 @@ Magick::ImageRef::ImageRef ( MagickCore::Image * image_,
 			     const Options * options_ )
   : _image(image_),
     _options(0),
+    _operations(0),
     _id(-1),
     _refCount(1),
     _mutexLock()
@@ -41,6 +43,7 @@ Magick::ImageRef::ImageRef ( MagickCore::Image * image_,
 Magick::ImageRef::ImageRef ( void )
   : _image(0),
     _options(new Options),
+    _operations(0),
     _id(-1),
     _refCount(1),
     _mutexLock()
@@ -71,6 +74,13 @@ Magick::ImageRef::~ImageRef( void )
       _image = 0;
     }
 
+  // Deallocate deferred operations
+  if ( _operations )
+    {
+      DestroyOperationInfo( _operations );
+      _operations = 0;
+    }
+
   // Deallocate image options
   delete _options;
   _options = 0;
@@ -36,12 +36,23 @@ namespace Magick
     // Copy constructor (reference counted)
     Blob ( const Blob& blob_ );
 
+#if defined(MagickCplusPlusMoveSupported)
+    // Move constructor (the moved-from blob is left empty, as if
+    // default constructed)
+    Blob ( Blob&& blob_ );
+#endif
+
     // Destructor (reference counted)
     virtual       ~Blob ();
 
     // Assignment operator (reference counted)
     Blob&         operator= ( const Blob& blob_ );
 
+#if defined(MagickCplusPlusMoveSupported)
+    // Move assignment operator
+    Blob&         operator= ( Blob&& blob_ ) throw();
+#endif
+
     // Update object contents from Base64-encoded string representation.
     void          base64 ( const std::string base64_ );
     // Return Base64-encoded string representation.
@@ -39,6 +39,11 @@ namespace Magick
     Color ( void );
     virtual        ~Color ( void );
     Color ( const Color & color_ );
+#if defined(MagickCplusPlusMoveSupported)
+    // Move constructor (the moved-from color may only be destroyed
+    // or assigned to)
+    Color ( Color && color_ );
+#endif
 
     // Red color (range 0 to MaxRGB)
     void           redQuantum ( Quantum red_ );
@@ -71,6 +76,10 @@ namespace Magick
 
     // Assignment operator
     Color& operator= ( const Color& color_ );
+#if defined(MagickCplusPlusMoveSupported)
+    // Move assignment operator
+    Color& operator= ( Color && color_ );
+#endif
 
     // Return X11 color specification string
     /* virtual */ operator std::string() const;
@@ -100,6 +100,15 @@ namespace Magick
     // Assignment operator
     Image& operator= ( const Image &image_ );
 
+#if defined(MagickCplusPlusMoveSupported)
+    // Move constructor (the moved-from image is left empty, as if
+    // default constructed)
+    Image ( Image && image_ );
+
+    // Move assignment operator
+    Image& operator= ( Image &&image_ ) throw();
+#endif
+
     //////////////////////////////////////////////////////////////////////
     //
     // Image operations
@@ -878,6 +887,14 @@ namespace Magick
     void            debug ( const bool flag_ );
     bool            debug ( void ) const;
 
+    // Record crop, resize, sharpen, level, gamma, and negate operations
+    // instead of running them.  The recorded operations run together the
+    // next time the image is used; crops are moved ahead of the other
+    // operations where the result allows it.  Disabling deferral runs any
+    // recorded operations.
+    void            deferred ( const bool deferred_ );
+    bool            deferred ( void ) const;
+
     // Tagged image format define (set/access coder-specific option) The
     // magick_ option specifies the coder the define applies to.  The key_
     // option provides the key specific to that coder.  The value_ option
@@ -1346,6 +1363,15 @@ typedef struct _ImageStatistics
     // Prepare to update image (copy if reference > 1)
     void            modifyImage ( void );
 
+    // Run deferred operations
+    void            applyOperations ( void );
+
+    // Record a gamma correction given as for GammaImage()
+    void            deferGamma ( const char *gamma_ );
+
+    // Prepare to record a deferred operation (copy if reference > 1)
+    MagickCore::OperationInfo * operations ( void );
+
     // Test for ImageMagick error and throw exception if error
     void            throwImageException( void ) const;
 
@@ -48,8 +48,9 @@ namespace Magick
     
     MagickCore::Image *   _image;    // ImageMagick Image
     Options *            _options;  // User-specified options
+    MagickCore::OperationInfo * _operations; // Deferred operations (0 if none)
     long                 _id;       // Registry ID (-1 if not registered)
-    int                  _refCount; // Reference count
+    ReferenceCount       _refCount; // Reference count
     MutexLock            _mutexLock;// Mutex lock
   };
 
@@ -112,6 +112,15 @@ namespace MagickCore
 #  pragma warning(disable : 4996) /* function deprecation warnings */
 #endif
 
+//
+// Rvalue references let Image, Blob, and Color hand over their
+// representation instead of copying it.
+//
+#if (__cplusplus >= 201103L) || defined(__GXX_EXPERIMENTAL_CXX0X__) || \
+    (defined(_MSC_VER) && (_MSC_VER >= 1600))
+#  define MagickCplusPlusMoveSupported
+#endif
+
 //
 // Import ImageMagick symbols and types which are used as part of the
 // Magick++ API definition into namespace "Magick".
@@ -525,8 +534,21 @@ namespace Magick
   //
   using MagickCore::AcquireCacheView;
   using MagickCore::AcquireExceptionInfo;
+  using MagickCore::AcquireOperationInfo;
+  using MagickCore::AppendCropOperation;
+  using MagickCore::AppendGammaOperation;
+  using MagickCore::AppendLevelOperation;
+  using MagickCore::AppendNegateOperation;
+  using MagickCore::AppendResizeOperation;
+  using MagickCore::AppendSharpenOperation;
+  using MagickCore::ApplyImageOperations;
+  using MagickCore::CloneOperationInfo;
+  using MagickCore::DestroyOperationInfo;
+  using MagickCore::GeometryInfo;
   using MagickCore::GetCacheViewVirtualPixels;
   using MagickCore::AcquireImage;
+  using MagickCore::GetImageOperationsSize;
+  using MagickCore::GetNumberOfOperations;
   using MagickCore::GetVirtualPixels;
   using MagickCore::AcquireIndexes;
   using MagickCore::AcquireMagickMemory;
@@ -771,6 +793,7 @@ namespace Magick
   using MagickCore::MagickCoreTerminus;
   using MagickCore::MagickInfo;
   using MagickCore::MagickPixelPacket;
+  using MagickCore::MagickStatusType;
   using MagickCore::MagickToMime;
   using MagickCore::MagickWand;
   using MagickCore::MagnifyImage;
@@ -798,9 +821,11 @@ namespace Magick
   using MagickCore::NoValue;
   using MagickCore::OilPaintImage;
   using MagickCore::OpaquePaintImage;
+  using MagickCore::OperationInfo;
   using MagickCore::OptionError;
   using MagickCore::OptionFatalError;
   using MagickCore::OptionWarning;
+  using MagickCore::ParseGeometry;
   using MagickCore::ParseMetaGeometry;
   using MagickCore::PercentValue;
   using MagickCore::PingBlob;
@@ -832,6 +857,7 @@ namespace Magick
   using MagickCore::RegistryWarning;
   using MagickCore::RelinquishMagickMemory;
   using MagickCore::RemapImage;
+  using MagickCore::ResetOperationInfo;
   using MagickCore::ResizeImage;
   using MagickCore::ResizeMagickMemory;
   using MagickCore::ResourceLimitError;
@@ -868,6 +894,7 @@ namespace Magick
   using MagickCore::SharpenImageChannel;
   using MagickCore::ShaveImage;
   using MagickCore::ShearImage;
+  using MagickCore::SigmaValue;
   using MagickCore::SigmoidalContrastImageChannel;
   using MagickCore::SignatureImage;
   using MagickCore::SolarizeImage;
@@ -903,6 +930,7 @@ namespace Magick
   using MagickCore::WaveImage;
   using MagickCore::WidthValue;
   using MagickCore::WriteImage;
+  using MagickCore::XiValue;
   using MagickCore::XNegative;
   using MagickCore::XServerError;
   using MagickCore::XServerFatalError;
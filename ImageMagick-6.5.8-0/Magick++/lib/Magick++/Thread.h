@@ -28,6 +28,13 @@ struct win32_mutex {
 # include <pthread.h>
 #endif // defined(MAGICKCORE_HAVE_PTHREAD)
 
+#if defined(__GNUC__) && ((__GNUC__ > 4) || \
+    ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 1)))
+# define MagickCplusPlusAtomicSupported
+#elif defined(_VISUALC_)
+# define MagickCplusPlusAtomicSupported
+#endif
+
 namespace Magick
 {
   // Mutex lock wrapper
@@ -81,6 +88,38 @@ namespace Magick
 
     MutexLock* _mutexLock;
   };
+
+  // Reference count shared by copy-on-write handles.  Updated with
+  // atomic operations where the compiler provides them so that
+  // copying, destroying, and testing ownership never takes a mutex.
+  class MagickDLLDecl ReferenceCount
+  {
+  public:
+    // Construct with initial count
+    ReferenceCount( const long count_ = 1 );
+
+    // Increment count and return the new count
+    long increment( void );
+
+    // Decrement count and return the new count
+    long decrement( void );
+
+    // Current count (acquire load)
+    long count( void ) const;
+
+  private:
+
+    // Don't support copy constructor
+    ReferenceCount ( const ReferenceCount& original_ );
+
+    // Don't support assignment
+    ReferenceCount& operator = ( const ReferenceCount& original_ );
+
+    volatile long      _count;
+#if !defined(MagickCplusPlusAtomicSupported)
+    mutable MutexLock  _mutexLock;
+#endif
+  };
 }
 
 // Construct with mutex lock (locks mutex)
@@ -97,4 +136,54 @@ inline Magick::Lock::~Lock( void )
   _mutexLock=0;
 }
 
+// Construct with initial count
+inline Magick::ReferenceCount::ReferenceCount( const long count_ )
+  : _count(count_)
+{
+}
+
+// Increment count and return the new count
+inline long Magick::ReferenceCount::increment( void )
+{
+#if defined(__GNUC__) && defined(MagickCplusPlusAtomicSupported)
+  return __sync_add_and_fetch( &_count, 1 );
+#elif defined(MagickCplusPlusAtomicSupported)
+  return InterlockedIncrement( &_count );
+#else
+  Lock lock( &_mutexLock );
+  return ++_count;
+#endif
+}
+
+// Decrement count and return the new count
+inline long Magick::ReferenceCount::decrement( void )
+{
+#if defined(__GNUC__) && defined(MagickCplusPlusAtomicSupported)
+  return __sync_sub_and_fetch( &_count, 1 );
+#elif defined(MagickCplusPlusAtomicSupported)
+  return InterlockedDecrement( &_count );
+#else
+  Lock lock( &_mutexLock );
+  return --_count;
+#endif
+}
+
+// Current count (acquire load)
+inline long Magick::ReferenceCount::count( void ) const
+{
+#if defined(__GNUC__) && defined(__ATOMIC_ACQUIRE)
+  return __atomic_load_n( &_count, __ATOMIC_ACQUIRE );
+#elif defined(__GNUC__) && defined(MagickCplusPlusAtomicSupported)
+  long count = _count;
+  __sync_synchronize();
+  return count;
+#elif defined(MagickCplusPlusAtomicSupported)
+  // Volatile reads have acquire semantics under Visual C++
+  return _count;
+#else
+  Lock lock( &_mutexLock );
+  return _count;
+#endif
+}
+
 #endif // Magick_Thread_header
@@ -53,6 +53,7 @@
 #include "magick/log.h"
 #include "magick/magick.h"
 #include "magick/memory_.h"
+#include "magick/property.h"
 #include "magick/resource_.h"
 #include "magick/quantum-private.h"
 #include "magick/static.h"
@@ -177,10 +178,6 @@ static Image *ReadDNGImage(const ImageInfo *image_info,ExceptionInfo *exception)
               XMLTreeInfo
                 *next;
 
-              if (image->properties == (void *) NULL)
-                ((Image *) image)->properties=NewSplayTree(
-                  CompareSplayTreeString,RelinquishMagickMemory,
-                  RelinquishMagickMemory);
               next=GetXMLTreeChild(ufraw,(const char *) NULL);
               while (next != (XMLTreeInfo *) NULL)
               {
@@ -195,9 +192,8 @@ static Image *ReadDNGImage(const ImageInfo *image_info,ExceptionInfo *exception)
                     (LocaleCompare(tag,"OutputFilename") != 0) &&
                     (LocaleCompare(tag,"OutputType") != 0) &&
                     (strlen(content) != 0))
-                  (void) AddValueToSplayTree((SplayTreeInfo *)
-                    ((Image *) image)->properties,ConstantString(property),
-                    content);
+                  (void) SetImageProperty(image,property,content);
+                content=DestroyString(content);
                 next=GetXMLTreeSibling(next);
               }
               ufraw=DestroyXMLTree(ufraw);
@@ -70,64 +70,69 @@
 */
 #define MaximumLZWBits  12
 #define MaximumLZWCode  (1UL << MaximumLZWBits)
+#define LZWBufferExtent  4096
+#define MaxHashTable  5003
 
 /*
   Typdef declarations.
 */
-typedef struct _LZWCodeInfo
-{
-  unsigned char
-    buffer[280];
-
-  unsigned long
-    count,
-    bit;
-
-  MagickBooleanType
-    eof;
-} LZWCodeInfo;
-
-typedef struct _LZWStack
-{
-  unsigned long
-    *codes,
-    *index,
-    *top;
-} LZWStack;
-
 typedef struct _LZWInfo
 {
   Image
     *image;
 
-  LZWStack
-    *stack;
+  unsigned char
+    buffer[LZWBufferExtent+256];
+
+  size_t
+    offset,
+    length,
+    block_length;
+
+  unsigned long
+    datum,
+    bits;
 
   MagickBooleanType
-    genesis;
+    eof;
 
   unsigned long
     data_size,
     maximum_data_value,
     clear_code,
     end_code,
-    bits,
-    first_code,
-    last_code,
+    code_size,
     maximum_code,
-    slot,
-    *table[2];
+    slot;
+
+  long
+    last_code;
 
-  LZWCodeInfo
-    code_info;
+  unsigned char
+    first;
+
+  unsigned short
+    prefix[MaximumLZWCode],
+    length_of[MaximumLZWCode];
+
+  unsigned char
+    suffix[MaximumLZWCode];
 } LZWInfo;
 
+typedef struct _LZWEncoder
+{
+  short
+    hash_code[MaxHashTable],
+    hash_prefix[MaxHashTable];
+
+  unsigned char
+    hash_suffix[MaxHashTable],
+    packet[256];
+} LZWEncoder;
+
 /*
   Forward declarations.
 */
-static inline int
-  GetNextLZWCode(LZWInfo *,const unsigned long);
-
 static MagickBooleanType
   WriteGIFImage(const ImageInfo *,Image *);
 
@@ -161,29 +166,16 @@ static ssize_t
 
 static LZWInfo *RelinquishLZWInfo(LZWInfo *lzw_info)
 {
-  if (lzw_info->table[0] != (unsigned long *) NULL)
-    lzw_info->table[0]=(unsigned long *) RelinquishMagickMemory(
-      lzw_info->table[0]);
-  if (lzw_info->table[1] != (unsigned long *) NULL)
-    lzw_info->table[1]=(unsigned long *) RelinquishMagickMemory(
-      lzw_info->table[1]);
-  if (lzw_info->stack != (LZWStack *) NULL)
-    {
-      if (lzw_info->stack->codes != (unsigned long *) NULL)
-        lzw_info->stack->codes=(unsigned long *) RelinquishMagickMemory(
-          lzw_info->stack->codes);
-      lzw_info->stack=(LZWStack *) RelinquishMagickMemory(lzw_info->stack);
-    }
   lzw_info=(LZWInfo *) RelinquishMagickMemory(lzw_info);
   return((LZWInfo *) NULL);
 }
 
 static inline void ResetLZWInfo(LZWInfo *lzw_info)
 {
-  lzw_info->bits=lzw_info->data_size+1;
-  lzw_info->maximum_code=1UL << lzw_info->bits;
+  lzw_info->code_size=lzw_info->data_size+1;
+  lzw_info->maximum_code=1UL << lzw_info->code_size;
   lzw_info->slot=lzw_info->maximum_data_value+3;
-  lzw_info->genesis=MagickTrue;
+  lzw_info->last_code=(-1);
 }
 
 static LZWInfo *AcquireLZWInfo(Image *image,const unsigned long data_size)
@@ -194,6 +186,9 @@ static LZWInfo *AcquireLZWInfo(Image *image,const unsigned long data_size)
   register long
     i;
 
+  unsigned char
+    block_length;
+
   lzw_info=(LZWInfo *) AcquireMagickMemory(sizeof(*lzw_info));
   if (lzw_info == (LZWInfo *) NULL)
     return((LZWInfo *) NULL);
@@ -203,169 +198,172 @@ static LZWInfo *AcquireLZWInfo(Image *image,const unsigned long data_size)
   lzw_info->maximum_data_value=(1UL << data_size)-1;
   lzw_info->clear_code=lzw_info->maximum_data_value+1;
   lzw_info->end_code=lzw_info->maximum_data_value+2;
-  lzw_info->table[0]=(unsigned long *) AcquireQuantumMemory(MaximumLZWCode,
-    sizeof(*lzw_info->table));
-  lzw_info->table[1]=(unsigned long *) AcquireQuantumMemory(MaximumLZWCode,
-    sizeof(*lzw_info->table));
-  if ((lzw_info->table[0] == (unsigned long *) NULL) ||
-      (lzw_info->table[1] == (unsigned long *) NULL))
-    {
-      lzw_info=RelinquishLZWInfo(lzw_info);
-      return((LZWInfo *) NULL);
-    }
   for (i=0; i <= (long) lzw_info->maximum_data_value; i++)
   {
-    lzw_info->table[0][i]=0;
-    lzw_info->table[1][i]=(unsigned long) i;
+    lzw_info->prefix[i]=0;
+    lzw_info->suffix[i]=(unsigned char) i;
+    lzw_info->length_of[i]=1;
   }
   ResetLZWInfo(lzw_info);
-  lzw_info->code_info.buffer[0]='\0';
-  lzw_info->code_info.buffer[1]='\0';
-  lzw_info->code_info.count=2;
-  lzw_info->code_info.bit=8*lzw_info->code_info.count;
-  lzw_info->code_info.eof=MagickFalse;
-  lzw_info->genesis=MagickTrue;
-  lzw_info->stack=(LZWStack *) AcquireMagickMemory(sizeof(*lzw_info->stack));
-  if (lzw_info->stack == (LZWStack *) NULL)
-    {
-      lzw_info=RelinquishLZWInfo(lzw_info);
-      return((LZWInfo *) NULL);
-    }
-  lzw_info->stack->codes=(unsigned long *) AcquireQuantumMemory(2UL*
-    MaximumLZWCode,sizeof(*lzw_info->stack->codes));
-  if (lzw_info->stack->codes == (unsigned long *) NULL)
-    {
-      lzw_info=RelinquishLZWInfo(lzw_info);
-      return((LZWInfo *) NULL);
-    }
-  lzw_info->stack->index=lzw_info->stack->codes;
-  lzw_info->stack->top=lzw_info->stack->codes+2*MaximumLZWCode;
+  /*
+    Prime the sub-block reader with the length of the first sub-block.
+  */
+  if (ReadBlob(image,1,&block_length) != 1)
+    block_length=0;
+  lzw_info->block_length=(size_t) block_length;
+  lzw_info->eof=block_length == 0 ? MagickTrue : MagickFalse;
   return(lzw_info);
 }
 
-static inline int GetNextLZWCode(LZWInfo *lzw_info,const unsigned long bits)
+static MagickBooleanType ReadLZWBlocks(LZWInfo *lzw_info)
 {
-  int
-    code;
-
-  register long
-    i;
+  ssize_t
+    count;
 
-  while (((lzw_info->code_info.bit+bits) > (8*lzw_info->code_info.count)) &&
-         (lzw_info->code_info.eof == MagickFalse))
-  {
-    ssize_t
-      count;
-
-    lzw_info->code_info.buffer[0]=lzw_info->code_info.buffer[
-      lzw_info->code_info.count-2];
-    lzw_info->code_info.buffer[1]=lzw_info->code_info.buffer[
-      lzw_info->code_info.count-1];
-    lzw_info->code_info.bit-=8*(lzw_info->code_info.count-2);
-    lzw_info->code_info.count=2;
-    count=ReadBlobBlock(lzw_info->image,&lzw_info->code_info.buffer[
-      lzw_info->code_info.count]);
-    if (count > 0)
-      lzw_info->code_info.count+=count;
-    else
-      lzw_info->code_info.eof=MagickTrue;
-  }
-  if ((lzw_info->code_info.bit+bits) > (8*lzw_info->code_info.count))
-    return(-1);
-  code=0;
-  for (i=0; i < (long) bits; i++)
+  /*
+    Refill the buffer with as many sub-blocks as fit.  Each read fetches one
+    sub-block plus the length byte of the next, so there is a single blob
+    read per sub-block and the stream is never read past the terminator.
+  */
+  if (lzw_info->offset < lzw_info->length)
+    (void) CopyMagickMemory(lzw_info->buffer,lzw_info->buffer+
+      lzw_info->offset,lzw_info->length-lzw_info->offset);
+  lzw_info->length-=lzw_info->offset;
+  lzw_info->offset=0;
+  while ((lzw_info->eof == MagickFalse) &&
+         ((lzw_info->length+lzw_info->block_length) <= LZWBufferExtent))
   {
-    code|=((lzw_info->code_info.buffer[lzw_info->code_info.bit/8] &
-      (1UL << (lzw_info->code_info.bit % 8))) != 0) << i;
-    lzw_info->code_info.bit++;
+    count=ReadBlob(lzw_info->image,lzw_info->block_length+1,
+      lzw_info->buffer+lzw_info->length);
+    if (count <= (ssize_t) lzw_info->block_length)
+      {
+        if (count > 0)
+          lzw_info->length+=(size_t) count;
+        lzw_info->eof=MagickTrue;
+        break;
+      }
+    lzw_info->length+=lzw_info->block_length;
+    lzw_info->block_length=(size_t) lzw_info->buffer[lzw_info->length];
+    if (lzw_info->block_length == 0)
+      lzw_info->eof=MagickTrue;
   }
-  return(code);
+  return(lzw_info->length != 0 ? MagickTrue : MagickFalse);
 }
 
-static inline long PopLZWStack(LZWStack *stack_info)
+static void SkipLZWBlocks(LZWInfo *lzw_info)
 {
-  if (stack_info->index <= stack_info->codes)
-    return(-1);
-  stack_info->index--;
-  return((long) *stack_info->index);
+  /*
+    Consume any sub-blocks left after the end code, up to the terminator.
+  */
+  while (lzw_info->eof == MagickFalse)
+  {
+    lzw_info->offset=lzw_info->length;
+    if (ReadLZWBlocks(lzw_info) == MagickFalse)
+      break;
+  }
 }
 
-static inline void PushLZWStack(LZWStack *stack_info,const unsigned long value)
+static inline int GetNextLZWCode(LZWInfo *lzw_info)
 {
-  if (stack_info->index >= stack_info->top)
-    return;
-  *stack_info->index=value;
-  stack_info->index++;
+  int
+    code;
+
+  while (lzw_info->bits < lzw_info->code_size)
+  {
+    if (lzw_info->offset >= lzw_info->length)
+      if (ReadLZWBlocks(lzw_info) == MagickFalse)
+        return(-1);
+    lzw_info->datum|=(unsigned long) lzw_info->buffer[lzw_info->offset++] <<
+      lzw_info->bits;
+    lzw_info->bits+=8;
+  }
+  code=(int) (lzw_info->datum & ((1UL << lzw_info->code_size)-1));
+  lzw_info->datum>>=lzw_info->code_size;
+  lzw_info->bits-=lzw_info->code_size;
+  return(code);
 }
 
-static int ReadBlobLZWByte(LZWInfo *lzw_info)
+static ssize_t ReadLZWString(LZWInfo *lzw_info,unsigned char *string)
 {
   int
     code;
 
-  ssize_t
-    count;
+  register unsigned char
+    *p;
 
-  unsigned long
-    value;
+  register unsigned long
+    c;
 
-  if (lzw_info->stack->index != lzw_info->stack->codes)
-    return(PopLZWStack(lzw_info->stack));
-  if (lzw_info->genesis != MagickFalse)
-    {
-      lzw_info->genesis=MagickFalse;
-      do
+  size_t
+    length;
+
+  /*
+    Decode the next code and write its whole string to the buffer; returns
+    the string length, 0 at the end code, and -1 on corrupt data.
+  */
+  for ( ; ; )
+  {
+    code=GetNextLZWCode(lzw_info);
+    if (code < 0)
+      return(-1);
+    if ((unsigned long) code == lzw_info->clear_code)
       {
-        lzw_info->first_code=(unsigned long) GetNextLZWCode(lzw_info,
-          lzw_info->bits);
-        lzw_info->last_code=lzw_info->first_code;
-      } while (lzw_info->first_code == lzw_info->clear_code);
-      return((int) lzw_info->first_code);
-    }
-  code=GetNextLZWCode(lzw_info,lzw_info->bits);
-  if (code < 0)
-    return(code);
-  if ((unsigned long) code == lzw_info->clear_code)
+        ResetLZWInfo(lzw_info);
+        continue;
+      }
+    if ((unsigned long) code == lzw_info->end_code)
+      return(0);
+    break;
+  }
+  if (lzw_info->last_code < 0)
     {
-      ResetLZWInfo(lzw_info);
-      return(ReadBlobLZWByte(lzw_info));
+      if ((unsigned long) code > lzw_info->maximum_data_value)
+        return(-1);
+      *string=(unsigned char) code;
+      lzw_info->first=(unsigned char) code;
+      lzw_info->last_code=(long) code;
+      return(1);
     }
-  if ((unsigned long) code == lzw_info->end_code)
-    return(-1);
   if ((unsigned long) code < lzw_info->slot)
-    value=(unsigned long) code;
+    {
+      length=(size_t) lzw_info->length_of[code];
+      c=(unsigned long) code;
+    }
   else
     {
-      PushLZWStack(lzw_info->stack,lzw_info->first_code);
-      value=lzw_info->last_code;
+      if ((unsigned long) code != lzw_info->slot)
+        return(-1);
+      /*
+        The code being defined: previous string plus its own first byte.
+      */
+      length=(size_t) lzw_info->length_of[lzw_info->last_code]+1;
+      string[length-1]=lzw_info->first;
+      c=(unsigned long) lzw_info->last_code;
     }
-  count=0;
-  while (value > lzw_info->maximum_data_value)
+  p=string+lzw_info->length_of[c]-1;
+  while (c > lzw_info->maximum_data_value)
   {
-    if ((size_t) count > MaximumLZWCode)
-      return(-1);
-    count++;
-    if ((size_t) value > MaximumLZWCode)
-      return(-1);
-    PushLZWStack(lzw_info->stack,lzw_info->table[1][value]);
-    value=lzw_info->table[0][value];
+    *p--=lzw_info->suffix[c];
+    c=lzw_info->prefix[c];
   }
-  lzw_info->first_code=lzw_info->table[1][value];
-  PushLZWStack(lzw_info->stack,lzw_info->first_code);
+  *p=(unsigned char) c;
+  lzw_info->first=(*string);
   if (lzw_info->slot < MaximumLZWCode)
     {
-      lzw_info->table[0][lzw_info->slot]=lzw_info->last_code;
-      lzw_info->table[1][lzw_info->slot]=lzw_info->first_code;
+      lzw_info->prefix[lzw_info->slot]=(unsigned short) lzw_info->last_code;
+      lzw_info->suffix[lzw_info->slot]=lzw_info->first;
+      lzw_info->length_of[lzw_info->slot]=(unsigned short)
+        (lzw_info->length_of[lzw_info->last_code]+1);
       lzw_info->slot++;
       if ((lzw_info->slot >= lzw_info->maximum_code) &&
-          (lzw_info->bits < MaximumLZWBits))
+          (lzw_info->code_size < MaximumLZWBits))
         {
-          lzw_info->bits++;
-          lzw_info->maximum_code=1UL << lzw_info->bits;
+          lzw_info->code_size++;
+          lzw_info->maximum_code=1UL << lzw_info->code_size;
         }
     }
-  lzw_info->last_code=(unsigned long) code;
-  return(PopLZWStack(lzw_info->stack));
+  lzw_info->last_code=(long) code;
+  return((ssize_t) length);
 }
 
 static MagickBooleanType DecodeImage(Image *image,const long opacity)
@@ -376,9 +374,6 @@ static MagickBooleanType DecodeImage(Image *image,const long opacity)
   IndexPacket
     index;
 
-  int
-    c;
-
   long
     offset,
     y;
@@ -386,8 +381,15 @@ static MagickBooleanType DecodeImage(Image *image,const long opacity)
   LZWInfo
     *lzw_info;
 
+  size_t
+    extent;
+
+  ssize_t
+    count;
+
   unsigned char
-    data_size;
+    data_size,
+    *pixels;
 
   unsigned long
     pass;
@@ -406,9 +408,22 @@ static MagickBooleanType DecodeImage(Image *image,const long opacity)
   if (lzw_info == (LZWInfo *) NULL)
     ThrowBinaryException(ResourceLimitError,"MemoryAllocationFailed",
       image->filename);
+  /*
+    Strings are decoded straight into a row buffer; a string that runs past
+    the end of a row spills into the slack and is carried to the next row.
+  */
+  pixels=(unsigned char *) AcquireQuantumMemory(image->columns+
+    MaximumLZWCode,sizeof(*pixels));
+  if (pixels == (unsigned char *) NULL)
+    {
+      lzw_info=RelinquishLZWInfo(lzw_info);
+      ThrowBinaryException(ResourceLimitError,"MemoryAllocationFailed",
+        image->filename);
+    }
   exception=(&image->exception);
   pass=0;
   offset=0;
+  extent=0;
   for (y=0; y < (long) image->rows; y++)
   {
     register IndexPacket
@@ -420,27 +435,33 @@ static MagickBooleanType DecodeImage(Image *image,const long opacity)
     register PixelPacket
       *__restrict q;
 
+    while (extent < image->columns)
+    {
+      count=ReadLZWString(lzw_info,pixels+extent);
+      if (count <= 0)
+        break;
+      extent+=(size_t) count;
+    }
+    if (extent < image->columns)
+      break;
     q=GetAuthenticPixels(image,0,offset,image->columns,1,exception);
     if (q == (PixelPacket *) NULL)
       break;
     indexes=GetAuthenticIndexQueue(image);
-    for (x=0; x < (long) image->columns; )
+    for (x=0; x < (long) image->columns; x++)
     {
-      c=ReadBlobLZWByte(lzw_info);
-      if (c < 0)
-        break;
-      index=ConstrainColormapIndex(image,(unsigned long) c);
+      index=ConstrainColormapIndex(image,(unsigned long) pixels[x]);
       q->red=image->colormap[(long) index].red;
       q->green=image->colormap[(long) index].green;
       q->blue=image->colormap[(long) index].blue;
       q->opacity=(long) index == opacity ? (Quantum) TransparentOpacity :
         (Quantum) OpaqueOpacity;
       indexes[x]=index;
-      x++;
       q++;
     }
-    if (x < (long) image->columns)
-      break;
+    extent-=image->columns;
+    if (extent != 0)
+      (void) CopyMagickMemory(pixels,pixels+image->columns,extent);
     if (image->interlace == NoInterlace)
       offset++;
     else
@@ -486,6 +507,8 @@ static MagickBooleanType DecodeImage(Image *image,const long opacity)
     if (SyncAuthenticPixels(image,exception) == MagickFalse)
       break;
   }
+  SkipLZWBlocks(lzw_info);
+  pixels=(unsigned char *) RelinquishMagickMemory(pixels);
   lzw_info=RelinquishLZWInfo(lzw_info);
   if (y < (long) image->rows)
     ThrowBinaryException(CorruptImageError,"CorruptImage",image->filename);
@@ -508,7 +531,7 @@ static MagickBooleanType DecodeImage(Image *image,const long opacity)
 %  The format of the EncodeImage method is:
 %
 %      MagickBooleanType EncodeImage(const ImageInfo *image_info,Image *image,
-%        const unsigned long data_size)
+%        const unsigned long data_size,LZWEncoder *lzw_encoder)
 %
 %  A description of each parameter follows:
 %
@@ -518,12 +541,13 @@ static MagickBooleanType DecodeImage(Image *image,const long opacity)
 %
 %    o data_size:  The number of bits in the compressed packet.
 %
+%    o lzw_encoder:  the encoder tables, shared by all the frames of a file.
+%
 */
 static MagickBooleanType EncodeImage(const ImageInfo *image_info,Image *image,
-  const unsigned long data_size)
+  const unsigned long data_size,LZWEncoder *lzw_encoder)
 {
 #define MaxCode(number_bits)  ((1UL << (number_bits))-1)
-#define MaxHashTable  5003
 #define MaxGIFBits  12UL
 #define MaxGIFTable  (1UL << MaxGIFBits)
 #define GIFOutputCode(code) \
@@ -539,13 +563,13 @@ static MagickBooleanType EncodeImage(const ImageInfo *image_info,Image *image,
   while (bits >= 8) \
   { \
     /*  \
-      Add a character to current packet. \
+      Add a character to current packet; packet[0] holds the block size. \
     */ \
-    packet[length++]=(unsigned char) (datum & 0xff); \
-    if (length >= 254) \
+    packet[++length]=(unsigned char) (datum & 0xff); \
+    if (length >= 255) \
       { \
-        (void) WriteBlobByte(image,(unsigned char) length); \
-        (void) WriteBlob(image,length,packet); \
+        packet[0]=(unsigned char) length; \
+        (void) WriteBlob(image,length+1,packet); \
         length=0; \
       } \
     datum>>=8; \
@@ -561,9 +585,6 @@ static MagickBooleanType EncodeImage(const ImageInfo *image_info,Image *image,
     } \
 }
 
-  IndexPacket
-    index;
-
   long
     displacement,
     offset,
@@ -573,17 +594,22 @@ static MagickBooleanType EncodeImage(const ImageInfo *image_info,Image *image,
   register long
     i;
 
+  register short
+    *hash_code,
+    *hash_prefix;
+
+  register unsigned char
+    *hash_suffix;
+
   size_t
     length;
 
   short
-    *hash_code,
-    *hash_prefix,
     waiting_code;
 
   unsigned char
-    *packet,
-    *hash_suffix;
+    index,
+    *packet;
 
   unsigned long
     bits,
@@ -592,36 +618,18 @@ static MagickBooleanType EncodeImage(const ImageInfo *image_info,Image *image,
     end_of_information_code,
     free_code,
     max_code,
-    next_pixel,
     number_bits,
     pass;
 
-  /*
-    Allocate encoder tables.
-  */
-  assert(image != (Image *) NULL);
-  packet=(unsigned char *) AcquireQuantumMemory(256,sizeof(*packet));
-  hash_code=(short *) AcquireQuantumMemory(MaxHashTable,sizeof(*hash_code));
-  hash_prefix=(short *) AcquireQuantumMemory(MaxHashTable,sizeof(*hash_prefix));
-  hash_suffix=(unsigned char *) AcquireQuantumMemory(MaxHashTable,
-    sizeof(*hash_suffix));
-  if ((packet == (unsigned char *) NULL) || (hash_code == (short *) NULL) ||
-      (hash_prefix == (short *) NULL) ||
-      (hash_suffix == (unsigned char *) NULL))
-    {
-      if (packet != (unsigned char *) NULL)
-        packet=(unsigned char *) RelinquishMagickMemory(packet);
-      if (hash_code != (short *) NULL)
-        hash_code=(short *) RelinquishMagickMemory(hash_code);
-      if (hash_prefix != (short *) NULL)
-        hash_prefix=(short *) RelinquishMagickMemory(hash_prefix);
-      if (hash_suffix != (unsigned char *) NULL)
-        hash_suffix=(unsigned char *) RelinquishMagickMemory(hash_suffix);
-      return(MagickFalse);
-    }
   /*
     Initialize GIF encoder.
   */
+  assert(image != (Image *) NULL);
+  assert(lzw_encoder != (LZWEncoder *) NULL);
+  hash_code=lzw_encoder->hash_code;
+  hash_prefix=lzw_encoder->hash_prefix;
+  hash_suffix=lzw_encoder->hash_suffix;
+  packet=lzw_encoder->packet;
   number_bits=data_size;
   max_code=MaxCode(number_bits);
   clear_code=((short) 1UL << (data_size-1));
@@ -630,8 +638,7 @@ static MagickBooleanType EncodeImage(const ImageInfo *image_info,Image *image,
   length=0;
   datum=0;
   bits=0;
-  for (i=0; i < MaxHashTable; i++)
-    hash_code[i]=0;
+  (void) ResetMagickMemory(hash_code,0,MaxHashTable*sizeof(*hash_code));
   GIFOutputCode(clear_code);
   /*
     Encode pixels.
@@ -644,14 +651,11 @@ static MagickBooleanType EncodeImage(const ImageInfo *image_info,Image *image,
     register const IndexPacket
       *__restrict indexes;
 
-    register const PixelPacket
-      *__restrict p;
-
     register long
       x;
 
-    p=GetVirtualPixels(image,0,offset,image->columns,1,&image->exception);
-    if (p == (const PixelPacket *) NULL)
+    if (GetVirtualPixels(image,0,offset,image->columns,1,&image->exception) ==
+        (const PixelPacket *) NULL)
       break;
     indexes=GetVirtualIndexQueue(image);
     if (y == 0)
@@ -661,21 +665,18 @@ static MagickBooleanType EncodeImage(const ImageInfo *image_info,Image *image,
       /*
         Probe hash table.
       */
-      index=(IndexPacket) ((unsigned long) indexes[x] & 0xff);
-      p++;
+      index=(unsigned char) ((unsigned long) indexes[x] & 0xff);
       k=(long) (((unsigned long) index << (MaxGIFBits-8))+waiting_code);
       if (k >= MaxHashTable)
         k-=MaxHashTable;
-      next_pixel=MagickFalse;
-      displacement=1;
       if (hash_code[k] > 0)
         {
-          if ((hash_prefix[k] == waiting_code) &&
-              (hash_suffix[k] == (unsigned char) index))
+          if ((hash_prefix[k] == waiting_code) && (hash_suffix[k] == index))
             {
               waiting_code=hash_code[k];
               continue;
             }
+          displacement=1;
           if (k != 0)
             displacement=MaxHashTable-k;
           for ( ; ; )
@@ -685,31 +686,29 @@ static MagickBooleanType EncodeImage(const ImageInfo *image_info,Image *image,
               k+=MaxHashTable;
             if (hash_code[k] == 0)
               break;
-            if ((hash_prefix[k] == waiting_code) &&
-                (hash_suffix[k] == (unsigned char) index))
-              {
-                waiting_code=hash_code[k];
-                next_pixel=MagickTrue;
-                break;
-              }
+            if ((hash_prefix[k] == waiting_code) && (hash_suffix[k] == index))
+              break;
           }
-          if (next_pixel == MagickTrue)
-            continue;
+          if (hash_code[k] != 0)
+            {
+              waiting_code=hash_code[k];
+              continue;
+            }
         }
       GIFOutputCode((unsigned long) waiting_code);
       if (free_code < MaxGIFTable)
         {
           hash_code[k]=(short) free_code++;
           hash_prefix[k]=waiting_code;
-          hash_suffix[k]=(unsigned char) index;
+          hash_suffix[k]=index;
         }
       else
         {
           /*
             Fill the hash table with empty entries.
           */
-          for (k=0; k < MaxHashTable; k++)
-            hash_code[k]=0;
+          for (i=0; i < MaxHashTable; i++)
+            hash_code[i]=0;
           /*
             Reset compressor and issue a clear code.
           */
@@ -773,11 +772,11 @@ static MagickBooleanType EncodeImage(const ImageInfo *image_info,Image *image,
       /*
         Add a character to current packet.
       */
-      packet[length++]=(unsigned char) (datum & 0xff);
-      if (length >= 254)
+      packet[++length]=(unsigned char) (datum & 0xff);
+      if (length >= 255)
         {
-          (void) WriteBlobByte(image,(unsigned char) length);
-          (void) WriteBlob(image,length,packet);
+          packet[0]=(unsigned char) length;
+          (void) WriteBlob(image,length+1,packet);
           length=0;
         }
     }
@@ -786,16 +785,9 @@ static MagickBooleanType EncodeImage(const ImageInfo *image_info,Image *image,
   */
   if (length > 0)
     {
-      (void) WriteBlobByte(image,(unsigned char) length);
-      (void) WriteBlob(image,length,packet);
+      packet[0]=(unsigned char) length;
+      (void) WriteBlob(image,length+1,packet);
     }
-  /*
-    Free encoder memory.
-  */
-  hash_suffix=(unsigned char *) RelinquishMagickMemory(hash_suffix);
-  hash_prefix=(short *) RelinquishMagickMemory(hash_prefix);
-  hash_code=(short *) RelinquishMagickMemory(hash_code);
-  packet=(unsigned char *) RelinquishMagickMemory(packet);
   return(MagickTrue);
 }
 
@@ -1442,6 +1434,9 @@ static MagickBooleanType WriteGIFImage(const ImageInfo *image_info,Image *image)
     j,
     opacity;
 
+  LZWEncoder
+    *lzw_encoder;
+
   ImageInfo
     *write_info;
 
@@ -1492,8 +1487,10 @@ static MagickBooleanType WriteGIFImage(const ImageInfo *image_info,Image *image)
   global_colormap=(unsigned char *) AcquireQuantumMemory(768UL,
     sizeof(*global_colormap));
   colormap=(unsigned char *) AcquireQuantumMemory(768UL,sizeof(*colormap));
+  lzw_encoder=(LZWEncoder *) AcquireMagickMemory(sizeof(*lzw_encoder));
   if ((global_colormap == (unsigned char *) NULL) ||
-      (colormap == (unsigned char *) NULL))
+      (colormap == (unsigned char *) NULL) ||
+      (lzw_encoder == (LZWEncoder *) NULL))
     ThrowWriterException(ResourceLimitError,"MemoryAllocationFailed");
   for (i=0; i < 768; i++)
     colormap[i]=(unsigned char) 0;
@@ -1836,12 +1833,13 @@ static MagickBooleanType WriteGIFImage(const ImageInfo *image_info,Image *image)
     c=(int) MagickMax(bits_per_pixel,2);
     (void) WriteBlobByte(image,(unsigned char) c);
     status=EncodeImage(write_info,image,(unsigned long)
-      MagickMax(bits_per_pixel,2)+1);
+      MagickMax(bits_per_pixel,2)+1,lzw_encoder);
     if (status == MagickFalse)
       {
         global_colormap=(unsigned char *) RelinquishMagickMemory(
           global_colormap);
         colormap=(unsigned char *) RelinquishMagickMemory(colormap);
+        lzw_encoder=(LZWEncoder *) RelinquishMagickMemory(lzw_encoder);
         write_info=DestroyImageInfo(write_info);
         ThrowWriterException(ResourceLimitError,"MemoryAllocationFailed");
       }
@@ -1858,6 +1856,7 @@ static MagickBooleanType WriteGIFImage(const ImageInfo *image_info,Image *image)
   (void) WriteBlobByte(image,';'); /* terminator */
   global_colormap=(unsigned char *) RelinquishMagickMemory(global_colormap);
   colormap=(unsigned char *) RelinquishMagickMemory(colormap);
+  lzw_encoder=(LZWEncoder *) RelinquishMagickMemory(lzw_encoder);
   write_info=DestroyImageInfo(write_info);
   (void) CloseBlob(image);
   return(MagickTrue);
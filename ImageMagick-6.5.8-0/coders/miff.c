@@ -44,6 +44,7 @@
 #include "magick/blob.h"
 #include "magick/blob-private.h"
 #include "magick/cache.h"
+#include "magick/cache-view.h"
 #include "magick/color.h"
 #include "magick/colormap-private.h"
 #include "magick/color-private.h"
@@ -68,6 +69,7 @@
 #include "magick/static.h"
 #include "magick/statistic.h"
 #include "magick/string_.h"
+#include "magick/thread-private.h"
 #include "magick/module.h"
 #if defined(MAGICKCORE_ZLIB_DELEGATE)
 #include "zlib.h"
@@ -362,6 +364,214 @@ static void RelinquishBZIPMemory(void *context,void *memory)
 }
 #endif
 
+static unsigned char **DestroyBlockThreadSet(unsigned char **pixels)
+{
+  register long
+    i;
+
+  assert(pixels != (unsigned char **) NULL);
+  for (i=0; i < (long) GetOpenMPMaximumThreads(); i++)
+    if (pixels[i] != (unsigned char *) NULL)
+      pixels[i]=(unsigned char *) RelinquishMagickMemory(pixels[i]);
+  pixels=(unsigned char **) RelinquishMagickMemory(pixels);
+  return(pixels);
+}
+
+static unsigned char **AcquireBlockThreadSet(const size_t extent)
+{
+  register long
+    i;
+
+  unsigned char
+    **pixels;
+
+  unsigned long
+    number_threads;
+
+  number_threads=GetOpenMPMaximumThreads();
+  pixels=(unsigned char **) AcquireQuantumMemory(number_threads,
+    sizeof(*pixels));
+  if (pixels == (unsigned char **) NULL)
+    return((unsigned char **) NULL);
+  (void) ResetMagickMemory(pixels,0,number_threads*sizeof(*pixels));
+  for (i=0; i < (long) number_threads; i++)
+  {
+    pixels[i]=(unsigned char *) AcquireQuantumMemory(extent,sizeof(**pixels));
+    if (pixels[i] == (unsigned char *) NULL)
+      return(DestroyBlockThreadSet(pixels));
+  }
+  return(pixels);
+}
+
+static MagickBooleanType ReadMIFFBlocks(Image *image,
+  const QuantumInfo *quantum_info,const QuantumType quantum_type,
+  const size_t packet_size,const unsigned long block_rows,
+  ExceptionInfo *exception)
+{
+  CacheView
+    *image_view;
+
+  long
+    block;
+
+  MagickBooleanType
+    status;
+
+  MagickSizeType
+    *offsets;
+
+  register long
+    i;
+
+  size_t
+    extent,
+    number_blocks;
+
+  ssize_t
+    count;
+
+  unsigned char
+    *blocks,
+    **pixels;
+
+  /*
+    The compressed length of every block of rows precedes the pixel data; the
+    offsets derived from it let each block be decompressed independently.
+  */
+  number_blocks=(size_t) ((image->rows+block_rows-1)/block_rows);
+  offsets=(MagickSizeType *) AcquireQuantumMemory(number_blocks+1,
+    sizeof(*offsets));
+  if (offsets == (MagickSizeType *) NULL)
+    {
+      (void) ThrowMagickException(exception,GetMagickModule(),
+        ResourceLimitError,"MemoryAllocationFailed","`%s'",image->filename);
+      return(MagickFalse);
+    }
+  offsets[0]=0;
+  for (i=0; i < (long) number_blocks; i++)
+    offsets[i+1]=offsets[i]+ReadBlobMSBLong(image);
+  extent=(size_t) offsets[number_blocks];
+  if ((EOFBlob(image) != MagickFalse) ||
+      (offsets[number_blocks] != (MagickSizeType) extent))
+    {
+      offsets=(MagickSizeType *) RelinquishMagickMemory(offsets);
+      (void) ThrowMagickException(exception,GetMagickModule(),
+        CorruptImageError,"InsufficientImageDataInFile","`%s'",
+        image->filename);
+      return(MagickFalse);
+    }
+  blocks=(unsigned char *) AcquireQuantumMemory(extent,sizeof(*blocks));
+  pixels=AcquireBlockThreadSet(block_rows*packet_size*image->columns);
+  if ((blocks == (unsigned char *) NULL) ||
+      (pixels == (unsigned char **) NULL))
+    {
+      if (pixels != (unsigned char **) NULL)
+        pixels=DestroyBlockThreadSet(pixels);
+      if (blocks != (unsigned char *) NULL)
+        blocks=(unsigned char *) RelinquishMagickMemory(blocks);
+      offsets=(MagickSizeType *) RelinquishMagickMemory(offsets);
+      (void) ThrowMagickException(exception,GetMagickModule(),
+        ResourceLimitError,"MemoryAllocationFailed","`%s'",image->filename);
+      return(MagickFalse);
+    }
+  count=ReadBlob(image,extent,blocks);
+  status=count == (ssize_t) extent ? MagickTrue : MagickFalse;
+  image_view=AcquireCacheView(image);
+#if defined(MAGICKCORE_OPENMP_SUPPORT) && (_OPENMP >= 200203)
+  #pragma omp parallel for schedule(dynamic,1) shared(status) \
+    if (GetBlobStreamHandler(image) == (StreamHandler) NULL)
+#endif
+  for (block=0; block < (long) number_blocks; block++)
+  {
+    long
+      id,
+      y;
+
+    register unsigned char
+      *p;
+
+    size_t
+      length;
+
+    unsigned long
+      rows;
+
+    if (status == MagickFalse)
+      continue;
+    id=GetOpenMPThreadId();
+    y=block*(long) block_rows;
+    rows=(unsigned long) MagickMin(block_rows,image->rows-y);
+    length=rows*packet_size*image->columns;
+    switch (image->compression)
+    {
+#if defined(MAGICKCORE_ZLIB_DELEGATE)
+      case LZWCompression:
+      case ZipCompression:
+      {
+        uLongf
+          number_bytes;
+
+        number_bytes=(uLongf) length;
+        if ((uncompress(pixels[id],&number_bytes,blocks+offsets[block],(uLong)
+            (offsets[block+1]-offsets[block])) != Z_OK) ||
+            (number_bytes != (uLongf) length))
+          status=MagickFalse;
+        break;
+      }
+#endif
+#if defined(MAGICKCORE_BZLIB_DELEGATE)
+      case BZipCompression:
+      {
+        unsigned int
+          number_bytes;
+
+        number_bytes=(unsigned int) length;
+        if ((BZ2_bzBuffToBuffDecompress((char *) pixels[id],&number_bytes,
+            (char *) blocks+offsets[block],(unsigned int) (offsets[block+1]-
+            offsets[block]),0,0) != BZ_OK) ||
+            (number_bytes != (unsigned int) length))
+          status=MagickFalse;
+        break;
+      }
+#endif
+      default:
+      {
+        status=MagickFalse;
+        break;
+      }
+    }
+    if (status == MagickFalse)
+      continue;
+    p=pixels[id];
+    for ( ; rows != 0; rows--)
+    {
+      if (QueueCacheViewAuthenticPixels(image_view,0,y,image->columns,1,
+          exception) == (PixelPacket *) NULL)
+        {
+          status=MagickFalse;
+          break;
+        }
+      (void) ImportQuantumPixels(image,image_view,quantum_info,quantum_type,p,
+        exception);
+      if (SyncCacheViewAuthenticPixels(image_view,exception) == MagickFalse)
+        {
+          status=MagickFalse;
+          break;
+        }
+      p+=packet_size*image->columns;
+      y++;
+    }
+  }
+  image_view=DestroyCacheView(image_view);
+  pixels=DestroyBlockThreadSet(pixels);
+  blocks=(unsigned char *) RelinquishMagickMemory(blocks);
+  offsets=(MagickSizeType *) RelinquishMagickMemory(offsets);
+  if (status == MagickFalse)
+    (void) ThrowMagickException(exception,GetMagickModule(),CorruptImageError,
+      "UnableToReadImageData","`%s'",image->filename);
+  return(status);
+}
+
 static Image *ReadMIFFImage(const ImageInfo *image_info,
   ExceptionInfo *exception)
 {
@@ -436,6 +646,7 @@ static Image *ReadMIFFImage(const ImageInfo *image_info,
     *pixels;
 
   unsigned long
+    block_rows,
     colors;
 
 #if defined(MAGICKCORE_ZLIB_DELEGATE)
@@ -479,6 +690,7 @@ static Image *ReadMIFFImage(const ImageInfo *image_info,
     options=AcquireString((char *) NULL);
     quantum_format=UndefinedQuantumFormat;
     profiles=(LinkedListInfo *) NULL;
+    block_rows=0;
     colors=0;
     image->depth=8UL;
     image->compression=NoCompression;
@@ -587,6 +799,17 @@ static Image *ReadMIFFImage(const ImageInfo *image_info,
                       exception);
                     break;
                   }
+                if (LocaleCompare(keyword,"block-rows") == 0)
+                  {
+                    block_rows=(unsigned long) atol(options);
+                    if (block_rows == 0)
+                      {
+                        options=DestroyString(options);
+                        ThrowReaderException(CorruptImageError,
+                          "ImproperImageHeader");
+                      }
+                    break;
+                  }
                 if (LocaleCompare(keyword,"blue-primary") == 0)
                   {
                     flags=ParseGeometry(options,&geometry_info);
@@ -1017,7 +1240,8 @@ static Image *ReadMIFFImage(const ImageInfo *image_info,
     */
     if ((LocaleCompare(id,"ImageMagick") != 0) ||
         (image->storage_class == UndefinedClass) ||
-        (image->columns == 0) || (image->rows == 0))
+        (image->columns == 0) || (image->rows == 0) ||
+        (block_rows > image->rows))
       ThrowReaderException(CorruptImageError,"ImproperImageHeader");
     if (image->montage != (char *) NULL)
       {
@@ -1219,7 +1443,21 @@ static Image *ReadMIFFImage(const ImageInfo *image_info,
     pixels=GetQuantumPixels(quantum_info);
     index=(IndexPacket) 0;
     length=0;
-    for (y=0; y < (long) image->rows; y++)
+    y=0;
+    if (block_rows != 0)
+      {
+        /*
+          Block compressed pixels.
+        */
+        if ((image->compression != ZipCompression) &&
+            (image->compression != LZWCompression) &&
+            (image->compression != BZipCompression))
+          ThrowReaderException(CorruptImageError,"ImproperImageHeader");
+        status=ReadMIFFBlocks(image,quantum_info,quantum_type,packet_size,
+          block_rows,exception);
+        y=(long) image->rows;
+      }
+    for ( ; y < (long) image->rows; y++)
     {
       register IndexPacket
         *__restrict indexes;
@@ -1672,6 +1910,174 @@ static unsigned char *PopRunlengthPacket(Image *image,unsigned char *pixels,
   return(pixels);
 }
 
+static MagickBooleanType WriteMIFFBlocks(Image *image,
+  const QuantumInfo *quantum_info,const QuantumType quantum_type,
+  const CompressionType compression,const size_t packet_size,
+  const unsigned long block_rows)
+{
+  CacheView
+    *image_view;
+
+  ExceptionInfo
+    *exception;
+
+  int
+    level;
+
+  long
+    block;
+
+  MagickBooleanType
+    status;
+
+  register long
+    i;
+
+  size_t
+    *lengths,
+    number_blocks;
+
+  unsigned char
+    **blocks,
+    **pixels;
+
+  /*
+    Compress each block of rows as an independent stream on its own thread,
+    then write the table of compressed lengths followed by the blocks.
+  */
+  number_blocks=(size_t) ((image->rows+block_rows-1)/block_rows);
+  blocks=(unsigned char **) AcquireQuantumMemory(number_blocks,
+    sizeof(*blocks));
+  lengths=(size_t *) AcquireQuantumMemory(number_blocks,sizeof(*lengths));
+  pixels=AcquireBlockThreadSet(block_rows*packet_size*image->columns);
+  if ((blocks == (unsigned char **) NULL) || (lengths == (size_t *) NULL) ||
+      (pixels == (unsigned char **) NULL))
+    {
+      if (pixels != (unsigned char **) NULL)
+        pixels=DestroyBlockThreadSet(pixels);
+      if (lengths != (size_t *) NULL)
+        lengths=(size_t *) RelinquishMagickMemory(lengths);
+      if (blocks != (unsigned char **) NULL)
+        blocks=(unsigned char **) RelinquishMagickMemory(blocks);
+      ThrowBinaryException(ResourceLimitError,"MemoryAllocationFailed",
+        image->filename);
+    }
+  (void) ResetMagickMemory(blocks,0,number_blocks*sizeof(*blocks));
+  level=(int) (image->quality == UndefinedCompressionQuality ? 7 :
+    MagickMin(image->quality/10,9));
+  status=MagickTrue;
+  exception=(&image->exception);
+  image_view=AcquireCacheView(image);
+#if defined(MAGICKCORE_OPENMP_SUPPORT) && (_OPENMP >= 200203)
+  #pragma omp parallel for schedule(dynamic,1) shared(status)
+#endif
+  for (block=0; block < (long) number_blocks; block++)
+  {
+    long
+      id,
+      y;
+
+    register unsigned char
+      *q;
+
+    size_t
+      length;
+
+    unsigned long
+      rows;
+
+    if (status == MagickFalse)
+      continue;
+    id=GetOpenMPThreadId();
+    y=block*(long) block_rows;
+    rows=(unsigned long) MagickMin(block_rows,image->rows-y);
+    length=rows*packet_size*image->columns;
+    q=pixels[id];
+    for ( ; rows != 0; rows--)
+    {
+      if (GetCacheViewVirtualPixels(image_view,0,y,image->columns,1,
+          exception) == (const PixelPacket *) NULL)
+        {
+          status=MagickFalse;
+          break;
+        }
+      (void) ExportQuantumPixels(image,image_view,quantum_info,quantum_type,q,
+        exception);
+      q+=packet_size*image->columns;
+      y++;
+    }
+    if (status == MagickFalse)
+      continue;
+    switch (compression)
+    {
+#if defined(MAGICKCORE_ZLIB_DELEGATE)
+      case LZWCompression:
+      case ZipCompression:
+      {
+        uLongf
+          number_bytes;
+
+        number_bytes=(uLongf) ZipMaxExtent(length);
+        blocks[block]=(unsigned char *) AcquireQuantumMemory((size_t)
+          number_bytes,sizeof(**blocks));
+        if ((blocks[block] == (unsigned char *) NULL) ||
+            (compress2(blocks[block],&number_bytes,pixels[id],(uLong) length,
+             level) != Z_OK))
+          status=MagickFalse;
+        lengths[block]=(size_t) number_bytes;
+        break;
+      }
+#endif
+#if defined(MAGICKCORE_BZLIB_DELEGATE)
+      case BZipCompression:
+      {
+        unsigned int
+          number_bytes;
+
+        number_bytes=(unsigned int) BZipMaxExtent(length);
+        blocks[block]=(unsigned char *) AcquireQuantumMemory((size_t)
+          number_bytes,sizeof(**blocks));
+        if ((blocks[block] == (unsigned char *) NULL) ||
+            (BZ2_bzBuffToBuffCompress((char *) blocks[block],&number_bytes,
+             (char *) pixels[id],(unsigned int) length,level == 0 ? 1 : level,
+             0,0) != BZ_OK))
+          status=MagickFalse;
+        lengths[block]=(size_t) number_bytes;
+        break;
+      }
+#endif
+      default:
+      {
+        status=MagickFalse;
+        break;
+      }
+    }
+  }
+  image_view=DestroyCacheView(image_view);
+  pixels=DestroyBlockThreadSet(pixels);
+  if (status != MagickFalse)
+    {
+      for (i=0; i < (long) number_blocks; i++)
+        (void) WriteBlobMSBLong(image,(unsigned long) lengths[i]);
+      for (i=0; i < (long) number_blocks; i++)
+      {
+        (void) WriteBlob(image,lengths[i],blocks[i]);
+        if (image->previous == (Image *) NULL)
+          {
+            status=SetImageProgress(image,SaveImageTag,i,number_blocks);
+            if (status == MagickFalse)
+              break;
+          }
+      }
+    }
+  for (i=0; i < (long) number_blocks; i++)
+    if (blocks[i] != (unsigned char *) NULL)
+      blocks[i]=(unsigned char *) RelinquishMagickMemory(blocks[i]);
+  lengths=(size_t *) RelinquishMagickMemory(lengths);
+  blocks=(unsigned char **) RelinquishMagickMemory(blocks);
+  return(status);
+}
+
 static MagickBooleanType WriteMIFFImage(const ImageInfo *image_info,
   Image *image)
 {
@@ -1687,6 +2093,7 @@ static MagickBooleanType WriteMIFFImage(const ImageInfo *image_info,
     compression;
 
   const char
+    *option,
     *property,
     *value;
 
@@ -1726,6 +2133,9 @@ static MagickBooleanType WriteMIFFImage(const ImageInfo *image_info,
     *pixels,
     *q;
 
+  unsigned long
+    block_rows;
+
 #if defined(MAGICKCORE_ZLIB_DELEGATE)
   z_stream
     zip_info;
@@ -1811,6 +2221,13 @@ static MagickBooleanType WriteMIFFImage(const ImageInfo *image_info,
       sizeof(*compress_pixels));
     if (compress_pixels == (unsigned char *) NULL)
       ThrowWriterException(ResourceLimitError,"MemoryAllocationFailed");
+    block_rows=0;
+    option=GetImageOption(image_info,"miff:block-rows");
+    if ((option != (const char *) NULL) &&
+        ((compression == ZipCompression) || (compression == LZWCompression) ||
+         (compression == BZipCompression)))
+      block_rows=(unsigned long) MagickMin((size_t) atol(option),
+        image->rows);
     /*
       Write MIFF header.
     */
@@ -1842,6 +2259,12 @@ static MagickBooleanType WriteMIFFImage(const ImageInfo *image_info,
           compression),image->quality);
         (void) WriteBlobString(image,buffer);
       }
+    if (block_rows != 0)
+      {
+        (void) FormatMagickString(buffer,MaxTextExtent,"block-rows=%lu\n",
+          block_rows);
+        (void) WriteBlobString(image,buffer);
+      }
     if (image->units != UndefinedResolution)
       {
         (void) FormatMagickString(buffer,MaxTextExtent,"units=%s\n",
@@ -2125,7 +2548,14 @@ static MagickBooleanType WriteMIFFImage(const ImageInfo *image_info,
     quantum_type=GetQuantumType(image,&image->exception);
     pixels=GetQuantumPixels(quantum_info);
     status=MagickTrue;
-    for (y=0; y < (long) image->rows; y++)
+    y=0;
+    if (block_rows != 0)
+      {
+        status=WriteMIFFBlocks(image,quantum_info,quantum_type,compression,
+          packet_size,block_rows);
+        y=(long) image->rows;
+      }
+    for ( ; y < (long) image->rows; y++)
     {
       register const IndexPacket
         *__restrict indexes;
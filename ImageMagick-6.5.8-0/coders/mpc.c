@@ -70,6 +70,89 @@
 #include "magick/module.h"
 #include "magick/utility.h"
 
+/*
+  Define declarations.
+*/
+#define MPCMagick  "\213MPC\r\n\032\n"
+#define MPCInfoLength  264UL
+#define MPCVersion  2UL
+
+/*
+  Typedef declarations.
+*/
+typedef struct _MPCInfo
+{
+  unsigned long
+    version,
+    length,
+    quantum_depth;
+
+  ClassType
+    storage_class;
+
+  ColorspaceType
+    colorspace;
+
+  CompressionType
+    compression;
+
+  DisposeType
+    dispose;
+
+  EndianType
+    endian;
+
+  GravityType
+    gravity;
+
+  ImageType
+    type;
+
+  MagickBooleanType
+    matte;
+
+  OrientationType
+    orientation;
+
+  RenderingIntent
+    rendering_intent;
+
+  ResolutionType
+    units;
+
+  unsigned long
+    columns,
+    rows,
+    depth,
+    colors,
+    quality,
+    scene,
+    iterations,
+    delay;
+
+  long
+    ticks_per_second;
+
+  double
+    x_resolution,
+    y_resolution,
+    gamma;
+
+  ChromaticityInfo
+    chromaticity;
+
+  RectangleInfo
+    page,
+    tile_offset;
+
+  unsigned long
+    number_profiles;
+
+  size_t
+    montage_length,
+    properties_length;
+} MPCInfo;
+
 /*
   Forward declarations.
 */
@@ -103,6 +186,10 @@ static MagickBooleanType
 */
 static MagickBooleanType IsMPC(const unsigned char *magick,const size_t length)
 {
+  if (length < 8)
+    return(MagickFalse);
+  if (memcmp(magick,MPCMagick,8) == 0)
+    return(MagickTrue);
   if (length < 14)
     return(MagickFalse);
   if (LocaleNCompare((const char *) magick,"id=MagickCache",14) == 0)
@@ -138,6 +225,225 @@ static MagickBooleanType IsMPC(const unsigned char *magick,const size_t length)
 %    o exception: return any errors or warnings in this structure.
 %
 */
+
+static double ReadMPCDouble(Image *image)
+{
+  union
+  {
+    MagickSizeType
+      unsigned_value;
+
+    double
+      double_value;
+  } quantum;
+
+  quantum.unsigned_value=(MagickSizeType) ReadBlobMSBLong(image) << 32;
+  quantum.unsigned_value|=(MagickSizeType) ReadBlobMSBLong(image);
+  return(quantum.double_value);
+}
+
+static void ReadMPCPrimary(Image *image,PrimaryInfo *primary)
+{
+  primary->x=ReadMPCDouble(image);
+  primary->y=ReadMPCDouble(image);
+  primary->z=ReadMPCDouble(image);
+}
+
+static void ReadMPCRectangle(Image *image,RectangleInfo *rectangle)
+{
+  rectangle->width=ReadBlobMSBLong(image);
+  rectangle->height=ReadBlobMSBLong(image);
+  rectangle->x=(long) ((int) ReadBlobMSBLong(image));
+  rectangle->y=(long) ((int) ReadBlobMSBLong(image));
+}
+
+static MagickBooleanType ReadMPCInfo(Image *image,unsigned long *quantum_depth,
+  LinkedListInfo **profiles)
+{
+  char
+    *name,
+    *properties;
+
+  MPCInfo
+    mpc_info;
+
+  register char
+    *p;
+
+  register unsigned long
+    i;
+
+  size_t
+    length;
+
+  ssize_t
+    count;
+
+  StringInfo
+    *profile;
+
+  unsigned char
+    magick[7];
+
+  /*
+    The binary header is a fixed record of 32-bit words in MSB order, so it
+    reads the same on any platform and is decoded without any parsing.  Its
+    length counts the magic, 34 words, and 15 doubles: 264 bytes.
+  */
+  count=ReadBlob(image,7,magick);
+  if ((count != 7) || (memcmp(magick,MPCMagick+1,7) != 0))
+    return(MagickFalse);
+  mpc_info.version=ReadBlobMSBLong(image);
+  mpc_info.length=ReadBlobMSBLong(image);
+  if ((mpc_info.version != MPCVersion) || (mpc_info.length != MPCInfoLength))
+    return(MagickFalse);
+  mpc_info.quantum_depth=ReadBlobMSBLong(image);
+  mpc_info.storage_class=(ClassType) ReadBlobMSBLong(image);
+  mpc_info.colorspace=(ColorspaceType) ReadBlobMSBLong(image);
+  mpc_info.compression=(CompressionType) ReadBlobMSBLong(image);
+  mpc_info.dispose=(DisposeType) ReadBlobMSBLong(image);
+  mpc_info.endian=(EndianType) ReadBlobMSBLong(image);
+  mpc_info.gravity=(GravityType) ReadBlobMSBLong(image);
+  mpc_info.type=(ImageType) ReadBlobMSBLong(image);
+  mpc_info.matte=(MagickBooleanType) ReadBlobMSBLong(image);
+  mpc_info.orientation=(OrientationType) ReadBlobMSBLong(image);
+  mpc_info.rendering_intent=(RenderingIntent) ReadBlobMSBLong(image);
+  mpc_info.units=(ResolutionType) ReadBlobMSBLong(image);
+  mpc_info.columns=ReadBlobMSBLong(image);
+  mpc_info.rows=ReadBlobMSBLong(image);
+  mpc_info.depth=ReadBlobMSBLong(image);
+  mpc_info.colors=ReadBlobMSBLong(image);
+  mpc_info.quality=ReadBlobMSBLong(image);
+  mpc_info.scene=ReadBlobMSBLong(image);
+  mpc_info.iterations=ReadBlobMSBLong(image);
+  mpc_info.delay=ReadBlobMSBLong(image);
+  mpc_info.ticks_per_second=(long) ((int) ReadBlobMSBLong(image));
+  mpc_info.x_resolution=ReadMPCDouble(image);
+  mpc_info.y_resolution=ReadMPCDouble(image);
+  mpc_info.gamma=ReadMPCDouble(image);
+  ReadMPCPrimary(image,&mpc_info.chromaticity.red_primary);
+  ReadMPCPrimary(image,&mpc_info.chromaticity.green_primary);
+  ReadMPCPrimary(image,&mpc_info.chromaticity.blue_primary);
+  ReadMPCPrimary(image,&mpc_info.chromaticity.white_point);
+  ReadMPCRectangle(image,&mpc_info.page);
+  ReadMPCRectangle(image,&mpc_info.tile_offset);
+  mpc_info.number_profiles=ReadBlobMSBLong(image);
+  mpc_info.montage_length=(size_t) ReadBlobMSBLong(image);
+  mpc_info.properties_length=(size_t) ReadBlobMSBLong(image);
+  if (EOFBlob(image) != MagickFalse)
+    return(MagickFalse);
+  /*
+    Reject enumerations out of range, whatever the signedness of the type.
+  */
+  if (((unsigned long) mpc_info.storage_class > PseudoClass) ||
+      ((unsigned long) mpc_info.colorspace > CMYColorspace) ||
+      ((unsigned long) mpc_info.compression > B44ACompression) ||
+      ((unsigned long) mpc_info.dispose > PreviousDispose) ||
+      ((unsigned long) mpc_info.endian > MSBEndian) ||
+      ((unsigned long) mpc_info.gravity > StaticGravity) ||
+      ((unsigned long) mpc_info.type > PaletteBilevelMatteType) ||
+      ((unsigned long) mpc_info.matte > MagickTrue) ||
+      ((unsigned long) mpc_info.orientation > LeftBottomOrientation) ||
+      ((unsigned long) mpc_info.rendering_intent > RelativeIntent) ||
+      ((unsigned long) mpc_info.units > PixelsPerCentimeterResolution))
+    return(MagickFalse);
+  *quantum_depth=mpc_info.quantum_depth;
+  image->storage_class=mpc_info.storage_class;
+  image->colorspace=mpc_info.colorspace;
+  if (mpc_info.compression != UndefinedCompression)
+    image->compression=mpc_info.compression;
+  image->dispose=mpc_info.dispose;
+  image->endian=mpc_info.endian;
+  image->gravity=mpc_info.gravity;
+  image->type=mpc_info.type;
+  image->matte=mpc_info.matte;
+  image->orientation=mpc_info.orientation;
+  image->rendering_intent=mpc_info.rendering_intent;
+  image->units=mpc_info.units;
+  image->columns=mpc_info.columns;
+  image->rows=mpc_info.rows;
+  image->depth=mpc_info.depth;
+  image->colors=mpc_info.colors;
+  image->quality=mpc_info.quality;
+  image->scene=mpc_info.scene;
+  image->iterations=mpc_info.iterations;
+  image->delay=mpc_info.delay;
+  image->ticks_per_second=mpc_info.ticks_per_second;
+  image->x_resolution=mpc_info.x_resolution;
+  image->y_resolution=mpc_info.y_resolution;
+  image->gamma=mpc_info.gamma;
+  image->chromaticity=mpc_info.chromaticity;
+  image->page=mpc_info.page;
+  image->tile_offset=mpc_info.tile_offset;
+  if (mpc_info.montage_length != 0)
+    {
+      image->montage=(char *) AcquireQuantumMemory(mpc_info.montage_length+
+        MaxTextExtent,sizeof(*image->montage));
+      if (image->montage == (char *) NULL)
+        return(MagickFalse);
+      count=ReadBlob(image,mpc_info.montage_length,(unsigned char *)
+        image->montage);
+      if (count != (ssize_t) mpc_info.montage_length)
+        return(MagickFalse);
+      image->montage[mpc_info.montage_length]='\0';
+    }
+  if (mpc_info.properties_length != 0)
+    {
+      /*
+        Properties are stored as consecutive NUL-terminated name/value pairs.
+      */
+      properties=(char *) AcquireQuantumMemory(mpc_info.properties_length+1,
+        sizeof(*properties));
+      if (properties == (char *) NULL)
+        return(MagickFalse);
+      count=ReadBlob(image,mpc_info.properties_length,(unsigned char *)
+        properties);
+      if (count != (ssize_t) mpc_info.properties_length)
+        {
+          properties=DestroyString(properties);
+          return(MagickFalse);
+        }
+      properties[mpc_info.properties_length]='\0';
+      p=properties;
+      while (p < (properties+mpc_info.properties_length))
+      {
+        name=p;
+        p+=strlen(p)+1;
+        if (p >= (properties+mpc_info.properties_length))
+          break;
+        (void) SetImageProperty(image,name,p);
+        p+=strlen(p)+1;
+      }
+      properties=DestroyString(properties);
+    }
+  for (i=0; i < mpc_info.number_profiles; i++)
+  {
+    /*
+      Profile names and lengths; the profile data follows the header.
+    */
+    length=(size_t) ReadBlobMSBLong(image);
+    if ((length == 0) || (length >= MaxTextExtent) ||
+        (EOFBlob(image) != MagickFalse))
+      return(MagickFalse);
+    name=AcquireString((char *) NULL);
+    count=ReadBlob(image,length,(unsigned char *) name);
+    name[length]='\0';
+    length=(size_t) ReadBlobMSBLong(image);
+    if (count != (ssize_t) strlen(name))
+      {
+        name=DestroyString(name);
+        return(MagickFalse);
+      }
+    if (*profiles == (LinkedListInfo *) NULL)
+      *profiles=NewLinkedList(0);
+    profile=AcquireStringInfo(length);
+    (void) SetImageProfile(image,name,profile);
+    profile=DestroyStringInfo(profile);
+    (void) AppendValueToLinkedList(*profiles,name);
+  }
+  return(MagickTrue);
+}
+
 static Image *ReadMPCImage(const ImageInfo *image_info,ExceptionInfo *exception)
 {
   char
@@ -162,6 +468,7 @@ static Image *ReadMPCImage(const ImageInfo *image_info,ExceptionInfo *exception)
     *profiles;
 
   MagickBooleanType
+    binary,
     status;
 
   MagickOffsetType
@@ -225,7 +532,16 @@ static Image *ReadMPCImage(const ImageInfo *image_info,ExceptionInfo *exception)
     quantum_depth=MAGICKCORE_QUANTUM_DEPTH;
     image->depth=8;
     image->compression=NoCompression;
-    while ((isgraph(c) != MagickFalse) && (c != (int) ':'))
+    binary=MagickFalse;
+    if (c == (int) ((unsigned char) *MPCMagick))
+      {
+        if (ReadMPCInfo(image,&quantum_depth,&profiles) == MagickFalse)
+          ThrowReaderException(CorruptImageError,"ImproperImageHeader");
+        (void) CopyMagickString(id,"MagickCache",MaxTextExtent);
+        binary=MagickTrue;
+      }
+    while ((binary == MagickFalse) && (isgraph(c) != MagickFalse) &&
+           (c != (int) ':'))
     {
       register char
         *p;
@@ -732,7 +1048,8 @@ static Image *ReadMPCImage(const ImageInfo *image_info,ExceptionInfo *exception)
         c=ReadBlobByte(image);
     }
     options=DestroyString(options);
-    (void) ReadBlobByte(image);
+    if (binary == MagickFalse)
+      (void) ReadBlobByte(image);
     /*
       Verify that required image information is defined.
     */
@@ -908,7 +1225,8 @@ static Image *ReadMPCImage(const ImageInfo *image_info,ExceptionInfo *exception)
     do
     {
       c=ReadBlobByte(image);
-    } while ((isgraph(c) == MagickFalse) && (c != EOF));
+    } while ((isgraph(c) == MagickFalse) && (c != EOF) &&
+             (c != (int) ((unsigned char) *MPCMagick)));
     if (c != EOF)
       {
         /*
@@ -1023,16 +1341,178 @@ ModuleExport void UnregisterMPCImage(void)
 %    o image: the image.
 %
 */
-static MagickBooleanType WriteMPCImage(const ImageInfo *image_info,Image *image)
+
+static void WriteMPCDouble(Image *image,const double value)
 {
-  char
-    buffer[MaxTextExtent],
-    cache_filename[MaxTextExtent];
+  union
+  {
+    MagickSizeType
+      unsigned_value;
+
+    double
+      double_value;
+  } quantum;
+
+  quantum.double_value=value;
+  (void) WriteBlobMSBLong(image,(unsigned int) (quantum.unsigned_value >> 32));
+  (void) WriteBlobMSBLong(image,(unsigned int) quantum.unsigned_value);
+}
 
+static void WriteMPCPrimary(Image *image,const PrimaryInfo *primary)
+{
+  WriteMPCDouble(image,primary->x);
+  WriteMPCDouble(image,primary->y);
+  WriteMPCDouble(image,primary->z);
+}
+
+static void WriteMPCRectangle(Image *image,const RectangleInfo *rectangle)
+{
+  (void) WriteBlobMSBLong(image,(unsigned int) rectangle->width);
+  (void) WriteBlobMSBLong(image,(unsigned int) rectangle->height);
+  (void) WriteBlobMSBLong(image,(unsigned int) rectangle->x);
+  (void) WriteBlobMSBLong(image,(unsigned int) rectangle->y);
+}
+
+static void WriteMPCInfo(Image *image)
+{
   const char
+    *name,
     *property,
     *value;
 
+  const StringInfo
+    *profile;
+
+  MPCInfo
+    mpc_info;
+
+  /*
+    Write the fixed binary header, then the montage, the image properties as
+    NUL-terminated name/value pairs, and the profile names and lengths.
+  */
+  (void) ResetMagickMemory(&mpc_info,0,sizeof(mpc_info));
+  mpc_info.version=MPCVersion;
+  mpc_info.length=MPCInfoLength;
+  mpc_info.quantum_depth=MAGICKCORE_QUANTUM_DEPTH;
+  mpc_info.storage_class=image->storage_class;
+  mpc_info.colorspace=image->colorspace;
+  mpc_info.compression=image->compression;
+  mpc_info.dispose=image->dispose;
+  mpc_info.endian=image->endian;
+  mpc_info.gravity=image->gravity;
+  mpc_info.type=image->type;
+  mpc_info.matte=image->matte;
+  mpc_info.orientation=image->orientation;
+  mpc_info.rendering_intent=image->rendering_intent;
+  mpc_info.units=image->units;
+  mpc_info.columns=image->columns;
+  mpc_info.rows=image->rows;
+  mpc_info.depth=image->depth;
+  mpc_info.colors=image->colors;
+  mpc_info.quality=image->quality;
+  mpc_info.scene=image->scene;
+  mpc_info.iterations=image->iterations;
+  mpc_info.delay=image->delay;
+  mpc_info.ticks_per_second=image->ticks_per_second;
+  mpc_info.x_resolution=image->x_resolution;
+  mpc_info.y_resolution=image->y_resolution;
+  mpc_info.gamma=image->gamma;
+  mpc_info.chromaticity=image->chromaticity;
+  mpc_info.page=image->page;
+  mpc_info.tile_offset=image->tile_offset;
+  if (image->montage != (char *) NULL)
+    mpc_info.montage_length=strlen(image->montage);
+  ResetImagePropertyIterator(image);
+  property=GetNextImageProperty(image);
+  while (property != (const char *) NULL)
+  {
+    value=GetImageProperty(image,property);
+    mpc_info.properties_length+=strlen(property)+1;
+    if (value != (const char *) NULL)
+      mpc_info.properties_length+=strlen(value);
+    mpc_info.properties_length++;
+    property=GetNextImageProperty(image);
+  }
+  ResetImageProfileIterator(image);
+  name=GetNextImageProfile(image);
+  while (name != (const char *) NULL)
+  {
+    if (GetImageProfile(image,name) != (StringInfo *) NULL)
+      mpc_info.number_profiles++;
+    name=GetNextImageProfile(image);
+  }
+  (void) WriteBlob(image,8,(const unsigned char *) MPCMagick);
+  (void) WriteBlobMSBLong(image,(unsigned int) mpc_info.version);
+  (void) WriteBlobMSBLong(image,(unsigned int) mpc_info.length);
+  (void) WriteBlobMSBLong(image,(unsigned int) mpc_info.quantum_depth);
+  (void) WriteBlobMSBLong(image,(unsigned int) mpc_info.storage_class);
+  (void) WriteBlobMSBLong(image,(unsigned int) mpc_info.colorspace);
+  (void) WriteBlobMSBLong(image,(unsigned int) mpc_info.compression);
+  (void) WriteBlobMSBLong(image,(unsigned int) mpc_info.dispose);
+  (void) WriteBlobMSBLong(image,(unsigned int) mpc_info.endian);
+  (void) WriteBlobMSBLong(image,(unsigned int) mpc_info.gravity);
+  (void) WriteBlobMSBLong(image,(unsigned int) mpc_info.type);
+  (void) WriteBlobMSBLong(image,(unsigned int) mpc_info.matte);
+  (void) WriteBlobMSBLong(image,(unsigned int) mpc_info.orientation);
+  (void) WriteBlobMSBLong(image,(unsigned int) mpc_info.rendering_intent);
+  (void) WriteBlobMSBLong(image,(unsigned int) mpc_info.units);
+  (void) WriteBlobMSBLong(image,(unsigned int) mpc_info.columns);
+  (void) WriteBlobMSBLong(image,(unsigned int) mpc_info.rows);
+  (void) WriteBlobMSBLong(image,(unsigned int) mpc_info.depth);
+  (void) WriteBlobMSBLong(image,(unsigned int) mpc_info.colors);
+  (void) WriteBlobMSBLong(image,(unsigned int) mpc_info.quality);
+  (void) WriteBlobMSBLong(image,(unsigned int) mpc_info.scene);
+  (void) WriteBlobMSBLong(image,(unsigned int) mpc_info.iterations);
+  (void) WriteBlobMSBLong(image,(unsigned int) mpc_info.delay);
+  (void) WriteBlobMSBLong(image,(unsigned int) mpc_info.ticks_per_second);
+  WriteMPCDouble(image,mpc_info.x_resolution);
+  WriteMPCDouble(image,mpc_info.y_resolution);
+  WriteMPCDouble(image,mpc_info.gamma);
+  WriteMPCPrimary(image,&mpc_info.chromaticity.red_primary);
+  WriteMPCPrimary(image,&mpc_info.chromaticity.green_primary);
+  WriteMPCPrimary(image,&mpc_info.chromaticity.blue_primary);
+  WriteMPCPrimary(image,&mpc_info.chromaticity.white_point);
+  WriteMPCRectangle(image,&mpc_info.page);
+  WriteMPCRectangle(image,&mpc_info.tile_offset);
+  (void) WriteBlobMSBLong(image,(unsigned int) mpc_info.number_profiles);
+  (void) WriteBlobMSBLong(image,(unsigned int) mpc_info.montage_length);
+  (void) WriteBlobMSBLong(image,(unsigned int) mpc_info.properties_length);
+  if (image->montage != (char *) NULL)
+    (void) WriteBlob(image,mpc_info.montage_length,(const unsigned char *)
+      image->montage);
+  ResetImagePropertyIterator(image);
+  property=GetNextImageProperty(image);
+  while (property != (const char *) NULL)
+  {
+    value=GetImageProperty(image,property);
+    (void) WriteBlob(image,strlen(property)+1,(const unsigned char *)
+      property);
+    if (value != (const char *) NULL)
+      (void) WriteBlob(image,strlen(value),(const unsigned char *) value);
+    (void) WriteBlobByte(image,'\0');
+    property=GetNextImageProperty(image);
+  }
+  ResetImageProfileIterator(image);
+  name=GetNextImageProfile(image);
+  while (name != (const char *) NULL)
+  {
+    profile=GetImageProfile(image,name);
+    if (profile != (StringInfo *) NULL)
+      {
+        (void) WriteBlobMSBLong(image,(unsigned long) strlen(name));
+        (void) WriteBlob(image,strlen(name),(const unsigned char *) name);
+        (void) WriteBlobMSBLong(image,(unsigned long)
+          GetStringInfoLength(profile));
+      }
+    name=GetNextImageProfile(image);
+  }
+}
+
+static MagickBooleanType WriteMPCImage(const ImageInfo *image_info,Image *image)
+{
+  char
+    cache_filename[MaxTextExtent];
+
   MagickBooleanType
     status;
 
@@ -1071,218 +1551,7 @@ static MagickBooleanType WriteMPCImage(const ImageInfo *image_info,Image *image)
     if ((image->storage_class == PseudoClass) &&
         (image->colors > (1UL << depth)))
       image->storage_class=DirectClass;
-    (void) WriteBlobString(image,"id=MagickCache\n");
-    (void) FormatMagickString(buffer,MaxTextExtent,"quantum-depth=%d\n",
-      MAGICKCORE_QUANTUM_DEPTH);
-    (void) WriteBlobString(image,buffer);
-    (void) FormatMagickString(buffer,MaxTextExtent,
-      "class=%s  colors=%lu  matte=%s\n",MagickOptionToMnemonic(
-      MagickClassOptions,image->storage_class),image->colors,
-      MagickOptionToMnemonic(MagickBooleanOptions,(long) image->matte));
-    (void) WriteBlobString(image,buffer);
-    (void) FormatMagickString(buffer,MaxTextExtent,
-      "columns=%lu  rows=%lu  depth=%lu\n",image->columns,image->rows,
-      image->depth);
-    (void) WriteBlobString(image,buffer);
-    if (image->type != UndefinedType)
-      {
-        (void) FormatMagickString(buffer,MaxTextExtent,"type=%s\n",
-          MagickOptionToMnemonic(MagickTypeOptions,image->type));
-        (void) WriteBlobString(image,buffer);
-      }
-    if (image->colorspace != UndefinedColorspace)
-      {
-        (void) FormatMagickString(buffer,MaxTextExtent,"colorspace=%s\n",
-          MagickOptionToMnemonic(MagickColorspaceOptions,image->colorspace));
-        (void) WriteBlobString(image,buffer);
-      }
-    if (image->endian != UndefinedEndian)
-      {
-        (void) FormatMagickString(buffer,MaxTextExtent,"endian=%s\n",
-          MagickOptionToMnemonic(MagickEndianOptions,image->endian));
-        (void) WriteBlobString(image,buffer);
-      }
-    if (image->compression != UndefinedCompression)
-      {
-        (void) FormatMagickString(buffer,MaxTextExtent,
-          "compression=%s  quality=%lu\n",MagickOptionToMnemonic(
-          MagickCompressOptions,image->compression),image->quality);
-        (void) WriteBlobString(image,buffer);
-      }
-    if (image->units != UndefinedResolution)
-      {
-        (void) FormatMagickString(buffer,MaxTextExtent,"units=%s\n",
-          MagickOptionToMnemonic(MagickResolutionOptions,image->units));
-        (void) WriteBlobString(image,buffer);
-      }
-    if ((image->x_resolution != 0) || (image->y_resolution != 0))
-      {
-        (void) FormatMagickString(buffer,MaxTextExtent,"resolution=%gx%g\n",
-          image->x_resolution,image->y_resolution);
-        (void) WriteBlobString(image,buffer);
-      }
-    if ((image->page.width != 0) || (image->page.height != 0))
-      {
-        (void) FormatMagickString(buffer,MaxTextExtent,"page=%lux%lu%+ld%+ld\n",
-          image->page.width,image->page.height,image->page.x,image->page.y);
-        (void) WriteBlobString(image,buffer);
-      }
-    else
-      if ((image->page.x != 0) || (image->page.y != 0))
-        {
-          (void) FormatMagickString(buffer,MaxTextExtent,"page=%+ld%+ld\n",
-            image->page.x,image->page.y);
-          (void) WriteBlobString(image,buffer);
-        }
-    if ((image->page.x != 0) || (image->page.y != 0))
-      {
-        (void) FormatMagickString(buffer,MaxTextExtent,"tile-offset=%+ld%+ld\n",
-          image->tile_offset.x,image->tile_offset.y);
-        (void) WriteBlobString(image,buffer);
-      }
-    if ((GetNextImageInList(image) != (Image *) NULL) ||
-        (GetPreviousImageInList(image) != (Image *) NULL))
-      {
-        if (image->scene == 0)
-          (void) FormatMagickString(buffer,MaxTextExtent,
-            "iterations=%lu  delay=%lu  ticks-per-second=%lu\n",
-            image->iterations,image->delay,image->ticks_per_second);
-        else
-          (void) FormatMagickString(buffer,MaxTextExtent,
-            "scene=%lu  iterations=%lu  delay=%lu  ticks-per-second=%lu\n",
-            image->scene,image->iterations,image->delay,
-            image->ticks_per_second);
-        (void) WriteBlobString(image,buffer);
-      }
-    else
-      {
-        if (image->scene != 0)
-          {
-            (void) FormatMagickString(buffer,MaxTextExtent,"scene=%lu\n",
-              image->scene);
-            (void) WriteBlobString(image,buffer);
-          }
-        if (image->iterations != 0)
-          {
-            (void) FormatMagickString(buffer,MaxTextExtent,"iterations=%lu\n",
-              image->iterations);
-            (void) WriteBlobString(image,buffer);
-          }
-        if (image->delay != 0)
-          {
-            (void) FormatMagickString(buffer,MaxTextExtent,"delay=%lu\n",
-              image->delay);
-            (void) WriteBlobString(image,buffer);
-          }
-        if (image->ticks_per_second != UndefinedTicksPerSecond)
-          {
-            (void) FormatMagickString(buffer,MaxTextExtent,
-              "ticks-per-second=%lu\n",image->ticks_per_second);
-            (void) WriteBlobString(image,buffer);
-          }
-      }
-    if (image->gravity != UndefinedGravity)
-      {
-        (void) FormatMagickString(buffer,MaxTextExtent,"gravity=%s\n",
-          MagickOptionToMnemonic(MagickGravityOptions,image->gravity));
-        (void) WriteBlobString(image,buffer);
-      }
-    if (image->dispose != UndefinedDispose)
-      {
-        (void) FormatMagickString(buffer,MaxTextExtent,"dispose=%s\n",
-          MagickOptionToMnemonic(MagickDisposeOptions,image->dispose));
-        (void) WriteBlobString(image,buffer);
-      }
-    if (image->rendering_intent != UndefinedIntent)
-      {
-        (void) FormatMagickString(buffer,MaxTextExtent,
-          "rendering-intent=%s\n",
-           MagickOptionToMnemonic(MagickIntentOptions,image->rendering_intent));
-        (void) WriteBlobString(image,buffer);
-      }
-    if (image->gamma != 0.0)
-      {
-        (void) FormatMagickString(buffer,MaxTextExtent,"gamma=%g\n",
-          image->gamma);
-        (void) WriteBlobString(image,buffer);
-      }
-    if (image->chromaticity.white_point.x != 0.0)
-      {
-        /*
-          Note chomaticity points.
-        */
-        (void) FormatMagickString(buffer,MaxTextExtent,
-          "red-primary=%g,%g  green-primary=%g,%g  blue-primary=%g,%g\n",
-          image->chromaticity.red_primary.x,image->chromaticity.red_primary.y,
-          image->chromaticity.green_primary.x,
-          image->chromaticity.green_primary.y,
-          image->chromaticity.blue_primary.x,
-          image->chromaticity.blue_primary.y);
-        (void) WriteBlobString(image,buffer);
-        (void) FormatMagickString(buffer,MaxTextExtent,"white-point=%g,%g\n",
-          image->chromaticity.white_point.x,image->chromaticity.white_point.y);
-        (void) WriteBlobString(image,buffer);
-      }
-    if (image->orientation != UndefinedOrientation)
-      {
-        (void) FormatMagickString(buffer,MaxTextExtent,
-          "orientation=%s\n",MagickOptionToMnemonic(MagickOrientationOptions,
-          image->orientation));
-        (void) WriteBlobString(image,buffer);
-      }
-    if (image->profiles != (void *) NULL)
-      {
-        const char
-          *name;
-
-        const StringInfo
-          *profile;
-
-        /*
-          Generic profile.
-        */
-        ResetImageProfileIterator(image);
-        for (name=GetNextImageProfile(image); name != (const char *) NULL; )
-        {
-          profile=GetImageProfile(image,name);
-          if (profile != (StringInfo *) NULL)
-            {
-              (void) FormatMagickString(buffer,MaxTextExtent,"profile:%s=%lu\n",
-                name,(unsigned long) GetStringInfoLength(profile));
-              (void) WriteBlobString(image,buffer);
-            }
-          name=GetNextImageProfile(image);
-        }
-      }
-    if (image->montage != (char *) NULL)
-      {
-        (void) FormatMagickString(buffer,MaxTextExtent,"montage=%s\n",
-          image->montage);
-        (void) WriteBlobString(image,buffer);
-      }
-    ResetImagePropertyIterator(image);
-    property=GetNextImageProperty(image);
-    while (property != (const char *) NULL)
-    {
-      (void) FormatMagickString(buffer,MaxTextExtent,"%s=",property);
-      (void) WriteBlobString(image,buffer);
-      value=GetImageProperty(image,property);
-      if (value != (const char *) NULL)
-        {
-          for (i=0; i < (long) strlen(value); i++)
-            if (isspace((int) ((unsigned char) value[i])) != 0)
-              break;
-          if (i <= (long) strlen(value))
-            (void) WriteBlobByte(image,'{');
-          (void) WriteBlob(image,strlen(value),(unsigned char *) value);
-          if (i <= (long) strlen(value))
-            (void) WriteBlobByte(image,'}');
-        }
-      (void) WriteBlobByte(image,'\n');
-      property=GetNextImageProperty(image);
-    }
-    ResetImageArtifactIterator(image);
-    (void) WriteBlobString(image,"\f\n:\032");
+    WriteMPCInfo(image);
     if (image->montage != (char *) NULL)
       {
         /*
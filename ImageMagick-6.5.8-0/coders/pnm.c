@@ -594,7 +594,8 @@ static Image *ReadPNMImage(const ImageInfo *image_info,ExceptionInfo *exception)
         extent=GetQuantumExtent(image,quantum_info,quantum_type);
         image_view=AcquireCacheView(image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT) && (_OPENMP > 200505)
-  #pragma omp parallel for schedule(static,1) shared(row,status,quantum_type)
+  #pragma omp parallel for schedule(static,1) shared(row,status,quantum_type) \
+    if (GetBlobStreamHandler(image) == (StreamHandler) NULL)
 #endif
         for (y=0; y < (long) image->rows; y++)
         {
@@ -676,7 +677,8 @@ static Image *ReadPNMImage(const ImageInfo *image_info,ExceptionInfo *exception)
           ThrowReaderException(ResourceLimitError,"MemoryAllocationFailed");
         image_view=AcquireCacheView(image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT) && (_OPENMP > 200505)
-  #pragma omp parallel for schedule(static,1) shared(row,status,quantum_type)
+  #pragma omp parallel for schedule(static,1) shared(row,status,quantum_type) \
+    if (GetBlobStreamHandler(image) == (StreamHandler) NULL)
 #endif
         for (y=0; y < (long) image->rows; y++)
         {
@@ -794,7 +796,8 @@ static Image *ReadPNMImage(const ImageInfo *image_info,ExceptionInfo *exception)
           ThrowReaderException(ResourceLimitError,"MemoryAllocationFailed");
         image_view=AcquireCacheView(image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT) && (_OPENMP > 200505)
-  #pragma omp parallel for schedule(static,1) shared(row,status,type)
+  #pragma omp parallel for schedule(static,1) shared(row,status,type) \
+    if (GetBlobStreamHandler(image) == (StreamHandler) NULL)
 #endif
         for (y=0; y < (long) image->rows; y++)
         {
@@ -968,7 +971,8 @@ static Image *ReadPNMImage(const ImageInfo *image_info,ExceptionInfo *exception)
           ThrowReaderException(ResourceLimitError,"MemoryAllocationFailed");
         image_view=AcquireCacheView(image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT) && (_OPENMP > 200505)
-  #pragma omp parallel for schedule(static,1) shared(row,status,quantum_type)
+  #pragma omp parallel for schedule(static,1) shared(row,status,quantum_type) \
+    if (GetBlobStreamHandler(image) == (StreamHandler) NULL)
 #endif
         for (y=0; y < (long) image->rows; y++)
         {
@@ -1211,7 +1215,8 @@ static Image *ReadPNMImage(const ImageInfo *image_info,ExceptionInfo *exception)
         extent=GetQuantumExtent(image,quantum_info,quantum_type);
         image_view=AcquireCacheView(image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT) && (_OPENMP > 200505)
-  #pragma omp parallel for schedule(static,1) shared(row,status,quantum_type)
+  #pragma omp parallel for schedule(static,1) shared(row,status,quantum_type) \
+    if (GetBlobStreamHandler(image) == (StreamHandler) NULL)
 #endif
         for (y=0; y < (long) image->rows; y++)
         {
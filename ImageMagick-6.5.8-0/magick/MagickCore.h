@@ -193,6 +193,7 @@ extern "C" {
 #include "magick/mime.h"
 #include "magick/monitor.h"
 #include "magick/montage.h"
+#include "magick/operation.h"
 #include "magick/option.h"
 #include "magick/paint.h"
 #include "magick/pixel.h"
@@ -214,8 +215,10 @@ extern "C" {
 #include "magick/stream.h"
 #include "magick/statistic.h"
 #include "magick/string_.h"
+#include "magick/string-map.h"
 #include "magick/timer.h"
 #include "magick/token.h"
+#include "magick/trace.h"
 #include "magick/transform.h"
 #include "magick/threshold.h"
 #include "magick/type.h"
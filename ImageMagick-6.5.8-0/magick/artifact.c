@@ -64,10 +64,10 @@
 #include "magick/profile.h"
 #include "magick/quantum.h"
 #include "magick/resource_.h"
-#include "magick/splay-tree.h"
 #include "magick/signature-private.h"
 #include "magick/statistic.h"
 #include "magick/string_.h"
+#include "magick/string-map.h"
 #include "magick/token.h"
 #include "magick/utility.h"
 #include "magick/xml-tree.h"
@@ -110,8 +110,7 @@ MagickExport MagickBooleanType CloneImageArtifacts(Image *image,
     (void) LogMagickEvent(TraceEvent,GetMagickModule(),"%s",
       clone_image->filename);
   if (clone_image->artifacts != (void *) NULL)
-    image->artifacts=CloneSplayTree((SplayTreeInfo *) clone_image->artifacts,
-      (void *(*)(void *)) ConstantString,(void *(*)(void *)) ConstantString);
+    image->artifacts=CloneStringMap((StringMapInfo *) clone_image->artifacts);
   return(MagickTrue);
 }
 
@@ -197,7 +196,7 @@ MagickExport MagickBooleanType DeleteImageArtifact(Image *image,
       image->filename);
   if (image->artifacts == (void *) NULL)
     return(MagickFalse);
-  return(DeleteNodeFromSplayTree((SplayTreeInfo *) image->artifacts,artifact));
+  return(DeleteEntryFromStringMap((StringMapInfo *) image->artifacts,artifact));
 }
 
 /*
@@ -231,7 +230,7 @@ MagickExport void DestroyImageArtifacts(Image *image)
     (void) LogMagickEvent(TraceEvent,GetMagickModule(),"%s",
       image->filename);
   if (image->artifacts != (void *) NULL)
-    image->artifacts=(void *) DestroySplayTree((SplayTreeInfo *)
+    image->artifacts=(void *) DestroyStringMap((StringMapInfo *)
       image->artifacts);
 }
 
@@ -272,14 +271,14 @@ MagickExport const char *GetImageArtifact(const Image *image,
   p=(const char *) NULL;
   if (artifact == (const char *) NULL)
     {
-      ResetSplayTreeIterator((SplayTreeInfo *) image->artifacts);
-      p=(const char *) GetNextValueInSplayTree((SplayTreeInfo *)
+      ResetStringMapIterator((StringMapInfo *) image->artifacts);
+      p=(const char *) GetNextValueInStringMap((StringMapInfo *)
         image->artifacts);
       return(p);
     }
   if (image->artifacts != (void *) NULL)
     {
-      p=(const char *) GetValueFromSplayTree((SplayTreeInfo *)
+      p=(const char *) GetValueFromStringMap((StringMapInfo *)
         image->artifacts,artifact);
       if (p != (const char *) NULL)
         return(p);
@@ -318,7 +317,7 @@ MagickExport char *GetNextImageArtifact(const Image *image)
       image->filename);
   if (image->artifacts == (void *) NULL)
     return((char *) NULL);
-  return((char *) GetNextKeyInSplayTree((SplayTreeInfo *) image->artifacts));
+  return((char *) GetNextKeyInStringMap((StringMapInfo *) image->artifacts));
 }
 
 /*
@@ -358,7 +357,7 @@ MagickExport char *RemoveImageArtifact(Image *image,const char *artifact)
       image->filename);
   if (image->artifacts == (void *) NULL)
     return((char *) NULL);
-  value=(char *) RemoveNodeFromSplayTree((SplayTreeInfo *) image->artifacts,
+  value=(char *) RemoveEntryFromStringMap((StringMapInfo *) image->artifacts,
     artifact);
   return(value);
 }
@@ -396,7 +395,7 @@ MagickExport void ResetImageArtifactIterator(const Image *image)
       image->filename);
   if (image->artifacts == (void *) NULL)
     return;
-  ResetSplayTreeIterator((SplayTreeInfo *) image->artifacts);
+  ResetStringMapIterator((StringMapInfo *) image->artifacts);
 }
 
 /*
@@ -438,11 +437,10 @@ MagickExport MagickBooleanType SetImageArtifact(Image *image,
     (void) LogMagickEvent(TraceEvent,GetMagickModule(),"%s",
       image->filename);
   if (image->artifacts == (void *) NULL)
-    image->artifacts=NewSplayTree(CompareSplayTreeString,
-      RelinquishMagickMemory,RelinquishMagickMemory);
+    image->artifacts=NewStringMap();
   if ((value == (const char *) NULL) || (*value == '\0'))
     return(DeleteImageArtifact(image,artifact));
-  status=AddValueToSplayTree((SplayTreeInfo *) image->artifacts,
-    ConstantString(artifact),ConstantString(value));
+  status=PutEntryInStringMap((StringMapInfo *) image->artifacts,
+    artifact,value);
   return(status);
 }
@@ -169,7 +169,8 @@ MagickExport RectangleInfo GetImageBoundingBox(const Image *image,
   status=MagickTrue;
   GetMagickPixelPacket(image,&zero);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(status)
+  #pragma omp parallel for shared(status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
   for (y=0; y < (long) image->rows; y++)
   {
@@ -325,7 +326,8 @@ MagickExport unsigned long GetImageChannelDepth(const Image *image,
 
       p=image->colormap;
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(status)
+  #pragma omp parallel for shared(status) \
+    magick_schedule(PointThreadCost,1,image->colors)
 #endif
       for (i=0; i < (long) image->colors; i++)
       {
@@ -366,7 +368,8 @@ MagickExport unsigned long GetImageChannelDepth(const Image *image,
     }
   image_view=AcquireCacheView(image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(status)
+  #pragma omp parallel for shared(status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
   for (y=0; y < (long) image->rows; y++)
   {
@@ -911,7 +914,8 @@ MagickExport MagickBooleanType SetImageChannelDepth(Image *image,
   exception=(&image->exception);
   image_view=AcquireCacheView(image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(status)
+  #pragma omp parallel for shared(status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
   for (y=0; y < (long) image->rows; y++)
   {
@@ -970,7 +974,8 @@ MagickExport MagickBooleanType SetImageChannelDepth(Image *image,
       p=image->colormap;
       range=GetQuantumRange(depth);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(status)
+  #pragma omp parallel for shared(status) \
+    magick_schedule(PointThreadCost,1,image->colors)
 #endif
       for (i=0; i < (long) image->colors; i++)
       {
@@ -1992,7 +1992,9 @@ MagickExport MagickBooleanType IsBlobTemporary(const Image *image)
 %
 %    o file: map this file descriptor.
 %
-%    o mode: ReadMode, WriteMode, or IOMode.
+%    o mode: ReadMode, WriteMode, IOMode, or PersistMode.  PersistMode maps
+%      the file private and writable: pages are shared with the page cache
+%      until they are first written, then copied.  The file is never updated.
 %
 %    o offset: starting at this offset within the file.
 %
@@ -2047,6 +2049,14 @@ MagickExport unsigned char *MapBlob(int file,const MapMode mode,
         (off_t) offset);
       break;
     }
+    case PersistMode:
+    {
+      protection=PROT_READ | PROT_WRITE;
+      flags|=MAP_PRIVATE;
+      map=(unsigned char *) mmap((char *) NULL,length,protection,flags,file,
+        (off_t) offset);
+      break;
+    }
   }
   if (map == (unsigned char *) MAP_FAILED)
     return((unsigned char *) NULL);
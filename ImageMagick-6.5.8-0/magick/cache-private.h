@@ -24,6 +24,7 @@ extern "C" {
 
 #include <time.h>
 #include "magick/random_.h"
+#include "magick/resource_.h"
 #include "magick/thread-private.h"
 #include "magick/semaphore.h"
 
@@ -125,7 +126,8 @@ typedef struct _CacheInfo
     mode;
 
   MagickBooleanType
-    mapped;
+    mapped,
+    planar;
 
   unsigned long
     columns,
@@ -168,6 +170,9 @@ typedef struct _CacheInfo
   RandomInfo
     *random_info;
 
+  ResourceContext
+    *resource_context;
+
   MagickBooleanType
     debug;
 
@@ -217,6 +222,9 @@ extern MagickExport IndexPacket
   *GetPixelCacheNexusIndexes(const Cache,NexusInfo *);
 
 extern MagickExport MagickBooleanType
+  GetAuthenticPixelPlanes(Image *,const ChannelType,Quantum **,
+    ExceptionInfo *),
+  SetPixelCacheResourceContext(Cache,ResourceContext *),
   SyncAuthenticPixelCacheNexus(Image *,NexusInfo *,ExceptionInfo *);
 
 extern MagickExport MagickSizeType
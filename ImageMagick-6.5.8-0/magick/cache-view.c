@@ -47,6 +47,7 @@
   Include declarations.
 */
 #include "magick/studio.h"
+#include "magick/blob.h"
 #include "magick/cache.h"
 #include "magick/cache-private.h"
 #include "magick/cache-view.h"
@@ -74,6 +75,7 @@ struct _CacheView
     **nexus_info;
 
   MagickBooleanType
+    stream,
     debug;
 
   unsigned long
@@ -94,6 +96,10 @@ struct _CacheView
 %  AcquireCacheView() acquires a view into the pixel cache, using the
 %  VirtualPixelMethod that is defined within the given image itself.
 %
+%  If the image pixels are being read with ReadStream(), authentic pixel
+%  requests are forwarded to the stream so they reach its handler.  Such a
+%  view must then be used by one thread, in scanline order.
+%
 %  The format of the AcquireCacheView method is:
 %
 %      CacheView *AcquireCacheView(const Image *image)
@@ -120,6 +126,10 @@ MagickExport CacheView *AcquireCacheView(const Image *image)
   cache_view->number_threads=GetOpenMPMaximumThreads();
   cache_view->nexus_info=AcquirePixelCacheNexus(cache_view->number_threads);
   cache_view->virtual_pixel_method=GetImageVirtualPixelMethod(image);
+  cache_view->stream=MagickFalse;
+  if ((GetBlobStreamHandler(image) != (StreamHandler) NULL) &&
+      (GetPixelCacheType(image) == UndefinedCache))
+    cache_view->stream=MagickTrue;
   cache_view->debug=IsEventLogging();
   cache_view->signature=MagickSignature;
   if (cache_view->nexus_info == (NexusInfo **) NULL)
@@ -167,6 +177,7 @@ MagickExport CacheView *CloneCacheView(const CacheView *cache_view)
   clone_view->number_threads=cache_view->number_threads;
   clone_view->nexus_info=AcquirePixelCacheNexus(cache_view->number_threads);
   clone_view->virtual_pixel_method=cache_view->virtual_pixel_method;
+  clone_view->stream=cache_view->stream;
   clone_view->debug=cache_view->debug;
   clone_view->signature=MagickSignature;
   return(clone_view);
@@ -402,6 +413,8 @@ MagickExport PixelPacket *GetCacheViewAuthenticPixels(CacheView *cache_view,
   if (cache_view->debug != MagickFalse)
     (void) LogMagickEvent(TraceEvent,GetMagickModule(),"%s",
       cache_view->image->filename);
+  if (cache_view->stream != MagickFalse)
+    return(GetAuthenticPixels(cache_view->image,x,y,columns,rows,exception));
   cache=GetImagePixelCache(cache_view->image,MagickTrue,exception);
   if (cache == (Cache) NULL)
     return((PixelPacket *) NULL);
@@ -513,6 +526,8 @@ MagickExport IndexPacket *GetCacheViewAuthenticIndexQueue(CacheView *cache_view)
     (void) LogMagickEvent(TraceEvent,GetMagickModule(),"%s",
       cache_view->image->filename);
   assert(cache_view->image->cache != (Cache) NULL);
+  if (cache_view->stream != MagickFalse)
+    return(GetAuthenticIndexQueue(cache_view->image));
   id=GetOpenMPThreadId();
   assert(id < (long) cache_view->number_threads);
   indexes=GetPixelCacheNexusIndexes(cache_view->image->cache,
@@ -559,6 +574,8 @@ MagickExport PixelPacket *GetCacheViewAuthenticPixelQueue(CacheView *cache_view)
     (void) LogMagickEvent(TraceEvent,GetMagickModule(),"%s",
       cache_view->image->filename);
   assert(cache_view->image->cache != (Cache) NULL);
+  if (cache_view->stream != MagickFalse)
+    return(GetAuthenticPixelQueue(cache_view->image));
   id=GetOpenMPThreadId();
   assert(id < (long) cache_view->number_threads);
   pixels=GetPixelCacheNexusPixels(cache_view->image->cache,
@@ -887,6 +904,9 @@ MagickExport PixelPacket *QueueCacheViewAuthenticPixels(CacheView *cache_view,
   if (cache_view->debug != MagickFalse)
     (void) LogMagickEvent(TraceEvent,GetMagickModule(),"%s",
       cache_view->image->filename);
+  if (cache_view->stream != MagickFalse)
+    return(QueueAuthenticPixels(cache_view->image,x,y,columns,rows,
+      exception));
   cache=GetImagePixelCache(cache_view->image,MagickFalse,exception);
   if (cache == (Cache) NULL)
     return((PixelPacket *) NULL);
@@ -1013,6 +1033,8 @@ MagickExport MagickBooleanType SyncCacheViewAuthenticPixels(
   if (cache_view->debug != MagickFalse)
     (void) LogMagickEvent(TraceEvent,GetMagickModule(),"%s",
       cache_view->image->filename);
+  if (cache_view->stream != MagickFalse)
+    return(SyncAuthenticPixels(cache_view->image,exception));
   id=GetOpenMPThreadId();
   assert(id < (long) cache_view->number_threads);
   status=SyncAuthenticPixelCacheNexus(cache_view->image,
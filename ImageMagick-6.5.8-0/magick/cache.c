@@ -41,6 +41,7 @@
   Include declarations.
 */
 #include "magick/studio.h"
+#include "magick/artifact.h"
 #include "magick/blob.h"
 #include "magick/blob-private.h"
 #include "magick/cache.h"
@@ -54,6 +55,7 @@
 #include "magick/magick.h"
 #include "magick/memory_.h"
 #include "magick/pixel-private.h"
+#include "magick/policy.h"
 #include "magick/quantum.h"
 #include "magick/random_.h"
 #include "magick/resource_.h"
@@ -61,14 +63,40 @@
 #include "magick/splay-tree.h"
 #include "magick/string_.h"
 #include "magick/thread-private.h"
+#include "magick/trace.h"
 #include "magick/utility.h"
 #if defined(MAGICKCORE_ZLIB_DELEGATE)
 #include "zlib.h"
 #endif
+#if defined(__linux__)
+#include <sys/syscall.h>
+#endif
+
+/*
+  Define declarations.
+*/
+#if defined(__linux__) && defined(SYS_mbind)
+#define MagickNUMASupport  1
+#if !defined(MPOL_PREFERRED)
+#define MPOL_PREFERRED  1
+#define MPOL_INTERLEAVE  3
+#define MPOL_F_MEMS_ALLOWED  (1 << 2)
+#define MPOL_MF_MOVE  (1 << 1)
+#endif
+#endif
+#define CachePlaneAlignment  128
 
 /*
   Typedef declarations.
 */
+typedef enum
+{
+  UndefinedCachePlacement,
+  FirstTouchCachePlacement,
+  InterleaveCachePlacement,
+  BandCachePlacement
+} CachePlacement;
+
 typedef struct _MagickModulo
 {
   long
@@ -143,6 +171,12 @@ static PixelPacket
 static volatile MagickBooleanType
   instantiate_cache = MagickFalse;
 
+static CachePlacement
+  cache_placement = UndefinedCachePlacement;
+
+static MagickBooleanType
+  cache_planar = MagickFalse;
+
 static SemaphoreInfo
   *cache_semaphore = (SemaphoreInfo *) NULL;
 
@@ -199,6 +233,10 @@ MagickExport Cache AcquirePixelCache(const unsigned long number_threads)
   cache_info->semaphore=AllocateSemaphoreInfo();
   cache_info->disk_semaphore=AllocateSemaphoreInfo();
   cache_info->debug=IsEventLogging();
+  cache_info->resource_context=GetThreadResourceContext();
+  if (cache_info->resource_context != (ResourceContext *) NULL)
+    cache_info->resource_context=ReferenceResourceContext(
+      cache_info->resource_context);
   cache_info->signature=MagickSignature;
   if ((cache_resources == (SplayTreeInfo *) NULL) &&
       (instantiate_cache == MagickFalse))
@@ -285,7 +323,35 @@ MagickExport NexusInfo **AcquirePixelCacheNexus(
 */
 MagickExport MagickBooleanType CacheComponentGenesis(void)
 {
+  char
+    *placement,
+    *planar;
+
   AcquireSemaphoreInfo(&cache_semaphore);
+  placement=GetEnvironmentValue("MAGICK_CACHE_PLACEMENT");
+  if (placement == (char *) NULL)
+    placement=GetPolicyValue("cache:placement");
+  if (placement != (char *) NULL)
+    {
+      if (LocaleCompare(placement,"first-touch") == 0)
+        cache_placement=FirstTouchCachePlacement;
+      if (LocaleCompare(placement,"interleave") == 0)
+        cache_placement=InterleaveCachePlacement;
+      if (LocaleCompare(placement,"band") == 0)
+        cache_placement=BandCachePlacement;
+      placement=DestroyString(placement);
+    }
+  if ((cache_placement == FirstTouchCachePlacement) ||
+      (cache_placement == BandCachePlacement))
+    SetMagickThreadScheduleType(StaticThreadSchedule);
+  planar=GetEnvironmentValue("MAGICK_CACHE_PLANAR");
+  if (planar == (char *) NULL)
+    planar=GetPolicyValue("cache:planar");
+  if (planar != (char *) NULL)
+    {
+      cache_planar=IsMagickTrue(planar);
+      planar=DestroyString(planar);
+    }
   return(MagickTrue);
 }
 
@@ -436,7 +502,9 @@ static MagickBooleanType ClipPixelCacheNexus(Image *image,
 %                                                                             %
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 %
-%  ClonePixelCache() clones a pixel cache.
+%  ClonePixelCache() clones a pixel cache.  The clone charges the resource
+%  context of the pixel cache, if it has one, otherwise the context bound to
+%  the calling thread.
 %
 %  The format of the ClonePixelCache() method is:
 %
@@ -465,6 +533,9 @@ MagickExport Cache ClonePixelCache(const Cache cache)
   if (clone_info == (Cache) NULL)
     return((Cache) NULL);
   clone_info->virtual_pixel_method=cache_info->virtual_pixel_method;
+  if (cache_info->resource_context != (ResourceContext *) NULL)
+    (void) SetPixelCacheResourceContext(clone_info,
+      cache_info->resource_context);
   return((Cache ) clone_info);
 }
 
@@ -603,7 +674,8 @@ static MagickBooleanType ClosePixelCacheOnDisk(CacheInfo *cache_info)
   (void) LockSemaphoreInfo(cache_info->disk_semaphore);
   status=close(cache_info->file);
   cache_info->file=(-1);
-  RelinquishMagickResource(FileResource,1);
+  RelinquishResourceContextResource(cache_info->resource_context,FileResource,
+    1);
   (void) UnlockSemaphoreInfo(cache_info->disk_semaphore);
   return(status == -1 ? MagickFalse : MagickTrue);
 }
@@ -716,7 +788,8 @@ static MagickBooleanType OpenPixelCacheOnDisk(CacheInfo *cache_info,
       (void) UnlockSemaphoreInfo(cache_info->disk_semaphore);
       return(MagickFalse);
     }
-  (void) AcquireMagickResource(FileResource,1);
+  (void) AcquireResourceContextResource(cache_info->resource_context,
+    FileResource,1);
   cache_info->file=file;
   cache_info->timestamp=time(0);
   (void) UnlockSemaphoreInfo(cache_info->disk_semaphore);
@@ -1333,9 +1406,80 @@ static MagickBooleanType CloneMemoryToMemoryPixelCache(CacheInfo *clone_info,
   return(MagickTrue);
 }
 
+static MagickBooleanType ClonePlanarPixelCache(CacheInfo *clone_info,
+  CacheInfo *cache_info,ExceptionInfo *exception)
+{
+  MagickBooleanType
+    status;
+
+  NexusInfo
+    clone_nexus,
+    nexus_info;
+
+  register long
+    y;
+
+  size_t
+    length;
+
+  unsigned long
+    columns,
+    rows;
+
+  /*
+    Planar caches are cloned a row at a time through the pixel adapter.
+  */
+  if (cache_info->debug != MagickFalse)
+    (void) LogMagickEvent(CacheEvent,GetMagickModule(),"planar => %s",
+      clone_info->planar != MagickFalse ? "planar" : "packed");
+  columns=(unsigned long) MagickMin(clone_info->columns,cache_info->columns);
+  rows=(unsigned long) MagickMin(clone_info->rows,cache_info->rows);
+  length=(size_t) MagickMax(clone_info->columns,cache_info->columns);
+  (void) ResetMagickMemory(&nexus_info,0,sizeof(nexus_info));
+  nexus_info.pixels=(PixelPacket *) AcquireQuantumMemory(length,
+    sizeof(PixelPacket)+sizeof(IndexPacket));
+  if (nexus_info.pixels == (PixelPacket *) NULL)
+    {
+      (void) ThrowMagickException(exception,GetMagickModule(),CacheError,
+        "MemoryAllocationFailed","`%s'",cache_info->filename);
+      return(MagickFalse);
+    }
+  (void) ResetMagickMemory(nexus_info.pixels,0,length*(sizeof(PixelPacket)+
+    sizeof(IndexPacket)));
+  nexus_info.indexes=(IndexPacket *) (nexus_info.pixels+length);
+  nexus_info.region.width=columns;
+  nexus_info.region.height=1;
+  clone_nexus=nexus_info;
+  clone_nexus.region.width=clone_info->columns;
+  status=MagickTrue;
+  for (y=0; y < (long) rows; y++)
+  {
+    nexus_info.region.y=y;
+    clone_nexus.region.y=y;
+    status=ReadPixelCachePixels(cache_info,&nexus_info,exception);
+    if ((status != MagickFalse) &&
+        (clone_info->active_index_channel != MagickFalse) &&
+        (cache_info->active_index_channel != MagickFalse))
+      status=ReadPixelCacheIndexes(cache_info,&nexus_info,exception);
+    if (status != MagickFalse)
+      status=WritePixelCachePixels(clone_info,&clone_nexus,exception);
+    if ((status != MagickFalse) &&
+        (clone_info->active_index_channel != MagickFalse) &&
+        (cache_info->active_index_channel != MagickFalse))
+      status=WritePixelCacheIndexes(clone_info,&clone_nexus,exception);
+    if (status == MagickFalse)
+      break;
+  }
+  nexus_info.pixels=(PixelPacket *) RelinquishMagickMemory(nexus_info.pixels);
+  return(status);
+}
+
 static MagickBooleanType ClonePixelCachePixels(CacheInfo *clone_info,
   CacheInfo *cache_info,ExceptionInfo *exception)
 {
+  if ((clone_info->planar != MagickFalse) ||
+      (cache_info->planar != MagickFalse))
+    return(ClonePlanarPixelCache(clone_info,cache_info,exception));
   if ((clone_info->type != DiskCache) && (cache_info->type != DiskCache))
     return(CloneMemoryToMemoryPixelCache(clone_info,cache_info,exception));
   if ((clone_info->type == DiskCache) && (cache_info->type == DiskCache))
@@ -1489,26 +1633,35 @@ static inline void RelinquishPixelCachePixels(CacheInfo *cache_info)
   {
     case MemoryCache:
     {
-      if (cache_info->mapped == MagickFalse)
-        cache_info->pixels=(PixelPacket *) RelinquishMagickMemory(
+      if (cache_info->planar != MagickFalse)
+        cache_info->pixels=(PixelPacket *) RelinquishAlignedMemory(
           cache_info->pixels);
       else
-        cache_info->pixels=(PixelPacket *) UnmapBlob(cache_info->pixels,
-          (size_t) cache_info->length);
-      RelinquishMagickResource(MemoryResource,cache_info->length);
+        if (cache_info->mapped == MagickFalse)
+          cache_info->pixels=(PixelPacket *) RelinquishMagickMemory(
+            cache_info->pixels);
+        else
+          cache_info->pixels=(PixelPacket *) UnmapBlob(cache_info->pixels,
+            (size_t) cache_info->length);
+      RelinquishResourceContextResource(cache_info->resource_context,
+        MemoryResource,cache_info->length);
       break;
     }
     case MapCache:
     {
       cache_info->pixels=(PixelPacket *) UnmapBlob(cache_info->pixels,(size_t)
         cache_info->length);
-      RelinquishMagickResource(MapResource,cache_info->length);
+      if (cache_info->mode == PersistMode)
+        break;  /* attached persistent caches are not charged as resources */
+      RelinquishResourceContextResource(cache_info->resource_context,
+        MapResource,cache_info->length);
     }
     case DiskCache:
     {
       if (cache_info->file != -1)
         (void) ClosePixelCacheOnDisk(cache_info);
-      RelinquishMagickResource(DiskResource,cache_info->length);
+      RelinquishResourceContextResource(cache_info->resource_context,
+        DiskResource,cache_info->length);
       break;
     }
     default:
@@ -1516,6 +1669,7 @@ static inline void RelinquishPixelCachePixels(CacheInfo *cache_info)
   }
   cache_info->type=UndefinedCache;
   cache_info->mapped=MagickFalse;
+  cache_info->planar=MagickFalse;
   cache_info->indexes=(IndexPacket *) NULL;
 }
 
@@ -1549,8 +1703,8 @@ MagickExport Cache DestroyPixelCache(Cache cache)
         cache_info->filename);
       (void) LogMagickEvent(CacheEvent,GetMagickModule(),"%s",message);
     }
-  if ((cache_info->mode == ReadMode) || ((cache_info->type != MapCache) &&
-      (cache_info->type != DiskCache)))
+  if ((cache_info->mode == ReadMode) || (cache_info->mode == PersistMode) ||
+      ((cache_info->type != MapCache) && (cache_info->type != DiskCache)))
     RelinquishPixelCachePixels(cache_info);
   else
     {
@@ -1563,6 +1717,9 @@ MagickExport Cache DestroyPixelCache(Cache cache)
       cache_info->number_threads);
   if (cache_info->random_info != (RandomInfo *) NULL)
     cache_info->random_info=DestroyRandomInfo(cache_info->random_info);
+  if (cache_info->resource_context != (ResourceContext *) NULL)
+    cache_info->resource_context=DestroyResourceContext(
+      cache_info->resource_context);
   cache_info->signature=(~MagickSignature);
   if (cache_info->disk_semaphore != (SemaphoreInfo *) NULL)
     DestroySemaphoreInfo(&cache_info->disk_semaphore);
@@ -1757,6 +1914,8 @@ static inline MagickBooleanType IsNexusInCore(const CacheInfo *cache_info,
   MagickOffsetType
     offset;
 
+  if (cache_info->planar != MagickFalse)
+    return(MagickFalse);
   offset=(MagickOffsetType) nexus_info->region.y*cache_info->columns+
     nexus_info->region.x;
   if (nexus_info->pixels != (cache_info->pixels+offset))
@@ -1838,6 +1997,174 @@ static PixelPacket *GetAuthenticPixelsFromCache(const Image *image)
   pixels=GetPixelCacheNexusPixels(image->cache,cache_info->nexus_info[id]);
   return(pixels);
 }
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   G e t A u t h e n t i c P i x e l P l a n e                               %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  GetAuthenticPixelPlane() returns the plane of the requested channel of a
+%  planar pixel cache.  The plane holds image->rows rows of image->columns
+%  quantums and may be updated in place.  NULL is returned if the pixel cache
+%  is not planar, is not in memory, or the image has a clip mask or mask;
+%  fall back to GetAuthenticPixels() in that case.
+%
+%  If the cache:planar artifact is set and the pixel cache is still packed,
+%  the pixel cache is converted to planar storage first.  Call this method
+%  outside of any parallel region.
+%
+%  The format of the GetAuthenticPixelPlane() method is:
+%
+%      Quantum *GetAuthenticPixelPlane(Image *image,const ChannelType channel,
+%        ExceptionInfo *exception)
+%
+%  A description of each parameter follows:
+%
+%    o image: the image.
+%
+%    o channel: the channel: RedChannel, GreenChannel, BlueChannel, or
+%      OpacityChannel.
+%
+%    o exception: return any errors or warnings in this structure.
+%
+*/
+
+static inline long GetPixelCachePlaneIndex(const ChannelType channel)
+{
+  switch (channel)
+  {
+    case RedChannel: return(0);
+    case GreenChannel: return(1);
+    case BlueChannel: return(2);
+    case OpacityChannel: return(3);
+    default: break;
+  }
+  return(-1);
+}
+
+static inline size_t GetPixelCachePlaneExtent(const CacheInfo *cache_info)
+{
+  size_t
+    extent;
+
+  extent=(size_t) cache_info->columns*cache_info->rows*sizeof(Quantum);
+  return((extent+CachePlaneAlignment-1) & ~(CachePlaneAlignment-1));
+}
+
+static inline Quantum *GetPixelCachePlane(const CacheInfo *cache_info,
+  const long plane)
+{
+  /*
+    Plane 4 is the colormap index array that follows the channel planes.
+  */
+  return((Quantum *) ((unsigned char *) cache_info->pixels+plane*
+    GetPixelCachePlaneExtent(cache_info)));
+}
+
+static inline MagickBooleanType IsPixelCachePlanar(const Image *image)
+{
+  const char
+    *value;
+
+  value=GetImageArtifact(image,"cache:planar");
+  if (value == (const char *) NULL)
+    return(cache_planar);
+  return(IsMagickTrue(value));
+}
+
+MagickExport Quantum *GetAuthenticPixelPlane(Image *image,
+  const ChannelType channel,ExceptionInfo *exception)
+{
+  CacheInfo
+    *cache_info;
+
+  long
+    plane;
+
+  assert(image != (Image *) NULL);
+  assert(image->signature == MagickSignature);
+  if (image->debug != MagickFalse)
+    (void) LogMagickEvent(TraceEvent,GetMagickModule(),"%s",image->filename);
+  plane=GetPixelCachePlaneIndex(channel);
+  if ((plane < 0) || (image->clip_mask != (Image *) NULL) ||
+      (image->mask != (Image *) NULL))
+    return((Quantum *) NULL);
+  cache_info=(CacheInfo *) GetImagePixelCache(image,MagickTrue,exception);
+  if (cache_info == (Cache) NULL)
+    return((Quantum *) NULL);
+  if ((cache_info->planar == MagickFalse) &&
+      (cache_info->type == MemoryCache) &&
+      (IsPixelCachePlanar(image) != MagickFalse))
+    if (OpenPixelCache(image,IOMode,exception) == MagickFalse)
+      return((Quantum *) NULL);
+  if ((cache_info->planar == MagickFalse) || (cache_info->type != MemoryCache))
+    return((Quantum *) NULL);
+  return(GetPixelCachePlane(cache_info,plane));
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
++   G e t A u t h e n t i c P i x e l P l a n e s                             %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  GetAuthenticPixelPlanes() returns the planes of the red, green, blue, and
+%  opacity channels requested by channel, with NULL for the others.  It
+%  returns MagickFalse if no such channel is requested or any requested
+%  channel has no plane, in which case the caller takes its packed path.
+%
+%  The format of the GetAuthenticPixelPlanes() method is:
+%
+%      MagickBooleanType GetAuthenticPixelPlanes(Image *image,
+%        const ChannelType channel,Quantum **planes,ExceptionInfo *exception)
+%
+%  A description of each parameter follows:
+%
+%    o image: the image.
+%
+%    o channel: the channel.
+%
+%    o planes: four planes in red, green, blue, opacity order.
+%
+%    o exception: return any errors or warnings in this structure.
+%
+*/
+MagickExport MagickBooleanType GetAuthenticPixelPlanes(Image *image,
+  const ChannelType channel,Quantum **planes,ExceptionInfo *exception)
+{
+  static const ChannelType
+    channels[4] = { RedChannel, GreenChannel, BlueChannel, OpacityChannel };
+
+  MagickBooleanType
+    status;
+
+  register long
+    i;
+
+  status=MagickFalse;
+  for (i=0; i < 4; i++)
+  {
+    planes[i]=(Quantum *) NULL;
+    if ((channel & channels[i]) == 0)
+      continue;
+    planes[i]=GetAuthenticPixelPlane(image,channels[i],exception);
+    if (planes[i] == (Quantum *) NULL)
+      return(MagickFalse);
+    status=MagickTrue;
+  }
+  return(status);
+}
 
 /*
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -2126,6 +2453,23 @@ MagickExport Cache GetImagePixelCache(Image *image,
     ThrowFatalException(ResourceLimitFatalError,"TimeLimitExceeded");
   assert(image->cache != (Cache) NULL);
   cache_info=(CacheInfo *) image->cache;
+  if (cache_info->resource_context != (ResourceContext *) NULL)
+    {
+      /*
+        A request that outlives its time budget fails rather than the process.
+      */
+      time_limit=GetResourceContextLimit(cache_info->resource_context,
+        TimeResource);
+      if ((time_limit != MagickResourceInfinity) &&
+          (GetResourceContextResource(cache_info->resource_context,
+           TimeResource) >= time_limit))
+        {
+          (void) UnlockSemaphoreInfo(image->semaphore);
+          (void) ThrowMagickException(exception,GetMagickModule(),
+            ResourceLimitError,"TimeLimitExceeded","`%s'",image->filename);
+          return((Cache) NULL);
+        }
+    }
   destroy=MagickFalse;
   (void) LockSemaphoreInfo(cache_info->semaphore);
   if ((cache_info->reference_count > 1) || (cache_info->mode == ReadMode))
@@ -3498,6 +3842,61 @@ static const PixelPacket *GetVirtualPixelCache(const Image *image,
     cache_info->nexus_info[id],exception);
   return(pixels);
 }
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   G e t V i r t u a l P i x e l P l a n e                                   %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  GetVirtualPixelPlane() returns the plane of the requested channel of a
+%  planar pixel cache.  The plane holds image->rows rows of image->columns
+%  quantums and must not be updated.  NULL is returned if the pixel cache is
+%  not planar or is not in memory; fall back to GetVirtualPixels() in that
+%  case.
+%
+%  The format of the GetVirtualPixelPlane() method is:
+%
+%      const Quantum *GetVirtualPixelPlane(const Image *image,
+%        const ChannelType channel,ExceptionInfo *exception)
+%
+%  A description of each parameter follows:
+%
+%    o image: the image.
+%
+%    o channel: the channel: RedChannel, GreenChannel, BlueChannel, or
+%      OpacityChannel.
+%
+%    o exception: return any errors or warnings in this structure.
+%
+*/
+MagickExport const Quantum *GetVirtualPixelPlane(const Image *image,
+  const ChannelType channel,ExceptionInfo *magick_unused(exception))
+{
+  CacheInfo
+    *cache_info;
+
+  long
+    plane;
+
+  assert(image != (const Image *) NULL);
+  assert(image->signature == MagickSignature);
+  if (image->debug != MagickFalse)
+    (void) LogMagickEvent(TraceEvent,GetMagickModule(),"%s",image->filename);
+  assert(image->cache != (Cache) NULL);
+  cache_info=(CacheInfo *) image->cache;
+  assert(cache_info->signature == MagickSignature);
+  plane=GetPixelCachePlaneIndex(channel);
+  if ((plane < 0) || (cache_info->planar == MagickFalse) ||
+      (cache_info->type != MemoryCache))
+    return((const Quantum *) NULL);
+  return((const Quantum *) GetPixelCachePlane(cache_info,plane));
+}
 
 /*
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -3863,9 +4262,162 @@ static MagickBooleanType MaskPixelCacheNexus(Image *image,NexusInfo *nexus_info,
 %
 */
 
+#if defined(MagickNUMASupport)
+static void BindPixelCacheMemory(const CacheInfo *cache_info,void *memory,
+  const size_t length,const int policy,const unsigned long *nodes,
+  const unsigned long maximum_nodes)
+{
+  size_t
+    extent,
+    page_size;
+
+  unsigned char
+    *first,
+    *last,
+    *p,
+    *q;
+
+  /*
+    A page straddling two adjacent regions goes with the later one, so the
+    bands of a pixel cache tile its pages without gaps.  Pages the cache
+    shares with other memory at either end are left alone.
+  */
+  page_size=(size_t) GetMagickPageSize();
+  first=(unsigned char *) (((size_t) cache_info->pixels+page_size-1) &
+    ~(page_size-1));
+  last=(unsigned char *) (((size_t) cache_info->pixels+(size_t)
+    cache_info->length) & ~(page_size-1));
+  p=(unsigned char *) ((size_t) memory & ~(page_size-1));
+  q=(unsigned char *) (((size_t) memory+length) & ~(page_size-1));
+  if (p < first)
+    p=first;
+  if (q > last)
+    q=last;
+  if (q <= p)
+    return;
+  extent=(size_t) (q-p);
+  (void) syscall(SYS_mbind,p,extent,policy,nodes,maximum_nodes+1,
+    MPOL_MF_MOVE);
+}
+#endif
+
+static void PlacePixelCachePixels(CacheInfo *cache_info)
+{
+  IndexPacket
+    *indexes;
+
+  long
+    i;
+
+  MagickSizeType
+    band;
+
+  unsigned long
+    planes,
+    threads;
+
+  if ((cache_placement == UndefinedCachePlacement) ||
+      (cache_info->pixels == (PixelPacket *) NULL))
+    return;
+  indexes=(IndexPacket *) (cache_info->pixels+cache_info->columns*
+    cache_info->rows);
+  planes=1;
+  if (cache_info->planar != MagickFalse)
+    {
+      indexes=(IndexPacket *) GetPixelCachePlane(cache_info,4);
+      planes=4;
+    }
+#if defined(MagickNUMASupport)
+  if (cache_placement == InterleaveCachePlacement)
+    {
+      unsigned long
+        nodes[1024/(8*sizeof(unsigned long))];
+
+      (void) ResetMagickMemory(nodes,0,sizeof(nodes));
+      if (syscall(SYS_get_mempolicy,(int *) NULL,nodes,8*sizeof(nodes),
+            (void *) NULL,MPOL_F_MEMS_ALLOWED) == 0)
+        BindPixelCacheMemory(cache_info,cache_info->pixels,(size_t)
+          cache_info->length,MPOL_INTERLEAVE,nodes,8*sizeof(nodes));
+      return;
+    }
+#endif
+  /*
+    Give each thread the band of rows a statically scheduled point operator
+    hands it, so its pages land on the node the thread runs on.
+  */
+  threads=GetMagickThreadCount(PointThreadCost,cache_info->columns,
+    cache_info->rows);
+  band=(cache_info->rows+threads-1)/threads;
+#if defined(MAGICKCORE_OPENMP_SUPPORT) && (_OPENMP >= 200203)
+  #pragma omp parallel for schedule(static,1) num_threads(threads)
+#endif
+  for (i=0; i < (long) threads; i++)
+  {
+    MagickSizeType
+      extent,
+      offset,
+      rows;
+
+    register long
+      j;
+
+    offset=(MagickSizeType) i*band*cache_info->columns;
+    if (((MagickSizeType) i*band) >= cache_info->rows)
+      continue;
+    rows=cache_info->rows-(MagickSizeType) i*band;
+    if (rows > band)
+      rows=band;
+    extent=rows*cache_info->columns*sizeof(PixelPacket);
+    if (cache_info->planar != MagickFalse)
+      extent=rows*cache_info->columns*sizeof(Quantum);
+#if defined(MagickNUMASupport)
+    if (cache_placement == BandCachePlacement)
+      {
+        unsigned int
+          cpu,
+          node;
+
+        unsigned long
+          nodes[1024/(8*sizeof(unsigned long))];
+
+        if (syscall(SYS_getcpu,&cpu,&node,(void *) NULL) != 0)
+          continue;
+        (void) ResetMagickMemory(nodes,0,sizeof(nodes));
+        if (node >= (8*sizeof(nodes)))
+          continue;
+        nodes[node/(8*sizeof(*nodes))]|=1UL << (node % (8*sizeof(*nodes)));
+        for (j=0; j < (long) planes; j++)
+          BindPixelCacheMemory(cache_info,planes == 1 ? (void *)
+            (cache_info->pixels+offset) : (void *) (GetPixelCachePlane(
+            cache_info,j)+offset),(size_t) extent,MPOL_PREFERRED,nodes,
+            8*sizeof(nodes));
+        if (cache_info->active_index_channel != MagickFalse)
+          BindPixelCacheMemory(cache_info,indexes+offset,(size_t) (rows*
+            cache_info->columns*sizeof(IndexPacket)),MPOL_PREFERRED,nodes,
+            8*sizeof(nodes));
+        continue;
+      }
+#endif
+    for (j=0; j < (long) planes; j++)
+      (void) ResetMagickMemory(planes == 1 ? (void *) (cache_info->pixels+
+        offset) : (void *) (GetPixelCachePlane(cache_info,j)+offset),0,
+        (size_t) extent);
+    if (cache_info->active_index_channel != MagickFalse)
+      (void) ResetMagickMemory(indexes+offset,0,(size_t) (rows*
+        cache_info->columns*sizeof(IndexPacket)));
+  }
+}
+
 static inline void AcquirePixelCachePixels(CacheInfo *cache_info)
 {
   cache_info->mapped=MagickFalse;
+  if (cache_info->planar != MagickFalse)
+    {
+      cache_info->pixels=(PixelPacket *) AcquireAlignedMemory(1,(size_t)
+        cache_info->length);
+      PlacePixelCachePixels(cache_info);
+      return;
+    }
   cache_info->pixels=(PixelPacket *) AcquireMagickMemory((size_t)
     cache_info->length);
   if (cache_info->pixels == (PixelPacket *) NULL)
@@ -3874,6 +4426,7 @@ static inline void AcquirePixelCachePixels(CacheInfo *cache_info)
       cache_info->pixels=(PixelPacket *) MapBlob(-1,IOMode,0,(size_t)
         cache_info->length);
     }
+  PlacePixelCachePixels(cache_info);
 }
 
 static MagickBooleanType ExtendCache(Image *image,MagickSizeType length)
@@ -3911,6 +4464,28 @@ static MagickBooleanType ExtendCache(Image *image,MagickSizeType length)
   return(count == (MagickOffsetType) 1 ? MagickTrue : MagickFalse);
 }
 
+static void TracePixelCache(const CacheInfo *source_info,
+  const CacheInfo *cache_info)
+{
+  static const char
+    *cache_types[] = { "Undefined", "Memory", "Map", "Disk" };
+
+  char
+    transition[MaxTextExtent];
+
+  if (IsMagickTraceEnabled(CacheTrace) == MagickFalse)
+    return;
+  TraceMagickEvent(CacheTrace,InstantTracePhase,"OpenPixelCache",
+    cache_types[cache_info->type],cache_info->length);
+  if ((source_info->type == UndefinedCache) ||
+      (source_info->type == cache_info->type))
+    return;
+  (void) FormatMagickString(transition,MaxTextExtent,"%s>%s",
+    cache_types[source_info->type],cache_types[cache_info->type]);
+  TraceMagickEvent(CacheTrace,InstantTracePhase,"PixelCacheTransition",
+    transition,cache_info->length);
+}
+
 static MagickBooleanType OpenPixelCache(Image *image,const MapMode mode,
   ExceptionInfo *exception)
 {
@@ -3942,6 +4517,15 @@ static MagickBooleanType OpenPixelCache(Image *image,const MapMode mode,
   cache_info=(CacheInfo *) image->cache;
   source_info=(*cache_info);
   source_info.file=(-1);
+  if (cache_info->mode == PersistMode)
+    {
+      /*
+        Detach from the persistent cache file; its pixels are cloned below.
+      */
+      *cache_info->cache_filename='\0';
+      cache_info->type=UndefinedCache;
+      cache_info->mapped=MagickFalse;
+    }
   (void) FormatMagickString(cache_info->filename,MaxTextExtent,"%s[%ld]",
     image->filename,GetImageIndexInList(image));
   cache_info->mode=mode;
@@ -3949,6 +4533,7 @@ static MagickBooleanType OpenPixelCache(Image *image,const MapMode mode,
   cache_info->columns=image->columns;
   cache_info->active_index_channel=((image->storage_class == PseudoClass) ||
     (image->colorspace == CMYKColorspace)) ? MagickTrue : MagickFalse;
+  cache_info->planar=MagickFalse;
   number_pixels=(MagickSizeType) cache_info->columns*cache_info->rows;
   packet_size=sizeof(PixelPacket);
   if (cache_info->active_index_channel != MagickFalse)
@@ -3959,11 +4544,23 @@ static MagickBooleanType OpenPixelCache(Image *image,const MapMode mode,
     ThrowBinaryException(ResourceLimitError,"PixelCacheAllocationFailed",
       image->filename);
   cache_info->length=length;
-  status=AcquireMagickResource(AreaResource,cache_info->length);
+  status=AcquireResourceContextResource(cache_info->resource_context,
+    AreaResource,cache_info->length);
   length=number_pixels*(sizeof(PixelPacket)+sizeof(IndexPacket));
   if ((status != MagickFalse) && (length == (MagickSizeType) ((size_t) length)))
     {
-      status=AcquireMagickResource(MemoryResource,cache_info->length);
+      cache_info->planar=IsPixelCachePlanar(image);
+      if (cache_info->planar != MagickFalse)
+        {
+          /*
+            Each channel in its own aligned plane, then the indexes.
+          */
+          cache_info->length=4*GetPixelCachePlaneExtent(cache_info);
+          if (cache_info->active_index_channel != MagickFalse)
+            cache_info->length+=number_pixels*sizeof(IndexPacket);
+        }
+      status=AcquireResourceContextResource(cache_info->resource_context,
+        MemoryResource,cache_info->length);
       if (((cache_info->type == UndefinedCache) && (status != MagickFalse)) ||
           (cache_info->type == MemoryCache))
         {
@@ -3990,32 +4587,45 @@ static MagickBooleanType OpenPixelCache(Image *image,const MapMode mode,
               cache_info->type=MemoryCache;
               cache_info->indexes=(IndexPacket *) NULL;
               if (cache_info->active_index_channel != MagickFalse)
-                cache_info->indexes=(IndexPacket *) (cache_info->pixels+
-                  number_pixels);
+                {
+                  cache_info->indexes=(IndexPacket *) (cache_info->pixels+
+                    number_pixels);
+                  if (cache_info->planar != MagickFalse)
+                    cache_info->indexes=(IndexPacket *)
+                      GetPixelCachePlane(cache_info,4);
+                }
               if (source_info.storage_class != UndefinedClass)
                 {
                   status|=ClonePixelCachePixels(cache_info,&source_info,
                     exception);
                   RelinquishPixelCachePixels(&source_info);
                 }
+              TracePixelCache(&source_info,cache_info);
               return(MagickTrue);
             }
         }
-      RelinquishMagickResource(MemoryResource,cache_info->length);
+      RelinquishResourceContextResource(cache_info->resource_context,
+        MemoryResource,cache_info->length);
+      cache_info->planar=MagickFalse;
+      cache_info->length=number_pixels*packet_size;
     }
   /*
     Create pixel cache on disk.
   */
-  status=AcquireMagickResource(DiskResource,cache_info->length);
+  status=AcquireResourceContextResource(cache_info->resource_context,
+    DiskResource,cache_info->length);
   if (status == MagickFalse)
     {
+      RelinquishResourceContextResource(cache_info->resource_context,
+        DiskResource,cache_info->length);
       (void) ThrowMagickException(exception,GetMagickModule(),CacheError,
         "CacheResourcesExhausted","`%s'",image->filename);
       return(MagickFalse);
     }
   if (OpenPixelCacheOnDisk(cache_info,mode) == MagickFalse)
     {
-      RelinquishMagickResource(DiskResource,cache_info->length);
+      RelinquishResourceContextResource(cache_info->resource_context,
+        DiskResource,cache_info->length);
       ThrowFileException(exception,CacheError,"UnableToOpenPixelCache",
         image->filename);
       return(MagickFalse);
@@ -4031,12 +4641,14 @@ static MagickBooleanType OpenPixelCache(Image *image,const MapMode mode,
   cache_info->storage_class=image->storage_class;
   cache_info->colorspace=image->colorspace;
   length=number_pixels*(sizeof(PixelPacket)+sizeof(IndexPacket));
-  status=AcquireMagickResource(AreaResource,cache_info->length);
+  status=AcquireResourceContextResource(cache_info->resource_context,
+    AreaResource,cache_info->length);
   if ((status == MagickFalse) || (length != (MagickSizeType) ((size_t) length)))
     cache_info->type=DiskCache;
   else
     {
-      status=AcquireMagickResource(MapResource,cache_info->length);
+      status=AcquireResourceContextResource(cache_info->resource_context,
+        MapResource,cache_info->length);
       if ((status == MagickFalse) && (cache_info->type != MapCache) &&
           (cache_info->type != MemoryCache))
         cache_info->type=DiskCache;
@@ -4078,10 +4690,12 @@ static MagickBooleanType OpenPixelCache(Image *image,const MapMode mode,
                   (void) LogMagickEvent(CacheEvent,GetMagickModule(),"%s",
                     message);
                 }
+              TracePixelCache(&source_info,cache_info);
               return(MagickTrue);
             }
         }
-      RelinquishMagickResource(MapResource,cache_info->length);
+      RelinquishResourceContextResource(cache_info->resource_context,
+        MapResource,cache_info->length);
     }
   if ((source_info.type != UndefinedCache) && (mode != ReadMode))
     {
@@ -4097,6 +4711,7 @@ static MagickBooleanType OpenPixelCache(Image *image,const MapMode mode,
         cache_info->rows,format);
       (void) LogMagickEvent(CacheEvent,GetMagickModule(),"%s",message);
     }
+  TracePixelCache(&source_info,cache_info);
   return(MagickTrue);
 }
 
@@ -4138,6 +4753,94 @@ static MagickBooleanType OpenPixelCache(Image *image,const MapMode mode,
 %    o exception: return any errors or warnings in this structure.
 %
 */
+
+static MagickBooleanType MapPersistentPixelCache(Image *image)
+{
+  CacheInfo
+    *cache_info;
+
+  int
+    file;
+
+  MagickSizeType
+    length,
+    number_pixels;
+
+  PixelPacket
+    *pixels;
+
+  size_t
+    packet_size;
+
+  struct stat
+    attributes;
+
+  /*
+    Map the persistent cache private and writable: untouched pages stay
+    shared with every other reader through the page cache, modified pages are
+    copied on write, and no memory, map, or disk resource is charged.
+  */
+  cache_info=(CacheInfo *) image->cache;
+  if ((image->columns == 0) || (image->rows == 0))
+    return(MagickFalse);
+  number_pixels=(MagickSizeType) image->columns*image->rows;
+  packet_size=sizeof(PixelPacket);
+  if ((image->storage_class == PseudoClass) ||
+      (image->colorspace == CMYKColorspace))
+    packet_size+=sizeof(IndexPacket);
+  length=number_pixels*packet_size;
+  if ((length/packet_size/image->rows) != image->columns)
+    return(MagickFalse);
+  if (length != (MagickSizeType) ((size_t) length))
+    return(MagickFalse);
+  file=open(cache_info->cache_filename,O_RDONLY | O_BINARY);
+  if (file == -1)
+    return(MagickFalse);
+  if ((fstat(file,&attributes) != 0) ||
+      ((MagickSizeType) attributes.st_size < ((MagickSizeType)
+       cache_info->offset+length)))
+    {
+      (void) close(file);
+      return(MagickFalse);
+    }
+  pixels=(PixelPacket *) MapBlob(file,PersistMode,cache_info->offset,(size_t)
+    length);
+  (void) close(file);
+  if (pixels == (PixelPacket *) NULL)
+    return(MagickFalse);
+  (void) FormatMagickString(cache_info->filename,MaxTextExtent,"%s[%ld]",
+    image->filename,GetImageIndexInList(image));
+  cache_info->mode=PersistMode;
+  cache_info->type=MapCache;
+  cache_info->mapped=MagickTrue;
+  cache_info->planar=MagickFalse;
+  cache_info->storage_class=image->storage_class;
+  cache_info->colorspace=image->colorspace;
+  cache_info->columns=image->columns;
+  cache_info->rows=image->rows;
+  cache_info->length=length;
+  cache_info->pixels=pixels;
+  cache_info->active_index_channel=packet_size != sizeof(PixelPacket) ?
+    MagickTrue : MagickFalse;
+  cache_info->indexes=(IndexPacket *) NULL;
+  if (cache_info->active_index_channel != MagickFalse)
+    cache_info->indexes=(IndexPacket *) (cache_info->pixels+number_pixels);
+  if (image->debug != MagickFalse)
+    {
+      char
+        format[MaxTextExtent],
+        message[MaxTextExtent];
+
+      (void) FormatMagickSize(cache_info->length,format);
+      (void) FormatMagickString(message,MaxTextExtent,
+        "attach %s (%s, copy-on-write, %lux%lu %s)",cache_info->filename,
+        cache_info->cache_filename,cache_info->columns,cache_info->rows,
+        format);
+      (void) LogMagickEvent(CacheEvent,GetMagickModule(),"%s",message);
+    }
+  return(MagickTrue);
+}
+
 MagickExport MagickBooleanType PersistPixelCache(Image *image,
   const char *filename,const MagickBooleanType attach,MagickOffsetType *offset,
   ExceptionInfo *exception)
@@ -4175,18 +4878,22 @@ MagickExport MagickBooleanType PersistPixelCache(Image *image,
           "attach persistent cache");
       (void) CopyMagickString(cache_info->cache_filename,filename,
         MaxTextExtent);
-      cache_info->type=DiskCache;
       cache_info->offset=(*offset);
-      if (OpenPixelCache(image,ReadMode,exception) == MagickFalse)
-        return(MagickFalse);
+      if (MapPersistentPixelCache(image) == MagickFalse)
+        {
+          cache_info->type=DiskCache;
+          if (OpenPixelCache(image,ReadMode,exception) == MagickFalse)
+            return(MagickFalse);
+        }
       *offset+=cache_info->length+page_size-(cache_info->length % page_size);
       return(MagickTrue);
     }
-  if ((cache_info->mode != ReadMode) && (cache_info->type != MemoryCache) &&
-      (cache_info->reference_count == 1))
+  if ((cache_info->mode != ReadMode) && (cache_info->mode != PersistMode) &&
+      (cache_info->type != MemoryCache) && (cache_info->reference_count == 1))
     {
       (void) LockSemaphoreInfo(cache_info->semaphore);
-      if ((cache_info->mode != ReadMode) && (cache_info->type != MemoryCache) &&
+      if ((cache_info->mode != ReadMode) && (cache_info->mode != PersistMode) &&
+          (cache_info->type != MemoryCache) &&
           (cache_info->reference_count == 1))
         {
           int
@@ -4612,6 +5319,33 @@ static MagickBooleanType ReadPixelCacheIndexes(CacheInfo *cache_info,
 %    o exception: return any errors or warnings in this structure.
 %
 */
+static inline void InterleavePixelCachePlanes(const CacheInfo *cache_info,
+  const MagickOffsetType offset,const unsigned long number_pixels,
+  PixelPacket *__restrict q)
+{
+  register const Quantum
+    *__restrict blue,
+    *__restrict green,
+    *__restrict opacity,
+    *__restrict red;
+
+  register long
+    i;
+
+  red=GetPixelCachePlane(cache_info,0)+offset;
+  green=GetPixelCachePlane(cache_info,1)+offset;
+  blue=GetPixelCachePlane(cache_info,2)+offset;
+  opacity=GetPixelCachePlane(cache_info,3)+offset;
+  for (i=0; i < (long) number_pixels; i++)
+  {
+    q->red=red[i];
+    q->green=green[i];
+    q->blue=blue[i];
+    q->opacity=opacity[i];
+    q++;
+  }
+}
+
 static MagickBooleanType ReadPixelCachePixels(CacheInfo *cache_info,
   NexusInfo *nexus_info,ExceptionInfo *exception)
 {
@@ -4660,6 +5394,17 @@ static MagickBooleanType ReadPixelCachePixels(CacheInfo *cache_info,
       /*
         Read pixels from memory.
       */
+      if (cache_info->planar != MagickFalse)
+        {
+          for (y=0; y < (long) nexus_info->region.height; y++)
+          {
+            InterleavePixelCachePlanes(cache_info,offset,
+              nexus_info->region.width,q);
+            offset+=cache_info->columns;
+            q+=nexus_info->region.width;
+          }
+          break;
+        }
       p=cache_info->pixels+offset;
       for (y=0; y < (long) rows; y++)
       {
@@ -4895,8 +5640,8 @@ static PixelPacket *SetPixelCacheNexusPixels(const Image *image,
   nexus_info->region.height=region->height == 0UL ? 1UL : region->height;
   nexus_info->region.x=region->x;
   nexus_info->region.y=region->y;
-  if ((cache_info->type != DiskCache) && (image->clip_mask == (Image *) NULL) &&
-      (image->mask == (Image *) NULL))
+  if ((cache_info->type != DiskCache) && (cache_info->planar == MagickFalse) &&
+      (image->clip_mask == (Image *) NULL) && (image->mask == (Image *) NULL))
     {
       offset=(MagickOffsetType) nexus_info->region.y*cache_info->columns+
         nexus_info->region.x;
@@ -4965,6 +5710,57 @@ static PixelPacket *SetPixelCacheNexusPixels(const Image *image,
 %                                                                             %
 %                                                                             %
 %                                                                             %
++   S e t P i x e l C a c h e R e s o u r c e C o n t e x t                   %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  SetPixelCacheResourceContext() sets the resource context the pixel cache
+%  charges its area, memory, map, disk and file resources to.  Caches cloned
+%  from it inherit the context.  The context can only be changed before the
+%  pixel cache is opened, MagickFalse is returned otherwise.
+%
+%  The format of the SetPixelCacheResourceContext() method is:
+%
+%      MagickBooleanType SetPixelCacheResourceContext(Cache cache,
+%        ResourceContext *resource_context)
+%
+%  A description of each parameter follows:
+%
+%    o cache: the pixel cache.
+%
+%    o resource_context: the resource context.
+%
+*/
+MagickExport MagickBooleanType SetPixelCacheResourceContext(Cache cache,
+  ResourceContext *resource_context)
+{
+  CacheInfo
+    *cache_info;
+
+  assert(cache != (Cache) NULL);
+  cache_info=(CacheInfo *) cache;
+  assert(cache_info->signature == MagickSignature);
+  if (cache_info->debug != MagickFalse)
+    (void) LogMagickEvent(TraceEvent,GetMagickModule(),"%s",
+      cache_info->filename);
+  if (cache_info->type != UndefinedCache)
+    return(MagickFalse);
+  if (resource_context != (ResourceContext *) NULL)
+    resource_context=ReferenceResourceContext(resource_context);
+  if (cache_info->resource_context != (ResourceContext *) NULL)
+    cache_info->resource_context=DestroyResourceContext(
+      cache_info->resource_context);
+  cache_info->resource_context=resource_context;
+  return(MagickTrue);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
 %   S e t P i x e l C a c h e V i r t u a l M e t h o d                       %
 %                                                                             %
 %                                                                             %
@@ -5323,6 +6119,33 @@ static MagickBooleanType WritePixelCacheIndexes(CacheInfo *cache_info,
 %    o exception: return any errors or warnings in this structure.
 %
 */
+static inline void DeinterleavePixelCachePlanes(const CacheInfo *cache_info,
+  const MagickOffsetType offset,const unsigned long number_pixels,
+  const PixelPacket *__restrict p)
+{
+  register Quantum
+    *__restrict blue,
+    *__restrict green,
+    *__restrict opacity,
+    *__restrict red;
+
+  register long
+    i;
+
+  red=GetPixelCachePlane(cache_info,0)+offset;
+  green=GetPixelCachePlane(cache_info,1)+offset;
+  blue=GetPixelCachePlane(cache_info,2)+offset;
+  opacity=GetPixelCachePlane(cache_info,3)+offset;
+  for (i=0; i < (long) number_pixels; i++)
+  {
+    red[i]=p->red;
+    green[i]=p->green;
+    blue[i]=p->blue;
+    opacity[i]=p->opacity;
+    p++;
+  }
+}
+
 static MagickBooleanType WritePixelCachePixels(CacheInfo *cache_info,
   NexusInfo *nexus_info,ExceptionInfo *exception)
 {
@@ -5371,6 +6194,17 @@ static MagickBooleanType WritePixelCachePixels(CacheInfo *cache_info,
       /*
         Write pixels to memory.
       */
+      if (cache_info->planar != MagickFalse)
+        {
+          for (y=0; y < (long) nexus_info->region.height; y++)
+          {
+            DeinterleavePixelCachePlanes(cache_info,offset,
+              nexus_info->region.width,p);
+            p+=nexus_info->region.width;
+            offset+=cache_info->columns;
+          }
+          break;
+        }
       q=cache_info->pixels+offset;
       for (y=0; y < (long) rows; y++)
       {
@@ -32,6 +32,9 @@ extern MagickExport const PixelPacket
     const unsigned long,ExceptionInfo *),
   *GetVirtualPixelQueue(const Image *);
 
+extern MagickExport const Quantum
+  *GetVirtualPixelPlane(const Image *,const ChannelType,ExceptionInfo *);
+
 extern MagickExport IndexPacket
   *GetAuthenticIndexQueue(const Image *);
 
@@ -59,6 +62,9 @@ extern MagickExport PixelPacket
   *QueueAuthenticPixels(Image *,const long,const long,const unsigned long,
     const unsigned long,ExceptionInfo *);
 
+extern MagickExport Quantum
+  *GetAuthenticPixelPlane(Image *,const ChannelType,ExceptionInfo *);
+
 extern MagickExport VirtualPixelMethod
   GetPixelCacheVirtualMethod(const Image *),
   SetPixelCacheVirtualMethod(const Image *,const VirtualPixelMethod);
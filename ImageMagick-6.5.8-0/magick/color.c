@@ -52,6 +52,7 @@
 #include "magick/exception-private.h"
 #include "magick/gem.h"
 #include "magick/geometry.h"
+#include "magick/hashmap.h"
 #include "magick/image-private.h"
 #include "magick/memory_.h"
 #include "magick/monitor.h"
@@ -780,6 +781,9 @@ static const ColorMapInfo
 /*
   Static declarations.
 */
+static HashmapInfo
+  *color_index = (HashmapInfo *) NULL;
+
 static LinkedListInfo
   *color_list = (LinkedListInfo *) NULL;
 
@@ -861,6 +865,8 @@ MagickExport void ColorComponentTerminus(void)
   if (color_semaphore == (SemaphoreInfo *) NULL)
     AcquireSemaphoreInfo(&color_semaphore);
   (void) LockSemaphoreInfo(color_semaphore);
+  if (color_index != (HashmapInfo *) NULL)
+    color_index=DestroyHashmap(color_index);
   if (color_list != (LinkedListInfo *) NULL)
     color_list=DestroyLinkedList(color_list,DestroyColorElement);
   instantiate_color=MagickFalse;
@@ -880,7 +886,8 @@ MagickExport void ColorComponentTerminus(void)
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 %
 %  GetColorInfo() searches the color list for the specified name and if found
-%  returns attributes for that color.
+%  returns attributes for that color.  The color list is indexed by name when
+%  it is loaded, so the search takes no lock.
 %
 %  The format of the GetColorInfo method is:
 %
@@ -933,22 +940,10 @@ MagickExport const ColorInfo *GetColorInfo(const char *name,
   /*
     Search for color tag.
   */
-  (void) LockSemaphoreInfo(color_semaphore);
-  ResetLinkedListIterator(color_list);
-  p=(const ColorInfo *) GetNextValueInLinkedList(color_list);
-  while (p != (const ColorInfo *) NULL)
-  {
-    if (LocaleCompare(colorname,p->name) == 0)
-      break;
-    p=(const ColorInfo *) GetNextValueInLinkedList(color_list);
-  }
+  p=(const ColorInfo *) GetValueFromHashmap(color_index,colorname);
   if (p == (ColorInfo *) NULL)
     (void) ThrowMagickException(exception,GetMagickModule(),OptionWarning,
       "UnrecognizedColor","`%s'",name);
-  else
-    (void) InsertValueInLinkedList(color_list,0,
-      RemoveElementByValueFromLinkedList(color_list,p));
-  (void) UnlockSemaphoreInfo(color_semaphore);
   return(p);
 }
 
@@ -1452,7 +1447,7 @@ MagickExport void GetColorTuple(const MagickPixelPacket *pixel,
 */
 static MagickBooleanType InitializeColorList(ExceptionInfo *exception)
 {
-  if ((color_list == (LinkedListInfo *) NULL) &&
+  if ((color_index == (HashmapInfo *) NULL) &&
       (instantiate_color == MagickFalse))
     {
       if (color_semaphore == (SemaphoreInfo *) NULL)
@@ -1462,6 +1457,30 @@ static MagickBooleanType InitializeColorList(ExceptionInfo *exception)
           (instantiate_color == MagickFalse))
         {
           (void) LoadColorLists(ColorFilename,exception);
+          if (color_list != (LinkedListInfo *) NULL)
+            {
+              register ColorInfo
+                *p;
+
+              HashmapInfo
+                *index;
+
+              /*
+                Index the colors by name;  the first definition wins.
+              */
+              index=NewHashmap(GetNumberOfElementsInLinkedList(color_list),
+                HashStringType,CompareHashmapString,(void *(*)(void *)) NULL,
+                (void *(*)(void *)) NULL);
+              ResetLinkedListIterator(color_list);
+              p=(ColorInfo *) GetNextValueInLinkedList(color_list);
+              while (p != (ColorInfo *) NULL)
+              {
+                if (GetValueFromHashmap(index,p->name) == (void *) NULL)
+                  (void) PutEntryInHashmap(index,p->name,p);
+                p=(ColorInfo *) GetNextValueInLinkedList(color_list);
+              }
+              color_index=index;
+            }
           instantiate_color=MagickTrue;
         }
       (void) UnlockSemaphoreInfo(color_semaphore);
@@ -64,6 +64,7 @@
 #include "magick/quantum.h"
 #include "magick/semaphore.h"
 #include "magick/string_.h"
+#include "magick/thread-private.h"
 #include "magick/token.h"
 #include "magick/utility.h"
 #include "magick/xml-tree.h"
@@ -119,7 +120,8 @@ MagickExport MagickBooleanType CycleColormapImage(Image *image,
   exception=(&image->exception);
   image_view=AcquireCacheView(image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(status)
+  #pragma omp parallel for shared(status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
   for (y=0; y < (long) image->rows; y++)
   {
@@ -248,7 +250,8 @@ MagickExport MagickBooleanType SortColormapByIntensity(Image *image)
     Assign index values to colormap entries.
   */
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(status)
+  #pragma omp parallel for shared(status) \
+    magick_schedule(PointThreadCost,1,image->colors)
 #endif
   for (i=0; i < (long) image->colors; i++)
     image->colormap[i].opacity=(IndexPacket) i;
@@ -261,7 +264,8 @@ MagickExport MagickBooleanType SortColormapByIntensity(Image *image)
     Update image colormap indexes to sorted colormap order.
   */
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(status)
+  #pragma omp parallel for shared(status) \
+    magick_schedule(PointThreadCost,1,image->colors)
 #endif
   for (i=0; i < (long) image->colors; i++)
     pixels[(long) image->colormap[i].opacity]=(unsigned short) i;
@@ -60,6 +60,7 @@
 #include "magick/quantize.h"
 #include "magick/quantum.h"
 #include "magick/string_.h"
+#include "magick/thread-private.h"
 #include "magick/utility.h"
 
 /*
@@ -224,7 +225,8 @@ MagickExport MagickBooleanType RGBTransformImage(Image *image,
         }
       image_view=AcquireCacheView(image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(status)
+  #pragma omp parallel for shared(status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
       for (y=0; y < (long) image->rows; y++)
       {
@@ -277,7 +279,8 @@ MagickExport MagickBooleanType RGBTransformImage(Image *image,
       GetMagickPixelPacket(image,&zero);
       image_view=AcquireCacheView(image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(status)
+  #pragma omp parallel for shared(status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
       for (y=0; y < (long) image->rows; y++)
       {
@@ -334,7 +337,8 @@ MagickExport MagickBooleanType RGBTransformImage(Image *image,
         }
       image_view=AcquireCacheView(image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(status)
+  #pragma omp parallel for shared(status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
       for (y=0; y < (long) image->rows; y++)
       {
@@ -390,7 +394,8 @@ MagickExport MagickBooleanType RGBTransformImage(Image *image,
         }
       image_view=AcquireCacheView(image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(status)
+  #pragma omp parallel for shared(status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
       for (y=0; y < (long) image->rows; y++)
       {
@@ -446,7 +451,8 @@ MagickExport MagickBooleanType RGBTransformImage(Image *image,
         }
       image_view=AcquireCacheView(image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(status)
+  #pragma omp parallel for shared(status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
       for (y=0; y < (long) image->rows; y++)
       {
@@ -502,7 +508,8 @@ MagickExport MagickBooleanType RGBTransformImage(Image *image,
         }
       image_view=AcquireCacheView(image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(status)
+  #pragma omp parallel for shared(status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
       for (y=0; y < (long) image->rows; y++)
       {
@@ -594,7 +601,8 @@ MagickExport MagickBooleanType RGBTransformImage(Image *image,
       black=pow(10.0,(reference_black-reference_white)*(gamma/density)*
         0.002/0.6);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4)
+  #pragma omp parallel for \
+    magick_schedule(PointThreadCost,1,MaxMap)
 #endif
       for (i=0; i <= (long) MaxMap; i++)
         logmap[i]=ScaleMapToQuantum((MagickRealType) (MaxMap*(reference_white+
@@ -602,7 +610,8 @@ MagickExport MagickBooleanType RGBTransformImage(Image *image,
           0.002/0.6))/1024.0+0.5));
       image_view=AcquireCacheView(image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(status)
+  #pragma omp parallel for shared(status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
       for (y=0; y < (long) image->rows; y++)
       {
@@ -671,7 +680,8 @@ MagickExport MagickBooleanType RGBTransformImage(Image *image,
       primary_info.y=(double) (MaxMap+1.0)/2.0;
       primary_info.z=(double) (MaxMap+1.0)/2.0;
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4)
+  #pragma omp parallel for \
+    magick_schedule(PointThreadCost,1,MaxMap)
 #endif
       for (i=0; i <= (long) MaxMap; i++)
       {
@@ -696,7 +706,8 @@ MagickExport MagickBooleanType RGBTransformImage(Image *image,
           G = 0.29900*R+0.58700*G+0.11400*B
       */
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4)
+  #pragma omp parallel for \
+    magick_schedule(PointThreadCost,1,MaxMap)
 #endif
       for (i=0; i <= (long) MaxMap; i++)
       {
@@ -729,7 +740,8 @@ MagickExport MagickBooleanType RGBTransformImage(Image *image,
       primary_info.y=(double) (MaxMap+1.0)/2.0;
       primary_info.z=(double) (MaxMap+1.0)/2.0;
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4)
+  #pragma omp parallel for \
+    magick_schedule(PointThreadCost,1,MaxMap)
 #endif
       for (i=0; i <= (long) MaxMap; i++)
       {
@@ -753,7 +765,8 @@ MagickExport MagickBooleanType RGBTransformImage(Image *image,
           G = 0.21260*R+0.71520*G+0.07220*B
       */
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4)
+  #pragma omp parallel for \
+    magick_schedule(PointThreadCost,1,MaxMap)
 #endif
       for (i=0; i <= (long) MaxMap; i++)
       {
@@ -784,7 +797,8 @@ MagickExport MagickBooleanType RGBTransformImage(Image *image,
       primary_info.y=(double) (MaxMap+1.0)/2.0;
       primary_info.z=(double) (MaxMap+1.0)/2.0;
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4)
+  #pragma omp parallel for \
+    magick_schedule(PointThreadCost,1,MaxMap)
 #endif
       for (i=0; i <= (long) MaxMap; i++)
       {
@@ -810,7 +824,8 @@ MagickExport MagickBooleanType RGBTransformImage(Image *image,
           B = 0.0*R+0.0*G+1.0*B
       */
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4)
+  #pragma omp parallel for \
+    magick_schedule(PointThreadCost,1,MaxMap)
 #endif
       for (i=0; i <= (long) MaxMap; i++)
       {
@@ -844,7 +859,8 @@ MagickExport MagickBooleanType RGBTransformImage(Image *image,
           Z = 0.0193339*R+0.1191920*G+0.9503041*B
       */
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4)
+  #pragma omp parallel for \
+    magick_schedule(PointThreadCost,1,MaxMap)
 #endif
       for (i=0; i <= (long) MaxMap; i++)
       {
@@ -914,7 +930,8 @@ MagickExport MagickBooleanType RGBTransformImage(Image *image,
       primary_info.y=(double) (MaxMap+1.0)/2.0;
       primary_info.z=(double) (MaxMap+1.0)/2.0;
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4)
+  #pragma omp parallel for \
+    magick_schedule(PointThreadCost,1,MaxMap)
 #endif
       for (i=0; i <= (long) MaxMap; i++)
       {
@@ -945,7 +962,8 @@ MagickExport MagickBooleanType RGBTransformImage(Image *image,
       primary_info.y=(double) (MaxMap+1.0)/2.0;
       primary_info.z=(double) (MaxMap+1.0)/2.0;
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4)
+  #pragma omp parallel for \
+    magick_schedule(PointThreadCost,1,MaxMap)
 #endif
       for (i=0; i <= (long) MaxMap; i++)
       {
@@ -977,7 +995,8 @@ MagickExport MagickBooleanType RGBTransformImage(Image *image,
       primary_info.y=(double) (MaxMap+1.0)/2.0;
       primary_info.z=(double) (MaxMap+1.0)/2.0;
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4)
+  #pragma omp parallel for \
+    magick_schedule(PointThreadCost,1,MaxMap)
 #endif
       for (i=0; i <= (long) MaxMap; i++)
       {
@@ -1007,7 +1026,8 @@ MagickExport MagickBooleanType RGBTransformImage(Image *image,
       */
       image_view=AcquireCacheView(image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(status)
+  #pragma omp parallel for shared(status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
       for (y=0; y < (long) image->rows; y++)
       {
@@ -1420,7 +1440,8 @@ MagickExport MagickBooleanType TransformRGBImage(Image *image,
         }
       image_view=AcquireCacheView(image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(status)
+  #pragma omp parallel for shared(status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
       for (y=0; y < (long) image->rows; y++)
       {
@@ -1476,7 +1497,8 @@ MagickExport MagickBooleanType TransformRGBImage(Image *image,
       GetMagickPixelPacket(image,&zero);
       image_view=AcquireCacheView(image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(status)
+  #pragma omp parallel for shared(status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
       for (y=0; y < (long) image->rows; y++)
       {
@@ -1536,7 +1558,8 @@ MagickExport MagickBooleanType TransformRGBImage(Image *image,
         }
       image_view=AcquireCacheView(image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(status)
+  #pragma omp parallel for shared(status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
       for (y=0; y < (long) image->rows; y++)
       {
@@ -1594,7 +1617,8 @@ MagickExport MagickBooleanType TransformRGBImage(Image *image,
         }
       image_view=AcquireCacheView(image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(status)
+  #pragma omp parallel for shared(status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
       for (y=0; y < (long) image->rows; y++)
       {
@@ -1652,7 +1676,8 @@ MagickExport MagickBooleanType TransformRGBImage(Image *image,
         }
       image_view=AcquireCacheView(image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(status)
+  #pragma omp parallel for shared(status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
       for (y=0; y < (long) image->rows; y++)
       {
@@ -1710,7 +1735,8 @@ MagickExport MagickBooleanType TransformRGBImage(Image *image,
         }
       image_view=AcquireCacheView(image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(status)
+  #pragma omp parallel for shared(status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
       for (y=0; y < (long) image->rows; y++)
       {
@@ -1811,7 +1837,8 @@ MagickExport MagickBooleanType TransformRGBImage(Image *image,
         return(MagickFalse);
       image_view=AcquireCacheView(image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(status)
+  #pragma omp parallel for shared(status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
       for (y=0; y < (long) image->rows; y++)
       {
@@ -1890,7 +1917,8 @@ MagickExport MagickBooleanType TransformRGBImage(Image *image,
         through QuantumRange.
       */
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4)
+  #pragma omp parallel for \
+    magick_schedule(PointThreadCost,1,MaxMap)
 #endif
       for (i=0; i <= (long) MaxMap; i++)
       {
@@ -1925,7 +1953,8 @@ MagickExport MagickBooleanType TransformRGBImage(Image *image,
         through QuantumRange.
       */
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4)
+  #pragma omp parallel for \
+    magick_schedule(PointThreadCost,1,MaxMap)
 #endif
       for (i=0; i <= (long) MaxMap; i++)
       {
@@ -1958,7 +1987,8 @@ MagickExport MagickBooleanType TransformRGBImage(Image *image,
         through QuantumRange.
       */
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4)
+  #pragma omp parallel for \
+    magick_schedule(PointThreadCost,1,MaxMap)
 #endif
       for (i=0; i <= (long) MaxMap; i++)
       {
@@ -1988,7 +2018,8 @@ MagickExport MagickBooleanType TransformRGBImage(Image *image,
           B = 0.0*R+0.0*G+1.0*B
       */
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4)
+  #pragma omp parallel for \
+    magick_schedule(PointThreadCost,1,MaxMap)
 #endif
       for (i=0; i <= (long) MaxMap; i++)
       {
@@ -2014,7 +2045,8 @@ MagickExport MagickBooleanType TransformRGBImage(Image *image,
           B =  0.0556434*X-0.2040259*Y+1.057225*Z
       */
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4)
+  #pragma omp parallel for \
+    magick_schedule(PointThreadCost,1,MaxMap)
 #endif
       for (i=0; i <= (long) MaxMap; i++)
       {
@@ -2042,7 +2074,8 @@ MagickExport MagickBooleanType TransformRGBImage(Image *image,
         YCC is scaled by 1.3584.  C1 zero is 156 and C2 is at 137.
       */
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4)
+  #pragma omp parallel for \
+    magick_schedule(PointThreadCost,1,MaxMap)
 #endif
       for (i=0; i <= (long) MaxMap; i++)
       {
@@ -2075,7 +2108,8 @@ MagickExport MagickBooleanType TransformRGBImage(Image *image,
         through QuantumRange.
       */
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4)
+  #pragma omp parallel for \
+    magick_schedule(PointThreadCost,1,MaxMap)
 #endif
       for (i=0; i <= (long) MaxMap; i++)
       {
@@ -2110,7 +2144,8 @@ MagickExport MagickBooleanType TransformRGBImage(Image *image,
         through QuantumRange.
       */
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4)
+  #pragma omp parallel for \
+    magick_schedule(PointThreadCost,1,MaxMap)
 #endif
       for (i=0; i <= (long) MaxMap; i++)
       {
@@ -2144,7 +2179,8 @@ MagickExport MagickBooleanType TransformRGBImage(Image *image,
         through QuantumRange.
       */
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4)
+  #pragma omp parallel for \
+    magick_schedule(PointThreadCost,1,MaxMap)
 #endif
       for (i=0; i <= (long) MaxMap; i++)
       {
@@ -2178,7 +2214,8 @@ MagickExport MagickBooleanType TransformRGBImage(Image *image,
       */
       image_view=AcquireCacheView(image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(status)
+  #pragma omp parallel for shared(status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
       for (y=0; y < (long) image->rows; y++)
       {
@@ -2287,7 +2324,8 @@ MagickExport MagickBooleanType TransformRGBImage(Image *image,
       */
       image_view=AcquireCacheView(image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(status)
+  #pragma omp parallel for shared(status) \
+    magick_schedule(PointThreadCost,1,image->colors)
 #endif
       for (i=0; i < (long) image->colors; i++)
       {
@@ -63,6 +63,7 @@
 #include "magick/pixel-private.h"
 #include "magick/resource_.h"
 #include "magick/string_.h"
+#include "magick/thread-private.h"
 #include "magick/utility.h"
 #include "magick/version.h"
 
@@ -198,7 +199,8 @@ MagickExport Image *CompareImageChannels(Image *image,
   reconstruct_view=AcquireCacheView(reconstruct_image);
   highlight_view=AcquireCacheView(highlight_image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(status)
+  #pragma omp parallel for shared(status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
   for (y=0; y < (long) image->rows; y++)
   {
@@ -370,7 +372,8 @@ static MagickBooleanType GetAbsoluteError(const Image *image,
   image_view=AcquireCacheView(image);
   reconstruct_view=AcquireCacheView(reconstruct_image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(status)
+  #pragma omp parallel for shared(status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
   for (y=0; y < (long) image->rows; y++)
   {
@@ -486,7 +489,8 @@ static MagickBooleanType GetMeanAbsoluteError(const Image *image,
   image_view=AcquireCacheView(image);
   reconstruct_view=AcquireCacheView(reconstruct_image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(status)
+  #pragma omp parallel for shared(status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
   for (y=0; y < (long) image->rows; y++)
   {
@@ -723,7 +727,8 @@ static MagickBooleanType GetMeanSquaredError(const Image *image,
   image_view=AcquireCacheView(image);
   reconstruct_view=AcquireCacheView(reconstruct_image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(status)
+  #pragma omp parallel for shared(status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
   for (y=0; y < (long) image->rows; y++)
   {
@@ -829,7 +834,8 @@ static MagickBooleanType GetPeakAbsoluteError(const Image *image,
   image_view=AcquireCacheView(image);
   reconstruct_view=AcquireCacheView(reconstruct_image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(status)
+  #pragma omp parallel for shared(status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
   for (y=0; y < (long) image->rows; y++)
   {
@@ -1405,7 +1411,8 @@ static double GetSimilarityMetric(const Image *image,const Image *reference,
   image_view=AcquireCacheView(image);
   reference_view=AcquireCacheView(reference);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(status)
+  #pragma omp parallel for shared(status) \
+    magick_schedule(IntensiveThreadCost,reference->columns,reference->rows)
 #endif
   for (y=0; y < (long) reference->rows; y++)
   {
@@ -1524,7 +1531,9 @@ MagickExport Image *SimilarityImage(Image *image,const Image *reference,
   progress=0;
   similarity_view=AcquireCacheView(similarity_image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(IntensiveThreadCost,similarity_image->columns, \
+      similarity_image->rows)
 #endif
   for (y=0; y < (long) (image->rows-reference->rows+1); y++)
   {
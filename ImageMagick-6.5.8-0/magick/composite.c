@@ -69,6 +69,8 @@
 #include "magick/resample.h"
 #include "magick/resource_.h"
 #include "magick/string_.h"
+#include "magick/thread-private.h"
+#include "magick/trace.h"
 #include "magick/utility.h"
 #include "magick/version.h"
 
@@ -1369,7 +1371,9 @@ MagickExport MagickBooleanType CompositeImageChannel(Image *image,
       image_view=AcquireCacheView(image);
       composite_view=AcquireCacheView(composite_image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-#pragma omp parallel for schedule(dynamic,4) shared(status)
+#pragma omp parallel for shared(status) \
+  magick_schedule(PointThreadCost,composite_image->columns, \
+    composite_image->rows)
 #endif
       for (y=0; y < (long) composite_image->rows; y++)
       {
@@ -1844,8 +1848,11 @@ MagickExport MagickBooleanType CompositeImageChannel(Image *image,
   exception=(&image->exception);
   image_view=AcquireCacheView(image);
   composite_view=AcquireCacheView(composite_image);
+  TraceMagickEvent(OpenMPTrace,BeginTracePhase,"CompositeImageChannel",
+    (const char *) NULL,(MagickSizeType) GetOpenMPMaximumThreads());
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
   for (y=0; y < (long) image->rows; y++)
   {
@@ -2440,6 +2447,8 @@ MagickExport MagickBooleanType CompositeImageChannel(Image *image,
           status=MagickFalse;
       }
   }
+  TraceMagickEvent(OpenMPTrace,EndTracePhase,"CompositeImageChannel",
+    (const char *) NULL,(MagickSizeType) GetOpenMPMaximumThreads());
   composite_view=DestroyCacheView(composite_view);
   image_view=DestroyCacheView(image_view);
   if (destination_image != (Image * ) NULL)
@@ -2507,7 +2516,8 @@ MagickExport MagickBooleanType TextureImage(Image *image,const Image *texture)
         Tile texture onto the image background.
       */
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(status)
+  #pragma omp parallel for shared(status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
       for (y=0; y < (long) image->rows; y+=texture->rows)
       {
@@ -2554,7 +2564,8 @@ MagickExport MagickBooleanType TextureImage(Image *image,const Image *texture)
   image_view=AcquireCacheView(image);
   texture_view=AcquireCacheView(texture);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-#pragma omp parallel for schedule(dynamic,4) shared(status)
+#pragma omp parallel for shared(status) \
+  magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
   for (y=0; y < (long) image->rows; y++)
   {
@@ -41,6 +41,7 @@
 */
 #include "magick/studio.h"
 #include "magick/blob.h"
+#include "magick/blob-private.h"
 #include "magick/client.h"
 #include "magick/configure.h"
 #include "magick/exception.h"
@@ -57,6 +58,8 @@
 /*
   Define declarations.
 */
+#define ConfigureCacheHeaderExtent  (sizeof(ConfigureCacheMagick)-1)
+#define ConfigureCacheMagick  "ImageMagick configure cache 1\n"
 #define ConfigureFilename  "configure.xml"
 
 /*
@@ -78,12 +81,22 @@ static const ConfigureMapInfo
     { "NAME", "ImageMagick" }
   };
 
+static char
+  cache_path[MaxTextExtent];
+
 static LinkedListInfo
   *configure_list = (LinkedListInfo *) NULL;
 
 static SemaphoreInfo
+  *cache_semaphore = (SemaphoreInfo *) NULL,
   *configure_semaphore = (SemaphoreInfo *) NULL;
 
+static size_t
+  cache_length = 0;
+
+static void
+  *cache_map = (void *) NULL;
+
 static volatile MagickBooleanType
   instantiate_configure = MagickFalse;
 
@@ -167,6 +180,11 @@ MagickExport void ConfigureComponentTerminus(void)
   instantiate_configure=MagickFalse;
   (void) UnlockSemaphoreInfo(configure_semaphore);
   DestroySemaphoreInfo(&configure_semaphore);
+  if (cache_map != (void *) NULL)
+    (void) UnmapBlob(cache_map,cache_length);
+  cache_map=(void *) NULL;
+  if (cache_semaphore != (SemaphoreInfo *) NULL)
+    DestroySemaphoreInfo(&cache_semaphore);
 }
 
 /*
@@ -517,6 +535,12 @@ MagickExport char *GetConfigureOption(const char *option)
 %  GetConfigureOptions() returns any Magick configuration options associated
 %  with the specified filename.
 %
+%  If MAGICK_CONFIGURE_CACHE names a file, it is used as a snapshot of the
+%  merged configure sources: a record is reused only while the path, size,
+%  and modify time of every candidate file are unchanged, otherwise the files
+%  are read as usual and the record is rewritten.  The snapshot is in native
+%  byte order and is not meant to be shared between hosts.
+%
 %  The format of the GetConfigureOptions method is:
 %
 %      LinkedListInfo *GetConfigureOptions(const char *filename,
@@ -529,10 +553,303 @@ MagickExport char *GetConfigureOption(const char *option)
 %    o exception: return any errors or warnings in this structure.
 %
 */
+static void *MapConfigureCache(const char *cache,size_t *length)
+{
+  int
+    file;
+
+  MagickOffsetType
+    offset;
+
+  void
+    *map;
+
+  /*
+    Map the configure snapshot and verify its signature.
+  */
+  *length=0;
+  file=open(cache,O_RDONLY | O_BINARY);
+  if (file == -1)
+    return((void *) NULL);
+  offset=(MagickOffsetType) MagickSeek(file,0,SEEK_END);
+  if ((offset < (MagickOffsetType) ConfigureCacheHeaderExtent) ||
+      (offset != (MagickOffsetType) ((ssize_t) offset)))
+    {
+      file=close(file)-1;
+      return((void *) NULL);
+    }
+  map=MapBlob(file,ReadMode,0,(size_t) offset);
+  file=close(file)-1;
+  if (map == (void *) NULL)
+    return((void *) NULL);
+  if (memcmp(map,ConfigureCacheMagick,ConfigureCacheHeaderExtent) != 0)
+    {
+      (void) UnmapBlob(map,(size_t) offset);
+      return((void *) NULL);
+    }
+  *length=(size_t) offset;
+  return(map);
+}
+
+static MagickBooleanType ReadConfigureCacheValue(const unsigned char **datum,
+  size_t *extent,MagickSizeType *value)
+{
+  if (*extent < sizeof(*value))
+    return(MagickFalse);
+  (void) CopyMagickMemory(value,*datum,sizeof(*value));
+  *datum+=sizeof(*value);
+  *extent-=sizeof(*value);
+  return(MagickTrue);
+}
+
+static MagickBooleanType ReadConfigureCacheBlob(const unsigned char **datum,
+  size_t *extent,const unsigned char **blob,size_t *length)
+{
+  MagickSizeType
+    value;
+
+  if (ReadConfigureCacheValue(datum,extent,&value) == MagickFalse)
+    return(MagickFalse);
+  if (value > (MagickSizeType) *extent)
+    return(MagickFalse);
+  *blob=(*datum);
+  *length=(size_t) value;
+  *datum+=(*length);
+  *extent-=(*length);
+  return(MagickTrue);
+}
+
+static void WriteConfigureCacheValue(StringInfo *record,
+  const MagickSizeType value)
+{
+  size_t
+    offset;
+
+  offset=GetStringInfoLength(record);
+  SetStringInfoLength(record,offset+sizeof(value));
+  (void) CopyMagickMemory(GetStringInfoDatum(record)+offset,&value,
+    sizeof(value));
+}
+
+static void WriteConfigureCacheBlob(StringInfo *record,const void *blob,
+  const size_t length)
+{
+  size_t
+    offset;
+
+  WriteConfigureCacheValue(record,(MagickSizeType) length);
+  if (length == 0)
+    return;
+  offset=GetStringInfoLength(record);
+  SetStringInfoLength(record,offset+length);
+  (void) CopyMagickMemory(GetStringInfoDatum(record)+offset,blob,length);
+}
+
+static MagickBooleanType GetConfigureCacheOptions(const char *cache,
+  const char *filename,LinkedListInfo *paths,LinkedListInfo *options)
+{
+  char
+    path[MaxTextExtent];
+
+  const char
+    *element;
+
+  const unsigned char
+    *blob,
+    *datum,
+    *record;
+
+  MagickBooleanType
+    status;
+
+  MagickSizeType
+    exists,
+    modify_time,
+    number_candidates,
+    size;
+
+  size_t
+    extent,
+    length,
+    record_extent;
+
+  StringInfo
+    *xml;
+
+  struct stat
+    attributes;
+
+  /*
+    The snapshot stays mapped until it is rewritten; use a record only if
+    every candidate path is unchanged.
+  */
+  if ((cache_map != (void *) NULL) && (strcmp(cache_path,cache) != 0))
+    {
+      (void) UnmapBlob(cache_map,cache_length);
+      cache_map=(void *) NULL;
+    }
+  if (cache_map == (void *) NULL)
+    {
+      cache_map=MapConfigureCache(cache,&cache_length);
+      (void) CopyMagickString(cache_path,cache,MaxTextExtent);
+    }
+  if (cache_map == (void *) NULL)
+    return(MagickFalse);
+  status=MagickFalse;
+  datum=(const unsigned char *) cache_map+ConfigureCacheHeaderExtent;
+  extent=cache_length-ConfigureCacheHeaderExtent;
+  while (ReadConfigureCacheBlob(&datum,&extent,&record,&record_extent) !=
+         MagickFalse)
+  {
+    if ((ReadConfigureCacheBlob(&record,&record_extent,&blob,&length) ==
+         MagickFalse) || (length != strlen(filename)) ||
+        (memcmp(blob,filename,length) != 0))
+      continue;
+    if (ReadConfigureCacheValue(&record,&record_extent,&number_candidates) ==
+        MagickFalse)
+      break;
+    status=MagickTrue;
+    ResetLinkedListIterator(paths);
+    for ( ; (status != MagickFalse) && (number_candidates != 0);
+          number_candidates--)
+    {
+      element=(const char *) GetNextValueInLinkedList(paths);
+      if (element == (const char *) NULL)
+        {
+          status=MagickFalse;
+          break;
+        }
+      (void) FormatMagickString(path,MaxTextExtent,"%s%s",element,filename);
+      if ((ReadConfigureCacheBlob(&record,&record_extent,&blob,&length) ==
+           MagickFalse) || (length != strlen(path)) ||
+          (memcmp(blob,path,length) != 0) ||
+          (ReadConfigureCacheValue(&record,&record_extent,&exists) ==
+           MagickFalse) ||
+          (ReadConfigureCacheValue(&record,&record_extent,&modify_time) ==
+           MagickFalse) ||
+          (ReadConfigureCacheValue(&record,&record_extent,&size) ==
+           MagickFalse))
+        {
+          status=MagickFalse;
+          break;
+        }
+      if (GetPathAttributes(path,&attributes) == MagickFalse)
+        {
+          if (exists != 0)
+            status=MagickFalse;
+          continue;
+        }
+      if ((exists == 0) ||
+          (modify_time != (MagickSizeType) attributes.st_mtime) ||
+          (size != (MagickSizeType) attributes.st_size) ||
+          (ReadConfigureCacheBlob(&record,&record_extent,&blob,&length) ==
+           MagickFalse) || (length != (size_t) size))
+        {
+          status=MagickFalse;
+          break;
+        }
+      xml=AcquireStringInfo(length);
+      SetStringInfoDatum(xml,blob);
+      GetStringInfoDatum(xml)[length]='\0';
+      SetStringInfoPath(xml,path);
+      (void) AppendValueToLinkedList(options,xml);
+    }
+    if (GetNextValueInLinkedList(paths) != (void *) NULL)
+      status=MagickFalse;
+    break;
+  }
+  if (status == MagickFalse)
+    ClearLinkedList(options,DestroyOptions);
+  return(status);
+}
+
+static void PutConfigureCacheOptions(const char *cache,const char *filename,
+  const StringInfo *record)
+{
+  char
+    path[MaxTextExtent];
+
+  const unsigned char
+    *blob,
+    *datum,
+    *p;
+
+  FILE
+    *file;
+
+  MagickBooleanType
+    status;
+
+  size_t
+    extent,
+    length,
+    map_length,
+    record_extent;
+
+  StringInfo
+    *snapshot;
+
+  void
+    *map;
+
+  /*
+    Carry over the records of other files, then append this one.
+  */
+  snapshot=AcquireStringInfo(ConfigureCacheHeaderExtent);
+  SetStringInfoDatum(snapshot,(const unsigned char *) ConfigureCacheMagick);
+  map=MapConfigureCache(cache,&map_length);
+  if (map != (void *) NULL)
+    {
+      datum=(const unsigned char *) map+ConfigureCacheHeaderExtent;
+      extent=map_length-ConfigureCacheHeaderExtent;
+      while (ReadConfigureCacheBlob(&datum,&extent,&p,&record_extent) !=
+             MagickFalse)
+      {
+        const unsigned char
+          *q;
+
+        size_t
+          q_extent;
+
+        q=p;
+        q_extent=record_extent;
+        if ((ReadConfigureCacheBlob(&q,&q_extent,&blob,&length) !=
+             MagickFalse) && ((length != strlen(filename)) ||
+            (memcmp(blob,filename,length) != 0)))
+          WriteConfigureCacheBlob(snapshot,p,record_extent);
+      }
+      (void) UnmapBlob(map,map_length);
+    }
+  WriteConfigureCacheBlob(snapshot,GetStringInfoDatum(record),
+    GetStringInfoLength(record));
+  /*
+    Write to a private file and rename it so readers never see a torn file.
+  */
+  (void) FormatMagickString(path,MaxTextExtent,"%s.%ld",cache,(long) getpid());
+  file=fopen(path,"wb");
+  if (file != (FILE *) NULL)
+    {
+      length=fwrite(GetStringInfoDatum(snapshot),1,
+        GetStringInfoLength(snapshot),file);
+      status=length == GetStringInfoLength(snapshot) ? MagickTrue : MagickFalse;
+      if (fclose(file) != 0)
+        status=MagickFalse;
+      if ((status == MagickFalse) || (rename(path,cache) != 0))
+        (void) remove(path);
+      if (cache_map != (void *) NULL)
+        {
+          (void) UnmapBlob(cache_map,cache_length);
+          cache_map=(void *) NULL;
+        }
+    }
+  snapshot=DestroyStringInfo(snapshot);
+}
+
 MagickExport LinkedListInfo *GetConfigureOptions(const char *filename,
   ExceptionInfo *exception)
 {
   char
+    *cache,
     path[MaxTextExtent];
 
   const char
@@ -542,9 +859,17 @@ MagickExport LinkedListInfo *GetConfigureOptions(const char *filename,
     *options,
     *paths;
 
+  MagickBooleanType
+    exists,
+    status;
+
   StringInfo
+    *record,
     *xml;
 
+  struct stat
+    attributes;
+
   assert(filename != (const char *) NULL);
   (void) LogMagickEvent(TraceEvent,GetMagickModule(),"%s",filename);
   assert(exception != (ExceptionInfo *) NULL);
@@ -554,22 +879,79 @@ MagickExport LinkedListInfo *GetConfigureOptions(const char *filename,
   */
   options=NewLinkedList(0);
   paths=GetConfigurePaths(filename,exception);
+  cache=GetEnvironmentValue("MAGICK_CONFIGURE_CACHE");
+  if ((cache != (char *) NULL) && (*cache == '\0'))
+    cache=DestroyString(cache);
   if (paths != (LinkedListInfo *) NULL)
     {
+      status=MagickFalse;
+      record=(StringInfo *) NULL;
+      if (cache != (char *) NULL)
+        {
+          if (cache_semaphore == (SemaphoreInfo *) NULL)
+            AcquireSemaphoreInfo(&cache_semaphore);
+          (void) LockSemaphoreInfo(cache_semaphore);
+          status=GetConfigureCacheOptions(cache,filename,paths,options);
+          if (status != MagickFalse)
+            (void) LogMagickEvent(ConfigureEvent,GetMagickModule(),
+              "Loaded configure file \"%s\" from snapshot: \"%s\"",filename,
+              cache);
+          else
+            {
+              record=AcquireStringInfo(0);
+              WriteConfigureCacheBlob(record,filename,strlen(filename));
+              WriteConfigureCacheValue(record,(MagickSizeType)
+                GetNumberOfElementsInLinkedList(paths));
+            }
+        }
       ResetLinkedListIterator(paths);
       element=(const char *) GetNextValueInLinkedList(paths);
-      while (element != (const char *) NULL)
+      while ((status == MagickFalse) && (element != (const char *) NULL))
       {
         (void) FormatMagickString(path,MaxTextExtent,"%s%s",element,filename);
         (void) LogMagickEvent(ConfigureEvent,GetMagickModule(),
           "Searching for configure file: \"%s\"",path);
+        exists=MagickFalse;
+        if (record != (StringInfo *) NULL)
+          {
+            /*
+              Stat before reading: a file modified in between then fails the
+              next validation rather than caching stale content.
+            */
+            (void) ResetMagickMemory(&attributes,0,sizeof(attributes));
+            exists=GetPathAttributes(path,&attributes);
+            WriteConfigureCacheBlob(record,path,strlen(path));
+            WriteConfigureCacheValue(record,exists != MagickFalse ? 1 : 0);
+            WriteConfigureCacheValue(record,(MagickSizeType)
+              attributes.st_mtime);
+            WriteConfigureCacheValue(record,(MagickSizeType)
+              attributes.st_size);
+          }
         xml=ConfigureFileToStringInfo(path);
+        if ((record != (StringInfo *) NULL) && (exists != MagickFalse))
+          {
+            if ((xml == (StringInfo *) NULL) || (GetStringInfoLength(xml) !=
+                (size_t) attributes.st_size))
+              record=DestroyStringInfo(record);
+            else
+              WriteConfigureCacheBlob(record,GetStringInfoDatum(xml),
+                GetStringInfoLength(xml));
+          }
         if (xml != (StringInfo *) NULL)
           (void) AppendValueToLinkedList(options,xml);
         element=(const char *) GetNextValueInLinkedList(paths);
       }
+      if (record != (StringInfo *) NULL)
+        {
+          PutConfigureCacheOptions(cache,filename,record);
+          record=DestroyStringInfo(record);
+        }
+      if (cache != (char *) NULL)
+        (void) UnlockSemaphoreInfo(cache_semaphore);
       paths=DestroyLinkedList(paths,RelinquishMagickMemory);
     }
+  if (cache != (char *) NULL)
+    cache=DestroyString(cache);
 #if defined(__WINDOWS__)
   {
     char
@@ -68,6 +68,7 @@
 #include "magick/stream.h"
 #include "magick/string_.h"
 #include "magick/timer.h"
+#include "magick/trace.h"
 #include "magick/transform.h"
 #include "magick/utility.h"
 
@@ -428,6 +429,9 @@ MagickExport Image *ReadImage(const ImageInfo *image_info,
   PolicyRights
     rights;
 
+  ResourceContext
+    *resource_context;
+
   /*
     Determine image type from filename prefix or suffix (e.g. image.jpg).
   */
@@ -511,13 +515,21 @@ MagickExport Image *ReadImage(const ImageInfo *image_info,
   image=NewImageList();
   if (constitute_semaphore == (SemaphoreInfo *) NULL)
     AcquireSemaphoreInfo(&constitute_semaphore);
+  resource_context=GetThreadResourceContext();
+  if (read_info->resource_context != (ResourceContext *) NULL)
+    (void) SetThreadResourceContext(read_info->resource_context);
   if ((magick_info != (const MagickInfo *) NULL) &&
       (GetImageDecoder(magick_info) != (DecodeImageHandler *) NULL))
     {
       thread_support=GetMagickThreadSupport(magick_info);
       if ((thread_support & DecoderThreadSupport) == 0)
         (void) LockSemaphoreInfo(constitute_semaphore);
+      TraceMagickEvent(CoderTrace,BeginTracePhase,"ReadImage",
+        magick_info->name,0);
       image=GetImageDecoder(magick_info)(read_info,exception);
+      TraceMagickEvent(CoderTrace,EndTracePhase,"ReadImage",magick_info->name,
+        image != (Image *) NULL ? (MagickSizeType) image->columns*image->rows :
+        0);
       if ((thread_support & DecoderThreadSupport) == 0)
         (void) UnlockSemaphoreInfo(constitute_semaphore);
     }
@@ -532,6 +544,7 @@ MagickExport Image *ReadImage(const ImageInfo *image_info,
               read_info->filename);
           if (read_info->temporary != MagickFalse)
             (void) RelinquishUniqueFileResource(read_info->filename);
+          (void) SetThreadResourceContext(resource_context);
           read_info=DestroyImageInfo(read_info);
           return((Image *) NULL);
         }
@@ -541,6 +554,7 @@ MagickExport Image *ReadImage(const ImageInfo *image_info,
       image=AcquireImage(read_info);
       if (image == (Image *) NULL)
         {
+          (void) SetThreadResourceContext(resource_context);
           read_info=DestroyImageInfo(read_info);
           return((Image *) NULL);
         }
@@ -567,16 +581,23 @@ MagickExport Image *ReadImage(const ImageInfo *image_info,
           else
             ThrowFileException(exception,FileOpenError,"UnableToOpenFile",
               read_info->filename);
+          (void) SetThreadResourceContext(resource_context);
           read_info=DestroyImageInfo(read_info);
           return((Image *) NULL);
         }
       thread_support=GetMagickThreadSupport(magick_info);
       if ((thread_support & DecoderThreadSupport) == 0)
         (void) LockSemaphoreInfo(constitute_semaphore);
+      TraceMagickEvent(CoderTrace,BeginTracePhase,"ReadImage",
+        magick_info->name,0);
       image=(Image *) (GetImageDecoder(magick_info))(read_info,exception);
+      TraceMagickEvent(CoderTrace,EndTracePhase,"ReadImage",magick_info->name,
+        image != (Image *) NULL ? (MagickSizeType) image->columns*image->rows :
+        0);
       if ((thread_support & DecoderThreadSupport) == 0)
         (void) UnlockSemaphoreInfo(constitute_semaphore);
     }
+  (void) SetThreadResourceContext(resource_context);
   if (read_info->temporary != MagickFalse)
     {
       (void) RelinquishUniqueFileResource(read_info->filename);
@@ -993,6 +1014,9 @@ MagickExport MagickBooleanType WriteImage(const ImageInfo *image_info,
   PolicyRights
     rights;
 
+  ResourceContext
+    *resource_context;
+
   /*
     Determine image type from filename prefix or suffix (e.g. image.jpg).
   */
@@ -1101,6 +1125,9 @@ MagickExport MagickBooleanType WriteImage(const ImageInfo *image_info,
     }
   if (constitute_semaphore == (SemaphoreInfo *) NULL)
     AcquireSemaphoreInfo(&constitute_semaphore);
+  resource_context=GetThreadResourceContext();
+  if (write_info->resource_context != (ResourceContext *) NULL)
+    (void) SetThreadResourceContext(write_info->resource_context);
   if ((magick_info != (const MagickInfo *) NULL) &&
       (GetImageEncoder(magick_info) != (EncodeImageHandler *) NULL))
     {
@@ -1110,7 +1137,11 @@ MagickExport MagickBooleanType WriteImage(const ImageInfo *image_info,
       thread_support=GetMagickThreadSupport(magick_info);
       if ((thread_support & EncoderThreadSupport) == 0)
         (void) LockSemaphoreInfo(constitute_semaphore);
+      TraceMagickEvent(CoderTrace,BeginTracePhase,"WriteImage",
+        magick_info->name,(MagickSizeType) image->columns*image->rows);
       status=GetImageEncoder(magick_info)(write_info,image);
+      TraceMagickEvent(CoderTrace,EndTracePhase,"WriteImage",
+        magick_info->name,(MagickSizeType) image->columns*image->rows);
       if ((thread_support & EncoderThreadSupport) == 0)
         (void) UnlockSemaphoreInfo(constitute_semaphore);
     }
@@ -1157,12 +1188,17 @@ MagickExport MagickBooleanType WriteImage(const ImageInfo *image_info,
               thread_support=GetMagickThreadSupport(magick_info);
               if ((thread_support & EncoderThreadSupport) == 0)
                 (void) LockSemaphoreInfo(constitute_semaphore);
+              TraceMagickEvent(CoderTrace,BeginTracePhase,"WriteImage",
+                magick_info->name,(MagickSizeType) image->columns*image->rows);
               status=GetImageEncoder(magick_info)(write_info,image);
+              TraceMagickEvent(CoderTrace,EndTracePhase,"WriteImage",
+                magick_info->name,(MagickSizeType) image->columns*image->rows);
               if ((thread_support & EncoderThreadSupport) == 0)
                 (void) UnlockSemaphoreInfo(constitute_semaphore);
             }
         }
     }
+  (void) SetThreadResourceContext(resource_context);
   if (GetBlobError(image) != MagickFalse)
     ThrowFileException(&image->exception,FileOpenError,
       "AnErrorHasOccurredWritingToFile",image->filename);
@@ -54,6 +54,7 @@
 #include "magick/monitor-private.h"
 #include "magick/pixel-private.h"
 #include "magick/quantum.h"
+#include "magick/thread-private.h"
 #include "magick/transform.h"
 
 /*
@@ -400,7 +401,8 @@ MagickExport Image *FrameImage(const Image *image,const FrameInfo *frame_info,
     Draw sides of ornamental border.
   */
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
   for (y=0; y < (long) image->rows; y++)
   {
@@ -722,7 +724,8 @@ MagickExport MagickBooleanType RaiseImage(Image *image,
   exception=(&image->exception);
   image_view=AcquireCacheView(image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(PointThreadCost,image->columns,raise_info->height)
 #endif
   for (y=0; y < (long) raise_info->height; y++)
   {
@@ -789,7 +792,8 @@ MagickExport MagickBooleanType RaiseImage(Image *image,
       }
   }
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
   for (y=(long) raise_info->height; y < (long) (image->rows-raise_info->height); y++)
   {
@@ -845,7 +849,8 @@ MagickExport MagickBooleanType RaiseImage(Image *image,
       }
   }
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
   for (y=(long) (image->rows-raise_info->height); y < (long) image->rows; y++)
   {
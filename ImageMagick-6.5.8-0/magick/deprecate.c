@@ -82,6 +82,7 @@
 #include "magick/segment.h"
 #include "magick/splay-tree.h"
 #include "magick/string_.h"
+#include "magick/thread-private.h"
 #include "magick/threshold.h"
 #include "magick/transform.h"
 #include "magick/utility.h"
@@ -1709,7 +1710,9 @@ MagickExport Image *ExtractSubimageFromImage(Image *image,
   similarity_threshold=image->columns*image->rows;
   SetGeometry(reference,&offset);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4)
+  #pragma omp parallel for \
+    magick_schedule(IntensiveThreadCost,image->columns, \
+      image->rows-reference->rows)
 #endif
   for (y=0; y < (long) (image->rows-reference->rows); y++)
   {
@@ -1943,7 +1943,9 @@ MagickExport Image *DistortImage(const Image *image,DistortImageMethod method,
     resample_filter=AcquireResampleFilterThreadSet(image,MagickFalse,exception);
     distort_view=AcquireCacheView(distort_image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(NeighborhoodThreadCost,distort_image->columns, \
+      distort_image->rows)
 #endif
     for (j=0; j < (long) distort_image->rows; j++)
     {
@@ -2509,7 +2511,9 @@ MagickExport Image *SparseColorImage(const Image *image,
     GetMagickPixelPacket(sparse_image,&zero);
     sparse_view=AcquireCacheView(sparse_image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(IntensiveThreadCost,sparse_image->columns, \
+      sparse_image->rows)
 #endif
     for (j=0; j < (long) sparse_image->rows; j++)
     {
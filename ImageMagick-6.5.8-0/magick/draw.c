@@ -73,6 +73,9 @@
 #include "magick/property.h"
 #include "magick/resample.h"
 #include "magick/resample-private.h"
+#include "magick/semaphore.h"
+#include "magick/signature-private.h"
+#include "magick/splay-tree.h"
 #include "magick/string_.h"
 #include "magick/thread-private.h"
 #include "magick/token.h"
@@ -83,6 +86,8 @@
   Define declarations.
 */
 #define BezierQuantum  200
+#define CoverageBandHeight  16
+#define MaxDisplayLists  64
 
 /*
   Typedef declarations.
@@ -111,6 +116,73 @@ typedef struct _EdgeInfo
     highwater;
 } EdgeInfo;
 
+typedef struct _CoverageInfo
+{
+  MagickRealType
+    *cells;
+
+  unsigned long
+    columns;
+
+  long
+    first[CoverageBandHeight],
+    last[CoverageBandHeight];
+} CoverageInfo;
+
+typedef enum
+{
+  UndefinedCode,
+  DrawPrimitiveCode,
+  ResetClipMaskCode
+} DisplayListCode;
+
+typedef struct _DisplayListElement
+{
+  DisplayListCode
+    code;
+
+  DrawInfo
+    *draw_info;
+
+  PrimitiveInfo
+    *primitive_info;
+
+  char
+    *clip_path;
+
+  long
+    fill_parameter,
+    stroke_parameter;
+} DisplayListElement;
+
+struct _DisplayListInfo
+{
+  char
+    *key;
+
+  DisplayListElement
+    *elements;
+
+  unsigned long
+    number_elements,
+    extent;
+
+  char
+    **parameters;
+
+  unsigned long
+    number_parameters;
+
+  long
+    reference_count;
+
+  SemaphoreInfo
+    *semaphore;
+
+  unsigned long
+    signature;
+};
+
 typedef struct _ElementInfo
 {
   MagickRealType
@@ -148,11 +220,21 @@ typedef struct _PathInfo
     code;
 } PathInfo;
 
+/*
+  Static declarations.
+*/
+static SemaphoreInfo
+  *display_list_semaphore = (SemaphoreInfo *) NULL;
+
+static SplayTreeInfo
+  *display_list_cache = (SplayTreeInfo *) NULL;
+
 /*
   Forward declarations.
 */
 static MagickBooleanType
-  DrawStrokePolygon(Image *,const DrawInfo *,const PrimitiveInfo *);
+  DrawStrokePolygon(Image *,const DrawInfo *,const PrimitiveInfo *),
+  RenderMVGContent(Image *,const DrawInfo *,DisplayListInfo *);
 
 static PrimitiveInfo
   *TraceStrokePolygon(const DrawInfo *,const PrimitiveInfo *);
@@ -178,6 +260,235 @@ static void
 %                                                                             %
 %                                                                             %
 %                                                                             %
+%   A c q u i r e D i s p l a y L i s t                                       %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  AcquireDisplayList() parses the MVG primitive of the draw info once into a
+%  display list: the graphic context and the traced points of every primitive
+%  it draws.  Replay the list with DrawDisplayList() on any number of images.
+%
+%  The list is laid out for the page geometry of the given image, which is
+%  not modified.  A fill or stroke given as a parameter, e.g. fill '$accent',
+%  is bound when the list is replayed.  Lists are cached by a digest of the
+%  MVG, the page geometry and the draw info, so acquiring the same template
+%  again returns the cached list without parsing it.
+%
+%  The format of the AcquireDisplayList method is:
+%
+%      DisplayListInfo *AcquireDisplayList(const Image *image,
+%        const DrawInfo *draw_info,ExceptionInfo *exception)
+%
+%  A description of each parameter follows:
+%
+%    o image: the image whose page geometry the list is laid out for.
+%
+%    o draw_info: the draw info.
+%
+%    o exception: return any errors or warnings in this structure.
+%
+*/
+
+static void UpdateDisplayListKey(SignatureInfo *signature_info,
+  const char *value)
+{
+  StringInfo
+    *string_info;
+
+  if (value == (const char *) NULL)
+    value="\001";
+  string_info=AcquireStringInfo(strlen(value)+1);
+  SetStringInfoDatum(string_info,(const unsigned char *) value);
+  UpdateSignature(signature_info,string_info);
+  string_info=DestroyStringInfo(string_info);
+}
+
+static char *GetDisplayListKey(const Image *image,const DrawInfo *draw_info,
+  const char *primitive)
+{
+  char
+    *key,
+    state[MaxTextExtent];
+
+  SignatureInfo
+    *signature_info;
+
+  /*
+    Patterns, tiles, dashes and clip masks of the draw info are not part of
+    the digest, so draw infos that carry them are not cached.
+  */
+  if ((draw_info->fill_pattern != (Image *) NULL) ||
+      (draw_info->stroke_pattern != (Image *) NULL) ||
+      (draw_info->tile != (Image *) NULL) ||
+      (draw_info->dash_pattern != (double *) NULL) ||
+      (draw_info->clip_mask != (char *) NULL) ||
+      (draw_info->gradient.stops != (StopInfo *) NULL))
+    return((char *) NULL);
+  signature_info=AcquireSignatureInfo();
+  UpdateDisplayListKey(signature_info,primitive);
+  (void) FormatMagickString(state,MaxTextExtent,
+    "%lux%lu%+ld%+ld %lux%lu %g,%g,%g,%g,%g,%g %d %u,%u,%u,%u %u,%u,%u,%u "
+    "%u,%u,%u,%u %u,%u,%u,%u %g %g %d,%d %d,%d,%d %lu %d %d %lu %d %d %lu %g "
+    "%d %d %u %d %g,%g,%g",image->page.width,image->page.height,
+    image->page.x,image->page.y,image->columns,image->rows,draw_info->affine.sx,
+    draw_info->affine.rx,draw_info->affine.ry,draw_info->affine.sy,
+    draw_info->affine.tx,draw_info->affine.ty,(int) draw_info->gravity,
+    draw_info->fill.red,draw_info->fill.green,draw_info->fill.blue,
+    draw_info->fill.opacity,draw_info->stroke.red,draw_info->stroke.green,
+    draw_info->stroke.blue,draw_info->stroke.opacity,
+    draw_info->undercolor.red,draw_info->undercolor.green,
+    draw_info->undercolor.blue,draw_info->undercolor.opacity,
+    draw_info->border_color.red,draw_info->border_color.green,
+    draw_info->border_color.blue,draw_info->border_color.opacity,
+    draw_info->stroke_width,draw_info->dash_offset,(int)
+    draw_info->stroke_antialias,(int) draw_info->text_antialias,(int)
+    draw_info->fill_rule,(int) draw_info->linecap,(int) draw_info->linejoin,
+    draw_info->miterlimit,(int) draw_info->decorate,(int) draw_info->compose,
+    draw_info->face,(int) draw_info->style,(int) draw_info->stretch,
+    draw_info->weight,draw_info->pointsize,(int) draw_info->align,(int)
+    draw_info->clip_units,(unsigned int) draw_info->opacity,(int)
+    draw_info->render,draw_info->kerning,draw_info->interword_spacing,
+    draw_info->interline_spacing);
+  UpdateDisplayListKey(signature_info,state);
+  UpdateDisplayListKey(signature_info,draw_info->geometry);
+  UpdateDisplayListKey(signature_info,draw_info->text);
+  UpdateDisplayListKey(signature_info,draw_info->font);
+  UpdateDisplayListKey(signature_info,draw_info->metrics);
+  UpdateDisplayListKey(signature_info,draw_info->family);
+  UpdateDisplayListKey(signature_info,draw_info->encoding);
+  UpdateDisplayListKey(signature_info,draw_info->density);
+  UpdateDisplayListKey(signature_info,draw_info->server_name);
+  FinalizeSignature(signature_info);
+  key=StringInfoToHexString(GetSignatureDigest(signature_info));
+  signature_info=DestroySignatureInfo(signature_info);
+  return(key);
+}
+
+static void *DestroyDisplayListNode(void *display_list)
+{
+  return((void *) DestroyDisplayList((DisplayListInfo *) display_list));
+}
+
+MagickExport DisplayListInfo *AcquireDisplayList(const Image *image,
+  const DrawInfo *draw_info,ExceptionInfo *exception)
+{
+  char
+    *key,
+    *primitive;
+
+  DisplayListInfo
+    *display_list;
+
+  DrawInfo
+    *clone_info;
+
+  Image
+    *layout_image;
+
+  MagickBooleanType
+    status;
+
+  assert(image != (const Image *) NULL);
+  assert(image->signature == MagickSignature);
+  if (image->debug != MagickFalse)
+    (void) LogMagickEvent(TraceEvent,GetMagickModule(),"%s",image->filename);
+  assert(draw_info != (const DrawInfo *) NULL);
+  assert(draw_info->signature == MagickSignature);
+  if ((draw_info->primitive == (char *) NULL) ||
+      (*draw_info->primitive == '\0'))
+    return((DisplayListInfo *) NULL);
+  if (*draw_info->primitive != '@')
+    primitive=AcquireString(draw_info->primitive);
+  else
+    primitive=FileToString(draw_info->primitive+1,~0,exception);
+  if (primitive == (char *) NULL)
+    return((DisplayListInfo *) NULL);
+  key=GetDisplayListKey(image,draw_info,primitive);
+  if (key != (char *) NULL)
+    {
+      if (display_list_semaphore == (SemaphoreInfo *) NULL)
+        AcquireSemaphoreInfo(&display_list_semaphore);
+      (void) LockSemaphoreInfo(display_list_semaphore);
+      display_list=(DisplayListInfo *) NULL;
+      if (display_list_cache != (SplayTreeInfo *) NULL)
+        display_list=(DisplayListInfo *) GetValueFromSplayTree(
+          display_list_cache,key);
+      if (display_list != (DisplayListInfo *) NULL)
+        {
+          (void) LockSemaphoreInfo(display_list->semaphore);
+          display_list->reference_count++;
+          (void) UnlockSemaphoreInfo(display_list->semaphore);
+        }
+      (void) UnlockSemaphoreInfo(display_list_semaphore);
+      if (display_list != (DisplayListInfo *) NULL)
+        {
+          key=DestroyString(key);
+          primitive=DestroyString(primitive);
+          return(display_list);
+        }
+    }
+  /*
+    Interpret the MVG on a one pixel image laid out like the given image.
+  */
+  layout_image=CloneImage(image,1,1,MagickTrue,exception);
+  if (layout_image == (Image *) NULL)
+    {
+      if (key != (char *) NULL)
+        key=DestroyString(key);
+      primitive=DestroyString(primitive);
+      return((DisplayListInfo *) NULL);
+    }
+  layout_image->page=image->page;
+  if ((image->page.width == 0) || (image->page.height == 0))
+    {
+      layout_image->page.width=image->columns;
+      layout_image->page.height=image->rows;
+    }
+  layout_image->progress_monitor=(MagickProgressMonitor) NULL;
+  display_list=(DisplayListInfo *) AcquireMagickMemory(sizeof(*display_list));
+  if (display_list == (DisplayListInfo *) NULL)
+    ThrowFatalException(ResourceLimitFatalError,"MemoryAllocationFailed");
+  (void) ResetMagickMemory(display_list,0,sizeof(*display_list));
+  display_list->key=key;
+  display_list->reference_count=1;
+  display_list->semaphore=AllocateSemaphoreInfo();
+  display_list->signature=MagickSignature;
+  clone_info=CloneDrawInfo((ImageInfo *) NULL,draw_info);
+  (void) CloneString(&clone_info->primitive,primitive);
+  status=RenderMVGContent(layout_image,clone_info,display_list);
+  if (layout_image->exception.severity != UndefinedException)
+    InheritException(exception,&layout_image->exception);
+  if (layout_image->exception.severity >= ErrorException)
+    status=MagickFalse;
+  clone_info=DestroyDrawInfo(clone_info);
+  layout_image=DestroyImage(layout_image);
+  primitive=DestroyString(primitive);
+  if (status == MagickFalse)
+    return(DestroyDisplayList(display_list));
+  if (display_list->key == (char *) NULL)
+    return(display_list);
+  (void) LockSemaphoreInfo(display_list_semaphore);
+  if (display_list_cache == (SplayTreeInfo *) NULL)
+    display_list_cache=NewSplayTree(CompareSplayTreeString,
+      (void *(*)(void *)) NULL,DestroyDisplayListNode);
+  if ((display_list_cache != (SplayTreeInfo *) NULL) &&
+      (GetNumberOfNodesInSplayTree(display_list_cache) < MaxDisplayLists))
+    {
+      display_list->reference_count++;
+      (void) AddValueToSplayTree(display_list_cache,display_list->key,
+        display_list);
+    }
+  (void) UnlockSemaphoreInfo(display_list_semaphore);
+  return(display_list);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
 %   A c q u i r e D r a w I n f o                                             %
 %                                                                             %
 %                                                                             %
@@ -790,6 +1101,78 @@ static PathInfo *ConvertPrimitiveToPath(
 %                                                                             %
 %                                                                             %
 %                                                                             %
+%   D e s t r o y D i s p l a y L i s t                                       %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  DestroyDisplayList() releases a reference to a display list and deallocates
+%  it once the last reference is gone.
+%
+%  The format of the DestroyDisplayList method is:
+%
+%      DisplayListInfo *DestroyDisplayList(DisplayListInfo *display_list)
+%
+%  A description of each parameter follows:
+%
+%    o display_list: the display list.
+%
+*/
+MagickExport DisplayListInfo *DestroyDisplayList(DisplayListInfo *display_list)
+{
+  register DisplayListElement
+    *p;
+
+  register long
+    i;
+
+  assert(display_list != (DisplayListInfo *) NULL);
+  assert(display_list->signature == MagickSignature);
+  (void) LockSemaphoreInfo(display_list->semaphore);
+  display_list->reference_count--;
+  if (display_list->reference_count > 0)
+    {
+      (void) UnlockSemaphoreInfo(display_list->semaphore);
+      return((DisplayListInfo *) NULL);
+    }
+  (void) UnlockSemaphoreInfo(display_list->semaphore);
+  for (i=0; i < (long) display_list->number_elements; i++)
+  {
+    p=display_list->elements+i;
+    if (p->draw_info != (DrawInfo *) NULL)
+      p->draw_info=DestroyDrawInfo(p->draw_info);
+    if (p->primitive_info != (PrimitiveInfo *) NULL)
+      {
+        if (p->primitive_info->text != (char *) NULL)
+          p->primitive_info->text=DestroyString(p->primitive_info->text);
+        p->primitive_info=(PrimitiveInfo *) RelinquishMagickMemory(
+          p->primitive_info);
+      }
+    if (p->clip_path != (char *) NULL)
+      p->clip_path=DestroyString(p->clip_path);
+  }
+  if (display_list->elements != (DisplayListElement *) NULL)
+    display_list->elements=(DisplayListElement *) RelinquishMagickMemory(
+      display_list->elements);
+  for (i=0; i < (long) display_list->number_parameters; i++)
+    display_list->parameters[i]=DestroyString(display_list->parameters[i]);
+  if (display_list->parameters != (char **) NULL)
+    display_list->parameters=(char **) RelinquishMagickMemory(
+      display_list->parameters);
+  if (display_list->key != (char *) NULL)
+    display_list->key=DestroyString(display_list->key);
+  DestroySemaphoreInfo(&display_list->semaphore);
+  display_list->signature=(~MagickSignature);
+  display_list=(DisplayListInfo *) RelinquishMagickMemory(display_list);
+  return(display_list);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
 %   D e s t r o y D r a w I n f o                                             %
 %                                                                             %
 %                                                                             %
@@ -1169,7 +1552,8 @@ MagickExport MagickBooleanType DrawAffineImage(Image *image,
   image_view=AcquireCacheView(image);
   source_view=AcquireCacheView(source);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(status)
+  #pragma omp parallel for shared(status) \
+    magick_schedule(NeighborhoodThreadCost,image->columns,image->rows)
 #endif
   for (y=(long) (edge.y1+0.5); y <= (long) (edge.y2+0.5); y++)
   {
@@ -1457,6 +1841,60 @@ MagickExport MagickBooleanType DrawClipPath(Image *image,
 %                                                                             %
 %                                                                             %
 %                                                                             %
++   D r a w C o m p o n e n t G e n e s i s                                   %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  DrawComponentGenesis() instantiates the draw component.
+%
+%  The format of the DrawComponentGenesis method is:
+%
+%      MagickBooleanType DrawComponentGenesis(void)
+%
+*/
+MagickExport MagickBooleanType DrawComponentGenesis(void)
+{
+  AcquireSemaphoreInfo(&display_list_semaphore);
+  return(MagickTrue);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
++   D r a w C o m p o n e n t T e r m i n u s                                 %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  DrawComponentTerminus() destroys the draw component and drops the cached
+%  display lists.  Lists still referenced by the caller remain valid.
+%
+%  The format of the DrawComponentTerminus method is:
+%
+%      void DrawComponentTerminus(void)
+%
+*/
+MagickExport void DrawComponentTerminus(void)
+{
+  if (display_list_semaphore == (SemaphoreInfo *) NULL)
+    AcquireSemaphoreInfo(&display_list_semaphore);
+  (void) LockSemaphoreInfo(display_list_semaphore);
+  if (display_list_cache != (SplayTreeInfo *) NULL)
+    display_list_cache=DestroySplayTree(display_list_cache);
+  (void) UnlockSemaphoreInfo(display_list_semaphore);
+  DestroySemaphoreInfo(&display_list_semaphore);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
 +   D r a w D a s h P o l y g o n                                             %
 %                                                                             %
 %                                                                             %
@@ -1628,94 +2066,300 @@ static MagickBooleanType DrawDashPolygon(const DrawInfo *draw_info,
 %                                                                             %
 %                                                                             %
 %                                                                             %
-%   D r a w I m a g e                                                         %
+%   D r a w D i s p l a y L i s t                                             %
 %                                                                             %
 %                                                                             %
 %                                                                             %
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 %
-%  DrawImage() draws a graphic primitive on your image.  The primitive
-%  may be represented as a string or filename.  Precede the filename with an
-%  "at" sign (@) and the contents of the file are drawn on the image.  You
-%  can affect how text is drawn by setting one or more members of the draw
-%  info structure.
+%  DrawDisplayList() replays a display list acquired with AcquireDisplayList()
+%  on the image.  No MVG is parsed and no path is traced again.
 %
-%  The format of the DrawImage method is:
+%  Parameters are given as a NULL terminated list of name and value pairs,
+%  e.g. { "accent", "#4682b4", (char *) NULL }.  A fill or stroke bound to a
+%  parameter takes its color, opacity included.  Unbound parameters keep the
+%  inherited color.
 %
-%      MagickBooleanType DrawImage(Image *image,const DrawInfo *draw_info)
+%  The format of the DrawDisplayList method is:
+%
+%      MagickBooleanType DrawDisplayList(Image *image,
+%        const DisplayListInfo *display_list,const char **parameters)
 %
 %  A description of each parameter follows:
 %
 %    o image: the image.
 %
-%    o draw_info: the draw info.
+%    o display_list: the display list.
+%
+%    o parameters: the parameter name and value pairs, or NULL.
 %
 */
 
-static inline MagickBooleanType IsPoint(const char *point)
-{
-  char
-    *p;
-
-  double
-    value;
-
-  value=strtod(point,&p);
-  return((value == 0.0) && (p == point) ? MagickFalse : MagickTrue);
-}
-
-static inline void TracePoint(PrimitiveInfo *primitive_info,
-  const PointInfo point)
-{
-  primitive_info->coordinates=1;
-  primitive_info->point=point;
-}
-
-MagickExport MagickBooleanType DrawImage(Image *image,const DrawInfo *draw_info)
+MagickExport MagickBooleanType DrawDisplayList(Image *image,
+  const DisplayListInfo *display_list,const char **parameters)
 {
 #define RenderImageTag  "Render/Image"
 
-  AffineMatrix
-    affine,
-    current;
-
-  char
-    key[2*MaxTextExtent],
-    keyword[MaxTextExtent],
-    geometry[MaxTextExtent],
-    name[MaxTextExtent],
-    pattern[MaxTextExtent],
-    *primitive,
-    *token;
-
-  const char
-    *q;
-
   DrawInfo
-    **graphic_context;
-
-  long
-    j,
-    k,
-    n;
+    draw_info;
 
   MagickBooleanType
-    proceed,
-    status;
-
-  MagickRealType
-    angle,
-    factor,
-    primitive_extent;
-
-  PointInfo
-    point;
+    *bound,
+    proceed;
 
   PixelPacket
-    start_color;
+    *colors;
 
-  PrimitiveInfo
-    *primitive_info;
+  register const DisplayListElement
+    *p;
+
+  register long
+    i,
+    j;
+
+  assert(image != (Image *) NULL);
+  assert(image->signature == MagickSignature);
+  if (image->debug != MagickFalse)
+    (void) LogMagickEvent(TraceEvent,GetMagickModule(),"%s",image->filename);
+  assert(display_list != (const DisplayListInfo *) NULL);
+  assert(display_list->signature == MagickSignature);
+  if (SetImageStorageClass(image,DirectClass) == MagickFalse)
+    return(MagickFalse);
+  if (image->debug != MagickFalse)
+    (void) LogMagickEvent(DrawEvent,GetMagickModule(),
+      "begin draw-display-list %lu",display_list->number_elements);
+  /*
+    Resolve the parameters once per replay.
+  */
+  bound=(MagickBooleanType *) AcquireQuantumMemory((size_t)
+    display_list->number_parameters+1,sizeof(*bound));
+  colors=(PixelPacket *) AcquireQuantumMemory((size_t)
+    display_list->number_parameters+1,sizeof(*colors));
+  if ((bound == (MagickBooleanType *) NULL) ||
+      (colors == (PixelPacket *) NULL))
+    {
+      if (colors != (PixelPacket *) NULL)
+        colors=(PixelPacket *) RelinquishMagickMemory(colors);
+      if (bound != (MagickBooleanType *) NULL)
+        bound=(MagickBooleanType *) RelinquishMagickMemory(bound);
+      ThrowBinaryException(ResourceLimitError,"MemoryAllocationFailed",
+        image->filename);
+    }
+  for (i=0; i < (long) display_list->number_parameters; i++)
+  {
+    bound[i]=MagickFalse;
+    if (parameters == (const char **) NULL)
+      continue;
+    for (j=0; parameters[j] != (const char *) NULL; j+=2)
+    {
+      if (parameters[j+1] == (const char *) NULL)
+        break;
+      if (LocaleCompare(parameters[j],display_list->parameters[i]) == 0)
+        bound[i]=QueryColorDatabase(parameters[j+1],colors+i,
+          &image->exception);
+    }
+  }
+  for (i=0; i < (long) display_list->number_elements; i++)
+  {
+    p=display_list->elements+i;
+    if (p->code == ResetClipMaskCode)
+      {
+        (void) SetImageClipMask(image,(Image *) NULL);
+        continue;
+      }
+    draw_info=(*p->draw_info);
+    if ((p->fill_parameter >= 0) && (bound[p->fill_parameter] != MagickFalse))
+      {
+        draw_info.fill=colors[p->fill_parameter];
+        draw_info.fill_pattern=(Image *) NULL;
+      }
+    if ((p->stroke_parameter >= 0) &&
+        (bound[p->stroke_parameter] != MagickFalse))
+      {
+        draw_info.stroke=colors[p->stroke_parameter];
+        draw_info.stroke_pattern=(Image *) NULL;
+      }
+    if (p->clip_path != (char *) NULL)
+      {
+        (void) SetImageArtifact(image,draw_info.clip_mask,p->clip_path);
+        (void) DrawClipPath(image,&draw_info,draw_info.clip_mask);
+      }
+    (void) DrawPrimitive(image,&draw_info,p->primitive_info);
+    proceed=SetImageProgress(image,RenderImageTag,i,(MagickSizeType)
+      display_list->number_elements);
+    if (proceed == MagickFalse)
+      break;
+  }
+  colors=(PixelPacket *) RelinquishMagickMemory(colors);
+  bound=(MagickBooleanType *) RelinquishMagickMemory(bound);
+  if (image->debug != MagickFalse)
+    (void) LogMagickEvent(DrawEvent,GetMagickModule(),"end draw-display-list");
+  return(MagickTrue);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   D r a w I m a g e                                                         %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  DrawImage() draws a graphic primitive on your image.  The primitive
+%  may be represented as a string or filename.  Precede the filename with an
+%  "at" sign (@) and the contents of the file are drawn on the image.  You
+%  can affect how text is drawn by setting one or more members of the draw
+%  info structure.  To draw the same primitives many times, parse them once
+%  with AcquireDisplayList() and replay them with DrawDisplayList().
+%
+%  The format of the DrawImage method is:
+%
+%      MagickBooleanType DrawImage(Image *image,const DrawInfo *draw_info)
+%
+%  A description of each parameter follows:
+%
+%    o image: the image.
+%
+%    o draw_info: the draw info.
+%
+*/
+
+static inline MagickBooleanType IsPoint(const char *point)
+{
+  char
+    *p;
+
+  double
+    value;
+
+  value=strtod(point,&p);
+  return((value == 0.0) && (p == point) ? MagickFalse : MagickTrue);
+}
+
+static inline void TracePoint(PrimitiveInfo *primitive_info,
+  const PointInfo point)
+{
+  primitive_info->coordinates=1;
+  primitive_info->point=point;
+}
+
+static long AcquireDisplayListParameter(DisplayListInfo *display_list,
+  const char *name)
+{
+  register long
+    i;
+
+  for (i=0; i < (long) display_list->number_parameters; i++)
+    if (LocaleCompare(display_list->parameters[i],name) == 0)
+      return(i);
+  display_list->parameters=(char **) ResizeQuantumMemory(
+    display_list->parameters,(size_t) display_list->number_parameters+1,
+    sizeof(*display_list->parameters));
+  if (display_list->parameters == (char **) NULL)
+    ThrowFatalException(ResourceLimitFatalError,"MemoryAllocationFailed");
+  display_list->parameters[i]=ConstantString(name);
+  display_list->number_parameters++;
+  return(i);
+}
+
+static MagickBooleanType AppendDisplayListElement(DisplayListInfo *display_list,
+  const DisplayListCode code,const DrawInfo *draw_info,const char *clip_path,
+  const PrimitiveInfo *primitive_info,const long *parameters)
+{
+  DisplayListElement
+    *element;
+
+  register long
+    i;
+
+  if (display_list->number_elements == display_list->extent)
+    {
+      display_list->extent=2*display_list->extent+64;
+      display_list->elements=(DisplayListElement *) ResizeQuantumMemory(
+        display_list->elements,(size_t) display_list->extent,
+        sizeof(*display_list->elements));
+      if (display_list->elements == (DisplayListElement *) NULL)
+        ThrowFatalException(ResourceLimitFatalError,"MemoryAllocationFailed");
+    }
+  element=display_list->elements+display_list->number_elements;
+  (void) ResetMagickMemory(element,0,sizeof(*element));
+  element->code=code;
+  element->fill_parameter=(-1);
+  element->stroke_parameter=(-1);
+  display_list->number_elements++;
+  if (code != DrawPrimitiveCode)
+    return(MagickTrue);
+  element->draw_info=CloneDrawInfo((ImageInfo *) NULL,draw_info);
+  if (clip_path != (const char *) NULL)
+    element->clip_path=ConstantString(clip_path);
+  if (parameters != (const long *) NULL)
+    {
+      element->fill_parameter=parameters[0];
+      element->stroke_parameter=parameters[1];
+    }
+  for (i=0; primitive_info[i].primitive != UndefinedPrimitive; i++) ;
+  element->primitive_info=(PrimitiveInfo *) AcquireQuantumMemory((size_t) i+1,
+    sizeof(*element->primitive_info));
+  if (element->primitive_info == (PrimitiveInfo *) NULL)
+    return(MagickFalse);
+  (void) CopyMagickMemory(element->primitive_info,primitive_info,(size_t)
+    (i+1)*sizeof(*element->primitive_info));
+  if (primitive_info->text != (char *) NULL)
+    element->primitive_info->text=ConstantString(primitive_info->text);
+  return(MagickTrue);
+}
+
+static MagickBooleanType RenderMVGContent(Image *image,
+  const DrawInfo *draw_info,DisplayListInfo *display_list)
+{
+#define RenderImageTag  "Render/Image"
+
+  AffineMatrix
+    affine,
+    current;
+
+  char
+    key[2*MaxTextExtent],
+    keyword[MaxTextExtent],
+    geometry[MaxTextExtent],
+    name[MaxTextExtent],
+    pattern[MaxTextExtent],
+    *primitive,
+    *token;
+
+  const char
+    *clip_path,
+    *q;
+
+  DrawInfo
+    **graphic_context;
+
+  long
+    *bindings,
+    j,
+    k,
+    n;
+
+  MagickBooleanType
+    proceed,
+    status;
+
+  MagickRealType
+    angle,
+    factor,
+    primitive_extent;
+
+  PointInfo
+    point;
+
+  PixelPacket
+    start_color;
+
+  PrimitiveInfo
+    *primitive_info;
 
   PrimitiveType
     primitive_type;
@@ -1784,6 +2428,18 @@ MagickExport MagickBooleanType DrawImage(Image *image,const DrawInfo *draw_info)
         image->filename);
     }
   graphic_context[n]=CloneDrawInfo((ImageInfo *) NULL,draw_info);
+  bindings=(long *) NULL;
+  if (display_list != (DisplayListInfo *) NULL)
+    {
+      /*
+        Track the fill and stroke parameters bound in each graphic context.
+      */
+      bindings=(long *) AcquireQuantumMemory(2,sizeof(*bindings));
+      if (bindings == (long *) NULL)
+        ThrowFatalException(ResourceLimitFatalError,"MemoryAllocationFailed");
+      bindings[0]=(-1);
+      bindings[1]=(-1);
+    }
   graphic_context[n]->viewbox=image->page;
   if ((image->page.width == 0) || (image->page.height == 0))
     {
@@ -1988,6 +2644,22 @@ MagickExport MagickBooleanType DrawImage(Image *image,const DrawInfo *draw_info)
         if (LocaleCompare("fill",keyword) == 0)
           {
             GetMagickToken(q,&q,token);
+            if (*token == '$')
+              {
+                /*
+                  A parameter, bound when a display list is replayed.
+                */
+                if (token[1] == '\0')
+                  GetMagickToken(q,&q,token);
+                else
+                  (void) memmove(token,token+1,strlen(token));
+                if (bindings != (long *) NULL)
+                  bindings[2*n]=AcquireDisplayListParameter(display_list,
+                    token);
+                break;
+              }
+            if (bindings != (long *) NULL)
+              bindings[2*n]=(-1);
             (void) FormatMagickString(pattern,MaxTextExtent,"%s",token);
             if (GetImageArtifact(image,pattern) != (const char *) NULL)
               (void) DrawPatternPath(image,draw_info,token,
@@ -2269,7 +2941,15 @@ MagickExport MagickBooleanType DrawImage(Image *image,const DrawInfo *draw_info)
                 if (graphic_context[n]->clip_mask != (char *) NULL)
                   if (LocaleCompare(graphic_context[n]->clip_mask,
                       graphic_context[n-1]->clip_mask) != 0)
-                    (void) SetImageClipMask(image,(Image *) NULL);
+                    {
+                      if (display_list != (DisplayListInfo *) NULL)
+                        (void) AppendDisplayListElement(display_list,
+                          ResetClipMaskCode,graphic_context[n],
+                          (const char *) NULL,(PrimitiveInfo *) NULL,
+                          (long *) NULL);
+                      else
+                        (void) SetImageClipMask(image,(Image *) NULL);
+                    }
                 graphic_context[n]=DestroyDrawInfo(graphic_context[n]);
                 n--;
                 break;
@@ -2436,6 +3116,16 @@ MagickExport MagickBooleanType DrawImage(Image *image,const DrawInfo *draw_info)
                   }
                 graphic_context[n]=CloneDrawInfo((ImageInfo *) NULL,
                   graphic_context[n-1]);
+                if (bindings != (long *) NULL)
+                  {
+                    bindings=(long *) ResizeQuantumMemory(bindings,(size_t)
+                      2*(n+1),sizeof(*bindings));
+                    if (bindings == (long *) NULL)
+                      ThrowFatalException(ResourceLimitFatalError,
+                        "MemoryAllocationFailed");
+                    bindings[2*n]=bindings[2*n-2];
+                    bindings[2*n+1]=bindings[2*n-1];
+                  }
                 break;
               }
             if (LocaleCompare("defs",token) == 0)
@@ -2515,6 +3205,22 @@ MagickExport MagickBooleanType DrawImage(Image *image,const DrawInfo *draw_info)
         if (LocaleCompare("stroke",keyword) == 0)
           {
             GetMagickToken(q,&q,token);
+            if (*token == '$')
+              {
+                /*
+                  A parameter, bound when a display list is replayed.
+                */
+                if (token[1] == '\0')
+                  GetMagickToken(q,&q,token);
+                else
+                  (void) memmove(token,token+1,strlen(token));
+                if (bindings != (long *) NULL)
+                  bindings[2*n+1]=AcquireDisplayListParameter(display_list,
+                    token);
+                break;
+              }
+            if (bindings != (long *) NULL)
+              bindings[2*n+1]=(-1);
             (void) FormatMagickString(pattern,MaxTextExtent,"%s",token);
             if (GetImageArtifact(image,pattern) != (const char *) NULL)
               (void) DrawPatternPath(image,draw_info,token,
@@ -3106,15 +3812,37 @@ MagickExport MagickBooleanType DrawImage(Image *image,const DrawInfo *draw_info)
     }
     if (i >= (long) number_points)
       ThrowFatalException(ResourceLimitFatalError,"MemoryAllocationFailed");
-    if (graphic_context[n]->render != MagickFalse)
+    if ((graphic_context[n]->render != MagickFalse) &&
+        (display_list != (DisplayListInfo *) NULL))
       {
+        /*
+          Record the primitive rather than draw it.
+        */
+        clip_path=(const char *) NULL;
         if ((n != 0) && (graphic_context[n]->clip_mask != (char *) NULL) &&
             (LocaleCompare(graphic_context[n]->clip_mask,
              graphic_context[n-1]->clip_mask) != 0))
-          (void) DrawClipPath(image,graphic_context[n],
-            graphic_context[n]->clip_mask);
-        (void) DrawPrimitive(image,graphic_context[n],primitive_info);
+          clip_path=GetImageArtifact(image,graphic_context[n]->clip_mask);
+        if (AppendDisplayListElement(display_list,DrawPrimitiveCode,
+            graphic_context[n],clip_path,primitive_info,bindings+2*n) ==
+            MagickFalse)
+          {
+            (void) ThrowMagickException(&image->exception,GetMagickModule(),
+              ResourceLimitError,"MemoryAllocationFailed","`%s'",
+              image->filename);
+            break;
+          }
       }
+    else
+      if (graphic_context[n]->render != MagickFalse)
+        {
+          if ((n != 0) && (graphic_context[n]->clip_mask != (char *) NULL) &&
+              (LocaleCompare(graphic_context[n]->clip_mask,
+               graphic_context[n-1]->clip_mask) != 0))
+            (void) DrawClipPath(image,graphic_context[n],
+              graphic_context[n]->clip_mask);
+          (void) DrawPrimitive(image,graphic_context[n],primitive_info);
+        }
     if (primitive_info->text != (char *) NULL)
       primitive_info->text=(char *) RelinquishMagickMemory(
         primitive_info->text);
@@ -3129,6 +3857,8 @@ MagickExport MagickBooleanType DrawImage(Image *image,const DrawInfo *draw_info)
     Relinquish resources.
   */
   token=DestroyString(token);
+  if (bindings != (long *) NULL)
+    bindings=(long *) RelinquishMagickMemory(bindings);
   if (primitive_info != (PrimitiveInfo *) NULL)
     primitive_info=(PrimitiveInfo *) RelinquishMagickMemory(primitive_info);
   primitive=DestroyString(primitive);
@@ -3140,6 +3870,11 @@ MagickExport MagickBooleanType DrawImage(Image *image,const DrawInfo *draw_info)
       keyword);
   return(status);
 }
+
+MagickExport MagickBooleanType DrawImage(Image *image,const DrawInfo *draw_info)
+{
+  return(RenderMVGContent(image,draw_info,(DisplayListInfo *) NULL));
+}
 
 /*
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -3273,7 +4008,8 @@ MagickExport MagickBooleanType DrawGradientImage(Image *image,
   GetMagickPixelPacket(image,&zero);
   image_view=AcquireCacheView(image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(status)
+  #pragma omp parallel for shared(status) \
+    magick_schedule(NeighborhoodThreadCost,image->columns,image->rows)
 #endif
   for (y=bounding_box.y; y < (long) bounding_box.height; y++)
   {
@@ -3790,6 +4526,587 @@ static MagickRealType GetPixelOpacity(PolygonInfo *polygon_info,
   return(subpath_opacity);
 }
 
+static CoverageInfo **DestroyCoverageThreadSet(CoverageInfo **coverage_info)
+{
+  register long
+    i;
+
+  assert(coverage_info != (CoverageInfo **) NULL);
+  for (i=0; i < (long) GetOpenMPMaximumThreads(); i++)
+    if (coverage_info[i] != (CoverageInfo *) NULL)
+      {
+        if (coverage_info[i]->cells != (MagickRealType *) NULL)
+          coverage_info[i]->cells=(MagickRealType *) RelinquishMagickMemory(
+            coverage_info[i]->cells);
+        coverage_info[i]=(CoverageInfo *) RelinquishMagickMemory(
+          coverage_info[i]);
+      }
+  coverage_info=(CoverageInfo **) RelinquishAlignedMemory(coverage_info);
+  return(coverage_info);
+}
+
+static CoverageInfo **AcquireCoverageThreadSet(const unsigned long columns)
+{
+  CoverageInfo
+    **coverage_info;
+
+  register long
+    i;
+
+  unsigned long
+    number_threads;
+
+  number_threads=GetOpenMPMaximumThreads();
+  coverage_info=(CoverageInfo **) AcquireAlignedMemory(number_threads,
+    sizeof(*coverage_info));
+  if (coverage_info == (CoverageInfo **) NULL)
+    return((CoverageInfo **) NULL);
+  (void) ResetMagickMemory(coverage_info,0,number_threads*
+    sizeof(*coverage_info));
+  for (i=0; i < (long) number_threads; i++)
+  {
+    coverage_info[i]=(CoverageInfo *) AcquireMagickMemory(
+      sizeof(**coverage_info));
+    if (coverage_info[i] == (CoverageInfo *) NULL)
+      return(DestroyCoverageThreadSet(coverage_info));
+    coverage_info[i]->columns=columns+2;
+    coverage_info[i]->cells=(MagickRealType *) AcquireQuantumMemory(
+      2*CoverageBandHeight*coverage_info[i]->columns,
+      sizeof(*coverage_info[i]->cells));
+    if (coverage_info[i]->cells == (MagickRealType *) NULL)
+      return(DestroyCoverageThreadSet(coverage_info));
+  }
+  return(coverage_info);
+}
+
+static void AccumulateCoverage(CoverageInfo *coverage_info,
+  MagickRealType *cells,const PointInfo *a,const PointInfo *b,
+  const MagickRealType direction)
+{
+  long
+    x1,
+    x2,
+    y;
+
+  MagickRealType
+    area,
+    bottom,
+    delta,
+    dxdy,
+    first_area,
+    last_area,
+    scale,
+    top,
+    x,
+    x_next;
+
+  register long
+    i;
+
+  register MagickRealType
+    *q;
+
+  /*
+    Accumulate the signed area to the right of a segment within one cell row
+    at a time, in the manner of FreeType's gray rasterizer.  The segment lies
+    within the band and within columns 0 through the band width, with a->y <
+    b->y.
+  */
+  dxdy=(b->x-a->x)/(b->y-a->y);
+  for (y=(long) floor(a->y); y < (long) ceil(b->y); y++)
+  {
+    top=(MagickRealType) y > a->y ? (MagickRealType) y : a->y;
+    bottom=(MagickRealType) (y+1) < b->y ? (MagickRealType) (y+1) : b->y;
+    delta=direction*(bottom-top);
+    x=a->x+dxdy*(top-a->y);
+    x_next=a->x+dxdy*(bottom-a->y);
+    if (x > x_next)
+      {
+        area=x;
+        x=x_next;
+        x_next=area;
+      }
+    x1=(long) floor(x);
+    x2=(long) ceil(x_next);
+    if (x2 <= x1)
+      x2=x1+1;
+    if (x1 < coverage_info->first[y])
+      coverage_info->first[y]=x1;
+    if (x2 > coverage_info->last[y])
+      coverage_info->last[y]=x2;
+    q=cells+y*coverage_info->columns+x1;
+    if (x2 == (x1+1))
+      {
+        /*
+          The segment stays within a single cell.
+        */
+        area=0.5*(x+x_next)-x1;
+        q[0]+=delta*(1.0-area);
+        q[1]+=delta*area;
+        continue;
+      }
+    /*
+      The segment crosses several cells: split its area among them.
+    */
+    scale=1.0/(x_next-x);
+    first_area=0.5*scale*(1.0-(x-x1))*(1.0-(x-x1));
+    last_area=0.5*scale*(x_next-x2+1.0)*(x_next-x2+1.0);
+    q[0]+=delta*first_area;
+    if (x2 == (x1+2))
+      q[1]+=delta*(1.0-first_area-last_area);
+    else
+      {
+        area=scale*(1.5-(x-x1));
+        q[1]+=delta*(area-first_area);
+        for (i=2; i < (x2-x1-1); i++)
+          q[i]+=delta*scale;
+        area+=(x2-x1-3)*scale;
+        q[x2-x1-1]+=delta*(1.0-area-last_area);
+      }
+    q[x2-x1]+=delta*last_area;
+  }
+}
+
+static void ClipCoverage(CoverageInfo *coverage_info,MagickRealType *cells,
+  const long columns,const long rows,const PointInfo *a,const PointInfo *b,
+  const MagickRealType direction)
+{
+  long
+    n;
+
+  MagickRealType
+    swap,
+    t[4];
+
+  PointInfo
+    p,
+    q;
+
+  register long
+    i;
+
+  /*
+    Clip the segment to the band rows, then split it where it crosses the
+    left or right edge of the band.  Parts beyond an edge are pushed onto it,
+    which leaves the coverage inside the band unchanged.
+  */
+  if ((b->y <= 0.0) || (a->y >= (MagickRealType) rows) || (b->y <= a->y))
+    return;
+  p=(*a);
+  q=(*b);
+  if (p.y < 0.0)
+    {
+      p.x+=(q.x-p.x)*(0.0-p.y)/(q.y-p.y);
+      p.y=0.0;
+    }
+  if (q.y > (MagickRealType) rows)
+    {
+      q.x+=(q.x-p.x)*((MagickRealType) rows-q.y)/(q.y-p.y);
+      q.y=(MagickRealType) rows;
+    }
+  if (q.y <= p.y)
+    return;
+  n=0;
+  t[n++]=0.0;
+  if ((p.x < 0.0) != (q.x < 0.0))
+    t[n++]=(0.0-p.x)/(q.x-p.x);
+  if ((p.x > (MagickRealType) columns) != (q.x > (MagickRealType) columns))
+    t[n++]=((MagickRealType) columns-p.x)/(q.x-p.x);
+  if ((n == 3) && (t[2] < t[1]))
+    {
+      swap=t[1];
+      t[1]=t[2];
+      t[2]=swap;
+    }
+  t[n]=1.0;
+  for (i=0; i < n; i++)
+  {
+    PointInfo
+      u,
+      v;
+
+    u.x=p.x+t[i]*(q.x-p.x);
+    u.y=p.y+t[i]*(q.y-p.y);
+    v.x=p.x+t[i+1]*(q.x-p.x);
+    v.y=p.y+t[i+1]*(q.y-p.y);
+    if (v.y <= u.y)
+      continue;
+    u.x=u.x < 0.0 ? 0.0 : u.x > (MagickRealType) columns ?
+      (MagickRealType) columns : u.x;
+    v.x=v.x < 0.0 ? 0.0 : v.x > (MagickRealType) columns ?
+      (MagickRealType) columns : v.x;
+    AccumulateCoverage(coverage_info,cells,&u,&v,direction);
+  }
+}
+
+static void AccumulatePolygonCoverage(CoverageInfo *coverage_info,
+  MagickRealType *cells,const PolygonInfo *polygon_info,const long x,
+  const long y,const long columns,const long rows)
+{
+  MagickRealType
+    direction;
+
+  PointInfo
+    u,
+    v;
+
+  register const EdgeInfo
+    *p;
+
+  register long
+    i,
+    j;
+
+  /*
+    Accumulate the edges that cross the band whose top left pixel is (x,y).
+    Edges are sorted by their topmost point and the points of each edge are
+    in increasing y.  Pixel centers lie on integer coordinates.
+  */
+  p=polygon_info->edges;
+  for (i=0; i < (long) polygon_info->number_edges; i++, p++)
+  {
+    if ((p->bounds.y1+0.5) >= (MagickRealType) (y+rows))
+      break;
+    if ((p->bounds.y2+0.5) <= (MagickRealType) y)
+      continue;
+    direction=p->direction != 0 ? 1.0 : -1.0;
+    for (j=1; j < (long) p->number_points; j++)
+    {
+      if ((p->points[j].y+0.5) <= (MagickRealType) y)
+        continue;
+      if ((p->points[j-1].y+0.5) >= (MagickRealType) (y+rows))
+        break;
+      u.x=p->points[j-1].x-x+0.5;
+      u.y=p->points[j-1].y-y+0.5;
+      v.x=p->points[j].x-x+0.5;
+      v.y=p->points[j].y-y+0.5;
+      ClipCoverage(coverage_info,cells,columns,rows,&u,&v,direction);
+    }
+  }
+}
+
+static PolygonInfo *TraceCoverageOutline(const DrawInfo *draw_info,
+  const PrimitiveInfo *primitive_info)
+{
+  DrawInfo
+    *clone_info;
+
+  PathInfo
+    *path_info;
+
+  PolygonInfo
+    *polygon_info;
+
+  PrimitiveInfo
+    *outline,
+    *stroke_polygon,
+    *subpath;
+
+  register const PrimitiveInfo
+    *p;
+
+  register long
+    i;
+
+  unsigned long
+    extent,
+    n,
+    number_points;
+
+  /*
+    Trace a one pixel wide outline along each closed subpath.  Pixel centers
+    lie on integer coordinates, so an edge through a pixel center would
+    otherwise cover that pixel only by half, where the distance-based
+    rasterizer covers it fully.
+  */
+  clone_info=CloneDrawInfo((ImageInfo *) NULL,draw_info);
+  GetAffineMatrix(&clone_info->affine);
+  clone_info->stroke_width=1.0;
+  clone_info->linecap=ButtCap;
+  clone_info->linejoin=MiterJoin;
+  extent=0;
+  number_points=0;
+  outline=(PrimitiveInfo *) NULL;
+  for (p=primitive_info; p->primitive != UndefinedPrimitive; p+=p->coordinates)
+  {
+    if (p->coordinates == 0)
+      break;
+    subpath=(PrimitiveInfo *) AcquireQuantumMemory((size_t) p->coordinates+2UL,
+      sizeof(*subpath));
+    if (subpath == (PrimitiveInfo *) NULL)
+      break;
+    (void) CopyMagickMemory(subpath,p,(size_t) p->coordinates*
+      sizeof(*subpath));
+    n=p->coordinates;
+    if ((subpath[n-1].point.x != subpath[0].point.x) ||
+        (subpath[n-1].point.y != subpath[0].point.y))
+      subpath[n++]=subpath[0];
+    subpath[0].coordinates=n;
+    subpath[n].primitive=UndefinedPrimitive;
+    stroke_polygon=TraceStrokePolygon(clone_info,subpath);
+    subpath=(PrimitiveInfo *) RelinquishMagickMemory(subpath);
+    if (stroke_polygon == (PrimitiveInfo *) NULL)
+      break;
+    for (n=0; stroke_polygon[n].primitive != UndefinedPrimitive; n++) ;
+    if ((number_points+n+1) > extent)
+      {
+        extent=2*(number_points+n+1);
+        outline=(PrimitiveInfo *) ResizeQuantumMemory(outline,(size_t) extent,
+          sizeof(*outline));
+        if (outline == (PrimitiveInfo *) NULL)
+          {
+            stroke_polygon=(PrimitiveInfo *) RelinquishMagickMemory(
+              stroke_polygon);
+            break;
+          }
+      }
+    for (i=0; i < (long) n; i++)
+      outline[number_points+i]=stroke_polygon[i];
+    number_points+=n;
+    stroke_polygon=(PrimitiveInfo *) RelinquishMagickMemory(stroke_polygon);
+  }
+  clone_info=DestroyDrawInfo(clone_info);
+  if (outline == (PrimitiveInfo *) NULL)
+    return((PolygonInfo *) NULL);
+  outline[number_points].primitive=UndefinedPrimitive;
+  polygon_info=(PolygonInfo *) NULL;
+  path_info=ConvertPrimitiveToPath(draw_info,outline);
+  outline=(PrimitiveInfo *) RelinquishMagickMemory(outline);
+  if (path_info != (PathInfo *) NULL)
+    {
+      polygon_info=ConvertPathToPolygon(draw_info,path_info);
+      path_info=(PathInfo *) RelinquishMagickMemory(path_info);
+    }
+  return(polygon_info);
+}
+
+static MagickBooleanType DrawCoveragePolygon(Image *image,
+  const DrawInfo *draw_info,const PrimitiveInfo *primitive_info)
+{
+  CacheView
+    *image_view;
+
+  CoverageInfo
+    **coverage_info;
+
+  ExceptionInfo
+    *exception;
+
+  long
+    band,
+    number_bands,
+    start,
+    stop,
+    y1,
+    y2;
+
+  MagickBooleanType
+    status;
+
+  PathInfo
+    *path_info;
+
+  PolygonInfo
+    *outline_info,
+    *polygon_info;
+
+  register EdgeInfo
+    *p;
+
+  register long
+    i;
+
+  SegmentInfo
+    bounds;
+
+  /*
+    Rasterize the fill by accumulating its signed area coverage per cell, in
+    bands of rows processed in parallel.
+  */
+  path_info=ConvertPrimitiveToPath(draw_info,primitive_info);
+  if (path_info == (PathInfo *) NULL)
+    return(MagickFalse);
+  polygon_info=ConvertPathToPolygon(draw_info,path_info);
+  path_info=(PathInfo *) RelinquishMagickMemory(path_info);
+  if (polygon_info == (PolygonInfo *) NULL)
+    return(MagickFalse);
+  outline_info=TraceCoverageOutline(draw_info,primitive_info);
+  if (outline_info == (PolygonInfo *) NULL)
+    {
+      polygon_info=DestroyPolygonInfo(polygon_info);
+      return(MagickFalse);
+    }
+  if (outline_info->number_edges == 0)
+    {
+      outline_info=DestroyPolygonInfo(outline_info);
+      polygon_info=DestroyPolygonInfo(polygon_info);
+      return(MagickTrue);
+    }
+  bounds=outline_info->edges[0].bounds;
+  for (i=1; i < (long) outline_info->number_edges; i++)
+  {
+    p=outline_info->edges+i;
+    if (p->bounds.x1 < bounds.x1)
+      bounds.x1=p->bounds.x1;
+    if (p->bounds.y1 < bounds.y1)
+      bounds.y1=p->bounds.y1;
+    if (p->bounds.x2 > bounds.x2)
+      bounds.x2=p->bounds.x2;
+    if (p->bounds.y2 > bounds.y2)
+      bounds.y2=p->bounds.y2;
+  }
+  start=(long) floor(bounds.x1+0.5);
+  stop=(long) floor(bounds.x2+0.5);
+  y1=(long) floor(bounds.y1+0.5);
+  y2=(long) floor(bounds.y2+0.5);
+  if (start < 0)
+    start=0;
+  if (stop >= (long) image->columns)
+    stop=(long) image->columns-1;
+  if (y1 < 0)
+    y1=0;
+  if (y2 >= (long) image->rows)
+    y2=(long) image->rows-1;
+  if ((start > stop) || (y1 > y2))
+    {
+      outline_info=DestroyPolygonInfo(outline_info);
+      polygon_info=DestroyPolygonInfo(polygon_info);
+      return(MagickTrue);
+    }
+  coverage_info=AcquireCoverageThreadSet((unsigned long) (stop-start+1));
+  if (coverage_info == (CoverageInfo **) NULL)
+    {
+      outline_info=DestroyPolygonInfo(outline_info);
+      polygon_info=DestroyPolygonInfo(polygon_info);
+      ThrowBinaryException(ResourceLimitError,"MemoryAllocationFailed",
+        image->filename);
+    }
+  if (image->matte == MagickFalse)
+    (void) SetImageAlphaChannel(image,OpaqueAlphaChannel);
+  status=MagickTrue;
+  exception=(&image->exception);
+  number_bands=(y2-y1+CoverageBandHeight)/CoverageBandHeight;
+  image_view=AcquireCacheView(image);
+#if defined(MAGICKCORE_OPENMP_SUPPORT)
+  #pragma omp parallel for schedule(dynamic,1) shared(status)
+#endif
+  for (band=0; band < number_bands; band++)
+  {
+    CoverageInfo
+      *coverage;
+
+    long
+      columns,
+      id,
+      rows,
+      top,
+      x,
+      y;
+
+    MagickRealType
+      *fill_cells,
+      *outline_cells;
+
+    PixelPacket
+      fill_color;
+
+    register PixelPacket
+      *__restrict q;
+
+    if (status == MagickFalse)
+      continue;
+    id=GetOpenMPThreadId();
+    coverage=coverage_info[id];
+    top=y1+band*CoverageBandHeight;
+    rows=MagickMin(CoverageBandHeight,y2-top+1);
+    columns=stop-start+1;
+    fill_cells=coverage->cells;
+    outline_cells=coverage->cells+CoverageBandHeight*coverage->columns;
+    (void) ResetMagickMemory(fill_cells,0,(size_t) rows*coverage->columns*
+      sizeof(*fill_cells));
+    (void) ResetMagickMemory(outline_cells,0,(size_t) rows*coverage->columns*
+      sizeof(*outline_cells));
+    for (y=0; y < rows; y++)
+    {
+      coverage->first[y]=(long) coverage->columns;
+      coverage->last[y]=(-1);
+    }
+    AccumulatePolygonCoverage(coverage,fill_cells,polygon_info,start,top,
+      columns,rows);
+    AccumulatePolygonCoverage(coverage,outline_cells,outline_info,start,top,
+      columns,rows);
+    /*
+      Composite the fill over the span of each row the edges touched.
+    */
+    for (y=0; y < rows; y++)
+    {
+      long
+        first,
+        last;
+
+      MagickRealType
+        alpha,
+        beta,
+        fill_opacity,
+        fill_sum,
+        outline_sum;
+
+      first=coverage->first[y];
+      last=MagickMin(coverage->last[y],columns-1);
+      if (first > last)
+        continue;
+      q=GetCacheViewAuthenticPixels(image_view,start+first,top+y,
+        (unsigned long) (last-first+1),1,exception);
+      if (q == (PixelPacket *) NULL)
+        {
+          status=MagickFalse;
+          break;
+        }
+      fill_sum=0.0;
+      outline_sum=0.0;
+      for (x=first; x <= last; x++)
+      {
+        fill_sum+=fill_cells[y*coverage->columns+x];
+        outline_sum+=outline_cells[y*coverage->columns+x];
+        alpha=fabs(fill_sum);
+        if (draw_info->fill_rule != NonZeroRule)
+          {
+            alpha-=2.0*floor(alpha/2.0);
+            if (alpha > 1.0)
+              alpha=2.0-alpha;
+          }
+        else
+          if (alpha > 1.0)
+            alpha=1.0;
+        beta=fabs(outline_sum);
+        if (beta > alpha)
+          alpha=beta > 1.0 ? 1.0 : beta;
+        if (draw_info->stroke_antialias == MagickFalse)
+          alpha=alpha >= 0.5 ? 1.0 : 0.0;
+        if (alpha > MagickEpsilon)
+          {
+            (void) GetFillColor(draw_info,start+x,top+y,&fill_color);
+            fill_opacity=(MagickRealType) (QuantumRange-alpha*(QuantumRange-
+              fill_color.opacity));
+            MagickCompositeOver(&fill_color,fill_opacity,q,(MagickRealType)
+              q->opacity,q);
+          }
+        q++;
+      }
+      if (SyncCacheViewAuthenticPixels(image_view,exception) == MagickFalse)
+        {
+          status=MagickFalse;
+          break;
+        }
+    }
+  }
+  image_view=DestroyCacheView(image_view);
+  coverage_info=DestroyCoverageThreadSet(coverage_info);
+  outline_info=DestroyPolygonInfo(outline_info);
+  polygon_info=DestroyPolygonInfo(polygon_info);
+  return(status);
+}
+
 static MagickBooleanType DrawPolygonPrimitive(Image *image,
   const DrawInfo *draw_info,const PrimitiveInfo *primitive_info)
 {
@@ -3881,7 +5198,8 @@ static MagickBooleanType DrawPolygonPrimitive(Image *image,
         Draw point.
       */
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(status)
+  #pragma omp parallel for shared(status) \
+    magick_schedule(NeighborhoodThreadCost,image->columns,image->rows)
 #endif
       for (y=(long) (bounds.y1+0.5); y <= (long) (bounds.y2+0.5); y++)
       {
@@ -3928,7 +5246,8 @@ static MagickBooleanType DrawPolygonPrimitive(Image *image,
   if (image->matte == MagickFalse)
     (void) SetImageAlphaChannel(image,OpaqueAlphaChannel);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(status)
+  #pragma omp parallel for shared(status) \
+    magick_schedule(NeighborhoodThreadCost,image->columns,image->rows)
 #endif
   for (y=(long) (bounds.y1+0.5); y <= (long) (bounds.y2+0.5); y++)
   {
@@ -4003,6 +5322,14 @@ static MagickBooleanType DrawPolygonPrimitive(Image *image,
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 %
 %  DrawPrimitive() draws a primitive (line, rectangle, ellipse) on the image.
+%  A fill without a stroke is rasterized by accumulating the signed area each
+%  edge covers in every cell it crosses, so its cost grows with the length of
+%  the edges rather than with the number of pixels times the number of edges.
+%  Strokes, including the outline TraceStrokePolygon() builds for a wide
+%  stroke, are not rasterized this way: they keep the distance-based
+%  rasterizer, because area coverage cannot reproduce its antialiased fringe
+%  along slanted edges and stroked output would change.  Use -define
+%  draw:rasterizer=legacy to select the distance-based rasterizer for fills.
 %
 %  The format of the DrawPrimitive method is:
 %
@@ -4118,6 +5445,41 @@ static void LogPrimitiveInfo(const PrimitiveInfo *primitive_info)
   }
 }
 
+static MagickBooleanType DrawFillPolygon(Image *image,
+  const DrawInfo *draw_info,const PrimitiveInfo *primitive_info)
+{
+  const char
+    *rasterizer;
+
+  MagickBooleanType
+    status;
+
+  /*
+    A fill without a stroke is rasterized from its area coverage.  Strokes,
+    stroke patterns and lines keep the distance-based rasterizer; stroke
+    outlines from TraceStrokePolygon() are drawn by DrawPolygonPrimitive()
+    directly and never reach this path.
+  */
+  if ((primitive_info->coordinates <= 1) ||
+      (primitive_info->primitive == LinePrimitive) ||
+      (draw_info->stroke.opacity != (Quantum) TransparentOpacity) ||
+      (draw_info->stroke_pattern != (Image *) NULL) ||
+      ((primitive_info->method != FillToBorderMethod) &&
+       (primitive_info->method != FloodfillMethod)))
+    return(DrawPolygonPrimitive(image,draw_info,primitive_info));
+  rasterizer=GetImageArtifact(image,"draw:rasterizer");
+  if ((rasterizer != (const char *) NULL) &&
+      (LocaleCompare(rasterizer,"legacy") == 0))
+    return(DrawPolygonPrimitive(image,draw_info,primitive_info));
+  if (image->debug != MagickFalse)
+    (void) LogMagickEvent(DrawEvent,GetMagickModule(),
+      "    begin draw-polygon coverage");
+  status=DrawCoveragePolygon(image,draw_info,primitive_info);
+  if (image->debug != MagickFalse)
+    (void) LogMagickEvent(DrawEvent,GetMagickModule(),"    end draw-polygon");
+  return(status);
+}
+
 MagickExport MagickBooleanType DrawPrimitive(Image *image,
   const DrawInfo *draw_info,const PrimitiveInfo *primitive_info)
 {
@@ -4510,7 +5872,7 @@ MagickExport MagickBooleanType DrawPrimitive(Image *image,
           clone_info=CloneDrawInfo((ImageInfo *) NULL,draw_info);
           clone_info->stroke_width=0.0;
           clone_info->stroke.opacity=(Quantum) TransparentOpacity;
-          status=DrawPolygonPrimitive(image,clone_info,primitive_info);
+          status=DrawFillPolygon(image,clone_info,primitive_info);
           clone_info=DestroyDrawInfo(clone_info);
           (void) DrawDashPolygon(draw_info,primitive_info,image);
           break;
@@ -4542,12 +5904,12 @@ MagickExport MagickBooleanType DrawPrimitive(Image *image,
           clone_info=CloneDrawInfo((ImageInfo *) NULL,draw_info);
           clone_info->stroke_width=0.0;
           clone_info->stroke.opacity=(Quantum) TransparentOpacity;
-          status=DrawPolygonPrimitive(image,clone_info,primitive_info);
+          status=DrawFillPolygon(image,clone_info,primitive_info);
           clone_info=DestroyDrawInfo(clone_info);
           status|=DrawStrokePolygon(image,draw_info,primitive_info);
           break;
         }
-      status=DrawPolygonPrimitive(image,draw_info,primitive_info);
+      status=DrawFillPolygon(image,draw_info,primitive_info);
       break;
     }
   }
@@ -4639,6 +6001,11 @@ static MagickBooleanType DrawStrokePolygon(Image *image,
   for (p=primitive_info; p->primitive != UndefinedPrimitive; p+=p->coordinates)
   {
     stroke_polygon=TraceStrokePolygon(draw_info,p);
+    if (stroke_polygon == (PrimitiveInfo *) NULL)
+      {
+        status=MagickFalse;
+        break;
+      }
     status=DrawPolygonPrimitive(image,clone_info,stroke_polygon);
     stroke_polygon=(PrimitiveInfo *) RelinquishMagickMemory(stroke_polygon);
     q=p+p->coordinates-1;
@@ -322,6 +322,9 @@ typedef struct _DrawInfo
     interline_spacing;
 } DrawInfo;
 
+typedef struct _DisplayListInfo
+  DisplayListInfo;
+
 typedef struct _PrimitiveInfo
 {
   PointInfo
@@ -361,6 +364,10 @@ typedef struct _TypeMetric
     origin;
 } TypeMetric;
 
+extern MagickExport DisplayListInfo
+  *AcquireDisplayList(const Image *,const DrawInfo *,ExceptionInfo *),
+  *DestroyDisplayList(DisplayListInfo *);
+
 extern MagickExport DrawInfo
   *AcquireDrawInfo(void),
   *CloneDrawInfo(const ImageInfo *,const DrawInfo *),
@@ -369,12 +376,15 @@ extern MagickExport DrawInfo
 extern MagickExport MagickBooleanType
   DrawAffineImage(Image *,const Image *,const AffineMatrix *),
   DrawClipPath(Image *,const DrawInfo *,const char *),
+  DrawComponentGenesis(void),
+  DrawDisplayList(Image *,const DisplayListInfo *,const char **),
   DrawGradientImage(Image *,const DrawInfo *),
   DrawImage(Image *,const DrawInfo *),
   DrawPatternPath(Image *,const DrawInfo *,const char *,Image **),
   DrawPrimitive(Image *,const DrawInfo *,const PrimitiveInfo *);
 
 extern MagickExport void
+  DrawComponentTerminus(void),
   GetAffineMatrix(AffineMatrix *),
   GetDrawInfo(const ImageInfo *,DrawInfo *);
 
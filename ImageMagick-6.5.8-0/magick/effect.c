@@ -43,6 +43,7 @@
 #include "magick/studio.h"
 #include "magick/property.h"
 #include "magick/blob.h"
+#include "magick/cache-private.h"
 #include "magick/cache-view.h"
 #include "magick/color.h"
 #include "magick/color-private.h"
@@ -80,6 +81,7 @@
 #include "magick/signature-private.h"
 #include "magick/string_.h"
 #include "magick/thread-private.h"
+#include "magick/trace.h"
 #include "magick/transform.h"
 #include "magick/threshold.h"
 
@@ -268,7 +270,8 @@ MagickExport Image *AdaptiveBlurImageChannel(const Image *image,
   edge_view=AcquireCacheView(edge_image);
   blur_view=AcquireCacheView(blur_image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(IntensiveThreadCost,blur_image->columns,blur_image->rows)
 #endif
   for (y=0; y < (long) blur_image->rows; y++)
   {
@@ -585,7 +588,8 @@ MagickExport Image *AdaptiveSharpenImageChannel(const Image *image,
   edge_view=AcquireCacheView(edge_image);
   sharp_view=AcquireCacheView(sharp_image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(IntensiveThreadCost,sharp_image->columns,sharp_image->rows)
 #endif
   for (y=0; y < (long) sharp_image->rows; y++)
   {
@@ -832,12 +836,18 @@ MagickExport Image *BlurImageChannel(const Image *image,
   MagickPixelPacket
     bias;
 
+  Quantum
+    *planes[4];
+
   register long
     i;
 
   unsigned long
     width;
 
+  VirtualPixelMethod
+    method;
+
   CacheView
     *blur_view,
     *image_view;
@@ -900,10 +910,208 @@ MagickExport Image *BlurImageChannel(const Image *image,
   progress=0;
   GetMagickPixelPacket(image,&bias);
   SetMagickPixelPacketBias(image,&bias);
+  method=GetImageVirtualPixelMethod(blur_image);
+  if ((((channel & OpacityChannel) == 0) || (image->matte == MagickFalse)) &&
+      (((channel & IndexChannel) == 0) ||
+       (image->colorspace != CMYKColorspace)) &&
+      ((method == UndefinedVirtualPixelMethod) ||
+       (method == EdgeVirtualPixelMethod)) &&
+      (GetAuthenticPixelPlanes(blur_image,channel,planes,exception) !=
+       MagickFalse))
+    {
+      MagickRealType
+        offsets[4],
+        **sums;
+
+      MagickSizeType
+        span;
+
+      MemoryArena
+        *arena;
+
+      Quantum
+        *buffer;
+
+      register long
+        j;
+
+      unsigned long
+        number_threads;
+
+      /*
+        Blur each channel plane: its rows into a scratch plane, then the
+        columns of the scratch plane back a row at a time, so every pass runs
+        with unit stride.  The blur image starts as a copy of the image.
+      */
+      number_threads=GetOpenMPMaximumThreads();
+      arena=AcquireMemoryArena(0);
+      buffer=(Quantum *) AcquireArenaMemory(arena,(size_t) blur_image->columns*
+        blur_image->rows,sizeof(*buffer));
+      sums=(MagickRealType **) AcquireArenaMemory(arena,number_threads,
+        sizeof(*sums));
+      if (sums != (MagickRealType **) NULL)
+        for (i=0; i < (long) number_threads; i++)
+        {
+          sums[i]=(MagickRealType *) AcquireArenaMemory(arena,
+            blur_image->columns,sizeof(**sums));
+          if (sums[i] == (MagickRealType *) NULL)
+            {
+              sums=(MagickRealType **) NULL;
+              break;
+            }
+        }
+      if ((buffer == (Quantum *) NULL) || (sums == (MagickRealType **) NULL))
+        {
+          arena=RelinquishMemoryArena(arena);
+          kernel=(double *) RelinquishMagickMemory(kernel);
+          blur_image=DestroyImage(blur_image);
+          ThrowImageException(ResourceLimitError,"MemoryAllocationFailed");
+        }
+      offsets[0]=bias.red;
+      offsets[1]=bias.green;
+      offsets[2]=bias.blue;
+      offsets[3]=bias.opacity;
+      span=0;
+      for (j=0; j < 4; j++)
+        if (planes[j] != (Quantum *) NULL)
+          span+=2*blur_image->rows;
+      status=MagickTrue;
+      progress=0;
+      for (j=0; j < 4; j++)
+      {
+        if (planes[j] == (Quantum *) NULL)
+          continue;
+#if defined(MAGICKCORE_OPENMP_SUPPORT)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(IntensiveThreadCost,blur_image->columns,blur_image->rows)
+#endif
+        for (y=0; y < (long) blur_image->rows; y++)
+        {
+          register const Quantum
+            *__restrict p;
+
+          register long
+            x;
+
+          register Quantum
+            *__restrict q;
+
+          if (status == MagickFalse)
+            continue;
+          p=planes[j]+y*blur_image->columns;
+          q=buffer+y*blur_image->columns;
+          for (x=0; x < (long) blur_image->columns; x++)
+          {
+            MagickRealType
+              pixel;
+
+            register long
+              i,
+              u;
+
+            pixel=offsets[j];
+            u=x-((long) width/2L);
+            if ((u >= 0) && ((u+(long) width) <= (long) blur_image->columns))
+              for (i=0; i < (long) width; i++)
+                pixel+=kernel[i]*p[u+i];
+            else
+              for (i=0; i < (long) width; i++)
+              {
+                if ((u+i) < 0)
+                  pixel+=kernel[i]*p[0];
+                else
+                  if ((u+i) >= (long) blur_image->columns)
+                    pixel+=kernel[i]*p[blur_image->columns-1];
+                  else
+                    pixel+=kernel[i]*p[u+i];
+              }
+            q[x]=RoundToQuantum(pixel);
+          }
+          if (image->progress_monitor != (MagickProgressMonitor) NULL)
+            {
+              MagickBooleanType
+                proceed;
+
+#if defined(MAGICKCORE_OPENMP_SUPPORT)
+  #pragma omp critical (MagickCore_BlurImageChannel)
+#endif
+              proceed=SetImageProgress(image,BlurImageTag,progress++,span);
+              if (proceed == MagickFalse)
+                status=MagickFalse;
+            }
+        }
+#if defined(MAGICKCORE_OPENMP_SUPPORT)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(IntensiveThreadCost,blur_image->columns,blur_image->rows)
+#endif
+        for (y=0; y < (long) blur_image->rows; y++)
+        {
+          register long
+            i,
+            x;
+
+          register MagickRealType
+            *__restrict sum;
+
+          register Quantum
+            *__restrict q;
+
+          if (status == MagickFalse)
+            continue;
+          sum=sums[GetOpenMPThreadId()];
+          for (x=0; x < (long) blur_image->columns; x++)
+            sum[x]=offsets[j];
+          for (i=0; i < (long) width; i++)
+          {
+            long
+              v;
+
+            register const Quantum
+              *__restrict p;
+
+            v=y-((long) width/2L)+i;
+            if (v < 0)
+              v=0;
+            if (v >= (long) blur_image->rows)
+              v=(long) blur_image->rows-1;
+            p=buffer+v*blur_image->columns;
+            for (x=0; x < (long) blur_image->columns; x++)
+              sum[x]+=kernel[i]*p[x];
+          }
+          q=planes[j]+y*blur_image->columns;
+          for (x=0; x < (long) blur_image->columns; x++)
+            q[x]=RoundToQuantum(sum[x]);
+          if (image->progress_monitor != (MagickProgressMonitor) NULL)
+            {
+              MagickBooleanType
+                proceed;
+
+#if defined(MAGICKCORE_OPENMP_SUPPORT)
+  #pragma omp critical (MagickCore_BlurImageChannel)
+#endif
+              proceed=SetImageProgress(image,BlurImageTag,progress++,span);
+              if (proceed == MagickFalse)
+                status=MagickFalse;
+            }
+        }
+      }
+      arena=RelinquishMemoryArena(arena);
+      kernel=(double *) RelinquishMagickMemory(kernel);
+      if (status == MagickFalse)
+        {
+          blur_image=DestroyImage(blur_image);
+          return((Image *) NULL);
+        }
+      blur_image->type=image->type;
+      return(blur_image);
+    }
   image_view=AcquireCacheView(image);
   blur_view=AcquireCacheView(blur_image);
+  TraceMagickEvent(OpenMPTrace,BeginTracePhase,"BlurImageChannel","rows",
+    (MagickSizeType) GetOpenMPMaximumThreads());
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(IntensiveThreadCost,blur_image->columns,blur_image->rows)
 #endif
   for (y=0; y < (long) blur_image->rows; y++)
   {
@@ -1074,6 +1282,8 @@ MagickExport Image *BlurImageChannel(const Image *image,
           status=MagickFalse;
       }
   }
+  TraceMagickEvent(OpenMPTrace,EndTracePhase,"BlurImageChannel","rows",
+    (MagickSizeType) GetOpenMPMaximumThreads());
   blur_view=DestroyCacheView(blur_view);
   image_view=DestroyCacheView(image_view);
   /*
@@ -1081,8 +1291,11 @@ MagickExport Image *BlurImageChannel(const Image *image,
   */
   image_view=AcquireCacheView(blur_image);
   blur_view=AcquireCacheView(blur_image);
+  TraceMagickEvent(OpenMPTrace,BeginTracePhase,"BlurImageChannel","columns",
+    (MagickSizeType) GetOpenMPMaximumThreads());
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(IntensiveThreadCost,blur_image->rows,blur_image->columns)
 #endif
   for (x=0; x < (long) blur_image->columns; x++)
   {
@@ -1252,6 +1465,8 @@ MagickExport Image *BlurImageChannel(const Image *image,
           status=MagickFalse;
       }
   }
+  TraceMagickEvent(OpenMPTrace,EndTracePhase,"BlurImageChannel","columns",
+    (MagickSizeType) GetOpenMPMaximumThreads());
   blur_view=DestroyCacheView(blur_view);
   image_view=DestroyCacheView(image_view);
   kernel=(double *) RelinquishMagickMemory(kernel);
@@ -1287,20 +1502,7 @@ MagickExport Image *BlurImageChannel(const Image *image,
 %
 */
 
-static Quantum **DestroyPixelThreadSet(Quantum **pixels)
-{
-  register long
-    i;
-
-  assert(pixels != (Quantum **) NULL);
-  for (i=0; i < (long) GetOpenMPMaximumThreads(); i++)
-    if (pixels[i] != (Quantum *) NULL)
-      pixels[i]=(Quantum *) RelinquishMagickMemory(pixels[i]);
-  pixels=(Quantum **) RelinquishAlignedMemory(pixels);
-  return(pixels);
-}
-
-static Quantum **AcquirePixelThreadSet(const size_t count)
+static Quantum **AcquirePixelThreadSet(MemoryArena *arena,const size_t count)
 {
   register long
     i;
@@ -1312,15 +1514,14 @@ static Quantum **AcquirePixelThreadSet(const size_t count)
     number_threads;
 
   number_threads=GetOpenMPMaximumThreads();
-  pixels=(Quantum **) AcquireAlignedMemory(number_threads,sizeof(*pixels));
+  pixels=(Quantum **) AcquireArenaMemory(arena,number_threads,sizeof(*pixels));
   if (pixels == (Quantum **) NULL)
     return((Quantum **) NULL);
-  (void) ResetMagickMemory(pixels,0,number_threads*sizeof(*pixels));
   for (i=0; i < (long) number_threads; i++)
   {
-    pixels[i]=(Quantum *) AcquireQuantumMemory(count,sizeof(**pixels));
+    pixels[i]=(Quantum *) AcquireArenaMemory(arena,count,sizeof(**pixels));
     if (pixels[i] == (Quantum *) NULL)
-      return(DestroyPixelThreadSet(pixels));
+      return((Quantum **) NULL);
   }
   return(pixels);
 }
@@ -1442,6 +1643,9 @@ MagickExport Image *DespeckleImage(const Image *image,ExceptionInfo *exception)
   MagickBooleanType
     status;
 
+  MemoryArena
+    *arena;
+
   Quantum
     **buffers,
     **pixels;
@@ -1476,14 +1680,12 @@ MagickExport Image *DespeckleImage(const Image *image,ExceptionInfo *exception)
     Allocate image buffers.
   */
   length=(size_t) ((image->columns+2)*(image->rows+2));
-  pixels=AcquirePixelThreadSet(length);
-  buffers=AcquirePixelThreadSet(length);
+  arena=AcquireMemoryArena(0);
+  pixels=AcquirePixelThreadSet(arena,length);
+  buffers=AcquirePixelThreadSet(arena,length);
   if ((pixels == (Quantum **) NULL) || (buffers == (Quantum **) NULL))
     {
-      if (buffers != (Quantum **) NULL)
-        buffers=DestroyPixelThreadSet(buffers);
-      if (pixels != (Quantum **) NULL)
-        pixels=DestroyPixelThreadSet(pixels);
+      arena=RelinquishMemoryArena(arena);
       despeckle_image=DestroyImage(despeckle_image);
       ThrowImageException(ResourceLimitError,"MemoryAllocationFailed");
     }
@@ -1494,7 +1696,8 @@ MagickExport Image *DespeckleImage(const Image *image,ExceptionInfo *exception)
   image_view=AcquireCacheView(image);
   despeckle_view=AcquireCacheView(despeckle_image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(status)
+  #pragma omp parallel for shared(status) \
+    magick_schedule(NeighborhoodThreadCost,image->columns*image->rows,4)
 #endif
   for (channel=0; channel <= 3; channel++)
   {
@@ -1600,8 +1803,7 @@ MagickExport Image *DespeckleImage(const Image *image,ExceptionInfo *exception)
   }
   despeckle_view=DestroyCacheView(despeckle_view);
   image_view=DestroyCacheView(image_view);
-  buffers=DestroyPixelThreadSet(buffers);
-  pixels=DestroyPixelThreadSet(pixels);
+  arena=RelinquishMemoryArena(arena);
   despeckle_image->type=image->type;
   if (status == MagickFalse)
     despeckle_image=DestroyImage(despeckle_image);
@@ -1919,62 +2121,39 @@ typedef struct _MedianPixelList
     lists[MedianListChannels];
 } MedianPixelList;
 
-static MedianPixelList *DestroyMedianPixelList(MedianPixelList *pixel_list)
-{
-  register long
-    i;
-
-  if (pixel_list == (MedianPixelList *) NULL)
-    return((MedianPixelList *) NULL);
-  for (i=0; i < MedianListChannels; i++)
-    if (pixel_list->lists[i].nodes != (MedianListNode *) NULL)
-      pixel_list->lists[i].nodes=(MedianListNode *) RelinquishMagickMemory(
-        pixel_list->lists[i].nodes);
-  pixel_list=(MedianPixelList *) RelinquishAlignedMemory(pixel_list);
-  return(pixel_list);
-}
-
-static MedianPixelList **DestroyMedianPixelListThreadSet(
-  MedianPixelList **pixel_list)
+static MedianPixelList *AcquireMedianPixelList(MemoryArena *arena,
+  const unsigned long width)
 {
-  register long
-    i;
-
-  assert(pixel_list != (MedianPixelList **) NULL);
-  for (i=0; i < (long) GetOpenMPMaximumThreads(); i++)
-    if (pixel_list[i] != (MedianPixelList *) NULL)
-      pixel_list[i]=DestroyMedianPixelList(pixel_list[i]);
-  pixel_list=(MedianPixelList **) RelinquishAlignedMemory(pixel_list);
-  return(pixel_list);
-}
+  MedianListNode
+    *nodes;
 
-static MedianPixelList *AcquireMedianPixelList(const unsigned long width)
-{
   MedianPixelList
     *pixel_list;
 
   register long
     i;
 
-  pixel_list=(MedianPixelList *) AcquireAlignedMemory(1,sizeof(*pixel_list));
+  /*
+    One arena block holds the skip list nodes of every channel.
+  */
+  pixel_list=(MedianPixelList *) AcquireArenaMemory(arena,1,
+    sizeof(*pixel_list));
   if (pixel_list == (MedianPixelList *) NULL)
     return(pixel_list);
   (void) ResetMagickMemory((void *) pixel_list,0,sizeof(*pixel_list));
   pixel_list->center=width*width/2;
+  nodes=(MedianListNode *) AcquireArenaMemory(arena,MedianListChannels*
+    65537UL,sizeof(*nodes));
+  if (nodes == (MedianListNode *) NULL)
+    return((MedianPixelList *) NULL);
+  (void) ResetMagickMemory(nodes,0,MedianListChannels*65537UL*sizeof(*nodes));
   for (i=0; i < MedianListChannels; i++)
-  {
-    pixel_list->lists[i].nodes=(MedianListNode *) AcquireQuantumMemory(65537UL,
-      sizeof(*pixel_list->lists[i].nodes));
-    if (pixel_list->lists[i].nodes == (MedianListNode *) NULL)
-      return(DestroyMedianPixelList(pixel_list));
-    (void) ResetMagickMemory(pixel_list->lists[i].nodes,0,65537UL*
-      sizeof(*pixel_list->lists[i].nodes));
-  }
+    pixel_list->lists[i].nodes=nodes+i*65537UL;
   pixel_list->signature=MagickSignature;
   return(pixel_list);
 }
 
-static MedianPixelList **AcquireMedianPixelListThreadSet(
+static MedianPixelList **AcquireMedianPixelListThreadSet(MemoryArena *arena,
   const unsigned long width)
 {
   register long
@@ -1987,16 +2166,15 @@ static MedianPixelList **AcquireMedianPixelListThreadSet(
     number_threads;
 
   number_threads=GetOpenMPMaximumThreads();
-  pixel_list=(MedianPixelList **) AcquireAlignedMemory(number_threads,
+  pixel_list=(MedianPixelList **) AcquireArenaMemory(arena,number_threads,
     sizeof(*pixel_list));
   if (pixel_list == (MedianPixelList **) NULL)
     return((MedianPixelList **) NULL);
-  (void) ResetMagickMemory(pixel_list,0,number_threads*sizeof(*pixel_list));
   for (i=0; i < (long) number_threads; i++)
   {
-    pixel_list[i]=AcquireMedianPixelList(width);
+    pixel_list[i]=AcquireMedianPixelList(arena,width);
     if (pixel_list[i] == (MedianPixelList *) NULL)
-      return(DestroyMedianPixelListThreadSet(pixel_list));
+      return((MedianPixelList **) NULL);
   }
   return(pixel_list);
 }
@@ -2193,6 +2371,9 @@ MagickExport Image *MedianFilterImage(const Image *image,const double radius,
   MagickBooleanType
     status;
 
+  MemoryArena
+    *arena;
+
   MedianPixelList
     **pixel_list;
 
@@ -2225,9 +2406,11 @@ MagickExport Image *MedianFilterImage(const Image *image,const double radius,
       median_image=DestroyImage(median_image);
       return((Image *) NULL);
     }
-  pixel_list=AcquireMedianPixelListThreadSet(width);
+  arena=AcquireMemoryArena(0);
+  pixel_list=AcquireMedianPixelListThreadSet(arena,width);
   if (pixel_list == (MedianPixelList **) NULL)
     {
+      arena=RelinquishMemoryArena(arena);
       median_image=DestroyImage(median_image);
       ThrowImageException(ResourceLimitError,"MemoryAllocationFailed");
     }
@@ -2239,7 +2422,9 @@ MagickExport Image *MedianFilterImage(const Image *image,const double radius,
   image_view=AcquireCacheView(image);
   median_view=AcquireCacheView(median_image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(IntensiveThreadCost,median_image->columns, \
+      median_image->rows)
 #endif
   for (y=0; y < (long) median_image->rows; y++)
   {
@@ -2321,7 +2506,7 @@ MagickExport Image *MedianFilterImage(const Image *image,const double radius,
   }
   median_view=DestroyCacheView(median_view);
   image_view=DestroyCacheView(image_view);
-  pixel_list=DestroyMedianPixelListThreadSet(pixel_list);
+  arena=RelinquishMemoryArena(arena);
   return(median_image);
 }
 
@@ -2511,7 +2696,8 @@ MagickExport Image *MotionBlurImageChannel(const Image *image,
   image_view=AcquireCacheView(image);
   blur_view=AcquireCacheView(blur_image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(IntensiveThreadCost,image->columns,image->rows)
 #endif
   for (y=0; y < (long) image->rows; y++)
   {
@@ -3286,7 +3472,8 @@ MagickExport Image *RadialBlurImageChannel(const Image *image,
   image_view=AcquireCacheView(image);
   blur_view=AcquireCacheView(blur_image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(IntensiveThreadCost,blur_image->columns,blur_image->rows)
 #endif
   for (y=0; y < (long) blur_image->rows; y++)
   {
@@ -3551,6 +3738,9 @@ MagickExport Image *ReduceNoiseImage(const Image *image,const double radius,
   MagickBooleanType
     status;
 
+  MemoryArena
+    *arena;
+
   MedianPixelList
     **pixel_list;
 
@@ -3583,9 +3773,11 @@ MagickExport Image *ReduceNoiseImage(const Image *image,const double radius,
       noise_image=DestroyImage(noise_image);
       return((Image *) NULL);
     }
-  pixel_list=AcquireMedianPixelListThreadSet(width);
+  arena=AcquireMemoryArena(0);
+  pixel_list=AcquireMedianPixelListThreadSet(arena,width);
   if (pixel_list == (MedianPixelList **) NULL)
     {
+      arena=RelinquishMemoryArena(arena);
       noise_image=DestroyImage(noise_image);
       ThrowImageException(ResourceLimitError,"MemoryAllocationFailed");
     }
@@ -3597,7 +3789,8 @@ MagickExport Image *ReduceNoiseImage(const Image *image,const double radius,
   image_view=AcquireCacheView(image);
   noise_view=AcquireCacheView(noise_image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(IntensiveThreadCost,noise_image->columns,noise_image->rows)
 #endif
   for (y=0; y < (long) noise_image->rows; y++)
   {
@@ -3679,7 +3872,7 @@ MagickExport Image *ReduceNoiseImage(const Image *image,const double radius,
   }
   noise_view=DestroyCacheView(noise_view);
   image_view=DestroyCacheView(image_view);
-  pixel_list=DestroyMedianPixelListThreadSet(pixel_list);
+  arena=RelinquishMemoryArena(arena);
   return(noise_image);
 }
 
@@ -3851,7 +4044,8 @@ MagickExport Image *SelectiveBlurImageChannel(const Image *image,
   image_view=AcquireCacheView(image);
   blur_view=AcquireCacheView(blur_image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(IntensiveThreadCost,image->columns,image->rows)
 #endif
   for (y=0; y < (long) image->rows; y++)
   {
@@ -4187,7 +4381,8 @@ MagickExport Image *ShadeImage(const Image *image,const MagickBooleanType gray,
   image_view=AcquireCacheView(image);
   shade_view=AcquireCacheView(shade_image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(NeighborhoodThreadCost,image->columns,image->rows)
 #endif
   for (y=0; y < (long) image->rows; y++)
   {
@@ -4484,7 +4679,9 @@ MagickExport Image *SpreadImage(const Image *image,const double radius,
   random_info=AcquireRandomInfoThreadSet();
   image_view=AcquireCacheView(spread_image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(NeighborhoodThreadCost,spread_image->columns, \
+      spread_image->rows)
 #endif
   for (y=0; y < (long) spread_image->rows; y++)
   {
@@ -4643,7 +4840,8 @@ MagickExport Image *UnsharpMaskImageChannel(const Image *image,
   image_view=AcquireCacheView(image);
   unsharp_view=AcquireCacheView(unsharp_image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
   for (y=0; y < (long) image->rows; y++)
   {
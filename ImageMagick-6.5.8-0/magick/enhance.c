@@ -43,6 +43,7 @@
 #include "magick/studio.h"
 #include "magick/artifact.h"
 #include "magick/cache.h"
+#include "magick/cache-private.h"
 #include "magick/cache-view.h"
 #include "magick/color.h"
 #include "magick/color-private.h"
@@ -460,7 +461,8 @@ MagickExport MagickBooleanType ColorDecisionListImage(Image *image,
     ThrowBinaryException(ResourceLimitError,"MemoryAllocationFailed",
       image->filename);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4)
+  #pragma omp parallel for \
+    magick_schedule(PointThreadCost,1,MaxMap)
 #endif
   for (i=0; i <= (long) MaxMap; i++)
   {
@@ -480,7 +482,8 @@ MagickExport MagickBooleanType ColorDecisionListImage(Image *image,
         Apply transfer function to colormap.
       */
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(PointThreadCost,1,image->colors)
 #endif
       for (i=0; i < (long) image->colors; i++)
       {
@@ -506,7 +509,8 @@ MagickExport MagickBooleanType ColorDecisionListImage(Image *image,
   exception=(&image->exception);
   image_view=AcquireCacheView(image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
   for (y=0; y < (long) image->rows; y++)
   {
@@ -654,7 +658,8 @@ MagickExport MagickBooleanType ClutImageChannel(Image *image,
     exception);
   image_view=AcquireCacheView(image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
   for (y=0; y < (long) image->rows; y++)
   {
@@ -887,7 +892,8 @@ MagickExport MagickBooleanType ContrastImage(Image *image,
   exception=(&image->exception);
   image_view=AcquireCacheView(image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
   for (y=0; y < (long) image->rows; y++)
   {
@@ -1225,7 +1231,8 @@ MagickExport MagickBooleanType ContrastStretchImageChannel(Image *image,
   */
   (void) ResetMagickMemory(stretch_map,0,(MaxMap+1)*sizeof(*stretch_map));
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(PointThreadCost,1,MaxMap)
 #endif
   for (i=0; i <= (long) MaxMap; i++)
   {
@@ -1307,7 +1314,8 @@ MagickExport MagickBooleanType ContrastStretchImageChannel(Image *image,
         Stretch colormap.
       */
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(PointThreadCost,1,image->colors)
 #endif
       for (i=0; i < (long) image->colors; i++)
       {
@@ -1343,7 +1351,8 @@ MagickExport MagickBooleanType ContrastStretchImageChannel(Image *image,
   status=MagickTrue;
   progress=0;
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
   for (y=0; y < (long) image->rows; y++)
   {
@@ -1522,7 +1531,8 @@ MagickExport Image *EnhanceImage(const Image *image,ExceptionInfo *exception)
   image_view=AcquireCacheView(image);
   enhance_view=AcquireCacheView(enhance_image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
   for (y=0; y < (long) image->rows; y++)
   {
@@ -1755,7 +1765,8 @@ MagickExport MagickBooleanType EqualizeImageChannel(Image *image,
   white=map[(int) MaxMap];
   (void) ResetMagickMemory(equalize_map,0,(MaxMap+1)*sizeof(*equalize_map));
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(PointThreadCost,1,MaxMap)
 #endif
   for (i=0; i <= (long) MaxMap; i++)
   {
@@ -1786,7 +1797,8 @@ MagickExport MagickBooleanType EqualizeImageChannel(Image *image,
         Equalize colormap.
       */
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(PointThreadCost,1,image->colors)
 #endif
       for (i=0; i < (long) image->colors; i++)
       {
@@ -1813,7 +1825,8 @@ MagickExport MagickBooleanType EqualizeImageChannel(Image *image,
   exception=(&image->exception);
   image_view=AcquireCacheView(image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
   for (y=0; y < (long) image->rows; y++)
   {
@@ -1965,7 +1978,8 @@ MagickExport MagickBooleanType GammaImageChannel(Image *image,
     status;
 
   Quantum
-    *gamma_map;
+    *gamma_map,
+    *planes[4];
 
   register long
     i;
@@ -1989,7 +2003,8 @@ MagickExport MagickBooleanType GammaImageChannel(Image *image,
   (void) ResetMagickMemory(gamma_map,0,(MaxMap+1)*sizeof(*gamma_map));
   if (gamma != 0.0)
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4)
+  #pragma omp parallel for \
+    magick_schedule(PointThreadCost,1,MaxMap)
 #endif
     for (i=0; i <= (long) MaxMap; i++)
       gamma_map[i]=RoundToQuantum((MagickRealType) ScaleMapToQuantum((
@@ -2000,7 +2015,8 @@ MagickExport MagickBooleanType GammaImageChannel(Image *image,
         Gamma-correct colormap.
       */
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(PointThreadCost,1,image->colors)
 #endif
       for (i=0; i < (long) image->colors; i++)
       {
@@ -2031,9 +2047,64 @@ MagickExport MagickBooleanType GammaImageChannel(Image *image,
   status=MagickTrue;
   progress=0;
   exception=(&image->exception);
+  if ((((channel & IndexChannel) == 0) ||
+       (image->colorspace != CMYKColorspace)) &&
+      (GetAuthenticPixelPlanes(image,channel,planes,exception) != MagickFalse))
+    {
+      /*
+        Gamma-correct each channel plane.
+      */
+#if defined(MAGICKCORE_OPENMP_SUPPORT)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
+#endif
+      for (y=0; y < (long) image->rows; y++)
+      {
+        register long
+          j,
+          x;
+
+        register Quantum
+          *__restrict q;
+
+        if (status == MagickFalse)
+          continue;
+        for (j=0; j < 4; j++)
+        {
+          if (planes[j] == (Quantum *) NULL)
+            continue;
+          q=planes[j]+y*image->columns;
+          if ((j == 3) && (image->matte != MagickFalse))
+            for (x=0; x < (long) image->columns; x++)
+              q[x]=(Quantum) QuantumRange-gamma_map[ScaleQuantumToMap(
+                (Quantum) (QuantumRange-q[x]))];
+          else
+            for (x=0; x < (long) image->columns; x++)
+              q[x]=gamma_map[ScaleQuantumToMap(q[x])];
+        }
+        if (image->progress_monitor != (MagickProgressMonitor) NULL)
+          {
+            MagickBooleanType
+              proceed;
+
+#if defined(MAGICKCORE_OPENMP_SUPPORT)
+  #pragma omp critical (MagickCore_GammaImageChannel)
+#endif
+            proceed=SetImageProgress(image,GammaCorrectImageTag,progress++,
+              image->rows);
+            if (proceed == MagickFalse)
+              status=MagickFalse;
+          }
+      }
+      gamma_map=(Quantum *) RelinquishMagickMemory(gamma_map);
+      if (image->gamma != 0.0)
+        image->gamma*=gamma;
+      return(status);
+    }
   image_view=AcquireCacheView(image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
   for (y=0; y < (long) image->rows; y++)
   {
@@ -2221,7 +2292,8 @@ MagickExport MagickBooleanType HaldClutImageChannel(Image *image,
     exception);
   image_view=AcquireCacheView(image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(NeighborhoodThreadCost,image->columns,image->rows)
 #endif
   for (y=0; y < (long) image->rows; y++)
   {
@@ -2492,7 +2564,8 @@ MagickExport MagickBooleanType LevelImageChannel(Image *image,
     (void) LogMagickEvent(TraceEvent,GetMagickModule(),"%s",image->filename);
   if (image->storage_class == PseudoClass)
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(PointThreadCost,1,image->colors)
 #endif
     for (i=0; i < (long) image->colors; i++)
     {
@@ -2516,7 +2589,8 @@ MagickExport MagickBooleanType LevelImageChannel(Image *image,
   exception=(&image->exception);
   image_view=AcquireCacheView(image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
   for (y=0; y < (long) image->rows; y++)
   {
@@ -2649,7 +2723,8 @@ MagickExport MagickBooleanType LevelizeImageChannel(Image *image,
     (void) LogMagickEvent(TraceEvent,GetMagickModule(),"%s",image->filename);
   if (image->storage_class == PseudoClass)
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(PointThreadCost,1,image->colors)
 #endif
     for (i=0; i < (long) image->colors; i++)
     {
@@ -2673,7 +2748,8 @@ MagickExport MagickBooleanType LevelizeImageChannel(Image *image,
   exception=(&image->exception);
   image_view=AcquireCacheView(image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
   for (y=0; y < (long) image->rows; y++)
   {
@@ -3122,7 +3198,8 @@ MagickExport MagickBooleanType ModulateImage(Image *image,const char *modulate)
         Modulate colormap.
       */
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(PointThreadCost,1,image->colors)
 #endif
       for (i=0; i < (long) image->colors; i++)
         switch (colorspace)
@@ -3159,7 +3236,8 @@ MagickExport MagickBooleanType ModulateImage(Image *image,const char *modulate)
   exception=(&image->exception);
   image_view=AcquireCacheView(image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
   for (y=0; y < (long) image->rows; y++)
   {
@@ -3278,6 +3356,9 @@ MagickExport MagickBooleanType NegateImageChannel(Image *image,
   MagickBooleanType
     status;
 
+  Quantum
+    *planes[4];
+
   register long
     i;
 
@@ -3294,7 +3375,8 @@ MagickExport MagickBooleanType NegateImageChannel(Image *image,
         Negate colormap.
       */
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(PointThreadCost,1,image->colors)
 #endif
       for (i=0; i < (long) image->colors; i++)
       {
@@ -3323,7 +3405,8 @@ MagickExport MagickBooleanType NegateImageChannel(Image *image,
   if (grayscale != MagickFalse)
     {
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
       for (y=0; y < (long) image->rows; y++)
       {
@@ -3389,11 +3472,59 @@ MagickExport MagickBooleanType NegateImageChannel(Image *image,
       image_view=DestroyCacheView(image_view);
       return(MagickTrue);
     }
+  if ((((channel & IndexChannel) == 0) ||
+       (image->colorspace != CMYKColorspace)) &&
+      (GetAuthenticPixelPlanes(image,channel,planes,exception) != MagickFalse))
+    {
+      /*
+        Negate each channel plane.
+      */
+#if defined(MAGICKCORE_OPENMP_SUPPORT)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
+#endif
+      for (y=0; y < (long) image->rows; y++)
+      {
+        register long
+          j,
+          x;
+
+        register Quantum
+          *__restrict q;
+
+        if (status == MagickFalse)
+          continue;
+        for (j=0; j < 4; j++)
+        {
+          if (planes[j] == (Quantum *) NULL)
+            continue;
+          q=planes[j]+y*image->columns;
+          for (x=0; x < (long) image->columns; x++)
+            q[x]=(Quantum) QuantumRange-q[x];
+        }
+        if (image->progress_monitor != (MagickProgressMonitor) NULL)
+          {
+            MagickBooleanType
+              proceed;
+
+#if defined(MAGICKCORE_OPENMP_SUPPORT)
+  #pragma omp critical (MagickCore_NegateImageChannel)
+#endif
+            proceed=SetImageProgress(image,NegateImageTag,progress++,
+              image->rows);
+            if (proceed == MagickFalse)
+              status=MagickFalse;
+          }
+      }
+      image_view=DestroyCacheView(image_view);
+      return(status);
+    }
   /*
     Negate image.
   */
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
   for (y=0; y < (long) image->rows; y++)
   {
@@ -3602,7 +3733,8 @@ MagickExport MagickBooleanType SigmoidalContrastImageChannel(Image *image,
       image->filename);
   (void) ResetMagickMemory(sigmoidal_map,0,(MaxMap+1)*sizeof(*sigmoidal_map));
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(PointThreadCost,1,MaxMap)
 #endif
   for (i=0; i <= (long) MaxMap; i++)
   {
@@ -3632,7 +3764,8 @@ MagickExport MagickBooleanType SigmoidalContrastImageChannel(Image *image,
         Sigmoidal-contrast enhance colormap.
       */
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(PointThreadCost,1,image->colors)
 #endif
       for (i=0; i < (long) image->colors; i++)
       {
@@ -3658,7 +3791,8 @@ MagickExport MagickBooleanType SigmoidalContrastImageChannel(Image *image,
   exception=(&image->exception);
   image_view=AcquireCacheView(image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
   for (y=0; y < (long) image->rows; y++)
   {
@@ -654,7 +654,8 @@ MagickExport Image *ForwardFourierTransformImage(const Image *image,
             status=MagickTrue;
             is_gray=IsGrayImage(image,exception);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(status)
+  #pragma omp parallel for shared(status) \
+    magick_schedule(IntensiveThreadCost,image->columns*image->rows,5)
 #endif
             for (i=0L; i < 5L; i++)
             {
@@ -1208,7 +1209,9 @@ MagickExport Image *InverseFourierTransformImage(const Image *magnitude_image,
         if (is_gray != MagickFalse)
           is_gray=IsGrayImage(phase_image,exception);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-        #pragma omp parallel for schedule(dynamic,4) shared(status)
+        #pragma omp parallel for shared(status) \
+          magick_schedule(IntensiveThreadCost, \
+            magnitude_image->columns*magnitude_image->rows,5)
 #endif
         for (i=0L; i < 5L; i++)
         {
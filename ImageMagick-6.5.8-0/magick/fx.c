@@ -45,6 +45,7 @@
 #include "magick/artifact.h"
 #include "magick/attribute.h"
 #include "magick/cache.h"
+#include "magick/cache-private.h"
 #include "magick/cache-view.h"
 #include "magick/color.h"
 #include "magick/color-private.h"
@@ -334,7 +335,8 @@ MagickExport Image *AddNoiseImageChannel(const Image *image,
   image_view=AcquireCacheView(image);
   noise_view=AcquireCacheView(noise_image);
 #if defined(MAGICKCOREMAGICKCORE_OPENMP_SUPPORT_SUPPORT_DEBUG)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(NeighborhoodThreadCost,image->columns,image->rows)
 #endif
   for (y=0; y < (long) image->rows; y++)
   {
@@ -490,7 +492,8 @@ MagickExport Image *BlueShiftImage(const Image *image,const double factor,
   image_view=AcquireCacheView(image);
   shift_view=AcquireCacheView(shift_image);
 #if defined(MAGICKCOREMAGICKCORE_OPENMP_SUPPORT_SUPPORT_DEBUG)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
   for (y=0; y < (long) image->rows; y++)
   {
@@ -737,7 +740,8 @@ MagickExport Image *ColorizeImage(const Image *image,const char *opacity,
   image_view=AcquireCacheView(image);
   colorize_view=AcquireCacheView(colorize_image);
 #if defined(MAGICKCOREMAGICKCORE_OPENMP_SUPPORT_SUPPORT_DEBUG)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
   for (y=0; y < (long) image->rows; y++)
   {
@@ -958,7 +962,8 @@ MagickExport Image *ConvolveImageChannel(const Image *image,
   image_view=AcquireCacheView(image);
   convolve_view=AcquireCacheView(convolve_image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(IntensiveThreadCost,image->columns,image->rows)
 #endif
   for (y=0; y < (long) image->rows; y++)
   {
@@ -1451,6 +1456,9 @@ MagickExport MagickBooleanType EvaluateImageChannel(Image *image,
   MagickBooleanType
     status;
 
+  Quantum
+    *planes[4];
+
   RandomInfo
     **random_info;
 
@@ -1471,9 +1479,64 @@ MagickExport MagickBooleanType EvaluateImageChannel(Image *image,
   status=MagickTrue;
   progress=0;
   random_info=AcquireRandomInfoThreadSet();
+  if ((((channel & IndexChannel) == 0) ||
+       (image->colorspace != CMYKColorspace)) &&
+      (GetAuthenticPixelPlanes(image,channel,planes,exception) != MagickFalse))
+    {
+      /*
+        Evaluate each channel plane.
+      */
+#if defined(MAGICKCORE_OPENMP_SUPPORT)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
+#endif
+      for (y=0; y < (long) image->rows; y++)
+      {
+        register long
+          id,
+          j,
+          x;
+
+        register Quantum
+          *__restrict q;
+
+        if (status == MagickFalse)
+          continue;
+        id=GetOpenMPThreadId();
+        for (j=0; j < 4; j++)
+        {
+          if (planes[j] == (Quantum *) NULL)
+            continue;
+          q=planes[j]+y*image->columns;
+          if ((j == 3) && (image->matte != MagickFalse))
+            for (x=0; x < (long) image->columns; x++)
+              q[x]=(Quantum) QuantumRange-ApplyEvaluateOperator(
+                random_info[id],(Quantum) (QuantumRange-q[x]),op,value);
+          else
+            for (x=0; x < (long) image->columns; x++)
+              q[x]=ApplyEvaluateOperator(random_info[id],q[x],op,value);
+        }
+        if (image->progress_monitor != (MagickProgressMonitor) NULL)
+          {
+            MagickBooleanType
+              proceed;
+
+#if defined(MAGICKCORE_OPENMP_SUPPORT)
+  #pragma omp critical (MagickCore_EvaluateImageChannel)
+#endif
+            proceed=SetImageProgress(image,EvaluateImageTag,progress++,
+              image->rows);
+            if (proceed == MagickFalse)
+              status=MagickFalse;
+          }
+      }
+      random_info=DestroyRandomInfoThreadSet(random_info);
+      return(status);
+    }
   image_view=AcquireCacheView(image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
   for (y=0; y < (long) image->rows; y++)
   {
@@ -1705,7 +1768,8 @@ MagickExport MagickBooleanType FunctionImageChannel(Image *image,
   progress=0;
   image_view=AcquireCacheView(image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
   for (y=0; y < (long) image->rows; y++)
   {
@@ -3428,16 +3492,18 @@ static FxInfo **DestroyFxThreadSet(FxInfo **fx_info)
   register long
     i;
 
+  /*
+    The thread set itself belongs to the arena; only its entries are freed.
+  */
   assert(fx_info != (FxInfo **) NULL);
   for (i=0; i < (long) GetOpenMPMaximumThreads(); i++)
     if (fx_info[i] != (FxInfo *) NULL)
       fx_info[i]=DestroyFxInfo(fx_info[i]);
-  fx_info=(FxInfo **) RelinquishAlignedMemory(fx_info);
-  return(fx_info);
+  return((FxInfo **) NULL);
 }
 
-static FxInfo **AcquireFxThreadSet(const Image *image,const char *expression,
-  ExceptionInfo *exception)
+static FxInfo **AcquireFxThreadSet(MemoryArena *arena,const Image *image,
+  const char *expression,ExceptionInfo *exception)
 {
   char
     *fx_expression;
@@ -3455,7 +3521,8 @@ static FxInfo **AcquireFxThreadSet(const Image *image,const char *expression,
     number_threads;
 
   number_threads=GetOpenMPMaximumThreads();
-  fx_info=(FxInfo **) AcquireAlignedMemory(number_threads,sizeof(*fx_info));
+  fx_info=(FxInfo **) AcquireArenaMemory(arena,number_threads,
+    sizeof(*fx_info));
   if (fx_info == (FxInfo **) NULL)
     return((FxInfo **) NULL);
   (void) ResetMagickMemory(fx_info,0,number_threads*sizeof(*fx_info));
@@ -3467,7 +3534,10 @@ static FxInfo **AcquireFxThreadSet(const Image *image,const char *expression,
   {
     fx_info[i]=AcquireFxInfo(image,fx_expression);
     if (fx_info[i] == (FxInfo *) NULL)
-      return(DestroyFxThreadSet(fx_info));
+      {
+        fx_expression=DestroyString(fx_expression);
+        return(DestroyFxThreadSet(fx_info));
+      }
     (void) FxPreprocessExpression(fx_info[i],&alpha,fx_info[i]->exception);
   }
   fx_expression=DestroyString(fx_expression);
@@ -3505,6 +3575,9 @@ MagickExport Image *FxImageChannel(const Image *image,const ChannelType channel,
   MagickRealType
     alpha;
 
+  MemoryArena
+    *arena;
+
   CacheView
     *fx_view;
 
@@ -3521,9 +3594,11 @@ MagickExport Image *FxImageChannel(const Image *image,const ChannelType channel,
       fx_image=DestroyImage(fx_image);
       return((Image *) NULL);
     }
-  fx_info=AcquireFxThreadSet(image,expression,exception);
+  arena=AcquireMemoryArena(0);
+  fx_info=AcquireFxThreadSet(arena,image,expression,exception);
   if (fx_info == (FxInfo **) NULL)
     {
+      arena=RelinquishMemoryArena(arena);
       fx_image=DestroyImage(fx_image);
       ThrowImageException(ResourceLimitError,"MemoryAllocationFailed");
     }
@@ -3532,6 +3607,7 @@ MagickExport Image *FxImageChannel(const Image *image,const ChannelType channel,
     {
       fx_image=DestroyImage(fx_image);
       fx_info=DestroyFxThreadSet(fx_info);
+      arena=RelinquishMemoryArena(arena);
       return((Image *) NULL);
     }
   /*
@@ -3541,7 +3617,8 @@ MagickExport Image *FxImageChannel(const Image *image,const ChannelType channel,
   progress=0;
   fx_view=AcquireCacheView(fx_image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(IntensiveThreadCost,fx_image->columns,fx_image->rows)
 #endif
   for (y=0; y < (long) fx_image->rows; y++)
   {
@@ -3627,6 +3704,7 @@ MagickExport Image *FxImageChannel(const Image *image,const ChannelType channel,
   fx_image->matte=fx_info[0]->matte;
   fx_view=DestroyCacheView(fx_view);
   fx_info=DestroyFxThreadSet(fx_info);
+  arena=RelinquishMemoryArena(arena);
   if (status == MagickFalse)
     fx_image=DestroyImage(fx_image);
   return(fx_image);
@@ -3744,7 +3822,8 @@ MagickExport Image *ImplodeImage(const Image *image,const double amount,
   image_view=AcquireCacheView(image);
   implode_view=AcquireCacheView(implode_image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(NeighborhoodThreadCost,image->columns,image->rows)
 #endif
   for (y=0; y < (long) image->rows; y++)
   {
@@ -3966,7 +4045,8 @@ MagickExport Image *MorphImages(const Image *image,
       image_view=AcquireCacheView(morph_image);
       morph_view=AcquireCacheView(morph_images);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(status)
+  #pragma omp parallel for shared(status) \
+    magick_schedule(PointThreadCost,morph_images->columns,morph_images->rows)
 #endif
       for (y=0; y < (long) morph_images->rows; y++)
       {
@@ -4587,7 +4667,8 @@ MagickExport Image *RecolorImage(const Image *image,const unsigned long order,
   image_view=AcquireCacheView(image);
   recolor_view=AcquireCacheView(recolor_image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
   for (y=0; y < (long) image->rows; y++)
   {
@@ -4817,7 +4898,8 @@ MagickExport Image *SepiaToneImage(const Image *image,const double threshold,
   image_view=AcquireCacheView(image);
   sepia_view=AcquireCacheView(sepia_image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
   for (y=0; y < (long) image->rows; y++)
   {
@@ -4975,7 +5057,8 @@ MagickExport Image *ShadowImage(const Image *image,const double opacity,
   progress=0;
   image_view=AcquireCacheView(border_image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(PointThreadCost,border_image->columns,border_image->rows)
 #endif
   for (y=0; y < (long) border_image->rows; y++)
   {
@@ -5264,7 +5347,8 @@ MagickExport MagickBooleanType SolarizeImage(Image *image,
   exception=(&image->exception);
   image_view=AcquireCacheView(image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
   for (y=0; y < (long) image->rows; y++)
   {
@@ -5705,7 +5789,8 @@ MagickExport Image *SwirlImage(const Image *image,double degrees,
   image_view=AcquireCacheView(image);
   swirl_view=AcquireCacheView(swirl_image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(NeighborhoodThreadCost,image->columns,image->rows)
 #endif
   for (y=0; y < (long) image->rows; y++)
   {
@@ -5902,7 +5987,8 @@ MagickExport Image *TintImage(const Image *image,const char *opacity,
   image_view=AcquireCacheView(image);
   tint_view=AcquireCacheView(tint_image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
   for (y=0; y < (long) image->rows; y++)
   {
@@ -6168,7 +6254,8 @@ MagickExport Image *WaveImage(const Image *image,const double amplitude,
   resample_filter=AcquireResampleFilterThreadSet(image,MagickTrue,exception);
   wave_view=AcquireCacheView(wave_image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(NeighborhoodThreadCost,wave_image->columns,wave_image->rows)
 #endif
   for (y=0; y < (long) wave_image->rows; y++)
   {
@@ -34,8 +34,10 @@
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 %
 %  This module implements the standard handy hash and linked-list methods for
-%  storing and retrieving large numbers of data elements.  It is loosely based
-%  on the Java implementation of these algorithms.
+%  storing and retrieving large numbers of data elements.  The linked-list is
+%  loosely based on the Java implementation.  The hash-map keeps its entries
+%  in a flat table searched by linear probing so that lookups need not take
+%  the hash-map lock.
 %
 */
 
@@ -48,9 +50,17 @@
 #include "magick/hashmap.h"
 #include "magick/memory_.h"
 #include "magick/semaphore.h"
-#include "magick/signature-private.h"
 #include "magick/string_.h"
 
+/*
+  Define declarations.
+*/
+#define MinimumHashmapCapacity  16UL
+#if defined(__GNUC__) && ((__GNUC__ > 4) || \
+    ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 1)))
+#define HashmapMemoryBarrier()  __sync_synchronize()
+#endif
+
 /*
   Typedef declarations.
 */
@@ -106,16 +116,24 @@ struct _HashmapInfo
     *(*relinquish_key)(void *),
     *(*relinquish_value)(void *);
 
+  size_t
+    seed;
+
+  volatile unsigned long
+    capacity;
+
   unsigned long
-    capacity,
     entries,
     next;
 
-  MagickBooleanType
-    head_of_list;
+  EntryInfo
+    *volatile map;
 
   LinkedListInfo
-    **map;
+    *retired;
+
+  volatile unsigned long
+    sequence;
 
   MagickBooleanType
     debug;
@@ -339,9 +357,6 @@ MagickExport MagickBooleanType CompareHashmapStringInfo(const void *target,
 */
 MagickExport HashmapInfo *DestroyHashmap(HashmapInfo *hashmap_info)
 {
-  LinkedListInfo
-    *list_info;
-
   register EntryInfo
     *entry;
 
@@ -355,25 +370,17 @@ MagickExport HashmapInfo *DestroyHashmap(HashmapInfo *hashmap_info)
   (void) LockSemaphoreInfo(hashmap_info->semaphore);
   for (i=0; i < (long) hashmap_info->capacity; i++)
   {
-    list_info=hashmap_info->map[i];
-    if (list_info != (LinkedListInfo *) NULL)
-      {
-        list_info->next=list_info->head;
-        entry=(EntryInfo *) GetNextValueInLinkedList(list_info);
-        while (entry != (EntryInfo *) NULL)
-        {
-          if (hashmap_info->relinquish_key != (void *(*)(void *)) NULL)
-            entry->key=hashmap_info->relinquish_key(entry->key);
-          if (hashmap_info->relinquish_value != (void *(*)(void *)) NULL)
-            entry->value=hashmap_info->relinquish_value(entry->value);
-          entry=(EntryInfo *) GetNextValueInLinkedList(list_info);
-        }
-      }
-    if (list_info != (LinkedListInfo *) NULL)
-      list_info=DestroyLinkedList(list_info,RelinquishMagickMemory);
+    entry=hashmap_info->map+i;
+    if (entry->key == (void *) NULL)
+      continue;
+    if (hashmap_info->relinquish_key != (void *(*)(void *)) NULL)
+      entry->key=hashmap_info->relinquish_key(entry->key);
+    if (hashmap_info->relinquish_value != (void *(*)(void *)) NULL)
+      entry->value=hashmap_info->relinquish_value(entry->value);
   }
-  hashmap_info->map=(LinkedListInfo **) RelinquishMagickMemory(
-    hashmap_info->map);
+  hashmap_info->map=(EntryInfo *) RelinquishMagickMemory(hashmap_info->map);
+  hashmap_info->retired=DestroyLinkedList(hashmap_info->retired,
+    RelinquishMagickMemory);
   hashmap_info->signature=(~MagickSignature);
   (void) UnlockSemaphoreInfo(hashmap_info->semaphore);
   DestroySemaphoreInfo(&hashmap_info->semaphore);
@@ -499,9 +506,6 @@ MagickExport void *GetLastValueInLinkedList(LinkedListInfo *list_info)
 */
 MagickExport void *GetNextKeyInHashmap(HashmapInfo *hashmap_info)
 {
-  LinkedListInfo
-    *list_info;
-
   register EntryInfo
     *entry;
 
@@ -515,24 +519,14 @@ MagickExport void *GetNextKeyInHashmap(HashmapInfo *hashmap_info)
   (void) LockSemaphoreInfo(hashmap_info->semaphore);
   while (hashmap_info->next < hashmap_info->capacity)
   {
-    list_info=hashmap_info->map[hashmap_info->next];
-    if (list_info != (LinkedListInfo *) NULL)
+    entry=hashmap_info->map+hashmap_info->next;
+    hashmap_info->next++;
+    if (entry->key != (void *) NULL)
       {
-        if (hashmap_info->head_of_list == MagickFalse)
-          {
-            list_info->next=list_info->head;
-            hashmap_info->head_of_list=MagickTrue;
-          }
-        entry=(EntryInfo *) GetNextValueInLinkedList(list_info);
-        if (entry != (EntryInfo *) NULL)
-          {
-            key=entry->key;
-            (void) UnlockSemaphoreInfo(hashmap_info->semaphore);
-            return(key);
-          }
-        hashmap_info->head_of_list=MagickFalse;
+        key=entry->key;
+        (void) UnlockSemaphoreInfo(hashmap_info->semaphore);
+        return(key);
       }
-    hashmap_info->next++;
   }
   (void) UnlockSemaphoreInfo(hashmap_info->semaphore);
   return((void *) NULL);
@@ -562,9 +556,6 @@ MagickExport void *GetNextKeyInHashmap(HashmapInfo *hashmap_info)
 */
 MagickExport void *GetNextValueInHashmap(HashmapInfo *hashmap_info)
 {
-  LinkedListInfo
-    *list_info;
-
   register EntryInfo
     *entry;
 
@@ -578,24 +569,14 @@ MagickExport void *GetNextValueInHashmap(HashmapInfo *hashmap_info)
   (void) LockSemaphoreInfo(hashmap_info->semaphore);
   while (hashmap_info->next < hashmap_info->capacity)
   {
-    list_info=hashmap_info->map[hashmap_info->next];
-    if (list_info != (LinkedListInfo *) NULL)
+    entry=hashmap_info->map+hashmap_info->next;
+    hashmap_info->next++;
+    if (entry->key != (void *) NULL)
       {
-        if (hashmap_info->head_of_list == MagickFalse)
-          {
-            list_info->next=list_info->head;
-            hashmap_info->head_of_list=MagickTrue;
-          }
-        entry=(EntryInfo *) GetNextValueInLinkedList(list_info);
-        if (entry != (EntryInfo *) NULL)
-          {
-            value=entry->value;
-            (void) UnlockSemaphoreInfo(hashmap_info->semaphore);
-            return(value);
-          }
-        hashmap_info->head_of_list=MagickFalse;
+        value=entry->value;
+        (void) UnlockSemaphoreInfo(hashmap_info->semaphore);
+        return(value);
       }
-    hashmap_info->next++;
   }
   (void) UnlockSemaphoreInfo(hashmap_info->semaphore);
   return((void *) NULL);
@@ -723,6 +704,13 @@ MagickExport unsigned long GetNumberOfElementsInLinkedList(
 %
 %  GetValueFromHashmap() gets an entry from the hash-map by its key.
 %
+%  The lookup does not take the hash-map lock: it searches the table
+%  optimistically and retries under the lock only if a writer modified the
+%  hash-map meanwhile.  The hash and compare methods must therefore be
+%  reentrant.  Replacing or removing a key while another thread looks up that
+%  same key must be serialized by the caller, since the old key and value are
+%  relinquished.
+%
 %  The format of the GetValueFromHashmap method is:
 %
 %      void *GetValueFromHashmap(HashmapInfo *hashmap_info,const void *key)
@@ -734,15 +722,63 @@ MagickExport unsigned long GetNumberOfElementsInLinkedList(
 %    o key: the key.
 %
 */
-MagickExport void *GetValueFromHashmap(HashmapInfo *hashmap_info,
-  const void *key)
+static inline unsigned long GetHashmapSlot(const HashmapInfo *hashmap_info,
+  const size_t hash,const unsigned long capacity)
 {
-  LinkedListInfo
-    *list_info;
+  size_t
+    slot;
 
-  register EntryInfo
+  /*
+    Mix the seeded hash so all its bits reach the low-order slot bits.
+  */
+  slot=hash ^ hashmap_info->seed;
+  if (sizeof(slot) > 4)
+    slot^=(slot >> 16) >> 16;
+  slot^=(slot >> 16);
+  slot*=(size_t) 0x45d9f3bUL;
+  slot^=(slot >> 16);
+  return((unsigned long) (slot & (capacity-1)));
+}
+
+static long SearchHashmap(const HashmapInfo *hashmap_info,const EntryInfo *map,
+  const unsigned long capacity,const void *key,const size_t hash)
+{
+  register const EntryInfo
     *entry;
 
+  register unsigned long
+    i,
+    slot;
+
+  slot=GetHashmapSlot(hashmap_info,hash,capacity);
+  for (i=0; i < capacity; i++)
+  {
+    entry=map+slot;
+    if (entry->key == (void *) NULL)
+      break;
+    if (entry->hash == hash)
+      {
+        if (hashmap_info->compare ==
+            (MagickBooleanType (*)(const void *,const void *)) NULL)
+          {
+            if (entry->key == key)
+              return((long) slot);
+          }
+        else
+          if (hashmap_info->compare(key,entry->key) != MagickFalse)
+            return((long) slot);
+      }
+    slot=(slot+1) & (capacity-1);
+  }
+  return(-1);
+}
+
+MagickExport void *GetValueFromHashmap(HashmapInfo *hashmap_info,
+  const void *key)
+{
+  long
+    slot;
+
   size_t
     hash;
 
@@ -755,36 +791,44 @@ MagickExport void *GetValueFromHashmap(HashmapInfo *hashmap_info,
     (void) LogMagickEvent(TraceEvent,GetMagickModule(),"...");
   if (key == (const void *) NULL)
     return((void *) NULL);
-  (void) LockSemaphoreInfo(hashmap_info->semaphore);
   hash=hashmap_info->hash(key);
-  list_info=hashmap_info->map[hash % hashmap_info->capacity];
-  if (list_info != (LinkedListInfo *) NULL)
-    {
-      list_info->next=list_info->head;
-      entry=(EntryInfo *) GetNextValueInLinkedList(list_info);
-      while (entry != (EntryInfo *) NULL)
+#if defined(HashmapMemoryBarrier)
+  {
+    EntryInfo
+      *map;
+
+    unsigned long
+      capacity,
+      sequence;
+
+    /*
+      Optimistic lookup: valid only if no writer intervened.
+    */
+    sequence=hashmap_info->sequence;
+    HashmapMemoryBarrier();
+    if ((sequence & 0x01) == 0)
       {
-        if (entry->hash == hash)
-          {
-            MagickBooleanType
-              compare;
-
-            compare=MagickTrue;
-            if (hashmap_info->compare !=
-                (MagickBooleanType (*)(const void *,const void *)) NULL)
-              compare=hashmap_info->compare(key,entry->key);
-            if (compare == MagickTrue)
-              {
-                value=entry->value;
-                (void) UnlockSemaphoreInfo(hashmap_info->semaphore);
-                return(value);
-              }
-          }
-        entry=(EntryInfo *) GetNextValueInLinkedList(list_info);
+        capacity=hashmap_info->capacity;
+        HashmapMemoryBarrier();
+        map=hashmap_info->map;
+        value=(void *) NULL;
+        slot=SearchHashmap(hashmap_info,map,capacity,key,hash);
+        if (slot >= 0)
+          value=map[slot].value;
+        HashmapMemoryBarrier();
+        if (hashmap_info->sequence == sequence)
+          return(value);
       }
-    }
+  }
+#endif
+  (void) LockSemaphoreInfo(hashmap_info->semaphore);
+  value=(void *) NULL;
+  slot=SearchHashmap(hashmap_info,hashmap_info->map,hashmap_info->capacity,
+    key,hash);
+  if (slot >= 0)
+    value=hashmap_info->map[slot].value;
   (void) UnlockSemaphoreInfo(hashmap_info->semaphore);
-  return((void *) NULL);
+  return(value);
 }
 
 /*
@@ -900,7 +944,9 @@ MagickExport size_t HashPointerType(const void *pointer)
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 %
 %  Specify the HashStringType() method in NewHashmap() to find an entry
-%  in a hash-map based on the contents of a string.
+%  in a hash-map based on the contents of a string.  The hash is the 64-bit
+%  FNV-1a hash of the string bytes folded to lowercase, consistent with the
+%  case-insensitive CompareHashmapString().
 %
 %  The format of the HashStringType method is:
 %
@@ -913,32 +959,19 @@ MagickExport size_t HashPointerType(const void *pointer)
 */
 MagickExport size_t HashStringType(const void *string)
 {
-  const unsigned char
-    *digest;
-
-  register long
-    i;
-
-  SignatureInfo
-    *signature_info;
-
-  size_t
+  MagickSizeType
     hash;
 
-  StringInfo
-    *signature;
-
-  signature_info=AcquireSignatureInfo();
-  signature=StringToStringInfo((const char *) string);
-  UpdateSignature(signature_info,signature);
-  FinalizeSignature(signature_info);
-  digest=GetStringInfoDatum(GetSignatureDigest(signature_info));
-  hash=0;
-  for (i=0; i < 8; i++)
-    hash^=digest[i];
-  signature=DestroyStringInfo(signature);
-  signature_info=DestroySignatureInfo(signature_info);
-  return(hash);
+  register const unsigned char
+    *p;
+
+  hash=MagickULLConstant(0xcbf29ce484222325);
+  for (p=(const unsigned char *) string; *p != '\0'; p++)
+  {
+    hash^=(MagickSizeType) tolower((int) *p);
+    hash*=MagickULLConstant(0x100000001b3);
+  }
+  return((size_t) (hash ^ (hash >> 32)));
 }
 
 /*
@@ -953,7 +986,8 @@ MagickExport size_t HashStringType(const void *string)
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 %
 %  Specify the HashStringInfoType() method in NewHashmap() to find an entry
-%  in a hash-map based on the contents of a string.
+%  in a hash-map based on the contents of a string.  The hash is the 64-bit
+%  FNV-1a hash of the string datum.
 %
 %  The format of the HashStringInfoType method is:
 %
@@ -966,27 +1000,27 @@ MagickExport size_t HashStringType(const void *string)
 */
 MagickExport size_t HashStringInfoType(const void *string_info)
 {
-  const unsigned char
-    *digest;
+  MagickSizeType
+    hash;
 
-  register long
-    i;
+  register const unsigned char
+    *p;
 
-  SignatureInfo
-    *signature_info;
+  register size_t
+    i;
 
   size_t
-    hash;
+    length;
 
-  signature_info=AcquireSignatureInfo();
-  UpdateSignature(signature_info,(const StringInfo *) string_info);
-  FinalizeSignature(signature_info);
-  digest=GetStringInfoDatum(GetSignatureDigest(signature_info));
-  hash=0;
-  for (i=0; i < 8; i++)
-    hash^=digest[i];
-  signature_info=DestroySignatureInfo(signature_info);
-  return(hash);
+  hash=MagickULLConstant(0xcbf29ce484222325);
+  p=GetStringInfoDatum((const StringInfo *) string_info);
+  length=GetStringInfoLength((const StringInfo *) string_info);
+  for (i=0; i < length; i++)
+  {
+    hash^=(MagickSizeType) p[i];
+    hash*=MagickULLConstant(0x100000001b3);
+  }
+  return((size_t) (hash ^ (hash >> 32)));
 }
 
 /*
@@ -1314,6 +1348,10 @@ MagickExport MagickBooleanType LinkedListToArray(LinkedListInfo *list_info,
 %  to default values.  The capacity is an initial estimate.  The hashmap will
 %  increase capacity dynamically as the demand requires.
 %
+%  Entries are placed by mixing their hash with a seed private to each
+%  hash-map, so a weak or adversarial hash method does not cluster entries
+%  the same way in every process.
+%
 %  The format of the NewHashmap method is:
 %
 %      HashmapInfo *NewHashmap(const unsigned long capacity,
@@ -1350,6 +1388,9 @@ MagickExport HashmapInfo *NewHashmap(const unsigned long capacity,
   HashmapInfo
     *hashmap_info;
 
+  unsigned long
+    extent;
+
   hashmap_info=(HashmapInfo *) AcquireMagickMemory(sizeof(*hashmap_info));
   if (hashmap_info == (HashmapInfo *) NULL)
     ThrowFatalException(ResourceLimitFatalError,"MemoryAllocationFailed");
@@ -1362,16 +1403,20 @@ MagickExport HashmapInfo *NewHashmap(const unsigned long capacity,
     hashmap_info->compare=compare;
   hashmap_info->relinquish_key=relinquish_key;
   hashmap_info->relinquish_value=relinquish_value;
+  hashmap_info->seed=HashPointerType(hashmap_info) ^
+    (size_t) time((time_t *) NULL);
   hashmap_info->entries=0;
-  hashmap_info->capacity=capacity;
-  hashmap_info->map=(LinkedListInfo **) NULL;
-  if (~capacity >= 1UL)
-    hashmap_info->map=(LinkedListInfo **) AcquireQuantumMemory((size_t)
-      capacity+1UL,sizeof(*hashmap_info->map));
-  if (hashmap_info->map == (LinkedListInfo **) NULL)
+  for (extent=MinimumHashmapCapacity; extent < capacity; extent<<=1)
+    if ((extent << 1) == 0)
+      ThrowFatalException(ResourceLimitFatalError,"MemoryAllocationFailed");
+  hashmap_info->capacity=extent;
+  hashmap_info->map=(EntryInfo *) AcquireQuantumMemory((size_t) extent,
+    sizeof(*hashmap_info->map));
+  if (hashmap_info->map == (EntryInfo *) NULL)
     ThrowFatalException(ResourceLimitFatalError,"MemoryAllocationFailed");
-  (void) ResetMagickMemory(hashmap_info->map,0,(size_t) capacity*
+  (void) ResetMagickMemory(hashmap_info->map,0,(size_t) extent*
     sizeof(*hashmap_info->map));
+  hashmap_info->retired=NewLinkedList(0);
   hashmap_info->debug=IsEventLogging();
   hashmap_info->semaphore=AllocateSemaphoreInfo();
   hashmap_info->signature=MagickSignature;
@@ -1435,6 +1480,10 @@ MagickExport LinkedListInfo *NewLinkedList(const unsigned long capacity)
 %  PutEntryInHashmap() puts an entry in the hash-map.  If the key already
 %  exists in the map it is first removed.
 %
+%  The table doubles once it is half full.  The table it replaces is retained
+%  until the hash-map is destroyed, so a concurrent lookup never reads freed
+%  memory.
+%
 %  The format of the PutEntryInHashmap method is:
 %
 %      MagickBooleanType PutEntryInHashmap(HashmapInfo *hashmap_info,
@@ -1450,84 +1499,77 @@ MagickExport LinkedListInfo *NewLinkedList(const unsigned long capacity)
 %
 */
 
-static MagickBooleanType IncreaseHashmapCapacity(HashmapInfo *hashmap_info)
+static void BeginHashmapUpdate(HashmapInfo *hashmap_info)
 {
-#define MaxCapacities  20
-
-  const unsigned long
-    capacities[MaxCapacities] =
-    {
-      17, 31, 61, 131, 257, 509, 1021, 2053, 4099, 8191, 16381, 32771,
-      65537, 131071, 262147, 524287, 1048573, 2097143, 4194301, 8388617
-    };
+  /*
+    An odd sequence number tells lookups a writer is active.
+  */
+  hashmap_info->sequence++;
+#if defined(HashmapMemoryBarrier)
+  HashmapMemoryBarrier();
+#endif
+}
 
-  ElementInfo
-    *element;
+static void EndHashmapUpdate(HashmapInfo *hashmap_info)
+{
+#if defined(HashmapMemoryBarrier)
+  HashmapMemoryBarrier();
+#endif
+  hashmap_info->sequence++;
+}
 
+static MagickBooleanType IncreaseHashmapCapacity(HashmapInfo *hashmap_info)
+{
   EntryInfo
-    *entry;
-
-  LinkedListInfo
-    *list_info,
-    *map_info,
-    **map;
-
-  register ElementInfo
-    *next;
+    *entry,
+    *map;
 
   register long
     i;
 
+  register unsigned long
+    slot;
+
   unsigned long
     capacity;
 
   /*
-    Increase to the next prime capacity.
+    Double the capacity.
   */
-  for (i=0; i < MaxCapacities; i++)
-    if (hashmap_info->capacity < capacities[i])
-      break;
-  if (i >= (MaxCapacities-1))
+  capacity=hashmap_info->capacity << 1;
+  if (capacity == 0)
     return(MagickFalse);
-  capacity=capacities[i+1];
-  map=(LinkedListInfo **) AcquireQuantumMemory((size_t) capacity+1UL,
-    sizeof(*map));
-  if (map == (LinkedListInfo **) NULL)
+  map=(EntryInfo *) AcquireQuantumMemory((size_t) capacity,sizeof(*map));
+  if (map == (EntryInfo *) NULL)
     return(MagickFalse);
   (void) ResetMagickMemory(map,0,(size_t) capacity*sizeof(*map));
+  if (AppendValueToLinkedList(hashmap_info->retired,hashmap_info->map) ==
+      MagickFalse)
+    {
+      map=(EntryInfo *) RelinquishMagickMemory(map);
+      return(MagickFalse);
+    }
   /*
     Copy entries to new hashmap with increased capacity.
   */
   for (i=0; i < (long) hashmap_info->capacity; i++)
   {
-    list_info=hashmap_info->map[i];
-    if (list_info == (LinkedListInfo *) NULL)
+    entry=hashmap_info->map+i;
+    if (entry->key == (void *) NULL)
       continue;
-    (void) LockSemaphoreInfo(list_info->semaphore);
-    for (next=list_info->head; next != (ElementInfo *) NULL; )
-    {
-      element=next;
-      next=next->next;
-      entry=(EntryInfo *) element->value;
-      map_info=map[entry->hash % capacity];
-      if (map_info == (LinkedListInfo *) NULL)
-        {
-          map_info=NewLinkedList(0);
-          map[entry->hash % capacity]=map_info;
-        }
-      map_info->next=element;
-      element->next=map_info->head;
-      map_info->head=element;
-      map_info->elements++;
-    }
-    list_info->signature=(~MagickSignature);
-    (void) UnlockSemaphoreInfo(list_info->semaphore);
-    DestroySemaphoreInfo(&list_info->semaphore);
-    list_info=(LinkedListInfo *) RelinquishMagickMemory(list_info);
+    slot=GetHashmapSlot(hashmap_info,entry->hash,capacity);
+    while (map[slot].key != (void *) NULL)
+      slot=(slot+1) & (capacity-1);
+    map[slot]=(*entry);
   }
-  hashmap_info->map=(LinkedListInfo **) RelinquishMagickMemory(
-    hashmap_info->map);
+  /*
+    Publish the map before its capacity: a lookup that reads the new capacity
+    is then sure to read the new map.
+  */
   hashmap_info->map=map;
+#if defined(HashmapMemoryBarrier)
+  HashmapMemoryBarrier();
+#endif
   hashmap_info->capacity=capacity;
   return(MagickTrue);
 }
@@ -1536,14 +1578,17 @@ MagickExport MagickBooleanType PutEntryInHashmap(HashmapInfo *hashmap_info,
   const void *key,const void *value)
 {
   EntryInfo
-    *entry,
-    *next;
+    *entry;
 
-  LinkedListInfo
-    *list_info;
+  long
+    slot;
 
-  register unsigned long
-    i;
+  size_t
+    hash;
+
+  void
+    *relinquish_key,
+    *relinquish_value;
 
   assert(hashmap_info != (HashmapInfo *) NULL);
   assert(hashmap_info->signature == MagickSignature);
@@ -1551,61 +1596,45 @@ MagickExport MagickBooleanType PutEntryInHashmap(HashmapInfo *hashmap_info,
     (void) LogMagickEvent(TraceEvent,GetMagickModule(),"...");
   if ((key == (void *) NULL) || (value == (void *) NULL))
     return(MagickFalse);
-  next=(EntryInfo *) AcquireMagickMemory(sizeof(*next));
-  if (next == (EntryInfo *) NULL)
-    return(MagickFalse);
+  hash=hashmap_info->hash(key);
   (void) LockSemaphoreInfo(hashmap_info->semaphore);
-  next->hash=hashmap_info->hash(key);
-  next->key=(void *) key;
-  next->value=(void *) value;
-  list_info=hashmap_info->map[next->hash % hashmap_info->capacity];
-  if (list_info == (LinkedListInfo *) NULL)
-    {
-      list_info=NewLinkedList(0);
-      hashmap_info->map[next->hash % hashmap_info->capacity]=list_info;
-    }
-  else
-    {
-      list_info->next=list_info->head;
-      entry=(EntryInfo *) GetNextValueInLinkedList(list_info);
-      for (i=0; entry != (EntryInfo *) NULL; i++)
-      {
-        if (entry->hash == next->hash)
-          {
-            MagickBooleanType
-              compare;
-
-            compare=MagickTrue;
-            if (hashmap_info->compare !=
-                (MagickBooleanType (*)(const void *,const void *)) NULL)
-              compare=hashmap_info->compare(key,entry->key);
-            if (compare == MagickTrue)
-              {
-                (void) RemoveElementFromLinkedList(list_info,i);
-                if (hashmap_info->relinquish_key != (void *(*)(void *)) NULL)
-                  entry->key=hashmap_info->relinquish_key(entry->key);
-                if (hashmap_info->relinquish_value != (void *(*)(void *)) NULL)
-                  entry->value=hashmap_info->relinquish_value(entry->value);
-                entry=(EntryInfo *) RelinquishMagickMemory(entry);
-                break;
-              }
-          }
-        entry=(EntryInfo *) GetNextValueInLinkedList(list_info);
-      }
-    }
-  if (InsertValueInLinkedList(list_info,0,next) == MagickFalse)
+  BeginHashmapUpdate(hashmap_info);
+  slot=SearchHashmap(hashmap_info,hashmap_info->map,hashmap_info->capacity,
+    key,hash);
+  if (slot >= 0)
     {
-      next=(EntryInfo *) RelinquishMagickMemory(next);
+      /*
+        Replace the existing entry.
+      */
+      entry=hashmap_info->map+slot;
+      relinquish_key=entry->key;
+      relinquish_value=entry->value;
+      entry->key=(void *) key;
+      entry->value=(void *) value;
+      if (hashmap_info->relinquish_key != (void *(*)(void *)) NULL)
+        (void) hashmap_info->relinquish_key(relinquish_key);
+      if (hashmap_info->relinquish_value != (void *(*)(void *)) NULL)
+        (void) hashmap_info->relinquish_value(relinquish_value);
+      EndHashmapUpdate(hashmap_info);
       (void) UnlockSemaphoreInfo(hashmap_info->semaphore);
-      return(MagickFalse);
+      return(MagickTrue);
     }
-  if (list_info->elements >= (hashmap_info->capacity-1))
+  if ((2*(hashmap_info->entries+1)) > hashmap_info->capacity)
     if (IncreaseHashmapCapacity(hashmap_info) == MagickFalse)
       {
+        EndHashmapUpdate(hashmap_info);
         (void) UnlockSemaphoreInfo(hashmap_info->semaphore);
         return(MagickFalse);
       }
+  slot=(long) GetHashmapSlot(hashmap_info,hash,hashmap_info->capacity);
+  while (hashmap_info->map[slot].key != (void *) NULL)
+    slot=(long) ((slot+1) & (hashmap_info->capacity-1));
+  entry=hashmap_info->map+slot;
+  entry->hash=hash;
+  entry->value=(void *) value;
+  entry->key=(void *) key;
   hashmap_info->entries++;
+  EndHashmapUpdate(hashmap_info);
   (void) UnlockSemaphoreInfo(hashmap_info->semaphore);
   return(MagickTrue);
 }
@@ -1788,17 +1817,21 @@ MagickExport void *RemoveEntryFromHashmap(HashmapInfo *hashmap_info,
   const void *key)
 {
   EntryInfo
-    *entry;
+    *map;
 
-  LinkedListInfo
-    *list_info;
+  long
+    slot;
 
   register unsigned long
-    i;
+    i,
+    j;
 
   size_t
     hash;
 
+  unsigned long
+    mask;
+
   void
     *value;
 
@@ -1808,46 +1841,39 @@ MagickExport void *RemoveEntryFromHashmap(HashmapInfo *hashmap_info,
     (void) LogMagickEvent(TraceEvent,GetMagickModule(),"...");
   if (key == (const void *) NULL)
     return((void *) NULL);
-  (void) LockSemaphoreInfo(hashmap_info->semaphore);
   hash=hashmap_info->hash(key);
-  list_info=hashmap_info->map[hash % hashmap_info->capacity];
-  if (list_info != (LinkedListInfo *) NULL)
+  (void) LockSemaphoreInfo(hashmap_info->semaphore);
+  map=hashmap_info->map;
+  slot=SearchHashmap(hashmap_info,map,hashmap_info->capacity,key,hash);
+  if (slot < 0)
     {
-      list_info->next=list_info->head;
-      entry=(EntryInfo *) GetNextValueInLinkedList(list_info);
-      for (i=0; entry != (EntryInfo *) NULL; i++)
+      (void) UnlockSemaphoreInfo(hashmap_info->semaphore);
+      return((void *) NULL);
+    }
+  BeginHashmapUpdate(hashmap_info);
+  if (hashmap_info->relinquish_key != (void *(*)(void *)) NULL)
+    (void) hashmap_info->relinquish_key(map[slot].key);
+  value=map[slot].value;
+  /*
+    Shift later entries of the probe sequence back into the vacated slot so
+    lookups need no tombstones.
+  */
+  mask=hashmap_info->capacity-1;
+  j=(unsigned long) slot;
+  for (i=(j+1) & mask; map[i].key != (void *) NULL; i=(i+1) & mask)
+    if (((i-GetHashmapSlot(hashmap_info,map[i].hash,mask+1)) & mask) >=
+        ((i-j) & mask))
       {
-        if (entry->hash == hash)
-          {
-            MagickBooleanType
-              compare;
-
-            compare=MagickTrue;
-            if (hashmap_info->compare !=
-                (MagickBooleanType (*)(const void *,const void *)) NULL)
-              compare=hashmap_info->compare(key,entry->key);
-            if (compare == MagickTrue)
-              {
-                entry=(EntryInfo *) RemoveElementFromLinkedList(list_info,i);
-                if (entry == (EntryInfo *) NULL)
-                  {
-                    (void) UnlockSemaphoreInfo(hashmap_info->semaphore);
-                    return((void *) NULL);
-                  }
-                if (hashmap_info->relinquish_key != (void *(*)(void *)) NULL)
-                  entry->key=hashmap_info->relinquish_key(entry->key);
-                value=entry->value;
-                entry=(EntryInfo *) RelinquishMagickMemory(entry);
-                hashmap_info->entries--;
-                (void) UnlockSemaphoreInfo(hashmap_info->semaphore);
-                return(value);
-              }
-          }
-        entry=(EntryInfo *) GetNextValueInLinkedList(list_info);
+        map[j]=map[i];
+        j=i;
       }
-    }
+  map[j].key=(void *) NULL;
+  map[j].value=(void *) NULL;
+  map[j].hash=0;
+  hashmap_info->entries--;
+  EndHashmapUpdate(hashmap_info);
   (void) UnlockSemaphoreInfo(hashmap_info->semaphore);
-  return((void *) NULL);
+  return(value);
 }
 
 /*
@@ -1942,7 +1968,6 @@ MagickExport void ResetHashmapIterator(HashmapInfo *hashmap_info)
     (void) LogMagickEvent(TraceEvent,GetMagickModule(),"...");
   (void) LockSemaphoreInfo(hashmap_info->semaphore);
   hashmap_info->next=0;
-  hashmap_info->head_of_list=MagickFalse;
   (void) UnlockSemaphoreInfo(hashmap_info->semaphore);
 }
 
@@ -255,6 +255,9 @@ MagickExport Image *AcquireImage(const ImageInfo *image_info)
   image->client_data=image_info->client_data;
   if (image_info->cache != (void *) NULL)
     ClonePixelCacheMethods(image->cache,image_info->cache);
+  if (image_info->resource_context != (ResourceContext *) NULL)
+    (void) SetPixelCacheResourceContext(image->cache,
+      image_info->resource_context);
   (void) SetImageVirtualPixelMethod(image,image_info->virtual_pixel_method);
   SyncImageSettings(image_info,image);
   return(image);
@@ -552,7 +555,8 @@ MagickExport Image *AppendImages(const Image *image,
       y_offset-=geometry.y;
     image_view=AcquireCacheView(image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-    #pragma omp parallel for schedule(dynamic,4) shared(status)
+    #pragma omp parallel for shared(status) \
+      magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
     for (y=0; y < (long) image->rows; y++)
     {
@@ -994,6 +998,9 @@ MagickExport ImageInfo *CloneImageInfo(const ImageInfo *image_info)
   if (image_info->profile != (void *) NULL)
     clone_info->profile=(void *) CloneStringInfo((StringInfo *)
       image_info->profile);
+  if (image_info->resource_context != (ResourceContext *) NULL)
+    clone_info->resource_context=ReferenceResourceContext(
+      image_info->resource_context);
   SetImageInfoFile(clone_info,image_info->file);
   SetImageInfoBlob(clone_info,image_info->blob,image_info->length);
   clone_info->stream=image_info->stream;
@@ -1093,7 +1100,8 @@ MagickExport Image *CombineImages(const Image *image,const ChannelType channel,
   progress=0;
   combine_view=AcquireCacheView(combine_image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(PointThreadCost,combine_image->columns,combine_image->rows)
 #endif
   for (y=0; y < (long) combine_image->rows; y++)
   {
@@ -1364,6 +1372,9 @@ MagickExport ImageInfo *DestroyImageInfo(ImageInfo *image_info)
   if (image_info->profile != (StringInfo *) NULL)
     image_info->profile=(void *) DestroyStringInfo((StringInfo *)
       image_info->profile);
+  if (image_info->resource_context != (ResourceContext *) NULL)
+    image_info->resource_context=DestroyResourceContext(
+      image_info->resource_context);
   image_info->signature=(~MagickSignature);
   image_info=(ImageInfo *) RelinquishMagickMemory(image_info);
   return(image_info);
@@ -1880,7 +1891,8 @@ MagickExport MagickBooleanType IsHighDynamicRangeImage(const Image *image,
   GetMagickPixelPacket(image,&zero);
   image_view=AcquireCacheView(image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(status)
+  #pragma omp parallel for shared(status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
   for (y=0; y < (long) image->rows; y++)
   {
@@ -2340,7 +2352,8 @@ MagickExport MagickBooleanType SeparateImageChannel(Image *image,
   exception=(&image->exception);
   image_view=AcquireCacheView(image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
   for (y=0; y < (long) image->rows; y++)
   {
@@ -2627,7 +2640,8 @@ MagickExport MagickBooleanType SetImageAlphaChannel(Image *image,
       exception=(&image->exception);
       image_view=AcquireCacheView(image);
       #if defined(MAGICKCORE_OPENMP_SUPPORT)
-        #pragma omp parallel for schedule(dynamic,4) shared(status)
+        #pragma omp parallel for shared(status) \
+          magick_schedule(PointThreadCost,image->columns,image->rows)
       #endif
       for (y=0; y < (long) image->rows; y++)
       {
@@ -2803,7 +2817,8 @@ MagickExport MagickBooleanType SetImageBackgroundColor(Image *image)
   exception=(&image->exception);
   image_view=AcquireCacheView(image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(status)
+  #pragma omp parallel for shared(status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
   for (y=0; y < (long) image->rows; y++)
   {
@@ -3470,7 +3485,8 @@ MagickExport MagickBooleanType SetImageOpacity(Image *image,
   exception=(&image->exception);
   image_view=AcquireCacheView(image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(status)
+  #pragma omp parallel for shared(status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
   for (y=0; y < (long) image->rows; y++)
   {
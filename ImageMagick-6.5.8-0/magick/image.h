@@ -140,6 +140,7 @@ typedef struct _ChromaticityInfo
 #include "magick/quantum.h"
 #include "magick/resample.h"
 #include "magick/resize.h"
+#include "magick/resource_.h"
 #include "magick/semaphore.h"
 #include "magick/stream.h"
 #include "magick/timer.h"
@@ -473,6 +474,9 @@ struct _ImageInfo
 
   MagickBooleanType
     synchronize;
+
+  ResourceContext
+    *resource_context;
 };
 
 extern MagickExport ExceptionType
@@ -178,6 +178,9 @@ static LinkedListInfo
 static SemaphoreInfo
   *log_semaphore = (SemaphoreInfo *) NULL;
 
+static volatile LogEventType
+  log_event_mask = NoEvents;
+
 static volatile MagickBooleanType
   instantiate_log = MagickFalse;
 
@@ -288,8 +291,11 @@ static LogInfo *GetLogInfo(const char *name,ExceptionInfo *exception)
     p=(LogInfo *) GetNextValueInLinkedList(log_list);
   }
   if (p != (LogInfo *) NULL)
-    (void) InsertValueInLinkedList(log_list,0,
-      RemoveElementByValueFromLinkedList(log_list,p));
+    {
+      (void) InsertValueInLinkedList(log_list,0,
+        RemoveElementByValueFromLinkedList(log_list,p));
+      log_event_mask=p->event_mask;
+    }
   (void) UnlockSemaphoreInfo(log_semaphore);
   return(p);
 }
@@ -537,6 +543,10 @@ static MagickBooleanType InitializeLogList(ExceptionInfo *exception)
           (instantiate_log == MagickFalse))
         {
           (void) LoadLogLists(LogFilename,exception);
+          if ((log_list != (LinkedListInfo *) NULL) &&
+              (IsLinkedListEmpty(log_list) == MagickFalse))
+            log_event_mask=((LogInfo *) GetValueFromLinkedList(log_list,0))->
+              event_mask;
           instantiate_log=MagickTrue;
         }
       (void) UnlockSemaphoreInfo(log_semaphore);
@@ -549,6 +559,35 @@ static MagickBooleanType InitializeLogList(ExceptionInfo *exception)
 %                                                                             %
 %                                                                             %
 %                                                                             %
+%  I s E v e n t L o g g e d                                                  %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  IsEventLogged() returns MagickTrue if events of the specified type are
+%  logged otherwise MagickFalse.  Use it to skip building log messages that
+%  would be discarded.
+%
+%  The format of the IsEventLogged method is:
+%
+%      MagickBooleanType IsEventLogged(const LogEventType type)
+%
+%  A description of each parameter follows:
+%
+%    o type: the event type.
+%
+*/
+MagickExport MagickBooleanType IsEventLogged(const LogEventType type)
+{
+  return((log_event_mask & type) != 0 ? MagickTrue : MagickFalse);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
 %  I s E v e n t L o g g i n g                                                %
 %                                                                             %
 %                                                                             %
@@ -565,19 +604,11 @@ static MagickBooleanType InitializeLogList(ExceptionInfo *exception)
 */
 MagickExport MagickBooleanType IsEventLogging(void)
 {
-  const LogInfo
-    *log_info;
-
-  ExceptionInfo
-    *exception;
-
-  if ((log_list == (LinkedListInfo *) NULL) ||
-      (IsLinkedListEmpty(log_list) != MagickFalse))
-    return(MagickFalse);
-  exception=AcquireExceptionInfo();
-  log_info=GetLogInfo("*",exception);
-  exception=DestroyExceptionInfo(exception);
-  return(log_info->event_mask != NoEvents ? MagickTrue : MagickFalse);
+  /*
+    The event mask of the active log is cached so this check is cheap enough
+    to guard formatting on hot paths.
+  */
+  return(log_event_mask != NoEvents ? MagickTrue : MagickFalse);
 }
 /*
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -740,6 +771,7 @@ MagickExport void LogComponentTerminus(void)
   (void) LockSemaphoreInfo(log_semaphore);
   if (log_list != (LinkedListInfo *) NULL)
     log_list=DestroyLinkedList(log_list,DestroyLogElement);
+  log_event_mask=NoEvents;
   instantiate_log=MagickFalse;
   (void) UnlockSemaphoreInfo(log_semaphore);
   DestroySemaphoreInfo(&log_semaphore);
@@ -1123,6 +1155,8 @@ MagickBooleanType LogMagickEventList(const LogEventType type,const char *module,
 
   if (IsEventLogging() == MagickFalse)
     return(MagickFalse);
+  if ((log_event_mask & type) == 0)
+    return(MagickTrue);
   exception=AcquireExceptionInfo();
   log_info=(LogInfo *) GetLogInfo("*",exception);
   exception=DestroyExceptionInfo(exception);
@@ -1689,6 +1723,7 @@ MagickExport LogEventType SetLogEventMask(const char *events)
   log_info->event_mask=(LogEventType) option;
   if (option == -1)
     log_info->event_mask=UndefinedEvents;
+  log_event_mask=log_info->event_mask;
   (void) UnlockSemaphoreInfo(log_semaphore);
   return(log_info->event_mask);
 }
@@ -72,6 +72,7 @@ extern MagickExport LogEventType
   SetLogEventMask(const char *);
 
 extern MagickExport MagickBooleanType
+  IsEventLogged(const LogEventType),
   IsEventLogging(void),
   ListLogInfo(FILE *,ExceptionInfo *),
   LogComponentGenesis(void),
@@ -76,6 +76,28 @@ typedef struct _MagicMapInfo
   const size_t
     length;
 } MagicMapInfo;
+
+typedef struct _MagicOffsetInfo
+{
+  size_t
+    offset,
+    start[257];
+} MagicOffsetInfo;
+
+typedef struct _MagicIndexInfo
+{
+  const MagicInfo
+    **table;
+
+  MagicOffsetInfo
+    *offsets;
+
+  size_t
+    number_offsets,
+    number_indexed,
+    number_entries,
+    *candidates;
+} MagicIndexInfo;
 
 /*
   Static declarations.
@@ -196,6 +218,9 @@ static const MagicMapInfo
 static LinkedListInfo
   *magic_list = (LinkedListInfo *) NULL;
 
+static MagicIndexInfo
+  *magic_index = (MagicIndexInfo *) NULL;
+
 static SemaphoreInfo
   *magic_semaphore = (SemaphoreInfo *) NULL;
 
@@ -214,6 +239,145 @@ static MagickBooleanType
 %                                                                             %
 %                                                                             %
 %                                                                             %
++   C o m p i l e M a g i c L i s t                                           %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  CompileMagicList() compiles the magic list into the index GetMagicInfo()
+%  searches.  Each distinct offset gets 256 buckets, one per value of the
+%  first signature byte, holding list positions in ascending order.
+%  Entries with an empty signature follow the bucketed candidates.
+%
+%  The format of the CompileMagicList method is:
+%
+%      MagicIndexInfo *CompileMagicList(LinkedListInfo *list)
+%
+%  A description of each parameter follows:
+%
+%    o list: the magic list.
+%
+*/
+
+static MagicIndexInfo *DestroyMagicIndex(MagicIndexInfo *index)
+{
+  if (index->candidates != (size_t *) NULL)
+    index->candidates=(size_t *) RelinquishMagickMemory(index->candidates);
+  if (index->offsets != (MagicOffsetInfo *) NULL)
+    index->offsets=(MagicOffsetInfo *) RelinquishMagickMemory(index->offsets);
+  if (index->table != (const MagicInfo **) NULL)
+    index->table=(const MagicInfo **) RelinquishMagickMemory((void *)
+      index->table);
+  return((MagicIndexInfo *) RelinquishMagickMemory(index));
+}
+
+static MagicIndexInfo *CompileMagicList(LinkedListInfo *list)
+{
+  const MagicInfo
+    *p;
+
+  MagicIndexInfo
+    *index;
+
+  MagicOffsetInfo
+    *q;
+
+  register size_t
+    i,
+    j;
+
+  size_t
+    byte,
+    number_entries,
+    start;
+
+  index=(MagicIndexInfo *) AcquireMagickMemory(sizeof(*index));
+  if (index == (MagicIndexInfo *) NULL)
+    return((MagicIndexInfo *) NULL);
+  (void) ResetMagickMemory(index,0,sizeof(*index));
+  number_entries=(size_t) GetNumberOfElementsInLinkedList(list);
+  index->table=(const MagicInfo **) AcquireQuantumMemory(number_entries+1,
+    sizeof(*index->table));
+  index->offsets=(MagicOffsetInfo *) AcquireQuantumMemory(number_entries+1,
+    sizeof(*index->offsets));
+  index->candidates=(size_t *) AcquireQuantumMemory(number_entries+1,
+    sizeof(*index->candidates));
+  if ((index->table == (const MagicInfo **) NULL) ||
+      (index->offsets == (MagicOffsetInfo *) NULL) ||
+      (index->candidates == (size_t *) NULL))
+    return(DestroyMagicIndex(index));
+  /*
+    Snapshot the list and count the entries in each bucket.
+  */
+  ResetLinkedListIterator(list);
+  for (i=0; i < number_entries; i++)
+  {
+    p=(const MagicInfo *) GetNextValueInLinkedList(list);
+    if (p == (const MagicInfo *) NULL)
+      break;
+    assert(p->offset >= 0);
+    index->table[i]=p;
+    if (p->length == 0)
+      continue;
+    for (j=0; j < index->number_offsets; j++)
+      if (index->offsets[j].offset == (size_t) p->offset)
+        break;
+    q=index->offsets+j;
+    if (j == index->number_offsets)
+      {
+        (void) ResetMagickMemory(q,0,sizeof(*q));
+        q->offset=(size_t) p->offset;
+        index->number_offsets++;
+      }
+    q->start[*p->magic+1]++;
+    index->number_indexed++;
+  }
+  index->table[i]=(const MagicInfo *) NULL;
+  index->number_entries=i;
+  /*
+    Turn the counts into bucket extents, then fill the buckets in list order.
+  */
+  start=0;
+  for (j=0; j < index->number_offsets; j++)
+  {
+    q=index->offsets+j;
+    q->start[0]=start;
+    for (byte=1; byte <= 256; byte++)
+      q->start[byte]+=q->start[byte-1];
+    start=q->start[256];
+  }
+  start=index->number_indexed;
+  for (i=0; i < index->number_entries; i++)
+  {
+    p=index->table[i];
+    if (p->length == 0)
+      {
+        index->candidates[start++]=i;
+        continue;
+      }
+    for (j=0; (size_t) p->offset != index->offsets[j].offset; j++) ;
+    q=index->offsets+j;
+    index->candidates[q->start[*p->magic]++]=i;
+  }
+  for (j=0; j < index->number_offsets; j++)
+  {
+    /*
+      Filling advanced each bucket start to the start of the next bucket.
+    */
+    q=index->offsets+j;
+    for (byte=256; byte > 0; byte--)
+      q->start[byte]=q->start[byte-1];
+    q->start[0]=(j == 0) ? 0 : index->offsets[j-1].start[256];
+  }
+  return(index);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
 +   G e t M a g i c I n f o                                                   %
 %                                                                             %
 %                                                                             %
@@ -223,6 +387,12 @@ static MagickBooleanType
 %  GetMagicInfo() searches the magic list for the specified name and if found
 %  returns attributes for that magic.
 %
+%  The magic list is compiled into an index when it is loaded: entries are
+%  bucketed by their offset and then by their first byte.  A search visits
+%  each distinct offset once, looks up the header byte found there, and
+%  compares only the entries in that bucket.  The first matching entry in
+%  list order wins.  The index is immutable, so the search takes no lock.
+%
 %  The format of the GetMagicInfo method is:
 %
 %      const MagicInfo *GetMagicInfo(const unsigned char *magic,
@@ -244,6 +414,16 @@ MagickExport const MagicInfo *GetMagicInfo(const unsigned char *magic,
   register const MagicInfo
     *p;
 
+  register const MagicOffsetInfo
+    *q;
+
+  register size_t
+    i,
+    j;
+
+  size_t
+    match;
+
   assert(exception != (ExceptionInfo *) NULL);
   if ((magic_list == (LinkedListInfo *) NULL) ||
       (instantiate_magic == MagickFalse))
@@ -259,22 +439,42 @@ MagickExport const MagicInfo *GetMagicInfo(const unsigned char *magic,
   /*
     Search for magic tag.
   */
-  (void) LockSemaphoreInfo(magic_semaphore);
-  ResetLinkedListIterator(magic_list);
-  p=(const MagicInfo *) GetNextValueInLinkedList(magic_list);
-  while (p != (const MagicInfo *) NULL)
+  match=magic_index->number_entries;
+  for (i=0; i < magic_index->number_offsets; i++)
   {
-    assert(p->offset >= 0);
-    if (((size_t) (p->offset+p->length) <= length) &&
-        (memcmp(magic+p->offset,p->magic,p->length) == 0))
+    q=magic_index->offsets+i;
+    if (q->offset >= length)
+      continue;
+    for (j=q->start[magic[q->offset]]; j < q->start[magic[q->offset]+1]; j++)
+    {
+      if (magic_index->candidates[j] >= match)
+        break;
+      p=magic_index->table[magic_index->candidates[j]];
+      if (((q->offset+p->length) <= length) &&
+          (memcmp(magic+q->offset+1,p->magic+1,p->length-1) == 0))
+        {
+          match=magic_index->candidates[j];
+          break;
+        }
+    }
+  }
+  for (j=magic_index->number_indexed; j < magic_index->number_entries; j++)
+  {
+    /*
+      Entries with an empty signature.
+    */
+    if (magic_index->candidates[j] >= match)
       break;
-    p=(const MagicInfo *) GetNextValueInLinkedList(magic_list);
+    p=magic_index->table[magic_index->candidates[j]];
+    if ((size_t) p->offset <= length)
+      {
+        match=magic_index->candidates[j];
+        break;
+      }
   }
-  if (p != (const MagicInfo *) NULL)
-    (void) InsertValueInLinkedList(magic_list,0,
-      RemoveElementByValueFromLinkedList(magic_list,p));
-  (void) UnlockSemaphoreInfo(magic_semaphore);
-  return(p);
+  if (match == magic_index->number_entries)
+    return((const MagicInfo *) NULL);
+  return(magic_index->table[match]);
 }
 
 /*
@@ -519,7 +719,7 @@ MagickExport const char *GetMagicName(const MagicInfo *magic_info)
 */
 static MagickBooleanType InitializeMagicList(ExceptionInfo *exception)
 {
-  if ((magic_list == (LinkedListInfo *) NULL) &&
+  if ((magic_index == (MagicIndexInfo *) NULL) &&
       (instantiate_magic == MagickFalse))
     {
       if (magic_semaphore == (SemaphoreInfo *) NULL)
@@ -529,6 +729,13 @@ static MagickBooleanType InitializeMagicList(ExceptionInfo *exception)
           (instantiate_magic == MagickFalse))
         {
           (void) LoadMagicLists(MagicFilename,exception);
+          if (magic_list != (LinkedListInfo *) NULL)
+            {
+              magic_index=CompileMagicList(magic_list);
+              if (magic_index == (MagicIndexInfo *) NULL)
+                ThrowFatalException(ResourceLimitFatalError,
+                  "MemoryAllocationFailed");
+            }
           instantiate_magic=MagickTrue;
         }
       (void) UnlockSemaphoreInfo(magic_semaphore);
@@ -1061,6 +1268,8 @@ MagickExport void MagicComponentTerminus(void)
   if (magic_semaphore == (SemaphoreInfo *) NULL)
     AcquireSemaphoreInfo(&magic_semaphore);
   (void) LockSemaphoreInfo(magic_semaphore);
+  if (magic_index != (MagicIndexInfo *) NULL)
+    magic_index=DestroyMagicIndex(magic_index);
   if (magic_list != (LinkedListInfo *) NULL)
     magic_list=DestroyLinkedList(magic_list,DestroyMagicElement);
   instantiate_magic=MagickFalse;
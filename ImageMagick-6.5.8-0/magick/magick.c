@@ -52,6 +52,7 @@
 #include "magick/draw.h"
 #include "magick/exception.h"
 #include "magick/exception-private.h"
+#include "magick/hashmap.h"
 #include "magick/locale_.h"
 #include "magick/log.h"
 #include "magick/magic.h"
@@ -73,6 +74,7 @@
 #include "magick/thread_.h"
 #include "magick/thread-private.h"
 #include "magick/token.h"
+#include "magick/trace.h"
 #include "magick/utility.h"
 #include "magick/xwindow-private.h"
 
@@ -101,6 +103,12 @@ typedef MAGICKCORE_RETSIGTYPE
 /*
   Global declarations.
 */
+static HashmapInfo
+  *magick_index = (HashmapInfo *) NULL;
+
+static LinkedListInfo
+  *magick_retired = (LinkedListInfo *) NULL;
+
 static SemaphoreInfo
   *magick_semaphore = (SemaphoreInfo *) NULL;
 
@@ -382,7 +390,9 @@ MagickExport MagickBooleanType GetMagickEndianSupport(
 %
 %  GetMagickInfo() returns a pointer MagickInfo structure that matches
 %  the specified name.  If name is NULL, the head of the image format list
-%  is returned.
+%  is returned.  Formats are indexed by name as they are registered, so a
+%  lookup of a registered format takes no lock.  A statically linked coder is
+%  registered on the first lookup of one of its formats.
 %
 %  The format of the GetMagickInfo method is:
 %
@@ -408,6 +418,9 @@ MagickExport const MagickInfo *GetMagickInfo(const char *name,
       return((const MagickInfo *) NULL);
   if ((name == (const char *) NULL) || (LocaleCompare(name,"*") == 0))
     {
+#if !defined(MAGICKCORE_BUILD_MODULES)
+      RegisterStaticModules();
+#endif
 #if defined(MAGICKCORE_MODULES_SUPPORT)
       if (LocaleCompare(name,"*") == 0)
         (void) OpenModules(exception);
@@ -421,31 +434,22 @@ MagickExport const MagickInfo *GetMagickInfo(const char *name,
   /*
     Find name in list.
   */
-  (void) LockSemaphoreInfo(magick_semaphore);
-  ResetSplayTreeIterator(magick_list);
-  p=(const MagickInfo *) GetNextValueInSplayTree(magick_list);
-  while (p != (const MagickInfo *) NULL)
-  {
-    if (LocaleCompare(p->name,name) == 0)
-      break;
-    p=(const MagickInfo *) GetNextValueInSplayTree(magick_list);
-  }
+  p=(const MagickInfo *) GetValueFromHashmap(magick_index,name);
+#if !defined(MAGICKCORE_BUILD_MODULES)
+  if ((p == (const MagickInfo *) NULL) && (RegisterStaticModule(name) !=
+      MagickFalse))
+    p=(const MagickInfo *) GetValueFromHashmap(magick_index,name);
+#endif
 #if defined(MAGICKCORE_MODULES_SUPPORT)
   if (p == (const MagickInfo *) NULL)
     {
+      (void) LockSemaphoreInfo(magick_semaphore);
       if (*name != '\0')
         (void) OpenModule(name,exception);
-      ResetSplayTreeIterator(magick_list);
-      p=(const MagickInfo *) GetNextValueInSplayTree(magick_list);
-      while (p != (const MagickInfo *) NULL)
-      {
-        if (LocaleCompare(p->name,name) == 0)
-          break;
-        p=(const MagickInfo *) GetNextValueInSplayTree(magick_list);
-      }
+      p=(const MagickInfo *) GetValueFromHashmap(magick_index,name);
+      (void) UnlockSemaphoreInfo(magick_semaphore);
     }
 #endif
-  (void) UnlockSemaphoreInfo(magick_semaphore);
   return(p);
 }
 
@@ -781,9 +785,6 @@ static MagickBooleanType InitializeMagickList(ExceptionInfo *exception)
       if ((magick_list == (SplayTreeInfo *) NULL) &&
           (instantiate_magick == MagickFalse))
         {
-          MagickBooleanType
-            status;
-
           MagickInfo
             *magick_info;
 
@@ -792,30 +793,17 @@ static MagickBooleanType InitializeMagickList(ExceptionInfo *exception)
           if (magick_list == (SplayTreeInfo *) NULL)
             ThrowFatalException(ResourceLimitFatalError,
               "MemoryAllocationFailed");
+          magick_index=NewHashmap(MediumHashmapSize,HashStringType,
+            CompareHashmapString,(void *(*)(void *)) NULL,
+            (void *(*)(void *)) NULL);
           magick_info=SetMagickInfo("ephemeral");
           magick_info->stealth=MagickTrue;
-          status=AddValueToSplayTree(magick_list,magick_info->name,magick_info);
-          if (status == MagickFalse)
-            ThrowFatalException(ResourceLimitFatalError,
-              "MemoryAllocationFailed");
+          (void) RegisterMagickInfo(magick_info);
           magick_info=SetMagickInfo("clipmask");
           magick_info->stealth=MagickTrue;
-          status=AddValueToSplayTree(magick_list,magick_info->name,magick_info);
-          if (status == MagickFalse)
-            {
-              char
-                *message;
-
-              message=GetExceptionMessage(errno);
-              ThrowFatalException(ResourceLimitFatalError,
-                "MemoryAllocationFailed");
-              message=DestroyString(message);
-            }
+          (void) RegisterMagickInfo(magick_info);
 #if defined(MAGICKCORE_MODULES_SUPPORT)
           (void) GetModuleInfo((char *) NULL,exception);
-#endif
-#if !defined(MAGICKCORE_BUILD_MODULES)
-          RegisterStaticModules();
 #endif
           instantiate_magick=MagickTrue;
         }
@@ -1058,8 +1046,12 @@ MagickExport void MagickComponentTerminus(void)
   if (magick_semaphore == (SemaphoreInfo *) NULL)
     AcquireSemaphoreInfo(&magick_semaphore);
   (void) LockSemaphoreInfo(magick_semaphore);
+  if (magick_index != (HashmapInfo *) NULL)
+    magick_index=DestroyHashmap(magick_index);
   if (magick_list != (SplayTreeInfo *) NULL)
     magick_list=DestroySplayTree(magick_list);
+  if (magick_retired != (LinkedListInfo *) NULL)
+    magick_retired=DestroyLinkedList(magick_retired,DestroyMagickNode);
   instantiate_magick=MagickFalse;
   (void) UnlockSemaphoreInfo(magick_semaphore);
   DestroySemaphoreInfo(&magick_semaphore);
@@ -1195,6 +1187,7 @@ MagickExport void MagickCoreGenesis(const char *path,
       (void) SetLogEventMask(events);
       events=DestroyString(events);
     }
+  (void) TraceComponentGenesis();
 #if defined(__WINDOWS__)
 #if defined(_DEBUG) && !defined(__BORLANDC__) && !defined(__MINGW32__)
   if (IsEventLogging() != MagickFalse)
@@ -1280,6 +1273,7 @@ MagickExport void MagickCoreGenesis(const char *path,
   (void) TypeComponentGenesis();
   (void) MimeComponentGenesis();
   (void) ConstituteComponentGenesis();
+  (void) DrawComponentGenesis();
   (void) XComponentGenesis();
 }
 
@@ -1306,6 +1300,7 @@ MagickExport void MagickCoreTerminus(void)
 #if defined(MAGICKCORE_X11_DELEGATE)
   XComponentTerminus();
 #endif
+  DrawComponentTerminus();
   ConstituteComponentTerminus();
   MimeComponentTerminus();
   TypeComponentTerminus();
@@ -1328,6 +1323,7 @@ MagickExport void MagickCoreTerminus(void)
   CacheComponentTerminus();
   PolicyComponentTerminus();
   ConfigureComponentTerminus();
+  TraceComponentTerminus();
   RandomComponentTerminus();
   LocaleComponentTerminus();
   LogComponentTerminus();
@@ -1361,11 +1357,31 @@ MagickExport void MagickCoreTerminus(void)
 %    o magick_info: the magick info.
 %
 */
+static MagickBooleanType RetireMagickInfo(MagickInfo *magick_info)
+{
+  /*
+    A lookup that skips the lock may still be comparing against the name,
+    and callers keep the info GetMagickInfo() returned: keep it until the
+    magick component is destroyed.
+  */
+  if (magick_retired == (LinkedListInfo *) NULL)
+    {
+      magick_retired=NewLinkedList(0);
+      if (magick_retired == (LinkedListInfo *) NULL)
+        return(MagickFalse);
+    }
+  (void) RemoveNodeFromSplayTree(magick_list,magick_info->name);
+  return(AppendValueToLinkedList(magick_retired,magick_info));
+}
+
 MagickExport MagickInfo *RegisterMagickInfo(MagickInfo *magick_info)
 {
   MagickBooleanType
     status;
 
+  MagickInfo
+    *p;
+
   /*
     Delete any existing name.
   */
@@ -1374,7 +1390,15 @@ MagickExport MagickInfo *RegisterMagickInfo(MagickInfo *magick_info)
   (void) LogMagickEvent(TraceEvent,GetMagickModule(),"%s",magick_info->name);
   if (magick_list == (SplayTreeInfo *) NULL)
     return((MagickInfo *) NULL);
-  status=AddValueToSplayTree(magick_list,magick_info->name,magick_info);
+  /*
+    Index the new entry before the entry it replaces is retired.
+  */
+  p=(MagickInfo *) GetValueFromHashmap(magick_index,magick_info->name);
+  status=PutEntryInHashmap(magick_index,magick_info->name,magick_info);
+  if ((status != MagickFalse) && (p != (MagickInfo *) NULL))
+    status=RetireMagickInfo(p);
+  if (status != MagickFalse)
+    status=AddValueToSplayTree(magick_list,magick_info->name,magick_info);
   if (status == MagickFalse)
     ThrowFatalException(ResourceLimitFatalError,"MemoryAllocationFailed");
   return(magick_info);
@@ -1440,6 +1464,8 @@ MagickExport MagickInfo *SetMagickInfo(const char *name)
 %
 %  UnregisterMagickInfo() removes a name from the magick info list.  It returns
 %  MagickFalse if the name does not exist in the list otherwise MagickTrue.
+%  The info of the name is not freed before MagickComponentTerminus(), so
+%  lookups in progress and callers of GetMagickInfo() may keep using it.
 %
 %  The format of the UnregisterMagickInfo method is:
 %
@@ -1453,27 +1479,22 @@ MagickExport MagickInfo *SetMagickInfo(const char *name)
 */
 MagickExport MagickBooleanType UnregisterMagickInfo(const char *name)
 {
-  register const MagickInfo
-    *p;
-
   MagickBooleanType
     status;
 
+  register MagickInfo
+    *p;
+
   assert(name != (const char *) NULL);
   if (magick_list == (SplayTreeInfo *) NULL)
     return(MagickFalse);
   if (GetNumberOfNodesInSplayTree(magick_list) == 0)
     return(MagickFalse);
   (void) LockSemaphoreInfo(magick_semaphore);
-  ResetSplayTreeIterator(magick_list);
-  p=(const MagickInfo *) GetNextValueInSplayTree(magick_list);
-  while (p != (const MagickInfo *) NULL)
-  {
-    if (LocaleCompare(p->name,name) == 0)
-      break;
-    p=(const MagickInfo *) GetNextValueInSplayTree(magick_list);
-  }
-  status=DeleteNodeByValueFromSplayTree(magick_list,p);
+  status=MagickFalse;
+  p=(MagickInfo *) RemoveEntryFromHashmap(magick_index,name);
+  if (p != (MagickInfo *) NULL)
+    status=RetireMagickInfo(p);
   (void) UnlockSemaphoreInfo(magick_semaphore);
   return(status);
 }
@@ -0,0 +1,45 @@
+/*
+  Copyright 1999-2009 ImageMagick Studio LLC, a non-profit organization
+  dedicated to making software imaging solutions freely available.
+  
+  You may not use this file except in compliance with the License.
+  obtain a copy of the License at
+  
+    http://www.imagemagick.org/script/license.php
+  
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  MagickCore memory private methods.
+*/
+#ifndef _MAGICKCORE_MEMORY_PRIVATE_H
+#define _MAGICKCORE_MEMORY_PRIVATE_H
+
+#if defined(__cplusplus) || defined(c_plusplus)
+extern "C" {
+#endif
+
+typedef struct _MemoryStatistics
+{
+  MagickSizeType
+    arenas,
+    active_arenas,
+    arena_extent,
+    peak_arena_extent,
+    heap_segments,
+    heap_extent,
+    cache_hits,
+    cache_misses;
+} MemoryStatistics;
+
+extern MagickExport void
+  GetMagickMemoryStatistics(MemoryStatistics *);
+
+#if defined(__cplusplus) || defined(c_plusplus)
+}
+#endif
+
+#endif
@@ -46,7 +46,13 @@
 %  By default, ANSI memory methods are called (e.g. malloc).  Use the
 %  custom memory allocator by defining MAGICKCORE_EMBEDDABLE_SUPPORT
 %  to allocate memory with private anonymous mapping rather than from the
-%  heap.
+%  heap.  Blocks of BlockThreshold bytes or less are recycled through small
+%  per-thread caches so the common allocate/free churn of a thread does not
+%  contend on the heap semaphore.
+%
+%  Hot operators can also acquire a memory arena for their temporaries (e.g.
+%  per-thread working sets).  An arena hands out memory by bumping an offset
+%  within large segments and releases everything at once when relinquished.
 %
 */
 
@@ -59,6 +65,7 @@
 #include "magick/exception.h"
 #include "magick/exception-private.h"
 #include "magick/memory_.h"
+#include "magick/memory-private.h"
 #include "magick/semaphore.h"
 #include "magick/string_.h"
 
@@ -71,8 +78,13 @@
 #define BlockSize  4096
 #define BlockThreshold  1024
 #define AlignedSize  (16*sizeof(void *))
+#define ArenaExtent  (64*1024)
+#define BlockExtent(size) \
+  ((size_t) ((size)+sizeof(size_t)+6*sizeof(size_t)-1) & -(4U*sizeof(size_t)))
 #define MaxBlockExponent  16
 #define MaxBlocks ((BlockThreshold/(4*sizeof(size_t)))+MaxBlockExponent+1)
+#define MaxCacheBlocks  64
+#define MaxCacheClasses  ((BlockThreshold/(4*sizeof(size_t)))+1)
 #define MaxSegments  1024
 #define MemoryGuard  ((0xdeadbeef << 31)+0xdeafdeed)
 #define NextBlock(block)  ((char *) (block)+SizeOfBlock(block))
@@ -87,6 +99,16 @@
 /*
   Typedef declarations.
 */
+typedef struct _ArenaSegmentInfo
+{
+  size_t
+    extent,
+    offset;
+
+  struct _ArenaSegmentInfo
+    *next;
+} ArenaSegmentInfo;
+
 typedef struct _DataSegmentInfo
 {
   void
@@ -132,6 +154,30 @@ typedef struct _MagickMemoryMethods
     destroy_memory_handler;
 } MagickMemoryMethods;
 
+typedef struct _MemoryCacheInfo
+{
+  void
+    *blocks[MaxCacheClasses];
+
+  size_t
+    number_blocks[MaxCacheClasses];
+
+  MagickSizeType
+    hits,
+    misses;
+} MemoryCacheInfo;
+
+struct _MemoryArena
+{
+  size_t
+    extent;
+
+  ArenaSegmentInfo
+    *segments;
+
+  unsigned long
+    signature;
+};
 
 /*
   Global declarations.
@@ -144,7 +190,21 @@ static MagickMemoryMethods
     (DestroyMemoryHandler)free
   };
 
+static MemoryStatistics
+  memory_statistics;
+
+static SemaphoreInfo
+  *statistics_semaphore = (SemaphoreInfo *) NULL;
+
 #if defined(MAGICKCORE_EMBEDDABLE_SUPPORT)
+static MagickBooleanType
+  memory_cache_support = MagickFalse;
+
+#if defined(MAGICKCORE_HAVE_PTHREAD)
+static pthread_key_t
+  memory_cache_key;
+#endif
+
 static MemoryInfo
   memory_info;
 
@@ -159,6 +219,9 @@ static volatile DataSegmentInfo
 */
 static MagickBooleanType
   ExpandHeap(size_t);
+
+static void
+  RelinquishBlock(void *);
 #endif
 
 /*
@@ -209,6 +272,95 @@ MagickExport void *AcquireAlignedMemory(const size_t count,const size_t quantum)
   return(malloc(size));
 }
 
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   A c q u i r e A r e n a M e m o r y                                       %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  AcquireArenaMemory() returns a pointer to a block of memory at least
+%  count * quantum bytes from the arena.  The address is a multiple of
+%  16*sizeof(void *) so blocks handed to different threads do not share a
+%  cache line.  The memory is released when the arena is relinquished.
+%
+%  The format of the AcquireArenaMemory method is:
+%
+%      void *AcquireArenaMemory(MemoryArena *arena,const size_t count,
+%        const size_t quantum)
+%
+%  A description of each parameter follows:
+%
+%    o arena: the memory arena.
+%
+%    o count: the number of quantum elements to allocate.
+%
+%    o quantum: the number of bytes in each quantum.
+%
+*/
+MagickExport void *AcquireArenaMemory(MemoryArena *arena,const size_t count,
+  const size_t quantum)
+{
+  ArenaSegmentInfo
+    *segment;
+
+  size_t
+    extent,
+    size;
+
+  void
+    *memory;
+
+  assert(arena != (MemoryArena *) NULL);
+  assert(arena->signature == MagickSignature);
+  size=count*quantum;
+  if ((count == 0) || (quantum != (size/count)) ||
+      ((size+AlignedSize-1) < size))
+    {
+      errno=ENOMEM;
+      return((void *) NULL);
+    }
+  size=(size+AlignedSize-1) & ~(AlignedSize-1);
+  segment=arena->segments;
+  if ((segment == (ArenaSegmentInfo *) NULL) ||
+      (size > (segment->extent-segment->offset)))
+    {
+      /*
+        Start a new segment; the remainder of the current one is abandoned.
+      */
+      assert(sizeof(*segment) <= AlignedSize);
+      extent=size > arena->extent ? size : arena->extent;
+      if ((extent+AlignedSize) < extent)
+        {
+          errno=ENOMEM;
+          return((void *) NULL);
+        }
+      segment=(ArenaSegmentInfo *) AcquireAlignedMemory(1,extent+AlignedSize);
+      if (segment == (ArenaSegmentInfo *) NULL)
+        return((void *) NULL);
+      segment->extent=extent;
+      segment->offset=0;
+      segment->next=arena->segments;
+      arena->segments=segment;
+      if (arena->extent < SegmentSize)
+        arena->extent<<=1;
+      if (statistics_semaphore == (SemaphoreInfo *) NULL)
+        AcquireSemaphoreInfo(&statistics_semaphore);
+      (void) LockSemaphoreInfo(statistics_semaphore);
+      memory_statistics.arena_extent+=extent+AlignedSize;
+      if (memory_statistics.arena_extent > memory_statistics.peak_arena_extent)
+        memory_statistics.peak_arena_extent=memory_statistics.arena_extent;
+      (void) UnlockSemaphoreInfo(statistics_semaphore);
+    }
+  memory=(char *) segment+AlignedSize+segment->offset;
+  segment->offset+=size;
+  return(memory);
+}
+
 #if defined(MAGICKCORE_EMBEDDABLE_SUPPORT)
 /*
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -316,7 +468,7 @@ static void *AcquireBlock(size_t size)
   /*
     Find free block.
   */
-  size=(size_t) (size+sizeof(size_t)+6*sizeof(size_t)-1) & -(4U*sizeof(size_t));
+  size=BlockExtent(size);
   i=AllocationPolicy(size);
   block=memory_info.blocks[i];
   while ((block != (void *) NULL) && (SizeOfBlock(block) < size))
@@ -381,6 +533,84 @@ static void *AcquireBlock(size_t size)
 %    o size: the size of the memory in bytes to allocate.
 %
 */
+
+#if defined(MAGICKCORE_EMBEDDABLE_SUPPORT)
+static void DestroyMemoryCache(void *cache)
+{
+  MemoryCacheInfo
+    *cache_info;
+
+  register long
+    i;
+
+  void
+    *block;
+
+  /*
+    Return the cached blocks of an exiting thread to the heap.
+  */
+  cache_info=(MemoryCacheInfo *) cache;
+  if (cache_info == (MemoryCacheInfo *) NULL)
+    return;
+  (void) LockSemaphoreInfo(memory_semaphore);
+  for (i=0; i < (long) MaxCacheClasses; i++)
+    while (cache_info->blocks[i] != (void *) NULL)
+    {
+      block=cache_info->blocks[i];
+      cache_info->blocks[i]=NextBlockInList(block);
+      RelinquishBlock(block);
+    }
+  memory_statistics.cache_hits+=cache_info->hits;
+  memory_statistics.cache_misses+=cache_info->misses;
+  (void) UnlockSemaphoreInfo(memory_semaphore);
+  memory_methods.destroy_memory_handler(cache_info);
+}
+
+static inline void FlushMemoryCacheStatistics(MemoryCacheInfo *cache_info)
+{
+  /*
+    Caller holds the memory semaphore.
+  */
+  if (cache_info == (MemoryCacheInfo *) NULL)
+    return;
+  memory_statistics.cache_hits+=cache_info->hits;
+  memory_statistics.cache_misses+=cache_info->misses;
+  cache_info->hits=0;
+  cache_info->misses=0;
+}
+
+static MemoryCacheInfo *GetMemoryCache(void)
+{
+  MemoryCacheInfo
+    *cache_info;
+
+  /*
+    The cache itself comes from the memory handler so acquiring it never
+    recurses into the heap.
+  */
+  if (memory_cache_support == MagickFalse)
+    return((MemoryCacheInfo *) NULL);
+#if !defined(MAGICKCORE_HAVE_PTHREAD)
+  cache_info=(MemoryCacheInfo *) NULL;
+#else
+  cache_info=(MemoryCacheInfo *) pthread_getspecific(memory_cache_key);
+  if (cache_info != (MemoryCacheInfo *) NULL)
+    return(cache_info);
+  cache_info=(MemoryCacheInfo *) memory_methods.acquire_memory_handler(
+    sizeof(*cache_info));
+  if (cache_info == (MemoryCacheInfo *) NULL)
+    return(cache_info);
+  (void) ResetMagickMemory(cache_info,0,sizeof(*cache_info));
+  if (pthread_setspecific(memory_cache_key,cache_info) != 0)
+    {
+      memory_methods.destroy_memory_handler(cache_info);
+      cache_info=(MemoryCacheInfo *) NULL;
+    }
+#endif
+  return(cache_info);
+}
+#endif
+
 MagickExport void *AcquireMagickMemory(const size_t size)
 {
   register void
@@ -389,6 +619,12 @@ MagickExport void *AcquireMagickMemory(const size_t size)
 #if !defined(MAGICKCORE_EMBEDDABLE_SUPPORT)
   memory=memory_methods.acquire_memory_handler(size == 0 ? 1UL : size);
 #else
+  MemoryCacheInfo
+    *cache_info;
+
+  size_t
+    blocksize;
+
   if (memory_semaphore == (SemaphoreInfo *) NULL)
     AcquireSemaphoreInfo(&memory_semaphore);
   if (free_segments == (DataSegmentInfo *) NULL)
@@ -411,11 +647,41 @@ MagickExport void *AcquireMagickMemory(const size_t size)
             if (i != (MaxSegments-1))
               memory_info.segment_pool[i].next=(&memory_info.segment_pool[i+1]);
           }
+#if defined(MAGICKCORE_HAVE_PTHREAD)
+          if (pthread_key_create(&memory_cache_key,DestroyMemoryCache) == 0)
+            memory_cache_support=MagickTrue;
+#endif
           free_segments=(&memory_info.segment_pool[0]);
         }
       (void) UnlockSemaphoreInfo(memory_semaphore);
     }
+  /*
+    Small blocks are served from the per-thread cache without locking.
+  */
+  cache_info=(MemoryCacheInfo *) NULL;
+  blocksize=BlockExtent(size == 0 ? 1UL : size);
+  if (blocksize <= BlockThreshold)
+    {
+      cache_info=GetMemoryCache();
+      if (cache_info != (MemoryCacheInfo *) NULL)
+        {
+          register size_t
+            i;
+
+          i=blocksize/(4*sizeof(size_t));
+          memory=cache_info->blocks[i];
+          if (memory != (void *) NULL)
+            {
+              cache_info->blocks[i]=NextBlockInList(memory);
+              cache_info->number_blocks[i]--;
+              cache_info->hits++;
+              return(memory);
+            }
+          cache_info->misses++;
+        }
+    }
   (void) LockSemaphoreInfo(memory_semaphore);
+  FlushMemoryCacheStatistics(cache_info);
   memory=AcquireBlock(size == 0 ? 1UL : size);
   if (memory == (void *) NULL)
     {
@@ -432,6 +698,54 @@ MagickExport void *AcquireMagickMemory(const size_t size)
 %                                                                             %
 %                                                                             %
 %                                                                             %
+%   A c q u i r e M e m o r y A r e n a                                       %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  AcquireMemoryArena() returns a memory arena for the temporaries of a single
+%  operation.  Allocate from it with AcquireArenaMemory() and release all of
+%  its memory at once with RelinquishMemoryArena().  An arena is not thread
+%  safe: acquire its memory from one thread, although the blocks themselves
+%  may be handed out to other threads.
+%
+%  The format of the AcquireMemoryArena method is:
+%
+%      MemoryArena *AcquireMemoryArena(const size_t extent)
+%
+%  A description of each parameter follows:
+%
+%    o extent: the expected number of bytes the arena will hand out, or 0 for
+%      the default.  Sizing it right lets the arena serve every request from
+%      a single segment.
+%
+*/
+MagickExport MemoryArena *AcquireMemoryArena(const size_t extent)
+{
+  MemoryArena
+    *arena;
+
+  arena=(MemoryArena *) AcquireMagickMemory(sizeof(*arena));
+  if (arena == (MemoryArena *) NULL)
+    ThrowFatalException(ResourceLimitFatalError,"MemoryAllocationFailed");
+  (void) ResetMagickMemory(arena,0,sizeof(*arena));
+  arena->extent=extent > ArenaExtent ? extent : ArenaExtent;
+  arena->signature=MagickSignature;
+  if (statistics_semaphore == (SemaphoreInfo *) NULL)
+    AcquireSemaphoreInfo(&statistics_semaphore);
+  (void) LockSemaphoreInfo(statistics_semaphore);
+  memory_statistics.arenas++;
+  memory_statistics.active_arenas++;
+  (void) UnlockSemaphoreInfo(statistics_semaphore);
+  return(arena);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
 %   A c q u i r e Q u a n t u m M e m o r y                                   %
 %                                                                             %
 %                                                                             %
@@ -552,6 +866,22 @@ MagickExport void DestroyMagickMemory(void)
     AcquireSemaphoreInfo(&memory_semaphore);
   (void) LockSemaphoreInfo(memory_semaphore);
   (void) UnlockSemaphoreInfo(memory_semaphore);
+#if defined(MAGICKCORE_HAVE_PTHREAD)
+  if (memory_cache_support != MagickFalse)
+    {
+      MemoryCacheInfo
+        *cache_info;
+
+      /*
+        Thread caches point into the heap; forget them with it.
+      */
+      cache_info=(MemoryCacheInfo *) pthread_getspecific(memory_cache_key);
+      if (cache_info != (MemoryCacheInfo *) NULL)
+        memory_methods.destroy_memory_handler(cache_info);
+      (void) pthread_key_delete(memory_cache_key);
+      memory_cache_support=MagickFalse;
+    }
+#endif
   for (i=0; i < (long) memory_info.number_segments; i++)
     if (memory_info.segments[i]->mapped == MagickFalse)
       memory_methods.destroy_memory_handler(
@@ -561,8 +891,12 @@ MagickExport void DestroyMagickMemory(void)
         memory_info.segments[i]->length);
   free_segments=(DataSegmentInfo *) NULL;
   (void) ResetMagickMemory(&memory_info,0,sizeof(memory_info));
+  memory_statistics.cache_hits=0;
+  memory_statistics.cache_misses=0;
   DestroySemaphoreInfo(&memory_semaphore);
 #endif
+  if (statistics_semaphore != (SemaphoreInfo *) NULL)
+    DestroySemaphoreInfo(&statistics_semaphore);
 }
 
 #if defined(MAGICKCORE_EMBEDDABLE_SUPPORT)
@@ -688,6 +1022,63 @@ MagickExport void GetMagickMemoryMethods(
 %                                                                             %
 %                                                                             %
 %                                                                             %
++   G e t M a g i c k M e m o r y S t a t i s t i c s                         %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  GetMagickMemoryStatistics() returns a snapshot of the memory manager
+%  statistics: arena usage and, in embeddable builds, the heap extent and how
+%  often small allocations were served from the per-thread caches.  Cache
+%  counts of other threads are folded in whenever those threads take the heap
+%  lock, so they may lag slightly.
+%
+%  The format of the GetMagickMemoryStatistics method is:
+%
+%      void GetMagickMemoryStatistics(MemoryStatistics *statistics)
+%
+%  A description of each parameter follows:
+%
+%    o statistics: return the memory statistics here.
+%
+*/
+MagickExport void GetMagickMemoryStatistics(MemoryStatistics *statistics)
+{
+  assert(statistics != (MemoryStatistics *) NULL);
+  if (statistics_semaphore == (SemaphoreInfo *) NULL)
+    AcquireSemaphoreInfo(&statistics_semaphore);
+  (void) LockSemaphoreInfo(statistics_semaphore);
+  *statistics=memory_statistics;
+  (void) UnlockSemaphoreInfo(statistics_semaphore);
+#if defined(MAGICKCORE_EMBEDDABLE_SUPPORT)
+  if (free_segments != (DataSegmentInfo *) NULL)
+    {
+      MemoryCacheInfo
+        *cache_info;
+
+      register long
+        i;
+
+      cache_info=GetMemoryCache();
+      (void) LockSemaphoreInfo(memory_semaphore);
+      FlushMemoryCacheStatistics(cache_info);
+      statistics->cache_hits=memory_statistics.cache_hits;
+      statistics->cache_misses=memory_statistics.cache_misses;
+      statistics->heap_segments=(MagickSizeType) memory_info.number_segments;
+      statistics->heap_extent=0;
+      for (i=0; i < (long) memory_info.number_segments; i++)
+        statistics->heap_extent+=memory_info.segments[i]->length;
+      (void) UnlockSemaphoreInfo(memory_semaphore);
+    }
+#endif
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
 %   R e l i n q u i s h A l i g n e d M e m o r y                             %
 %                                                                             %
 %                                                                             %
@@ -737,16 +1128,15 @@ MagickExport void *RelinquishAlignedMemory(void *memory)
 %    o memory: A pointer to a block of memory to free for reuse.
 %
 */
-MagickExport void *RelinquishMagickMemory(void *memory)
+
+#if defined(MAGICKCORE_EMBEDDABLE_SUPPORT)
+static void RelinquishBlock(void *memory)
 {
-  if (memory == (void *) NULL)
-    return((void *) NULL);
-#if !defined(MAGICKCORE_EMBEDDABLE_SUPPORT)
-  memory_methods.destroy_memory_handler(memory);
-#else
+  /*
+    Caller holds the memory semaphore.
+  */
   assert((SizeOfBlock(memory) % (4*sizeof(size_t))) == 0);
   assert((*BlockHeader(NextBlock(memory)) & PreviousBlockBit) != 0);
-  (void) LockSemaphoreInfo(memory_semaphore);
   if ((*BlockHeader(memory) & PreviousBlockBit) == 0)
     {
       void
@@ -777,7 +1167,48 @@ MagickExport void *RelinquishMagickMemory(void *memory)
   *BlockFooter(memory,SizeOfBlock(memory))=SizeOfBlock(memory);
   *BlockHeader(NextBlock(memory))&=(~PreviousBlockBit);
   InsertFreeBlock(memory,AllocationPolicy(SizeOfBlock(memory)));
-  (void) UnlockSemaphoreInfo(memory_semaphore);
+}
+#endif
+
+MagickExport void *RelinquishMagickMemory(void *memory)
+{
+  if (memory == (void *) NULL)
+    return((void *) NULL);
+#if !defined(MAGICKCORE_EMBEDDABLE_SUPPORT)
+  memory_methods.destroy_memory_handler(memory);
+#else
+  {
+    MemoryCacheInfo
+      *cache_info;
+
+    assert((SizeOfBlock(memory) % (4*sizeof(size_t))) == 0);
+    cache_info=(MemoryCacheInfo *) NULL;
+    if (SizeOfBlock(memory) <= BlockThreshold)
+      {
+        cache_info=GetMemoryCache();
+        if (cache_info != (MemoryCacheInfo *) NULL)
+          {
+            register size_t
+              i;
+
+            /*
+              Keep the block, still marked in use, in the thread cache.
+            */
+            i=SizeOfBlock(memory)/(4*sizeof(size_t));
+            if (cache_info->number_blocks[i] < MaxCacheBlocks)
+              {
+                NextBlockInList(memory)=cache_info->blocks[i];
+                cache_info->blocks[i]=memory;
+                cache_info->number_blocks[i]++;
+                return((void *) NULL);
+              }
+          }
+      }
+    (void) LockSemaphoreInfo(memory_semaphore);
+    FlushMemoryCacheStatistics(cache_info);
+    RelinquishBlock(memory);
+    (void) UnlockSemaphoreInfo(memory_semaphore);
+  }
 #endif
   return((void *) NULL);
 }
@@ -787,6 +1218,58 @@ MagickExport void *RelinquishMagickMemory(void *memory)
 %                                                                             %
 %                                                                             %
 %                                                                             %
+%   R e l i n q u i s h M e m o r y A r e n a                                 %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  RelinquishMemoryArena() frees the arena and every block acquired from it
+%  with AcquireArenaMemory().
+%
+%  The format of the RelinquishMemoryArena method is:
+%
+%      MemoryArena *RelinquishMemoryArena(MemoryArena *arena)
+%
+%  A description of each parameter follows:
+%
+%    o arena: the memory arena.
+%
+*/
+MagickExport MemoryArena *RelinquishMemoryArena(MemoryArena *arena)
+{
+  ArenaSegmentInfo
+    *segment;
+
+  MagickSizeType
+    extent;
+
+  assert(arena != (MemoryArena *) NULL);
+  assert(arena->signature == MagickSignature);
+  extent=0;
+  while (arena->segments != (ArenaSegmentInfo *) NULL)
+  {
+    segment=arena->segments;
+    arena->segments=segment->next;
+    extent+=segment->extent+AlignedSize;
+    segment=(ArenaSegmentInfo *) RelinquishAlignedMemory(segment);
+  }
+  if (statistics_semaphore == (SemaphoreInfo *) NULL)
+    AcquireSemaphoreInfo(&statistics_semaphore);
+  (void) LockSemaphoreInfo(statistics_semaphore);
+  memory_statistics.active_arenas--;
+  memory_statistics.arena_extent-=extent;
+  (void) UnlockSemaphoreInfo(statistics_semaphore);
+  arena->signature=(~MagickSignature);
+  arena=(MemoryArena *) RelinquishMagickMemory(arena);
+  return(arena);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
 %   R e s e t M a g i c k M e m o r y                                         %
 %                                                                             %
 %                                                                             %
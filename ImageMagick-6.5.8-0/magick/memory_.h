@@ -22,13 +22,22 @@
 extern "C" {
 #endif
 
+typedef struct _MemoryArena
+  MemoryArena;
+
 typedef void
   *(*AcquireMemoryHandler)(size_t),
   (*DestroyMemoryHandler)(void *),
   *(*ResizeMemoryHandler)(void *,size_t);
 
+extern MagickExport MemoryArena
+  *AcquireMemoryArena(const size_t),
+  *RelinquishMemoryArena(MemoryArena *);
+
 extern MagickExport void
   *AcquireAlignedMemory(const size_t,const size_t) magick_attribute((malloc)),
+  *AcquireArenaMemory(MemoryArena *,const size_t,const size_t)
+    magick_attribute((malloc)),
   *AcquireMagickMemory(const size_t) magick_attribute((malloc)),
   *AcquireQuantumMemory(const size_t,const size_t) magick_attribute((malloc)),
   *CopyMagickMemory(void *,const void *,const size_t)
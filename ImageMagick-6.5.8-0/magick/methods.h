@@ -34,13 +34,27 @@ extern "C" {
 #define PrescanMagickPrefix(prefix,method)  prefix(method)
 #endif
 #define EvaluateMagickPrefix(prefix,method)  PrescanMagickPrefix(prefix,method)
+#define AcquireOperationInfo  PrependMagickMethod(AcquireOperationInfo)
+#define AppendCropOperation  PrependMagickMethod(AppendCropOperation)
+#define AppendGammaOperation  PrependMagickMethod(AppendGammaOperation)
+#define AppendLevelOperation  PrependMagickMethod(AppendLevelOperation)
+#define AppendNegateOperation  PrependMagickMethod(AppendNegateOperation)
+#define AppendResizeOperation  PrependMagickMethod(AppendResizeOperation)
+#define AppendSharpenOperation  PrependMagickMethod(AppendSharpenOperation)
+#define ApplyImageOperations  PrependMagickMethod(ApplyImageOperations)
+#define CloneOperationInfo  PrependMagickMethod(CloneOperationInfo)
+#define DestroyOperationInfo  PrependMagickMethod(DestroyOperationInfo)
+#define GetImageOperationsSize  PrependMagickMethod(GetImageOperationsSize)
+#define GetNumberOfOperations  PrependMagickMethod(GetNumberOfOperations)
 #define PrependMagickMethod(method) \
   EvaluateMagickPrefix(MAGICKCORE_NAMESPACE_PREFIX,method)
 
 #define AcquireAlignedMemory  PrependMagickMethod(AcquireAlignedMemory)
+#define AcquireArenaMemory  PrependMagickMethod(AcquireArenaMemory)
 #define AcquireCacheViewIndexes  PrependMagickMethod(AcquireCacheViewIndexes)
 #define AcquireCacheViewPixels  PrependMagickMethod(AcquireCacheViewPixels)
 #define AcquireCacheView  PrependMagickMethod(AcquireCacheView)
+#define AcquireDisplayList  PrependMagickMethod(AcquireDisplayList)
 #define AcquireDrawInfo  PrependMagickMethod(AcquireDrawInfo)
 #define AcquireExceptionInfo  PrependMagickMethod(AcquireExceptionInfo)
 #define AcquireFxInfo  PrependMagickMethod(AcquireFxInfo)
@@ -53,6 +67,7 @@ extern "C" {
 #define AcquireMagickMemory  PrependMagickMethod(AcquireMagickMemory)
 #define AcquireMagickResource  PrependMagickMethod(AcquireMagickResource)
 #define AcquireMemory  PrependMagickMethod(AcquireMemory)
+#define AcquireMemoryArena  PrependMagickMethod(AcquireMemoryArena)
 #define AcquireNextImage  PrependMagickMethod(AcquireNextImage)
 #define AcquireOneCacheViewPixel  PrependMagickMethod(AcquireOneCacheViewPixel)
 #define AcquireOneCacheViewVirtualPixel  PrependMagickMethod(AcquireOneCacheViewVirtualPixel)
@@ -61,6 +76,7 @@ extern "C" {
 #define AcquireOneVirtualPixel  PrependMagickMethod(AcquireOneVirtualPixel)
 #define AcquirePixelCacheNexus  PrependMagickMethod(AcquirePixelCacheNexus)
 #define AcquirePixelCache  PrependMagickMethod(AcquirePixelCache)
+#define AcquirePixelFormatInfo  PrependMagickMethod(AcquirePixelFormatInfo)
 #define AcquirePixels  PrependMagickMethod(AcquirePixels)
 #define AcquireQuantizeInfo  PrependMagickMethod(AcquireQuantizeInfo)
 #define AcquireQuantumInfo  PrependMagickMethod(AcquireQuantumInfo)
@@ -68,6 +84,8 @@ extern "C" {
 #define AcquireRandomInfo  PrependMagickMethod(AcquireRandomInfo)
 #define AcquireResampleFilter  PrependMagickMethod(AcquireResampleFilter)
 #define AcquireResizeFilter  PrependMagickMethod(AcquireResizeFilter)
+#define AcquireResourceContext  PrependMagickMethod(AcquireResourceContext)
+#define AcquireResourceContextResource  PrependMagickMethod(AcquireResourceContextResource)
 #define AcquireSemaphoreInfo  PrependMagickMethod(AcquireSemaphoreInfo)
 #define AcquireSignatureInfo  PrependMagickMethod(AcquireSignatureInfo)
 #define AcquireStreamInfo  PrependMagickMethod(AcquireStreamInfo)
@@ -140,6 +158,7 @@ extern "C" {
 #define ClampImage  PrependMagickMethod(ClampImage)
 #define ClearLinkedList  PrependMagickMethod(ClearLinkedList)
 #define ClearMagickException  PrependMagickMethod(ClearMagickException)
+#define ClearStringMap  PrependMagickMethod(ClearStringMap)
 #define ClipImagePath  PrependMagickMethod(ClipImagePath)
 #define ClipImage  PrependMagickMethod(ClipImage)
 #define ClipPathImage  PrependMagickMethod(ClipPathImage)
@@ -163,6 +182,7 @@ extern "C" {
 #define CloneSplayTree  PrependMagickMethod(CloneSplayTree)
 #define CloneStringInfo  PrependMagickMethod(CloneStringInfo)
 #define CloneString  PrependMagickMethod(CloneString)
+#define CloneStringMap  PrependMagickMethod(CloneStringMap)
 #define CloseBlob  PrependMagickMethod(CloseBlob)
 #define CloseCacheView  PrependMagickMethod(CloseCacheView)
 #define CloseMagickLog  PrependMagickMethod(CloseMagickLog)
@@ -225,6 +245,7 @@ extern "C" {
 #define DefineImageRegistry  PrependMagickMethod(DefineImageRegistry)
 #define DelegateComponentGenesis  PrependMagickMethod(DelegateComponentGenesis)
 #define DelegateComponentTerminus  PrependMagickMethod(DelegateComponentTerminus)
+#define DeleteEntryFromStringMap  PrependMagickMethod(DeleteEntryFromStringMap)
 #define DeleteImageArtifact  PrependMagickMethod(DeleteImageArtifact)
 #define DeleteImageAttribute  PrependMagickMethod(DeleteImageAttribute)
 #define DeleteImageFromList  PrependMagickMethod(DeleteImageFromList)
@@ -243,6 +264,7 @@ extern "C" {
 #define DestroyBlob  PrependMagickMethod(DestroyBlob)
 #define DestroyCacheView  PrependMagickMethod(DestroyCacheView)
 #define DestroyConfigureOptions  PrependMagickMethod(DestroyConfigureOptions)
+#define DestroyDisplayList  PrependMagickMethod(DestroyDisplayList)
 #define DestroyDrawInfo  PrependMagickMethod(DestroyDrawInfo)
 #define DestroyExceptionInfo  PrependMagickMethod(DestroyExceptionInfo)
 #define DestroyFxInfo  PrependMagickMethod(DestroyFxInfo)
@@ -265,11 +287,13 @@ extern "C" {
 #define DestroyMontageInfo  PrependMagickMethod(DestroyMontageInfo)
 #define DestroyPixelCacheNexus  PrependMagickMethod(DestroyPixelCacheNexus)
 #define DestroyPixelCache  PrependMagickMethod(DestroyPixelCache)
+#define DestroyPixelFormatInfo  PrependMagickMethod(DestroyPixelFormatInfo)
 #define DestroyQuantizeInfo  PrependMagickMethod(DestroyQuantizeInfo)
 #define DestroyQuantumInfo  PrependMagickMethod(DestroyQuantumInfo)
 #define DestroyRandomInfo  PrependMagickMethod(DestroyRandomInfo)
 #define DestroyResampleFilter  PrependMagickMethod(DestroyResampleFilter)
 #define DestroyResizeFilter  PrependMagickMethod(DestroyResizeFilter)
+#define DestroyResourceContext  PrependMagickMethod(DestroyResourceContext)
 #define DestroySemaphoreInfo  PrependMagickMethod(DestroySemaphoreInfo)
 #define DestroySignatureInfo  PrependMagickMethod(DestroySignatureInfo)
 #define DestroySplayTree  PrependMagickMethod(DestroySplayTree)
@@ -277,6 +301,7 @@ extern "C" {
 #define DestroyStringInfo  PrependMagickMethod(DestroyStringInfo)
 #define DestroyStringList  PrependMagickMethod(DestroyStringList)
 #define DestroyString  PrependMagickMethod(DestroyString)
+#define DestroyStringMap  PrependMagickMethod(DestroyStringMap)
 #define DestroyThresholdMap  PrependMagickMethod(DestroyThresholdMap)
 #define DestroyTimerInfo  PrependMagickMethod(DestroyTimerInfo)
 #define DestroyTokenInfo  PrependMagickMethod(DestroyTokenInfo)
@@ -291,6 +316,9 @@ extern "C" {
 #define DistortImage  PrependMagickMethod(DistortImage)
 #define DrawAffineImage  PrependMagickMethod(DrawAffineImage)
 #define DrawClipPath  PrependMagickMethod(DrawClipPath)
+#define DrawComponentGenesis  PrependMagickMethod(DrawComponentGenesis)
+#define DrawComponentTerminus  PrependMagickMethod(DrawComponentTerminus)
+#define DrawDisplayList  PrependMagickMethod(DrawDisplayList)
 #define DrawGradientImage  PrependMagickMethod(DrawGradientImage)
 #define DrawImage  PrependMagickMethod(DrawImage)
 #define DrawPatternPath  PrependMagickMethod(DrawPatternPath)
@@ -310,7 +338,9 @@ extern "C" {
 #define ExpandAffine  PrependMagickMethod(ExpandAffine)
 #define ExpandFilename  PrependMagickMethod(ExpandFilename)
 #define ExpandFilenames  PrependMagickMethod(ExpandFilenames)
+#define ExportFormattedImagePixels  PrependMagickMethod(ExportFormattedImagePixels)
 #define ExportImagePixels  PrependMagickMethod(ExportImagePixels)
+#define ExportPixelFormatPackets  PrependMagickMethod(ExportPixelFormatPackets)
 #define ExportQuantumPixels  PrependMagickMethod(ExportQuantumPixels)
 #define ExtentImage  PrependMagickMethod(ExtentImage)
 #define ExtractSubimageFromImage  PrependMagickMethod(ExtractSubimageFromImage)
@@ -355,6 +385,8 @@ extern "C" {
 #define GetAffineMatrix  PrependMagickMethod(GetAffineMatrix)
 #define GetAuthenticIndexQueue  PrependMagickMethod(GetAuthenticIndexQueue)
 #define GetAuthenticPixelCacheNexus  PrependMagickMethod(GetAuthenticPixelCacheNexus)
+#define GetAuthenticPixelPlane  PrependMagickMethod(GetAuthenticPixelPlane)
+#define GetAuthenticPixelPlanes  PrependMagickMethod(GetAuthenticPixelPlanes)
 #define GetAuthenticPixelQueue  PrependMagickMethod(GetAuthenticPixelQueue)
 #define GetAuthenticPixels  PrependMagickMethod(GetAuthenticPixels)
 #define GetBlobError  PrependMagickMethod(GetBlobError)
@@ -485,6 +517,7 @@ extern "C" {
 #define GetMagickInfo  PrependMagickMethod(GetMagickInfo)
 #define GetMagickList  PrependMagickMethod(GetMagickList)
 #define GetMagickMemoryMethods  PrependMagickMethod(GetMagickMemoryMethods)
+#define GetMagickMemoryStatistics  PrependMagickMethod(GetMagickMemoryStatistics)
 #define GetMagickOptions  PrependMagickMethod(GetMagickOptions)
 #define GetMagickPackageName  PrependMagickMethod(GetMagickPackageName)
 #define GetMagickPageSize  PrependMagickMethod(GetMagickPageSize)
@@ -500,6 +533,7 @@ extern "C" {
 #define GetMagickSeekableStream  PrependMagickMethod(GetMagickSeekableStream)
 #define GetMagickThreadSupport  PrependMagickMethod(GetMagickThreadSupport)
 #define GetMagickToken  PrependMagickMethod(GetMagickToken)
+#define GetMagickTraceMask  PrependMagickMethod(GetMagickTraceMask)
 #define GetMagickVersion  PrependMagickMethod(GetMagickVersion)
 #define GetMagicList  PrependMagickMethod(GetMagicList)
 #define GetMagicName  PrependMagickMethod(GetMagicName)
@@ -521,13 +555,16 @@ extern "C" {
 #define GetNextImageRegistry  PrependMagickMethod(GetNextImageRegistry)
 #define GetNextKeyInHashmap  PrependMagickMethod(GetNextKeyInHashmap)
 #define GetNextKeyInSplayTree  PrependMagickMethod(GetNextKeyInSplayTree)
+#define GetNextKeyInStringMap  PrependMagickMethod(GetNextKeyInStringMap)
 #define GetNextValueInHashmap  PrependMagickMethod(GetNextValueInHashmap)
 #define GetNextValueInLinkedList  PrependMagickMethod(GetNextValueInLinkedList)
 #define GetNextValueInSplayTree  PrependMagickMethod(GetNextValueInSplayTree)
+#define GetNextValueInStringMap  PrependMagickMethod(GetNextValueInStringMap)
 #define GetNextXMLTreeTag  PrependMagickMethod(GetNextXMLTreeTag)
 #define GetNumberColors  PrependMagickMethod(GetNumberColors)
 #define GetNumberOfElementsInLinkedList  PrependMagickMethod(GetNumberOfElementsInLinkedList)
 #define GetNumberOfEntriesInHashmap  PrependMagickMethod(GetNumberOfEntriesInHashmap)
+#define GetNumberOfEntriesInStringMap  PrependMagickMethod(GetNumberOfEntriesInStringMap)
 #define GetNumberOfNodesInSplayTree  PrependMagickMethod(GetNumberOfNodesInSplayTree)
 #define GetNumberScenes  PrependMagickMethod(GetNumberScenes)
 #define GetOneAuthenticPixel  PrependMagickMethod(GetOneAuthenticPixel)
@@ -554,6 +591,7 @@ extern "C" {
 #define GetPixelCacheTileSize  PrependMagickMethod(GetPixelCacheTileSize)
 #define GetPixelCacheType  PrependMagickMethod(GetPixelCacheType)
 #define GetPixelCacheVirtualMethod  PrependMagickMethod(GetPixelCacheVirtualMethod)
+#define GetPixelFormatExtent  PrependMagickMethod(GetPixelFormatExtent)
 #define GetPixels  PrependMagickMethod(GetPixels)
 #define GetPolicyInfoList  PrependMagickMethod(GetPolicyInfoList)
 #define GetPolicyList  PrependMagickMethod(GetPolicyList)
@@ -570,6 +608,8 @@ extern "C" {
 #define GetRandomValue  PrependMagickMethod(GetRandomValue)
 #define GetResizeFilterSupport  PrependMagickMethod(GetResizeFilterSupport)
 #define GetResizeFilterWeight  PrependMagickMethod(GetResizeFilterWeight)
+#define GetResourceContextLimit  PrependMagickMethod(GetResourceContextLimit)
+#define GetResourceContextResource  PrependMagickMethod(GetResourceContextResource)
 #define GetSignatureBlocksize  PrependMagickMethod(GetSignatureBlocksize)
 #define GetSignatureDigest  PrependMagickMethod(GetSignatureDigest)
 #define GetSignatureDigestsize  PrependMagickMethod(GetSignatureDigestsize)
@@ -577,6 +617,7 @@ extern "C" {
 #define GetStringInfoDatum  PrependMagickMethod(GetStringInfoDatum)
 #define GetStringInfoLength  PrependMagickMethod(GetStringInfoLength)
 #define GetStringInfoPath  PrependMagickMethod(GetStringInfoPath)
+#define GetThreadResourceContext  PrependMagickMethod(GetThreadResourceContext)
 #define GetThresholdMapFile  PrependMagickMethod(GetThresholdMapFile)
 #define GetThresholdMap  PrependMagickMethod(GetThresholdMap)
 #define GetTimerInfo  PrependMagickMethod(GetTimerInfo)
@@ -589,8 +630,10 @@ extern "C" {
 #define GetValueFromHashmap  PrependMagickMethod(GetValueFromHashmap)
 #define GetValueFromLinkedList  PrependMagickMethod(GetValueFromLinkedList)
 #define GetValueFromSplayTree  PrependMagickMethod(GetValueFromSplayTree)
+#define GetValueFromStringMap  PrependMagickMethod(GetValueFromStringMap)
 #define GetVirtualIndexesFromNexus  PrependMagickMethod(GetVirtualIndexesFromNexus)
 #define GetVirtualIndexQueue  PrependMagickMethod(GetVirtualIndexQueue)
+#define GetVirtualPixelPlane  PrependMagickMethod(GetVirtualPixelPlane)
 #define GetVirtualPixelQueue  PrependMagickMethod(GetVirtualPixelQueue)
 #define GetVirtualPixelsFromNexus  PrependMagickMethod(GetVirtualPixelsFromNexus)
 #define GetVirtualPixelsNexus  PrependMagickMethod(GetVirtualPixelsNexus)
@@ -622,7 +665,9 @@ extern "C" {
 #define ImageToBlob  PrependMagickMethod(ImageToBlob)
 #define ImageToFile  PrependMagickMethod(ImageToFile)
 #define ImplodeImage  PrependMagickMethod(ImplodeImage)
+#define ImportFormattedImagePixels  PrependMagickMethod(ImportFormattedImagePixels)
 #define ImportImagePixels  PrependMagickMethod(ImportImagePixels)
+#define ImportPixelFormatPackets  PrependMagickMethod(ImportPixelFormatPackets)
 #define ImportQuantumPixels  PrependMagickMethod(ImportQuantumPixels)
 #define increase  PrependMagickMethod(increase)
 #define InheritException  PrependMagickMethod(InheritException)
@@ -644,6 +689,7 @@ extern "C" {
 #define IsBlobSeekable  PrependMagickMethod(IsBlobSeekable)
 #define IsBlobTemporary  PrependMagickMethod(IsBlobTemporary)
 #define IsColorSimilar  PrependMagickMethod(IsColorSimilar)
+#define IsEventLogged  PrependMagickMethod(IsEventLogged)
 #define IsEventLogging  PrependMagickMethod(IsEventLogging)
 #define IsGeometry  PrependMagickMethod(IsGeometry)
 #define IsGlob  PrependMagickMethod(IsGlob)
@@ -659,6 +705,7 @@ extern "C" {
 #define IsMagickConflict  PrependMagickMethod(IsMagickConflict)
 #define IsMagickInstantiated  PrependMagickMethod(IsMagickInstantiated)
 #define IsMagickOption  PrependMagickMethod(IsMagickOption)
+#define IsMagickTraceEnabled  PrependMagickMethod(IsMagickTraceEnabled)
 #define IsMagickTrue  PrependMagickMethod(IsMagickTrue)
 #define IsMonochromeImage  PrependMagickMethod(IsMonochromeImage)
 #define IsOpacitySimilar  PrependMagickMethod(IsOpacitySimilar)
@@ -759,6 +806,7 @@ extern "C" {
 #define NewLinkedList  PrependMagickMethod(NewLinkedList)
 #define NewMagickImage  PrependMagickMethod(NewMagickImage)
 #define NewSplayTree  PrependMagickMethod(NewSplayTree)
+#define NewStringMap  PrependMagickMethod(NewStringMap)
 #define NewXMLTree  PrependMagickMethod(NewXMLTree)
 #define NewXMLTreeTag  PrependMagickMethod(NewXMLTreeTag)
 #define NormalizeImageChannel  PrependMagickMethod(NormalizeImageChannel)
@@ -818,6 +866,7 @@ extern "C" {
 #define PushImageList  PrependMagickMethod(PushImageList)
 #define PushImagePixels  PrependMagickMethod(PushImagePixels)
 #define PutEntryInHashmap  PrependMagickMethod(PutEntryInHashmap)
+#define PutEntryInStringMap  PrependMagickMethod(PutEntryInStringMap)
 #define QuantizationError  PrependMagickMethod(QuantizationError)
 #define QuantizeImage  PrependMagickMethod(QuantizeImage)
 #define QuantizeImages  PrependMagickMethod(QuantizeImages)
@@ -858,6 +907,7 @@ extern "C" {
 #define ReferenceBlob  PrependMagickMethod(ReferenceBlob)
 #define ReferenceImage  PrependMagickMethod(ReferenceImage)
 #define ReferencePixelCache  PrependMagickMethod(ReferencePixelCache)
+#define ReferenceResourceContext  PrependMagickMethod(ReferenceResourceContext)
 #define RegisterARTImage  PrependMagickMethod(RegisterARTImage)
 #define RegisterAVSImage  PrependMagickMethod(RegisterAVSImage)
 #define RegisterBMPImage  PrependMagickMethod(RegisterBMPImage)
@@ -935,6 +985,7 @@ extern "C" {
 #define RegisterSCTImage  PrependMagickMethod(RegisterSCTImage)
 #define RegisterSFWImage  PrependMagickMethod(RegisterSFWImage)
 #define RegisterSGIImage  PrependMagickMethod(RegisterSGIImage)
+#define RegisterStaticModule  PrependMagickMethod(RegisterStaticModule)
 #define RegisterStaticModules  PrependMagickMethod(RegisterStaticModules)
 #define RegisterSTEGANOImage  PrependMagickMethod(RegisterSTEGANOImage)
 #define RegisterSUNImage  PrependMagickMethod(RegisterSUNImage)
@@ -969,6 +1020,8 @@ extern "C" {
 #define RelinquishMagickMatrix  PrependMagickMethod(RelinquishMagickMatrix)
 #define RelinquishMagickMemory  PrependMagickMethod(RelinquishMagickMemory)
 #define RelinquishMagickResource  PrependMagickMethod(RelinquishMagickResource)
+#define RelinquishMemoryArena  PrependMagickMethod(RelinquishMemoryArena)
+#define RelinquishResourceContextResource  PrependMagickMethod(RelinquishResourceContextResource)
 #define RelinquishSemaphoreInfo  PrependMagickMethod(RelinquishSemaphoreInfo)
 #define RelinquishUniqueFileResource  PrependMagickMethod(RelinquishUniqueFileResource)
 #define RemapImage  PrependMagickMethod(RemapImage)
@@ -978,6 +1031,7 @@ extern "C" {
 #define RemoveElementByValueFromLinkedList  PrependMagickMethod(RemoveElementByValueFromLinkedList)
 #define RemoveElementFromLinkedList  PrependMagickMethod(RemoveElementFromLinkedList)
 #define RemoveEntryFromHashmap  PrependMagickMethod(RemoveEntryFromHashmap)
+#define RemoveEntryFromStringMap  PrependMagickMethod(RemoveEntryFromStringMap)
 #define RemoveFirstImageFromList  PrependMagickMethod(RemoveFirstImageFromList)
 #define RemoveImageArtifact  PrependMagickMethod(RemoveImageArtifact)
 #define RemoveImageFromList  PrependMagickMethod(RemoveImageFromList)
@@ -1004,9 +1058,12 @@ extern "C" {
 #define ResetImageRegistryIterator  PrependMagickMethod(ResetImageRegistryIterator)
 #define ResetLinkedListIterator  PrependMagickMethod(ResetLinkedListIterator)
 #define ResetMagickMemory  PrependMagickMethod(ResetMagickMemory)
+#define ResetMagickTrace  PrependMagickMethod(ResetMagickTrace)
+#define ResetOperationInfo  PrependMagickMethod(ResetOperationInfo)
 #define ResetSplayTreeIterator  PrependMagickMethod(ResetSplayTreeIterator)
 #define ResetSplayTree  PrependMagickMethod(ResetSplayTree)
 #define ResetStringInfo  PrependMagickMethod(ResetStringInfo)
+#define ResetStringMapIterator  PrependMagickMethod(ResetStringMapIterator)
 #define ResetTimer  PrependMagickMethod(ResetTimer)
 #define ResizeImage  PrependMagickMethod(ResizeImage)
 #define ResizeMagickMemory  PrependMagickMethod(ResizeMagickMemory)
@@ -1077,8 +1134,10 @@ extern "C" {
 #define SetMagickMemoryMethods  PrependMagickMethod(SetMagickMemoryMethods)
 #define SetMagickRegistry  PrependMagickMethod(SetMagickRegistry)
 #define SetMagickResourceLimit  PrependMagickMethod(SetMagickResourceLimit)
+#define SetMagickTraceMask  PrependMagickMethod(SetMagickTraceMask)
 #define SetMonitorHandler  PrependMagickMethod(SetMonitorHandler)
 #define SetPixelCacheMethods  PrependMagickMethod(SetPixelCacheMethods)
+#define SetPixelCacheResourceContext  PrependMagickMethod(SetPixelCacheResourceContext)
 #define SetPixelCacheVirtualMethod  PrependMagickMethod(SetPixelCacheVirtualMethod)
 #define SetQuantumAlphaType  PrependMagickMethod(SetQuantumAlphaType)
 #define SetQuantumDepth  PrependMagickMethod(SetQuantumDepth)
@@ -1095,6 +1154,7 @@ extern "C" {
 #define SetResampleFilter  PrependMagickMethod(SetResampleFilter)
 #define SetResampleFilterVirtualPixelMethod  PrependMagickMethod(SetResampleFilterVirtualPixelMethod)
 #define SetResizeFilterSupport  PrependMagickMethod(SetResizeFilterSupport)
+#define SetResourceContextLimit  PrependMagickMethod(SetResourceContextLimit)
 #define SetSignatureDigest  PrependMagickMethod(SetSignatureDigest)
 #define SetStreamInfoClientData  PrependMagickMethod(SetStreamInfoClientData)
 #define SetStreamInfoMap  PrependMagickMethod(SetStreamInfoMap)
@@ -1103,6 +1163,7 @@ extern "C" {
 #define SetStringInfoLength  PrependMagickMethod(SetStringInfoLength)
 #define SetStringInfoPath  PrependMagickMethod(SetStringInfoPath)
 #define SetStringInfo  PrependMagickMethod(SetStringInfo)
+#define SetThreadResourceContext  PrependMagickMethod(SetThreadResourceContext)
 #define SetWarningHandler  PrependMagickMethod(SetWarningHandler)
 #define SetXMLTreeAttribute  PrependMagickMethod(SetXMLTreeAttribute)
 #define SetXMLTreeContent  PrependMagickMethod(SetXMLTreeContent)
@@ -1133,6 +1194,7 @@ extern "C" {
 #define StereoAnaglyphImage  PrependMagickMethod(StereoAnaglyphImage)
 #define StereoImage  PrependMagickMethod(StereoImage)
 #define StreamImage  PrependMagickMethod(StreamImage)
+#define StreamResizeImage  PrependMagickMethod(StreamResizeImage)
 #define StringInfoToHexString  PrependMagickMethod(StringInfoToHexString)
 #define StringInfoToString  PrependMagickMethod(StringInfoToString)
 #define StringToArgv  PrependMagickMethod(StringToArgv)
@@ -1167,6 +1229,9 @@ extern "C" {
 #define ThumbnailImage  PrependMagickMethod(ThumbnailImage)
 #define TintImage  PrependMagickMethod(TintImage)
 #define Tokenizer  PrependMagickMethod(Tokenizer)
+#define TraceComponentGenesis  PrependMagickMethod(TraceComponentGenesis)
+#define TraceComponentTerminus  PrependMagickMethod(TraceComponentTerminus)
+#define TraceMagickEvent  PrependMagickMethod(TraceMagickEvent)
 #define TransformColorspace  PrependMagickMethod(TransformColorspace)
 #define TransformHSL  PrependMagickMethod(TransformHSL)
 #define TransformImageColorspace  PrependMagickMethod(TransformImageColorspace)
@@ -1311,6 +1376,7 @@ extern "C" {
 #define WriteBlobString  PrependMagickMethod(WriteBlobString)
 #define WriteImage  PrependMagickMethod(WriteImage)
 #define WriteImages  PrependMagickMethod(WriteImages)
+#define WriteMagickTrace  PrependMagickMethod(WriteMagickTrace)
 #define WriteStream  PrependMagickMethod(WriteStream)
 #define XAnimateBackgroundImage  PrependMagickMethod(XAnimateBackgroundImage)
 #define XAnimateImages  PrependMagickMethod(XAnimateImages)
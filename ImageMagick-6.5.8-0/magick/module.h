@@ -79,7 +79,8 @@ extern MagickExport MagickBooleanType
   ListModuleInfo(FILE *,ExceptionInfo *),
   ModuleComponentGenesis(void),
   OpenModule(const char *,ExceptionInfo *),
-  OpenModules(ExceptionInfo *);
+  OpenModules(ExceptionInfo *),
+  RegisterStaticModule(const char *);
 
 extern MagickExport ModuleInfo
   *GetModuleInfo(const char *,ExceptionInfo *);
@@ -0,0 +1,1581 @@
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%         OOO   PPPP   EEEEE  RRRR    AAA   TTTTT  IIIII   OOO   N   N        %
+%        O   O  P   P  E      R   R  A   A    T      I    O   O  NN  N        %
+%        O   O  PPPP   EEE    RRRR   AAAAA    T      I    O   O  N N N        %
+%        O   O  P      E      R R    A   A    T      I    O   O  N  NN        %
+%         OOO   P      EEEEE  R  R   A   A    T    IIIII   OOO   N   N        %
+%                                                                             %
+%                                                                             %
+%                    MagickCore Deferred Image Operations                     %
+%                                                                             %
+%                              Software Design                                %
+%                                John Cristy                                  %
+%                               November 2009                                 %
+%                                                                             %
+%                                                                             %
+%  Copyright 1999-2009 ImageMagick Studio LLC, a non-profit organization      %
+%  dedicated to making software imaging solutions freely available.           %
+%                                                                             %
+%  You may not use this file except in compliance with the License.  You may  %
+%  obtain a copy of the License at                                            %
+%                                                                             %
+%    http://www.imagemagick.org/script/license.php                            %
+%                                                                             %
+%  Unless required by applicable law or agreed to in writing, software        %
+%  distributed under the License is distributed on an "AS IS" BASIS,          %
+%  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   %
+%  See the License for the specific language governing permissions and        %
+%  limitations under the License.                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  This module records image operations instead of running them, so that a
+%  chain such as crop, resize, sharpen, and level can be rearranged before any
+%  pixels are touched.  When the operations are applied, crops move ahead of
+%  the point operations, sharpens, and resizes that precede them (enlarged by
+%  the kernel or filter support so the result is unchanged), adjacent crops
+%  are merged, a resize is merged into the one before it when it is no larger
+%  in either dimension, and each run of gamma, level, and negate operations is
+%  tabulated once and applied in a single pass.  At most two images are alive
+%  at any point of the chain.
+%
+%  Every rewrite except the merging of resizes reproduces the pixels of the
+%  immediate operations; a merged resize samples the source once rather than
+%  twice, so it is sharper than the two resizes it replaces.  A reduction
+%  followed by an enlargement is never merged, since it would skip the loss
+%  of detail the reduction causes.
+%
+*/
+
+/*
+  Include declarations.
+*/
+#include "magick/studio.h"
+#include "magick/cache.h"
+#include "magick/cache-view.h"
+#include "magick/colorspace.h"
+#include "magick/effect.h"
+#include "magick/enhance.h"
+#include "magick/exception.h"
+#include "magick/exception-private.h"
+#include "magick/gem.h"
+#include "magick/image.h"
+#include "magick/image-private.h"
+#include "magick/log.h"
+#include "magick/memory_.h"
+#include "magick/monitor.h"
+#include "magick/monitor-private.h"
+#include "magick/operation.h"
+#include "magick/quantum-private.h"
+#include "magick/resize.h"
+#include "magick/resize-private.h"
+#include "magick/thread-private.h"
+#include "magick/transform.h"
+
+/*
+  Define declarations.
+*/
+#define MinimumOperationExtent  8UL
+#define OperationCropBenefit  0.75
+
+/*
+  Typedef declarations.
+*/
+typedef enum
+{
+  UndefinedOperation,
+  CropOperation,
+  GammaOperation,
+  LevelOperation,
+  NegateOperation,
+  ResizeOperation,
+  SharpenOperation
+} OperationType;
+
+typedef struct _OperationNode
+{
+  OperationType
+    type;
+
+  ChannelType
+    channel;
+
+  RectangleInfo
+    geometry,
+    region;
+
+  FilterTypes
+    filter;
+
+  double
+    parameters[3];
+
+  MagickBooleanType
+    grayscale,
+    fixed;
+} OperationNode;
+
+struct _OperationInfo
+{
+  OperationNode
+    *nodes;
+
+  unsigned long
+    number_nodes,
+    extent;
+
+  MagickBooleanType
+    debug;
+
+  unsigned long
+    signature;
+};
+
+typedef struct _StageInfo
+{
+  unsigned long
+    columns,
+    rows;
+
+  RectangleInfo
+    page,
+    tile_offset;
+} StageInfo;
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   A c q u i r e O p e r a t i o n I n f o                                   %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  AcquireOperationInfo() returns an empty list of deferred image operations.
+%
+%  The format of the AcquireOperationInfo method is:
+%
+%      OperationInfo *AcquireOperationInfo(void)
+%
+*/
+MagickExport OperationInfo *AcquireOperationInfo(void)
+{
+  OperationInfo
+    *operation_info;
+
+  operation_info=(OperationInfo *) AcquireMagickMemory(
+    sizeof(*operation_info));
+  if (operation_info == (OperationInfo *) NULL)
+    ThrowFatalException(ResourceLimitFatalError,"MemoryAllocationFailed");
+  (void) ResetMagickMemory(operation_info,0,sizeof(*operation_info));
+  operation_info->debug=IsEventLogging();
+  operation_info->signature=MagickSignature;
+  return(operation_info);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   A p p e n d C r o p O p e r a t i o n                                     %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  AppendCropOperation() records a crop.  The geometry has the meaning it has
+%  for CropImage(): it is relative to the virtual canvas of the image the crop
+%  receives.
+%
+%  The format of the AppendCropOperation method is:
+%
+%      MagickBooleanType AppendCropOperation(OperationInfo *operation_info,
+%        const RectangleInfo *geometry)
+%
+%  A description of each parameter follows:
+%
+%    o operation_info: the operation list.
+%
+%    o geometry: the region to crop.
+%
+*/
+
+static inline double MagickMax(const double x,const double y)
+{
+  if (x > y)
+    return(x);
+  return(y);
+}
+
+static inline double MagickMin(const double x,const double y)
+{
+  if (x < y)
+    return(x);
+  return(y);
+}
+
+static OperationNode *AppendOperationNode(OperationInfo *operation_info,
+  const OperationType type)
+{
+  OperationNode
+    *node;
+
+  assert(operation_info != (OperationInfo *) NULL);
+  assert(operation_info->signature == MagickSignature);
+  if (operation_info->number_nodes >= operation_info->extent)
+    {
+      unsigned long
+        extent;
+
+      extent=(unsigned long) MagickMax(2.0*operation_info->extent,(double)
+        MinimumOperationExtent);
+      node=(OperationNode *) ResizeQuantumMemory(operation_info->nodes,
+        (size_t) extent,sizeof(*node));
+      if (node == (OperationNode *) NULL)
+        return((OperationNode *) NULL);
+      operation_info->nodes=node;
+      operation_info->extent=extent;
+    }
+  node=operation_info->nodes+operation_info->number_nodes++;
+  (void) ResetMagickMemory(node,0,sizeof(*node));
+  node->type=type;
+  node->channel=DefaultChannels;
+  return(node);
+}
+
+MagickExport MagickBooleanType AppendCropOperation(
+  OperationInfo *operation_info,const RectangleInfo *geometry)
+{
+  OperationNode
+    *node;
+
+  assert(geometry != (const RectangleInfo *) NULL);
+  node=AppendOperationNode(operation_info,CropOperation);
+  if (node == (OperationNode *) NULL)
+    return(MagickFalse);
+  node->geometry=(*geometry);
+  return(MagickTrue);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   A p p e n d G a m m a O p e r a t i o n                                   %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  AppendGammaOperation() records a gamma correction, as GammaImageChannel()
+%  performs it.
+%
+%  The format of the AppendGammaOperation method is:
+%
+%      MagickBooleanType AppendGammaOperation(OperationInfo *operation_info,
+%        const ChannelType channel,const double gamma)
+%
+%  A description of each parameter follows:
+%
+%    o operation_info: the operation list.
+%
+%    o channel: the channel.
+%
+%    o gamma: the image gamma.
+%
+*/
+MagickExport MagickBooleanType AppendGammaOperation(
+  OperationInfo *operation_info,const ChannelType channel,const double gamma)
+{
+  OperationNode
+    *node;
+
+  node=AppendOperationNode(operation_info,GammaOperation);
+  if (node == (OperationNode *) NULL)
+    return(MagickFalse);
+  node->channel=channel;
+  node->parameters[0]=gamma;
+  return(MagickTrue);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   A p p e n d L e v e l O p e r a t i o n                                   %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  AppendLevelOperation() records a level adjustment, as LevelImageChannel()
+%  performs it.
+%
+%  The format of the AppendLevelOperation method is:
+%
+%      MagickBooleanType AppendLevelOperation(OperationInfo *operation_info,
+%        const ChannelType channel,const double black_point,
+%        const double white_point,const double gamma)
+%
+%  A description of each parameter follows:
+%
+%    o operation_info: the operation list.
+%
+%    o channel: the channel.
+%
+%    o black_point: the level to map zero (black) to.
+%
+%    o white_point: the level to map QuantumRange (white) to.
+%
+%    o gamma: adjust gamma by this factor before mapping values.
+%
+*/
+MagickExport MagickBooleanType AppendLevelOperation(
+  OperationInfo *operation_info,const ChannelType channel,
+  const double black_point,const double white_point,const double gamma)
+{
+  OperationNode
+    *node;
+
+  node=AppendOperationNode(operation_info,LevelOperation);
+  if (node == (OperationNode *) NULL)
+    return(MagickFalse);
+  node->channel=channel;
+  node->parameters[0]=black_point;
+  node->parameters[1]=white_point;
+  node->parameters[2]=gamma;
+  return(MagickTrue);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   A p p e n d N e g a t e O p e r a t i o n                                 %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  AppendNegateOperation() records a negation, as NegateImageChannel()
+%  performs it.
+%
+%  The format of the AppendNegateOperation method is:
+%
+%      MagickBooleanType AppendNegateOperation(OperationInfo *operation_info,
+%        const ChannelType channel,const MagickBooleanType grayscale)
+%
+%  A description of each parameter follows:
+%
+%    o operation_info: the operation list.
+%
+%    o channel: the channel.
+%
+%    o grayscale: If MagickTrue, only negate grayscale pixels.
+%
+*/
+MagickExport MagickBooleanType AppendNegateOperation(
+  OperationInfo *operation_info,const ChannelType channel,
+  const MagickBooleanType grayscale)
+{
+  OperationNode
+    *node;
+
+  node=AppendOperationNode(operation_info,NegateOperation);
+  if (node == (OperationNode *) NULL)
+    return(MagickFalse);
+  node->channel=channel;
+  node->grayscale=grayscale;
+  return(MagickTrue);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   A p p e n d R e s i z e O p e r a t i o n                                 %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  AppendResizeOperation() records a resize, as ResizeImage() performs it.
+%
+%  The format of the AppendResizeOperation method is:
+%
+%      MagickBooleanType AppendResizeOperation(OperationInfo *operation_info,
+%        const unsigned long columns,const unsigned long rows,
+%        const FilterTypes filter,const double blur)
+%
+%  A description of each parameter follows:
+%
+%    o operation_info: the operation list.
+%
+%    o columns: the number of columns in the resized image.
+%
+%    o rows: the number of rows in the resized image.
+%
+%    o filter: Image filter to use.
+%
+%    o blur: the blur factor where > 1 is blurry, < 1 is sharp.
+%
+*/
+MagickExport MagickBooleanType AppendResizeOperation(
+  OperationInfo *operation_info,const unsigned long columns,
+  const unsigned long rows,const FilterTypes filter,const double blur)
+{
+  OperationNode
+    *node;
+
+  node=AppendOperationNode(operation_info,ResizeOperation);
+  if (node == (OperationNode *) NULL)
+    return(MagickFalse);
+  node->geometry.width=columns;
+  node->geometry.height=rows;
+  node->filter=filter;
+  node->parameters[0]=blur;
+  return(MagickTrue);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   A p p e n d S h a r p e n O p e r a t i o n                               %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  AppendSharpenOperation() records a sharpen, as SharpenImageChannel()
+%  performs it.
+%
+%  The format of the AppendSharpenOperation method is:
+%
+%      MagickBooleanType AppendSharpenOperation(OperationInfo *operation_info,
+%        const ChannelType channel,const double radius,const double sigma)
+%
+%  A description of each parameter follows:
+%
+%    o operation_info: the operation list.
+%
+%    o channel: the channel type.
+%
+%    o radius: the radius of the Gaussian, in pixels, not counting the center
+%      pixel.
+%
+%    o sigma: the standard deviation of the Laplacian, in pixels.
+%
+*/
+MagickExport MagickBooleanType AppendSharpenOperation(
+  OperationInfo *operation_info,const ChannelType channel,const double radius,
+  const double sigma)
+{
+  OperationNode
+    *node;
+
+  node=AppendOperationNode(operation_info,SharpenOperation);
+  if (node == (OperationNode *) NULL)
+    return(MagickFalse);
+  node->channel=channel;
+  node->parameters[0]=radius;
+  node->parameters[1]=sigma;
+  return(MagickTrue);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   A p p l y I m a g e O p e r a t i o n s                                   %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  ApplyImageOperations() applies the recorded operations to a copy of the
+%  image and returns the result.  The operation list is left unchanged, so it
+%  can be applied to further images.
+%
+%  The format of the ApplyImageOperations method is:
+%
+%      Image *ApplyImageOperations(const Image *image,
+%        const OperationInfo *operation_info,ExceptionInfo *exception)
+%
+%  A description of each parameter follows:
+%
+%    o image: the image.
+%
+%    o operation_info: the operation list.
+%
+%    o exception: return any errors or warnings in this structure.
+%
+*/
+
+static inline unsigned long GreatestCommonDivisor(unsigned long a,
+  unsigned long b)
+{
+  while (b != 0)
+  {
+    unsigned long
+      r;
+
+    r=a % b;
+    a=b;
+    b=r;
+  }
+  return(a);
+}
+
+static inline MagickBooleanType IsPointOperation(const OperationNode *node)
+{
+  if ((node->type == GammaOperation) || (node->type == LevelOperation) ||
+      (node->type == NegateOperation))
+    return(MagickTrue);
+  return(MagickFalse);
+}
+
+static inline MagickBooleanType IsTabularOperation(const OperationNode *node)
+{
+  if (IsPointOperation(node) == MagickFalse)
+    return(MagickFalse);
+  if ((node->type == NegateOperation) && (node->grayscale != MagickFalse))
+    return(MagickFalse);
+  return(MagickTrue);
+}
+
+static void ScaleStage(StageInfo *stage,const unsigned long columns,
+  const unsigned long rows)
+{
+  MagickRealType
+    scale;
+
+  /*
+    As CloneImage() scales the page and tile offset for a new size.
+  */
+  scale=(MagickRealType) columns/(MagickRealType) stage->columns;
+  stage->page.width=(unsigned long) (scale*stage->page.width+0.5);
+  stage->page.x=(long) (scale*stage->page.x+0.5);
+  stage->tile_offset.x=(long) (scale*stage->tile_offset.x+0.5);
+  scale=(MagickRealType) rows/(MagickRealType) stage->rows;
+  stage->page.height=(unsigned long) (scale*stage->page.height+0.5);
+  stage->page.y=(long) (stage->page.y*scale+0.5);
+  stage->tile_offset.y=(long) (scale*stage->tile_offset.y+0.5);
+  stage->columns=columns;
+  stage->rows=rows;
+}
+
+static MagickBooleanType CropStage(StageInfo *stage,
+  const RectangleInfo *geometry,RectangleInfo *region)
+{
+  RectangleInfo
+    bounding_box,
+    page;
+
+  /*
+    Follow the canvas arithmetic of CropImage() and return the region it
+    copies.  A crop outside the canvas yields a single pixel.
+  */
+  bounding_box=stage->page;
+  if ((bounding_box.width == 0) || (bounding_box.height == 0))
+    {
+      bounding_box.width=stage->columns;
+      bounding_box.height=stage->rows;
+    }
+  page=(*geometry);
+  if (page.width == 0)
+    page.width=bounding_box.width;
+  if (page.height == 0)
+    page.height=bounding_box.height;
+  if (((bounding_box.x-page.x) >= (long) page.width) ||
+      ((bounding_box.y-page.y) >= (long) page.height) ||
+      ((page.x-bounding_box.x) > (long) stage->columns) ||
+      ((page.y-bounding_box.y) > (long) stage->rows))
+    {
+      ScaleStage(stage,1,1);
+      stage->page=bounding_box;
+      stage->page.x=(-1);
+      stage->page.y=(-1);
+      return(MagickFalse);
+    }
+  if ((page.x < 0) && (bounding_box.x >= 0))
+    {
+      page.width+=page.x-bounding_box.x;
+      page.x=0;
+    }
+  else
+    {
+      page.width-=bounding_box.x-page.x;
+      page.x-=bounding_box.x;
+      if (page.x < 0)
+        page.x=0;
+    }
+  if ((page.y < 0) && (bounding_box.y >= 0))
+    {
+      page.height+=page.y-bounding_box.y;
+      page.y=0;
+    }
+  else
+    {
+      page.height-=bounding_box.y-page.y;
+      page.y-=bounding_box.y;
+      if (page.y < 0)
+        page.y=0;
+    }
+  if ((unsigned long) (page.x+page.width) > stage->columns)
+    page.width=stage->columns-page.x;
+  if (geometry->width != 0)
+    if (page.width > geometry->width)
+      page.width=geometry->width;
+  if ((unsigned long) (page.y+page.height) > stage->rows)
+    page.height=stage->rows-page.y;
+  if (geometry->height != 0)
+    if (page.height > geometry->height)
+      page.height=geometry->height;
+  bounding_box.x+=page.x;
+  bounding_box.y+=page.y;
+  if ((page.width == 0) || (page.height == 0))
+    {
+      stage->columns=0;
+      stage->rows=0;
+      return(MagickFalse);
+    }
+  *region=page;
+  ScaleStage(stage,page.width,page.height);
+  stage->page.width=bounding_box.width;
+  stage->page.height=bounding_box.height;
+  stage->page.x=bounding_box.x;
+  stage->page.y=bounding_box.y;
+  return(MagickTrue);
+}
+
+static MagickBooleanType SimulateOperations(const Image *image,
+  OperationNode *nodes,const unsigned long number_nodes,StageInfo *stage)
+{
+  MagickBooleanType
+    status;
+
+  register long
+    i;
+
+  /*
+    Track the size, page, and tile offset of the image through the
+    operations, and resolve each crop to a region of pixels.  Returns
+    MagickFalse if a crop misses the canvas or a resize has no size; the
+    operations must then run as given.
+  */
+  stage->columns=image->columns;
+  stage->rows=image->rows;
+  stage->page=image->page;
+  stage->tile_offset=image->tile_offset;
+  status=MagickTrue;
+  for (i=0; i < (long) number_nodes; i++)
+  {
+    if ((stage->columns == 0) || (stage->rows == 0))
+      return(MagickFalse);
+    switch (nodes[i].type)
+    {
+      case CropOperation:
+      {
+        if (CropStage(stage,&nodes[i].geometry,&nodes[i].region) == MagickFalse)
+          status=MagickFalse;
+        break;
+      }
+      case ResizeOperation:
+      {
+        if ((nodes[i].geometry.width == 0) || (nodes[i].geometry.height == 0))
+          {
+            stage->columns=0;
+            stage->rows=0;
+            return(MagickFalse);
+          }
+        if ((nodes[i].geometry.width == stage->columns) &&
+            (nodes[i].geometry.height == stage->rows) &&
+            (nodes[i].filter == UndefinedFilter) &&
+            (nodes[i].parameters[0] == 1.0))
+          break;
+        ScaleStage(stage,nodes[i].geometry.width,nodes[i].geometry.height);
+        break;
+      }
+      default:
+        break;
+    }
+  }
+  if ((stage->columns == 0) || (stage->rows == 0))
+    return(MagickFalse);
+  return(status);
+}
+
+static void GetStageExtent(const Image *image,const OperationNode *nodes,
+  const long index,unsigned long *columns,unsigned long *rows)
+{
+  register long
+    i;
+
+  *columns=image->columns;
+  *rows=image->rows;
+  for (i=0; i < index; i++)
+    if (nodes[i].type == CropOperation)
+      {
+        *columns=nodes[i].region.width;
+        *rows=nodes[i].region.height;
+      }
+    else
+      if (nodes[i].type == ResizeOperation)
+        {
+          *columns=nodes[i].geometry.width;
+          *rows=nodes[i].geometry.height;
+        }
+}
+
+static MagickBooleanType InsertOperationNode(OperationNode **nodes,
+  unsigned long *number_nodes,unsigned long *extent,const long index,
+  const OperationNode *node)
+{
+  if (*number_nodes >= *extent)
+    {
+      OperationNode
+        *grown;
+
+      grown=(OperationNode *) ResizeQuantumMemory(*nodes,(size_t) 2*(*extent),
+        sizeof(**nodes));
+      if (grown == (OperationNode *) NULL)
+        return(MagickFalse);
+      *nodes=grown;
+      *extent*=2;
+    }
+  (void) CopyMagickMemory(*nodes+index+1,*nodes+index,(size_t)
+    (*number_nodes-index)*sizeof(**nodes));
+  (*nodes)[index]=(*node);
+  (*number_nodes)++;
+  return(MagickTrue);
+}
+
+static void RemoveOperationNode(OperationNode *nodes,
+  unsigned long *number_nodes,const long index)
+{
+  (*number_nodes)--;
+  (void) CopyMagickMemory(nodes+index,nodes+index+1,(size_t)
+    (*number_nodes-index)*sizeof(*nodes));
+}
+
+static inline MagickBooleanType IsLocalVirtualPixelMethod(
+  const VirtualPixelMethod method)
+{
+  switch (method)
+  {
+    case UndefinedVirtualPixelMethod:
+    case BackgroundVirtualPixelMethod:
+    case ConstantVirtualPixelMethod:
+    case EdgeVirtualPixelMethod:
+    case TransparentVirtualPixelMethod:
+    case BlackVirtualPixelMethod:
+    case GrayVirtualPixelMethod:
+    case WhiteVirtualPixelMethod:
+      return(MagickTrue);
+    default:
+      break;
+  }
+  return(MagickFalse);
+}
+
+static MagickRealType GetResizeSupport(const Image *image,
+  const OperationNode *node,ExceptionInfo *exception)
+{
+  MagickRealType
+    support;
+
+  ResizeFilter
+    *resize_filter;
+
+  /*
+    ResizeImage() picks among these filters when none is given; take the
+    widest.
+  */
+  if (node->filter != UndefinedFilter)
+    {
+      resize_filter=AcquireResizeFilter(image,node->filter,node->parameters[0],
+        MagickFalse,exception);
+      support=GetResizeFilterSupport(resize_filter);
+      resize_filter=DestroyResizeFilter(resize_filter);
+      return(support);
+    }
+  resize_filter=AcquireResizeFilter(image,LanczosFilter,node->parameters[0],
+    MagickFalse,exception);
+  support=GetResizeFilterSupport(resize_filter);
+  resize_filter=DestroyResizeFilter(resize_filter);
+  resize_filter=AcquireResizeFilter(image,MitchellFilter,node->parameters[0],
+    MagickFalse,exception);
+  support=MagickMax(support,GetResizeFilterSupport(resize_filter));
+  resize_filter=DestroyResizeFilter(resize_filter);
+  return(support);
+}
+
+static void GetResizeSpan(const unsigned long extent,
+  const unsigned long resize_extent,const long offset,
+  const unsigned long length,const MagickRealType support,long *source,
+  unsigned long *source_length,long *target,unsigned long *target_length)
+{
+  double
+    first,
+    last,
+    scale;
+
+  unsigned long
+    divisor,
+    source_block,
+    target_block;
+
+  /*
+    Find the source span that covers [offset,offset+length) of the resized
+    image plus the filter support, aligned so that the span resizes to a
+    whole number of pixels at exactly the original scale.
+  */
+  divisor=GreatestCommonDivisor(extent,resize_extent);
+  source_block=extent/divisor;
+  target_block=resize_extent/divisor;
+  scale=(double) extent/resize_extent;
+  first=floor(offset*scale)-ceil(support*MagickMax(scale,1.0))-2.0;
+  last=ceil((offset+length)*scale)+ceil(support*MagickMax(scale,1.0))+2.0;
+  first=floor(first/source_block)*source_block;
+  last=ceil(last/source_block)*source_block;
+  if (first < 0.0)
+    first=0.0;
+  if (last > (double) extent)
+    last=(double) extent;
+  *source=(long) first;
+  *source_length=(unsigned long) (last-first);
+  *target=(long) (*source/source_block*target_block);
+  *target_length=(*source_length)/source_block*target_block;
+}
+
+static MagickBooleanType PushCropBeforeResize(const Image *image,
+  OperationNode **nodes,unsigned long *number_nodes,unsigned long *extent,
+  const long index,ExceptionInfo *exception)
+{
+  MagickRealType
+    support;
+
+  OperationNode
+    crop,
+    *resize;
+
+  RectangleInfo
+    region,
+    resize_region;
+
+  unsigned long
+    columns,
+    rows;
+
+  /*
+    Replace resize+crop with crop+resize+crop: the first crop keeps just the
+    source pixels the filter reads for the region.
+  */
+  resize=(*nodes)+index-1;
+  GetStageExtent(image,*nodes,index-1,&columns,&rows);
+  support=GetResizeSupport(image,resize,exception);
+  GetResizeSpan(columns,resize->geometry.width,(*nodes)[index].region.x,
+    (*nodes)[index].region.width,support,&region.x,&region.width,
+    &resize_region.x,&resize_region.width);
+  GetResizeSpan(rows,resize->geometry.height,(*nodes)[index].region.y,
+    (*nodes)[index].region.height,support,&region.y,&region.height,
+    &resize_region.y,&resize_region.height);
+  if (((double) region.width*region.height) >=
+      (OperationCropBenefit*columns*rows))
+    {
+      (*nodes)[index].fixed=MagickTrue;
+      return(MagickTrue);
+    }
+  resize->geometry.width=resize_region.width;
+  resize->geometry.height=resize_region.height;
+  (*nodes)[index].region.x-=resize_region.x;
+  (*nodes)[index].region.y-=resize_region.y;
+  (*nodes)[index].fixed=MagickTrue;
+  (void) ResetMagickMemory(&crop,0,sizeof(crop));
+  crop.type=CropOperation;
+  crop.region=region;
+  return(InsertOperationNode(nodes,number_nodes,extent,index-1,&crop));
+}
+
+static MagickBooleanType PushCropBeforeSharpen(const Image *image,
+  OperationNode **nodes,unsigned long *number_nodes,unsigned long *extent,
+  const long index)
+{
+  long
+    margin;
+
+  OperationNode
+    crop;
+
+  RectangleInfo
+    region;
+
+  unsigned long
+    columns,
+    rows;
+
+  /*
+    Replace sharpen+crop with crop+sharpen+crop: the first crop keeps the
+    region and the kernel radius around it.
+  */
+  GetStageExtent(image,*nodes,index,&columns,&rows);
+  margin=(long) GetOptimalKernelWidth2D((*nodes)[index-1].parameters[0],
+    (*nodes)[index-1].parameters[1])/2;
+  region=(*nodes)[index].region;
+  region.x=(long) MagickMax((double) region.x-margin,0.0);
+  region.y=(long) MagickMax((double) region.y-margin,0.0);
+  region.width=(unsigned long) MagickMin((double) columns,(double)
+    (*nodes)[index].region.x+(*nodes)[index].region.width+margin)-region.x;
+  region.height=(unsigned long) MagickMin((double) rows,(double)
+    (*nodes)[index].region.y+(*nodes)[index].region.height+margin)-region.y;
+  if (((double) region.width*region.height) >=
+      (OperationCropBenefit*columns*rows))
+    {
+      (*nodes)[index].fixed=MagickTrue;
+      return(MagickTrue);
+    }
+  (*nodes)[index].region.x-=region.x;
+  (*nodes)[index].region.y-=region.y;
+  (*nodes)[index].fixed=MagickTrue;
+  (void) ResetMagickMemory(&crop,0,sizeof(crop));
+  crop.type=CropOperation;
+  crop.region=region;
+  return(InsertOperationNode(nodes,number_nodes,extent,index-1,&crop));
+}
+
+static MagickBooleanType OptimizeOperations(const Image *image,
+  OperationNode **nodes,unsigned long *number_nodes,unsigned long *extent,
+  ExceptionInfo *exception)
+{
+  long
+    pass;
+
+  MagickBooleanType
+    local,
+    status;
+
+  register long
+    i;
+
+  local=IsLocalVirtualPixelMethod(GetImageVirtualPixelMethod(image));
+  status=MagickTrue;
+  for (pass=0; pass < (long) (4*(*number_nodes)*(*number_nodes)+16); pass++)
+  {
+    MagickBooleanType
+      changed;
+
+    changed=MagickFalse;
+    for (i=1; (i < (long) *number_nodes) && (changed == MagickFalse); i++)
+    {
+      OperationNode
+        *node,
+        *prior;
+
+      prior=(*nodes)+i-1;
+      node=(*nodes)+i;
+      if ((prior->type == CropOperation) && (node->type == CropOperation))
+        {
+          /*
+            A crop of a crop is one crop.
+          */
+          prior->region.x+=node->region.x;
+          prior->region.y+=node->region.y;
+          prior->region.width=node->region.width;
+          prior->region.height=node->region.height;
+          if (node->fixed != MagickFalse)
+            prior->fixed=MagickTrue;
+          RemoveOperationNode(*nodes,number_nodes,i);
+          changed=MagickTrue;
+          continue;
+        }
+      if ((prior->type == ResizeOperation) &&
+          (node->type == ResizeOperation) && (prior->filter == node->filter) &&
+          (prior->parameters[0] == node->parameters[0]) &&
+          (node->geometry.width <= prior->geometry.width) &&
+          (node->geometry.height <= prior->geometry.height))
+        {
+          /*
+            Resample once, unless the second resize enlarges the first: the
+            detail the first one discarded cannot be restored.
+          */
+          prior->geometry=node->geometry;
+          RemoveOperationNode(*nodes,number_nodes,i);
+          changed=MagickTrue;
+          continue;
+        }
+      if ((node->type != CropOperation) || (node->fixed != MagickFalse))
+        continue;
+      if (IsPointOperation(prior) != MagickFalse)
+        {
+          OperationNode
+            swap;
+
+          swap=(*prior);
+          *prior=(*node);
+          *node=swap;
+          changed=MagickTrue;
+          continue;
+        }
+      if ((prior->type == SharpenOperation) && (local != MagickFalse))
+        {
+          status=PushCropBeforeSharpen(image,nodes,number_nodes,extent,i);
+          changed=MagickTrue;
+          continue;
+        }
+      if (prior->type == ResizeOperation)
+        {
+          status=PushCropBeforeResize(image,nodes,number_nodes,extent,i,
+            exception);
+          changed=MagickTrue;
+          continue;
+        }
+    }
+    if ((changed == MagickFalse) || (status == MagickFalse))
+      break;
+  }
+  return(status);
+}
+
+static MagickBooleanType RunPointOperation(Image *image,
+  const OperationNode *node)
+{
+  switch (node->type)
+  {
+    case GammaOperation:
+      return(GammaImageChannel(image,node->channel,node->parameters[0]));
+    case LevelOperation:
+      return(LevelImageChannel(image,node->channel,node->parameters[0],
+        node->parameters[1],node->parameters[2]));
+    case NegateOperation:
+      return(NegateImageChannel(image,node->channel,node->grayscale));
+    default:
+      break;
+  }
+  return(MagickFalse);
+}
+
+static MagickBooleanType ApplyPointOperations(Image *image,
+  const OperationNode *nodes,const unsigned long number_nodes,
+  ExceptionInfo *exception)
+{
+#define ApplyPointOperationsTag  "Operations/Image"
+
+  Image
+    *ramp_image;
+
+  IndexPacket
+    *index_map;
+
+  long
+    progress,
+    y;
+
+  MagickBooleanType
+    status;
+
+  PixelPacket
+    *map;
+
+  register const IndexPacket
+    *indexes;
+
+  register const PixelPacket
+    *p;
+
+  register long
+    i;
+
+  CacheView
+    *image_view;
+
+  /*
+    Run the operations on a ramp through every quantum value to tabulate
+    their combined effect on each channel.
+  */
+  ramp_image=CloneImage(image,MaxMap+1,1,MagickTrue,exception);
+  if (ramp_image == (Image *) NULL)
+    return(MagickFalse);
+  ramp_image->progress_monitor=(MagickProgressMonitor) NULL;
+  map=GetAuthenticPixels(ramp_image,0,0,ramp_image->columns,1,exception);
+  if (map == (PixelPacket *) NULL)
+    {
+      ramp_image=DestroyImage(ramp_image);
+      return(MagickFalse);
+    }
+  index_map=GetAuthenticIndexQueue(ramp_image);
+  for (i=0; i <= (long) MaxMap; i++)
+  {
+    map[i].red=(Quantum) i;
+    map[i].green=(Quantum) i;
+    map[i].blue=(Quantum) i;
+    map[i].opacity=(Quantum) i;
+    if (index_map != (IndexPacket *) NULL)
+      index_map[i]=(IndexPacket) i;
+  }
+  status=SyncAuthenticPixels(ramp_image,exception);
+  for (i=0; (i < (long) number_nodes) && (status != MagickFalse); i++)
+    status=RunPointOperation(ramp_image,nodes+i);
+  map=(PixelPacket *) NULL;
+  index_map=(IndexPacket *) NULL;
+  if (status != MagickFalse)
+    {
+      map=(PixelPacket *) AcquireQuantumMemory(MaxMap+1UL,sizeof(*map));
+      index_map=(IndexPacket *) AcquireQuantumMemory(MaxMap+1UL,
+        sizeof(*index_map));
+      p=GetVirtualPixels(ramp_image,0,0,ramp_image->columns,1,exception);
+      indexes=GetVirtualIndexQueue(ramp_image);
+      if ((map == (PixelPacket *) NULL) ||
+          (index_map == (IndexPacket *) NULL) || (p == (PixelPacket *) NULL))
+        status=MagickFalse;
+      else
+        for (i=0; i <= (long) MaxMap; i++)
+        {
+          map[i]=p[i];
+          index_map[i]=(IndexPacket) i;
+          if (indexes != (const IndexPacket *) NULL)
+            index_map[i]=indexes[i];
+        }
+    }
+  if (status == MagickFalse)
+    InheritException(exception,&ramp_image->exception);
+  ramp_image=DestroyImage(ramp_image);
+  if (status == MagickFalse)
+    {
+      if (index_map != (IndexPacket *) NULL)
+        index_map=(IndexPacket *) RelinquishMagickMemory(index_map);
+      if (map != (PixelPacket *) NULL)
+        map=(PixelPacket *) RelinquishMagickMemory(map);
+      return(MagickFalse);
+    }
+  /*
+    Map the image through the tables.
+  */
+  progress=0;
+  image_view=AcquireCacheView(image);
+#if defined(MAGICKCORE_OPENMP_SUPPORT)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
+#endif
+  for (y=0; y < (long) image->rows; y++)
+  {
+    register IndexPacket
+      *__restrict image_indexes;
+
+    register long
+      x;
+
+    register PixelPacket
+      *__restrict q;
+
+    if (status == MagickFalse)
+      continue;
+    q=GetCacheViewAuthenticPixels(image_view,0,y,image->columns,1,exception);
+    if (q == (PixelPacket *) NULL)
+      {
+        status=MagickFalse;
+        continue;
+      }
+    image_indexes=GetCacheViewAuthenticIndexQueue(image_view);
+    for (x=0; x < (long) image->columns; x++)
+    {
+      q->red=map[ScaleQuantumToMap(q->red)].red;
+      q->green=map[ScaleQuantumToMap(q->green)].green;
+      q->blue=map[ScaleQuantumToMap(q->blue)].blue;
+      q->opacity=map[ScaleQuantumToMap(q->opacity)].opacity;
+      q++;
+    }
+    if ((image_indexes != (IndexPacket *) NULL) &&
+        (image->colorspace == CMYKColorspace))
+      for (x=0; x < (long) image->columns; x++)
+        image_indexes[x]=index_map[ScaleQuantumToMap(image_indexes[x])];
+    if (SyncCacheViewAuthenticPixels(image_view,exception) == MagickFalse)
+      status=MagickFalse;
+    if (image->progress_monitor != (MagickProgressMonitor) NULL)
+      {
+        MagickBooleanType
+          proceed;
+
+#if defined(MAGICKCORE_OPENMP_SUPPORT)
+  #pragma omp critical (MagickCore_ApplyPointOperations)
+#endif
+        proceed=SetImageProgress(image,ApplyPointOperationsTag,progress++,
+          image->rows);
+        if (proceed == MagickFalse)
+          status=MagickFalse;
+      }
+  }
+  image_view=DestroyCacheView(image_view);
+  index_map=(IndexPacket *) RelinquishMagickMemory(index_map);
+  map=(PixelPacket *) RelinquishMagickMemory(map);
+  return(status);
+}
+
+static MagickBooleanType RunOperation(Image **image,const OperationNode *node,
+  const MagickBooleanType regions,ExceptionInfo *exception)
+{
+  Image
+    *next_image;
+
+  MagickBooleanType
+    status;
+
+  next_image=(Image *) NULL;
+  switch (node->type)
+  {
+    case CropOperation:
+    {
+      if (regions == MagickFalse)
+        {
+          next_image=CropImage(*image,&node->geometry,exception);
+          break;
+        }
+      /*
+        The region is in pixels; take the canvas out of the way.
+      */
+      (void) ResetMagickMemory(&(*image)->page,0,sizeof((*image)->page));
+      next_image=CropImage(*image,&node->region,exception);
+      break;
+    }
+    case ResizeOperation:
+    {
+      next_image=ResizeImage(*image,node->geometry.width,node->geometry.height,
+        node->filter,node->parameters[0],exception);
+      break;
+    }
+    case SharpenOperation:
+    {
+      next_image=SharpenImageChannel(*image,node->channel,node->parameters[0],
+        node->parameters[1],exception);
+      break;
+    }
+    default:
+    {
+      status=RunPointOperation(*image,node);
+      if (status == MagickFalse)
+        InheritException(exception,&(*image)->exception);
+      return(status);
+    }
+  }
+  if (next_image == (Image *) NULL)
+    return(MagickFalse);
+  *image=DestroyImage(*image);
+  *image=next_image;
+  return(MagickTrue);
+}
+
+MagickExport Image *ApplyImageOperations(const Image *image,
+  const OperationInfo *operation_info,ExceptionInfo *exception)
+{
+  Image
+    *operation_image;
+
+  MagickBooleanType
+    regions,
+    status;
+
+  OperationNode
+    *nodes;
+
+  register long
+    i;
+
+  StageInfo
+    stage;
+
+  unsigned long
+    extent,
+    number_nodes;
+
+  assert(image != (const Image *) NULL);
+  assert(image->signature == MagickSignature);
+  if (image->debug != MagickFalse)
+    (void) LogMagickEvent(TraceEvent,GetMagickModule(),"%s",image->filename);
+  assert(operation_info != (const OperationInfo *) NULL);
+  assert(operation_info->signature == MagickSignature);
+  assert(exception != (ExceptionInfo *) NULL);
+  assert(exception->signature == MagickSignature);
+  operation_image=CloneImage(image,0,0,MagickTrue,exception);
+  if ((operation_image == (Image *) NULL) ||
+      (operation_info->number_nodes == 0))
+    return(operation_image);
+  number_nodes=operation_info->number_nodes;
+  extent=2*number_nodes;
+  nodes=(OperationNode *) AcquireQuantumMemory((size_t) extent,
+    sizeof(*nodes));
+  if (nodes == (OperationNode *) NULL)
+    {
+      operation_image=DestroyImage(operation_image);
+      ThrowImageException(ResourceLimitError,"MemoryAllocationFailed");
+    }
+  (void) CopyMagickMemory(nodes,operation_info->nodes,(size_t) number_nodes*
+    sizeof(*nodes));
+  /*
+    Rearrange the operations only when the pixels they produce do not
+    depend on the order: crops and resizes drop clip masks, so an image with
+    one runs the operations as given.
+  */
+  regions=SimulateOperations(image,nodes,number_nodes,&stage);
+  if ((image->clip_mask != (Image *) NULL) || (image->mask != (Image *) NULL))
+    regions=MagickFalse;
+  status=MagickTrue;
+  if (regions != MagickFalse)
+    status=OptimizeOperations(image,&nodes,&number_nodes,&extent,exception);
+  if (operation_info->debug != MagickFalse)
+    (void) LogMagickEvent(TraceEvent,GetMagickModule(),
+      "%lu operations run as %lu",operation_info->number_nodes,number_nodes);
+  for (i=0; (i < (long) number_nodes) && (status != MagickFalse); )
+  {
+    register long
+      j;
+
+    j=i;
+#if !defined(MAGICKCORE_HDRI_SUPPORT) && (MAGICKCORE_QUANTUM_DEPTH <= 16)
+    while ((j < (long) number_nodes) &&
+           (IsTabularOperation(nodes+j) != MagickFalse))
+      j++;
+    if (((j-i) > 1) && (operation_image->storage_class == DirectClass) &&
+        (operation_image->clip_mask == (Image *) NULL) &&
+        (operation_image->mask == (Image *) NULL))
+      {
+        /*
+          One pass for the whole run of point operations.
+        */
+        status=ApplyPointOperations(operation_image,nodes+i,(unsigned long)
+          (j-i),exception);
+        i=j;
+        continue;
+      }
+#endif
+    status=RunOperation(&operation_image,nodes+i,regions,exception);
+    i++;
+  }
+  nodes=(OperationNode *) RelinquishMagickMemory(nodes);
+  if (status == MagickFalse)
+    {
+      operation_image=DestroyImage(operation_image);
+      return((Image *) NULL);
+    }
+  if (regions != MagickFalse)
+    {
+      operation_image->page=stage.page;
+      operation_image->tile_offset=stage.tile_offset;
+    }
+  return(operation_image);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   C l o n e O p e r a t i o n I n f o                                       %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  CloneOperationInfo() makes a duplicate of the given operation list.
+%
+%  The format of the CloneOperationInfo method is:
+%
+%      OperationInfo *CloneOperationInfo(const OperationInfo *operation_info)
+%
+%  A description of each parameter follows:
+%
+%    o operation_info: the operation list.
+%
+*/
+MagickExport OperationInfo *CloneOperationInfo(
+  const OperationInfo *operation_info)
+{
+  OperationInfo
+    *clone_info;
+
+  assert(operation_info != (const OperationInfo *) NULL);
+  assert(operation_info->signature == MagickSignature);
+  clone_info=AcquireOperationInfo();
+  if (operation_info->number_nodes == 0)
+    return(clone_info);
+  clone_info->nodes=(OperationNode *) AcquireQuantumMemory((size_t)
+    operation_info->number_nodes,sizeof(*clone_info->nodes));
+  if (clone_info->nodes == (OperationNode *) NULL)
+    ThrowFatalException(ResourceLimitFatalError,"MemoryAllocationFailed");
+  (void) CopyMagickMemory(clone_info->nodes,operation_info->nodes,(size_t)
+    operation_info->number_nodes*sizeof(*clone_info->nodes));
+  clone_info->number_nodes=operation_info->number_nodes;
+  clone_info->extent=operation_info->number_nodes;
+  return(clone_info);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   D e s t r o y O p e r a t i o n I n f o                                   %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  DestroyOperationInfo() deallocates memory associated with an operation
+%  list.
+%
+%  The format of the DestroyOperationInfo method is:
+%
+%      OperationInfo *DestroyOperationInfo(OperationInfo *operation_info)
+%
+%  A description of each parameter follows:
+%
+%    o operation_info: the operation list.
+%
+*/
+MagickExport OperationInfo *DestroyOperationInfo(OperationInfo *operation_info)
+{
+  assert(operation_info != (OperationInfo *) NULL);
+  assert(operation_info->signature == MagickSignature);
+  if (operation_info->nodes != (OperationNode *) NULL)
+    operation_info->nodes=(OperationNode *) RelinquishMagickMemory(
+      operation_info->nodes);
+  operation_info->signature=(~MagickSignature);
+  operation_info=(OperationInfo *) RelinquishMagickMemory(operation_info);
+  return(operation_info);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   G e t I m a g e O p e r a t i o n s S i z e                               %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  GetImageOperationsSize() returns the size the image would have once the
+%  operations are applied, without applying them.  It returns MagickFalse if
+%  an operation would fail.
+%
+%  The format of the GetImageOperationsSize method is:
+%
+%      MagickBooleanType GetImageOperationsSize(const Image *image,
+%        const OperationInfo *operation_info,unsigned long *columns,
+%        unsigned long *rows)
+%
+%  A description of each parameter follows:
+%
+%    o image: the image.
+%
+%    o operation_info: the operation list.
+%
+%    o columns: the number of columns.
+%
+%    o rows: the number of rows.
+%
+*/
+MagickExport MagickBooleanType GetImageOperationsSize(const Image *image,
+  const OperationInfo *operation_info,unsigned long *columns,
+  unsigned long *rows)
+{
+  OperationNode
+    *nodes;
+
+  StageInfo
+    stage;
+
+  assert(image != (const Image *) NULL);
+  assert(image->signature == MagickSignature);
+  assert(operation_info != (const OperationInfo *) NULL);
+  assert(operation_info->signature == MagickSignature);
+  *columns=image->columns;
+  *rows=image->rows;
+  if (operation_info->number_nodes == 0)
+    return(MagickTrue);
+  nodes=(OperationNode *) AcquireQuantumMemory((size_t)
+    operation_info->number_nodes,sizeof(*nodes));
+  if (nodes == (OperationNode *) NULL)
+    return(MagickFalse);
+  (void) CopyMagickMemory(nodes,operation_info->nodes,(size_t)
+    operation_info->number_nodes*sizeof(*nodes));
+  (void) SimulateOperations(image,nodes,operation_info->number_nodes,&stage);
+  nodes=(OperationNode *) RelinquishMagickMemory(nodes);
+  if ((stage.columns == 0) || (stage.rows == 0))
+    return(MagickFalse);
+  *columns=stage.columns;
+  *rows=stage.rows;
+  return(MagickTrue);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   G e t N u m b e r O f O p e r a t i o n s                                 %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  GetNumberOfOperations() returns the number of operations in the list.
+%
+%  The format of the GetNumberOfOperations method is:
+%
+%      unsigned long GetNumberOfOperations(const OperationInfo *operation_info)
+%
+%  A description of each parameter follows:
+%
+%    o operation_info: the operation list.
+%
+*/
+MagickExport unsigned long GetNumberOfOperations(
+  const OperationInfo *operation_info)
+{
+  assert(operation_info != (const OperationInfo *) NULL);
+  assert(operation_info->signature == MagickSignature);
+  return(operation_info->number_nodes);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   R e s e t O p e r a t i o n I n f o                                       %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  ResetOperationInfo() removes every operation from the list.
+%
+%  The format of the ResetOperationInfo method is:
+%
+%      void ResetOperationInfo(OperationInfo *operation_info)
+%
+%  A description of each parameter follows:
+%
+%    o operation_info: the operation list.
+%
+*/
+MagickExport void ResetOperationInfo(OperationInfo *operation_info)
+{
+  assert(operation_info != (OperationInfo *) NULL);
+  assert(operation_info->signature == MagickSignature);
+  operation_info->number_nodes=0;
+}
@@ -0,0 +1,63 @@
+/*
+  Copyright 1999-2009 ImageMagick Studio LLC, a non-profit organization
+  dedicated to making software imaging solutions freely available.
+
+  You may not use this file except in compliance with the License.
+  obtain a copy of the License at
+
+    http://www.imagemagick.org/script/license.php
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  MagickCore deferred image operation methods.
+*/
+#ifndef _MAGICKCORE_OPERATION_H
+#define _MAGICKCORE_OPERATION_H
+
+#if defined(__cplusplus) || defined(c_plusplus)
+extern "C" {
+#endif
+
+#include "magick/image.h"
+#include "magick/resample.h"
+
+typedef struct _OperationInfo
+  OperationInfo;
+
+extern MagickExport Image
+  *ApplyImageOperations(const Image *,const OperationInfo *,ExceptionInfo *);
+
+extern MagickExport MagickBooleanType
+  AppendCropOperation(OperationInfo *,const RectangleInfo *),
+  AppendGammaOperation(OperationInfo *,const ChannelType,const double),
+  AppendLevelOperation(OperationInfo *,const ChannelType,const double,
+    const double,const double),
+  AppendNegateOperation(OperationInfo *,const ChannelType,
+    const MagickBooleanType),
+  AppendResizeOperation(OperationInfo *,const unsigned long,
+    const unsigned long,const FilterTypes,const double),
+  AppendSharpenOperation(OperationInfo *,const ChannelType,const double,
+    const double),
+  GetImageOperationsSize(const Image *,const OperationInfo *,unsigned long *,
+    unsigned long *);
+
+extern MagickExport OperationInfo
+  *AcquireOperationInfo(void),
+  *CloneOperationInfo(const OperationInfo *),
+  *DestroyOperationInfo(OperationInfo *);
+
+extern MagickExport unsigned long
+  GetNumberOfOperations(const OperationInfo *);
+
+extern MagickExport void
+  ResetOperationInfo(OperationInfo *);
+
+#if defined(__cplusplus) || defined(c_plusplus)
+}
+#endif
+
+#endif
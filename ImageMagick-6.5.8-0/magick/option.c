@@ -67,9 +67,10 @@
 #include "magick/quantize.h"
 #include "magick/quantum.h"
 #include "magick/resource_.h"
-#include "magick/splay-tree.h"
 #include "magick/string_.h"
+#include "magick/string-map.h"
 #include "magick/token.h"
+#include "magick/trace.h"
 #include "magick/utility.h"
 
 /*
@@ -462,6 +463,8 @@ static const OptionInfo
     { "-page", 1L, MagickFalse },
     { "+paint", 0L, MagickFalse },
     { "-paint", 1L, MagickFalse },
+    { "+parallel-files", 0L, MagickFalse },
+    { "-parallel-files", 1L, MagickFalse },
     { "+path", 0L, MagickFalse },
     { "-path", 1L, MagickFalse },
     { "+pause", 0L, MagickFalse },
@@ -582,6 +585,8 @@ static const OptionInfo
     { "-stegano", 1L, MagickFalse },
     { "+stereo", 0L, MagickFalse },
     { "-stereo", 1L, MagickFalse },
+    { "+stream-resize", 0L, MagickFalse },
+    { "-stream-resize", 1L, MagickFalse },
     { "+stretch", 0L, MagickFalse },
     { "-stretch", 1L, MagickFalse },
     { "+strip", 0L, MagickFalse },
@@ -1117,6 +1122,7 @@ static const OptionInfo
     { "Stretch", (long) MagickStretchOptions, MagickFalse },
     { "Style", (long) MagickStyleOptions, MagickFalse },
     { "Threshold", (long) MagickThresholdOptions, MagickFalse },
+    { "Trace", (long) MagickTraceOptions, MagickFalse },
     { "Type", (long) MagickTypeOptions, MagickFalse },
     { "Units", (long) MagickResolutionOptions, MagickFalse },
     { "Undefined", (long) MagickUndefinedOptions, MagickTrue },
@@ -1345,6 +1351,18 @@ static const OptionInfo
     { "Oblique", (long) ObliqueStyle, MagickFalse },
     { (char *) NULL, (long) UndefinedStyle, MagickFalse }
   },
+  TraceOptions[] =
+  {
+    { "Undefined", (long) UndefinedTrace, MagickTrue },
+    { "All", (long) AllTrace, MagickFalse },
+    { "Cache", (long) CacheTrace, MagickFalse },
+    { "Coder", (long) CoderTrace, MagickFalse },
+    { "None", (long) NoTrace, MagickFalse },
+    { "OpenMP", (long) OpenMPTrace, MagickFalse },
+    { "Operator", (long) OperatorTrace, MagickFalse },
+    { "Resource", (long) ResourceTrace, MagickFalse },
+    { (char *) NULL, (long) UndefinedTrace, MagickFalse }
+  },
   TypeOptions[] =
   {
     { "Undefined", (long) UndefinedType, MagickTrue },
@@ -1365,15 +1383,24 @@ static const OptionInfo
   {
     { "Undefined", (long) UndefinedValidate, MagickTrue },
     { "All", (long) AllValidate, MagickFalse },
+    { "Cache", (long) CacheValidate, MagickFalse },
     { "Compare", (long) CompareValidate, MagickFalse },
     { "Composite", (long) CompositeValidate, MagickFalse },
     { "Convert", (long) ConvertValidate, MagickFalse },
+    { "Draw", (long) DrawValidate, MagickFalse },
     { "FormatsInMemory", (long) FormatsInMemoryValidate, MagickFalse },
     { "FormatsOnDisk", (long) FormatsOnDiskValidate, MagickFalse },
+    { "Hashmap", (long) HashmapValidate, MagickFalse },
     { "Identify", (long) IdentifyValidate, MagickFalse },
     { "ImportExport", (long) ImportExportValidate, MagickFalse },
     { "Montage", (long) MontageValidate, MagickFalse },
+    { "Operation", (long) OperationValidate, MagickFalse },
+    { "Registry", (long) RegistryValidate, MagickFalse },
+    { "Resource", (long) ResourceValidate, MagickFalse },
+    { "Startup", (long) StartupValidate, MagickFalse },
     { "Stream", (long) StreamValidate, MagickFalse },
+    { "Thread", (long) ThreadValidate, MagickFalse },
+    { "Trace", (long) TraceValidate, MagickFalse },
     { "None", (long) NoValidate, MagickFalse },
     { (char *) NULL, (long) UndefinedValidate, MagickFalse }
   },
@@ -1435,8 +1462,7 @@ MagickExport MagickBooleanType CloneImageOptions(ImageInfo *image_info,
   assert(clone_info != (const ImageInfo *) NULL);
   assert(clone_info->signature == MagickSignature);
   if (clone_info->options != (void *) NULL)
-    image_info->options=CloneSplayTree((SplayTreeInfo *) clone_info->options,
-      (void *(*)(void *)) ConstantString,(void *(*)(void *)) ConstantString);
+    image_info->options=CloneStringMap((StringMapInfo *) clone_info->options);
   return(MagickTrue);
 }
 
@@ -1523,7 +1549,8 @@ MagickExport MagickBooleanType DeleteImageOption(ImageInfo *image_info,
       image_info->filename);
   if (image_info->options == (void *) NULL)
     return(MagickFalse);
-  return(DeleteNodeFromSplayTree((SplayTreeInfo *) image_info->options,option));
+  return(DeleteEntryFromStringMap((StringMapInfo *) image_info->options,
+    option));
 }
 
 /*
@@ -1556,7 +1583,7 @@ MagickExport void DestroyImageOptions(ImageInfo *image_info)
     (void) LogMagickEvent(TraceEvent,GetMagickModule(),"%s",
       image_info->filename);
   if (image_info->options != (void *) NULL)
-    image_info->options=DestroySplayTree((SplayTreeInfo *) image_info->options);
+    image_info->options=DestroyStringMap((StringMapInfo *) image_info->options);
 }
 
 /*
@@ -1597,7 +1624,7 @@ MagickExport const char *GetImageOption(const ImageInfo *image_info,
       image_info->filename);
   if (image_info->options == (void *) NULL)
     return((const char *) NULL);
-  option=(const char *) GetValueFromSplayTree((SplayTreeInfo *)
+  option=(const char *) GetValueFromStringMap((StringMapInfo *)
     image_info->options,key);
   return(option);
 }
@@ -1676,6 +1703,7 @@ static const OptionInfo *GetOptionInfo(const MagickOption option)
     case MagickStorageOptions: return(StorageOptions);
     case MagickStretchOptions: return(StretchOptions);
     case MagickStyleOptions: return(StyleOptions);
+    case MagickTraceOptions: return(TraceOptions);
     case MagickTypeOptions: return(TypeOptions);
     case MagickValidateOptions: return(ValidateOptions);
     case MagickVirtualPixelOptions: return(VirtualPixelOptions);
@@ -1739,7 +1767,7 @@ MagickExport char *GetNextImageOption(const ImageInfo *image_info)
       image_info->filename);
   if (image_info->options == (void *) NULL)
     return((char *) NULL);
-  return((char *) GetNextKeyInSplayTree((SplayTreeInfo *) image_info->options));
+  return((char *) GetNextKeyInStringMap((StringMapInfo *) image_info->options));
 }
 
 /*
@@ -2144,7 +2172,7 @@ MagickExport char *RemoveImageOption(ImageInfo *image_info,const char *option)
       image_info->filename);
   if (image_info->options == (void *) NULL)
     return((char *) NULL);
-  value=(char *) RemoveNodeFromSplayTree((SplayTreeInfo *)
+  value=(char *) RemoveEntryFromStringMap((StringMapInfo *)
     image_info->options,option);
   return(value);
 }
@@ -2181,7 +2209,7 @@ MagickExport void ResetImageOptions(const ImageInfo *image_info)
       image_info->filename);
   if (image_info->options == (void *) NULL)
     return;
-  ResetSplayTree((SplayTreeInfo *) image_info->options);
+  ClearStringMap((StringMapInfo *) image_info->options);
 }
 
 /*
@@ -2217,7 +2245,7 @@ MagickExport void ResetImageOptionIterator(const ImageInfo *image_info)
       image_info->filename);
   if (image_info->options == (void *) NULL)
     return;
-  ResetSplayTreeIterator((SplayTreeInfo *) image_info->options);
+  ResetStringMapIterator((StringMapInfo *) image_info->options);
 }
 
 /*
@@ -2261,9 +2289,8 @@ MagickExport MagickBooleanType SetImageOption(ImageInfo *image_info,
   if (LocaleCompare(option,"size") == 0)
     (void) CloneString(&image_info->size,value);
   if (image_info->options == (void *) NULL)
-    image_info->options=NewSplayTree(CompareSplayTreeString,
-      RelinquishMagickMemory,RelinquishMagickMemory);
-  status=AddValueToSplayTree((SplayTreeInfo *) image_info->options,
-    ConstantString(option),ConstantString(value));
+    image_info->options=NewStringMap();
+  status=PutEntryInStringMap((StringMapInfo *) image_info->options,
+    option,value);
   return(status);
 }
@@ -86,6 +86,7 @@ typedef enum
   MagickStretchOptions,
   MagickStyleOptions,
   MagickThresholdOptions,
+  MagickTraceOptions,
   MagickTypeOptions,
   MagickValidateOptions,
   MagickVirtualPixelOptions
@@ -104,6 +105,15 @@ typedef enum
   ImportExportValidate = 0x00040,
   MontageValidate = 0x00080,
   StreamValidate = 0x00100,
+  HashmapValidate = 0x00200,
+  RegistryValidate = 0x00400,
+  StartupValidate = 0x00800,
+  DrawValidate = 0x01000,
+  OperationValidate = 0x02000,
+  ThreadValidate = 0x04000,
+  CacheValidate = 0x08000,
+  ResourceValidate = 0x10000,
+  TraceValidate = 0x20000,
   AllValidate = 0x7fffffff
 } ValidateType;
 
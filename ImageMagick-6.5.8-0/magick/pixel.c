@@ -46,6 +46,8 @@
 #include "magick/exception.h"
 #include "magick/exception-private.h"
 #include "magick/cache.h"
+#include "magick/cache-view.h"
+#include "magick/colorspace.h"
 #include "magick/constitute.h"
 #include "magick/delegate.h"
 #include "magick/geometry.h"
@@ -62,43 +64,77 @@
 #include "magick/statistic.h"
 #include "magick/stream.h"
 #include "magick/string_.h"
+#include "magick/thread-private.h"
 #include "magick/utility.h"
 
+/*
+  Define declarations.
+*/
+#define PixelChannelBlock  256
+
+/*
+  Typedef declarations.
+*/
+typedef void
+  (*ExportPixelFormatMethod)(const PixelPacket *__restrict,const size_t,
+    void *__restrict),
+  (*ImportPixelFormatMethod)(const void *__restrict,const size_t,
+    PixelPacket *__restrict);
+
+struct _PixelFormatInfo
+{
+  char
+    *map;
+
+  StorageType
+    storage;
+
+  QuantumType
+    *quantum_map;
+
+  size_t
+    channels,
+    extent;
+
+  MagickBooleanType
+    cmyk,
+    matte;
+
+  ExportPixelFormatMethod
+    export_packets;
+
+  ImportPixelFormatMethod
+    import_packets;
+
+  unsigned long
+    signature;
+};
+
 /*
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 %                                                                             %
 %                                                                             %
 %                                                                             %
-%   E x p o r t I m a g e P i x e l s                                         %
+%   A c q u i r e P i x e l F o r m a t I n f o                               %
 %                                                                             %
 %                                                                             %
 %                                                                             %
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 %
-%  ExportImagePixels() extracts pixel data from an image and returns it to you.
-%  The method returns MagickTrue on success otherwise MagickFalse if an error is
-%  encountered.  The data is returned as char, short int, int, long, float,
-%  or double in the order specified by map.
-%
-%  Suppose you want to extract the first scanline of a 640x480 image as
-%  character data in red-green-blue order:
-%
-%      ExportImagePixels(image,0,0,640,1,"RGB",CharPixel,pixels,exception);
+%  AcquirePixelFormatInfo() compiles a pixel map and storage type into a pixel
+%  format that can be reused to export or import any number of pixels without
+%  parsing the map again.  Use ExportFormattedImagePixels() and
+%  ImportFormattedImagePixels() to transfer image regions or
+%  ExportPixelFormatPackets() and ImportPixelFormatPackets() to convert pixels
+%  you already hold, for example from a cache view.
 %
-%  The format of the ExportImagePixels method is:
+%  The format of the AcquirePixelFormatInfo method is:
 %
-%      MagickBooleanType ExportImagePixels(const Image *image,
-%        const long x_offset,const long y_offset,const unsigned long columns,
-%        const unsigned long rows,const char *map,const StorageType type,
-%        void *pixels,ExceptionInfo *exception)
+%      PixelFormatInfo *AcquirePixelFormatInfo(const char *map,
+%        const StorageType type,ExceptionInfo *exception)
 %
 %  A description of each parameter follows:
 %
-%    o image: the image.
-%
-%    o x_offset,y_offset,columns,rows:  These values define the perimeter
-%      of a region of pixels you want to extract.
-%
 %    o map:  This string reflects the expected ordering of the pixel array.
 %      It can be any combination or order of R = red, G = green, B = blue,
 %      A = alpha (0 is transparent), O = opacity (0 is opaque), C = cyan,
@@ -110,1491 +146,1080 @@
 %      types: CharPixel, DoublePixel, FloatPixel, IntegerPixel, LongPixel,
 %      QuantumPixel, or ShortPixel.
 %
-%    o pixels: This array of values contain the pixel components as defined by
-%      map and type.  You must preallocate this array where the expected
-%      length varies depending on the values of width, height, map, and type.
-%
 %    o exception: return any errors or warnings in this structure.
 %
 */
-MagickExport MagickBooleanType ExportImagePixels(const Image *image,
-  const long x_offset,const long y_offset,const unsigned long columns,
-  const unsigned long rows,const char *map,const StorageType type,void *pixels,
-  ExceptionInfo *exception)
+
+static void ExportBGRACharPixels(const PixelPacket *__restrict p,
+  const size_t number_pixels,void *__restrict pixels)
 {
-  long
-    y;
+  register long
+    x;
 
-  QuantumType
-    *quantum_map;
+  register unsigned char
+    *__restrict q;
+
+  q=(unsigned char *) pixels;
+  for (x=0; x < (long) number_pixels; x++)
+  {
+    q[0]=ScaleQuantumToChar(p[x].blue);
+    q[1]=ScaleQuantumToChar(p[x].green);
+    q[2]=ScaleQuantumToChar(p[x].red);
+    q[3]=ScaleQuantumToChar((Quantum) (QuantumRange-p[x].opacity));
+    q+=4;
+  }
+}
 
+static void ExportBGRCharPixels(const PixelPacket *__restrict p,
+  const size_t number_pixels,void *__restrict pixels)
+{
   register long
-    i,
     x;
 
-  register const IndexPacket
-    *indexes;
+  register unsigned char
+    *__restrict q;
 
-  register const PixelPacket
-    *p;
+  q=(unsigned char *) pixels;
+  for (x=0; x < (long) number_pixels; x++)
+  {
+    q[0]=ScaleQuantumToChar(p[x].blue);
+    q[1]=ScaleQuantumToChar(p[x].green);
+    q[2]=ScaleQuantumToChar(p[x].red);
+    q+=3;
+  }
+}
 
-  size_t
-    length;
+static void ExportICharPixels(const PixelPacket *__restrict p,
+  const size_t number_pixels,void *__restrict pixels)
+{
+  register long
+    x;
 
-  assert(image != (Image *) NULL);
-  assert(image->signature == MagickSignature);
-  if (image->debug != MagickFalse)
-    (void) LogMagickEvent(TraceEvent,GetMagickModule(),"%s",image->filename);
-  length=strlen(map);
-  quantum_map=(QuantumType *) AcquireQuantumMemory(length,sizeof(*quantum_map));
-  if (quantum_map == (QuantumType *) NULL)
-    {
-      (void) ThrowMagickException(exception,GetMagickModule(),
-        ResourceLimitError,"MemoryAllocationFailed","`%s'",image->filename);
-      return(MagickFalse);
-    }
-  for (i=0; i < (long) length; i++)
+  register unsigned char
+    *__restrict q;
+
+  q=(unsigned char *) pixels;
+  for (x=0; x < (long) number_pixels; x++)
+    q[x]=ScaleQuantumToChar(PixelIntensityToQuantum(p+x));
+}
+
+static void ExportRGBACharPixels(const PixelPacket *__restrict p,
+  const size_t number_pixels,void *__restrict pixels)
+{
+  register long
+    x;
+
+  register unsigned char
+    *__restrict q;
+
+  q=(unsigned char *) pixels;
+  for (x=0; x < (long) number_pixels; x++)
   {
-    switch (map[i])
-    {
-      case 'A':
-      case 'a':
-      {
-        quantum_map[i]=AlphaQuantum;
-        break;
-      }
-      case 'B':
-      case 'b':
-      {
-        quantum_map[i]=BlueQuantum;
-        break;
-      }
-      case 'C':
-      case 'c':
-      {
-        quantum_map[i]=CyanQuantum;
-        if (image->colorspace == CMYKColorspace)
-          break;
-        quantum_map=(QuantumType *) RelinquishMagickMemory(quantum_map);
-        (void) ThrowMagickException(exception,GetMagickModule(),ImageError,
-          "ColorSeparatedImageRequired","`%s'",map);
-        return(MagickFalse);
-      }
-      case 'g':
-      case 'G':
-      {
-        quantum_map[i]=GreenQuantum;
-        break;
-      }
-      case 'I':
-      case 'i':
-      {
-        quantum_map[i]=IndexQuantum;
-        break;
-      }
-      case 'K':
-      case 'k':
-      {
-        quantum_map[i]=BlackQuantum;
-        if (image->colorspace == CMYKColorspace)
-          break;
-        quantum_map=(QuantumType *) RelinquishMagickMemory(quantum_map);
-        (void) ThrowMagickException(exception,GetMagickModule(),ImageError,
-          "ColorSeparatedImageRequired","`%s'",map);
-        return(MagickFalse);
-      }
-      case 'M':
-      case 'm':
-      {
-        quantum_map[i]=MagentaQuantum;
-        if (image->colorspace == CMYKColorspace)
-          break;
-        quantum_map=(QuantumType *) RelinquishMagickMemory(quantum_map);
-        (void) ThrowMagickException(exception,GetMagickModule(),ImageError,
-          "ColorSeparatedImageRequired","`%s'",map);
-        return(MagickFalse);
-      }
-      case 'o':
-      case 'O':
-      {
-        quantum_map[i]=OpacityQuantum;
-        break;
-      }
-      case 'P':
-      case 'p':
-      {
-        quantum_map[i]=UndefinedQuantum;
-        break;
-      }
-      case 'R':
-      case 'r':
-      {
-        quantum_map[i]=RedQuantum;
-        break;
-      }
-      case 'Y':
-      case 'y':
-      {
-        quantum_map[i]=YellowQuantum;
-        if (image->colorspace == CMYKColorspace)
-          break;
-        quantum_map=(QuantumType *) RelinquishMagickMemory(quantum_map);
-        (void) ThrowMagickException(exception,GetMagickModule(),ImageError,
-          "ColorSeparatedImageRequired","`%s'",map);
-        return(MagickFalse);
-      }
-      default:
-      {
-        quantum_map=(QuantumType *) RelinquishMagickMemory(quantum_map);
-        (void) ThrowMagickException(exception,GetMagickModule(),OptionError,
-          "UnrecognizedPixelMap","`%s'",map);
-        return(MagickFalse);
-      }
-    }
+    q[0]=ScaleQuantumToChar(p[x].red);
+    q[1]=ScaleQuantumToChar(p[x].green);
+    q[2]=ScaleQuantumToChar(p[x].blue);
+    q[3]=ScaleQuantumToChar((Quantum) (QuantumRange-p[x].opacity));
+    q+=4;
   }
-  switch (type)
-  {
-    case CharPixel:
-    {
-      register unsigned char
-        *q;
+}
 
-      q=(unsigned char *) pixels;
-      if (LocaleCompare(map,"BGR") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            p=GetVirtualPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (p == (const PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              *q++=ScaleQuantumToChar(p->blue);
-              *q++=ScaleQuantumToChar(p->green);
-              *q++=ScaleQuantumToChar(p->red);
-              p++;
-            }
-          }
-          break;
-        }
-      if (LocaleCompare(map,"BGRA") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            p=GetVirtualPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (p == (const PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              *q++=ScaleQuantumToChar(p->blue);
-              *q++=ScaleQuantumToChar(p->green);
-              *q++=ScaleQuantumToChar(p->red);
-              *q++=ScaleQuantumToChar((Quantum) (QuantumRange-p->opacity));
-              p++;
-            }
-          }
-          break;
-        }
-      if (LocaleCompare(map,"BGRP") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            p=GetVirtualPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (p == (const PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              *q++=ScaleQuantumToChar(p->blue);
-              *q++=ScaleQuantumToChar(p->green);
-              *q++=ScaleQuantumToChar(p->red);
-              *q++=ScaleQuantumToChar((Quantum) 0);
-              p++;
-            }
-          }
-          break;
-        }
-      if (LocaleCompare(map,"I") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            p=GetVirtualPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (p == (const PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              *q++=ScaleQuantumToChar(PixelIntensityToQuantum(p));
-              p++;
-            }
-          }
-          break;
-        }
-      if (LocaleCompare(map,"RGB") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            p=GetVirtualPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (p == (const PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              *q++=ScaleQuantumToChar(p->red);
-              *q++=ScaleQuantumToChar(p->green);
-              *q++=ScaleQuantumToChar(p->blue);
-              p++;
-            }
-          }
-          break;
-        }
-      if (LocaleCompare(map,"RGBA") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            p=GetVirtualPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (p == (const PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              *q++=ScaleQuantumToChar(p->red);
-              *q++=ScaleQuantumToChar(p->green);
-              *q++=ScaleQuantumToChar(p->blue);
-              *q++=ScaleQuantumToChar((Quantum) (QuantumRange-p->opacity));
-              p++;
-            }
-          }
-          break;
-        }
-      if (LocaleCompare(map,"RGBP") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            p=GetVirtualPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (p == (const PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              *q++=ScaleQuantumToChar(p->red);
-              *q++=ScaleQuantumToChar(p->green);
-              *q++=ScaleQuantumToChar(p->blue);
-              *q++=ScaleQuantumToChar((Quantum) 0);
-              p++;
-            }
-          }
-          break;
-        }
-      for (y=0; y < (long) rows; y++)
-      {
-        p=GetVirtualPixels(image,x_offset,y_offset+y,columns,1,exception);
-        if (p == (const PixelPacket *) NULL)
-          break;
-        indexes=GetVirtualIndexQueue(image);
-        for (x=0; x < (long) columns; x++)
-        {
-          for (i=0; i < (long) length; i++)
-          {
-            *q=0;
-            switch (quantum_map[i])
-            {
-              case RedQuantum:
-              case CyanQuantum:
-              {
-                *q=ScaleQuantumToChar(p->red);
-                break;
-              }
-              case GreenQuantum:
-              case MagentaQuantum:
-              {
-                *q=ScaleQuantumToChar(p->green);
-                break;
-              }
-              case BlueQuantum:
-              case YellowQuantum:
-              {
-                *q=ScaleQuantumToChar(p->blue);
-                break;
-              }
-              case AlphaQuantum:
-              {
-                *q=ScaleQuantumToChar((Quantum) (QuantumRange-p->opacity));
-                break;
-              }
-              case OpacityQuantum:
-              {
-                *q=ScaleQuantumToChar(p->opacity);
-                break;
-              }
-              case BlackQuantum:
-              {
-                if (image->colorspace == CMYKColorspace)
-                  *q=ScaleQuantumToChar(indexes[x]);
-                break;
-              }
-              case IndexQuantum:
-              {
-                *q=ScaleQuantumToChar(PixelIntensityToQuantum(p));
-                break;
-              }
-              default:
-                break;
-            }
-            q++;
-          }
-          p++;
-        }
-      }
-      break;
-    }
-    case DoublePixel:
-    {
-      register double
-        *q;
+static void ExportRGBADoublePixels(const PixelPacket *__restrict p,
+  const size_t number_pixels,void *__restrict pixels)
+{
+  register long
+    x;
 
-      q=(double *) pixels;
-      if (LocaleCompare(map,"BGR") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            p=GetVirtualPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (p == (const PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              *q++=(double) (QuantumScale*p->blue);
-              *q++=(double) (QuantumScale*p->green);
-              *q++=(double) (QuantumScale*p->red);
-              p++;
-            }
-          }
-          break;
-        }
-      if (LocaleCompare(map,"BGRA") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            p=GetVirtualPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (p == (const PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              *q++=(double) (QuantumScale*p->blue);
-              *q++=(double) (QuantumScale*p->green);
-              *q++=(double) (QuantumScale*p->red);
-              *q++=(double) (QuantumScale*((Quantum) (QuantumRange-
-                p->opacity)));
-              p++;
-            }
-          }
-          break;
-        }
-      if (LocaleCompare(map,"BGRP") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            p=GetVirtualPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (p == (const PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              *q++=(double) (QuantumScale*p->blue);
-              *q++=(double) (QuantumScale*p->green);
-              *q++=(double) (QuantumScale*p->red);
-              *q++=0.0;
-              p++;
-            }
-          }
-          break;
-        }
-      if (LocaleCompare(map,"I") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            p=GetVirtualPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (p == (const PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              *q++=(double) (QuantumScale*PixelIntensityToQuantum(p));
-              p++;
-            }
-          }
-          break;
-        }
-      if (LocaleCompare(map,"RGB") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            p=GetVirtualPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (p == (const PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              *q++=(double) (QuantumScale*p->red);
-              *q++=(double) (QuantumScale*p->green);
-              *q++=(double) (QuantumScale*p->blue);
-              p++;
-            }
-          }
-          break;
-        }
-      if (LocaleCompare(map,"RGBA") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            p=GetVirtualPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (p == (const PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              *q++=(double) (QuantumScale*p->red);
-              *q++=(double) (QuantumScale*p->green);
-              *q++=(double) (QuantumScale*p->blue);
-              *q++=(double) (QuantumScale*((Quantum) (QuantumRange-
-                p->opacity)));
-              p++;
-            }
-          }
-          break;
-        }
-      if (LocaleCompare(map,"RGBP") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            p=GetVirtualPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (p == (const PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              *q++=(double) (QuantumScale*p->red);
-              *q++=(double) (QuantumScale*p->green);
-              *q++=(double) (QuantumScale*p->blue);
-              *q++=0.0;
-              p++;
-            }
-          }
-          break;
-        }
-      for (y=0; y < (long) rows; y++)
-      {
-        p=GetVirtualPixels(image,x_offset,y_offset+y,columns,1,exception);
-        if (p == (const PixelPacket *) NULL)
-          break;
-        indexes=GetVirtualIndexQueue(image);
-        for (x=0; x < (long) columns; x++)
-        {
-          for (i=0; i < (long) length; i++)
-          {
-            *q=0;
-            switch (quantum_map[i])
-            {
-              case RedQuantum:
-              case CyanQuantum:
-              {
-                *q=(double) (QuantumScale*p->red);
-                break;
-              }
-              case GreenQuantum:
-              case MagentaQuantum:
-              {
-                *q=(double) (QuantumScale*p->green);
-                break;
-              }
-              case BlueQuantum:
-              case YellowQuantum:
-              {
-                *q=(double) (QuantumScale*p->blue);
-                break;
-              }
-              case AlphaQuantum:
-              {
-                *q=(double) (QuantumScale*((Quantum) (QuantumRange-
-                  p->opacity)));
-                break;
-              }
-              case OpacityQuantum:
-              {
-                *q=(double) (QuantumScale*p->opacity);
-                break;
-              }
-              case BlackQuantum:
-              {
-                if (image->colorspace == CMYKColorspace)
-                  *q=(double) (QuantumScale*indexes[x]);
-                break;
-              }
-              case IndexQuantum:
-              {
-                *q=(double) (QuantumScale*PixelIntensityToQuantum(p));
-                break;
-              }
-              default:
-                *q=0;
-            }
-            q++;
-          }
-          p++;
-        }
-      }
-      break;
-    }
-    case FloatPixel:
-    {
-      register float
-        *q;
+  register double
+    *__restrict q;
 
-      q=(float *) pixels;
+  q=(double *) pixels;
+  for (x=0; x < (long) number_pixels; x++)
+  {
+    q[0]=(double) (QuantumScale*p[x].red);
+    q[1]=(double) (QuantumScale*p[x].green);
+    q[2]=(double) (QuantumScale*p[x].blue);
+    q[3]=(double) (QuantumScale*((Quantum) (QuantumRange-p[x].opacity)));
+    q+=4;
+  }
+}
+
+static void ExportRGBAFloatPixels(const PixelPacket *__restrict p,
+  const size_t number_pixels,void *__restrict pixels)
+{
+  register long
+    x;
+
+  register float
+    *__restrict q;
+
+  q=(float *) pixels;
+  for (x=0; x < (long) number_pixels; x++)
+  {
+    q[0]=(float) (QuantumScale*p[x].red);
+    q[1]=(float) (QuantumScale*p[x].green);
+    q[2]=(float) (QuantumScale*p[x].blue);
+    q[3]=(float) (QuantumScale*((Quantum) (QuantumRange-p[x].opacity)));
+    q+=4;
+  }
+}
+
+static void ExportRGBAShortPixels(const PixelPacket *__restrict p,
+  const size_t number_pixels,void *__restrict pixels)
+{
+  register long
+    x;
+
+  register unsigned short
+    *__restrict q;
+
+  q=(unsigned short *) pixels;
+  for (x=0; x < (long) number_pixels; x++)
+  {
+    q[0]=ScaleQuantumToShort(p[x].red);
+    q[1]=ScaleQuantumToShort(p[x].green);
+    q[2]=ScaleQuantumToShort(p[x].blue);
+    q[3]=ScaleQuantumToShort((Quantum) (QuantumRange-p[x].opacity));
+    q+=4;
+  }
+}
+
+static void ExportRGBCharPixels(const PixelPacket *__restrict p,
+  const size_t number_pixels,void *__restrict pixels)
+{
+  register long
+    x;
+
+  register unsigned char
+    *__restrict q;
+
+  q=(unsigned char *) pixels;
+  for (x=0; x < (long) number_pixels; x++)
+  {
+    q[0]=ScaleQuantumToChar(p[x].red);
+    q[1]=ScaleQuantumToChar(p[x].green);
+    q[2]=ScaleQuantumToChar(p[x].blue);
+    q+=3;
+  }
+}
+
+static void ExportRGBDoublePixels(const PixelPacket *__restrict p,
+  const size_t number_pixels,void *__restrict pixels)
+{
+  register long
+    x;
+
+  register double
+    *__restrict q;
+
+  q=(double *) pixels;
+  for (x=0; x < (long) number_pixels; x++)
+  {
+    q[0]=(double) (QuantumScale*p[x].red);
+    q[1]=(double) (QuantumScale*p[x].green);
+    q[2]=(double) (QuantumScale*p[x].blue);
+    q+=3;
+  }
+}
+
+static void ExportRGBFloatPixels(const PixelPacket *__restrict p,
+  const size_t number_pixels,void *__restrict pixels)
+{
+  register long
+    x;
+
+  register float
+    *__restrict q;
+
+  q=(float *) pixels;
+  for (x=0; x < (long) number_pixels; x++)
+  {
+    q[0]=(float) (QuantumScale*p[x].red);
+    q[1]=(float) (QuantumScale*p[x].green);
+    q[2]=(float) (QuantumScale*p[x].blue);
+    q+=3;
+  }
+}
+
+static void ExportRGBShortPixels(const PixelPacket *__restrict p,
+  const size_t number_pixels,void *__restrict pixels)
+{
+  register long
+    x;
+
+  register unsigned short
+    *__restrict q;
+
+  q=(unsigned short *) pixels;
+  for (x=0; x < (long) number_pixels; x++)
+  {
+    q[0]=ScaleQuantumToShort(p[x].red);
+    q[1]=ScaleQuantumToShort(p[x].green);
+    q[2]=ScaleQuantumToShort(p[x].blue);
+    q+=3;
+  }
+}
+
+static void ImportBGRACharPixels(const void *__restrict pixels,
+  const size_t number_pixels,PixelPacket *__restrict q)
+{
+  register const unsigned char
+    *__restrict p;
+
+  register long
+    x;
+
+  p=(const unsigned char *) pixels;
+  for (x=0; x < (long) number_pixels; x++)
+  {
+    q[x].blue=ScaleCharToQuantum(p[0]);
+    q[x].green=ScaleCharToQuantum(p[1]);
+    q[x].red=ScaleCharToQuantum(p[2]);
+    q[x].opacity=(Quantum) QuantumRange-ScaleCharToQuantum(p[3]);
+    p+=4;
+  }
+}
+
+static void ImportBGRCharPixels(const void *__restrict pixels,
+  const size_t number_pixels,PixelPacket *__restrict q)
+{
+  register const unsigned char
+    *__restrict p;
+
+  register long
+    x;
+
+  p=(const unsigned char *) pixels;
+  for (x=0; x < (long) number_pixels; x++)
+  {
+    q[x].blue=ScaleCharToQuantum(p[0]);
+    q[x].green=ScaleCharToQuantum(p[1]);
+    q[x].red=ScaleCharToQuantum(p[2]);
+    p+=3;
+  }
+}
+
+static void ImportICharPixels(const void *__restrict pixels,
+  const size_t number_pixels,PixelPacket *__restrict q)
+{
+  register const unsigned char
+    *__restrict p;
+
+  register long
+    x;
+
+  p=(const unsigned char *) pixels;
+  for (x=0; x < (long) number_pixels; x++)
+  {
+    q[x].red=ScaleCharToQuantum(p[x]);
+    q[x].green=q[x].red;
+    q[x].blue=q[x].red;
+  }
+}
+
+static void ImportRGBACharPixels(const void *__restrict pixels,
+  const size_t number_pixels,PixelPacket *__restrict q)
+{
+  register const unsigned char
+    *__restrict p;
+
+  register long
+    x;
+
+  p=(const unsigned char *) pixels;
+  for (x=0; x < (long) number_pixels; x++)
+  {
+    q[x].red=ScaleCharToQuantum(p[0]);
+    q[x].green=ScaleCharToQuantum(p[1]);
+    q[x].blue=ScaleCharToQuantum(p[2]);
+    q[x].opacity=(Quantum) QuantumRange-ScaleCharToQuantum(p[3]);
+    p+=4;
+  }
+}
+
+static void ImportRGBADoublePixels(const void *__restrict pixels,
+  const size_t number_pixels,PixelPacket *__restrict q)
+{
+  register const double
+    *__restrict p;
+
+  register long
+    x;
+
+  p=(const double *) pixels;
+  for (x=0; x < (long) number_pixels; x++)
+  {
+    q[x].red=RoundToQuantum((MagickRealType) QuantumRange*p[0]);
+    q[x].green=RoundToQuantum((MagickRealType) QuantumRange*p[1]);
+    q[x].blue=RoundToQuantum((MagickRealType) QuantumRange*p[2]);
+    q[x].opacity=(Quantum) QuantumRange-RoundToQuantum((MagickRealType)
+      QuantumRange*p[3]);
+    p+=4;
+  }
+}
+
+static void ImportRGBAFloatPixels(const void *__restrict pixels,
+  const size_t number_pixels,PixelPacket *__restrict q)
+{
+  register const float
+    *__restrict p;
+
+  register long
+    x;
+
+  p=(const float *) pixels;
+  for (x=0; x < (long) number_pixels; x++)
+  {
+    q[x].red=RoundToQuantum((MagickRealType) QuantumRange*p[0]);
+    q[x].green=RoundToQuantum((MagickRealType) QuantumRange*p[1]);
+    q[x].blue=RoundToQuantum((MagickRealType) QuantumRange*p[2]);
+    q[x].opacity=(Quantum) QuantumRange-RoundToQuantum((MagickRealType)
+      QuantumRange*p[3]);
+    p+=4;
+  }
+}
+
+static void ImportRGBAShortPixels(const void *__restrict pixels,
+  const size_t number_pixels,PixelPacket *__restrict q)
+{
+  register const unsigned short
+    *__restrict p;
+
+  register long
+    x;
+
+  p=(const unsigned short *) pixels;
+  for (x=0; x < (long) number_pixels; x++)
+  {
+    q[x].red=ScaleShortToQuantum(p[0]);
+    q[x].green=ScaleShortToQuantum(p[1]);
+    q[x].blue=ScaleShortToQuantum(p[2]);
+    q[x].opacity=(Quantum) QuantumRange-ScaleShortToQuantum(p[3]);
+    p+=4;
+  }
+}
+
+static void ImportRGBCharPixels(const void *__restrict pixels,
+  const size_t number_pixels,PixelPacket *__restrict q)
+{
+  register const unsigned char
+    *__restrict p;
+
+  register long
+    x;
+
+  p=(const unsigned char *) pixels;
+  for (x=0; x < (long) number_pixels; x++)
+  {
+    q[x].red=ScaleCharToQuantum(p[0]);
+    q[x].green=ScaleCharToQuantum(p[1]);
+    q[x].blue=ScaleCharToQuantum(p[2]);
+    p+=3;
+  }
+}
+
+static void ImportRGBDoublePixels(const void *__restrict pixels,
+  const size_t number_pixels,PixelPacket *__restrict q)
+{
+  register const double
+    *__restrict p;
+
+  register long
+    x;
+
+  p=(const double *) pixels;
+  for (x=0; x < (long) number_pixels; x++)
+  {
+    q[x].red=RoundToQuantum((MagickRealType) QuantumRange*p[0]);
+    q[x].green=RoundToQuantum((MagickRealType) QuantumRange*p[1]);
+    q[x].blue=RoundToQuantum((MagickRealType) QuantumRange*p[2]);
+    p+=3;
+  }
+}
+
+static void ImportRGBFloatPixels(const void *__restrict pixels,
+  const size_t number_pixels,PixelPacket *__restrict q)
+{
+  register const float
+    *__restrict p;
+
+  register long
+    x;
+
+  p=(const float *) pixels;
+  for (x=0; x < (long) number_pixels; x++)
+  {
+    q[x].red=RoundToQuantum((MagickRealType) QuantumRange*p[0]);
+    q[x].green=RoundToQuantum((MagickRealType) QuantumRange*p[1]);
+    q[x].blue=RoundToQuantum((MagickRealType) QuantumRange*p[2]);
+    p+=3;
+  }
+}
+
+static void ImportRGBShortPixels(const void *__restrict pixels,
+  const size_t number_pixels,PixelPacket *__restrict q)
+{
+  register const unsigned short
+    *__restrict p;
+
+  register long
+    x;
+
+  p=(const unsigned short *) pixels;
+  for (x=0; x < (long) number_pixels; x++)
+  {
+    q[x].red=ScaleShortToQuantum(p[0]);
+    q[x].green=ScaleShortToQuantum(p[1]);
+    q[x].blue=ScaleShortToQuantum(p[2]);
+    p+=3;
+  }
+}
+
+MagickExport PixelFormatInfo *AcquirePixelFormatInfo(const char *map,
+  const StorageType type,ExceptionInfo *exception)
+{
+  PixelFormatInfo
+    *format_info;
+
+  register long
+    i;
+
+  size_t
+    length,
+    quantum;
+
+  assert(map != (const char *) NULL);
+  assert(exception != (ExceptionInfo *) NULL);
+  switch (type)
+  {
+    case CharPixel:
+    {
+      quantum=sizeof(unsigned char);
+      break;
+    }
+    case DoublePixel:
+    {
+      quantum=sizeof(double);
+      break;
+    }
+    case FloatPixel:
+    {
+      quantum=sizeof(float);
+      break;
+    }
+    case IntegerPixel:
+    {
+      quantum=sizeof(unsigned int);
+      break;
+    }
+    case LongPixel:
+    {
+      quantum=sizeof(unsigned long);
+      break;
+    }
+    case QuantumPixel:
+    {
+      quantum=sizeof(Quantum);
+      break;
+    }
+    case ShortPixel:
+    {
+      quantum=sizeof(unsigned short);
+      break;
+    }
+    default:
+    {
+      (void) ThrowMagickException(exception,GetMagickModule(),OptionError,
+        "UnrecognizedStorageType","`%s'",map);
+      return((PixelFormatInfo *) NULL);
+    }
+  }
+  length=strlen(map);
+  if (length == 0)
+    {
+      (void) ThrowMagickException(exception,GetMagickModule(),OptionError,
+        "UnrecognizedPixelMap","`%s'",map);
+      return((PixelFormatInfo *) NULL);
+    }
+  format_info=(PixelFormatInfo *) AcquireAlignedMemory(1,sizeof(*format_info));
+  if (format_info == (PixelFormatInfo *) NULL)
+    ThrowFatalException(ResourceLimitFatalError,"MemoryAllocationFailed");
+  (void) ResetMagickMemory(format_info,0,sizeof(*format_info));
+  format_info->map=ConstantString(map);
+  format_info->storage=type;
+  format_info->channels=length;
+  format_info->extent=length*quantum;
+  format_info->quantum_map=(QuantumType *) AcquireQuantumMemory(length,
+    sizeof(*format_info->quantum_map));
+  if (format_info->quantum_map == (QuantumType *) NULL)
+    ThrowFatalException(ResourceLimitFatalError,"MemoryAllocationFailed");
+  for (i=0; i < (long) length; i++)
+  {
+    switch (map[i])
+    {
+      case 'A':
+      case 'a':
+      {
+        format_info->quantum_map[i]=AlphaQuantum;
+        format_info->matte=MagickTrue;
+        break;
+      }
+      case 'B':
+      case 'b':
+      {
+        format_info->quantum_map[i]=BlueQuantum;
+        break;
+      }
+      case 'C':
+      case 'c':
+      {
+        format_info->quantum_map[i]=CyanQuantum;
+        format_info->cmyk=MagickTrue;
+        break;
+      }
+      case 'g':
+      case 'G':
+      {
+        format_info->quantum_map[i]=GreenQuantum;
+        break;
+      }
+      case 'I':
+      case 'i':
+      {
+        format_info->quantum_map[i]=IndexQuantum;
+        break;
+      }
+      case 'K':
+      case 'k':
+      {
+        format_info->quantum_map[i]=BlackQuantum;
+        format_info->cmyk=MagickTrue;
+        break;
+      }
+      case 'M':
+      case 'm':
+      {
+        format_info->quantum_map[i]=MagentaQuantum;
+        format_info->cmyk=MagickTrue;
+        break;
+      }
+      case 'o':
+      case 'O':
+      {
+        format_info->quantum_map[i]=OpacityQuantum;
+        format_info->matte=MagickTrue;
+        break;
+      }
+      case 'P':
+      case 'p':
+      {
+        format_info->quantum_map[i]=UndefinedQuantum;
+        break;
+      }
+      case 'R':
+      case 'r':
+      {
+        format_info->quantum_map[i]=RedQuantum;
+        break;
+      }
+      case 'Y':
+      case 'y':
+      {
+        format_info->quantum_map[i]=YellowQuantum;
+        format_info->cmyk=MagickTrue;
+        break;
+      }
+      default:
+      {
+        (void) ThrowMagickException(exception,GetMagickModule(),OptionError,
+          "UnrecognizedPixelMap","`%s'",map);
+        return(DestroyPixelFormatInfo(format_info));
+      }
+    }
+  }
+  /*
+    The most common packed layouts get a kernel that converts a whole pixel
+    per iteration.
+  */
+  if (type == CharPixel)
+    {
       if (LocaleCompare(map,"BGR") == 0)
         {
-          for (y=0; y < (long) rows; y++)
-          {
-            p=GetVirtualPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (p == (const PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              *q++=(float) (QuantumScale*p->blue);
-              *q++=(float) (QuantumScale*p->green);
-              *q++=(float) (QuantumScale*p->red);
-              p++;
-            }
-          }
-          break;
+          format_info->export_packets=ExportBGRCharPixels;
+          format_info->import_packets=ImportBGRCharPixels;
         }
       if (LocaleCompare(map,"BGRA") == 0)
         {
-          for (y=0; y < (long) rows; y++)
-          {
-            p=GetVirtualPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (p == (const PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              *q++=(float) (QuantumScale*p->blue);
-              *q++=(float) (QuantumScale*p->green);
-              *q++=(float) (QuantumScale*p->red);
-              *q++=(float) (QuantumScale*(Quantum) (QuantumRange-p->opacity));
-              p++;
-            }
-          }
-          break;
+          format_info->export_packets=ExportBGRACharPixels;
+          format_info->import_packets=ImportBGRACharPixels;
         }
-      if (LocaleCompare(map,"BGRP") == 0)
+      if (LocaleCompare(map,"I") == 0)
         {
-          for (y=0; y < (long) rows; y++)
-          {
-            p=GetVirtualPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (p == (const PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              *q++=(float) (QuantumScale*p->blue);
-              *q++=(float) (QuantumScale*p->green);
-              *q++=(float) (QuantumScale*p->red);
-              *q++=0.0;
-              p++;
-            }
-          }
-          break;
+          format_info->export_packets=ExportICharPixels;
+          format_info->import_packets=ImportICharPixels;
         }
-      if (LocaleCompare(map,"I") == 0)
+      if (LocaleCompare(map,"RGB") == 0)
         {
-          for (y=0; y < (long) rows; y++)
-          {
-            p=GetVirtualPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (p == (const PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              *q++=(float) (QuantumScale*PixelIntensityToQuantum(p));
-              p++;
-            }
-          }
-          break;
+          format_info->export_packets=ExportRGBCharPixels;
+          format_info->import_packets=ImportRGBCharPixels;
+        }
+      if (LocaleCompare(map,"RGBA") == 0)
+        {
+          format_info->export_packets=ExportRGBACharPixels;
+          format_info->import_packets=ImportRGBACharPixels;
         }
+    }
+  if (type == DoublePixel)
+    {
       if (LocaleCompare(map,"RGB") == 0)
         {
-          for (y=0; y < (long) rows; y++)
-          {
-            p=GetVirtualPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (p == (const PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              *q++=(float) (QuantumScale*p->red);
-              *q++=(float) (QuantumScale*p->green);
-              *q++=(float) (QuantumScale*p->blue);
-              p++;
-            }
-          }
-          break;
+          format_info->export_packets=ExportRGBDoublePixels;
+          format_info->import_packets=ImportRGBDoublePixels;
         }
       if (LocaleCompare(map,"RGBA") == 0)
         {
-          for (y=0; y < (long) rows; y++)
-          {
-            p=GetVirtualPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (p == (const PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              *q++=(float) (QuantumScale*p->red);
-              *q++=(float) (QuantumScale*p->green);
-              *q++=(float) (QuantumScale*p->blue);
-              *q++=(float) (QuantumScale*((Quantum) (QuantumRange-p->opacity)));
-              p++;
-            }
-          }
-          break;
+          format_info->export_packets=ExportRGBADoublePixels;
+          format_info->import_packets=ImportRGBADoublePixels;
         }
-      if (LocaleCompare(map,"RGBP") == 0)
+    }
+  if (type == FloatPixel)
+    {
+      if (LocaleCompare(map,"RGB") == 0)
         {
-          for (y=0; y < (long) rows; y++)
-          {
-            p=GetVirtualPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (p == (const PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              *q++=(float) (QuantumScale*p->red);
-              *q++=(float) (QuantumScale*p->green);
-              *q++=(float) (QuantumScale*p->blue);
-              *q++=0.0;
-              p++;
-            }
-          }
-          break;
+          format_info->export_packets=ExportRGBFloatPixels;
+          format_info->import_packets=ImportRGBFloatPixels;
         }
-      for (y=0; y < (long) rows; y++)
-      {
-        p=GetVirtualPixels(image,x_offset,y_offset+y,columns,1,exception);
-        if (p == (const PixelPacket *) NULL)
-          break;
-        indexes=GetVirtualIndexQueue(image);
-        for (x=0; x < (long) columns; x++)
+      if (LocaleCompare(map,"RGBA") == 0)
         {
-          for (i=0; i < (long) length; i++)
-          {
-            *q=0;
-            switch (quantum_map[i])
-            {
-              case RedQuantum:
-              case CyanQuantum:
-              {
-                *q=(float) (QuantumScale*p->red);
-                break;
-              }
-              case GreenQuantum:
-              case MagentaQuantum:
-              {
-                *q=(float) (QuantumScale*p->green);
-                break;
-              }
-              case BlueQuantum:
-              case YellowQuantum:
-              {
-                *q=(float) (QuantumScale*p->blue);
-                break;
-              }
-              case AlphaQuantum:
-              {
-                *q=(float) (QuantumScale*((Quantum) (QuantumRange-p->opacity)));
-                break;
-              }
-              case OpacityQuantum:
-              {
-                *q=(float) (QuantumScale*p->opacity);
-                break;
-              }
-              case BlackQuantum:
-              {
-                if (image->colorspace == CMYKColorspace)
-                  *q=(float) (QuantumScale*indexes[x]);
-                break;
-              }
-              case IndexQuantum:
-              {
-                *q=(float) (QuantumScale*PixelIntensityToQuantum(p));
-                break;
-              }
-              default:
-                *q=0;
-            }
-            q++;
-          }
-          p++;
+          format_info->export_packets=ExportRGBAFloatPixels;
+          format_info->import_packets=ImportRGBAFloatPixels;
+        }
+    }
+  if (type == ShortPixel)
+    {
+      if (LocaleCompare(map,"RGB") == 0)
+        {
+          format_info->export_packets=ExportRGBShortPixels;
+          format_info->import_packets=ImportRGBShortPixels;
+        }
+      if (LocaleCompare(map,"RGBA") == 0)
+        {
+          format_info->export_packets=ExportRGBAShortPixels;
+          format_info->import_packets=ImportRGBAShortPixels;
         }
+    }
+  format_info->signature=MagickSignature;
+  return(format_info);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   D e s t r o y P i x e l F o r m a t I n f o                               %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  DestroyPixelFormatInfo() deallocates memory associated with a pixel format.
+%
+%  The format of the DestroyPixelFormatInfo method is:
+%
+%      PixelFormatInfo *DestroyPixelFormatInfo(PixelFormatInfo *format_info)
+%
+%  A description of each parameter follows:
+%
+%    o format_info: the pixel format.
+%
+*/
+MagickExport PixelFormatInfo *DestroyPixelFormatInfo(
+  PixelFormatInfo *format_info)
+{
+  assert(format_info != (PixelFormatInfo *) NULL);
+  if (format_info->quantum_map != (QuantumType *) NULL)
+    format_info->quantum_map=(QuantumType *)
+      RelinquishMagickMemory(format_info->quantum_map);
+  if (format_info->map != (char *) NULL)
+    format_info->map=DestroyString(format_info->map);
+  format_info->signature=(~MagickSignature);
+  format_info=(PixelFormatInfo *) RelinquishAlignedMemory(format_info);
+  return(format_info);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   E x p o r t F o r m a t t e d I m a g e P i x e l s                       %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  ExportFormattedImagePixels() extracts pixel data from an image in the
+%  layout defined by a pixel format returned by AcquirePixelFormatInfo().
+%  Large regions are converted in parallel.
+%
+%  The format of the ExportFormattedImagePixels method is:
+%
+%      MagickBooleanType ExportFormattedImagePixels(const Image *image,
+%        const long x_offset,const long y_offset,const unsigned long columns,
+%        const unsigned long rows,const PixelFormatInfo *format_info,
+%        void *pixels,ExceptionInfo *exception)
+%
+%  A description of each parameter follows:
+%
+%    o image: the image.
+%
+%    o x_offset,y_offset,columns,rows:  These values define the perimeter
+%      of a region of pixels you want to extract.
+%
+%    o format_info: the pixel format.
+%
+%    o pixels: This array of values contain the pixel components as defined by
+%      the pixel format.  You must preallocate this array where the expected
+%      length is columns*rows*GetPixelFormatExtent(format_info) bytes.
+%
+%    o exception: return any errors or warnings in this structure.
+%
+*/
+MagickExport MagickBooleanType ExportFormattedImagePixels(const Image *image,
+  const long x_offset,const long y_offset,const unsigned long columns,
+  const unsigned long rows,const PixelFormatInfo *format_info,void *pixels,
+  ExceptionInfo *exception)
+{
+  CacheView
+    *image_view;
+
+  long
+    y;
+
+  MagickBooleanType
+    status;
+
+  assert(image != (Image *) NULL);
+  assert(image->signature == MagickSignature);
+  if (image->debug != MagickFalse)
+    (void) LogMagickEvent(TraceEvent,GetMagickModule(),"%s",image->filename);
+  assert(format_info != (const PixelFormatInfo *) NULL);
+  assert(format_info->signature == MagickSignature);
+  if ((format_info->cmyk != MagickFalse) &&
+      (image->colorspace != CMYKColorspace))
+    {
+      (void) ThrowMagickException(exception,GetMagickModule(),ImageError,
+        "ColorSeparatedImageRequired","`%s'",format_info->map);
+      return(MagickFalse);
+    }
+  status=MagickTrue;
+  image_view=AcquireCacheView(image);
+#if defined(MAGICKCORE_OPENMP_SUPPORT)
+  #pragma omp parallel for shared(status) \
+    magick_schedule(PointThreadCost,columns,rows)
+#endif
+  for (y=0; y < (long) rows; y++)
+  {
+    register const PixelPacket
+      *__restrict p;
+
+    if (status == MagickFalse)
+      continue;
+    p=GetCacheViewVirtualPixels(image_view,x_offset,y_offset+y,columns,1,
+      exception);
+    if (p == (const PixelPacket *) NULL)
+      {
+        status=MagickFalse;
+        continue;
       }
-      break;
+    ExportPixelFormatPackets(format_info,p,GetCacheViewVirtualIndexQueue(
+      image_view),columns,(unsigned char *) pixels+y*columns*
+      format_info->extent);
+  }
+  image_view=DestroyCacheView(image_view);
+  return(status);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   E x p o r t I m a g e P i x e l s                                         %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  ExportImagePixels() extracts pixel data from an image and returns it to you.
+%  The method returns MagickTrue on success otherwise MagickFalse if an error is
+%  encountered.  The data is returned as char, short int, int, long, float,
+%  or double in the order specified by map.
+%
+%  Suppose you want to extract the first scanline of a 640x480 image as
+%  character data in red-green-blue order:
+%
+%      ExportImagePixels(image,0,0,640,1,"RGB",CharPixel,pixels,exception);
+%
+%  The format of the ExportImagePixels method is:
+%
+%      MagickBooleanType ExportImagePixels(const Image *image,
+%        const long x_offset,const long y_offset,const unsigned long columns,
+%        const unsigned long rows,const char *map,const StorageType type,
+%        void *pixels,ExceptionInfo *exception)
+%
+%  A description of each parameter follows:
+%
+%    o image: the image.
+%
+%    o x_offset,y_offset,columns,rows:  These values define the perimeter
+%      of a region of pixels you want to extract.
+%
+%    o map:  This string reflects the expected ordering of the pixel array.
+%      It can be any combination or order of R = red, G = green, B = blue,
+%      A = alpha (0 is transparent), O = opacity (0 is opaque), C = cyan,
+%      Y = yellow, M = magenta, K = black, I = intensity (for grayscale),
+%      P = pad.
+%
+%    o type: Define the data type of the pixels.  Float and double types are
+%      normalized to [0..1] otherwise [0..QuantumRange].  Choose from these
+%      types: CharPixel, DoublePixel, FloatPixel, IntegerPixel, LongPixel,
+%      QuantumPixel, or ShortPixel.
+%
+%    o pixels: This array of values contain the pixel components as defined by
+%      map and type.  You must preallocate this array where the expected
+%      length varies depending on the values of width, height, map, and type.
+%
+%    o exception: return any errors or warnings in this structure.
+%
+*/
+MagickExport MagickBooleanType ExportImagePixels(const Image *image,
+  const long x_offset,const long y_offset,const unsigned long columns,
+  const unsigned long rows,const char *map,const StorageType type,void *pixels,
+  ExceptionInfo *exception)
+{
+  MagickBooleanType
+    status;
+
+  PixelFormatInfo
+    *format_info;
+
+  assert(image != (Image *) NULL);
+  assert(image->signature == MagickSignature);
+  if (image->debug != MagickFalse)
+    (void) LogMagickEvent(TraceEvent,GetMagickModule(),"%s",image->filename);
+  format_info=AcquirePixelFormatInfo(map,type,exception);
+  if (format_info == (PixelFormatInfo *) NULL)
+    return(MagickFalse);
+  status=ExportFormattedImagePixels(image,x_offset,y_offset,columns,rows,
+    format_info,pixels,exception);
+  format_info=DestroyPixelFormatInfo(format_info);
+  return(status);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   E x p o r t P i x e l F o r m a t P a c k e t s                           %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  ExportPixelFormatPackets() converts a run of pixel packets, such as a row
+%  returned by GetCacheViewVirtualPixels(), to the layout defined by a pixel
+%  format.  The pixels are converted one channel at a time in short blocks so
+%  the map is interpreted once per block rather than once per sample and each
+%  inner loop is a straight conversion whatever the channel order.
+%
+%  The format of the ExportPixelFormatPackets method is:
+%
+%      void ExportPixelFormatPackets(const PixelFormatInfo *format_info,
+%        const PixelPacket *p,const IndexPacket *indexes,
+%        const size_t number_pixels,void *pixels)
+%
+%  A description of each parameter follows:
+%
+%    o format_info: the pixel format.
+%
+%    o p: the pixel packets.
+%
+%    o indexes: the black channel of CMYK pixels, otherwise NULL.
+%
+%    o number_pixels: the number of pixels to convert.
+%
+%    o pixels: the converted pixels.
+%
+*/
+
+static inline const Quantum *ExportPixelChannel(
+  const QuantumType quantum_type,const PixelPacket *__restrict p,
+  const IndexPacket *__restrict indexes,const size_t number_pixels,
+  Quantum *__restrict channel,size_t *step)
+{
+  register long
+    x;
+
+  *step=sizeof(*p)/sizeof(Quantum);
+  switch (quantum_type)
+  {
+    case RedQuantum:
+    case CyanQuantum:
+      return(&p->red);
+    case GreenQuantum:
+    case MagentaQuantum:
+      return(&p->green);
+    case BlueQuantum:
+    case YellowQuantum:
+      return(&p->blue);
+    case OpacityQuantum:
+      return(&p->opacity);
+    case BlackQuantum:
+    {
+      if (indexes == (const IndexPacket *) NULL)
+        break;
+      *step=1;
+      return(indexes);
     }
-    case IntegerPixel:
+    case AlphaQuantum:
     {
-      register unsigned int
-        *q;
-
-      q=(unsigned int *) pixels;
-      if (LocaleCompare(map,"BGR") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            p=GetVirtualPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (p == (const PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              *q++=(unsigned int) ScaleQuantumToLong(p->blue);
-              *q++=(unsigned int) ScaleQuantumToLong(p->green);
-              *q++=(unsigned int) ScaleQuantumToLong(p->red);
-              p++;
-            }
-          }
-          break;
-        }
-      if (LocaleCompare(map,"BGRA") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            p=GetVirtualPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (p == (const PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              *q++=(unsigned int) ScaleQuantumToLong(p->blue);
-              *q++=(unsigned int) ScaleQuantumToLong(p->green);
-              *q++=(unsigned int) ScaleQuantumToLong(p->red);
-              *q++=(unsigned int) ScaleQuantumToLong((Quantum) (QuantumRange-
-                p->opacity));
-              p++;
-            }
-          }
-          break;
-        }
-      if (LocaleCompare(map,"BGRP") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            p=GetVirtualPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (p == (const PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              *q++=(unsigned int) ScaleQuantumToLong(p->blue);
-              *q++=(unsigned int) ScaleQuantumToLong(p->green);
-              *q++=(unsigned int) ScaleQuantumToLong(p->red);
-              *q++=0U;
-              p++;
-            }
-          }
-          break;
-        }
-      if (LocaleCompare(map,"I") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            p=GetVirtualPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (p == (const PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              *q++=(unsigned int)
-                ScaleQuantumToLong(PixelIntensityToQuantum(p));
-              p++;
-            }
-          }
-          break;
-        }
-      if (LocaleCompare(map,"RGB") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            p=GetVirtualPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (p == (const PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              *q++=(unsigned int) ScaleQuantumToLong(p->red);
-              *q++=(unsigned int) ScaleQuantumToLong(p->green);
-              *q++=(unsigned int) ScaleQuantumToLong(p->blue);
-              p++;
-            }
-          }
-          break;
-        }
-      if (LocaleCompare(map,"RGBA") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            p=GetVirtualPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (p == (const PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              *q++=(unsigned int) ScaleQuantumToLong(p->red);
-              *q++=(unsigned int) ScaleQuantumToLong(p->green);
-              *q++=(unsigned int) ScaleQuantumToLong(p->blue);
-              *q++=(unsigned int) ScaleQuantumToLong((Quantum)
-                (QuantumRange-p->opacity));
-              p++;
-            }
-          }
-          break;
-        }
-      if (LocaleCompare(map,"RGBP") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            p=GetVirtualPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (p == (const PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              *q++=(unsigned int) ScaleQuantumToLong(p->red);
-              *q++=(unsigned int) ScaleQuantumToLong(p->green);
-              *q++=(unsigned int) ScaleQuantumToLong(p->blue);
-              *q++=0U;
-              p++;
-            }
-          }
-          break;
-        }
-      for (y=0; y < (long) rows; y++)
-      {
-        p=GetVirtualPixels(image,x_offset,y_offset+y,columns,1,exception);
-        if (p == (const PixelPacket *) NULL)
-          break;
-        indexes=GetVirtualIndexQueue(image);
-        for (x=0; x < (long) columns; x++)
-        {
-          for (i=0; i < (long) length; i++)
-          {
-            *q=0;
-            switch (quantum_map[i])
-            {
-              case RedQuantum:
-              case CyanQuantum:
-              {
-                *q=(unsigned int) ScaleQuantumToLong(p->red);
-                break;
-              }
-              case GreenQuantum:
-              case MagentaQuantum:
-              {
-                *q=(unsigned int) ScaleQuantumToLong(p->green);
-                break;
-              }
-              case BlueQuantum:
-              case YellowQuantum:
-              {
-                *q=(unsigned int) ScaleQuantumToLong(p->blue);
-                break;
-              }
-              case AlphaQuantum:
-              {
-                *q=(unsigned int) ScaleQuantumToLong((Quantum) (QuantumRange-
-                  p->opacity));
-                break;
-              }
-              case OpacityQuantum:
-              {
-                *q=(unsigned int) ScaleQuantumToLong(p->opacity);
-                break;
-              }
-              case BlackQuantum:
-              {
-                if (image->colorspace == CMYKColorspace)
-                  *q=(unsigned int) ScaleQuantumToLong(indexes[x]);
-                break;
-              }
-              case IndexQuantum:
-              {
-                *q=(unsigned int)
-                  ScaleQuantumToLong(PixelIntensityToQuantum(p));
-                break;
-              }
-              default:
-                *q=0;
-            }
-            q++;
-          }
-          p++;
-        }
-      }
-      break;
+      for (x=0; x < (long) number_pixels; x++)
+        channel[x]=(Quantum) (QuantumRange-p[x].opacity);
+      *step=1;
+      return(channel);
     }
-    case LongPixel:
+    case IndexQuantum:
     {
-      register unsigned long
-        *q;
-
-      q=(unsigned long *) pixels;
-      if (LocaleCompare(map,"BGR") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            p=GetVirtualPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (p == (const PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              *q++=ScaleQuantumToLong(p->blue);
-              *q++=ScaleQuantumToLong(p->green);
-              *q++=ScaleQuantumToLong(p->red);
-              p++;
-            }
-          }
-          break;
-        }
-      if (LocaleCompare(map,"BGRA") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            p=GetVirtualPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (p == (const PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              *q++=ScaleQuantumToLong(p->blue);
-              *q++=ScaleQuantumToLong(p->green);
-              *q++=ScaleQuantumToLong(p->red);
-              *q++=ScaleQuantumToLong((Quantum) (QuantumRange-p->opacity));
-              p++;
-            }
-          }
-          break;
-        }
-      if (LocaleCompare(map,"BGRP") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            p=GetVirtualPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (p == (const PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              *q++=ScaleQuantumToLong(p->blue);
-              *q++=ScaleQuantumToLong(p->green);
-              *q++=ScaleQuantumToLong(p->red);
-              *q++=0;
-              p++;
-            }
-          }
-          break;
-        }
-      if (LocaleCompare(map,"I") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            p=GetVirtualPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (p == (const PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              *q++=ScaleQuantumToLong(PixelIntensityToQuantum(p));
-              p++;
-            }
-          }
-          break;
-        }
-      if (LocaleCompare(map,"RGB") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            p=GetVirtualPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (p == (const PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              *q++=ScaleQuantumToLong(p->red);
-              *q++=ScaleQuantumToLong(p->green);
-              *q++=ScaleQuantumToLong(p->blue);
-              p++;
-            }
-          }
-          break;
-        }
-      if (LocaleCompare(map,"RGBA") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            p=GetVirtualPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (p == (const PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              *q++=ScaleQuantumToLong(p->red);
-              *q++=ScaleQuantumToLong(p->green);
-              *q++=ScaleQuantumToLong(p->blue);
-              *q++=ScaleQuantumToLong((Quantum) (QuantumRange-p->opacity));
-              p++;
-            }
-          }
-          break;
-        }
-      if (LocaleCompare(map,"RGBP") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            p=GetVirtualPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (p == (const PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              *q++=ScaleQuantumToLong(p->red);
-              *q++=ScaleQuantumToLong(p->green);
-              *q++=ScaleQuantumToLong(p->blue);
-              *q++=0;
-              p++;
-            }
-          }
-          break;
-        }
-      for (y=0; y < (long) rows; y++)
-      {
-        p=GetVirtualPixels(image,x_offset,y_offset+y,columns,1,exception);
-        if (p == (const PixelPacket *) NULL)
-          break;
-        indexes=GetVirtualIndexQueue(image);
-        for (x=0; x < (long) columns; x++)
-        {
-          for (i=0; i < (long) length; i++)
-          {
-            *q=0;
-            switch (quantum_map[i])
-            {
-              case RedQuantum:
-              case CyanQuantum:
-              {
-                *q=ScaleQuantumToLong(p->red);
-                break;
-              }
-              case GreenQuantum:
-              case MagentaQuantum:
-              {
-                *q=ScaleQuantumToLong(p->green);
-                break;
-              }
-              case BlueQuantum:
-              case YellowQuantum:
-              {
-                *q=ScaleQuantumToLong(p->blue);
-                break;
-              }
-              case AlphaQuantum:
-              {
-                *q=ScaleQuantumToLong((Quantum) (QuantumRange-p->opacity));
-                break;
-              }
-              case OpacityQuantum:
-              {
-                *q=ScaleQuantumToLong(p->opacity);
-                break;
-              }
-              case BlackQuantum:
-              {
-                if (image->colorspace == CMYKColorspace)
-                  *q=ScaleQuantumToLong(indexes[x]);
-                break;
-              }
-              case IndexQuantum:
-              {
-                *q=ScaleQuantumToLong(PixelIntensityToQuantum(p));
-                break;
-              }
-              default:
-                break;
-            }
-            q++;
-          }
-          p++;
-        }
-      }
+      for (x=0; x < (long) number_pixels; x++)
+        channel[x]=PixelIntensityToQuantum(p+x);
+      *step=1;
+      return(channel);
+    }
+    default:
       break;
+  }
+  (void) ResetMagickMemory(channel,0,number_pixels*sizeof(*channel));
+  *step=1;
+  return(channel);
+}
+
+MagickExport void ExportPixelFormatPackets(const PixelFormatInfo *format_info,
+  const PixelPacket *p,const IndexPacket *indexes,const size_t number_pixels,
+  void *pixels)
+{
+  Quantum
+    channel[PixelChannelBlock];
+
+  register const Quantum
+    *__restrict s;
+
+  register long
+    i,
+    x;
+
+  size_t
+    count,
+    offset,
+    step,
+    stride;
+
+  assert(format_info != (const PixelFormatInfo *) NULL);
+  assert(format_info->signature == MagickSignature);
+  if (format_info->export_packets != (ExportPixelFormatMethod) NULL)
+    {
+      format_info->export_packets(p,number_pixels,pixels);
+      return;
     }
-    case QuantumPixel:
+  stride=format_info->channels;
+  for (offset=0; offset < number_pixels; offset+=count)
+  {
+    count=number_pixels-offset;
+    if (count > PixelChannelBlock)
+      count=PixelChannelBlock;
+    for (i=0; i < (long) stride; i++)
     {
-      register Quantum
-        *q;
-
-      q=(Quantum *) pixels;
-      if (LocaleCompare(map,"BGR") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            p=GetVirtualPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (p == (const PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              *q++=p->blue;
-              *q++=p->green;
-              *q++=p->red;
-              p++;
-            }
-          }
-          break;
-        }
-      if (LocaleCompare(map,"BGRA") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            p=GetVirtualPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (p == (const PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              *q++=p->blue;
-              *q++=p->green;
-              *q++=p->red;
-              *q++=(Quantum) (QuantumRange-p->opacity);
-              p++;
-            }
-          }
-          break;
-        }
-      if (LocaleCompare(map,"BGRP") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            p=GetVirtualPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (p == (const PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              *q++=p->blue;
-              *q++=p->green;
-              *q++=p->red;
-              *q++=(Quantum) 0;
-              p++;
-            }
-          }
-          break;
-        }
-      if (LocaleCompare(map,"I") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            p=GetVirtualPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (p == (const PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              *q++=PixelIntensityToQuantum(p);
-              p++;
-            }
-          }
-          break;
-        }
-      if (LocaleCompare(map,"RGB") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            p=GetVirtualPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (p == (const PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              *q++=p->red;
-              *q++=p->green;
-              *q++=p->blue;
-              p++;
-            }
-          }
-          break;
-        }
-      if (LocaleCompare(map,"RGBA") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            p=GetVirtualPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (p == (const PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              *q++=p->red;
-              *q++=p->green;
-              *q++=p->blue;
-              *q++=(Quantum) (QuantumRange-p->opacity);
-              p++;
-            }
-          }
-          break;
-        }
-      if (LocaleCompare(map,"RGBP") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            p=GetVirtualPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (p == (const PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              *q++=p->red;
-              *q++=p->green;
-              *q++=p->blue;
-              *q++=(Quantum) 0;
-              p++;
-            }
-          }
-          break;
-        }
-      for (y=0; y < (long) rows; y++)
+      s=ExportPixelChannel(format_info->quantum_map[i],p+offset,indexes ==
+        (const IndexPacket *) NULL ? (const IndexPacket *) NULL :
+        indexes+offset,count,channel,&step);
+      switch (format_info->storage)
       {
-        p=GetVirtualPixels(image,x_offset,y_offset+y,columns,1,exception);
-        if (p == (const PixelPacket *) NULL)
-          break;
-        indexes=GetVirtualIndexQueue(image);
-        for (x=0; x < (long) columns; x++)
+        case CharPixel:
         {
-          for (i=0; i < (long) length; i++)
-          {
-            *q=(Quantum) 0;
-            switch (quantum_map[i])
-            {
-              case RedQuantum:
-              case CyanQuantum:
-              {
-                *q=p->red;
-                break;
-              }
-              case GreenQuantum:
-              case MagentaQuantum:
-              {
-                *q=p->green;
-                break;
-              }
-              case BlueQuantum:
-              case YellowQuantum:
-              {
-                *q=p->blue;
-                break;
-              }
-              case AlphaQuantum:
-              {
-                *q=(Quantum) (QuantumRange-p->opacity);
-                break;
-              }
-              case OpacityQuantum:
-              {
-                *q=p->opacity;
-                break;
-              }
-              case BlackQuantum:
-              {
-                if (image->colorspace == CMYKColorspace)
-                  *q=indexes[x];
-                break;
-              }
-              case IndexQuantum:
-              {
-                *q=(PixelIntensityToQuantum(p));
-                break;
-              }
-              default:
-                *q=(Quantum) 0;
-            }
-            q++;
-          }
-          p++;
-        }
-      }
-      break;
-    }
-    case ShortPixel:
-    {
-      register unsigned short
-        *q;
+          register unsigned char
+            *__restrict q;
 
-      q=(unsigned short *) pixels;
-      if (LocaleCompare(map,"BGR") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            p=GetVirtualPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (p == (const PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              *q++=ScaleQuantumToShort(p->blue);
-              *q++=ScaleQuantumToShort(p->green);
-              *q++=ScaleQuantumToShort(p->red);
-              p++;
-            }
-          }
+          q=(unsigned char *) pixels+offset*stride+i;
+          for (x=0; x < (long) count; x++)
+            q[x*stride]=ScaleQuantumToChar(s[x*step]);
           break;
         }
-      if (LocaleCompare(map,"BGRA") == 0)
+        case DoublePixel:
         {
-          for (y=0; y < (long) rows; y++)
-          {
-            p=GetVirtualPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (p == (const PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              *q++=ScaleQuantumToShort(p->blue);
-              *q++=ScaleQuantumToShort(p->green);
-              *q++=ScaleQuantumToShort(p->red);
-              *q++=ScaleQuantumToShort((Quantum) (QuantumRange-p->opacity));
-              p++;
-            }
-          }
+          register double
+            *__restrict q;
+
+          q=(double *) pixels+offset*stride+i;
+          for (x=0; x < (long) count; x++)
+            q[x*stride]=(double) (QuantumScale*s[x*step]);
           break;
         }
-      if (LocaleCompare(map,"BGRP") == 0)
+        case FloatPixel:
         {
-          for (y=0; y < (long) rows; y++)
-          {
-            p=GetVirtualPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (p == (const PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              *q++=ScaleQuantumToShort(p->blue);
-              *q++=ScaleQuantumToShort(p->green);
-              *q++=ScaleQuantumToShort(p->red);
-              *q++=0;
-              p++;
-            }
-          }
+          register float
+            *__restrict q;
+
+          q=(float *) pixels+offset*stride+i;
+          for (x=0; x < (long) count; x++)
+            q[x*stride]=(float) (QuantumScale*s[x*step]);
           break;
         }
-      if (LocaleCompare(map,"I") == 0)
+        case IntegerPixel:
         {
-          for (y=0; y < (long) rows; y++)
-          {
-            p=GetVirtualPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (p == (const PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              *q++=ScaleQuantumToShort(PixelIntensityToQuantum(p));
-              p++;
-            }
-          }
+          register unsigned int
+            *__restrict q;
+
+          q=(unsigned int *) pixels+offset*stride+i;
+          for (x=0; x < (long) count; x++)
+            q[x*stride]=(unsigned int) ScaleQuantumToLong(s[x*step]);
           break;
         }
-      if (LocaleCompare(map,"RGB") == 0)
+        case LongPixel:
         {
-          for (y=0; y < (long) rows; y++)
-          {
-            p=GetVirtualPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (p == (const PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              *q++=ScaleQuantumToShort(p->red);
-              *q++=ScaleQuantumToShort(p->green);
-              *q++=ScaleQuantumToShort(p->blue);
-              p++;
-            }
-          }
+          register unsigned long
+            *__restrict q;
+
+          q=(unsigned long *) pixels+offset*stride+i;
+          for (x=0; x < (long) count; x++)
+            q[x*stride]=ScaleQuantumToLong(s[x*step]);
           break;
         }
-      if (LocaleCompare(map,"RGBA") == 0)
+        case QuantumPixel:
         {
-          for (y=0; y < (long) rows; y++)
-          {
-            p=GetVirtualPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (p == (const PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              *q++=ScaleQuantumToShort(p->red);
-              *q++=ScaleQuantumToShort(p->green);
-              *q++=ScaleQuantumToShort(p->blue);
-              *q++=ScaleQuantumToShort((Quantum) (QuantumRange-p->opacity));
-              p++;
-            }
-          }
+          register Quantum
+            *__restrict q;
+
+          q=(Quantum *) pixels+offset*stride+i;
+          for (x=0; x < (long) count; x++)
+            q[x*stride]=s[x*step];
           break;
         }
-      if (LocaleCompare(map,"RGBP") == 0)
+        case ShortPixel:
         {
-          for (y=0; y < (long) rows; y++)
-          {
-            p=GetVirtualPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (p == (const PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              *q++=ScaleQuantumToShort(p->red);
-              *q++=ScaleQuantumToShort(p->green);
-              *q++=ScaleQuantumToShort(p->blue);
-              *q++=0;
-              p++;
-            }
-          }
+          register unsigned short
+            *__restrict q;
+
+          q=(unsigned short *) pixels+offset*stride+i;
+          for (x=0; x < (long) count; x++)
+            q[x*stride]=ScaleQuantumToShort(s[x*step]);
           break;
         }
-      for (y=0; y < (long) rows; y++)
-      {
-        p=GetVirtualPixels(image,x_offset,y_offset+y,columns,1,exception);
-        if (p == (const PixelPacket *) NULL)
+        default:
           break;
-        indexes=GetVirtualIndexQueue(image);
-        for (x=0; x < (long) columns; x++)
-        {
-          for (i=0; i < (long) length; i++)
-          {
-            *q=0;
-            switch (quantum_map[i])
-            {
-              case RedQuantum:
-              case CyanQuantum:
-              {
-                *q=ScaleQuantumToShort(p->red);
-                break;
-              }
-              case GreenQuantum:
-              case MagentaQuantum:
-              {
-                *q=ScaleQuantumToShort(p->green);
-                break;
-              }
-              case BlueQuantum:
-              case YellowQuantum:
-              {
-                *q=ScaleQuantumToShort(p->blue);
-                break;
-              }
-              case AlphaQuantum:
-              {
-                *q=ScaleQuantumToShort((Quantum) (QuantumRange-p->opacity));
-                break;
-              }
-              case OpacityQuantum:
-              {
-                *q=ScaleQuantumToShort(p->opacity);
-                break;
-              }
-              case BlackQuantum:
-              {
-                if (image->colorspace == CMYKColorspace)
-                  *q=ScaleQuantumToShort(indexes[x]);
-                break;
-              }
-              case IndexQuantum:
-              {
-                *q=ScaleQuantumToShort(PixelIntensityToQuantum(p));
-                break;
-              }
-              default:
-                break;
-            }
-            q++;
-          }
-          p++;
-        }
       }
-      break;
-    }
-    default:
-    {
-      quantum_map=(QuantumType *) RelinquishMagickMemory(quantum_map);
-      (void) ThrowMagickException(exception,GetMagickModule(),OptionError,
-        "UnrecognizedPixelMap","`%s'",map);
-      break;
     }
   }
-  quantum_map=(QuantumType *) RelinquishMagickMemory(quantum_map);
-  return(MagickTrue);
 }
 
 /*
@@ -1648,6 +1273,132 @@ MagickExport void GetMagickPixelPacket(const Image *image,
 %                                                                             %
 %                                                                             %
 %                                                                             %
+%   G e t P i x e l F o r m a t E x t e n t                                   %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  GetPixelFormatExtent() returns the number of bytes one pixel occupies in
+%  the layout defined by a pixel format.
+%
+%  The format of the GetPixelFormatExtent method is:
+%
+%      size_t GetPixelFormatExtent(const PixelFormatInfo *format_info)
+%
+%  A description of each parameter follows:
+%
+%    o format_info: the pixel format.
+%
+*/
+MagickExport size_t GetPixelFormatExtent(const PixelFormatInfo *format_info)
+{
+  assert(format_info != (const PixelFormatInfo *) NULL);
+  assert(format_info->signature == MagickSignature);
+  return(format_info->extent);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   I m p o r t F o r m a t t e d I m a g e P i x e l s                       %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  ImportFormattedImagePixels() stores pixel data laid out as defined by a
+%  pixel format returned by AcquirePixelFormatInfo() in the image at the
+%  location you specify.  Channels not named by the pixel format are left
+%  untouched.  Large regions are converted in parallel.
+%
+%  The format of the ImportFormattedImagePixels method is:
+%
+%      MagickBooleanType ImportFormattedImagePixels(Image *image,
+%        const long x_offset,const long y_offset,const unsigned long columns,
+%        const unsigned long rows,const PixelFormatInfo *format_info,
+%        const void *pixels)
+%
+%  A description of each parameter follows:
+%
+%    o image: the image.
+%
+%    o x_offset,y_offset,columns,rows:  These values define the perimeter
+%      of a region of pixels you want to define.
+%
+%    o format_info: the pixel format.
+%
+%    o pixels: This array of values contain the pixel components as defined by
+%      the pixel format.
+%
+*/
+MagickExport MagickBooleanType ImportFormattedImagePixels(Image *image,
+  const long x_offset,const long y_offset,const unsigned long columns,
+  const unsigned long rows,const PixelFormatInfo *format_info,
+  const void *pixels)
+{
+  CacheView
+    *image_view;
+
+  ExceptionInfo
+    *exception;
+
+  long
+    y;
+
+  MagickBooleanType
+    status;
+
+  assert(image != (Image *) NULL);
+  assert(image->signature == MagickSignature);
+  if (image->debug != MagickFalse)
+    (void) LogMagickEvent(TraceEvent,GetMagickModule(),"%s",image->filename);
+  assert(format_info != (const PixelFormatInfo *) NULL);
+  assert(format_info->signature == MagickSignature);
+  if (format_info->matte != MagickFalse)
+    image->matte=MagickTrue;
+  if (format_info->cmyk != MagickFalse)
+    (void) SetImageColorspace(image,CMYKColorspace);
+  if (SetImageStorageClass(image,DirectClass) == MagickFalse)
+    return(MagickFalse);
+  status=MagickTrue;
+  exception=(&image->exception);
+  image_view=AcquireCacheView(image);
+#if defined(MAGICKCORE_OPENMP_SUPPORT)
+  #pragma omp parallel for shared(status) \
+    magick_schedule(PointThreadCost,columns,rows)
+#endif
+  for (y=0; y < (long) rows; y++)
+  {
+    register PixelPacket
+      *__restrict q;
+
+    if (status == MagickFalse)
+      continue;
+    q=GetCacheViewAuthenticPixels(image_view,x_offset,y_offset+y,columns,1,
+      exception);
+    if (q == (PixelPacket *) NULL)
+      {
+        status=MagickFalse;
+        continue;
+      }
+    ImportPixelFormatPackets(format_info,(const unsigned char *) pixels+y*
+      columns*format_info->extent,columns,q,GetCacheViewAuthenticIndexQueue(
+      image_view));
+    if (SyncCacheViewAuthenticPixels(image_view,exception) == MagickFalse)
+      status=MagickFalse;
+  }
+  image_view=DestroyCacheView(image_view);
+  return(status);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
 %   I m p o r t I m a g e P i x e l s                                         %
 %                                                                             %
 %                                                                             %
@@ -1699,1676 +1450,234 @@ MagickExport MagickBooleanType ImportImagePixels(Image *image,
   const unsigned long rows,const char *map,const StorageType type,
   const void *pixels)
 {
-  ExceptionInfo
-    *exception;
-
-  long
-    y;
-
-  PixelPacket
-    *q;
-
-  QuantumType
-    *quantum_map;
-
-  register IndexPacket
-    *indexes;
-
-  register long
-    i,
-    x;
+  MagickBooleanType
+    status;
 
-  size_t
-    length;
+  PixelFormatInfo
+    *format_info;
 
-  /*
-    Allocate image structure.
-  */
   assert(image != (Image *) NULL);
   assert(image->signature == MagickSignature);
   if (image->debug != MagickFalse)
     (void) LogMagickEvent(TraceEvent,GetMagickModule(),"%s",image->filename);
-  length=strlen(map);
-  quantum_map=(QuantumType *) AcquireQuantumMemory(length,sizeof(*quantum_map));
-  if (quantum_map == (QuantumType *) NULL)
-    ThrowBinaryException(ResourceLimitError,"MemoryAllocationFailed",
-      image->filename);
-  for (i=0; i < (long) length; i++)
-  {
-    switch (map[i])
-    {
-      case 'a':
-      case 'A':
-      {
-        quantum_map[i]=AlphaQuantum;
-        image->matte=MagickTrue;
-        break;
-      }
-      case 'B':
-      case 'b':
-      {
-        quantum_map[i]=BlueQuantum;
-        break;
-      }
-      case 'C':
-      case 'c':
-      {
-        quantum_map[i]=CyanQuantum;
-        (void) SetImageColorspace(image,CMYKColorspace);
-        break;
-      }
-      case 'g':
-      case 'G':
-      {
-        quantum_map[i]=GreenQuantum;
-        break;
-      }
-      case 'K':
-      case 'k':
-      {
-        quantum_map[i]=BlackQuantum;
-        (void) SetImageColorspace(image,CMYKColorspace);
-        break;
-      }
-      case 'I':
-      case 'i':
-      {
-        quantum_map[i]=IndexQuantum;
-        break;
-      }
-      case 'm':
-      case 'M':
-      {
-        quantum_map[i]=MagentaQuantum;
-        (void) SetImageColorspace(image,CMYKColorspace);
-        break;
-      }
-      case 'O':
-      case 'o':
-      {
-        quantum_map[i]=OpacityQuantum;
-        image->matte=MagickTrue;
-        break;
-      }
-      case 'P':
-      case 'p':
-      {
-        quantum_map[i]=UndefinedQuantum;
-        break;
-      }
-      case 'R':
-      case 'r':
-      {
-        quantum_map[i]=RedQuantum;
-        break;
-      }
-      case 'Y':
-      case 'y':
-      {
-        quantum_map[i]=YellowQuantum;
-        (void) SetImageColorspace(image,CMYKColorspace);
-        break;
-      }
-      default:
-      {
-        quantum_map=(QuantumType *) RelinquishMagickMemory(quantum_map);
-        (void) ThrowMagickException(&image->exception,GetMagickModule(),
-          OptionError,"UnrecognizedPixelMap","`%s'",map);
-        return(MagickFalse);
-      }
-    }
-  }
-  if (SetImageStorageClass(image,DirectClass) == MagickFalse)
+  format_info=AcquirePixelFormatInfo(map,type,&image->exception);
+  if (format_info == (PixelFormatInfo *) NULL)
     return(MagickFalse);
-  /*
-    Transfer the pixels from the pixel datarray to the image.
-  */
-  exception=(&image->exception);
-  switch (type)
-  {
-    case CharPixel:
-    {
-      register const unsigned char
-        *p;
-
-      p=(const unsigned char *) pixels;
-      if (LocaleCompare(map,"BGR") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            q=GetAuthenticPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (q == (PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              q->blue=ScaleCharToQuantum(*p++);
-              q->green=ScaleCharToQuantum(*p++);
-              q->red=ScaleCharToQuantum(*p++);
-              q++;
-            }
-            if (SyncAuthenticPixels(image,exception) == MagickFalse)
-              break;
-          }
-          break;
-        }
-      if (LocaleCompare(map,"BGRA") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            q=GetAuthenticPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (q == (PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              q->blue=ScaleCharToQuantum(*p++);
-              q->green=ScaleCharToQuantum(*p++);
-              q->red=ScaleCharToQuantum(*p++);
-              q->opacity=(Quantum) QuantumRange-ScaleCharToQuantum(*p++);
-              q++;
-            }
-            if (SyncAuthenticPixels(image,exception) == MagickFalse)
-              break;
-          }
-          break;
-        }
-      if (LocaleCompare(map,"BGRO") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            q=GetAuthenticPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (q == (PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              q->blue=ScaleCharToQuantum(*p++);
-              q->green=ScaleCharToQuantum(*p++);
-              q->red=ScaleCharToQuantum(*p++);
-              q->opacity=ScaleCharToQuantum(*p++);
-              q++;
-            }
-            if (SyncAuthenticPixels(image,exception) == MagickFalse)
-              break;
-          }
-          break;
-        }
-      if (LocaleCompare(map,"BGRP") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            q=GetAuthenticPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (q == (PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              q->blue=ScaleCharToQuantum(*p++);
-              q->green=ScaleCharToQuantum(*p++);
-              q->red=ScaleCharToQuantum(*p++);
-              p++;
-              q++;
-            }
-            if (SyncAuthenticPixels(image,exception) == MagickFalse)
-              break;
-          }
-          break;
-        }
-      if (LocaleCompare(map,"I") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            q=GetAuthenticPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (q == (PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              q->red=ScaleCharToQuantum(*p++);
-              q->green=q->red;
-              q->blue=q->red;
-              q++;
-            }
-            if (SyncAuthenticPixels(image,exception) == MagickFalse)
-              break;
-          }
-          break;
-        }
-      if (LocaleCompare(map,"RGB") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            q=GetAuthenticPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (q == (PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              q->red=ScaleCharToQuantum(*p++);
-              q->green=ScaleCharToQuantum(*p++);
-              q->blue=ScaleCharToQuantum(*p++);
-              q++;
-            }
-            if (SyncAuthenticPixels(image,exception) == MagickFalse)
-              break;
-          }
-          break;
-        }
-      if (LocaleCompare(map,"RGBA") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            q=GetAuthenticPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (q == (PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              q->red=ScaleCharToQuantum(*p++);
-              q->green=ScaleCharToQuantum(*p++);
-              q->blue=ScaleCharToQuantum(*p++);
-              q->opacity=(Quantum) QuantumRange-ScaleCharToQuantum(*p++);
-              q++;
-            }
-            if (SyncAuthenticPixels(image,exception) == MagickFalse)
-              break;
-          }
-          break;
-        }
-      if (LocaleCompare(map,"RGBO") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            q=GetAuthenticPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (q == (PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              q->red=ScaleCharToQuantum(*p++);
-              q->green=ScaleCharToQuantum(*p++);
-              q->blue=ScaleCharToQuantum(*p++);
-              q->opacity=ScaleCharToQuantum(*p++);
-              q++;
-            }
-            if (SyncAuthenticPixels(image,exception) == MagickFalse)
-              break;
-          }
-          break;
-        }
-      if (LocaleCompare(map,"RGBP") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            q=GetAuthenticPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (q == (PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              q->red=ScaleCharToQuantum(*p++);
-              q->green=ScaleCharToQuantum(*p++);
-              q->blue=ScaleCharToQuantum(*p++);
-              p++;
-              q++;
-            }
-            if (SyncAuthenticPixels(image,exception) == MagickFalse)
-              break;
-          }
-          break;
-        }
-      for (y=0; y < (long) rows; y++)
-      {
-        q=GetAuthenticPixels(image,x_offset,y_offset+y,columns,1,exception);
-        if (q == (PixelPacket *) NULL)
-          break;
-        indexes=GetAuthenticIndexQueue(image);
-        for (x=0; x < (long) columns; x++)
-        {
-          for (i=0; i < (long) length; i++)
-          {
-            switch (quantum_map[i])
-            {
-              case RedQuantum:
-              case CyanQuantum:
-              {
-                q->red=ScaleCharToQuantum(*p);
-                break;
-              }
-              case GreenQuantum:
-              case MagentaQuantum:
-              {
-                q->green=ScaleCharToQuantum(*p);
-                break;
-              }
-              case BlueQuantum:
-              case YellowQuantum:
-              {
-                q->blue=ScaleCharToQuantum(*p);
-                break;
-              }
-              case AlphaQuantum:
-              {
-                q->opacity=(Quantum) QuantumRange-ScaleCharToQuantum(*p);
-                break;
-              }
-              case OpacityQuantum:
-              {
-                q->opacity=ScaleCharToQuantum(*p);
-                break;
-              }
-              case BlackQuantum:
-              {
-                indexes[x]=ScaleCharToQuantum(*p);
-                break;
-              }
-              case IndexQuantum:
-              {
-                q->red=ScaleCharToQuantum(*p);
-                q->green=q->red;
-                q->blue=q->red;
-                break;
-              }
-              default:
-                break;
-            }
-            p++;
-          }
-          q++;
-        }
-        if (SyncAuthenticPixels(image,exception) == MagickFalse)
-          break;
-      }
-      break;
-    }
-    case DoublePixel:
-    {
-      register const double
-        *p;
-
-      p=(const double *) pixels;
-      if (LocaleCompare(map,"BGR") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            q=GetAuthenticPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (q == (PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              q->blue=RoundToQuantum((MagickRealType) QuantumRange*(*p));
-              p++;
-              q->green=RoundToQuantum((MagickRealType) QuantumRange*(*p));
-              p++;
-              q->red=RoundToQuantum((MagickRealType) QuantumRange*(*p));
-              p++;
-              q++;
-            }
-            if (SyncAuthenticPixels(image,exception) == MagickFalse)
-              break;
-          }
-          break;
-        }
-      if (LocaleCompare(map,"BGRA") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            q=GetAuthenticPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (q == (PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              q->blue=RoundToQuantum((MagickRealType) QuantumRange*(*p));
-              p++;
-              q->green=RoundToQuantum((MagickRealType) QuantumRange*(*p));
-              p++;
-              q->red=RoundToQuantum((MagickRealType) QuantumRange*(*p));
-              p++;
-              q->opacity=(Quantum) QuantumRange-RoundToQuantum((MagickRealType)
-                QuantumRange*(*p));
-              p++;
-              q++;
-            }
-            if (SyncAuthenticPixels(image,exception) == MagickFalse)
-              break;
-          }
-          break;
-        }
-      if (LocaleCompare(map,"BGRP") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            q=GetAuthenticPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (q == (PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              q->blue=RoundToQuantum((MagickRealType) QuantumRange*(*p));
-              p++;
-              q->green=RoundToQuantum((MagickRealType) QuantumRange*(*p));
-              p++;
-              q->red=RoundToQuantum((MagickRealType) QuantumRange*(*p));
-              p++;
-              p++;
-              q++;
-            }
-            if (SyncAuthenticPixels(image,exception) == MagickFalse)
-              break;
-          }
-          break;
-        }
-      if (LocaleCompare(map,"I") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            q=GetAuthenticPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (q == (PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              q->red=RoundToQuantum((MagickRealType) QuantumRange*(*p));
-              q->green=q->red;
-              q->blue=q->red;
-              p++;
-              q++;
-            }
-            if (SyncAuthenticPixels(image,exception) == MagickFalse)
-              break;
-          }
-          break;
-        }
-      if (LocaleCompare(map,"RGB") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            q=GetAuthenticPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (q == (PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              q->red=RoundToQuantum((MagickRealType) QuantumRange*(*p));
-              p++;
-              q->green=RoundToQuantum((MagickRealType) QuantumRange*(*p));
-              p++;
-              q->blue=RoundToQuantum((MagickRealType) QuantumRange*(*p));
-              p++;
-              q++;
-            }
-            if (SyncAuthenticPixels(image,exception) == MagickFalse)
-              break;
-          }
-          break;
-        }
-      if (LocaleCompare(map,"RGBA") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            q=GetAuthenticPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (q == (PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              q->red=RoundToQuantum((MagickRealType) QuantumRange*(*p));
-              p++;
-              q->green=RoundToQuantum((MagickRealType) QuantumRange*(*p));
-              p++;
-              q->blue=RoundToQuantum((MagickRealType) QuantumRange*(*p));
-              p++;
-              q->opacity=(Quantum) QuantumRange-RoundToQuantum((MagickRealType)
-                QuantumRange*(*p));
-              p++;
-              q++;
-            }
-            if (SyncAuthenticPixels(image,exception) == MagickFalse)
-              break;
-          }
-          break;
-        }
-      if (LocaleCompare(map,"RGBP") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            q=GetAuthenticPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (q == (PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              q->red=RoundToQuantum((MagickRealType) QuantumRange*(*p));
-              p++;
-              q->green=RoundToQuantum((MagickRealType) QuantumRange*(*p));
-              p++;
-              q->blue=RoundToQuantum((MagickRealType) QuantumRange*(*p));
-              p++;
-              q++;
-            }
-            if (SyncAuthenticPixels(image,exception) == MagickFalse)
-              break;
-          }
-          break;
-        }
-      for (y=0; y < (long) rows; y++)
-      {
-        q=GetAuthenticPixels(image,x_offset,y_offset+y,columns,1,exception);
-        if (q == (PixelPacket *) NULL)
-          break;
-        indexes=GetAuthenticIndexQueue(image);
-        for (x=0; x < (long) columns; x++)
-        {
-          for (i=0; i < (long) length; i++)
-          {
-            switch (quantum_map[i])
-            {
-              case RedQuantum:
-              case CyanQuantum:
-              {
-                q->red=RoundToQuantum((MagickRealType) QuantumRange*(*p));
-                break;
-              }
-              case GreenQuantum:
-              case MagentaQuantum:
-              {
-                q->green=RoundToQuantum((MagickRealType) QuantumRange*(*p));
-                break;
-              }
-              case BlueQuantum:
-              case YellowQuantum:
-              {
-                q->blue=RoundToQuantum((MagickRealType) QuantumRange*(*p));
-                break;
-              }
-              case AlphaQuantum:
-              {
-                q->opacity=(Quantum) QuantumRange-RoundToQuantum(
-                  (MagickRealType) QuantumRange*(*p));
-                break;
-              }
-              case OpacityQuantum:
-              {
-                q->opacity=RoundToQuantum((MagickRealType) QuantumRange*(*p));
-                break;
-              }
-              case BlackQuantum:
-              {
-                indexes[x]=RoundToQuantum((MagickRealType) QuantumRange*(*p));
-                break;
-              }
-              case IndexQuantum:
-              {
-                q->red=RoundToQuantum((MagickRealType) QuantumRange*(*p));
-                q->green=q->red;
-                q->blue=q->red;
-                break;
-              }
-              default:
-                break;
-            }
-            p++;
-          }
-          q++;
-        }
-        if (SyncAuthenticPixels(image,exception) == MagickFalse)
-          break;
-      }
-      break;
-    }
-    case FloatPixel:
-    {
-      register const float
-        *p;
+  status=ImportFormattedImagePixels(image,x_offset,y_offset,columns,rows,
+    format_info,pixels);
+  format_info=DestroyPixelFormatInfo(format_info);
+  return(status);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   I m p o r t P i x e l F o r m a t P a c k e t s                           %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  ImportPixelFormatPackets() converts pixels laid out as defined by a pixel
+%  format into a run of pixel packets, such as a row returned by
+%  GetCacheViewAuthenticPixels().  Channels not named by the pixel format are
+%  left untouched.
+%
+%  The format of the ImportPixelFormatPackets method is:
+%
+%      void ImportPixelFormatPackets(const PixelFormatInfo *format_info,
+%        const void *pixels,const size_t number_pixels,PixelPacket *q,
+%        IndexPacket *indexes)
+%
+%  A description of each parameter follows:
+%
+%    o format_info: the pixel format.
+%
+%    o pixels: the pixels to convert.
+%
+%    o number_pixels: the number of pixels to convert.
+%
+%    o q: the pixel packets.
+%
+%    o indexes: the black channel of CMYK pixels, otherwise NULL.
+%
+*/
 
-      p=(const float *) pixels;
-      if (LocaleCompare(map,"BGR") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            q=GetAuthenticPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (q == (PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              q->blue=RoundToQuantum((MagickRealType) QuantumRange*(*p));
-              p++;
-              q->green=RoundToQuantum((MagickRealType) QuantumRange*(*p));
-              p++;
-              q->red=RoundToQuantum((MagickRealType) QuantumRange*(*p));
-              p++;
-              q++;
-            }
-            if (SyncAuthenticPixels(image,exception) == MagickFalse)
-              break;
-          }
-          break;
-        }
-      if (LocaleCompare(map,"BGRA") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            q=GetAuthenticPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (q == (PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              q->blue=RoundToQuantum((MagickRealType) QuantumRange*(*p));
-              p++;
-              q->green=RoundToQuantum((MagickRealType) QuantumRange*(*p));
-              p++;
-              q->red=RoundToQuantum((MagickRealType) QuantumRange*(*p));
-              p++;
-              q->opacity=(Quantum) QuantumRange-RoundToQuantum((MagickRealType)
-                QuantumRange*(*p));
-              p++;
-              q++;
-            }
-            if (SyncAuthenticPixels(image,exception) == MagickFalse)
-              break;
-          }
-          break;
-        }
-      if (LocaleCompare(map,"BGRP") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            q=GetAuthenticPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (q == (PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              q->blue=RoundToQuantum((MagickRealType) QuantumRange*(*p));
-              p++;
-              q->green=RoundToQuantum((MagickRealType) QuantumRange*(*p));
-              p++;
-              q->red=RoundToQuantum((MagickRealType) QuantumRange*(*p));
-              p++;
-              p++;
-              q++;
-            }
-            if (SyncAuthenticPixels(image,exception) == MagickFalse)
-              break;
-          }
-          break;
-        }
-      if (LocaleCompare(map,"I") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            q=GetAuthenticPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (q == (PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              q->red=RoundToQuantum((MagickRealType) QuantumRange*(*p));
-              q->green=q->red;
-              q->blue=q->red;
-              p++;
-              q++;
-            }
-            if (SyncAuthenticPixels(image,exception) == MagickFalse)
-              break;
-          }
-          break;
-        }
-      if (LocaleCompare(map,"RGB") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            q=GetAuthenticPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (q == (PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              q->red=RoundToQuantum((MagickRealType) QuantumRange*(*p));
-              p++;
-              q->green=RoundToQuantum((MagickRealType) QuantumRange*(*p));
-              p++;
-              q->blue=RoundToQuantum((MagickRealType) QuantumRange*(*p));
-              p++;
-              q++;
-            }
-            if (SyncAuthenticPixels(image,exception) == MagickFalse)
-              break;
-          }
-          break;
-        }
-      if (LocaleCompare(map,"RGBA") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            q=GetAuthenticPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (q == (PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              q->red=RoundToQuantum((MagickRealType) QuantumRange*(*p));
-              p++;
-              q->green=RoundToQuantum((MagickRealType) QuantumRange*(*p));
-              p++;
-              q->blue=RoundToQuantum((MagickRealType) QuantumRange*(*p));
-              p++;
-              q->opacity=(Quantum) QuantumRange-RoundToQuantum((MagickRealType)
-                QuantumRange*(*p));
-              p++;
-              q++;
-            }
-            if (SyncAuthenticPixels(image,exception) == MagickFalse)
-              break;
-          }
-          break;
-        }
-      if (LocaleCompare(map,"RGBP") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            q=GetAuthenticPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (q == (PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              q->red=RoundToQuantum((MagickRealType) QuantumRange*(*p));
-              p++;
-              q->green=RoundToQuantum((MagickRealType) QuantumRange*(*p));
-              p++;
-              q->blue=RoundToQuantum((MagickRealType) QuantumRange*(*p));
-              p++;
-              q++;
-            }
-            if (SyncAuthenticPixels(image,exception) == MagickFalse)
-              break;
-          }
-          break;
-        }
-      for (y=0; y < (long) rows; y++)
-      {
-        q=GetAuthenticPixels(image,x_offset,y_offset+y,columns,1,exception);
-        if (q == (PixelPacket *) NULL)
-          break;
-        indexes=GetAuthenticIndexQueue(image);
-        for (x=0; x < (long) columns; x++)
-        {
-          for (i=0; i < (long) length; i++)
-          {
-            switch (quantum_map[i])
-            {
-              case RedQuantum:
-              case CyanQuantum:
-              {
-                q->red=RoundToQuantum((MagickRealType) QuantumRange*(*p));
-                break;
-              }
-              case GreenQuantum:
-              case MagentaQuantum:
-              {
-                q->green=RoundToQuantum((MagickRealType) QuantumRange*(*p));
-                break;
-              }
-              case BlueQuantum:
-              case YellowQuantum:
-              {
-                q->blue=RoundToQuantum((MagickRealType) QuantumRange*(*p));
-                break;
-              }
-              case AlphaQuantum:
-              {
-                q->opacity=(Quantum) QuantumRange-RoundToQuantum(
-                  (MagickRealType) QuantumRange*(*p));
-                break;
-              }
-              case OpacityQuantum:
-              {
-                q->opacity=RoundToQuantum((MagickRealType) QuantumRange*(*p));
-                break;
-              }
-              case BlackQuantum:
-              {
-                indexes[x]=RoundToQuantum((MagickRealType) QuantumRange*(*p));
-                break;
-              }
-              case IndexQuantum:
-              {
-                q->red=RoundToQuantum((MagickRealType) QuantumRange*(*p));
-                q->green=q->red;
-                q->blue=q->red;
-                break;
-              }
-              default:
-                break;
-            }
-            p++;
-          }
-          q++;
-        }
-        if (SyncAuthenticPixels(image,exception) == MagickFalse)
-          break;
-      }
-      break;
+static inline Quantum *ImportPixelChannel(const QuantumType quantum_type,
+  PixelPacket *__restrict q,IndexPacket *__restrict indexes,
+  Quantum *__restrict channel,size_t *step)
+{
+  *step=sizeof(*q)/sizeof(Quantum);
+  switch (quantum_type)
+  {
+    case RedQuantum:
+    case CyanQuantum:
+      return(&q->red);
+    case GreenQuantum:
+    case MagentaQuantum:
+      return(&q->green);
+    case BlueQuantum:
+    case YellowQuantum:
+      return(&q->blue);
+    case OpacityQuantum:
+      return(&q->opacity);
+    case BlackQuantum:
+    {
+      *step=1;
+      return(indexes);
     }
-    case IntegerPixel:
+    case AlphaQuantum:
+    case IndexQuantum:
     {
-      register const unsigned int
-        *p;
-
-      p=(const unsigned int *) pixels;
-      if (LocaleCompare(map,"BGR") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            q=GetAuthenticPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (q == (PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              q->blue=ScaleLongToQuantum(*p++);
-              q->green=ScaleLongToQuantum(*p++);
-              q->red=ScaleLongToQuantum(*p++);
-              q++;
-            }
-            if (SyncAuthenticPixels(image,exception) == MagickFalse)
-              break;
-          }
-          break;
-        }
-      if (LocaleCompare(map,"BGRA") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            q=GetAuthenticPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (q == (PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              q->blue=ScaleLongToQuantum(*p++);
-              q->green=ScaleLongToQuantum(*p++);
-              q->red=ScaleLongToQuantum(*p++);
-              q->opacity=(Quantum) QuantumRange-ScaleLongToQuantum(*p++);
-              q++;
-            }
-            if (SyncAuthenticPixels(image,exception) == MagickFalse)
-              break;
-          }
-          break;
-        }
-      if (LocaleCompare(map,"BGRP") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            q=GetAuthenticPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (q == (PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              q->blue=ScaleLongToQuantum(*p++);
-              q->green=ScaleLongToQuantum(*p++);
-              q->red=ScaleLongToQuantum(*p++);
-              p++;
-              q++;
-            }
-            if (SyncAuthenticPixels(image,exception) == MagickFalse)
-              break;
-          }
-          break;
-        }
-      if (LocaleCompare(map,"I") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            q=GetAuthenticPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (q == (PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              q->red=ScaleLongToQuantum(*p++);
-              q->green=q->red;
-              q->blue=q->red;
-              q++;
-            }
-            if (SyncAuthenticPixels(image,exception) == MagickFalse)
-              break;
-          }
-          break;
-        }
-      if (LocaleCompare(map,"RGB") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            q=GetAuthenticPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (q == (PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              q->red=ScaleLongToQuantum(*p++);
-              q->green=ScaleLongToQuantum(*p++);
-              q->blue=ScaleLongToQuantum(*p++);
-              q++;
-            }
-            if (SyncAuthenticPixels(image,exception) == MagickFalse)
-              break;
-          }
-          break;
-        }
-      if (LocaleCompare(map,"RGBA") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            q=GetAuthenticPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (q == (PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              q->red=ScaleLongToQuantum(*p++);
-              q->green=ScaleLongToQuantum(*p++);
-              q->blue=ScaleLongToQuantum(*p++);
-              q->opacity=(Quantum) QuantumRange-ScaleLongToQuantum(*p++);
-              q++;
-            }
-            if (SyncAuthenticPixels(image,exception) == MagickFalse)
-              break;
-          }
-          break;
-        }
-      if (LocaleCompare(map,"RGBP") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            q=GetAuthenticPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (q == (PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              q->red=ScaleLongToQuantum(*p++);
-              q->green=ScaleLongToQuantum(*p++);
-              q->blue=ScaleLongToQuantum(*p++);
-              p++;
-              q++;
-            }
-            if (SyncAuthenticPixels(image,exception) == MagickFalse)
-              break;
-          }
-          break;
-        }
-      for (y=0; y < (long) rows; y++)
-      {
-        q=GetAuthenticPixels(image,x_offset,y_offset+y,columns,1,exception);
-        if (q == (PixelPacket *) NULL)
-          break;
-        indexes=GetAuthenticIndexQueue(image);
-        for (x=0; x < (long) columns; x++)
-        {
-          for (i=0; i < (long) length; i++)
-          {
-            switch (quantum_map[i])
-            {
-              case RedQuantum:
-              case CyanQuantum:
-              {
-                q->red=ScaleLongToQuantum(*p);
-                break;
-              }
-              case GreenQuantum:
-              case MagentaQuantum:
-              {
-                q->green=ScaleLongToQuantum(*p);
-                break;
-              }
-              case BlueQuantum:
-              case YellowQuantum:
-              {
-                q->blue=ScaleLongToQuantum(*p);
-                break;
-              }
-              case AlphaQuantum:
-              {
-                q->opacity=(Quantum) QuantumRange-ScaleLongToQuantum(*p);
-                break;
-              }
-              case OpacityQuantum:
-              {
-                q->opacity=ScaleLongToQuantum(*p);
-                break;
-              }
-              case BlackQuantum:
-              {
-                indexes[x]=ScaleLongToQuantum(*p);
-                break;
-              }
-              case IndexQuantum:
-              {
-                q->red=ScaleLongToQuantum(*p);
-                q->green=q->red;
-                q->blue=q->red;
-                break;
-              }
-              default:
-                break;
-            }
-            p++;
-          }
-          q++;
-        }
-        if (SyncAuthenticPixels(image,exception) == MagickFalse)
-          break;
-      }
+      *step=1;
+      return(channel);
+    }
+    default:
       break;
+  }
+  return((Quantum *) NULL);
+}
+
+MagickExport void ImportPixelFormatPackets(const PixelFormatInfo *format_info,
+  const void *pixels,const size_t number_pixels,PixelPacket *q,
+  IndexPacket *indexes)
+{
+  Quantum
+    channel[PixelChannelBlock];
+
+  register long
+    i,
+    x;
+
+  register Quantum
+    *__restrict d;
+
+  size_t
+    count,
+    offset,
+    step,
+    stride;
+
+  assert(format_info != (const PixelFormatInfo *) NULL);
+  assert(format_info->signature == MagickSignature);
+  if (format_info->import_packets != (ImportPixelFormatMethod) NULL)
+    {
+      format_info->import_packets(pixels,number_pixels,q);
+      return;
     }
-    case LongPixel:
+  stride=format_info->channels;
+  for (offset=0; offset < number_pixels; offset+=count)
+  {
+    count=number_pixels-offset;
+    if (count > PixelChannelBlock)
+      count=PixelChannelBlock;
+    for (i=0; i < (long) stride; i++)
     {
-      register const unsigned long
-        *p;
-
-      p=(const unsigned long *) pixels;
-      if (LocaleCompare(map,"BGR") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            q=GetAuthenticPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (q == (PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              q->blue=ScaleLongToQuantum(*p++);
-              q->green=ScaleLongToQuantum(*p++);
-              q->red=ScaleLongToQuantum(*p++);
-              q++;
-            }
-            if (SyncAuthenticPixels(image,exception) == MagickFalse)
-              break;
-          }
-          break;
-        }
-      if (LocaleCompare(map,"BGRA") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            q=GetAuthenticPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (q == (PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              q->blue=ScaleLongToQuantum(*p++);
-              q->green=ScaleLongToQuantum(*p++);
-              q->red=ScaleLongToQuantum(*p++);
-              q->opacity=(Quantum) QuantumRange-ScaleLongToQuantum(*p++);
-              q++;
-            }
-            if (SyncAuthenticPixels(image,exception) == MagickFalse)
-              break;
-          }
-          break;
-        }
-      if (LocaleCompare(map,"BGRP") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            q=GetAuthenticPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (q == (PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              q->blue=ScaleLongToQuantum(*p++);
-              q->green=ScaleLongToQuantum(*p++);
-              q->red=ScaleLongToQuantum(*p++);
-              p++;
-              q++;
-            }
-            if (SyncAuthenticPixels(image,exception) == MagickFalse)
-              break;
-          }
-          break;
-        }
-      if (LocaleCompare(map,"I") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            q=GetAuthenticPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (q == (PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              q->red=ScaleLongToQuantum(*p++);
-              q->green=q->red;
-              q->blue=q->red;
-              q++;
-            }
-            if (SyncAuthenticPixels(image,exception) == MagickFalse)
-              break;
-          }
-          break;
-        }
-      if (LocaleCompare(map,"RGB") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            q=GetAuthenticPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (q == (PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              q->red=ScaleLongToQuantum(*p++);
-              q->green=ScaleLongToQuantum(*p++);
-              q->blue=ScaleLongToQuantum(*p++);
-              q++;
-            }
-            if (SyncAuthenticPixels(image,exception) == MagickFalse)
-              break;
-          }
-          break;
-        }
-      if (LocaleCompare(map,"RGBA") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            q=GetAuthenticPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (q == (PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              q->red=ScaleLongToQuantum(*p++);
-              q->green=ScaleLongToQuantum(*p++);
-              q->blue=ScaleLongToQuantum(*p++);
-              q->opacity=(Quantum) QuantumRange-ScaleLongToQuantum(*p++);
-              q++;
-            }
-            if (SyncAuthenticPixels(image,exception) == MagickFalse)
-              break;
-          }
-          break;
-        }
-      if (LocaleCompare(map,"RGBP") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            q=GetAuthenticPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (q == (PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              q->red=ScaleLongToQuantum(*p++);
-              q->green=ScaleLongToQuantum(*p++);
-              q->blue=ScaleLongToQuantum(*p++);
-              p++;
-              q++;
-            }
-            if (SyncAuthenticPixels(image,exception) == MagickFalse)
-              break;
-          }
-          break;
-        }
-      for (y=0; y < (long) rows; y++)
+      d=ImportPixelChannel(format_info->quantum_map[i],q+offset,indexes ==
+        (IndexPacket *) NULL ? (IndexPacket *) NULL : indexes+offset,channel,
+        &step);
+      if (d == (Quantum *) NULL)
+        continue;
+      switch (format_info->storage)
       {
-        q=GetAuthenticPixels(image,x_offset,y_offset+y,columns,1,exception);
-        if (q == (PixelPacket *) NULL)
-          break;
-        indexes=GetAuthenticIndexQueue(image);
-        for (x=0; x < (long) columns; x++)
+        case CharPixel:
         {
-          for (i=0; i < (long) length; i++)
-          {
-            switch (quantum_map[i])
-            {
-              case RedQuantum:
-              case CyanQuantum:
-              {
-                q->red=ScaleLongToQuantum(*p);
-                break;
-              }
-              case GreenQuantum:
-              case MagentaQuantum:
-              {
-                q->green=ScaleLongToQuantum(*p);
-                break;
-              }
-              case BlueQuantum:
-              case YellowQuantum:
-              {
-                q->blue=ScaleLongToQuantum(*p);
-                break;
-              }
-              case AlphaQuantum:
-              {
-                q->opacity=(Quantum) QuantumRange-ScaleLongToQuantum(*p);
-                break;
-              }
-              case OpacityQuantum:
-              {
-                q->opacity=ScaleLongToQuantum(*p);
-                break;
-              }
-              case BlackQuantum:
-              {
-                indexes[x]=ScaleLongToQuantum(*p);
-                break;
-              }
-              case IndexQuantum:
-              {
-                q->red=ScaleLongToQuantum(*p);
-                q->green=q->red;
-                q->blue=q->red;
-                break;
-              }
-              default:
-                break;
-            }
-            p++;
-          }
-          q++;
-        }
-        if (SyncAuthenticPixels(image,exception) == MagickFalse)
-          break;
-      }
-      break;
-    }
-    case QuantumPixel:
-    {
-      register const Quantum
-        *p;
+          register const unsigned char
+            *__restrict p;
 
-      p=(const Quantum *) pixels;
-      if (LocaleCompare(map,"BGR") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            q=GetAuthenticPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (q == (PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              q->blue=(*p++);
-              q->green=(*p++);
-              q->red=(*p++);
-              q++;
-            }
-            if (SyncAuthenticPixels(image,exception) == MagickFalse)
-              break;
-          }
-          break;
-        }
-      if (LocaleCompare(map,"BGRA") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            q=GetAuthenticPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (q == (PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              q->blue=(*p++);
-              q->green=(*p++);
-              q->red=(*p++);
-              q->opacity=(Quantum) QuantumRange-(*p++);
-              q++;
-            }
-            if (SyncAuthenticPixels(image,exception) == MagickFalse)
-              break;
-          }
-          break;
-        }
-      if (LocaleCompare(map,"BGRP") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            q=GetAuthenticPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (q == (PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              q->blue=(*p++);
-              q->green=(*p++);
-              q->red=(*p++);
-              p++;
-              q++;
-            }
-            if (SyncAuthenticPixels(image,exception) == MagickFalse)
-              break;
-          }
-          break;
-        }
-      if (LocaleCompare(map,"I") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            q=GetAuthenticPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (q == (PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              q->red=(*p++);
-              q->green=q->red;
-              q->blue=q->red;
-              q++;
-            }
-            if (SyncAuthenticPixels(image,exception) == MagickFalse)
-              break;
-          }
-          break;
-        }
-      if (LocaleCompare(map,"RGB") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            q=GetAuthenticPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (q == (PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              q->red=(*p++);
-              q->green=(*p++);
-              q->blue=(*p++);
-              q++;
-            }
-            if (SyncAuthenticPixels(image,exception) == MagickFalse)
-              break;
-          }
+          p=(const unsigned char *) pixels+offset*stride+i;
+          for (x=0; x < (long) count; x++)
+            d[x*step]=ScaleCharToQuantum(p[x*stride]);
           break;
         }
-      if (LocaleCompare(map,"RGBA") == 0)
+        case DoublePixel:
         {
-          for (y=0; y < (long) rows; y++)
-          {
-            q=GetAuthenticPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (q == (PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              q->red=(*p++);
-              q->green=(*p++);
-              q->blue=(*p++);
-              q->opacity=(Quantum) QuantumRange-(*p++);
-              q++;
-            }
-            if (SyncAuthenticPixels(image,exception) == MagickFalse)
-              break;
-          }
+          register const double
+            *__restrict p;
+
+          p=(const double *) pixels+offset*stride+i;
+          for (x=0; x < (long) count; x++)
+            d[x*step]=RoundToQuantum((MagickRealType) QuantumRange*
+              p[x*stride]);
           break;
         }
-      if (LocaleCompare(map,"RGBP") == 0)
+        case FloatPixel:
         {
-          for (y=0; y < (long) rows; y++)
-          {
-            q=GetAuthenticPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (q == (PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              q->red=(*p++);
-              q->green=(*p++);
-              q->blue=(*p++);
-              p++;
-              q++;
-            }
-            if (SyncAuthenticPixels(image,exception) == MagickFalse)
-              break;
-          }
+          register const float
+            *__restrict p;
+
+          p=(const float *) pixels+offset*stride+i;
+          for (x=0; x < (long) count; x++)
+            d[x*step]=RoundToQuantum((MagickRealType) QuantumRange*
+              p[x*stride]);
           break;
         }
-      for (y=0; y < (long) rows; y++)
-      {
-        q=GetAuthenticPixels(image,x_offset,y_offset+y,columns,1,exception);
-        if (q == (PixelPacket *) NULL)
-          break;
-        indexes=GetAuthenticIndexQueue(image);
-        for (x=0; x < (long) columns; x++)
+        case IntegerPixel:
         {
-          for (i=0; i < (long) length; i++)
-          {
-            switch (quantum_map[i])
-            {
-              case RedQuantum:
-              case CyanQuantum:
-              {
-                q->red=(*p);
-                break;
-              }
-              case GreenQuantum:
-              case MagentaQuantum:
-              {
-                q->green=(*p);
-                break;
-              }
-              case BlueQuantum:
-              case YellowQuantum:
-              {
-                q->blue=(*p);
-                break;
-              }
-              case AlphaQuantum:
-              {
-                q->opacity=(Quantum) QuantumRange-(*p);
-                break;
-              }
-              case OpacityQuantum:
-              {
-                q->opacity=(*p);
-                break;
-              }
-              case BlackQuantum:
-              {
-                indexes[x]=(*p);
-                break;
-              }
-              case IndexQuantum:
-              {
-                q->red=(*p);
-                q->green=q->red;
-                q->blue=q->red;
-                break;
-              }
-              default:
-                break;
-            }
-            p++;
-          }
-          q++;
-        }
-        if (SyncAuthenticPixels(image,exception) == MagickFalse)
-          break;
-      }
-      break;
-    }
-    case ShortPixel:
-    {
-      register const unsigned short
-        *p;
+          register const unsigned int
+            *__restrict p;
 
-      p=(const unsigned short *) pixels;
-      if (LocaleCompare(map,"BGR") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            q=GetAuthenticPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (q == (PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              q->blue=ScaleShortToQuantum(*p++);
-              q->green=ScaleShortToQuantum(*p++);
-              q->red=ScaleShortToQuantum(*p++);
-              q++;
-            }
-            if (SyncAuthenticPixels(image,exception) == MagickFalse)
-              break;
-          }
+          p=(const unsigned int *) pixels+offset*stride+i;
+          for (x=0; x < (long) count; x++)
+            d[x*step]=ScaleLongToQuantum(p[x*stride]);
           break;
         }
-      if (LocaleCompare(map,"BGRA") == 0)
+        case LongPixel:
         {
-          for (y=0; y < (long) rows; y++)
-          {
-            q=GetAuthenticPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (q == (PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              q->blue=ScaleShortToQuantum(*p++);
-              q->green=ScaleShortToQuantum(*p++);
-              q->red=ScaleShortToQuantum(*p++);
-              q->opacity=(Quantum) QuantumRange-ScaleShortToQuantum(*p++);
-              q++;
-            }
-            if (SyncAuthenticPixels(image,exception) == MagickFalse)
-              break;
-          }
+          register const unsigned long
+            *__restrict p;
+
+          p=(const unsigned long *) pixels+offset*stride+i;
+          for (x=0; x < (long) count; x++)
+            d[x*step]=ScaleLongToQuantum(p[x*stride]);
           break;
         }
-      if (LocaleCompare(map,"BGRP") == 0)
+        case QuantumPixel:
         {
-          for (y=0; y < (long) rows; y++)
-          {
-            q=GetAuthenticPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (q == (PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              q->blue=ScaleShortToQuantum(*p++);
-              q->green=ScaleShortToQuantum(*p++);
-              q->red=ScaleShortToQuantum(*p++);
-              p++;
-              q++;
-            }
-            if (SyncAuthenticPixels(image,exception) == MagickFalse)
-              break;
-          }
+          register const Quantum
+            *__restrict p;
+
+          p=(const Quantum *) pixels+offset*stride+i;
+          for (x=0; x < (long) count; x++)
+            d[x*step]=p[x*stride];
           break;
         }
-      if (LocaleCompare(map,"I") == 0)
+        case ShortPixel:
         {
-          for (y=0; y < (long) rows; y++)
-          {
-            q=GetAuthenticPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (q == (PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              q->red=ScaleShortToQuantum(*p++);
-              q->green=q->red;
-              q->blue=q->red;
-              q++;
-            }
-            if (SyncAuthenticPixels(image,exception) == MagickFalse)
-              break;
-          }
+          register const unsigned short
+            *__restrict p;
+
+          p=(const unsigned short *) pixels+offset*stride+i;
+          for (x=0; x < (long) count; x++)
+            d[x*step]=ScaleShortToQuantum(p[x*stride]);
           break;
         }
-      if (LocaleCompare(map,"RGB") == 0)
-        {
-          for (y=0; y < (long) rows; y++)
-          {
-            q=GetAuthenticPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (q == (PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              q->red=ScaleShortToQuantum(*p++);
-              q->green=ScaleShortToQuantum(*p++);
-              q->blue=ScaleShortToQuantum(*p++);
-              q++;
-            }
-            if (SyncAuthenticPixels(image,exception) == MagickFalse)
-              break;
-          }
+        default:
           break;
-        }
-      if (LocaleCompare(map,"RGBA") == 0)
+      }
+      switch (format_info->quantum_map[i])
+      {
+        case AlphaQuantum:
         {
-          for (y=0; y < (long) rows; y++)
-          {
-            q=GetAuthenticPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (q == (PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              q->red=ScaleShortToQuantum(*p++);
-              q->green=ScaleShortToQuantum(*p++);
-              q->blue=ScaleShortToQuantum(*p++);
-              q->opacity=(Quantum) QuantumRange-ScaleShortToQuantum(*p++);
-              q++;
-            }
-            if (SyncAuthenticPixels(image,exception) == MagickFalse)
-              break;
-          }
+          for (x=0; x < (long) count; x++)
+            q[offset+x].opacity=(Quantum) QuantumRange-channel[x];
           break;
         }
-      if (LocaleCompare(map,"RGBP") == 0)
+        case IndexQuantum:
         {
-          for (y=0; y < (long) rows; y++)
+          for (x=0; x < (long) count; x++)
           {
-            q=GetAuthenticPixels(image,x_offset,y_offset+y,columns,1,exception);
-            if (q == (PixelPacket *) NULL)
-              break;
-            for (x=0; x < (long) columns; x++)
-            {
-              q->red=ScaleShortToQuantum(*p++);
-              q->green=ScaleShortToQuantum(*p++);
-              q->blue=ScaleShortToQuantum(*p++);
-              p++;
-              q++;
-            }
-            if (SyncAuthenticPixels(image,exception) == MagickFalse)
-              break;
+            q[offset+x].red=channel[x];
+            q[offset+x].green=channel[x];
+            q[offset+x].blue=channel[x];
           }
           break;
         }
-      for (y=0; y < (long) rows; y++)
-      {
-        q=GetAuthenticPixels(image,x_offset,y_offset+y,columns,1,exception);
-        if (q == (PixelPacket *) NULL)
-          break;
-        indexes=GetAuthenticIndexQueue(image);
-        for (x=0; x < (long) columns; x++)
-        {
-          for (i=0; i < (long) length; i++)
-          {
-            switch (quantum_map[i])
-            {
-              case RedQuantum:
-              case CyanQuantum:
-              {
-                q->red=ScaleShortToQuantum(*p);
-                break;
-              }
-              case GreenQuantum:
-              case MagentaQuantum:
-              {
-                q->green=ScaleShortToQuantum(*p);
-                break;
-              }
-              case BlueQuantum:
-              case YellowQuantum:
-              {
-                q->blue=ScaleShortToQuantum(*p);
-                break;
-              }
-              case AlphaQuantum:
-              {
-                q->opacity=(Quantum) QuantumRange-ScaleShortToQuantum(*p);
-                break;
-              }
-              case OpacityQuantum:
-              {
-                q->opacity=ScaleShortToQuantum(*p);
-                break;
-              }
-              case BlackQuantum:
-              {
-                indexes[x]=ScaleShortToQuantum(*p);
-                break;
-              }
-              case IndexQuantum:
-              {
-                q->red=ScaleShortToQuantum(*p);
-                q->green=q->red;
-                q->blue=q->red;
-                break;
-              }
-              default:
-                break;
-            }
-            p++;
-          }
-          q++;
-        }
-        if (SyncAuthenticPixels(image,exception) == MagickFalse)
+        default:
           break;
       }
-      break;
-    }
-    default:
-    {
-      quantum_map=(QuantumType *) RelinquishMagickMemory(quantum_map);
-      (void) ThrowMagickException(&image->exception,GetMagickModule(),
-        OptionError,"UnrecognizedPixelMap","`%s'",map);
-      break;
     }
   }
-  quantum_map=(QuantumType *) RelinquishMagickMemory(quantum_map);
-  return(MagickTrue);
 }
@@ -79,14 +79,34 @@ typedef struct _PixelPacket
 #endif
 } PixelPacket;
 
+typedef struct _PixelFormatInfo
+  PixelFormatInfo;
+
 extern MagickExport MagickBooleanType
+  ExportFormattedImagePixels(const Image *,const long,const long,
+    const unsigned long,const unsigned long,const PixelFormatInfo *,void *,
+    ExceptionInfo *),
   ExportImagePixels(const Image *,const long,const long,const unsigned long,
     const unsigned long,const char *,const StorageType,void *,ExceptionInfo *),
+  ImportFormattedImagePixels(Image *,const long,const long,
+    const unsigned long,const unsigned long,const PixelFormatInfo *,
+    const void *),
   ImportImagePixels(Image *,const long,const long,const unsigned long,
     const unsigned long,const char *,const StorageType,const void *);
 
+extern MagickExport PixelFormatInfo
+  *AcquirePixelFormatInfo(const char *,const StorageType,ExceptionInfo *),
+  *DestroyPixelFormatInfo(PixelFormatInfo *);
+
+extern MagickExport size_t
+  GetPixelFormatExtent(const PixelFormatInfo *);
+
 extern MagickExport void
-  GetMagickPixelPacket(const Image *,MagickPixelPacket *);
+  ExportPixelFormatPackets(const PixelFormatInfo *,const PixelPacket *,
+    const IndexPacket *,const size_t,void *),
+  GetMagickPixelPacket(const Image *,MagickPixelPacket *),
+  ImportPixelFormatPackets(const PixelFormatInfo *,const void *,const size_t,
+    PixelPacket *,IndexPacket *);
 
 #if defined(__cplusplus) || defined(c_plusplus)
 }
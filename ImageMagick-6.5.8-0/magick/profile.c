@@ -1151,7 +1151,8 @@ MagickExport MagickBooleanType ProfileImage(Image *image,const char *name,
           progress=0;
           image_view=AcquireCacheView(image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-          #pragma omp parallel for schedule(dynamic,4) shared(status)
+          #pragma omp parallel for shared(status) \
+            magick_schedule(NeighborhoodThreadCost,image->columns,image->rows)
 #endif
           for (y=0; y < (long) image->rows; y++)
           {
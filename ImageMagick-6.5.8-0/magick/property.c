@@ -67,10 +67,10 @@
 #include "magick/property.h"
 #include "magick/quantum.h"
 #include "magick/resource_.h"
-#include "magick/splay-tree.h"
 #include "magick/signature-private.h"
 #include "magick/statistic.h"
 #include "magick/string_.h"
+#include "magick/string-map.h"
 #include "magick/token.h"
 #include "magick/utility.h"
 #include "magick/xml-tree.h"
@@ -162,9 +162,8 @@ MagickExport MagickBooleanType CloneImageProperties(Image *image,
     {
       if (image->properties != (void *) NULL)
         DestroyImageProperties(image);
-      image->properties=CloneSplayTree((SplayTreeInfo *)
-        clone_image->properties,(void *(*)(void *)) ConstantString,
-        (void *(*)(void *)) ConstantString);
+      image->properties=CloneStringMap((StringMapInfo *)
+        clone_image->properties);
     }
   return(MagickTrue);
 }
@@ -251,7 +250,8 @@ MagickExport MagickBooleanType DeleteImageProperty(Image *image,
       image->filename);
   if (image->properties == (void *) NULL)
     return(MagickFalse);
-  return(DeleteNodeFromSplayTree((SplayTreeInfo *) image->properties,property));
+  return(DeleteEntryFromStringMap((StringMapInfo *) image->properties,
+    property));
 }
 
 /*
@@ -285,7 +285,7 @@ MagickExport void DestroyImageProperties(Image *image)
     (void) LogMagickEvent(TraceEvent,GetMagickModule(),"%s",
       image->filename);
   if (image->properties != (void *) NULL)
-    image->properties=(void *) DestroySplayTree((SplayTreeInfo *)
+    image->properties=(void *) DestroyStringMap((StringMapInfo *)
       image->properties);
 }
 
@@ -1432,7 +1432,7 @@ static MagickBooleanType GetEXIFProperty(const Image *image,
               }
               p=(const char *) NULL;
               if (image->properties != (void *) NULL)
-                p=(const char *) GetValueFromSplayTree((SplayTreeInfo *)
+                p=(const char *) GetValueFromStringMap((StringMapInfo *)
                   image->properties,key);
               if (p == (const char *) NULL)
                 (void) SetImageProperty((Image *) image,key,value);
@@ -1529,8 +1529,7 @@ static MagickBooleanType GetXMPProperty(const Image *image,
   if (rdf != (XMLTreeInfo *) NULL)
     {
       if (image->properties == (void *) NULL)
-        ((Image *) image)->properties=NewSplayTree(CompareSplayTreeString,
-          RelinquishMagickMemory,RelinquishMagickMemory);
+        ((Image *) image)->properties=NewStringMap();
       description=GetXMLTreeChild(rdf,"rdf:Description");
       while (description != (XMLTreeInfo *) NULL)
       {
@@ -1539,15 +1538,13 @@ static MagickBooleanType GetXMPProperty(const Image *image,
         {
           child=GetXMLTreeChild(node,(const char *) NULL);
           if (child == (XMLTreeInfo *) NULL)
-            (void) AddValueToSplayTree((SplayTreeInfo *) image->properties,
-              ConstantString(GetXMLTreeTag(node)),
-              ConstantString(GetXMLTreeContent(node)));
+            (void) PutEntryInStringMap((StringMapInfo *) image->properties,
+              GetXMLTreeTag(node),GetXMLTreeContent(node));
           while (child != (XMLTreeInfo *) NULL)
           {
             if (LocaleCompare(GetXMLTreeTag(child),"rdf:Seq") != 0)
-              (void) AddValueToSplayTree((SplayTreeInfo *) image->properties,
-                ConstantString(GetXMLTreeTag(child)),
-                ConstantString(GetXMLTreeContent(child)));
+              (void) PutEntryInStringMap((StringMapInfo *) image->properties,
+                GetXMLTreeTag(child),GetXMLTreeContent(child));
             child=GetXMLTreeSibling(child);
           }
           node=GetXMLTreeSibling(node);
@@ -1966,15 +1963,15 @@ MagickExport const char *GetImageProperty(const Image *image,
   p=(const char *) NULL;
   if (property == (const char *) NULL)
     {
-      ResetSplayTreeIterator((SplayTreeInfo *) image->properties);
-      p=(const char *) GetNextValueInSplayTree((SplayTreeInfo *)
+      ResetStringMapIterator((StringMapInfo *) image->properties);
+      p=(const char *) GetNextValueInStringMap((StringMapInfo *)
         image->properties);
       return(p);
     }
   if ((image->properties != (void *) NULL) &&
       (LocaleNCompare("fx:",property,3) != 0))
     {
-      p=(const char *) GetValueFromSplayTree((SplayTreeInfo *)
+      p=(const char *) GetValueFromStringMap((StringMapInfo *)
         image->properties,property);
       if (p != (const char *) NULL)
         return(p);
@@ -1990,7 +1987,7 @@ MagickExport const char *GetImageProperty(const Image *image,
         {
           if (Get8BIMProperty(image,property) != MagickFalse)
             {
-              p=(const char *) GetValueFromSplayTree((SplayTreeInfo *)
+              p=(const char *) GetValueFromStringMap((StringMapInfo *)
                 image->properties,property);
               return(p);
             }
@@ -2004,7 +2001,7 @@ MagickExport const char *GetImageProperty(const Image *image,
         {
           if (GetEXIFProperty(image,property) != MagickFalse)
             {
-              p=(const char *) GetValueFromSplayTree((SplayTreeInfo *)
+              p=(const char *) GetValueFromStringMap((StringMapInfo *)
                 image->properties,property);
               return(p);
             }
@@ -2028,7 +2025,7 @@ MagickExport const char *GetImageProperty(const Image *image,
                 alpha);
               (void) SetImageProperty((Image *) image,property,value);
             }
-          p=(const char *) GetValueFromSplayTree((SplayTreeInfo *)
+          p=(const char *) GetValueFromStringMap((StringMapInfo *)
             image->properties,property);
           return(p);
         }
@@ -2041,7 +2038,7 @@ MagickExport const char *GetImageProperty(const Image *image,
         {
           if (GetIPTCProperty(image,property) != MagickFalse)
             {
-              p=(const char *) GetValueFromSplayTree((SplayTreeInfo *)
+              p=(const char *) GetValueFromStringMap((StringMapInfo *)
                 image->properties,property);
               return(p);
             }
@@ -2097,7 +2094,7 @@ MagickExport const char *GetImageProperty(const Image *image,
         {
           if (GetXMPProperty(image,property) != MagickFalse)
             {
-              p=(const char *) GetValueFromSplayTree((SplayTreeInfo *)
+              p=(const char *) GetValueFromStringMap((StringMapInfo *)
                 image->properties,property);
               return(p);
             }
@@ -2439,10 +2436,9 @@ MagickExport const char *GetMagickProperty(const ImageInfo *image_info,
   if (*value != '\0')
    {
      if (image->properties == (void *) NULL)
-       image->properties=NewSplayTree(CompareSplayTreeString,
-         RelinquishMagickMemory,RelinquishMagickMemory);
-     (void) AddValueToSplayTree((SplayTreeInfo *) image->properties,
-       ConstantString(property),ConstantString(value));
+       image->properties=NewStringMap();
+     (void) PutEntryInStringMap((StringMapInfo *) image->properties,
+       property,value);
    }
   return(GetImageProperty(image,property));
 }
@@ -2478,7 +2474,7 @@ MagickExport char *GetNextImageProperty(const Image *image)
       image->filename);
   if (image->properties == (void *) NULL)
     return((char *) NULL);
-  return((char *) GetNextKeyInSplayTree((SplayTreeInfo *) image->properties));
+  return((char *) GetNextKeyInStringMap((StringMapInfo *) image->properties));
 }
 
 /*
@@ -3168,7 +3164,7 @@ MagickExport char *RemoveImageProperty(Image *image,
       image->filename);
   if (image->properties == (void *) NULL)
     return((char *) NULL);
-  value=(char *) RemoveNodeFromSplayTree((SplayTreeInfo *) image->properties,
+  value=(char *) RemoveEntryFromStringMap((StringMapInfo *) image->properties,
     property);
   return(value);
 }
@@ -3206,7 +3202,7 @@ MagickExport void ResetImagePropertyIterator(const Image *image)
       image->filename);
   if (image->properties == (void *) NULL)
     return;
-  ResetSplayTreeIterator((SplayTreeInfo *) image->properties);
+  ResetStringMapIterator((StringMapInfo *) image->properties);
 }
 
 /*
@@ -3251,8 +3247,7 @@ MagickExport MagickBooleanType SetImageProperty(Image *image,
     (void) LogMagickEvent(TraceEvent,GetMagickModule(),"%s",
       image->filename);
   if (image->properties == (void *) NULL)
-    image->properties=NewSplayTree(CompareSplayTreeString,
-      RelinquishMagickMemory,RelinquishMagickMemory);
+    image->properties=NewStringMap();
   if ((value == (const char *) NULL) || (*value == '\0'))
     return(DeleteImageProperty(image,property));
   status=MagickTrue;
@@ -3266,8 +3261,8 @@ MagickExport MagickBooleanType SetImageProperty(Image *image,
           image->bias=StringToDouble(value,QuantumRange);
           break;
         }
-      status=AddValueToSplayTree((SplayTreeInfo *) image->properties,
-        ConstantString(property),ConstantString(value));
+      status=PutEntryInStringMap((StringMapInfo *) image->properties,
+        property,value);
       break;
     }
     case 'C':
@@ -3308,8 +3303,8 @@ MagickExport MagickBooleanType SetImageProperty(Image *image,
           image->compression=(CompressionType) compression;
           break;
         }
-      status=AddValueToSplayTree((SplayTreeInfo *) image->properties,
-        ConstantString(property),ConstantString(value));
+      status=PutEntryInStringMap((StringMapInfo *) image->properties,
+        property,value);
       break;
     }
     case 'D':
@@ -3354,8 +3349,8 @@ MagickExport MagickBooleanType SetImageProperty(Image *image,
           image->dispose=(DisposeType) dispose;
           break;
         }
-      status=AddValueToSplayTree((SplayTreeInfo *) image->properties,
-        ConstantString(property),ConstantString(value));
+      status=PutEntryInStringMap((StringMapInfo *) image->properties,
+        property,value);
       break;
     }
     case 'G':
@@ -3372,8 +3367,8 @@ MagickExport MagickBooleanType SetImageProperty(Image *image,
           image->gravity=(GravityType) gravity;
           break;
         }
-      status=AddValueToSplayTree((SplayTreeInfo *) image->properties,
-        ConstantString(property),ConstantString(value));
+      status=PutEntryInStringMap((StringMapInfo *) image->properties,
+        property,value);
       break;
     }
     case 'I':
@@ -3403,8 +3398,8 @@ MagickExport MagickBooleanType SetImageProperty(Image *image,
           image->interpolate=(InterpolatePixelMethod) interpolate;
           break;
         }
-      status=AddValueToSplayTree((SplayTreeInfo *) image->properties,
-        ConstantString(property),ConstantString(value));
+      status=PutEntryInStringMap((StringMapInfo *) image->properties,
+        property,value);
       break;
     }
     case 'L':
@@ -3415,8 +3410,8 @@ MagickExport MagickBooleanType SetImageProperty(Image *image,
           image->iterations=(unsigned long) atol(value);
           break;
         }
-      status=AddValueToSplayTree((SplayTreeInfo *) image->properties,
-        ConstantString(property),ConstantString(value));
+      status=PutEntryInStringMap((StringMapInfo *) image->properties,
+        property,value);
       break;
     }
     case 'P':
@@ -3432,8 +3427,8 @@ MagickExport MagickBooleanType SetImageProperty(Image *image,
           geometry=DestroyString(geometry);
           break;
         }
-      status=AddValueToSplayTree((SplayTreeInfo *) image->properties,
-        ConstantString(property),ConstantString(value));
+      status=PutEntryInStringMap((StringMapInfo *) image->properties,
+        property,value);
       break;
     }
     case 'R':
@@ -3451,8 +3446,8 @@ MagickExport MagickBooleanType SetImageProperty(Image *image,
           image->rendering_intent=(RenderingIntent) rendering_intent;
           break;
         }
-      status=AddValueToSplayTree((SplayTreeInfo *) image->properties,
-        ConstantString(property),ConstantString(value));
+      status=PutEntryInStringMap((StringMapInfo *) image->properties,
+        property,value);
       break;
     }
     case 'T':
@@ -3468,14 +3463,14 @@ MagickExport MagickBooleanType SetImageProperty(Image *image,
           geometry=DestroyString(geometry);
           break;
         }
-      status=AddValueToSplayTree((SplayTreeInfo *) image->properties,
-        ConstantString(property),ConstantString(value));
+      status=PutEntryInStringMap((StringMapInfo *) image->properties,
+        property,value);
       break;
     }
     default:
     {
-      status=AddValueToSplayTree((SplayTreeInfo *) image->properties,
-        ConstantString(property),ConstantString(value));
+      status=PutEntryInStringMap((StringMapInfo *) image->properties,
+        property,value);
       break;
     }
   }
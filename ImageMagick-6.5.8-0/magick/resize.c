@@ -63,8 +63,10 @@
 #include "magick/resample.h"
 #include "magick/resize.h"
 #include "magick/resize-private.h"
+#include "magick/stream.h"
 #include "magick/string_.h"
 #include "magick/thread-private.h"
+#include "magick/trace.h"
 #include "magick/utility.h"
 #include "magick/version.h"
 #if defined(MAGICKCORE_LQR_DELEGATE)
@@ -1605,22 +1607,8 @@ typedef struct _ContributionInfo
     pixel;
 } ContributionInfo;
 
-static ContributionInfo **DestroyContributionThreadSet(
-  ContributionInfo **contribution)
-{
-  register long
-    i;
-
-  assert(contribution != (ContributionInfo **) NULL);
-  for (i=0; i < (long) GetOpenMPMaximumThreads(); i++)
-    if (contribution[i] != (ContributionInfo *) NULL)
-      contribution[i]=(ContributionInfo *) RelinquishMagickMemory(
-        contribution[i]);
-  contribution=(ContributionInfo **) RelinquishAlignedMemory(contribution);
-  return(contribution);
-}
-
-static ContributionInfo **AcquireContributionThreadSet(const size_t count)
+static ContributionInfo **AcquireContributionThreadSet(MemoryArena *arena,
+  const size_t count)
 {
   register long
     i;
@@ -1632,17 +1620,16 @@ static ContributionInfo **AcquireContributionThreadSet(const size_t count)
     number_threads;
 
   number_threads=GetOpenMPMaximumThreads();
-  contribution=(ContributionInfo **) AcquireAlignedMemory(number_threads,
+  contribution=(ContributionInfo **) AcquireArenaMemory(arena,number_threads,
     sizeof(*contribution));
   if (contribution == (ContributionInfo **) NULL)
     return((ContributionInfo **) NULL);
-  (void) ResetMagickMemory(contribution,0,number_threads*sizeof(*contribution));
   for (i=0; i < (long) number_threads; i++)
   {
-    contribution[i]=(ContributionInfo *) AcquireQuantumMemory(count,
+    contribution[i]=(ContributionInfo *) AcquireArenaMemory(arena,count,
       sizeof(**contribution));
     if (contribution[i] == (ContributionInfo *) NULL)
-      return(DestroyContributionThreadSet(contribution));
+      return((ContributionInfo **) NULL);
   }
   return(contribution);
 }
@@ -1686,6 +1673,9 @@ static MagickBooleanType HorizontalFilter(const ResizeFilter *resize_filter,
     scale,
     support;
 
+  MemoryArena
+    *arena;
+
   CacheView
     *image_view,
     *resize_view;
@@ -1709,9 +1699,11 @@ static MagickBooleanType HorizontalFilter(const ResizeFilter *resize_filter,
       support=(MagickRealType) 0.5;
       scale=1.0;
     }
-  contributions=AcquireContributionThreadSet((size_t) (2.0*support+3.0));
+  arena=AcquireMemoryArena(0);
+  contributions=AcquireContributionThreadSet(arena,(size_t) (2.0*support+3.0));
   if (contributions == (ContributionInfo **) NULL)
     {
+      arena=RelinquishMemoryArena(arena);
       (void) ThrowMagickException(exception,GetMagickModule(),
         ResourceLimitError,"MemoryAllocationFailed","`%s'",image->filename);
       return(MagickFalse);
@@ -1721,8 +1713,12 @@ static MagickBooleanType HorizontalFilter(const ResizeFilter *resize_filter,
   (void) ResetMagickMemory(&zero,0,sizeof(zero));
   image_view=AcquireCacheView(image);
   resize_view=AcquireCacheView(resize_image);
+  TraceMagickEvent(OpenMPTrace,BeginTracePhase,"HorizontalFilter",
+    (const char *) NULL,(MagickSizeType) GetOpenMPMaximumThreads());
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for shared(status)
+  #pragma omp parallel for shared(status) \
+    magick_schedule(NeighborhoodThreadCost,resize_image->rows, \
+      resize_image->columns)
 #endif
   for (x=0; x < (long) resize_image->columns; x++)
   {
@@ -1898,9 +1894,11 @@ static MagickBooleanType HorizontalFilter(const ResizeFilter *resize_filter,
           status=MagickFalse;
       }
   }
+  TraceMagickEvent(OpenMPTrace,EndTracePhase,"HorizontalFilter",
+    (const char *) NULL,(MagickSizeType) GetOpenMPMaximumThreads());
   resize_view=DestroyCacheView(resize_view);
   image_view=DestroyCacheView(image_view);
-  contributions=DestroyContributionThreadSet(contributions);
+  arena=RelinquishMemoryArena(arena);
   return(status);
 }
 
@@ -1927,6 +1925,9 @@ static MagickBooleanType VerticalFilter(const ResizeFilter *resize_filter,
     scale,
     support;
 
+  MemoryArena
+    *arena;
+
   CacheView
     *image_view,
     *resize_view;
@@ -1950,9 +1951,11 @@ static MagickBooleanType VerticalFilter(const ResizeFilter *resize_filter,
       support=(MagickRealType) 0.5;
       scale=1.0;
     }
-  contributions=AcquireContributionThreadSet((size_t) (2.0*support+3.0));
+  arena=AcquireMemoryArena(0);
+  contributions=AcquireContributionThreadSet(arena,(size_t) (2.0*support+3.0));
   if (contributions == (ContributionInfo **) NULL)
     {
+      arena=RelinquishMemoryArena(arena);
       (void) ThrowMagickException(exception,GetMagickModule(),
         ResourceLimitError,"MemoryAllocationFailed","`%s'",image->filename);
       return(MagickFalse);
@@ -1962,8 +1965,12 @@ static MagickBooleanType VerticalFilter(const ResizeFilter *resize_filter,
   (void) ResetMagickMemory(&zero,0,sizeof(zero));
   image_view=AcquireCacheView(image);
   resize_view=AcquireCacheView(resize_image);
+  TraceMagickEvent(OpenMPTrace,BeginTracePhase,"VerticalFilter",
+    (const char *) NULL,(MagickSizeType) GetOpenMPMaximumThreads());
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for shared(status)
+  #pragma omp parallel for shared(status) \
+    magick_schedule(NeighborhoodThreadCost,resize_image->columns, \
+      resize_image->rows)
 #endif
   for (y=0; y < (long) resize_image->rows; y++)
   {
@@ -2139,9 +2146,11 @@ static MagickBooleanType VerticalFilter(const ResizeFilter *resize_filter,
           status=MagickFalse;
       }
   }
+  TraceMagickEvent(OpenMPTrace,EndTracePhase,"VerticalFilter",
+    (const char *) NULL,(MagickSizeType) GetOpenMPMaximumThreads());
   resize_view=DestroyCacheView(resize_view);
   image_view=DestroyCacheView(image_view);
-  contributions=DestroyContributionThreadSet(contributions);
+  arena=RelinquishMemoryArena(arena);
   return(status);
 }
 
@@ -2336,7 +2345,8 @@ MagickExport Image *SampleImage(const Image *image,const unsigned long columns,
   image_view=AcquireCacheView(image);
   sample_view=AcquireCacheView(sample_image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(PointThreadCost,sample_image->columns,sample_image->rows)
 #endif
   for (y=0; y < (long) sample_image->rows; y++)
   {
@@ -2830,6 +2840,702 @@ MagickExport void SetResizeFilterSupport(ResizeFilter *resize_filter,
 %                                                                             %
 %                                                                             %
 %                                                                             %
+%   S t r e a m R e s i z e I m a g e                                         %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  StreamResizeImage() reads an image and scales it to the desired dimensions
+%  without ever holding the full-size image in memory.  Scanlines are pulled
+%  from the coder with ReadStream() and kept in a ring buffer just tall enough
+%  to cover the vertical filter support.  Each resized row is emitted as soon
+%  as its last contributing scanline is decoded, so memory is proportional to
+%  the image width times the filter support rather than to the image size.
+%
+%  The two filter passes run in the order ResizeImage() runs them, and each
+%  rounds to a quantum as it does, so the result matches -resize: an enlarged
+%  image filters each scanline horizontally as it arrives and buffers it at
+%  the resized width, whereas a reduced one buffers source scanlines and
+%  filters them vertically first.
+%
+%  Only the first frame of a multi-frame image is resized.  The coder must
+%  deliver its scanlines top-to-bottom one row at a time (e.g. JPEG, PNG,
+%  PNM, stripped TIFF, or raw RGB); interlaced or tiled layouts are not
+%  supported.  The filter selection follows ResizeImage().
+%
+%  The format of the StreamResizeImage method is:
+%
+%      Image *StreamResizeImage(const ImageInfo *image_info,
+%        const char *geometry,const FilterTypes filter,const double blur,
+%        ExceptionInfo *exception)
+%
+%  A description of each parameter follows:
+%
+%    o image_info: the image info.
+%
+%    o geometry: the resized image geometry, relative to the source image
+%      dimensions (e.g. 10% or 640x480).
+%
+%    o filter: Image filter to use.
+%
+%    o blur: the blur factor where > 1 is blurry, < 1 is sharp.
+%
+%    o exception: return any errors or warnings in this structure.
+%
+*/
+
+typedef struct _StreamResizeInfo
+{
+  const ImageInfo
+    *image_info;
+
+  const char
+    *geometry;
+
+  FilterTypes
+    filter;
+
+  double
+    blur;
+
+  const Image
+    *image;
+
+  Image
+    *resize_image;
+
+  CacheView
+    *resize_view;
+
+  ResizeFilter
+    *resize_filter;
+
+  MagickRealType
+    y_factor,
+    y_scale,
+    y_support;
+
+  ContributionInfo
+    *x_contributions,
+    *y_contributions;
+
+  long
+    *x_count,
+    x_window,
+    y_window,
+    y,
+    resize_y;
+
+  unsigned long
+    columns;
+
+  PixelPacket
+    *scanlines,
+    *row_pixels;
+
+  IndexPacket
+    *scanline_indexes,
+    *row_indexes;
+
+  MagickBooleanType
+    vertical_first,
+    status;
+
+  ExceptionInfo
+    *exception;
+} StreamResizeInfo;
+
+static MagickBooleanType AcquireStreamResizeInfo(StreamResizeInfo *resize_info,
+  const Image *image)
+{
+  FilterTypes
+    filter_type;
+
+  long
+    n,
+    start,
+    stop,
+    x;
+
+  MagickRealType
+    center,
+    density,
+    x_factor,
+    x_scale,
+    x_support;
+
+  RectangleInfo
+    geometry;
+
+  register long
+    i;
+
+  /*
+    Size the resized image and its filter from the first scanline's image.
+  */
+  SetGeometry(image,&geometry);
+  (void) ParseRegionGeometry(image,resize_info->geometry,&geometry,
+    resize_info->exception);
+  if ((geometry.width == 0) || (geometry.height == 0))
+    {
+      (void) ThrowMagickException(resize_info->exception,GetMagickModule(),
+        ImageError,"NegativeOrZeroImageSize","`%s'",image->filename);
+      return(MagickFalse);
+    }
+  resize_info->resize_image=CloneImage(image,geometry.width,geometry.height,
+    MagickTrue,resize_info->exception);
+  if (resize_info->resize_image == (Image *) NULL)
+    return(MagickFalse);
+  resize_info->resize_image->client_data=resize_info->image_info->client_data;
+  if (SetImageStorageClass(resize_info->resize_image,DirectClass) ==
+      MagickFalse)
+    {
+      InheritException(resize_info->exception,
+        &resize_info->resize_image->exception);
+      return(MagickFalse);
+    }
+  x_factor=(MagickRealType) geometry.width/(MagickRealType) image->columns;
+  resize_info->y_factor=(MagickRealType) geometry.height/(MagickRealType)
+    image->rows;
+  filter_type=LanczosFilter;
+  if (resize_info->filter != UndefinedFilter)
+    filter_type=resize_info->filter;
+  else
+    if ((x_factor == 1.0) && (resize_info->y_factor == 1.0))
+      filter_type=PointFilter;
+    else
+      if ((image->storage_class == PseudoClass) ||
+          (image->matte != MagickFalse) ||
+          ((x_factor*resize_info->y_factor) > 1.0))
+        filter_type=MitchellFilter;
+  resize_info->resize_filter=AcquireResizeFilter(image,filter_type,
+    resize_info->blur,MagickFalse,resize_info->exception);
+  if (resize_info->resize_filter == (ResizeFilter *) NULL)
+    return(MagickFalse);
+  x_scale=MagickMax(1.0/x_factor,1.0);
+  x_support=x_scale*GetResizeFilterSupport(resize_info->resize_filter);
+  if (x_support < 0.5)
+    {
+      x_support=(MagickRealType) 0.5;
+      x_scale=1.0;
+    }
+  x_scale=1.0/x_scale;
+  resize_info->y_scale=MagickMax(1.0/resize_info->y_factor,1.0);
+  resize_info->y_support=resize_info->y_scale*
+    GetResizeFilterSupport(resize_info->resize_filter);
+  if (resize_info->y_support < 0.5)
+    {
+      resize_info->y_support=(MagickRealType) 0.5;
+      resize_info->y_scale=1.0;
+    }
+  resize_info->y_scale=1.0/resize_info->y_scale;
+  resize_info->x_window=(long) (2.0*x_support+3.0);
+  resize_info->y_window=(long) (2.0*resize_info->y_support+3.0);
+  resize_info->x_contributions=(ContributionInfo *) AcquireQuantumMemory(
+    (size_t) geometry.width*resize_info->x_window,
+    sizeof(*resize_info->x_contributions));
+  resize_info->x_count=(long *) AcquireQuantumMemory((size_t) geometry.width,
+    sizeof(*resize_info->x_count));
+  resize_info->y_contributions=(ContributionInfo *) AcquireQuantumMemory(
+    (size_t) resize_info->y_window,sizeof(*resize_info->y_contributions));
+  /*
+    Filter in the order ResizeImage() does, so the rounding of the
+    intermediate pass is the same: a reduction buffers source scanlines and
+    filters them vertically first.
+  */
+  resize_info->vertical_first=MagickTrue;
+  resize_info->columns=image->columns;
+  if ((x_factor*resize_info->y_factor) > WorkLoadFactor)
+    {
+      resize_info->vertical_first=MagickFalse;
+      resize_info->columns=geometry.width;
+    }
+  resize_info->scanlines=(PixelPacket *) AcquireQuantumMemory((size_t)
+    resize_info->columns*resize_info->y_window,
+    sizeof(*resize_info->scanlines));
+  resize_info->row_pixels=(PixelPacket *) AcquireQuantumMemory((size_t)
+    image->columns,sizeof(*resize_info->row_pixels));
+  if (image->colorspace == CMYKColorspace)
+    {
+      resize_info->scanline_indexes=(IndexPacket *) AcquireQuantumMemory(
+        (size_t) resize_info->columns*resize_info->y_window,
+        sizeof(*resize_info->scanline_indexes));
+      resize_info->row_indexes=(IndexPacket *) AcquireQuantumMemory((size_t)
+        image->columns,sizeof(*resize_info->row_indexes));
+    }
+  if ((resize_info->x_contributions == (ContributionInfo *) NULL) ||
+      (resize_info->x_count == (long *) NULL) ||
+      (resize_info->y_contributions == (ContributionInfo *) NULL) ||
+      (resize_info->scanlines == (PixelPacket *) NULL) ||
+      (resize_info->row_pixels == (PixelPacket *) NULL) ||
+      ((image->colorspace == CMYKColorspace) &&
+       ((resize_info->scanline_indexes == (IndexPacket *) NULL) ||
+        (resize_info->row_indexes == (IndexPacket *) NULL))))
+    {
+      (void) ThrowMagickException(resize_info->exception,GetMagickModule(),
+        ResourceLimitError,"MemoryAllocationFailed","`%s'",image->filename);
+      return(MagickFalse);
+    }
+  /*
+    The horizontal contributions are the same for every scanline.
+  */
+  for (x=0; x < (long) geometry.width; x++)
+  {
+    ContributionInfo
+      *contribution;
+
+    contribution=resize_info->x_contributions+x*resize_info->x_window;
+    center=(MagickRealType) (x+0.5)/x_factor;
+    start=(long) (MagickMax(center-x_support-MagickEpsilon,0.0)+0.5);
+    stop=(long) (MagickMin(center+x_support,(double) image->columns)+0.5);
+    density=0.0;
+    for (n=0; n < (stop-start); n++)
+    {
+      contribution[n].pixel=start+n;
+      contribution[n].weight=GetResizeFilterWeight(resize_info->resize_filter,
+        x_scale*((MagickRealType) (start+n)-center+0.5));
+      density+=contribution[n].weight;
+    }
+    if ((density != 0.0) && (density != 1.0))
+      {
+        density=1.0/density;
+        for (i=0; i < n; i++)
+          contribution[i].weight*=density;
+      }
+    resize_info->x_count[x]=n;
+  }
+  resize_info->resize_view=AcquireCacheView(resize_info->resize_image);
+  resize_info->image=image;
+  return(MagickTrue);
+}
+
+static void DestroyStreamResizeInfo(StreamResizeInfo *resize_info)
+{
+  if (resize_info->resize_view != (CacheView *) NULL)
+    resize_info->resize_view=DestroyCacheView(resize_info->resize_view);
+  if (resize_info->resize_filter != (ResizeFilter *) NULL)
+    resize_info->resize_filter=DestroyResizeFilter(resize_info->resize_filter);
+  if (resize_info->row_indexes != (IndexPacket *) NULL)
+    resize_info->row_indexes=(IndexPacket *) RelinquishMagickMemory(
+      resize_info->row_indexes);
+  if (resize_info->scanline_indexes != (IndexPacket *) NULL)
+    resize_info->scanline_indexes=(IndexPacket *) RelinquishMagickMemory(
+      resize_info->scanline_indexes);
+  if (resize_info->row_pixels != (PixelPacket *) NULL)
+    resize_info->row_pixels=(PixelPacket *) RelinquishMagickMemory(
+      resize_info->row_pixels);
+  if (resize_info->scanlines != (PixelPacket *) NULL)
+    resize_info->scanlines=(PixelPacket *) RelinquishMagickMemory(
+      resize_info->scanlines);
+  if (resize_info->y_contributions != (ContributionInfo *) NULL)
+    resize_info->y_contributions=(ContributionInfo *) RelinquishMagickMemory(
+      resize_info->y_contributions);
+  if (resize_info->x_count != (long *) NULL)
+    resize_info->x_count=(long *) RelinquishMagickMemory(resize_info->x_count);
+  if (resize_info->x_contributions != (ContributionInfo *) NULL)
+    resize_info->x_contributions=(ContributionInfo *) RelinquishMagickMemory(
+      resize_info->x_contributions);
+}
+
+static void FilterStreamColumns(const StreamResizeInfo *resize_info,
+  const PixelPacket *p,const IndexPacket *indexes,PixelPacket *q,
+  IndexPacket *resize_indexes)
+{
+  const Image
+    *image;
+
+  register long
+    x;
+
+  /*
+    Filter a row of the source width to the resized width, rounding each
+    sample to a quantum as HorizontalFilter() does.
+  */
+  image=resize_info->image;
+  for (x=0; x < (long) resize_info->resize_image->columns; x++)
+  {
+    MagickPixelPacket
+      pixel;
+
+    MagickRealType
+      alpha,
+      gamma;
+
+    register const ContributionInfo
+      *contribution;
+
+    register long
+      i,
+      j;
+
+    contribution=resize_info->x_contributions+x*resize_info->x_window;
+    pixel.red=0.0;
+    pixel.green=0.0;
+    pixel.blue=0.0;
+    pixel.opacity=0.0;
+    pixel.index=0.0;
+    gamma=0.0;
+    for (i=0; i < resize_info->x_count[x]; i++)
+    {
+      j=contribution[i].pixel;
+      alpha=contribution[i].weight;
+      if (image->matte != MagickFalse)
+        alpha*=QuantumScale*((MagickRealType) QuantumRange-p[j].opacity);
+      pixel.red+=alpha*p[j].red;
+      pixel.green+=alpha*p[j].green;
+      pixel.blue+=alpha*p[j].blue;
+      pixel.opacity+=contribution[i].weight*p[j].opacity;
+      if (indexes != (const IndexPacket *) NULL)
+        pixel.index+=alpha*indexes[j];
+      gamma+=alpha;
+    }
+    if (image->matte == MagickFalse)
+      gamma=1.0;
+    gamma=1.0/(fabs((double) gamma) <= MagickEpsilon ? 1.0 : gamma);
+    q[x].red=RoundToQuantum(gamma*pixel.red);
+    q[x].green=RoundToQuantum(gamma*pixel.green);
+    q[x].blue=RoundToQuantum(gamma*pixel.blue);
+    q[x].opacity=RoundToQuantum(pixel.opacity);
+    if ((indexes != (const IndexPacket *) NULL) &&
+        (resize_indexes != (IndexPacket *) NULL))
+      resize_indexes[x]=(IndexPacket) RoundToQuantum(gamma*pixel.index);
+  }
+}
+
+static void FilterStreamRows(const StreamResizeInfo *resize_info,
+  const ContributionInfo *contribution,const long n,PixelPacket *q,
+  IndexPacket *resize_indexes)
+{
+  const Image
+    *image;
+
+  register long
+    x;
+
+  /*
+    Filter the buffered scanlines into one row, rounding each sample to a
+    quantum as VerticalFilter() does.
+  */
+  image=resize_info->image;
+  for (x=0; x < (long) resize_info->columns; x++)
+  {
+    MagickPixelPacket
+      pixel;
+
+    MagickRealType
+      alpha,
+      gamma;
+
+    register const PixelPacket
+      *p;
+
+    register long
+      i;
+
+    size_t
+      offset;
+
+    pixel.red=0.0;
+    pixel.green=0.0;
+    pixel.blue=0.0;
+    pixel.opacity=0.0;
+    pixel.index=0.0;
+    gamma=0.0;
+    for (i=0; i < n; i++)
+    {
+      offset=(size_t) contribution[i].pixel*resize_info->columns+x;
+      p=resize_info->scanlines+offset;
+      alpha=contribution[i].weight;
+      if (image->matte != MagickFalse)
+        alpha*=QuantumScale*((MagickRealType) QuantumRange-p->opacity);
+      pixel.red+=alpha*p->red;
+      pixel.green+=alpha*p->green;
+      pixel.blue+=alpha*p->blue;
+      pixel.opacity+=contribution[i].weight*p->opacity;
+      if (resize_info->scanline_indexes != (IndexPacket *) NULL)
+        pixel.index+=alpha*resize_info->scanline_indexes[offset];
+      gamma+=alpha;
+    }
+    if (image->matte == MagickFalse)
+      gamma=1.0;
+    gamma=1.0/(fabs((double) gamma) <= MagickEpsilon ? 1.0 : gamma);
+    q[x].red=RoundToQuantum(gamma*pixel.red);
+    q[x].green=RoundToQuantum(gamma*pixel.green);
+    q[x].blue=RoundToQuantum(gamma*pixel.blue);
+    q[x].opacity=RoundToQuantum(pixel.opacity);
+    if ((resize_info->scanline_indexes != (IndexPacket *) NULL) &&
+        (resize_indexes != (IndexPacket *) NULL))
+      resize_indexes[x]=(IndexPacket) RoundToQuantum(gamma*pixel.index);
+  }
+}
+
+static MagickBooleanType StreamResizeRows(StreamResizeInfo *resize_info,
+  const MagickBooleanType flush)
+{
+  const Image
+    *image;
+
+  Image
+    *resize_image;
+
+  /*
+    Emit every resized row whose contributing scanlines are all buffered.
+  */
+  image=resize_info->image;
+  resize_image=resize_info->resize_image;
+  while (resize_info->resize_y < (long) resize_image->rows)
+  {
+    long
+      n,
+      start,
+      stop;
+
+    MagickRealType
+      center,
+      density;
+
+    register ContributionInfo
+      *contribution;
+
+    register IndexPacket
+      *__restrict resize_indexes;
+
+    register long
+      i;
+
+    register PixelPacket
+      *__restrict q;
+
+    center=(MagickRealType) (resize_info->resize_y+0.5)/resize_info->y_factor;
+    start=(long) (MagickMax(center-resize_info->y_support-MagickEpsilon,0.0)+
+      0.5);
+    stop=(long) (MagickMin(center+resize_info->y_support,(double)
+      image->rows)+0.5);
+    if (stop > resize_info->y)
+      {
+        if (flush == MagickFalse)
+          break;
+        /*
+          The image was truncated: filter what was decoded.
+        */
+        stop=resize_info->y;
+        if (start >= stop)
+          start=stop-1;
+      }
+    contribution=resize_info->y_contributions;
+    density=0.0;
+    for (n=0; n < (stop-start); n++)
+    {
+      contribution[n].pixel=(start+n) % resize_info->y_window;
+      contribution[n].weight=GetResizeFilterWeight(resize_info->resize_filter,
+        resize_info->y_scale*((MagickRealType) (start+n)-center+0.5));
+      density+=contribution[n].weight;
+    }
+    if ((density != 0.0) && (density != 1.0))
+      {
+        density=1.0/density;
+        for (i=0; i < n; i++)
+          contribution[i].weight*=density;
+      }
+    q=QueueCacheViewAuthenticPixels(resize_info->resize_view,0,
+      resize_info->resize_y,resize_image->columns,1,resize_info->exception);
+    if (q == (PixelPacket *) NULL)
+      return(MagickFalse);
+    resize_indexes=GetCacheViewAuthenticIndexQueue(resize_info->resize_view);
+    if (resize_info->vertical_first == MagickFalse)
+      FilterStreamRows(resize_info,contribution,n,q,resize_indexes);
+    else
+      {
+        FilterStreamRows(resize_info,contribution,n,resize_info->row_pixels,
+          resize_info->row_indexes);
+        FilterStreamColumns(resize_info,resize_info->row_pixels,
+          resize_info->row_indexes,q,resize_indexes);
+      }
+    if (SyncCacheViewAuthenticPixels(resize_info->resize_view,
+        resize_info->exception) == MagickFalse)
+      return(MagickFalse);
+    resize_info->resize_y++;
+  }
+  return(MagickTrue);
+}
+
+#if defined(__cplusplus) || defined(c_plusplus)
+extern "C" {
+#endif
+
+static size_t StreamResizePixels(const Image *image,const void *pixels,
+  const size_t columns)
+{
+  register const IndexPacket
+    *indexes;
+
+  register const PixelPacket
+    *p;
+
+  register IndexPacket
+    *q_indexes;
+
+  register long
+    x;
+
+  register PixelPacket
+    *q;
+
+  size_t
+    offset;
+
+  StreamResizeInfo
+    *resize_info;
+
+  resize_info=(StreamResizeInfo *) image->client_data;
+  if ((pixels == (const void *) NULL) || (resize_info->status == MagickFalse))
+    return(0);
+  if (resize_info->image == (const Image *) NULL)
+    {
+      resize_info->status=AcquireStreamResizeInfo(resize_info,image);
+      if (resize_info->status == MagickFalse)
+        return(0);
+    }
+  if ((image != resize_info->image) || (resize_info->y >= (long) image->rows))
+    return(columns);
+  if (columns != image->columns)
+    {
+      (void) ThrowMagickException(resize_info->exception,GetMagickModule(),
+        StreamError,"ImageDoesNotContainTheStreamGeometry","`%s'",
+        image->filename);
+      resize_info->status=MagickFalse;
+      return(0);
+    }
+  p=(const PixelPacket *) pixels;
+  indexes=GetVirtualIndexQueue(image);
+  if ((image->storage_class == PseudoClass) &&
+      (indexes != (const IndexPacket *) NULL))
+    {
+      /*
+        Look up the colors of a colormapped scanline.
+      */
+      for (x=0; x < (long) image->columns; x++)
+      {
+        resize_info->row_pixels[x]=p[x];
+        if ((unsigned long) indexes[x] < image->colors)
+          resize_info->row_pixels[x]=image->colormap[(long) indexes[x]];
+      }
+      p=resize_info->row_pixels;
+    }
+  if (resize_info->scanline_indexes == (IndexPacket *) NULL)
+    indexes=(const IndexPacket *) NULL;
+  /*
+    Buffer the scanline, filtered horizontally unless the vertical pass comes
+    first.
+  */
+  offset=(size_t) (resize_info->y % resize_info->y_window)*
+    resize_info->columns;
+  q=resize_info->scanlines+offset;
+  q_indexes=(IndexPacket *) NULL;
+  if (resize_info->scanline_indexes != (IndexPacket *) NULL)
+    q_indexes=resize_info->scanline_indexes+offset;
+  if (resize_info->vertical_first == MagickFalse)
+    FilterStreamColumns(resize_info,p,indexes,q,q_indexes);
+  else
+    {
+      (void) CopyMagickMemory(q,p,(size_t) image->columns*sizeof(*q));
+      if ((indexes != (const IndexPacket *) NULL) &&
+          (q_indexes != (IndexPacket *) NULL))
+        (void) CopyMagickMemory(q_indexes,indexes,(size_t) image->columns*
+          sizeof(*q_indexes));
+    }
+  resize_info->y++;
+  resize_info->status=StreamResizeRows(resize_info,MagickFalse);
+  return(resize_info->status == MagickFalse ? 0 : columns);
+}
+
+#if defined(__cplusplus) || defined(c_plusplus)
+}
+#endif
+
+MagickExport Image *StreamResizeImage(const ImageInfo *image_info,
+  const char *geometry,const FilterTypes filter,const double blur,
+  ExceptionInfo *exception)
+{
+  Image
+    *image,
+    *resize_image;
+
+  ImageInfo
+    *read_info;
+
+  StreamResizeInfo
+    resize_info;
+
+  assert(image_info != (const ImageInfo *) NULL);
+  assert(image_info->signature == MagickSignature);
+  if (image_info->debug != MagickFalse)
+    (void) LogMagickEvent(TraceEvent,GetMagickModule(),"%s",
+      image_info->filename);
+  assert(geometry != (const char *) NULL);
+  assert(exception != (ExceptionInfo *) NULL);
+  assert(exception->signature == MagickSignature);
+  (void) ResetMagickMemory(&resize_info,0,sizeof(resize_info));
+  resize_info.image_info=image_info;
+  resize_info.geometry=geometry;
+  resize_info.filter=filter;
+  resize_info.blur=blur;
+  resize_info.status=MagickTrue;
+  resize_info.exception=exception;
+  read_info=CloneImageInfo(image_info);
+  read_info->client_data=(void *) &resize_info;
+  image=ReadStream(read_info,&StreamResizePixels,exception);
+  read_info=DestroyImageInfo(read_info);
+  resize_image=resize_info.resize_image;
+  if ((resize_image != (Image *) NULL) && (resize_info.y != 0) &&
+      (resize_info.resize_y < (long) resize_image->rows))
+    {
+      /*
+        Flush the rows held back by a truncated image.
+      */
+      if (resize_info.status != MagickFalse)
+        resize_info.status=StreamResizeRows(&resize_info,MagickTrue);
+    }
+  if (image != (Image *) NULL)
+    {
+      if (resize_image != (Image *) NULL)
+        {
+          const char
+            *property;
+
+          /*
+            Keep properties the coder set after the last scanline.
+          */
+          ResetImagePropertyIterator(image);
+          property=GetNextImageProperty(image);
+          while (property != (const char *) NULL)
+          {
+            (void) SetImageProperty(resize_image,property,
+              GetImageProperty(image,property));
+            property=GetNextImageProperty(image);
+          }
+          InheritException(&resize_image->exception,&image->exception);
+          resize_image->type=image->type;
+        }
+      image=DestroyImageList(image);
+    }
+  DestroyStreamResizeInfo(&resize_info);
+  if ((resize_image != (Image *) NULL) &&
+      ((resize_info.status == MagickFalse) || (resize_info.y == 0)))
+    resize_image=DestroyImage(resize_image);
+  if ((resize_image == (Image *) NULL) &&
+      (exception->severity < ErrorException))
+    (void) ThrowMagickException(exception,GetMagickModule(),CorruptImageError,
+      "UnableToReadImageData","`%s'",image_info->filename);
+  return(resize_image);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
 %   T h u m b n a i l I m a g e                                               %
 %                                                                             %
 %                                                                             %
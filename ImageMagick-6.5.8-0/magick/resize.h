@@ -37,6 +37,8 @@ extern MagickExport Image
     ExceptionInfo *),
   *ScaleImage(const Image *,const unsigned long,const unsigned long,
     ExceptionInfo *),
+  *StreamResizeImage(const ImageInfo *,const char *,const FilterTypes,
+    const double,ExceptionInfo *),
   *ThumbnailImage(const Image *,const unsigned long,const unsigned long,
     ExceptionInfo *),
   *ZoomImage(const Image *,const unsigned long,const unsigned long,
@@ -48,6 +48,7 @@
 #include "magick/log.h"
 #include "magick/image.h"
 #include "magick/memory_.h"
+#include "magick/memory-private.h"
 #include "magick/option.h"
 #include "magick/policy.h"
 #include "magick/random_.h"
@@ -59,55 +60,76 @@
 #include "magick/splay-tree.h"
 #include "magick/thread-private.h"
 #include "magick/token.h"
+#include "magick/trace.h"
 #include "magick/utility.h"
 
+/*
+  Define declarations.
+*/
+#define NumberOfResources  (TimeResource+1)
+
 /*
   Typedef declarations.
 */
 typedef struct _ResourceInfo
 {
-  MagickOffsetType
-    area,
-    memory,
-    map,
-    disk,
-    file,
-    thread,
-    time;
+  volatile MagickOffsetType
+    resources[NumberOfResources];
 
   MagickSizeType
-    area_limit,
-    memory_limit,
-    map_limit,
-    disk_limit,
-    file_limit,
-    thread_limit,
-    time_limit;
+    limits[NumberOfResources];
 } ResourceInfo;
+
+struct _ResourceContext
+{
+  ResourceInfo
+    resource_info;
+
+  time_t
+    timestamp;
+
+  volatile MagickOffsetType
+    reference_count;
+
+  unsigned long
+    signature;
+};
 
 /*
   Global declarations.
 */
+static MagickBooleanType
+  instantiate_key = MagickFalse;
+
+static MagickThreadKey
+  resource_key;
+
 static RandomInfo
   *random_info = (RandomInfo *) NULL;
 
 static ResourceInfo
   resource_info =
   {
-    MagickULLConstant(0),
-    MagickULLConstant(0),
-    MagickULLConstant(0),
-    MagickULLConstant(0),
-    MagickULLConstant(0),
-    MagickULLConstant(0),
-    MagickULLConstant(0),
-    MagickULLConstant(2048)*1024*1024,
-    MagickULLConstant(1536)*1024*1024,
-    MagickULLConstant(8192)*1024*1024,
-    MagickResourceInfinity,
-    MagickULLConstant(768),
-    MagickULLConstant(8),
-    MagickResourceInfinity
+    {
+      MagickULLConstant(0),
+      MagickULLConstant(0),
+      MagickULLConstant(0),
+      MagickULLConstant(0),
+      MagickULLConstant(0),
+      MagickULLConstant(0),
+      MagickULLConstant(0),
+      MagickULLConstant(0)
+    },
+    {
+      MagickResourceInfinity,
+      MagickULLConstant(2048)*1024*1024,
+      MagickResourceInfinity,
+      MagickULLConstant(768),
+      MagickULLConstant(8192)*1024*1024,
+      MagickULLConstant(1536)*1024*1024,
+      MagickULLConstant(8),
+      MagickResourceInfinity
+    }
   };
 
 static SemaphoreInfo
@@ -129,7 +151,10 @@ static SplayTreeInfo
 %
 %  AcquireMagickResource() acquires resources of the specified type.
 %  MagickFalse is returned if the specified resource is exhausted otherwise
-%  MagickTrue.
+%  MagickTrue.  The resource is charged to the resource context bound to the
+%  calling thread, if any, and to the process-wide pool; it is exhausted when
+%  either limit is reached.  The counters are updated atomically so the call
+%  does not serialize concurrent requests.
 %
 %  The format of the AcquireMagickResource() method is:
 %
@@ -143,123 +168,77 @@ static SplayTreeInfo
 %    o size: the number of bytes needed from for this resource.
 %
 */
-MagickExport MagickBooleanType AcquireMagickResource(const ResourceType type,
-  const MagickSizeType size)
+static MagickSizeType GetResource(ResourceInfo *resource_info,
+  const ResourceType type)
+{
+#if defined(MagickAtomicSupport)
+  return((MagickSizeType) MagickAtomicAdd(&resource_info->resources[type],0));
+#else
+  MagickSizeType
+    resource;
+
+  if (resource_semaphore == (SemaphoreInfo *) NULL)
+    AcquireSemaphoreInfo(&resource_semaphore);
+  (void) LockSemaphoreInfo(resource_semaphore);
+  resource=(MagickSizeType) resource_info->resources[type];
+  (void) UnlockSemaphoreInfo(resource_semaphore);
+  return(resource);
+#endif
+}
+
+static void LogResourceEvent(const char *module,const char *function,
+  const unsigned long line,const ResourceType type,const MagickSizeType size,
+  const MagickSizeType resource,const MagickSizeType limit)
 {
   char
     resource_current[MaxTextExtent],
     resource_limit[MaxTextExtent],
     resource_request[MaxTextExtent];
 
-  MagickBooleanType
-    status;
+  (void) FormatMagickSize(size,resource_request);
+  (void) FormatMagickSize(resource,resource_current);
+  (void) FormatMagickSize(limit,resource_limit);
+  (void) LogMagickEvent(ResourceEvent,module,function,line,"%s: %s/%s/%s",
+    MagickOptionToMnemonic(MagickResourceOptions,(long) type),resource_request,
+    resource_current,resource_limit);
+}
 
-  MagickSizeType
-    limit;
+static MagickSizeType UpdateResource(ResourceInfo *resource_info,
+  const ResourceType type,const MagickOffsetType size)
+{
+  MagickOffsetType
+    resource;
 
-  status=MagickFalse;
-  (void) FormatMagickSize(size,resource_request);
+  /*
+    The area resource tracks the extent of the latest request, the others are
+    running totals.
+  */
+#if defined(MagickAtomicSupport)
+  if (type == AreaResource)
+    {
+      resource=size < 0 ? -size : size;
+      (void) MagickAtomicExchange(&resource_info->resources[type],resource);
+    }
+  else
+    resource=MagickAtomicAdd(&resource_info->resources[type],size);
+#else
   if (resource_semaphore == (SemaphoreInfo *) NULL)
     AcquireSemaphoreInfo(&resource_semaphore);
   (void) LockSemaphoreInfo(resource_semaphore);
-  switch (type)
-  {
-    case AreaResource:
-    {
-      resource_info.area=(MagickOffsetType) size;
-      limit=resource_info.area_limit;
-      status=(resource_info.area_limit == MagickResourceInfinity) ||
-        (size < limit) ? MagickTrue : MagickFalse;
-      (void) FormatMagickSize((MagickSizeType) resource_info.area,
-        resource_current);
-      (void) FormatMagickSize(resource_info.area_limit,resource_limit);
-      break;
-    }
-    case MemoryResource:
-    {
-      resource_info.memory+=size;
-      limit=resource_info.memory_limit;
-      status=(resource_info.memory_limit == MagickResourceInfinity) ||
-        ((MagickSizeType) resource_info.memory < limit) ?
-        MagickTrue : MagickFalse;
-      (void) FormatMagickSize((MagickSizeType) resource_info.memory,
-        resource_current);
-      (void) FormatMagickSize(resource_info.memory_limit,
-        resource_limit);
-      break;
-    }
-    case MapResource:
-    {
-      resource_info.map+=size;
-      limit=resource_info.map_limit;
-      status=(resource_info.map_limit == MagickResourceInfinity) ||
-        ((MagickSizeType) resource_info.map < limit) ?
-        MagickTrue : MagickFalse;
-      (void) FormatMagickSize((MagickSizeType) resource_info.map,
-        resource_current);
-      (void) FormatMagickSize(resource_info.map_limit,
-        resource_limit);
-      break;
-    }
-    case DiskResource:
-    {
-      resource_info.disk+=size;
-      limit=resource_info.disk_limit;
-      status=(resource_info.disk_limit == MagickResourceInfinity) ||
-        ((MagickSizeType) resource_info.disk < limit) ?
-        MagickTrue : MagickFalse;
-      (void) FormatMagickSize((MagickSizeType) resource_info.disk,
-        resource_current);
-      (void) FormatMagickSize(resource_info.disk_limit,resource_limit);
-      break;
-    }
-    case FileResource:
-    {
-      resource_info.file+=size;
-      limit=resource_info.file_limit;
-      status=(resource_info.file_limit == MagickResourceInfinity) ||
-        ((MagickSizeType) resource_info.file < limit) ?
-        MagickTrue : MagickFalse;
-      (void) FormatMagickSize((MagickSizeType) resource_info.file,
-        resource_current);
-      (void) FormatMagickSize((MagickSizeType) resource_info.file_limit,
-        resource_limit);
-      break;
-    }
-    case ThreadResource:
-    {
-      resource_info.thread+=size;
-      limit=resource_info.thread_limit;
-      status=(resource_info.thread_limit == MagickResourceInfinity) ||
-        ((MagickSizeType) resource_info.thread < limit) ?
-        MagickTrue : MagickFalse;
-      (void) FormatMagickSize((MagickSizeType) resource_info.thread,
-        resource_current);
-      (void) FormatMagickSize((MagickSizeType) resource_info.thread_limit,
-        resource_limit);
-      break;
-    }
-    case TimeResource:
-    {
-      resource_info.time+=size;
-      limit=resource_info.time_limit;
-      status=(resource_info.time_limit == MagickResourceInfinity) ||
-        ((MagickSizeType) resource_info.time < limit) ?
-        MagickTrue : MagickFalse;
-      (void) FormatMagickSize((MagickSizeType) resource_info.time,
-        resource_current);
-      (void) FormatMagickSize((MagickSizeType) resource_info.time_limit,
-        resource_limit);
-      break;
-    }
-    default:
-      break;
-  }
+  if (type == AreaResource)
+    resource_info->resources[type]=size < 0 ? -size : size;
+  else
+    resource_info->resources[type]+=size;
+  resource=resource_info->resources[type];
   (void) UnlockSemaphoreInfo(resource_semaphore);
-  (void) LogMagickEvent(ResourceEvent,GetMagickModule(),"%s: %s/%s/%s",
-    MagickOptionToMnemonic(MagickResourceOptions,(long) type),resource_request,
-    resource_current,resource_limit);
-  return(status);
+#endif
+  return((MagickSizeType) resource);
+}
+
+MagickExport MagickBooleanType AcquireMagickResource(const ResourceType type,
+  const MagickSizeType size)
+{
+  return(AcquireResourceContextResource(GetThreadResourceContext(),type,size));
 }
 
 /*
@@ -306,6 +285,118 @@ MagickExport void AsynchronousResourceComponentTerminus(void)
 %                                                                             %
 %                                                                             %
 %                                                                             %
+%   A c q u i r e R e s o u r c e C o n t e x t                               %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  AcquireResourceContext() returns a resource context.  Bind it to one or more
+%  threads with SetThreadResourceContext() and every resource those threads
+%  acquire is charged to the context as well as to the process-wide pool, so
+%  a request or a group of threads can be held to its own limits.  A new
+%  context has no limits; set them with SetResourceContextLimit().
+%
+%  Resources must be relinquished while the same context is bound.
+%
+%  The format of the AcquireResourceContext method is:
+%
+%      ResourceContext *AcquireResourceContext(void)
+%
+*/
+MagickExport ResourceContext *AcquireResourceContext(void)
+{
+  register long
+    i;
+
+  ResourceContext
+    *resource_context;
+
+  resource_context=(ResourceContext *) AcquireMagickMemory(
+    sizeof(*resource_context));
+  if (resource_context == (ResourceContext *) NULL)
+    ThrowFatalException(ResourceLimitFatalError,"MemoryAllocationFailed");
+  (void) ResetMagickMemory(resource_context,0,sizeof(*resource_context));
+  for (i=0; i < NumberOfResources; i++)
+    resource_context->resource_info.limits[i]=MagickResourceInfinity;
+  resource_context->timestamp=time((time_t *) NULL);
+  resource_context->reference_count=1;
+  resource_context->signature=MagickSignature;
+  return(resource_context);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   A c q u i r e R e s o u r c e C o n t e x t R e s o u r c e               %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  AcquireResourceContextResource() acquires resources of the specified type
+%  on behalf of a resource context rather than the context bound to the
+%  calling thread.  The resource is charged to the context and to the
+%  process-wide pool.  MagickFalse is returned if either limit is reached
+%  otherwise MagickTrue.  A NULL context charges the process-wide pool only.
+%
+%  The format of the AcquireResourceContextResource() method is:
+%
+%      MagickBooleanType AcquireResourceContextResource(
+%        ResourceContext *resource_context,const ResourceType type,
+%        const MagickSizeType size)
+%
+%  A description of each parameter follows:
+%
+%    o resource_context: the resource context.
+%
+%    o type: the type of resource.
+%
+%    o size: the number of bytes needed from for this resource.
+%
+*/
+MagickExport MagickBooleanType AcquireResourceContextResource(
+  ResourceContext *resource_context,const ResourceType type,
+  const MagickSizeType size)
+{
+  MagickBooleanType
+    status;
+
+  MagickSizeType
+    limit,
+    resource;
+
+  if ((type <= UndefinedResource) || (type >= NumberOfResources))
+    return(MagickFalse);
+  status=MagickTrue;
+  if (resource_context != (ResourceContext *) NULL)
+    {
+      assert(resource_context->signature == MagickSignature);
+      resource=UpdateResource(&resource_context->resource_info,type,
+        (MagickOffsetType) size);
+      limit=resource_context->resource_info.limits[type];
+      if ((limit != MagickResourceInfinity) && (resource >= limit))
+        status=MagickFalse;
+    }
+  resource=UpdateResource(&resource_info,type,(MagickOffsetType) size);
+  limit=resource_info.limits[type];
+  if ((limit != MagickResourceInfinity) && (resource >= limit))
+    status=MagickFalse;
+  if (IsEventLogged(ResourceEvent) != MagickFalse)
+    LogResourceEvent(GetMagickModule(),type,size,resource,limit);
+  if (IsMagickTraceEnabled(ResourceTrace) != MagickFalse)
+    TraceMagickEvent(ResourceTrace,CounterTracePhase,"AcquireMagickResource",
+      MagickOptionToMnemonic(MagickResourceOptions,(long) type),resource);
+  return(status);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
 %   A c q u i r e U n i q u e F i l e R e s o u r c e                         %
 %                                                                             %
 %                                                                             %
@@ -486,6 +577,57 @@ MagickExport int AcquireUniqueFileResource(char *path)
 %                                                                             %
 %                                                                             %
 %                                                                             %
+%   D e s t r o y R e s o u r c e C o n t e x t                               %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  DestroyResourceContext() releases a reference to a resource context.  The
+%  context is destroyed, and unbound from the calling thread, once the last
+%  reference is released.
+%
+%  The format of the DestroyResourceContext method is:
+%
+%      ResourceContext *DestroyResourceContext(
+%        ResourceContext *resource_context)
+%
+%  A description of each parameter follows:
+%
+%    o resource_context: the resource context.
+%
+*/
+MagickExport ResourceContext *DestroyResourceContext(
+  ResourceContext *resource_context)
+{
+  MagickOffsetType
+    reference_count;
+
+  assert(resource_context != (ResourceContext *) NULL);
+  assert(resource_context->signature == MagickSignature);
+#if defined(MagickAtomicSupport)
+  reference_count=MagickAtomicAdd(&resource_context->reference_count,-1);
+#else
+  if (resource_semaphore == (SemaphoreInfo *) NULL)
+    AcquireSemaphoreInfo(&resource_semaphore);
+  (void) LockSemaphoreInfo(resource_semaphore);
+  reference_count=(--resource_context->reference_count);
+  (void) UnlockSemaphoreInfo(resource_semaphore);
+#endif
+  if (reference_count > 0)
+    return((ResourceContext *) NULL);
+  if (GetThreadResourceContext() == resource_context)
+    (void) SetThreadResourceContext((ResourceContext *) NULL);
+  resource_context->signature=(~MagickSignature);
+  resource_context=(ResourceContext *) RelinquishMagickMemory(resource_context);
+  return(resource_context);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
 %   G e t M a g i c k R e s o u r c e                                         %
 %                                                                             %
 %                                                                             %
@@ -505,53 +647,9 @@ MagickExport int AcquireUniqueFileResource(char *path)
 */
 MagickExport MagickSizeType GetMagickResource(const ResourceType type)
 {
-  MagickSizeType
-    resource;
-
-  resource=0;
-  (void) LockSemaphoreInfo(resource_semaphore);
-  switch (type)
-  {
-    case AreaResource:
-    {
-      resource=(MagickSizeType) resource_info.area;
-      break;
-    }
-    case MemoryResource:
-    {
-      resource=(MagickSizeType) resource_info.memory;
-      break;
-    }
-    case MapResource:
-    {
-      resource=(MagickSizeType) resource_info.map;
-      break;
-    }
-    case DiskResource:
-    {
-      resource=(MagickSizeType) resource_info.disk;
-      break;
-    }
-    case FileResource:
-    {
-      resource=(MagickSizeType) resource_info.file;
-      break;
-    }
-    case ThreadResource:
-    {
-      resource=(MagickSizeType) resource_info.thread;
-      break;
-    }
-    case TimeResource:
-    {
-      resource=(MagickSizeType) resource_info.time;
-      break;
-    }
-    default:
-      break;
-  }
-  (void) UnlockSemaphoreInfo(resource_semaphore);
-  return(resource);
+  if ((type <= UndefinedResource) || (type >= NumberOfResources))
+    return(0);
+  return(GetResource(&resource_info,type));
 }
 
 /*
@@ -581,50 +679,12 @@ MagickExport MagickSizeType GetMagickResourceLimit(const ResourceType type)
   MagickSizeType
     resource;
 
-  resource=0;
+  if ((type <= UndefinedResource) || (type >= NumberOfResources))
+    return(0);
   if (resource_semaphore == (SemaphoreInfo *) NULL)
     AcquireSemaphoreInfo(&resource_semaphore);
   (void) LockSemaphoreInfo(resource_semaphore);
-  switch (type)
-  {
-    case AreaResource:
-    {
-      resource=resource_info.area_limit;
-      break;
-    }
-    case MemoryResource:
-    {
-      resource=resource_info.memory_limit;
-      break;
-    }
-    case MapResource:
-    {
-      resource=resource_info.map_limit;
-      break;
-    }
-    case DiskResource:
-    {
-      resource=resource_info.disk_limit;
-      break;
-    }
-    case FileResource:
-    {
-      resource=resource_info.file_limit;
-      break;
-    }
-    case ThreadResource:
-    {
-      resource=resource_info.thread_limit;
-      break;
-    }
-    case TimeResource:
-    {
-      resource=resource_info.time_limit;
-      break;
-    }
-    default:
-      break;
-  }
+  resource=resource_info.limits[type];
   (void) UnlockSemaphoreInfo(resource_semaphore);
   return(resource);
 }
@@ -634,13 +694,116 @@ MagickExport MagickSizeType GetMagickResourceLimit(const ResourceType type)
 %                                                                             %
 %                                                                             %
 %                                                                             %
+%   G e t R e s o u r c e C o n t e x t L i m i t                             %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  GetResourceContextLimit() returns the limit a resource context places on
+%  the specified resource.
+%
+%  The format of the GetResourceContextLimit() method is:
+%
+%      MagickSizeType GetResourceContextLimit(
+%        const ResourceContext *resource_context,const ResourceType type)
+%
+%  A description of each parameter follows:
+%
+%    o resource_context: the resource context.
+%
+%    o type: the type of resource.
+%
+*/
+MagickExport MagickSizeType GetResourceContextLimit(
+  const ResourceContext *resource_context,const ResourceType type)
+{
+  assert(resource_context != (const ResourceContext *) NULL);
+  assert(resource_context->signature == MagickSignature);
+  if ((type <= UndefinedResource) || (type >= NumberOfResources))
+    return(0);
+  return(resource_context->resource_info.limits[type]);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   G e t R e s o u r c e C o n t e x t R e s o u r c e                       %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  GetResourceContextResource() returns the amount of the specified resource
+%  charged to a resource context.  The time resource is the number of seconds
+%  since the context was acquired.
+%
+%  The format of the GetResourceContextResource() method is:
+%
+%      MagickSizeType GetResourceContextResource(
+%        ResourceContext *resource_context,const ResourceType type)
+%
+%  A description of each parameter follows:
+%
+%    o resource_context: the resource context.
+%
+%    o type: the type of resource.
+%
+*/
+MagickExport MagickSizeType GetResourceContextResource(
+  ResourceContext *resource_context,const ResourceType type)
+{
+  assert(resource_context != (ResourceContext *) NULL);
+  assert(resource_context->signature == MagickSignature);
+  if ((type <= UndefinedResource) || (type >= NumberOfResources))
+    return(0);
+  if (type == TimeResource)
+    return((MagickSizeType) (time((time_t *) NULL)-
+      resource_context->timestamp));
+  return(GetResource(&resource_context->resource_info,type));
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   G e t T h r e a d R e s o u r c e C o n t e x t                           %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  GetThreadResourceContext() returns the resource context bound to the
+%  calling thread, or NULL if there is none.
+%
+%  The format of the GetThreadResourceContext() method is:
+%
+%      ResourceContext *GetThreadResourceContext(void)
+%
+*/
+MagickExport ResourceContext *GetThreadResourceContext(void)
+{
+  if (instantiate_key == MagickFalse)
+    return((ResourceContext *) NULL);
+  return((ResourceContext *) MagickGetThreadValue(resource_key));
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
 %  L i s t M a g i c k R e s o u r c e I n f o                                %
 %                                                                             %
 %                                                                             %
 %                                                                             %
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 %
-%  ListMagickResourceInfo() lists the resource info to a file.
+%  ListMagickResourceInfo() lists the resource info to a file, followed by
+%  the memory manager allocation statistics.
 %
 %  The format of the ListMagickResourceInfo method is:
 %
@@ -659,33 +822,54 @@ MagickExport MagickBooleanType ListMagickResourceInfo(FILE *file,
 {
   char
     area_limit[MaxTextExtent],
+    arena_extent[MaxTextExtent],
     disk_limit[MaxTextExtent],
+    heap_extent[MaxTextExtent],
     map_limit[MaxTextExtent],
     memory_limit[MaxTextExtent],
+    peak_arena_extent[MaxTextExtent],
     time_limit[MaxTextExtent];
 
+  MemoryStatistics
+    statistics;
+
   if (file == (const FILE *) NULL)
     file=stdout;
   if (resource_semaphore == (SemaphoreInfo *) NULL)
     AcquireSemaphoreInfo(&resource_semaphore);
   (void) LockSemaphoreInfo(resource_semaphore);
-  (void) FormatMagickSize(resource_info.area_limit,area_limit);
-  (void) FormatMagickSize(resource_info.memory_limit,memory_limit);
-  (void) FormatMagickSize(resource_info.map_limit,map_limit);
-  (void) FormatMagickSize(resource_info.disk_limit,disk_limit);
+  (void) FormatMagickSize(resource_info.limits[AreaResource],area_limit);
+  (void) FormatMagickSize(resource_info.limits[MemoryResource],memory_limit);
+  (void) FormatMagickSize(resource_info.limits[MapResource],map_limit);
+  (void) FormatMagickSize(resource_info.limits[DiskResource],disk_limit);
   (void) CopyMagickString(time_limit,"unlimited",MaxTextExtent);
-  if (resource_info.time_limit != MagickResourceInfinity)
+  if (resource_info.limits[TimeResource] != MagickResourceInfinity)
     (void) FormatMagickString(time_limit,MaxTextExtent,"%lu",(unsigned long)
-      resource_info.time_limit);
+      resource_info.limits[TimeResource]);
   (void) fprintf(file,"File        Area      Memory         Map"
     "        Disk  Thread        Time\n");
   (void) fprintf(file,"------------------------------------------------------"
     "------------------\n");
   (void) fprintf(file,"%4lu  %10s  %10s  %10s  %10s  %6lu  %10s\n",
-    (unsigned long) resource_info.file_limit,area_limit,memory_limit,map_limit,
-    disk_limit,(unsigned long) resource_info.thread_limit,time_limit);
-  (void) fflush(file);
+    (unsigned long) resource_info.limits[FileResource],area_limit,memory_limit,
+    map_limit,disk_limit,(unsigned long) resource_info.limits[ThreadResource],
+    time_limit);
   (void) UnlockSemaphoreInfo(resource_semaphore);
+  GetMagickMemoryStatistics(&statistics);
+  (void) FormatMagickSize(statistics.arena_extent,arena_extent);
+  (void) FormatMagickSize(statistics.peak_arena_extent,peak_arena_extent);
+  (void) fprintf(file,"\nMemory arenas: %lu acquired, %lu active, %s reserved "
+    "(peak %s)\n",(unsigned long) statistics.arenas,(unsigned long)
+    statistics.active_arenas,arena_extent,peak_arena_extent);
+  if (statistics.heap_segments != 0)
+    {
+      (void) FormatMagickSize(statistics.heap_extent,heap_extent);
+      (void) fprintf(file,"Memory heap: %s in %lu segments, %lu of %lu small "
+        "allocations served from thread caches\n",heap_extent,(unsigned long)
+        statistics.heap_segments,(unsigned long) statistics.cache_hits,
+        (unsigned long) (statistics.cache_hits+statistics.cache_misses));
+    }
+  (void) fflush(file);
   return(MagickTrue);
 }
 
@@ -694,6 +878,49 @@ MagickExport MagickBooleanType ListMagickResourceInfo(FILE *file,
 %                                                                             %
 %                                                                             %
 %                                                                             %
+%   R e f e r e n c e R e s o u r c e C o n t e x t                           %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  ReferenceResourceContext() increments the reference count of a resource
+%  context so it outlives the caller that acquired it; image info structures
+%  and pixel caches hold a reference to the context they are charged to.
+%  Release the reference with DestroyResourceContext().
+%
+%  The format of the ReferenceResourceContext method is:
+%
+%      ResourceContext *ReferenceResourceContext(
+%        ResourceContext *resource_context)
+%
+%  A description of each parameter follows:
+%
+%    o resource_context: the resource context.
+%
+*/
+MagickExport ResourceContext *ReferenceResourceContext(
+  ResourceContext *resource_context)
+{
+  assert(resource_context != (ResourceContext *) NULL);
+  assert(resource_context->signature == MagickSignature);
+#if defined(MagickAtomicSupport)
+  (void) MagickAtomicAdd(&resource_context->reference_count,1);
+#else
+  if (resource_semaphore == (SemaphoreInfo *) NULL)
+    AcquireSemaphoreInfo(&resource_semaphore);
+  (void) LockSemaphoreInfo(resource_semaphore);
+  resource_context->reference_count++;
+  (void) UnlockSemaphoreInfo(resource_semaphore);
+#endif
+  return(resource_context);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
 %   R e l i n q u i s h M a g i c k R e s o u r c e                           %
 %                                                                             %
 %                                                                             %
@@ -717,83 +944,61 @@ MagickExport MagickBooleanType ListMagickResourceInfo(FILE *file,
 MagickExport void RelinquishMagickResource(const ResourceType type,
   const MagickSizeType size)
 {
-  char
-    resource_current[MaxTextExtent],
-    resource_limit[MaxTextExtent],
-    resource_request[MaxTextExtent];
+  RelinquishResourceContextResource(GetThreadResourceContext(),type,size);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   R e l i n q u i s h R e s o u r c e C o n t e x t R e s o u r c e         %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  RelinquishResourceContextResource() relinquishes resources of the specified
+%  type previously acquired with AcquireResourceContextResource().
+%
+%  The format of the RelinquishResourceContextResource() method is:
+%
+%      void RelinquishResourceContextResource(
+%        ResourceContext *resource_context,const ResourceType type,
+%        const MagickSizeType size)
+%
+%  A description of each parameter follows:
+%
+%    o resource_context: the resource context.
+%
+%    o type: the type of resource.
+%
+%    o size: the size of the resource.
+%
+*/
+MagickExport void RelinquishResourceContextResource(
+  ResourceContext *resource_context,const ResourceType type,
+  const MagickSizeType size)
+{
+  MagickSizeType
+    resource;
 
-  (void) FormatMagickSize(size,resource_request);
-  if (resource_semaphore == (SemaphoreInfo *) NULL)
-    AcquireSemaphoreInfo(&resource_semaphore);
-  (void) LockSemaphoreInfo(resource_semaphore);
-  switch (type)
-  {
-    case AreaResource:
-    {
-      resource_info.area=(MagickOffsetType) size;
-      (void) FormatMagickSize((MagickSizeType) resource_info.area,
-        resource_current);
-      (void) FormatMagickSize(resource_info.area_limit,resource_limit);
-      break;
-    }
-    case MemoryResource:
-    {
-      resource_info.memory-=size;
-      (void) FormatMagickSize((MagickSizeType) resource_info.memory,
-        resource_current);
-      (void) FormatMagickSize(resource_info.memory_limit,resource_limit);
-      break;
-    }
-    case MapResource:
-    {
-      resource_info.map-=size;
-      (void) FormatMagickSize((MagickSizeType) resource_info.map,
-        resource_current);
-      (void) FormatMagickSize(resource_info.map_limit,resource_limit);
-      break;
-    }
-    case DiskResource:
-    {
-      resource_info.disk-=size;
-      (void) FormatMagickSize((MagickSizeType) resource_info.disk,
-        resource_current);
-      (void) FormatMagickSize(resource_info.disk_limit,resource_limit);
-      break;
-    }
-    case FileResource:
-    {
-      resource_info.file-=size;
-      (void) FormatMagickSize((MagickSizeType) resource_info.file,
-        resource_current);
-      (void) FormatMagickSize((MagickSizeType) resource_info.file_limit,
-        resource_limit);
-      break;
-    }
-    case ThreadResource:
-    {
-      resource_info.thread-=size;
-      (void) FormatMagickSize((MagickSizeType) resource_info.thread,
-        resource_current);
-      (void) FormatMagickSize((MagickSizeType) resource_info.thread_limit,
-        resource_limit);
-      break;
-    }
-    case TimeResource:
+  if ((type <= UndefinedResource) || (type >= NumberOfResources))
+    return;
+  if (resource_context != (ResourceContext *) NULL)
     {
-      resource_info.time-=size;
-      (void) FormatMagickSize((MagickSizeType) resource_info.time,
-        resource_current);
-      (void) FormatMagickSize((MagickSizeType) resource_info.time_limit,
-        resource_limit);
-      break;
+      assert(resource_context->signature == MagickSignature);
+      (void) UpdateResource(&resource_context->resource_info,type,
+        -((MagickOffsetType) size));
     }
-    default:
-      break;
-  }
-  (void) UnlockSemaphoreInfo(resource_semaphore);
-  (void) LogMagickEvent(ResourceEvent,GetMagickModule(),"%s: %s/%s/%s",
-    MagickOptionToMnemonic(MagickResourceOptions,(long) type),resource_request,
-    resource_current,resource_limit);
+  resource=UpdateResource(&resource_info,type,-((MagickOffsetType) size));
+  if (IsEventLogged(ResourceEvent) != MagickFalse)
+    LogResourceEvent(GetMagickModule(),type,size,resource,
+      resource_info.limits[type]);
+  if (IsMagickTraceEnabled(ResourceTrace) != MagickFalse)
+    TraceMagickEvent(ResourceTrace,CounterTracePhase,
+      "RelinquishMagickResource",MagickOptionToMnemonic(MagickResourceOptions,
+      (long) type),resource);
 }
 
 /*
@@ -903,6 +1108,7 @@ MagickExport MagickBooleanType ResourceComponentGenesis(void)
     Set Magick resource limits.
   */
   AcquireSemaphoreInfo(&resource_semaphore);
+  instantiate_key=MagickCreateThreadKey(&resource_key);
   pagesize=GetMagickPageSize();
   pages=(-1);
 #if defined(MAGICKCORE_HAVE_SYSCONF) && defined(_SC_PHYS_PAGES)
@@ -991,6 +1197,25 @@ MagickExport MagickBooleanType ResourceComponentGenesis(void)
         100.0));
       limit=DestroyString(limit);
     }
+  limit=GetEnvironmentValue("MAGICK_THREAD_MIN_AREA");
+  if (limit == (char *) NULL)
+    limit=GetPolicyValue("thread:min-area");
+  if (limit != (char *) NULL)
+    {
+      SetMagickThreadMinArea(StringToSizeType(limit,100.0));
+      limit=DestroyString(limit);
+    }
+  limit=GetEnvironmentValue("MAGICK_THREAD_SCHEDULE");
+  if (limit == (char *) NULL)
+    limit=GetPolicyValue("thread:schedule");
+  if (limit != (char *) NULL)
+    {
+      if (LocaleCompare(limit,"dynamic") == 0)
+        SetMagickThreadScheduleType(DynamicThreadSchedule);
+      if (LocaleCompare(limit,"static") == 0)
+        SetMagickThreadScheduleType(StaticThreadSchedule);
+      limit=DestroyString(limit);
+    }
   limit=GetEnvironmentValue("MAGICK_TIME_LIMIT");
   if (limit == (char *) NULL)
     limit=GetPolicyValue("time");
@@ -1029,6 +1254,11 @@ MagickExport void ResourceComponentTerminus(void)
     temporary_resources=DestroySplayTree(temporary_resources);
   if (random_info != (RandomInfo *) NULL)
     random_info=DestroyRandomInfo(random_info);
+  if (instantiate_key != MagickFalse)
+    {
+      (void) MagickDeleteThreadKey(resource_key);
+      instantiate_key=MagickFalse;
+    }
   (void) UnlockSemaphoreInfo(resource_semaphore);
   DestroySemaphoreInfo(&resource_semaphore);
 }
@@ -1061,50 +1291,134 @@ MagickExport void ResourceComponentTerminus(void)
 MagickExport MagickBooleanType SetMagickResourceLimit(const ResourceType type,
   const MagickSizeType limit)
 {
+  if ((type <= UndefinedResource) || (type >= NumberOfResources))
+    return(MagickTrue);
   if (resource_semaphore == (SemaphoreInfo *) NULL)
     AcquireSemaphoreInfo(&resource_semaphore);
   (void) LockSemaphoreInfo(resource_semaphore);
-  switch (type)
-  {
-    case AreaResource:
-    {
-      resource_info.area_limit=limit;
-      break;
-    }
-    case MemoryResource:
-    {
-      resource_info.memory_limit=limit;
-      break;
-    }
-    case MapResource:
-    {
-      resource_info.map_limit=limit;
-      break;
-    }
-    case DiskResource:
-    {
-      resource_info.disk_limit=limit;
-      break;
-    }
-    case FileResource:
-    {
-      resource_info.file_limit=limit;
-      break;
-    }
-    case ThreadResource:
+  resource_info.limits[type]=limit;
+  if (type == ThreadResource)
     {
       SetOpenMPMaximumThreads((unsigned long) limit);
-      resource_info.thread_limit=GetOpenMPMaximumThreads();
-      break;
+      resource_info.limits[type]=GetOpenMPMaximumThreads();
     }
-    case TimeResource:
-    {
-      resource_info.time_limit=limit;
-      break;
-    }
-    default:
-      break;
-  }
   (void) UnlockSemaphoreInfo(resource_semaphore);
   return(MagickTrue);
 }
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   S e t R e s o u r c e C o n t e x t L i m i t                             %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  SetResourceContextLimit() sets the limit a resource context places on a
+%  particular resource.  Use MagickResourceInfinity to lift the limit.  The
+%  thread limit caps the OpenMP team size of the threads the context is bound
+%  to and the time limit bounds, in seconds, how long after the context was
+%  acquired its pixel caches remain accessible.
+%
+%  The format of the SetResourceContextLimit() method is:
+%
+%      MagickBooleanType SetResourceContextLimit(
+%        ResourceContext *resource_context,const ResourceType type,
+%        const MagickSizeType limit)
+%
+%  A description of each parameter follows:
+%
+%    o resource_context: the resource context.
+%
+%    o type: the type of resource.
+%
+%    o limit: the maximum limit for the resource.
+%
+*/
+
+static void SetResourceContextThreads(const ResourceContext *resource_context)
+{
+  MagickSizeType
+    threads;
+
+  /*
+    OpenMP 3.0 keeps the team size per thread, so a context narrows the
+    parallel regions of the threads it is bound to and no others.
+  */
+  threads=resource_info.limits[ThreadResource];
+  if ((resource_context != (const ResourceContext *) NULL) &&
+      (resource_context->resource_info.limits[ThreadResource] < threads))
+    threads=resource_context->resource_info.limits[ThreadResource];
+  if (threads == MagickResourceInfinity)
+    return;
+  SetOpenMPMaximumThreads(threads == 0 ? 1UL : (unsigned long) threads);
+}
+
+MagickExport MagickBooleanType SetResourceContextLimit(
+  ResourceContext *resource_context,const ResourceType type,
+  const MagickSizeType limit)
+{
+  assert(resource_context != (ResourceContext *) NULL);
+  assert(resource_context->signature == MagickSignature);
+  if ((type <= UndefinedResource) || (type >= NumberOfResources))
+    return(MagickFalse);
+  resource_context->resource_info.limits[type]=limit;
+  if ((type == ThreadResource) &&
+      (GetThreadResourceContext() == resource_context))
+    SetResourceContextThreads(resource_context);
+  return(MagickTrue);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   S e t T h r e a d R e s o u r c e C o n t e x t                           %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  SetThreadResourceContext() binds a resource context to the calling thread
+%  and returns the context previously bound, if any.  Bind NULL to stop
+%  charging the thread's resources to a context.  The thread's OpenMP team
+%  size follows the thread limit of the bound context.  No reference is taken;
+%  the caller must keep the context alive while it is bound.
+%
+%  The format of the SetThreadResourceContext() method is:
+%
+%      ResourceContext *SetThreadResourceContext(
+%        ResourceContext *resource_context)
+%
+%  A description of each parameter follows:
+%
+%    o resource_context: the resource context.
+%
+*/
+MagickExport ResourceContext *SetThreadResourceContext(
+  ResourceContext *resource_context)
+{
+  ResourceContext
+    *previous_context;
+
+  assert((resource_context == (ResourceContext *) NULL) ||
+    (resource_context->signature == MagickSignature));
+  if (instantiate_key == MagickFalse)
+    return((ResourceContext *) NULL);
+  previous_context=(ResourceContext *) MagickGetThreadValue(resource_key);
+  if (resource_context == previous_context)
+    return(previous_context);
+  (void) MagickSetThreadValue(resource_key,resource_context);
+  if (((previous_context != (ResourceContext *) NULL) &&
+       (previous_context->resource_info.limits[ThreadResource] !=
+        MagickResourceInfinity)) ||
+      ((resource_context != (ResourceContext *) NULL) &&
+       (resource_context->resource_info.limits[ThreadResource] !=
+        MagickResourceInfinity)))
+    SetResourceContextThreads(resource_context);
+  return(previous_context);
+}
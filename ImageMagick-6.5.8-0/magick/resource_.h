@@ -36,23 +36,41 @@ typedef enum
 
 #define MagickResourceInfinity  MagickULLConstant(~0)
 
+typedef struct _ResourceContext
+  ResourceContext;
+
 extern MagickExport int
   AcquireUniqueFileResource(char *);
 
 extern MagickExport MagickBooleanType
   AcquireMagickResource(const ResourceType,const MagickSizeType),
+  AcquireResourceContextResource(ResourceContext *,const ResourceType,
+    const MagickSizeType),
   ListMagickResourceInfo(FILE *,ExceptionInfo *),
   RelinquishUniqueFileResource(const char *),
   ResourceComponentGenesis(void),
-  SetMagickResourceLimit(const ResourceType,const MagickSizeType);
+  SetMagickResourceLimit(const ResourceType,const MagickSizeType),
+  SetResourceContextLimit(ResourceContext *,const ResourceType,
+    const MagickSizeType);
 
 extern MagickExport MagickSizeType
   GetMagickResource(const ResourceType),
-  GetMagickResourceLimit(const ResourceType);
+  GetMagickResourceLimit(const ResourceType),
+  GetResourceContextLimit(const ResourceContext *,const ResourceType),
+  GetResourceContextResource(ResourceContext *,const ResourceType);
+
+extern MagickExport ResourceContext
+  *AcquireResourceContext(void),
+  *DestroyResourceContext(ResourceContext *),
+  *GetThreadResourceContext(void),
+  *ReferenceResourceContext(ResourceContext *),
+  *SetThreadResourceContext(ResourceContext *);
 
 extern MagickExport void
   AsynchronousResourceComponentTerminus(void),
   RelinquishMagickResource(const ResourceType,const MagickSizeType),
+  RelinquishResourceContextResource(ResourceContext *,const ResourceType,
+    const MagickSizeType),
   ResourceComponentTerminus(void);
 
 #if defined(__cplusplus) || defined(c_plusplus)
@@ -72,6 +72,7 @@
 #include "magick/resource_.h"
 #include "magick/shear.h"
 #include "magick/statistic.h"
+#include "magick/thread-private.h"
 #include "magick/threshold.h"
 #include "magick/transform.h"
 
@@ -627,7 +628,8 @@ static void RadonProjection(RadonInfo *source_cells,
     q=swap;
   }
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4)
+  #pragma omp parallel for \
+    magick_schedule(PointThreadCost,p->height,p->width)
 #endif
   for (x=0; x < (long) p->width; x++)
   {
@@ -707,7 +709,8 @@ static MagickBooleanType RadonTransform(const Image *image,
   status=MagickTrue;
   image_view=AcquireCacheView(image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(status)
+  #pragma omp parallel for shared(status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
   for (y=0; y < (long) image->rows; y++)
   {
@@ -758,7 +761,8 @@ static MagickBooleanType RadonTransform(const Image *image,
   RadonProjection(source_cells,destination_cells,-1,projection);
   (void) ResetRadonCells(source_cells);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(status)
+  #pragma omp parallel for shared(status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
   for (y=0; y < (long) image->rows; y++)
   {
@@ -1075,7 +1079,8 @@ static Image *IntegralRotateImage(const Image *image,unsigned long rotations,
       */
       GetPixelCacheTileSize(image,&tile_width,&tile_height);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress, status)
+  #pragma omp parallel for shared(progress, status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
       for (tile_y=0; tile_y < (long) image->rows; tile_y+=tile_height)
       {
@@ -1189,7 +1194,8 @@ static Image *IntegralRotateImage(const Image *image,unsigned long rotations,
         Rotate 180 degrees.
       */
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress, status)
+  #pragma omp parallel for shared(progress, status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
       for (y=0; y < (long) image->rows; y++)
       {
@@ -1265,7 +1271,8 @@ static Image *IntegralRotateImage(const Image *image,unsigned long rotations,
       */
       GetPixelCacheTileSize(image,&tile_width,&tile_height);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress, status)
+  #pragma omp parallel for shared(progress, status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
       for (tile_y=0; tile_y < (long) image->rows; tile_y+=tile_height)
       {
@@ -1461,7 +1468,8 @@ static MagickBooleanType XShearImage(Image *image,const MagickRealType degrees,
   exception=(&image->exception);
   image_view=AcquireCacheView(image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress, status)
+  #pragma omp parallel for shared(progress, status) \
+    magick_schedule(PointThreadCost,width,height)
 #endif
   for (y=0; y < (long) height; y++)
   {
@@ -1681,7 +1689,8 @@ static MagickBooleanType YShearImage(Image *image,const MagickRealType degrees,
   exception=(&image->exception);
   image_view=AcquireCacheView(image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress, status)
+  #pragma omp parallel for shared(progress, status) \
+    magick_schedule(PointThreadCost,height,width)
 #endif
   for (x=0; x < (long) width; x++)
   {
@@ -45,8 +45,439 @@
 #include "magick/image.h"
 #include "magick/module.h"
 #include "magick/policy.h"
+#include "magick/semaphore.h"
 #include "magick/static.h"
 #include "magick/string_.h"
+
+#if !defined(MAGICKCORE_BUILD_MODULES)
+/*
+  Typedef declarations.
+*/
+typedef struct _StaticFormatInfo
+{
+  const char
+    *format,
+    *module;
+} StaticFormatInfo;
+
+typedef struct _StaticModuleInfo
+{
+  const char
+    *module;
+
+  unsigned long
+    (*register_module)(void);
+
+  void
+    (*unregister_module)(void);
+} StaticModuleInfo;
+
+/*
+  Static declarations: every name a coder passes to SetMagickInfo(), and the
+  coders themselves, both sorted by LocaleCompare() for a binary search.
+*/
+static const StaticFormatInfo
+  StaticFormats[] =
+  {
+    { "3FR", "DNG" },
+    { "8BIM", "META" },
+    { "8BIMTEXT", "META" },
+    { "8BIMWTEXT", "META" },
+    { "A", "RAW" },
+    { "AI", "PDF" },
+    { "APP1", "META" },
+    { "APP1JPEG", "META" },
+    { "ART", "ART" },
+    { "ARW", "DNG" },
+    { "AVI", "MPEG" },
+    { "AVS", "AVS" },
+    { "B", "RAW" },
+    { "BGR", "RGB" },
+    { "BIE", "JBIG" },
+    { "BMP", "BMP" },
+    { "BMP2", "BMP" },
+    { "BMP3", "BMP" },
+    { "BRF", "BRAILLE" },
+    { "BRG", "RGB" },
+    { "C", "RAW" },
+    { "CACHE", "MPC" },
+    { "CAL", "CALS" },
+    { "CALS", "CALS" },
+    { "CAPTION", "CAPTION" },
+    { "CIN", "CIN" },
+    { "CIP", "CIP" },
+    { "CLIP", "CLIP" },
+    { "CLIPBOARD", "CLIPBOARD" },
+    { "CMYK", "CMYK" },
+    { "CMYKA", "CMYK" },
+    { "CR2", "DNG" },
+    { "CRW", "DNG" },
+    { "CUR", "ICON" },
+    { "CUT", "CUT" },
+    { "DCM", "DCM" },
+    { "DCR", "DNG" },
+    { "DCX", "PCX" },
+    { "DDS", "DDS" },
+    { "DFONT", "TTF" },
+    { "DIB", "DIB" },
+    { "DJVU", "DJVU" },
+    { "DNG", "DNG" },
+    { "DOT", "DOT" },
+    { "DPS", "DPS" },
+    { "DPX", "DPX" },
+    { "EMF", "EMF" },
+    { "EPDF", "PDF" },
+    { "EPI", "PS" },
+    { "EPS", "PS" },
+    { "EPS2", "PS2" },
+    { "EPS3", "PS3" },
+    { "EPSF", "PS" },
+    { "EPSI", "PS" },
+    { "EPT", "EPT" },
+    { "EPT2", "EPT" },
+    { "EPT3", "EPT" },
+    { "ERF", "DNG" },
+    { "EXIF", "META" },
+    { "EXR", "EXR" },
+    { "FAX", "FAX" },
+    { "FILE", "URL" },
+    { "FITS", "FITS" },
+    { "FPX", "FPX" },
+    { "FRACTAL", "PLASMA" },
+    { "FTP", "URL" },
+    { "FTS", "FITS" },
+    { "G", "RAW" },
+    { "G3", "FAX" },
+    { "GBR", "RGB" },
+    { "GIF", "GIF" },
+    { "GIF87", "GIF" },
+    { "GRADIENT", "GRADIENT" },
+    { "GRANITE", "MAGICK" },
+    { "GRAY", "GRAY" },
+    { "GRB", "RGB" },
+    { "GROUP4", "TIFF" },
+    { "H", "MAGICK" },
+    { "HALD", "HALD" },
+    { "HISTOGRAM", "HISTOGRAM" },
+    { "HRZ", "HRZ" },
+    { "HTM", "HTML" },
+    { "HTML", "HTML" },
+    { "HTTP", "URL" },
+    { "ICB", "TGA" },
+    { "ICC", "META" },
+    { "ICM", "META" },
+    { "ICO", "ICON" },
+    { "ICON", "ICON" },
+    { "INFO", "INFO" },
+    { "INLINE", "INLINE" },
+    { "IPL", "IPL" },
+    { "IPTC", "META" },
+    { "IPTCTEXT", "META" },
+    { "IPTCWTEXT", "META" },
+    { "ISOBRL", "BRAILLE" },
+    { "JBG", "JBIG" },
+    { "JBIG", "JBIG" },
+    { "JNG", "PNG" },
+    { "JP2", "JP2" },
+    { "JPC", "JP2" },
+    { "JPEG", "JPEG" },
+    { "JPG", "JPEG" },
+    { "JPX", "JP2" },
+    { "K", "RAW" },
+    { "K25", "DNG" },
+    { "KDC", "DNG" },
+    { "LABEL", "LABEL" },
+    { "LOGO", "MAGICK" },
+    { "M", "RAW" },
+    { "M2V", "MPEG" },
+    { "M4V", "MPEG" },
+    { "MAGICK", "MAGICK" },
+    { "MAP", "MAP" },
+    { "MAT", "MAT" },
+    { "MATTE", "MATTE" },
+    { "MIFF", "MIFF" },
+    { "MNG", "PNG" },
+    { "MONO", "MONO" },
+    { "MOV", "MPEG" },
+    { "MP4", "MPEG" },
+    { "MPC", "MPC" },
+    { "MPEG", "MPEG" },
+    { "MPG", "MPEG" },
+    { "MPR", "MPR" },
+    { "MPRI", "MPR" },
+    { "MRW", "DNG" },
+    { "MSL", "MSL" },
+    { "MSVG", "SVG" },
+    { "MTV", "MTV" },
+    { "MVG", "MVG" },
+    { "NEF", "DNG" },
+    { "NETSCAPE", "MAGICK" },
+    { "NULL", "NULL" },
+    { "O", "RAW" },
+    { "ORF", "DNG" },
+    { "OTB", "OTB" },
+    { "OTF", "TTF" },
+    { "PAL", "UYVY" },
+    { "PALM", "PALM" },
+    { "PAM", "PNM" },
+    { "PATTERN", "PATTERN" },
+    { "PBM", "PNM" },
+    { "PCD", "PCD" },
+    { "PCDS", "PCD" },
+    { "PCL", "PCL" },
+    { "PCT", "PICT" },
+    { "PCX", "PCX" },
+    { "PDB", "PDB" },
+    { "PDF", "PDF" },
+    { "PDFA", "PDF" },
+    { "PEF", "DNG" },
+    { "PFA", "TTF" },
+    { "PFB", "TTF" },
+    { "PFM", "PNM" },
+    { "PGM", "PNM" },
+    { "PGX", "JP2" },
+    { "PICON", "XPM" },
+    { "PICT", "PICT" },
+    { "PIX", "PIX" },
+    { "PJPEG", "JPEG" },
+    { "PLASMA", "PLASMA" },
+    { "PM", "XPM" },
+    { "PNG", "PNG" },
+    { "PNG24", "PNG" },
+    { "PNG32", "PNG" },
+    { "PNG8", "PNG" },
+    { "PNM", "PNM" },
+    { "PPM", "PNM" },
+    { "PREVIEW", "PREVIEW" },
+    { "PS", "PS" },
+    { "PS2", "PS2" },
+    { "PS3", "PS3" },
+    { "PSD", "PSD" },
+    { "PTIF", "TIFF" },
+    { "PWP", "PWP" },
+    { "R", "RAW" },
+    { "RADIAL-GRADIENT", "GRADIENT" },
+    { "RAF", "DNG" },
+    { "RAS", "SUN" },
+    { "RBG", "RGB" },
+    { "RGB", "RGB" },
+    { "RGBA", "RGB" },
+    { "RGBO", "RGB" },
+    { "RLA", "RLA" },
+    { "RLE", "RLE" },
+    { "ROSE", "MAGICK" },
+    { "SCR", "SCR" },
+    { "SCT", "SCT" },
+    { "SFW", "SFW" },
+    { "SGI", "SGI" },
+    { "SHTML", "HTML" },
+    { "SR2", "DNG" },
+    { "SRF", "DNG" },
+    { "STEGANO", "STEGANO" },
+    { "SUN", "SUN" },
+    { "SVG", "SVG" },
+    { "SVGZ", "SVG" },
+    { "TEXT", "TXT" },
+    { "TGA", "TGA" },
+    { "THUMBNAIL", "THUMBNAIL" },
+    { "TIF", "TIFF" },
+    { "TIFF", "TIFF" },
+    { "TIFF64", "TIFF" },
+    { "TILE", "TILE" },
+    { "TIM", "TIM" },
+    { "TTC", "TTF" },
+    { "TTF", "TTF" },
+    { "TXT", "TXT" },
+    { "UBRL", "BRAILLE" },
+    { "UIL", "UIL" },
+    { "UYVY", "UYVY" },
+    { "VDA", "TGA" },
+    { "VICAR", "VICAR" },
+    { "VID", "VID" },
+    { "VIFF", "VIFF" },
+    { "VST", "TGA" },
+    { "WBMP", "WBMP" },
+    { "WMF", "WMF" },
+    { "WMFWIN32", "EMF" },
+    { "WMV", "MPEG" },
+    { "WMZ", "WMF" },
+    { "WPG", "WPG" },
+    { "X", "X" },
+    { "X3F", "DNG" },
+    { "XBM", "XBM" },
+    { "XC", "XC" },
+    { "XCF", "XCF" },
+    { "XMP", "META" },
+    { "XPM", "XPM" },
+    { "XPS", "XPS" },
+    { "XTRNARRAY", "XTRN" },
+    { "XTRNBLOB", "XTRN" },
+    { "XTRNBSTR", "XTRN" },
+    { "XTRNFILE", "XTRN" },
+    { "XTRNIMAGE", "XTRN" },
+    { "XV", "VIFF" },
+    { "XWD", "XWD" },
+    { "Y", "RAW" },
+    { "YCbCr", "YCBCR" },
+    { "YCbCrA", "YCBCR" },
+    { "YUV", "YUV" },
+  };
+
+static const StaticModuleInfo
+  StaticModules[] =
+  {
+    { "ART", RegisterARTImage, UnregisterARTImage },
+    { "AVS", RegisterAVSImage, UnregisterAVSImage },
+    { "BMP", RegisterBMPImage, UnregisterBMPImage },
+    { "BRAILLE", RegisterBRAILLEImage, UnregisterBRAILLEImage },
+    { "CALS", RegisterCALSImage, UnregisterCALSImage },
+    { "CAPTION", RegisterCAPTIONImage, UnregisterCAPTIONImage },
+    { "CIN", RegisterCINImage, UnregisterCINImage },
+    { "CIP", RegisterCIPImage, UnregisterCIPImage },
+    { "CLIP", RegisterCLIPImage, UnregisterCLIPImage },
+#if defined(MAGICKCORE_WINGDI32_DELEGATE)
+    { "CLIPBOARD", RegisterCLIPBOARDImage, UnregisterCLIPBOARDImage },
+#endif
+    { "CMYK", RegisterCMYKImage, UnregisterCMYKImage },
+    { "CUT", RegisterCUTImage, UnregisterCUTImage },
+    { "DCM", RegisterDCMImage, UnregisterDCMImage },
+    { "DDS", RegisterDDSImage, UnregisterDDSImage },
+    { "DIB", RegisterDIBImage, UnregisterDIBImage },
+#if defined(MAGICKCORE_DJVU_DELEGATE)
+    { "DJVU", RegisterDJVUImage, UnregisterDJVUImage },
+#endif
+    { "DNG", RegisterDNGImage, UnregisterDNGImage },
+    { "DOT", RegisterDOTImage, UnregisterDOTImage },
+#if defined(MAGICKCORE_DPS_DELEGATE)
+    { "DPS", RegisterDPSImage, UnregisterDPSImage },
+#endif
+    { "DPX", RegisterDPXImage, UnregisterDPXImage },
+#if defined(MAGICKCORE_WINGDI32_DELEGATE)
+    { "EMF", RegisterEMFImage, UnregisterEMFImage },
+#endif
+#if defined(MAGICKCORE_TIFF_DELEGATE)
+    { "EPT", RegisterEPTImage, UnregisterEPTImage },
+#endif
+#if defined(MAGICKCORE_OPENEXR_DELEGATE)
+    { "EXR", RegisterEXRImage, UnregisterEXRImage },
+#endif
+    { "FAX", RegisterFAXImage, UnregisterFAXImage },
+    { "FITS", RegisterFITSImage, UnregisterFITSImage },
+#if defined(MAGICKCORE_FPX_DELEGATE)
+    { "FPX", RegisterFPXImage, UnregisterFPXImage },
+#endif
+    { "GIF", RegisterGIFImage, UnregisterGIFImage },
+    { "GRADIENT", RegisterGRADIENTImage, UnregisterGRADIENTImage },
+    { "GRAY", RegisterGRAYImage, UnregisterGRAYImage },
+    { "HALD", RegisterHALDImage, UnregisterHALDImage },
+    { "HISTOGRAM", RegisterHISTOGRAMImage, UnregisterHISTOGRAMImage },
+    { "HRZ", RegisterHRZImage, UnregisterHRZImage },
+    { "HTML", RegisterHTMLImage, UnregisterHTMLImage },
+    { "ICON", RegisterICONImage, UnregisterICONImage },
+    { "INFO", RegisterINFOImage, UnregisterINFOImage },
+    { "INLINE", RegisterINLINEImage, UnregisterINLINEImage },
+    { "IPL", RegisterIPLImage, UnregisterIPLImage },
+#if defined(MAGICKCORE_JBIG_DELEGATE)
+    { "JBIG", RegisterJBIGImage, UnregisterJBIGImage },
+#endif
+#if defined(MAGICKCORE_JP2_DELEGATE)
+    { "JP2", RegisterJP2Image, UnregisterJP2Image },
+#endif
+#if defined(MAGICKCORE_JPEG_DELEGATE)
+    { "JPEG", RegisterJPEGImage, UnregisterJPEGImage },
+#endif
+    { "LABEL", RegisterLABELImage, UnregisterLABELImage },
+    { "MAGICK", RegisterMAGICKImage, UnregisterMAGICKImage },
+    { "MAP", RegisterMAPImage, UnregisterMAPImage },
+    { "MAT", RegisterMATImage, UnregisterMATImage },
+    { "MATTE", RegisterMATTEImage, UnregisterMATTEImage },
+    { "META", RegisterMETAImage, UnregisterMETAImage },
+    { "MIFF", RegisterMIFFImage, UnregisterMIFFImage },
+    { "MONO", RegisterMONOImage, UnregisterMONOImage },
+    { "MPC", RegisterMPCImage, UnregisterMPCImage },
+    { "MPEG", RegisterMPEGImage, UnregisterMPEGImage },
+    { "MPR", RegisterMPRImage, UnregisterMPRImage },
+    { "MSL", RegisterMSLImage, UnregisterMSLImage },
+    { "MTV", RegisterMTVImage, UnregisterMTVImage },
+    { "MVG", RegisterMVGImage, UnregisterMVGImage },
+    { "NULL", RegisterNULLImage, UnregisterNULLImage },
+    { "OTB", RegisterOTBImage, UnregisterOTBImage },
+    { "PALM", RegisterPALMImage, UnregisterPALMImage },
+    { "PATTERN", RegisterPATTERNImage, UnregisterPATTERNImage },
+    { "PCD", RegisterPCDImage, UnregisterPCDImage },
+    { "PCL", RegisterPCLImage, UnregisterPCLImage },
+    { "PCX", RegisterPCXImage, UnregisterPCXImage },
+    { "PDB", RegisterPDBImage, UnregisterPDBImage },
+    { "PDF", RegisterPDFImage, UnregisterPDFImage },
+    { "PICT", RegisterPICTImage, UnregisterPICTImage },
+    { "PIX", RegisterPIXImage, UnregisterPIXImage },
+    { "PLASMA", RegisterPLASMAImage, UnregisterPLASMAImage },
+#if defined(MAGICKCORE_PNG_DELEGATE)
+    { "PNG", RegisterPNGImage, UnregisterPNGImage },
+#endif
+    { "PNM", RegisterPNMImage, UnregisterPNMImage },
+    { "PREVIEW", RegisterPREVIEWImage, UnregisterPREVIEWImage },
+    { "PS", RegisterPSImage, UnregisterPSImage },
+    { "PS2", RegisterPS2Image, UnregisterPS2Image },
+    { "PS3", RegisterPS3Image, UnregisterPS3Image },
+    { "PSD", RegisterPSDImage, UnregisterPSDImage },
+    { "PWP", RegisterPWPImage, UnregisterPWPImage },
+    { "RAW", RegisterRAWImage, UnregisterRAWImage },
+    { "RGB", RegisterRGBImage, UnregisterRGBImage },
+    { "RLA", RegisterRLAImage, UnregisterRLAImage },
+    { "RLE", RegisterRLEImage, UnregisterRLEImage },
+    { "SCR", RegisterSCRImage, UnregisterSCRImage },
+    { "SCT", RegisterSCTImage, UnregisterSCTImage },
+    { "SFW", RegisterSFWImage, UnregisterSFWImage },
+    { "SGI", RegisterSGIImage, UnregisterSGIImage },
+    { "STEGANO", RegisterSTEGANOImage, UnregisterSTEGANOImage },
+    { "SUN", RegisterSUNImage, UnregisterSUNImage },
+    { "SVG", RegisterSVGImage, UnregisterSVGImage },
+    { "TGA", RegisterTGAImage, UnregisterTGAImage },
+    { "THUMBNAIL", RegisterTHUMBNAILImage, UnregisterTHUMBNAILImage },
+#if defined(MAGICKCORE_TIFF_DELEGATE)
+    { "TIFF", RegisterTIFFImage, UnregisterTIFFImage },
+#endif
+    { "TILE", RegisterTILEImage, UnregisterTILEImage },
+    { "TIM", RegisterTIMImage, UnregisterTIMImage },
+    { "TTF", RegisterTTFImage, UnregisterTTFImage },
+    { "TXT", RegisterTXTImage, UnregisterTXTImage },
+    { "UIL", RegisterUILImage, UnregisterUILImage },
+    { "URL", RegisterURLImage, UnregisterURLImage },
+    { "UYVY", RegisterUYVYImage, UnregisterUYVYImage },
+    { "VICAR", RegisterVICARImage, UnregisterVICARImage },
+    { "VID", RegisterVIDImage, UnregisterVIDImage },
+    { "VIFF", RegisterVIFFImage, UnregisterVIFFImage },
+    { "WBMP", RegisterWBMPImage, UnregisterWBMPImage },
+#if defined(MAGICKCORE_WMF_DELEGATE) || defined(MAGICKCORE_WMFLITE_DELEGATE)
+    { "WMF", RegisterWMFImage, UnregisterWMFImage },
+#endif
+    { "WPG", RegisterWPGImage, UnregisterWPGImage },
+#if defined(MAGICKCORE_X11_DELEGATE)
+    { "X", RegisterXImage, UnregisterXImage },
+#endif
+    { "XBM", RegisterXBMImage, UnregisterXBMImage },
+    { "XC", RegisterXCImage, UnregisterXCImage },
+    { "XCF", RegisterXCFImage, UnregisterXCFImage },
+    { "XPM", RegisterXPMImage, UnregisterXPMImage },
+    { "XPS", RegisterXPSImage, UnregisterXPSImage },
+#if defined(_VISUALC_)
+    { "XTRN", RegisterXTRNImage, UnregisterXTRNImage },
+#endif
+#if defined(MAGICKCORE_X11_DELEGATE)
+    { "XWD", RegisterXWDImage, UnregisterXWDImage },
+#endif
+    { "YCBCR", RegisterYCBCRImage, UnregisterYCBCRImage },
+    { "YUV", RegisterYUVImage, UnregisterYUVImage },
+  };
+
+static SemaphoreInfo
+  *static_semaphore = (SemaphoreInfo *) NULL;
+
+static volatile MagickBooleanType
+  instantiate_static = MagickFalse,
+  static_registered[sizeof(StaticModules)/sizeof(*StaticModules)];
+#endif
 
 /*
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -146,162 +577,151 @@ MagickExport MagickBooleanType InvokeStaticImageFilter(const char *tag,
 %                                                                             %
 %                                                                             %
 %                                                                             %
+%   R e g i s t e r S t a t i c M o d u l e                                   %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  RegisterStaticModule() registers the statically linked coder that supports
+%  the specified image format, unless it is already registered.  It returns
+%  MagickTrue if such a coder exists, so the caller can repeat its lookup.
+%
+%  The format of the RegisterStaticModule method is:
+%
+%      MagickBooleanType RegisterStaticModule(const char *format)
+%
+%  A description of each parameter follows:
+%
+%    o format: the image format name (e.g. PNG8).
+%
+*/
+
+#if !defined(MAGICKCORE_BUILD_MODULES)
+static long GetStaticModuleIndex(const char *format)
+{
+  const char
+    *module;
+
+  int
+    status;
+
+  long
+    k;
+
+  register long
+    i,
+    j;
+
+  /*
+    Binary search the format table, then the module table.
+  */
+  module=(const char *) NULL;
+  i=0;
+  j=(long) (sizeof(StaticFormats)/sizeof(*StaticFormats))-1;
+  while (i <= j)
+  {
+    k=(i+j)/2;
+    status=LocaleCompare(format,StaticFormats[k].format);
+    if (status == 0)
+      {
+        module=StaticFormats[k].module;
+        break;
+      }
+    if (status < 0)
+      j=k-1;
+    else
+      i=k+1;
+  }
+  if (module == (const char *) NULL)
+    return(-1);
+  i=0;
+  j=(long) (sizeof(StaticModules)/sizeof(*StaticModules))-1;
+  while (i <= j)
+  {
+    k=(i+j)/2;
+    status=LocaleCompare(module,StaticModules[k].module);
+    if (status == 0)
+      return(k);
+    if (status < 0)
+      j=k-1;
+    else
+      i=k+1;
+  }
+  return(-1);
+}
+#endif
+
+MagickExport MagickBooleanType RegisterStaticModule(const char *format)
+{
+#if !defined(MAGICKCORE_BUILD_MODULES)
+  long
+    i;
+
+  assert(format != (const char *) NULL);
+  i=GetStaticModuleIndex(format);
+  if (i < 0)
+    return(MagickFalse);
+  if (static_registered[i] == MagickFalse)
+    {
+      if (static_semaphore == (SemaphoreInfo *) NULL)
+        AcquireSemaphoreInfo(&static_semaphore);
+      (void) LockSemaphoreInfo(static_semaphore);
+      if (static_registered[i] == MagickFalse)
+        {
+          (void) StaticModules[i].register_module();
+          static_registered[i]=MagickTrue;
+        }
+      (void) UnlockSemaphoreInfo(static_semaphore);
+    }
+  return(MagickTrue);
+#else
+  (void) format;
+  return(MagickFalse);
+#endif
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
 %   R e g i s t e r S t a t i c M o d u l e s                                 %
 %                                                                             %
 %                                                                             %
 %                                                                             %
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 %
-%  (void) RegisterStaticModules() statically registers all the available module
-%  handlers.
+%  RegisterStaticModules() statically registers all the available module
+%  handlers that are not registered yet.  Individual coders are otherwise
+%  registered on the first use of one of their formats, see
+%  RegisterStaticModule().
 %
 %  The format of the RegisterStaticModules method is:
 %
-%      (void) RegisterStaticModules(void)
+%      void RegisterStaticModules(void)
 %
 */
 MagickExport void RegisterStaticModules(void)
 {
 #if !defined(MAGICKCORE_BUILD_MODULES)
-  (void) RegisterARTImage();
-  (void) RegisterAVSImage();
-  (void) RegisterBMPImage();
-  (void) RegisterCAPTIONImage();
-  (void) RegisterCINImage();
-  (void) RegisterCIPImage();
-  (void) RegisterCLIPImage();
-#if defined(MAGICKCORE_WINGDI32_DELEGATE)
-  (void) RegisterCLIPBOARDImage();
-#endif
-  (void) RegisterCMYKImage();
-  (void) RegisterCUTImage();
-  (void) RegisterDCMImage();
-  (void) RegisterDDSImage();
-  (void) RegisterDIBImage();
-#if defined(MAGICKCORE_DJVU_DELEGATE)
-  (void) RegisterDJVUImage();
-#endif
-  (void) RegisterDNGImage();
-#if defined(MAGICKCORE_DPS_DELEGATE)
-  (void) RegisterDPSImage();
-#endif
-  (void) RegisterDPXImage();
-#if defined(MAGICKCORE_WINGDI32_DELEGATE)
-  (void) RegisterEMFImage();
-#endif
-#if defined(MAGICKCORE_TIFF_DELEGATE)
-  (void) RegisterEPTImage();
-#endif
-#if defined(MAGICKCORE_OPENEXR_DELEGATE)
-  (void) RegisterEXRImage();
-#endif
-  (void) RegisterFAXImage();
-  (void) RegisterFITSImage();
-#if defined(MAGICKCORE_FPX_DELEGATE)
-  (void) RegisterFPXImage();
-#endif
-  (void) RegisterGIFImage();
-  (void) RegisterGRAYImage();
-  (void) RegisterGRADIENTImage();
-  (void) RegisterHISTOGRAMImage();
-  (void) RegisterHRZImage();
-  (void) RegisterHTMLImage();
-  (void) RegisterICONImage();
-  (void) RegisterINFOImage();
-  (void) RegisterINLINEImage();
-  (void) RegisterIPLImage();
-#if defined(MAGICKCORE_JBIG_DELEGATE)
-  (void) RegisterJBIGImage();
-#endif
-#if defined(MAGICKCORE_JPEG_DELEGATE)
-  (void) RegisterJPEGImage();
-#endif
-#if defined(MAGICKCORE_JP2_DELEGATE)
-  (void) RegisterJP2Image();
-#endif
-  (void) RegisterLABELImage();
-  (void) RegisterMAGICKImage();
-  (void) RegisterMAPImage();
-  (void) RegisterMATImage();
-  (void) RegisterMATTEImage();
-  (void) RegisterMETAImage();
-  (void) RegisterMIFFImage();
-  (void) RegisterMONOImage();
-  (void) RegisterMPCImage();
-  (void) RegisterMPEGImage();
-  (void) RegisterMPRImage();
-  (void) RegisterMSLImage();
-  (void) RegisterMTVImage();
-  (void) RegisterMVGImage();
-  (void) RegisterNULLImage();
-  (void) RegisterOTBImage();
-  (void) RegisterPALMImage();
-  (void) RegisterPATTERNImage();
-  (void) RegisterPCDImage();
-  (void) RegisterPCLImage();
-  (void) RegisterPCXImage();
-  (void) RegisterPDBImage();
-  (void) RegisterPDFImage();
-  (void) RegisterPICTImage();
-  (void) RegisterPIXImage();
-  (void) RegisterPLASMAImage();
-#if defined(MAGICKCORE_PNG_DELEGATE)
-  (void) RegisterPNGImage();
-#endif
-  (void) RegisterPNMImage();
-  (void) RegisterPREVIEWImage();
-  (void) RegisterPSImage();
-  (void) RegisterPS2Image();
-  (void) RegisterPS3Image();
-  (void) RegisterPSDImage();
-  (void) RegisterPWPImage();
-  (void) RegisterRAWImage();
-  (void) RegisterRGBImage();
-  (void) RegisterRLAImage();
-  (void) RegisterRLEImage();
-  (void) RegisterSCRImage();
-  (void) RegisterSCTImage();
-  (void) RegisterSFWImage();
-  (void) RegisterSGIImage();
-  (void) RegisterSTEGANOImage();
-  (void) RegisterSUNImage();
-  (void) RegisterSVGImage();
-  (void) RegisterTGAImage();
-  (void) RegisterTHUMBNAILImage();
-#if defined(MAGICKCORE_TIFF_DELEGATE)
-  (void) RegisterTIFFImage();
-#endif
-  (void) RegisterTILEImage();
-  (void) RegisterTIMImage();
-  (void) RegisterTTFImage();
-  (void) RegisterTXTImage();
-  (void) RegisterUILImage();
-  (void) RegisterURLImage();
-  (void) RegisterUYVYImage();
-  (void) RegisterVICARImage();
-  (void) RegisterVIDImage();
-  (void) RegisterVIFFImage();
-  (void) RegisterWBMPImage();
-#if defined(MAGICKCORE_WMF_DELEGATE) || defined(MAGICKCORE_WMFLITE_DELEGATE)
-  (void) RegisterWMFImage();
-#endif
-  (void) RegisterWPGImage();
-#if defined(MAGICKCORE_X11_DELEGATE)
-  (void) RegisterXImage();
-#endif
-  (void) RegisterXBMImage();
-  (void) RegisterXCImage();
-  (void) RegisterXCFImage();
-  (void) RegisterXPMImage();
-  (void) RegisterXPSImage();
-#if defined(_VISUALC_)
-  (void) RegisterXTRNImage();
-#endif
-#if defined(MAGICKCORE_X11_DELEGATE)
-  (void) RegisterXWDImage();
-#endif
-  (void) RegisterYCBCRImage();
-  (void) RegisterYUVImage();
+  register long
+    i;
+
+  if (instantiate_static != MagickFalse)
+    return;
+  if (static_semaphore == (SemaphoreInfo *) NULL)
+    AcquireSemaphoreInfo(&static_semaphore);
+  (void) LockSemaphoreInfo(static_semaphore);
+  for (i=0; i < (long) (sizeof(StaticModules)/sizeof(*StaticModules)); i++)
+  {
+    if (static_registered[i] != MagickFalse)
+      continue;
+    (void) StaticModules[i].register_module();
+    static_registered[i]=MagickTrue;
+  }
+  instantiate_static=MagickTrue;
+  (void) UnlockSemaphoreInfo(static_semaphore);
 #endif
 }
 
@@ -316,7 +736,7 @@ MagickExport void RegisterStaticModules(void)
 %                                                                             %
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 %
-%  UnregisterStaticModules() statically unregisters all the available module
+%  UnregisterStaticModules() statically unregisters all the registered module
 %  handlers.
 %
 %  The format of the UnregisterStaticModules method is:
@@ -327,145 +747,21 @@ MagickExport void RegisterStaticModules(void)
 MagickExport void UnregisterStaticModules(void)
 {
 #if !defined(MAGICKCORE_BUILD_MODULES)
-  UnregisterARTImage();
-  UnregisterAVSImage();
-  UnregisterBMPImage();
-  UnregisterBRAILLEImage();
-  UnregisterCAPTIONImage();
-  UnregisterCINImage();
-  UnregisterCIPImage();
-  UnregisterCLIPImage();
-#if defined(MAGICKCORE_WINGDI32_DELEGATE)
-  UnregisterCLIPBOARDImage();
-#endif
-  UnregisterCMYKImage();
-  UnregisterCUTImage();
-  UnregisterDCMImage();
-  UnregisterDDSImage();
-  UnregisterDIBImage();
-#if defined(MAGICKCORE_DJVU_DELEGATE)
-  UnregisterDJVUImage();
-#endif
-  UnregisterDNGImage();
-#if defined(MAGICKCORE_DPS_DELEGATE)
-  UnregisterDPSImage();
-#endif
-  UnregisterDPXImage();
-#if defined(MAGICKCORE_WINGDI32_DELEGATE)
-  UnregisterEMFImage();
-#endif
-#if defined(MAGICKCORE_TIFF_DELEGATE)
-  UnregisterEPTImage();
-#endif
-#if defined(MAGICKCORE_OPENEXR_DELEGATE)
-  UnregisterEXRImage();
-#endif
-  UnregisterFAXImage();
-  UnregisterFITSImage();
-#if defined(MAGICKCORE_FPX_DELEGATE)
-  UnregisterFPXImage();
-#endif
-  UnregisterGIFImage();
-  UnregisterGRAYImage();
-  UnregisterGRADIENTImage();
-  UnregisterHISTOGRAMImage();
-  UnregisterHRZImage();
-  UnregisterHTMLImage();
-  UnregisterICONImage();
-  UnregisterINFOImage();
-  UnregisterINLINEImage();
-  UnregisterIPLImage();
-#if defined(MAGICKCORE_JBIG_DELEGATE)
-  UnregisterJBIGImage();
-#endif
-#if defined(MAGICKCORE_JPEG_DELEGATE)
-  UnregisterJPEGImage();
-#endif
-#if defined(MAGICKCORE_JP2_DELEGATE)
-  UnregisterJP2Image();
-#endif
-  UnregisterLABELImage();
-  UnregisterMAGICKImage();
-  UnregisterMAPImage();
-  UnregisterMATImage();
-  UnregisterMATTEImage();
-  UnregisterMETAImage();
-  UnregisterMIFFImage();
-  UnregisterMONOImage();
-  UnregisterMPCImage();
-  UnregisterMPEGImage();
-  UnregisterMPRImage();
-  UnregisterMSLImage();
-  UnregisterMTVImage();
-  UnregisterMVGImage();
-  UnregisterNULLImage();
-  UnregisterOTBImage();
-  UnregisterPALMImage();
-  UnregisterPATTERNImage();
-  UnregisterPCDImage();
-  UnregisterPCLImage();
-  UnregisterPCXImage();
-  UnregisterPDBImage();
-  UnregisterPDFImage();
-  UnregisterPICTImage();
-  UnregisterPIXImage();
-  UnregisterPLASMAImage();
-#if defined(MAGICKCORE_PNG_DELEGATE)
-  UnregisterPNGImage();
-#endif
-  UnregisterPNMImage();
-  UnregisterPREVIEWImage();
-  UnregisterPSImage();
-  UnregisterPS2Image();
-  UnregisterPS3Image();
-  UnregisterPSDImage();
-  UnregisterPWPImage();
-  UnregisterRAWImage();
-  UnregisterRGBImage();
-  UnregisterRLAImage();
-  UnregisterRLEImage();
-  UnregisterSCRImage();
-  UnregisterSCTImage();
-  UnregisterSFWImage();
-  UnregisterSGIImage();
-  UnregisterSTEGANOImage();
-  UnregisterSUNImage();
-  UnregisterSVGImage();
-  UnregisterTGAImage();
-  UnregisterTHUMBNAILImage();
-#if defined(MAGICKCORE_TIFF_DELEGATE)
-  UnregisterTIFFImage();
-#endif
-  UnregisterTILEImage();
-  UnregisterTIMImage();
-  UnregisterTTFImage();
-  UnregisterTXTImage();
-  UnregisterUILImage();
-  UnregisterURLImage();
-  UnregisterUYVYImage();
-  UnregisterVICARImage();
-  UnregisterVIDImage();
-  UnregisterVIFFImage();
-  UnregisterWBMPImage();
-#if defined(MAGICKCORE_WMF_DELEGATE) || defined(MAGICKCORE_WMFLITE_DELEGATE)
-  UnregisterWMFImage();
-#endif
-  UnregisterWPGImage();
-#if defined(MAGICKCORE_X11_DELEGATE)
-  UnregisterXImage();
-#endif
-  UnregisterXBMImage();
-  UnregisterXCImage();
-  UnregisterXCFImage();
-  UnregisterXPMImage();
-  UnregisterXPSImage();
-#if defined(_VISUALC_)
-  UnregisterXTRNImage();
-#endif
-#if defined(MAGICKCORE_X11_DELEGATE)
-  UnregisterXWDImage();
-#endif
-  UnregisterYCBCRImage();
-  UnregisterYUVImage();
+  register long
+    i;
+
+  if (static_semaphore == (SemaphoreInfo *) NULL)
+    AcquireSemaphoreInfo(&static_semaphore);
+  (void) LockSemaphoreInfo(static_semaphore);
+  for (i=0; i < (long) (sizeof(StaticModules)/sizeof(*StaticModules)); i++)
+  {
+    if (static_registered[i] == MagickFalse)
+      continue;
+    StaticModules[i].unregister_module();
+    static_registered[i]=MagickFalse;
+  }
+  instantiate_static=MagickFalse;
+  (void) UnlockSemaphoreInfo(static_semaphore);
+  DestroySemaphoreInfo(&static_semaphore);
 #endif
 }
@@ -33,6 +33,7 @@ extern ModuleExport unsigned long
   RegisterBIEImage(void),
   RegisterBMPImage(void),
   RegisterBRAILLEImage(void),
+  RegisterCALSImage(void),
   RegisterCAPTIONImage(void),
   RegisterCINImage(void),
   RegisterCIPImage(void),
@@ -46,6 +47,7 @@ extern ModuleExport unsigned long
   RegisterDIBImage(void),
   RegisterDJVUImage(void),
   RegisterDNGImage(void),
+  RegisterDOTImage(void),
   RegisterDPSImage(void),
   RegisterDPXImage(void),
   RegisterEMFImage(void),
@@ -67,6 +69,7 @@ extern ModuleExport unsigned long
   RegisterGRANITEImage(void),
   RegisterGRAYImage(void),
   RegisterHImage(void),
+  RegisterHALDImage(void),
   RegisterHISTOGRAMImage(void),
   RegisterHRZImage(void),
   RegisterHTMLImage(void),
@@ -178,6 +181,7 @@ extern ModuleExport void
   UnregisterBIEImage(void),
   UnregisterBMPImage(void),
   UnregisterBRAILLEImage(void),
+  UnregisterCALSImage(void),
   UnregisterCAPTIONImage(void),
   UnregisterCINImage(void),
   UnregisterCIPImage(void),
@@ -191,6 +195,7 @@ extern ModuleExport void
   UnregisterDIBImage(void),
   UnregisterDJVUImage(void),
   UnregisterDNGImage(void),
+  UnregisterDOTImage(void),
   UnregisterDPSImage(void),
   UnregisterDPXImage(void),
   UnregisterEMFImage(void),
@@ -212,6 +217,7 @@ extern ModuleExport void
   UnregisterGRANITEImage(void),
   UnregisterGRAYImage(void),
   UnregisterHImage(void),
+  UnregisterHALDImage(void),
   UnregisterHISTOGRAMImage(void),
   UnregisterHRZImage(void),
   UnregisterHTMLImage(void),
@@ -0,0 +1,988 @@
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%                  SSSSS   TTTTT  RRRR   IIIII  N   N   GGGG                  %
+%                  SS        T    R   R    I    NN  N  G                      %
+%                   SSS      T    RRRR     I    N N N  G GGG                  %
+%                     SS     T    R R      I    N  NN  G   G                  %
+%                  SSSSS     T    R  R   IIIII  N   N   GGGG                  %
+%                                                                             %
+%                             M   M   AAA   PPPP                              %
+%                             MM MM  A   A  P   P                             %
+%                             M M M  AAAAA  PPPP                              %
+%                             M   M  A   A  P                                 %
+%                             M   M  A   A  P                                 %
+%                                                                             %
+%                                                                             %
+%                        MagickCore String-map Methods                        %
+%                                                                             %
+%                              Software Design                                %
+%                                John Cristy                                  %
+%                               November 2009                                 %
+%                                                                             %
+%                                                                             %
+%  Copyright 1999-2009 ImageMagick Studio LLC, a non-profit organization      %
+%  dedicated to making software imaging solutions freely available.           %
+%                                                                             %
+%  You may not use this file except in compliance with the License.  You may  %
+%  obtain a copy of the License at                                            %
+%                                                                             %
+%    http://www.imagemagick.org/script/license.php                            %
+%                                                                             %
+%  Unless required by applicable law or agreed to in writing, software        %
+%  distributed under the License is distributed on an "AS IS" BASIS,          %
+%  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   %
+%  See the License for the specific language governing permissions and        %
+%  limitations under the License.                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  This module implements a small map from case-insensitive string keys to
+%  string values, as used for image properties, artifacts and options.  The
+%  entries are kept in a sorted vector: lookups are a binary search that does
+%  not restructure the map and need not take its lock, and iteration is in key
+%  order.  Cloning a map shares its entries; they are copied on the first
+%  update of either map.
+%
+*/
+
+/*
+  Include declarations.
+*/
+#include "magick/studio.h"
+#include "magick/exception.h"
+#include "magick/exception-private.h"
+#include "magick/hashmap.h"
+#include "magick/log.h"
+#include "magick/memory_.h"
+#include "magick/semaphore.h"
+#include "magick/string_.h"
+#include "magick/string-map.h"
+#include "magick/thread-private.h"
+
+/*
+  Define declarations.
+*/
+#define MinimumStringMapCapacity  8UL
+#if defined(__GNUC__) && ((__GNUC__ > 4) || \
+    ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 1)))
+#define StringMapMemoryBarrier()  __sync_synchronize()
+#endif
+
+/*
+  Typedef declarations.
+*/
+typedef struct _EntryInfo
+{
+  char
+    *key,
+    *value;
+} EntryInfo;
+
+typedef struct _TableInfo
+{
+  EntryInfo
+    *entries;
+
+  unsigned long
+    capacity;
+
+  volatile unsigned long
+    number_entries;
+
+  MagickBooleanType
+    owner;
+
+  volatile MagickOffsetType
+    reference_count;
+} TableInfo;
+
+struct _StringMapInfo
+{
+  TableInfo
+    *volatile table;
+
+  LinkedListInfo
+    *retired,
+    *retired_keys;
+
+  unsigned long
+    next;
+
+  volatile unsigned long
+    sequence;
+
+  volatile MagickOffsetType
+    readers;
+
+  MagickBooleanType
+    debug;
+
+  SemaphoreInfo
+    *semaphore;
+
+  unsigned long
+    signature;
+};
+
+/*
+  Global declarations.
+*/
+#if !defined(MagickAtomicSupport)
+static SemaphoreInfo
+  *table_semaphore = (SemaphoreInfo *) NULL;
+#endif
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   C l e a r S t r i n g M a p                                               %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  ClearStringMap() removes all the entries from the string-map.
+%
+%  The format of the ClearStringMap method is:
+%
+%      void ClearStringMap(StringMapInfo *string_map)
+%
+%  A description of each parameter follows:
+%
+%    o string_map: the string-map info.
+%
+*/
+
+static void BeginStringMapUpdate(StringMapInfo *string_map)
+{
+  /*
+    An odd sequence number tells lookups a writer is active.
+  */
+  string_map->sequence++;
+#if defined(StringMapMemoryBarrier)
+  StringMapMemoryBarrier();
+#endif
+}
+
+static void EndStringMapUpdate(StringMapInfo *string_map)
+{
+#if defined(StringMapMemoryBarrier)
+  StringMapMemoryBarrier();
+#endif
+  string_map->sequence++;
+}
+
+static void *RelinquishTable(void *table_info)
+{
+  MagickOffsetType
+    reference_count;
+
+  register long
+    i;
+
+  TableInfo
+    *table;
+
+  table=(TableInfo *) table_info;
+#if defined(MagickAtomicSupport)
+  reference_count=MagickAtomicAdd(&table->reference_count,-1);
+#else
+  if (table_semaphore == (SemaphoreInfo *) NULL)
+    AcquireSemaphoreInfo(&table_semaphore);
+  (void) LockSemaphoreInfo(table_semaphore);
+  reference_count=(--table->reference_count);
+  (void) UnlockSemaphoreInfo(table_semaphore);
+#endif
+  if (reference_count > 0)
+    return((void *) NULL);
+  if (table->owner != MagickFalse)
+    for (i=0; i < (long) table->number_entries; i++)
+    {
+      table->entries[i].key=DestroyString(table->entries[i].key);
+      table->entries[i].value=DestroyString(table->entries[i].value);
+    }
+  table->entries=(EntryInfo *) RelinquishMagickMemory(table->entries);
+  table=(TableInfo *) RelinquishMagickMemory(table);
+  return((void *) NULL);
+}
+
+static void ReclaimStringMap(StringMapInfo *string_map)
+{
+  /*
+    Retired tables and keys are no longer reachable from the map: once no
+    lookup is in progress, none can still be reading them.
+  */
+#if defined(StringMapMemoryBarrier)
+  StringMapMemoryBarrier();
+  if (string_map->readers != 0)
+    return;
+#endif
+  if (string_map->retired != (LinkedListInfo *) NULL)
+    string_map->retired=DestroyLinkedList(string_map->retired,RelinquishTable);
+  if (string_map->retired_keys != (LinkedListInfo *) NULL)
+    string_map->retired_keys=DestroyLinkedList(string_map->retired_keys,
+      RelinquishMagickMemory);
+}
+
+static MagickBooleanType RetireTable(StringMapInfo *string_map)
+{
+  /*
+    A lookup may still be searching the table, keep it until no lookup is in
+    progress.
+  */
+  if (string_map->retired == (LinkedListInfo *) NULL)
+    {
+      string_map->retired=NewLinkedList(0);
+      if (string_map->retired == (LinkedListInfo *) NULL)
+        return(MagickFalse);
+    }
+  return(AppendValueToLinkedList(string_map->retired,string_map->table));
+}
+
+static MagickBooleanType RetireKey(StringMapInfo *string_map,char *key)
+{
+  /*
+    A lookup may still be comparing against the key, keep it until no lookup
+    is in progress.
+  */
+  if (string_map->retired_keys == (LinkedListInfo *) NULL)
+    {
+      string_map->retired_keys=NewLinkedList(0);
+      if (string_map->retired_keys == (LinkedListInfo *) NULL)
+        return(MagickFalse);
+    }
+  return(AppendValueToLinkedList(string_map->retired_keys,key));
+}
+
+MagickExport void ClearStringMap(StringMapInfo *string_map)
+{
+  assert(string_map != (StringMapInfo *) NULL);
+  assert(string_map->signature == MagickSignature);
+  if (string_map->debug != MagickFalse)
+    (void) LogMagickEvent(TraceEvent,GetMagickModule(),"...");
+  (void) LockSemaphoreInfo(string_map->semaphore);
+  if ((string_map->table != (TableInfo *) NULL) &&
+      (RetireTable(string_map) != MagickFalse))
+    {
+      BeginStringMapUpdate(string_map);
+      string_map->table=(TableInfo *) NULL;
+      EndStringMapUpdate(string_map);
+    }
+  string_map->next=0;
+  ReclaimStringMap(string_map);
+  (void) UnlockSemaphoreInfo(string_map->semaphore);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   C l o n e S t r i n g M a p                                               %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  CloneStringMap() makes a copy of the given string-map.  The copy shares the
+%  entries of the original until either of them is updated, so cloning is
+%  cheap regardless of the number of entries.
+%
+%  The format of the CloneStringMap method is:
+%
+%      StringMapInfo *CloneStringMap(StringMapInfo *string_map)
+%
+%  A description of each parameter follows:
+%
+%    o string_map: the string-map info.
+%
+*/
+MagickExport StringMapInfo *CloneStringMap(StringMapInfo *string_map)
+{
+  StringMapInfo
+    *clone_map;
+
+  assert(string_map != (StringMapInfo *) NULL);
+  assert(string_map->signature == MagickSignature);
+  if (string_map->debug != MagickFalse)
+    (void) LogMagickEvent(TraceEvent,GetMagickModule(),"...");
+  clone_map=NewStringMap();
+  (void) LockSemaphoreInfo(string_map->semaphore);
+  clone_map->table=string_map->table;
+  if (clone_map->table != (TableInfo *) NULL)
+    {
+#if defined(MagickAtomicSupport)
+      (void) MagickAtomicAdd(&clone_map->table->reference_count,1);
+#else
+      if (table_semaphore == (SemaphoreInfo *) NULL)
+        AcquireSemaphoreInfo(&table_semaphore);
+      (void) LockSemaphoreInfo(table_semaphore);
+      clone_map->table->reference_count++;
+      (void) UnlockSemaphoreInfo(table_semaphore);
+#endif
+    }
+  (void) UnlockSemaphoreInfo(string_map->semaphore);
+  return(clone_map);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   D e l e t e E n t r y F r o m S t r i n g M a p                           %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  DeleteEntryFromStringMap() deletes an entry from the string-map.  It
+%  returns MagickTrue if the entry was found and deleted.
+%
+%  The format of the DeleteEntryFromStringMap method is:
+%
+%      MagickBooleanType DeleteEntryFromStringMap(StringMapInfo *string_map,
+%        const char *key)
+%
+%  A description of each parameter follows:
+%
+%    o string_map: the string-map info.
+%
+%    o key: the key.
+%
+*/
+MagickExport MagickBooleanType DeleteEntryFromStringMap(
+  StringMapInfo *string_map,const char *key)
+{
+  char
+    *value;
+
+  value=RemoveEntryFromStringMap(string_map,key);
+  if (value == (char *) NULL)
+    return(MagickFalse);
+  value=DestroyString(value);
+  return(MagickTrue);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   D e s t r o y S t r i n g M a p                                           %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  DestroyStringMap() frees the string-map and its entries.
+%
+%  The format of the DestroyStringMap method is:
+%
+%      StringMapInfo *DestroyStringMap(StringMapInfo *string_map)
+%
+%  A description of each parameter follows:
+%
+%    o string_map: the string-map info.
+%
+*/
+MagickExport StringMapInfo *DestroyStringMap(StringMapInfo *string_map)
+{
+  assert(string_map != (StringMapInfo *) NULL);
+  assert(string_map->signature == MagickSignature);
+  if (string_map->debug != MagickFalse)
+    (void) LogMagickEvent(TraceEvent,GetMagickModule(),"...");
+  (void) LockSemaphoreInfo(string_map->semaphore);
+  if (string_map->table != (TableInfo *) NULL)
+    string_map->table=(TableInfo *) RelinquishTable(string_map->table);
+  if (string_map->retired != (LinkedListInfo *) NULL)
+    string_map->retired=DestroyLinkedList(string_map->retired,RelinquishTable);
+  if (string_map->retired_keys != (LinkedListInfo *) NULL)
+    string_map->retired_keys=DestroyLinkedList(string_map->retired_keys,
+      RelinquishMagickMemory);
+  string_map->signature=(~MagickSignature);
+  (void) UnlockSemaphoreInfo(string_map->semaphore);
+  DestroySemaphoreInfo(&string_map->semaphore);
+  string_map=(StringMapInfo *) RelinquishMagickMemory(string_map);
+  return(string_map);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   G e t N e x t K e y I n S t r i n g M a p                                 %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  GetNextKeyInStringMap() gets the next key in the string-map, in key order.
+%
+%  The format of the GetNextKeyInStringMap method is:
+%
+%      const char *GetNextKeyInStringMap(StringMapInfo *string_map)
+%
+%  A description of each parameter follows:
+%
+%    o string_map: the string-map info.
+%
+*/
+MagickExport const char *GetNextKeyInStringMap(StringMapInfo *string_map)
+{
+  const char
+    *key;
+
+  assert(string_map != (StringMapInfo *) NULL);
+  assert(string_map->signature == MagickSignature);
+  if (string_map->debug != MagickFalse)
+    (void) LogMagickEvent(TraceEvent,GetMagickModule(),"...");
+  key=(const char *) NULL;
+  (void) LockSemaphoreInfo(string_map->semaphore);
+  if ((string_map->table != (TableInfo *) NULL) &&
+      (string_map->next < string_map->table->number_entries))
+    key=string_map->table->entries[string_map->next++].key;
+  (void) UnlockSemaphoreInfo(string_map->semaphore);
+  return(key);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   G e t N e x t V a l u e I n S t r i n g M a p                             %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  GetNextValueInStringMap() gets the next value in the string-map, in key
+%  order.
+%
+%  The format of the GetNextValueInStringMap method is:
+%
+%      const char *GetNextValueInStringMap(StringMapInfo *string_map)
+%
+%  A description of each parameter follows:
+%
+%    o string_map: the string-map info.
+%
+*/
+MagickExport const char *GetNextValueInStringMap(StringMapInfo *string_map)
+{
+  const char
+    *value;
+
+  assert(string_map != (StringMapInfo *) NULL);
+  assert(string_map->signature == MagickSignature);
+  if (string_map->debug != MagickFalse)
+    (void) LogMagickEvent(TraceEvent,GetMagickModule(),"...");
+  value=(const char *) NULL;
+  (void) LockSemaphoreInfo(string_map->semaphore);
+  if ((string_map->table != (TableInfo *) NULL) &&
+      (string_map->next < string_map->table->number_entries))
+    value=string_map->table->entries[string_map->next++].value;
+  (void) UnlockSemaphoreInfo(string_map->semaphore);
+  return(value);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   G e t N u m b e r O f E n t r i e s I n S t r i n g M a p                 %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  GetNumberOfEntriesInStringMap() returns the number of entries in the
+%  string-map.
+%
+%  The format of the GetNumberOfEntriesInStringMap method is:
+%
+%      unsigned long GetNumberOfEntriesInStringMap(StringMapInfo *string_map)
+%
+%  A description of each parameter follows:
+%
+%    o string_map: the string-map info.
+%
+*/
+MagickExport unsigned long GetNumberOfEntriesInStringMap(
+  StringMapInfo *string_map)
+{
+  unsigned long
+    number_entries;
+
+  assert(string_map != (StringMapInfo *) NULL);
+  assert(string_map->signature == MagickSignature);
+  if (string_map->debug != MagickFalse)
+    (void) LogMagickEvent(TraceEvent,GetMagickModule(),"...");
+  number_entries=0;
+  (void) LockSemaphoreInfo(string_map->semaphore);
+  if (string_map->table != (TableInfo *) NULL)
+    number_entries=string_map->table->number_entries;
+  (void) UnlockSemaphoreInfo(string_map->semaphore);
+  return(number_entries);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   G e t V a l u e F r o m S t r i n g M a p                                 %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  GetValueFromStringMap() gets the value associated with a key, or NULL if
+%  the key is not in the map.  The lookup does not take the string-map lock
+%  unless it races with an update.
+%
+%  The format of the GetValueFromStringMap method is:
+%
+%      const char *GetValueFromStringMap(StringMapInfo *string_map,
+%        const char *key)
+%
+%  A description of each parameter follows:
+%
+%    o string_map: the string-map info.
+%
+%    o key: the key.
+%
+*/
+
+static MagickBooleanType SearchStringMap(const EntryInfo *entries,
+  const unsigned long number_entries,const char *key,unsigned long *index)
+{
+  long
+    status;
+
+  register unsigned long
+    high,
+    low,
+    middle;
+
+  low=0;
+  high=number_entries;
+  while (low < high)
+  {
+    middle=low+((high-low) >> 1);
+    status=LocaleCompare(key,entries[middle].key);
+    if (status == 0)
+      {
+        *index=middle;
+        return(MagickTrue);
+      }
+    if (status < 0)
+      high=middle;
+    else
+      low=middle+1;
+  }
+  *index=low;
+  return(MagickFalse);
+}
+
+MagickExport const char *GetValueFromStringMap(StringMapInfo *string_map,
+  const char *key)
+{
+  const char
+    *value;
+
+  TableInfo
+    *table;
+
+  unsigned long
+    index;
+
+  assert(string_map != (StringMapInfo *) NULL);
+  assert(string_map->signature == MagickSignature);
+  if (string_map->debug != MagickFalse)
+    (void) LogMagickEvent(TraceEvent,GetMagickModule(),"...");
+  if (key == (const char *) NULL)
+    return((const char *) NULL);
+#if defined(StringMapMemoryBarrier)
+  {
+    EntryInfo
+      *entries;
+
+    unsigned long
+      number_entries,
+      sequence;
+
+    /*
+      Optimistic lookup: valid only if no writer intervened.  The reader count
+      keeps writers from reclaiming the tables and keys it may search.
+    */
+    (void) MagickAtomicAdd(&string_map->readers,1);
+    sequence=string_map->sequence;
+    StringMapMemoryBarrier();
+    if ((sequence & 0x01) == 0)
+      {
+        value=(const char *) NULL;
+        table=string_map->table;
+        if (table != (TableInfo *) NULL)
+          {
+            number_entries=table->number_entries;
+            StringMapMemoryBarrier();
+            entries=table->entries;
+            if (SearchStringMap(entries,number_entries,key,&index) !=
+                MagickFalse)
+              value=entries[index].value;
+          }
+        StringMapMemoryBarrier();
+        if (string_map->sequence == sequence)
+          {
+            (void) MagickAtomicAdd(&string_map->readers,-1);
+            return(value);
+          }
+      }
+    (void) MagickAtomicAdd(&string_map->readers,-1);
+  }
+#endif
+  value=(const char *) NULL;
+  (void) LockSemaphoreInfo(string_map->semaphore);
+  table=string_map->table;
+  if ((table != (TableInfo *) NULL) &&
+      (SearchStringMap(table->entries,table->number_entries,key,&index) !=
+       MagickFalse))
+    value=table->entries[index].value;
+  (void) UnlockSemaphoreInfo(string_map->semaphore);
+  return(value);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   N e w S t r i n g M a p                                                   %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  NewStringMap() returns a pointer to a StringMapInfo structure initialized
+%  to default values.  Keys compare without regard to case.
+%
+%  The format of the NewStringMap method is:
+%
+%      StringMapInfo *NewStringMap(void)
+%
+*/
+MagickExport StringMapInfo *NewStringMap(void)
+{
+  StringMapInfo
+    *string_map;
+
+  string_map=(StringMapInfo *) AcquireMagickMemory(sizeof(*string_map));
+  if (string_map == (StringMapInfo *) NULL)
+    ThrowFatalException(ResourceLimitFatalError,"MemoryAllocationFailed");
+  (void) ResetMagickMemory(string_map,0,sizeof(*string_map));
+  string_map->table=(TableInfo *) NULL;
+  string_map->retired=(LinkedListInfo *) NULL;
+  string_map->retired_keys=(LinkedListInfo *) NULL;
+  string_map->readers=0;
+  string_map->debug=IsEventLogging();
+  string_map->semaphore=AllocateSemaphoreInfo();
+  string_map->signature=MagickSignature;
+  return(string_map);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   P u t E n t r y I n S t r i n g M a p                                     %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  PutEntryInStringMap() puts a copy of a key and of its value in the
+%  string-map, replacing the value of an existing key.
+%
+%  The format of the PutEntryInStringMap method is:
+%
+%      MagickBooleanType PutEntryInStringMap(StringMapInfo *string_map,
+%        const char *key,const char *value)
+%
+%  A description of each parameter follows:
+%
+%    o string_map: the string-map info.
+%
+%    o key: the key.
+%
+%    o value: the value.
+%
+*/
+
+static TableInfo *GetStringMapTable(StringMapInfo *string_map,
+  const unsigned long number_entries)
+{
+  register long
+    i;
+
+  TableInfo
+    *table;
+
+  unsigned long
+    capacity;
+
+  /*
+    Return a table the map alone references, large enough for the specified
+    number of entries.  Otherwise the entries are copied to a new table and
+    the one they came from is retired.
+  */
+  table=string_map->table;
+  if ((table != (TableInfo *) NULL) && (table->reference_count == 1) &&
+      (number_entries <= table->capacity))
+    return(table);
+  capacity=MinimumStringMapCapacity;
+  if (table != (TableInfo *) NULL)
+    capacity=table->capacity;
+  while (capacity < number_entries)
+    capacity<<=1;
+  table=(TableInfo *) AcquireMagickMemory(sizeof(*table));
+  if (table == (TableInfo *) NULL)
+    return((TableInfo *) NULL);
+  (void) ResetMagickMemory(table,0,sizeof(*table));
+  table->entries=(EntryInfo *) AcquireQuantumMemory((size_t) capacity,
+    sizeof(*table->entries));
+  if (table->entries == (EntryInfo *) NULL)
+    {
+      table=(TableInfo *) RelinquishMagickMemory(table);
+      return((TableInfo *) NULL);
+    }
+  (void) ResetMagickMemory(table->entries,0,(size_t) capacity*
+    sizeof(*table->entries));
+  table->capacity=capacity;
+  table->owner=MagickTrue;
+  table->reference_count=1;
+  if (string_map->table != (TableInfo *) NULL)
+    {
+      if (RetireTable(string_map) == MagickFalse)
+        {
+          table->entries=(EntryInfo *) RelinquishMagickMemory(table->entries);
+          table=(TableInfo *) RelinquishMagickMemory(table);
+          return((TableInfo *) NULL);
+        }
+      table->number_entries=string_map->table->number_entries;
+      if (string_map->table->reference_count != 1)
+        for (i=0; i < (long) table->number_entries; i++)
+        {
+          table->entries[i].key=ConstantString(
+            string_map->table->entries[i].key);
+          table->entries[i].value=ConstantString(
+            string_map->table->entries[i].value);
+        }
+      else
+        {
+          /*
+            Move the strings: the retired table no longer owns them.
+          */
+          (void) CopyMagickMemory(table->entries,string_map->table->entries,
+            (size_t) table->number_entries*sizeof(*table->entries));
+          string_map->table->owner=MagickFalse;
+        }
+    }
+  BeginStringMapUpdate(string_map);
+  string_map->table=table;
+  EndStringMapUpdate(string_map);
+  return(table);
+}
+
+MagickExport MagickBooleanType PutEntryInStringMap(StringMapInfo *string_map,
+  const char *key,const char *value)
+{
+  char
+    *entry_key,
+    *entry_value,
+    *previous_value;
+
+  MagickBooleanType
+    status;
+
+  TableInfo
+    *table;
+
+  unsigned long
+    index,
+    number_entries;
+
+  assert(string_map != (StringMapInfo *) NULL);
+  assert(string_map->signature == MagickSignature);
+  if (string_map->debug != MagickFalse)
+    (void) LogMagickEvent(TraceEvent,GetMagickModule(),"...");
+  if ((key == (const char *) NULL) || (value == (const char *) NULL))
+    return(MagickFalse);
+  entry_value=ConstantString(value);
+  (void) LockSemaphoreInfo(string_map->semaphore);
+  number_entries=0;
+  status=MagickFalse;
+  table=string_map->table;
+  if (table != (TableInfo *) NULL)
+    {
+      number_entries=table->number_entries;
+      status=SearchStringMap(table->entries,number_entries,key,&index);
+    }
+  if (status == MagickFalse)
+    number_entries++;
+  table=GetStringMapTable(string_map,number_entries);
+  if (table == (TableInfo *) NULL)
+    {
+      (void) UnlockSemaphoreInfo(string_map->semaphore);
+      entry_value=DestroyString(entry_value);
+      return(MagickFalse);
+    }
+  if (SearchStringMap(table->entries,table->number_entries,key,&index) !=
+      MagickFalse)
+    {
+      /*
+        Replace the value of an existing key.
+      */
+      BeginStringMapUpdate(string_map);
+      previous_value=table->entries[index].value;
+      table->entries[index].value=entry_value;
+      EndStringMapUpdate(string_map);
+      ReclaimStringMap(string_map);
+      (void) UnlockSemaphoreInfo(string_map->semaphore);
+      previous_value=DestroyString(previous_value);
+      return(MagickTrue);
+    }
+  entry_key=ConstantString(key);
+  BeginStringMapUpdate(string_map);
+  (void) CopyMagickMemory(table->entries+index+1,table->entries+index,
+    (size_t) (table->number_entries-index)*sizeof(*table->entries));
+  table->entries[index].key=entry_key;
+  table->entries[index].value=entry_value;
+  table->number_entries++;
+  EndStringMapUpdate(string_map);
+  if (index < string_map->next)
+    string_map->next++;
+  ReclaimStringMap(string_map);
+  (void) UnlockSemaphoreInfo(string_map->semaphore);
+  return(MagickTrue);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   R e m o v e E n t r y F r o m S t r i n g M a p                           %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  RemoveEntryFromStringMap() removes an entry from the string-map and returns
+%  its value, or NULL if the key is not in the map.  The caller is responsible
+%  for freeing the value.
+%
+%  The format of the RemoveEntryFromStringMap method is:
+%
+%      char *RemoveEntryFromStringMap(StringMapInfo *string_map,
+%        const char *key)
+%
+%  A description of each parameter follows:
+%
+%    o string_map: the string-map info.
+%
+%    o key: the key.
+%
+*/
+MagickExport char *RemoveEntryFromStringMap(StringMapInfo *string_map,
+  const char *key)
+{
+  char
+    *value;
+
+  TableInfo
+    *table;
+
+  unsigned long
+    index;
+
+  assert(string_map != (StringMapInfo *) NULL);
+  assert(string_map->signature == MagickSignature);
+  if (string_map->debug != MagickFalse)
+    (void) LogMagickEvent(TraceEvent,GetMagickModule(),"...");
+  if (key == (const char *) NULL)
+    return((char *) NULL);
+  (void) LockSemaphoreInfo(string_map->semaphore);
+  table=string_map->table;
+  if ((table == (TableInfo *) NULL) ||
+      (SearchStringMap(table->entries,table->number_entries,key,&index) ==
+       MagickFalse))
+    {
+      (void) UnlockSemaphoreInfo(string_map->semaphore);
+      return((char *) NULL);
+    }
+  table=GetStringMapTable(string_map,table->number_entries);
+  if ((table == (TableInfo *) NULL) ||
+      (RetireKey(string_map,table->entries[index].key) == MagickFalse))
+    {
+      (void) UnlockSemaphoreInfo(string_map->semaphore);
+      return((char *) NULL);
+    }
+  BeginStringMapUpdate(string_map);
+  value=table->entries[index].value;
+  table->number_entries--;
+  (void) CopyMagickMemory(table->entries+index,table->entries+index+1,
+    (size_t) (table->number_entries-index)*sizeof(*table->entries));
+  table->entries[table->number_entries].key=(char *) NULL;
+  table->entries[table->number_entries].value=(char *) NULL;
+  EndStringMapUpdate(string_map);
+  if (index < string_map->next)
+    string_map->next--;
+  ReclaimStringMap(string_map);
+  (void) UnlockSemaphoreInfo(string_map->semaphore);
+  return(value);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   R e s e t S t r i n g M a p I t e r a t o r                               %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  ResetStringMapIterator() resets the string-map iterator.  Use it in
+%  conjunction with GetNextKeyInStringMap() or GetNextValueInStringMap() to
+%  iterate over all the entries in the string-map in key order.
+%
+%  The format of the ResetStringMapIterator method is:
+%
+%      void ResetStringMapIterator(StringMapInfo *string_map)
+%
+%  A description of each parameter follows:
+%
+%    o string_map: the string-map info.
+%
+*/
+MagickExport void ResetStringMapIterator(StringMapInfo *string_map)
+{
+  assert(string_map != (StringMapInfo *) NULL);
+  assert(string_map->signature == MagickSignature);
+  if (string_map->debug != MagickFalse)
+    (void) LogMagickEvent(TraceEvent,GetMagickModule(),"...");
+  (void) LockSemaphoreInfo(string_map->semaphore);
+  string_map->next=0;
+  (void) UnlockSemaphoreInfo(string_map->semaphore);
+}
@@ -0,0 +1,56 @@
+/*
+  Copyright 1999-2009 ImageMagick Studio LLC, a non-profit organization
+  dedicated to making software imaging solutions freely available.
+
+  You may not use this file except in compliance with the License.
+  obtain a copy of the License at
+
+    http://www.imagemagick.org/script/license.php
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  MagickCore string-map methods.
+*/
+#ifndef _MAGICKCORE_STRING_MAP_H
+#define _MAGICKCORE_STRING_MAP_H
+
+#if defined(__cplusplus) || defined(c_plusplus)
+extern "C" {
+#endif
+
+typedef struct _StringMapInfo
+  StringMapInfo;
+
+extern MagickExport char
+  *RemoveEntryFromStringMap(StringMapInfo *,const char *);
+
+extern MagickExport const char
+  *GetNextKeyInStringMap(StringMapInfo *),
+  *GetNextValueInStringMap(StringMapInfo *),
+  *GetValueFromStringMap(StringMapInfo *,const char *);
+
+extern MagickExport MagickBooleanType
+  DeleteEntryFromStringMap(StringMapInfo *,const char *),
+  PutEntryInStringMap(StringMapInfo *,const char *,const char *);
+
+extern MagickExport StringMapInfo
+  *CloneStringMap(StringMapInfo *),
+  *DestroyStringMap(StringMapInfo *),
+  *NewStringMap(void);
+
+extern MagickExport unsigned long
+  GetNumberOfEntriesInStringMap(StringMapInfo *);
+
+extern MagickExport void
+  ClearStringMap(StringMapInfo *),
+  ResetStringMapIterator(StringMapInfo *);
+
+#if defined(__cplusplus) || defined(c_plusplus)
+}
+#endif
+
+#endif
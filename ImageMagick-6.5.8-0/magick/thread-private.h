@@ -32,6 +32,63 @@ extern "C" {
   typedef unsigned long MagickMutexType;
 #endif
 
+/*
+  Cost classes of the operators that run rows in parallel: a point operator
+  touches each pixel once, a neighborhood operator reads a small kernel or
+  resamples, and an intensive operator evaluates a large kernel or an
+  expression per pixel.
+*/
+typedef enum
+{
+  UndefinedThreadCost,
+  PointThreadCost,
+  NeighborhoodThreadCost,
+  IntensiveThreadCost
+} ThreadCostType;
+
+/*
+  A dynamic schedule deals the rows of point operators to the threads in
+  small chunks; a static schedule gives each thread one band of rows, the
+  same band every loop, so the thread stays next to the pixel cache memory
+  it first touched.  Neighborhood and intensive operators always balance
+  their rows dynamically.
+*/
+typedef enum
+{
+  UndefinedThreadSchedule,
+  DynamicThreadSchedule,
+  StaticThreadSchedule
+} ThreadScheduleType;
+
+/*
+  Schedule a parallel loop of rows iterations, each columns pixels wide:
+  only as many threads as the work warrants, up to the thread limit.  The
+  schedule kind is fixed by the cost class, so the loop never depends on or
+  changes the OpenMP runtime schedule of the calling thread.
+*/
+#define magick_schedule(cost,columns,rows) \
+  magick_schedule_ ## cost(columns,rows) \
+  num_threads(GetMagickThreadCount(cost,columns,rows))
+#define magick_schedule_PointThreadCost(columns,rows) \
+  schedule(static,GetMagickThreadChunk(PointThreadCost,columns,rows))
+#define magick_schedule_NeighborhoodThreadCost(columns,rows) \
+  schedule(dynamic,GetMagickThreadChunk(NeighborhoodThreadCost,columns,rows))
+#define magick_schedule_IntensiveThreadCost(columns,rows) \
+  schedule(dynamic,GetMagickThreadChunk(IntensiveThreadCost,columns,rows))
+
+extern MagickExport ThreadScheduleType
+  GetMagickThreadScheduleType(void);
+
+extern MagickExport unsigned long
+  GetMagickThreadChunk(const ThreadCostType,const MagickSizeType,
+    const MagickSizeType),
+  GetMagickThreadCount(const ThreadCostType,const MagickSizeType,
+    const MagickSizeType);
+
+extern MagickExport void
+  SetMagickThreadMinArea(const MagickSizeType),
+  SetMagickThreadScheduleType(const ThreadScheduleType);
+
 static inline MagickThreadType GetMagickThreadId(void)
 {
 #if defined(MAGICKCORE_HAVE_PTHREAD)
@@ -82,6 +139,34 @@ static inline MagickBooleanType IsMagickThreadEqual(const MagickThreadType id)
   return(MagickFalse);
 }
 
+/*
+  Atomic methods.  Callers must serialize with a semaphore when
+  MagickAtomicSupport is not defined.
+*/
+#if defined(__GNUC__) && ((__GNUC__ > 4) || \
+    ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 1)))
+#define MagickAtomicSupport  1
+
+static inline MagickOffsetType MagickAtomicAdd(volatile MagickOffsetType *value,
+  const MagickOffsetType delta)
+{
+  return(__sync_add_and_fetch(value,delta));
+}
+
+static inline MagickOffsetType MagickAtomicExchange(
+  volatile MagickOffsetType *value,const MagickOffsetType exchange)
+{
+  MagickOffsetType
+    previous;
+
+  do
+  {
+    previous=(*value);
+  } while (__sync_bool_compare_and_swap(value,previous,exchange) == 0);
+  return(previous);
+}
+#endif
+
 /*
   Lightweight OpenMP methods.
 */
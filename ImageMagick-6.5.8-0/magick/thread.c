@@ -43,6 +43,191 @@
 #include "magick/thread_.h"
 #include "magick/thread-private.h"
 
+/*
+  Define declarations.
+*/
+#define ThreadMinArea  16384UL
+
+/*
+  Global declarations.
+*/
+static MagickSizeType
+  thread_min_area = ThreadMinArea;
+
+static ThreadScheduleType
+  thread_schedule = DynamicThreadSchedule;
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   G e t M a g i c k T h r e a d C h u n k                                   %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  GetMagickThreadChunk() returns the number of iterations a thread claims at
+%  a time from a loop scheduled with GetMagickThreadCount().  Each thread
+%  claims several chunks so the team stays balanced when rows differ in cost,
+%  more of them as the operator grows more expensive.  With the static
+%  schedule each thread of a point operator instead takes a single band of
+%  rows.
+%
+%  The format of the GetMagickThreadChunk method is:
+%
+%      unsigned long GetMagickThreadChunk(const ThreadCostType cost,
+%        const MagickSizeType columns,const MagickSizeType rows)
+%
+%  A description of each parameter follows:
+%
+%    o cost: the cost class of the operator.
+%
+%    o columns: the pixels each iteration processes.
+%
+%    o rows: the number of iterations.
+%
+*/
+MagickExport unsigned long GetMagickThreadChunk(const ThreadCostType cost,
+  const MagickSizeType columns,const MagickSizeType rows)
+{
+  MagickSizeType
+    chunk,
+    chunks;
+
+  unsigned long
+    threads;
+
+  threads=GetMagickThreadCount(cost,columns,rows);
+  if (threads <= 1)
+    return(rows == 0 ? 1UL : (unsigned long) rows);
+  if ((cost == PointThreadCost) && (thread_schedule == StaticThreadSchedule))
+    return((unsigned long) ((rows+threads-1)/threads));
+  switch (cost)
+  {
+    case NeighborhoodThreadCost:
+    {
+      chunks=8*threads;
+      break;
+    }
+    case IntensiveThreadCost:
+    {
+      chunks=16*threads;
+      break;
+    }
+    default:
+    {
+      chunks=4*threads;
+      break;
+    }
+  }
+  chunk=rows/chunks;
+  if (chunk == 0)
+    chunk=1;
+  return((unsigned long) chunk);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   G e t M a g i c k T h r e a d C o u n t                                   %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  GetMagickThreadCount() returns the number of threads to run a parallel loop
+%  with.  The work, the pixels the loop processes weighted by the cost class
+%  of the operator, must reach the thread:min-area policy for every thread
+%  started, so small images run in the calling thread and large ones use up
+%  to the thread resource limit.  A thread:min-area of zero always starts the
+%  full team.
+%
+%  The format of the GetMagickThreadCount method is:
+%
+%      unsigned long GetMagickThreadCount(const ThreadCostType cost,
+%        const MagickSizeType columns,const MagickSizeType rows)
+%
+%  A description of each parameter follows:
+%
+%    o cost: the cost class of the operator.
+%
+%    o columns: the pixels each iteration processes.
+%
+%    o rows: the number of iterations.
+%
+*/
+MagickExport unsigned long GetMagickThreadCount(const ThreadCostType cost,
+  const MagickSizeType columns,const MagickSizeType rows)
+{
+  MagickSizeType
+    threads,
+    work;
+
+  unsigned long
+    maximum_threads;
+
+  maximum_threads=1UL;
+#if defined(MAGICKCORE_OPENMP_SUPPORT) && (_OPENMP >= 200203)
+  maximum_threads=(unsigned long) omp_get_max_threads();
+#endif
+  if (maximum_threads <= 1)
+    return(1UL);
+  work=columns*rows;
+  switch (cost)
+  {
+    case NeighborhoodThreadCost:
+    {
+      work*=4;
+      break;
+    }
+    case IntensiveThreadCost:
+    {
+      work*=16;
+      break;
+    }
+    default:
+      break;
+  }
+  threads=maximum_threads;
+  if (thread_min_area != 0)
+    threads=work/thread_min_area;
+  if (threads > maximum_threads)
+    threads=maximum_threads;
+  if (threads > rows)
+    threads=rows;
+  if (threads == 0)
+    threads=1;
+  return((unsigned long) threads);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   G e t M a g i c k T h r e a d S c h e d u l e T y p e                     %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  GetMagickThreadScheduleType() returns how parallel loops divide their rows
+%  among threads.
+%
+%  The format of the GetMagickThreadScheduleType method is:
+%
+%      ThreadScheduleType GetMagickThreadScheduleType(void)
+%
+*/
+MagickExport ThreadScheduleType GetMagickThreadScheduleType(void)
+{
+  return(thread_schedule);
+}
+
 /*
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 %                                                                             %
@@ -179,3 +364,62 @@ MagickExport MagickBooleanType MagickSetThreadValue(MagickThreadKey key,
   return(MagickTrue);
 #endif
 }
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   S e t M a g i c k T h r e a d M i n A r e a                               %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  SetMagickThreadMinArea() sets the work, in pixels weighted by operator
+%  cost, that each thread of a parallel loop must have before the thread is
+%  started.  Zero starts the full team regardless of image size.
+%
+%  The format of the SetMagickThreadMinArea method is:
+%
+%      void SetMagickThreadMinArea(const MagickSizeType area)
+%
+%  A description of each parameter follows:
+%
+%    o area: the minimum work per thread.
+%
+*/
+MagickExport void SetMagickThreadMinArea(const MagickSizeType area)
+{
+  thread_min_area=area;
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   S e t M a g i c k T h r e a d S c h e d u l e T y p e                     %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  SetMagickThreadScheduleType() sets how the parallel loops of point
+%  operators divide their rows among threads: in small chunks dealt to the
+%  threads in turn, or statically, in one band of rows per thread.
+%
+%  The format of the SetMagickThreadScheduleType method is:
+%
+%      void SetMagickThreadScheduleType(const ThreadScheduleType schedule)
+%
+%  A description of each parameter follows:
+%
+%    o schedule: the schedule type.
+%
+*/
+MagickExport void SetMagickThreadScheduleType(const ThreadScheduleType schedule)
+{
+  if (schedule != UndefinedThreadSchedule)
+    thread_schedule=schedule;
+}
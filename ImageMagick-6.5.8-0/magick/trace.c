@@ -0,0 +1,694 @@
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%                      TTTTT  RRRR    AAA    CCCC  EEEEE                      %
+%                        T    R   R  A   A  C      E                          %
+%                        T    RRRR   AAAAA  C      EEE                        %
+%                        T    R R    A   A  C      E                          %
+%                        T    R  R   A   A   CCCC  EEEEE                      %
+%                                                                             %
+%                                                                             %
+%                          MagickCore Trace Methods                           %
+%                                                                             %
+%                              Software Design                                %
+%                                John Cristy                                  %
+%                               November 2009                                 %
+%                                                                             %
+%                                                                             %
+%  Copyright 1999-2009 ImageMagick Studio LLC, a non-profit organization      %
+%  dedicated to making software imaging solutions freely available.           %
+%                                                                             %
+%  You may not use this file except in compliance with the License.  You may  %
+%  obtain a copy of the License at                                            %
+%                                                                             %
+%    http://www.imagemagick.org/script/license.php                            %
+%                                                                             %
+%  Unless required by applicable law or agreed to in writing, software        %
+%  distributed under the License is distributed on an "AS IS" BASIS,          %
+%  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   %
+%  See the License for the specific language governing permissions and        %
+%  limitations under the License.                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  This module records timed events from the hot paths of MagickCore: image
+%  operators, coders, the pixel cache, resources and OpenMP regions.  Unlike
+%  the log, events are not formatted when they occur.  Each thread appends
+%  fixed-size binary records to its own ring buffer, without locking, and the
+%  buffers are exported in the Chrome trace-event JSON format on request, or
+%  at exit when the MAGICK_TRACE environment variable names a file.  When an
+%  event type is not enabled, recording it costs a single test of the mask.
+%  The buffer of a thread that exits is handed on to the next thread that
+%  records an event, so short-lived threads do not each hold on to a buffer.
+%
+*/
+
+/*
+  Include declarations.
+*/
+#include "magick/studio.h"
+#include "magick/exception.h"
+#include "magick/exception-private.h"
+#include "magick/hashmap.h"
+#include "magick/log.h"
+#include "magick/memory_.h"
+#include "magick/option.h"
+#include "magick/semaphore.h"
+#include "magick/string_.h"
+#include "magick/thread_.h"
+#include "magick/thread-private.h"
+#include "magick/trace.h"
+#include "magick/utility.h"
+
+/*
+  Define declarations.
+*/
+#define TraceBufferExtent  8192UL  /* must be a power of 2 */
+
+/*
+  Typedef declarations.
+*/
+typedef struct _TraceRecord
+{
+  MagickSizeType
+    timestamp,
+    value;
+
+  const char
+    *name;
+
+  TraceType
+    type;
+
+  TracePhase
+    phase;
+
+  char
+    detail[32];
+} TraceRecord;
+
+typedef struct _TraceBuffer
+{
+  TraceRecord
+    *records;
+
+  volatile MagickSizeType
+    count;
+
+  unsigned long
+    id;
+
+  MagickBooleanType
+    active;
+} TraceBuffer;
+
+/*
+  Global declarations.
+*/
+static char
+  *trace_filename = (char *) NULL;
+
+static LinkedListInfo
+  *trace_buffers = (LinkedListInfo *) NULL;
+
+static MagickBooleanType
+  instantiate_key = MagickFalse;
+
+static MagickSizeType
+  trace_epoch = 0;
+
+static MagickThreadKey
+  trace_key;
+
+static SemaphoreInfo
+  *trace_semaphore = (SemaphoreInfo *) NULL;
+
+static volatile TraceType
+  trace_mask = NoTrace;
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   G e t M a g i c k T r a c e M a s k                                       %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  GetMagickTraceMask() returns the types of event currently traced.
+%
+%  The format of the GetMagickTraceMask method is:
+%
+%      TraceType GetMagickTraceMask(void)
+%
+*/
+MagickExport TraceType GetMagickTraceMask(void)
+{
+  return(trace_mask);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   I s M a g i c k T r a c e E n a b l e d                                   %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  IsMagickTraceEnabled() returns MagickTrue if events of the specified type
+%  are traced.  Use it to skip preparing an event detail that would be
+%  discarded.
+%
+%  The format of the IsMagickTraceEnabled method is:
+%
+%      MagickBooleanType IsMagickTraceEnabled(const TraceType type)
+%
+%  A description of each parameter follows:
+%
+%    o type: the trace type.
+%
+*/
+MagickExport MagickBooleanType IsMagickTraceEnabled(const TraceType type)
+{
+  return((trace_mask & type) != 0 ? MagickTrue : MagickFalse);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   R e s e t M a g i c k T r a c e                                           %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  ResetMagickTrace() discards the events recorded so far.  Call it while no
+%  other thread is recording events.
+%
+%  The format of the ResetMagickTrace method is:
+%
+%      void ResetMagickTrace(void)
+%
+*/
+MagickExport void ResetMagickTrace(void)
+{
+  TraceBuffer
+    *trace_buffer;
+
+  if (trace_buffers == (LinkedListInfo *) NULL)
+    return;
+  (void) LockSemaphoreInfo(trace_semaphore);
+  ResetLinkedListIterator(trace_buffers);
+  trace_buffer=(TraceBuffer *) GetNextValueInLinkedList(trace_buffers);
+  while (trace_buffer != (TraceBuffer *) NULL)
+  {
+    trace_buffer->count=0;
+    trace_buffer=(TraceBuffer *) GetNextValueInLinkedList(trace_buffers);
+  }
+  (void) UnlockSemaphoreInfo(trace_semaphore);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   S e t M a g i c k T r a c e M a s k                                       %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  SetMagickTraceMask() accepts a list that determines which events to trace,
+%  for example "Coder,Operator".  All other events are ignored.  By default,
+%  no events are traced.  This method returns the new trace mask.
+%
+%  The format of the SetMagickTraceMask method is:
+%
+%      TraceType SetMagickTraceMask(const char *events)
+%
+%  A description of each parameter follows:
+%
+%    o events: the events to trace.
+%
+*/
+MagickExport TraceType SetMagickTraceMask(const char *events)
+{
+  long
+    option;
+
+  option=ParseMagickOption(MagickTraceOptions,MagickTrue,events);
+  if (option == -1)
+    option=(long) NoTrace;
+  trace_mask=(TraceType) option;
+  return(trace_mask);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
++   T r a c e C o m p o n e n t G e n e s i s                                 %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  TraceComponentGenesis() instantiates the trace component.  If the
+%  MAGICK_TRACE environment variable is set, events are traced and written to
+%  the file it names when MagickCore terminates.  MAGICK_TRACE_EVENTS selects
+%  the events to trace; the default is all of them.
+%
+%  The format of the TraceComponentGenesis method is:
+%
+%      MagickBooleanType TraceComponentGenesis(void)
+%
+*/
+
+static inline MagickSizeType GetTraceTimestamp(void)
+{
+#if defined(CLOCK_MONOTONIC)
+  struct timespec
+    timestamp;
+
+  (void) clock_gettime(CLOCK_MONOTONIC,&timestamp);
+  return((MagickSizeType) timestamp.tv_sec*1000000000UL+timestamp.tv_nsec);
+#elif defined(__WINDOWS__)
+  LARGE_INTEGER
+    counter,
+    frequency;
+
+  (void) QueryPerformanceFrequency(&frequency);
+  (void) QueryPerformanceCounter(&counter);
+  return((MagickSizeType) ((double) counter.QuadPart*1.0e9/
+    frequency.QuadPart));
+#elif defined(MAGICKCORE_HAVE_GETTIMEOFDAY)
+  struct timeval
+    timestamp;
+
+  (void) gettimeofday(&timestamp,(struct timezone *) NULL);
+  return((MagickSizeType) timestamp.tv_sec*1000000000UL+
+    timestamp.tv_usec*1000UL);
+#else
+  return((MagickSizeType) time((time_t *) NULL)*1000000000UL);
+#endif
+}
+
+#if defined(MAGICKCORE_HAVE_PTHREAD)
+static void ReleaseTraceBuffer(void *trace_buffer)
+{
+  /*
+    The thread is exiting; its events stay in the buffer until the next
+    thread takes it over.
+  */
+  (void) LockSemaphoreInfo(trace_semaphore);
+  if (trace_buffers != (LinkedListInfo *) NULL)
+    ((TraceBuffer *) trace_buffer)->active=MagickFalse;
+  (void) UnlockSemaphoreInfo(trace_semaphore);
+}
+#endif
+
+MagickExport MagickBooleanType TraceComponentGenesis(void)
+{
+  char
+    *events;
+
+  AcquireSemaphoreInfo(&trace_semaphore);
+#if defined(MAGICKCORE_HAVE_PTHREAD)
+  instantiate_key=pthread_key_create(&trace_key,ReleaseTraceBuffer) == 0 ?
+    MagickTrue : MagickFalse;
+#else
+  instantiate_key=MagickCreateThreadKey(&trace_key);
+#endif
+  trace_buffers=NewLinkedList(0);
+  trace_epoch=GetTraceTimestamp();
+  trace_filename=GetEnvironmentValue("MAGICK_TRACE");
+  if (trace_filename == (char *) NULL)
+    return(MagickTrue);
+  events=GetEnvironmentValue("MAGICK_TRACE_EVENTS");
+  if (events == (char *) NULL)
+    trace_mask=AllTrace;
+  else
+    {
+      (void) SetMagickTraceMask(events);
+      events=DestroyString(events);
+    }
+  return(MagickTrue);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
++   T r a c e C o m p o n e n t T e r m i n u s                               %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  TraceComponentTerminus() writes the trace named by MAGICK_TRACE, if any,
+%  and destroys the trace component.
+%
+%  The format of the TraceComponentTerminus method is:
+%
+%      TraceComponentTerminus(void)
+%
+*/
+
+static void *DestroyTraceBuffer(void *trace_buffer)
+{
+  register TraceBuffer
+    *p;
+
+  p=(TraceBuffer *) trace_buffer;
+  p->records=(TraceRecord *) RelinquishMagickMemory(p->records);
+  return(RelinquishMagickMemory(p));
+}
+
+MagickExport void TraceComponentTerminus(void)
+{
+  trace_mask=NoTrace;
+  if (trace_filename != (char *) NULL)
+    {
+      ExceptionInfo
+        *exception;
+
+      exception=AcquireExceptionInfo();
+      (void) WriteMagickTrace(trace_filename,exception);
+      CatchException(exception);
+      exception=DestroyExceptionInfo(exception);
+      trace_filename=DestroyString(trace_filename);
+    }
+  if (trace_semaphore == (SemaphoreInfo *) NULL)
+    AcquireSemaphoreInfo(&trace_semaphore);
+  (void) LockSemaphoreInfo(trace_semaphore);
+  if (trace_buffers != (LinkedListInfo *) NULL)
+    trace_buffers=DestroyLinkedList(trace_buffers,DestroyTraceBuffer);
+  if (instantiate_key != MagickFalse)
+    {
+      (void) MagickDeleteThreadKey(trace_key);
+      instantiate_key=MagickFalse;
+    }
+  (void) UnlockSemaphoreInfo(trace_semaphore);
+  DestroySemaphoreInfo(&trace_semaphore);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   T r a c e M a g i c k E v e n t                                           %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  TraceMagickEvent() records an event in the calling thread's trace buffer.
+%  Begin and end events bracket a timed span and must nest within a thread;
+%  instant events mark a point in time; counter events plot their value.  When
+%  a buffer is full, the oldest events are overwritten.
+%
+%  The format of the TraceMagickEvent method is:
+%
+%      void TraceMagickEvent(const TraceType type,const TracePhase phase,
+%        const char *name,const char *detail,const MagickSizeType value)
+%
+%  A description of each parameter follows:
+%
+%    o type: the trace type.
+%
+%    o phase: the trace phase.
+%
+%    o name: the event name.  Only the pointer is recorded, so it must be a
+%      string constant.
+%
+%    o detail: an optional qualifier of the name, for example a coder or an
+%      option.  It is copied and truncated to 31 characters.
+%
+%    o value: a value associated with the event.
+%
+*/
+
+static TraceBuffer *AcquireTraceBuffer(void)
+{
+  TraceBuffer
+    *trace_buffer;
+
+  if (instantiate_key == MagickFalse)
+    return((TraceBuffer *) NULL);
+  trace_buffer=(TraceBuffer *) MagickGetThreadValue(trace_key);
+  if (trace_buffer != (TraceBuffer *) NULL)
+    return(trace_buffer);
+  /*
+    Take over the buffer of a thread that exited, if any.
+  */
+  (void) LockSemaphoreInfo(trace_semaphore);
+  ResetLinkedListIterator(trace_buffers);
+  trace_buffer=(TraceBuffer *) GetNextValueInLinkedList(trace_buffers);
+  while ((trace_buffer != (TraceBuffer *) NULL) &&
+         (trace_buffer->active != MagickFalse))
+    trace_buffer=(TraceBuffer *) GetNextValueInLinkedList(trace_buffers);
+  if (trace_buffer == (TraceBuffer *) NULL)
+    {
+      trace_buffer=(TraceBuffer *) AcquireMagickMemory(sizeof(*trace_buffer));
+      if (trace_buffer == (TraceBuffer *) NULL)
+        {
+          (void) UnlockSemaphoreInfo(trace_semaphore);
+          return((TraceBuffer *) NULL);
+        }
+      (void) ResetMagickMemory(trace_buffer,0,sizeof(*trace_buffer));
+      trace_buffer->records=(TraceRecord *) AcquireQuantumMemory(
+        TraceBufferExtent,sizeof(*trace_buffer->records));
+      if (trace_buffer->records == (TraceRecord *) NULL)
+        {
+          (void) UnlockSemaphoreInfo(trace_semaphore);
+          trace_buffer=(TraceBuffer *) RelinquishMagickMemory(trace_buffer);
+          return((TraceBuffer *) NULL);
+        }
+      trace_buffer->id=GetNumberOfElementsInLinkedList(trace_buffers)+1;
+      (void) AppendValueToLinkedList(trace_buffers,trace_buffer);
+    }
+  trace_buffer->active=MagickTrue;
+  (void) UnlockSemaphoreInfo(trace_semaphore);
+  (void) MagickSetThreadValue(trace_key,trace_buffer);
+  return(trace_buffer);
+}
+
+MagickExport void TraceMagickEvent(const TraceType type,const TracePhase phase,
+  const char *name,const char *detail,const MagickSizeType value)
+{
+  register TraceRecord
+    *p;
+
+  TraceBuffer
+    *trace_buffer;
+
+  if ((trace_mask & type) == 0)
+    return;
+  trace_buffer=AcquireTraceBuffer();
+  if (trace_buffer == (TraceBuffer *) NULL)
+    return;
+  p=trace_buffer->records+(trace_buffer->count & (TraceBufferExtent-1));
+  p->timestamp=GetTraceTimestamp();
+  p->value=value;
+  p->name=name;
+  p->type=type;
+  p->phase=phase;
+  *p->detail='\0';
+  if (detail != (const char *) NULL)
+    (void) CopyMagickString(p->detail,detail,sizeof(p->detail));
+  trace_buffer->count++;
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   W r i t e M a g i c k T r a c e                                           %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  WriteMagickTrace() writes the events recorded so far to a file in the
+%  Chrome trace-event JSON format, as read by chrome://tracing and similar
+%  viewers.  A filename of "-" writes to standard output.  Call it while no
+%  other thread is recording events.  Once a buffer wraps, end events whose
+%  begin event was overwritten are left out, so every end event closes a
+%  span.
+%
+%  The format of the WriteMagickTrace method is:
+%
+%      MagickBooleanType WriteMagickTrace(const char *filename,
+%        ExceptionInfo *exception)
+%
+%  A description of each parameter follows:
+%
+%    o filename: the trace filename.
+%
+%    o exception: return any errors or warnings in this structure.
+%
+*/
+
+static void WriteTraceString(FILE *file,const char *string)
+{
+  register const unsigned char
+    *p;
+
+  (void) fputc('"',file);
+  for (p=(const unsigned char *) string; *p != '\0'; p++)
+  {
+    if ((*p == '"') || (*p == '\\'))
+      (void) fprintf(file,"\\%c",*p);
+    else
+      if (*p < 0x20)
+        (void) fprintf(file,"\\u%04x",(unsigned int) *p);
+      else
+        (void) fputc((int) *p,file);
+  }
+  (void) fputc('"',file);
+}
+
+static const char *TraceTypeToString(const TraceType type)
+{
+  switch (type)
+  {
+    case CacheTrace: return("cache");
+    case CoderTrace: return("coder");
+    case OpenMPTrace: return("openmp");
+    case OperatorTrace: return("operator");
+    case ResourceTrace: return("resource");
+    default: break;
+  }
+  return("undefined");
+}
+
+MagickExport MagickBooleanType WriteMagickTrace(const char *filename,
+  ExceptionInfo *exception)
+{
+  char
+    name[MaxTextExtent];
+
+  const char
+    *phase;
+
+  FILE
+    *file;
+
+  long
+    pid;
+
+  MagickBooleanType
+    status;
+
+  MagickSizeType
+    count,
+    first;
+
+  register const TraceRecord
+    *p;
+
+  register MagickSizeType
+    i;
+
+  TraceBuffer
+    *trace_buffer;
+
+  unsigned long
+    depth,
+    events;
+
+  assert(filename != (const char *) NULL);
+  assert(exception != (ExceptionInfo *) NULL);
+  if (trace_buffers == (LinkedListInfo *) NULL)
+    return(MagickFalse);
+  if (LocaleCompare(filename,"-") == 0)
+    file=stdout;
+  else
+    file=fopen(filename,"w");
+  if (file == (FILE *) NULL)
+    {
+      ThrowFileException(exception,FileOpenError,"UnableToOpenFile",filename);
+      return(MagickFalse);
+    }
+  pid=(long) getpid();
+  events=0;
+  (void) fprintf(file,"{\"traceEvents\":[");
+  (void) LockSemaphoreInfo(trace_semaphore);
+  ResetLinkedListIterator(trace_buffers);
+  trace_buffer=(TraceBuffer *) GetNextValueInLinkedList(trace_buffers);
+  while (trace_buffer != (TraceBuffer *) NULL)
+  {
+    count=trace_buffer->count;
+    first=0;
+    if (count > TraceBufferExtent)
+      first=count-TraceBufferExtent;
+    depth=0;
+    for (i=first; i < count; i++)
+    {
+      p=trace_buffer->records+(i & (TraceBufferExtent-1));
+      if (p->phase == BeginTracePhase)
+        depth++;
+      if (p->phase == EndTracePhase)
+        {
+          /*
+            Skip an end event whose begin event was overwritten.
+          */
+          if (depth == 0)
+            continue;
+          depth--;
+        }
+      switch (p->phase)
+      {
+        case BeginTracePhase: phase="B"; break;
+        case EndTracePhase: phase="E"; break;
+        case CounterTracePhase: phase="C"; break;
+        default: phase="i"; break;
+      }
+      if (*p->detail == '\0')
+        (void) CopyMagickString(name,p->name,MaxTextExtent);
+      else
+        if (p->phase == CounterTracePhase)
+          (void) CopyMagickString(name,p->detail,MaxTextExtent);
+        else
+          (void) FormatMagickString(name,MaxTextExtent,"%s %s",p->name,
+            p->detail);
+      (void) fprintf(file,"%s\n{\"name\":",events != 0 ? "," : "");
+      WriteTraceString(file,name);
+      (void) fprintf(file,",\"cat\":\"%s\",\"ph\":\"%s\",\"ts\":%.3f,"
+        "\"pid\":%ld,\"tid\":%lu",TraceTypeToString(p->type),phase,
+        (double) (p->timestamp-trace_epoch)/1000.0,pid,trace_buffer->id);
+      if (p->phase == InstantTracePhase)
+        (void) fprintf(file,",\"s\":\"t\"");
+      (void) fprintf(file,",\"args\":{\"value\":%.20g}}",(double) p->value);
+      events++;
+    }
+    trace_buffer=(TraceBuffer *) GetNextValueInLinkedList(trace_buffers);
+  }
+  (void) UnlockSemaphoreInfo(trace_semaphore);
+  (void) fprintf(file,"\n],\"displayTimeUnit\":\"ns\"}\n");
+  status=ferror(file) == 0 ? MagickTrue : MagickFalse;
+  if (file != stdout)
+    {
+      if (fclose(file) != 0)
+        status=MagickFalse;
+    }
+  else
+    (void) fflush(file);
+  if (status == MagickFalse)
+    ThrowFileException(exception,FileOpenError,"UnableToWriteFile",filename);
+  return(status);
+}
@@ -0,0 +1,67 @@
+/*
+  Copyright 1999-2009 ImageMagick Studio LLC, a non-profit organization
+  dedicated to making software imaging solutions freely available.
+
+  You may not use this file except in compliance with the License.
+  obtain a copy of the License at
+
+    http://www.imagemagick.org/script/license.php
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  MagickCore trace methods.
+*/
+#ifndef _MAGICKCORE_TRACE_H
+#define _MAGICKCORE_TRACE_H
+
+#if defined(__cplusplus) || defined(c_plusplus)
+extern "C" {
+#endif
+
+#include "magick/exception.h"
+
+typedef enum
+{
+  UndefinedTrace,
+  NoTrace = 0x00000,
+  CacheTrace = 0x00001,
+  CoderTrace = 0x00002,
+  OpenMPTrace = 0x00004,
+  OperatorTrace = 0x00008,
+  ResourceTrace = 0x00010,
+  AllTrace = 0x7fffffff
+} TraceType;
+
+typedef enum
+{
+  UndefinedTracePhase,
+  BeginTracePhase,
+  EndTracePhase,
+  InstantTracePhase,
+  CounterTracePhase
+} TracePhase;
+
+extern MagickExport MagickBooleanType
+  IsMagickTraceEnabled(const TraceType),
+  TraceComponentGenesis(void),
+  WriteMagickTrace(const char *,ExceptionInfo *);
+
+extern MagickExport TraceType
+  GetMagickTraceMask(void),
+  SetMagickTraceMask(const char *);
+
+extern MagickExport void
+  ResetMagickTrace(void),
+  TraceComponentTerminus(void),
+  TraceMagickEvent(const TraceType,const TracePhase,const char *,const char *,
+    const MagickSizeType);
+
+#if defined(__cplusplus) || defined(c_plusplus)
+}
+#endif
+
+#endif
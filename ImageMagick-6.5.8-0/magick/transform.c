@@ -62,6 +62,7 @@
 #include "magick/resize.h"
 #include "magick/statistic.h"
 #include "magick/string_.h"
+#include "magick/thread-private.h"
 #include "magick/transform.h"
 
 /*
@@ -586,7 +587,8 @@ MagickExport Image *CropImage(const Image *image,const RectangleInfo *geometry,
   image_view=AcquireCacheView(image);
   crop_view=AcquireCacheView(crop_image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(PointThreadCost,crop_image->columns,crop_image->rows)
 #endif
   for (y=0; y < (long) crop_image->rows; y++)
   {
@@ -714,7 +716,8 @@ MagickExport Image *ExcerptImage(const Image *image,
   image_view=AcquireCacheView(image);
   excerpt_view=AcquireCacheView(excerpt_image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(PointThreadCost,excerpt_image->columns,excerpt_image->rows)
 #endif
   for (y=0; y < (long) excerpt_image->rows; y++)
   {
@@ -895,7 +898,8 @@ MagickExport Image *FlipImage(const Image *image,ExceptionInfo *exception)
   image_view=AcquireCacheView(image);
   flip_view=AcquireCacheView(flip_image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(PointThreadCost,flip_image->columns,flip_image->rows)
 #endif
   for (y=0; y < (long) flip_image->rows; y++)
   {
@@ -1013,7 +1017,8 @@ MagickExport Image *FlopImage(const Image *image,ExceptionInfo *exception)
   image_view=AcquireCacheView(image);
   flop_view=AcquireCacheView(flop_image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(PointThreadCost,flop_image->columns,flop_image->rows)
 #endif
   for (y=0; y < (long) flop_image->rows; y++)
   {
@@ -1124,7 +1129,8 @@ static inline MagickBooleanType CopyImageRegion(Image *destination,
   source_view=AcquireCacheView(source);
   destination_view=AcquireCacheView(destination);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(status)
+  #pragma omp parallel for shared(status) \
+    magick_schedule(PointThreadCost,columns,rows)
 #endif
   for (y=0; y < (long) rows; y++)
   {
@@ -1439,7 +1445,8 @@ MagickExport Image *SpliceImage(const Image *image,
   image_view=AcquireCacheView(image);
   splice_view=AcquireCacheView(splice_image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(PointThreadCost,splice_image->columns,splice_geometry.y)
 #endif
   for (y=0; y < (long) splice_geometry.y; y++)
   {
@@ -1514,7 +1521,8 @@ MagickExport Image *SpliceImage(const Image *image,
       }
   }
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(PointThreadCost,splice_image->columns,splice_image->rows)
 #endif
   for (y=(long) (splice_geometry.y+splice_geometry.height);
        y < (long) splice_image->rows; y++)
@@ -1876,7 +1884,8 @@ MagickExport Image *TransposeImage(const Image *image,ExceptionInfo *exception)
   image_view=AcquireCacheView(image);
   transpose_view=AcquireCacheView(transpose_image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
   for (y=0; y < (long) image->rows; y++)
   {
@@ -2004,7 +2013,8 @@ MagickExport Image *TransverseImage(const Image *image,ExceptionInfo *exception)
   image_view=AcquireCacheView(image);
   transverse_view=AcquireCacheView(transverse_image);
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(PointThreadCost,image->columns,image->rows)
 #endif
   for (y=0; y < (long) image->rows; y++)
   {
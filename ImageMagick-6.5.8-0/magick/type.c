@@ -112,6 +112,9 @@ static const char
 /*
   Static declarations.
 */
+static HashmapInfo
+  *type_index = (HashmapInfo *) NULL;
+
 static SemaphoreInfo
   *type_semaphore = (SemaphoreInfo *) NULL;
 
@@ -140,7 +143,8 @@ static MagickBooleanType
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 %
 %  GetTypeInfo searches the type list for the specified name and if found
-%  returns attributes for that type.
+%  returns attributes for that type.  The type list is indexed by name when it
+%  is loaded, so the search takes no lock.
 %
 %  The format of the GetTypeInfo method is:
 %
@@ -169,7 +173,7 @@ MagickExport const TypeInfo *GetTypeInfo(const char *name,
       ResetSplayTreeIterator(type_list);
       return((const TypeInfo *) GetNextValueInSplayTree(type_list));
     }
-  return((const TypeInfo *) GetValueFromSplayTree(type_list,name));
+  return((const TypeInfo *) GetValueFromHashmap(type_index,name));
 }
 
 /*
@@ -768,7 +772,7 @@ MagickExport MagickBooleanType LoadFontConfigFonts(SplayTreeInfo *type_list,
 
 static MagickBooleanType InitializeTypeList(ExceptionInfo *exception)
 {
-  if ((type_list == (SplayTreeInfo *) NULL) &&
+  if ((type_index == (HashmapInfo *) NULL) &&
       (instantiate_type == MagickFalse))
     {
       if (type_semaphore == (SemaphoreInfo *) NULL)
@@ -784,6 +788,29 @@ static MagickBooleanType InitializeTypeList(ExceptionInfo *exception)
 #if defined(MAGICKCORE_FONTCONFIG_DELEGATE)
           (void) LoadFontConfigFonts(type_list,exception);
 #endif
+          if (type_list != (SplayTreeInfo *) NULL)
+            {
+              HashmapInfo
+                *index;
+
+              register const TypeInfo
+                *p;
+
+              /*
+                Index the types by name.
+              */
+              index=NewHashmap(GetNumberOfNodesInSplayTree(type_list),
+                HashStringType,CompareHashmapString,(void *(*)(void *)) NULL,
+                (void *(*)(void *)) NULL);
+              ResetSplayTreeIterator(type_list);
+              p=(const TypeInfo *) GetNextValueInSplayTree(type_list);
+              while (p != (const TypeInfo *) NULL)
+              {
+                (void) PutEntryInHashmap(index,p->name,p);
+                p=(const TypeInfo *) GetNextValueInSplayTree(type_list);
+              }
+              type_index=index;
+            }
           instantiate_type=MagickTrue;
         }
       (void) UnlockSemaphoreInfo(type_semaphore);
@@ -1371,6 +1398,8 @@ MagickExport void TypeComponentTerminus(void)
   if (type_semaphore == (SemaphoreInfo *) NULL)
     AcquireSemaphoreInfo(&type_semaphore);
   (void) LockSemaphoreInfo(type_semaphore);
+  if (type_index != (HashmapInfo *) NULL)
+    type_index=DestroyHashmap(type_index);
   if (type_list != (SplayTreeInfo *) NULL)
     type_list=DestroySplayTree(type_list);
   instantiate_type=MagickFalse;
@@ -75,14 +75,17 @@ struct _XMLTreeInfo
     *content;
 
   size_t
-    offset;
+    offset,
+    content_length;
 
   XMLTreeInfo
     *parent,
     *next,
     *sibling,
     *ordered,
-    *child;
+    *child,
+    *last_ordered,
+    *last_next;
 
   MagickBooleanType
     debug;
@@ -1034,6 +1037,7 @@ MagickExport XMLTreeInfo *InsertTagIntoXMLTree(XMLTreeInfo *xml_info,
   XMLTreeInfo *child,const size_t offset)
 {
   XMLTreeInfo
+    *group,
     *head,
     *node,
     *previous;
@@ -1041,11 +1045,14 @@ MagickExport XMLTreeInfo *InsertTagIntoXMLTree(XMLTreeInfo *xml_info,
   child->ordered=(XMLTreeInfo *) NULL;
   child->sibling=(XMLTreeInfo *) NULL;
   child->next=(XMLTreeInfo *) NULL;
+  child->last_next=(XMLTreeInfo *) NULL;
   child->offset=offset;
   child->parent=xml_info;
   if (xml_info->child == (XMLTreeInfo *) NULL)
     {
       xml_info->child=child;
+      xml_info->last_ordered=child;
+      child->last_next=child;
       return(child);
     }
   head=xml_info->child;
@@ -1056,13 +1063,22 @@ MagickExport XMLTreeInfo *InsertTagIntoXMLTree(XMLTreeInfo *xml_info,
     }
   else
     {
+      /*
+        The parser appends tags in document order: start from the last
+        ordered child rather than walk the whole list.
+      */
       node=head;
+      if ((xml_info->last_ordered != (XMLTreeInfo *) NULL) &&
+          (xml_info->last_ordered->offset <= offset))
+        node=xml_info->last_ordered;
       while ((node->ordered != (XMLTreeInfo *) NULL) &&
              (node->ordered->offset <= offset))
         node=node->ordered;
       child->ordered=node->ordered;
       node->ordered=child;
     }
+  if (child->ordered == (XMLTreeInfo *) NULL)
+    xml_info->last_ordered=child;
   previous=(XMLTreeInfo *) NULL;
   node=head;
   while ((node != (XMLTreeInfo *) NULL) && (strcmp(node->tag,child->tag) != 0))
@@ -1072,17 +1088,24 @@ MagickExport XMLTreeInfo *InsertTagIntoXMLTree(XMLTreeInfo *xml_info,
   }
   if ((node != (XMLTreeInfo *) NULL) && (node->offset <= offset))
     {
+      group=node;
+      if ((group->last_next != (XMLTreeInfo *) NULL) &&
+          (group->last_next->offset <= offset))
+        node=group->last_next;
       while ((node->next != (XMLTreeInfo *) NULL) &&
              (node->next->offset <= offset))
         node=node->next;
       child->next=node->next;
       node->next=child;
+      if (child->next == (XMLTreeInfo *) NULL)
+        group->last_next=child;
     }
   else
     {
       if ((previous != (XMLTreeInfo *) NULL) && (node != (XMLTreeInfo *) NULL))
         previous->sibling=node->sibling;
       child->next=node;
+      child->last_next=(node != (XMLTreeInfo *) NULL) ? node->last_next : child;
       previous=(XMLTreeInfo *) NULL;
       node=head;
       while ((node != (XMLTreeInfo *) NULL) && (node->offset <= offset))
@@ -1238,7 +1261,7 @@ static char *ParseEntities(char *xml,char **entities,int state)
   for (xml=p; ; )
   {
     while ((*xml != '\0') && (*xml != '&') && ((*xml != '%') ||
-           (state != '%')) && (isspace((int) ((unsigned char) *xml) == 0)))
+           (state != '%')) && (isspace((int) ((unsigned char) *xml)) == 0))
       xml++;
     if (*xml == '\0')
       break;
@@ -1356,6 +1379,8 @@ static char *ParseEntities(char *xml,char **entities,int state)
           (void) CopyMagickMemory(xml,xml+i,strlen(xml+i)+1);
         while ((*xml != '\0') && (*xml != ' '))
           xml++;
+        if (*xml == '\0')
+          break;
       }
       xml--;
       if ((xml >= p) && (*xml == ' '))
@@ -1367,6 +1392,9 @@ static char *ParseEntities(char *xml,char **entities,int state)
 static void ParseCharacterContent(XMLTreeRoot *root,char *xml,
   const size_t length,const char state)
 {
+  size_t
+    extent;
+
   XMLTreeInfo
     *xml_info;
 
@@ -1376,9 +1404,18 @@ static void ParseCharacterContent(XMLTreeRoot *root,char *xml,
     return;
   xml[length]='\0';
   xml=ParseEntities(xml,root->entities,state);
+  extent=strlen(xml);
   if (*xml_info->content != '\0')
     {
-      (void) ConcatenateString(&xml_info->content,xml);
+      /*
+        Append to the content, its length is tracked rather than rescanned.
+      */
+      xml_info->content=(char *) ResizeQuantumMemory(xml_info->content,
+        xml_info->content_length+extent+1,sizeof(*xml_info->content));
+      if (xml_info->content == (char *) NULL)
+        ThrowFatalException(ResourceLimitFatalError,"MemoryAllocationFailed");
+      (void) CopyMagickMemory(xml_info->content+xml_info->content_length,xml,
+        extent+1);
       xml=DestroyString(xml);
     }
   else
@@ -1386,7 +1423,9 @@ static void ParseCharacterContent(XMLTreeRoot *root,char *xml,
       if (xml_info->content != (char *) NULL)
         xml_info->content=DestroyString(xml_info->content);
       xml_info->content=xml;
+      xml_info->content_length=0;
     }
+  xml_info->content_length+=extent;
 }
 
 static XMLTreeInfo *ParseCloseTag(XMLTreeRoot *root,char *tag,
@@ -1734,7 +1773,7 @@ static void ParseOpenTag(XMLTreeRoot *root,char *tag,char **attributes)
   if (xml_info->tag == (char *) NULL)
     xml_info->tag=ConstantString(tag);
   else
-    xml_info=AddChildToXMLTree(xml_info,tag,strlen(xml_info->content));
+    xml_info=AddChildToXMLTree(xml_info,tag,xml_info->content_length);
   xml_info->attributes=attributes;
   root->node=xml_info;
 }
@@ -2208,6 +2247,15 @@ MagickExport XMLTreeInfo *PruneTagFromXMLTree(XMLTreeInfo *xml_info)
           if (node->next != (XMLTreeInfo *) NULL)
             node->next=node->next->next;
         }
+      /*
+        Forget the insertion hints, they may reference the pruned tag.
+      */
+      xml_info->parent->last_ordered=(XMLTreeInfo *) NULL;
+      for (node=xml_info->parent->child; node != (XMLTreeInfo *) NULL; )
+      {
+        node->last_next=(XMLTreeInfo *) NULL;
+        node=node->ordered;
+      }
     }
   xml_info->ordered=(XMLTreeInfo *) NULL;
   xml_info->sibling=(XMLTreeInfo *) NULL;
@@ -2349,6 +2397,7 @@ MagickExport XMLTreeInfo *SetXMLTreeContent(XMLTreeInfo *xml_info,
   if (xml_info->content != (char *) NULL)
     xml_info->content=DestroyString(xml_info->content);
   xml_info->content=(char *) ConstantString(content);
+  xml_info->content_length=strlen(xml_info->content);
   return(xml_info);
 }
 
@@ -0,0 +1,41 @@
+#!/bin/sh
+#
+#  Copyright 1999-2009 ImageMagick Studio LLC, a non-profit organization
+#  dedicated to making software imaging solutions freely available.
+#
+#  You may not use this file except in compliance with the License.  You may
+#  obtain a copy of the License at
+#
+#    http://www.imagemagick.org/script/license.php
+#
+#  Unless required by applicable law or agreed to in writing, software
+#  distributed under the License is distributed on an "AS IS" BASIS,
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#  See the License for the specific language governing permissions and
+#  limitations under the License.
+#
+#  Test that magick/static.c lists every format the coders register.
+#
+
+set -e # Exit on any error
+. ${srcdir}/tests/common.sh
+
+status=0
+for format in `sed -n 's/.*SetMagickInfo("\([^"]*\)").*/\1/p' \
+  ${TOPSRCDIR}/coders/*.c`; do
+  if ! grep "{ \"${format}\", \"" ${TOPSRCDIR}/magick/static.c \
+       > /dev/null; then
+    echo "magick/static.c: no static module for format ${format}"
+    status=1
+  fi
+done
+for module in `sed -n \
+  's/^ModuleExport unsigned long Register\(.*\)Image(void)$/\1/p' \
+  ${TOPSRCDIR}/coders/*.c`; do
+  if ! grep "{ \"${module}\", Register" ${TOPSRCDIR}/magick/static.c \
+       > /dev/null; then
+    echo "magick/static.c: no static module ${module}"
+    status=1
+  fi
+done
+exit ${status}
@@ -41,10 +41,21 @@
   Include declarations.
 */
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <math.h>
 #include "wand/MagickWand.h"
 #include "validate.h"
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+#if defined(__linux__)
+#include <unistd.h>
+#include <sys/syscall.h>
+#endif
+#if defined(MAGICKCORE_HAVE_PTHREAD)
+#include <pthread.h>
+#endif
 
 /*
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -313,44 +324,88 @@ static unsigned long ValidateConvertCommand(ImageInfo *image_info,
 %                                                                             %
 %                                                                             %
 %                                                                             %
-%   V a l i d a t e I d e n t i f y C o m m a n d                             %
+%   V a l i d a t e D i s p l a y L i s t s                                   %
 %                                                                             %
 %                                                                             %
 %                                                                             %
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 %
-%  ValidateIdentifyCommand() validates the ImageMagick identify command line
-%  program and returns the number of validation tests that passed and failed.
+%  ValidateDisplayLists() validates that replaying a display list draws the
+%  same pixels as DrawImage() and reports the time of each.  It returns the
+%  number of validation tests that passed and failed.
 %
-%  The format of the ValidateIdentifyCommand method is:
+%  The format of the ValidateDisplayLists method is:
 %
-%      unsigned long ValidateIdentifyCommand(ImageInfo *image_info,
-%        const char *reference_filename,const char *output_filename,
+%      unsigned long ValidateDisplayLists(ImageInfo *image_info,
 %        unsigned long *fail,ExceptionInfo *exception)
 %
 %  A description of each parameter follows:
 %
 %    o image_info: the image info.
 %
-%    o reference_filename: the reference image filename.
-%
-%    o output_filename: the output image filename.
-%
 %    o fail: return the number of validation tests that pass.
 %
 %    o exception: return any errors or warnings in this structure.
 %
 */
-static unsigned long ValidateIdentifyCommand(ImageInfo *image_info,
-  const char *reference_filename,const char *output_filename,
+
+static Image *AcquireCanvas(const ImageInfo *image_info,
+  ExceptionInfo *exception)
+{
+  Image
+    *image;
+
+  ImageInfo
+    *canvas_info;
+
+  canvas_info=CloneImageInfo(image_info);
+  (void) CopyMagickString(canvas_info->filename,"xc:white",MaxTextExtent);
+  (void) CloneString(&canvas_info->size,"160x120");
+  image=ReadImage(canvas_info,exception);
+  canvas_info=DestroyImageInfo(canvas_info);
+  return(image);
+}
+
+static unsigned long ValidateDisplayLists(ImageInfo *image_info,
   unsigned long *fail,ExceptionInfo *exception)
 {
-  char
-    **arguments,
-    command[MaxTextExtent];
+#define DisplayListIterations  500
 
-  int
-    number_arguments;
+  static const char
+    *primitives[] =
+    {
+      "fill red rectangle 10,10 90,60",
+      "fill blue stroke black stroke-width 3 circle 80,60 80,20",
+      "push graphic-context fill green affine 1 0 0.5 1 0 0 "
+        "polygon 10,10 70,20 40,90 pop graphic-context "
+        "fill none stroke navy path 'M 10,100 C 40,40 120,160 150,100'",
+      "push defs push clip-path hole rectangle 0,0 80,120 pop clip-path "
+        "pop defs push graphic-context clip-path url(#hole) "
+        "fill orange ellipse 80,60 70,50 0,360 pop graphic-context",
+      (const char *) NULL
+    },
+    *parameters[] =
+    {
+      "accent", "#4682b4", "edge", "red", (const char *) NULL
+    };
+
+  const char
+    *template;
+
+  DisplayListInfo
+    *display_list,
+    *cached_list;
+
+  double
+    draw_time,
+    replay_time;
+
+  DrawInfo
+    *draw_info;
+
+  Image
+    *image,
+    *reference_image;
 
   MagickBooleanType
     status;
@@ -359,38 +414,344 @@ static unsigned long ValidateIdentifyCommand(ImageInfo *image_info,
     i,
     j;
 
+  TimerInfo
+    *timer;
+
   unsigned long
     test;
 
-  (void) output_filename;
   test=0;
-  (void) fprintf(stdout,"validate identify command line program:\n");
-  for (i=0; identify_options[i] != (char *) NULL; i++)
+  (void) fprintf(stdout,"validate display lists:\n");
+  CatchException(exception);
+  draw_info=CloneDrawInfo(image_info,(DrawInfo *) NULL);
+  for (i=0; primitives[i] != (const char *) NULL; i++)
   {
-    CatchException(exception);
-    (void) fprintf(stdout,"  test %lu: %s",test++,identify_options[i]);
-    (void) FormatMagickString(command,MaxTextExtent,"%s %s",
-      identify_options[i],reference_filename);
-    arguments=StringToArgv(command,&number_arguments);
-    if (arguments == (char **) NULL)
+    (void) fprintf(stdout,"  test %lu: replay `%.24s...'",test++,
+      primitives[i]);
+    (void) CloneString(&draw_info->primitive,primitives[i]);
+    reference_image=AcquireCanvas(image_info,exception);
+    image=AcquireCanvas(image_info,exception);
+    if ((reference_image == (Image *) NULL) || (image == (Image *) NULL))
       {
+        if (reference_image != (Image *) NULL)
+          reference_image=DestroyImage(reference_image);
+        if (image != (Image *) NULL)
+          image=DestroyImage(image);
         (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
         (*fail)++;
         continue;
       }
-    status=IdentifyImageCommand(image_info,number_arguments,arguments,
-      (char **) NULL,exception);
-    for (j=0; j < number_arguments; j++)
-      arguments[j]=DestroyString(arguments[j]);
-    arguments=(char **) RelinquishMagickMemory(arguments);
-    if (status != MagickFalse)
+    timer=AcquireTimerInfo();
+    for (j=0; j < DisplayListIterations; j++)
+      (void) DrawImage(reference_image,draw_info);
+    draw_time=GetElapsedTime(timer);
+    display_list=AcquireDisplayList(image,draw_info,exception);
+    status=MagickFalse;
+    replay_time=0.0;
+    if (display_list != (DisplayListInfo *) NULL)
+      {
+        StartTimer(timer,MagickTrue);
+        for (j=0; j < DisplayListIterations; j++)
+          (void) DrawDisplayList(image,display_list,(const char **) NULL);
+        replay_time=GetElapsedTime(timer);
+        status=IsImagesEqual(reference_image,image);
+        if (reference_image->error.normalized_maximum_error != 0.0)
+          status=MagickFalse;
+        display_list=DestroyDisplayList(display_list);
+      }
+    timer=DestroyTimerInfo(timer);
+    image=DestroyImage(image);
+    reference_image=DestroyImage(reference_image);
+    if (status == MagickFalse)
       {
         (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
         (*fail)++;
-        continue;
       }
+    else
+      (void) fprintf(stdout,"... pass, %g ms draw, %g ms replay.\n",
+        1000.0*draw_time/DisplayListIterations,1000.0*replay_time/
+        DisplayListIterations);
+    CatchException(exception);
+  }
+  (void) fprintf(stdout,"  test %lu: substitute parameters",test++);
+  template="fill '$accent' stroke $edge rectangle 20,20 100,80 "
+    "fill yellow rectangle 110,20 150,80";
+  status=MagickFalse;
+  reference_image=AcquireCanvas(image_info,exception);
+  image=AcquireCanvas(image_info,exception);
+  if ((reference_image != (Image *) NULL) && (image != (Image *) NULL))
+    {
+      (void) CloneString(&draw_info->primitive,"fill #4682b4 stroke red "
+        "rectangle 20,20 100,80 fill yellow rectangle 110,20 150,80");
+      (void) DrawImage(reference_image,draw_info);
+      (void) CloneString(&draw_info->primitive,template);
+      display_list=AcquireDisplayList(image,draw_info,exception);
+      if (display_list != (DisplayListInfo *) NULL)
+        {
+          (void) DrawDisplayList(image,display_list,parameters);
+          status=IsImagesEqual(reference_image,image);
+          if (reference_image->error.normalized_maximum_error != 0.0)
+            status=MagickFalse;
+          display_list=DestroyDisplayList(display_list);
+        }
+    }
+  if (image != (Image *) NULL)
+    image=DestroyImage(image);
+  if (reference_image != (Image *) NULL)
+    reference_image=DestroyImage(reference_image);
+  if (status == MagickFalse)
+    {
+      (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
+      (*fail)++;
+    }
+  else
+    (void) fprintf(stdout,"... pass.\n");
+  CatchException(exception);
+  (void) fprintf(stdout,"  test %lu: cache by digest",test++);
+  status=MagickFalse;
+  image=AcquireCanvas(image_info,exception);
+  if (image != (Image *) NULL)
+    {
+      display_list=AcquireDisplayList(image,draw_info,exception);
+      cached_list=AcquireDisplayList(image,draw_info,exception);
+      if ((display_list != (DisplayListInfo *) NULL) &&
+          (display_list == cached_list))
+        status=MagickTrue;
+      (void) CloneString(&draw_info->primitive,"fill red point 1,1");
+      if (cached_list != (DisplayListInfo *) NULL)
+        cached_list=DestroyDisplayList(cached_list);
+      cached_list=AcquireDisplayList(image,draw_info,exception);
+      if ((cached_list == (DisplayListInfo *) NULL) ||
+          (cached_list == display_list))
+        status=MagickFalse;
+      if (cached_list != (DisplayListInfo *) NULL)
+        cached_list=DestroyDisplayList(cached_list);
+      if (display_list != (DisplayListInfo *) NULL)
+        display_list=DestroyDisplayList(display_list);
+      image=DestroyImage(image);
+    }
+  if (status == MagickFalse)
+    {
+      (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
+      (*fail)++;
+    }
+  else
+    (void) fprintf(stdout,"... pass.\n");
+  CatchException(exception);
+  draw_info=DestroyDrawInfo(draw_info);
+  return(test);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   V a l i d a t e H a s h m a p                                             %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  ValidateHashmap() validates the hash-map methods and reports their lookup
+%  throughput.  It returns the number of validation tests that passed and
+%  failed.
+%
+%  The format of the ValidateHashmap method is:
+%
+%      unsigned long ValidateHashmap(unsigned long *fail,
+%        ExceptionInfo *exception)
+%
+%  A description of each parameter follows:
+%
+%    o fail: return the number of validation tests that pass.
+%
+%    o exception: return any errors or warnings in this structure.
+%
+*/
+static unsigned long ValidateHashmap(unsigned long *fail,
+  ExceptionInfo *exception)
+{
+#define HashmapEntries  10000
+#define HashmapLookups  2000000
+
+  char
+    key[MaxTextExtent],
+    **keys;
+
+  double
+    elapsed_time;
+
+  HashmapInfo
+    *hashmap_info;
+
+  MagickBooleanType
+    status;
+
+  register long
+    i;
+
+  StringInfo
+    *string_info;
+
+  TimerInfo
+    *timer;
+
+  unsigned long
+    test;
+
+  void
+    *value;
+
+  test=0;
+  (void) fprintf(stdout,"validate hash-map methods:\n");
+  CatchException(exception);
+  keys=(char **) AcquireQuantumMemory(HashmapEntries,sizeof(*keys));
+  if (keys == (char **) NULL)
+    {
+      (void) fprintf(stdout,"  test %lu: allocate keys",test++);
+      (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
+      (*fail)++;
+      return(test);
+    }
+  for (i=0; i < HashmapEntries; i++)
+  {
+    (void) FormatMagickString(key,MaxTextExtent,"key-%ld",i);
+    keys[i]=ConstantString(key);
+  }
+  hashmap_info=NewHashmap(SmallHashmapSize,HashStringType,CompareHashmapString,
+    RelinquishMagickMemory,(void *(*)(void *)) NULL);
+  (void) fprintf(stdout,"  test %lu: put %d string keys",test++,
+    HashmapEntries);
+  status=MagickTrue;
+  for (i=0; i < HashmapEntries; i++)
+  {
+    (void) FormatMagickString(key,MaxTextExtent,"key-%ld",i);
+    status&=PutEntryInHashmap(hashmap_info,ConstantString(key),
+      (void *) (size_t) (i+1));
+  }
+  if ((status == MagickFalse) ||
+      (GetNumberOfEntriesInHashmap(hashmap_info) != HashmapEntries))
+    {
+      (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
+      (*fail)++;
+    }
+  else
+    (void) fprintf(stdout,"... pass.\n");
+  (void) fprintf(stdout,"  test %lu: get string keys",test++);
+  for (i=0; i < HashmapEntries; i++)
+  {
+    (void) FormatMagickString(key,MaxTextExtent,"key-%ld",i);
+    if (GetValueFromHashmap(hashmap_info,key) != (void *) (size_t) (i+1))
+      break;
+  }
+  if ((i < HashmapEntries) ||
+      (GetValueFromHashmap(hashmap_info,"key-missing") != (void *) NULL))
+    {
+      (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
+      (*fail)++;
+    }
+  else
+    (void) fprintf(stdout,"... pass.\n");
+  (void) fprintf(stdout,"  test %lu: replace and remove string keys",test++);
+  for (i=0; i < HashmapEntries; i+=2)
+  {
+    (void) FormatMagickString(key,MaxTextExtent,"key-%ld",i);
+    (void) PutEntryInHashmap(hashmap_info,ConstantString(key),
+      (void *) (size_t) (i+2));
+  }
+  for (i=0; i < HashmapEntries; i+=3)
+  {
+    (void) FormatMagickString(key,MaxTextExtent,"key-%ld",i);
+    (void) RemoveEntryFromHashmap(hashmap_info,key);
+  }
+  for (i=0; i < HashmapEntries; i++)
+  {
+    (void) FormatMagickString(key,MaxTextExtent,"key-%ld",i);
+    value=GetValueFromHashmap(hashmap_info,key);
+    if ((i % 3) == 0)
+      {
+        if (value != (void *) NULL)
+          break;
+      }
+    else
+      if (value != (void *) (size_t) ((i % 2) == 0 ? i+2 : i+1))
+        break;
+  }
+  if ((i < HashmapEntries) || (GetNumberOfEntriesInHashmap(hashmap_info) !=
+      (HashmapEntries-(HashmapEntries+2)/3)))
+    {
+      (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
+      (*fail)++;
+    }
+  else
+    (void) fprintf(stdout,"... pass.\n");
+  (void) fprintf(stdout,"  test %lu: iterate string keys",test++);
+  ResetHashmapIterator(hashmap_info);
+  for (i=0; GetNextKeyInHashmap(hashmap_info) != (void *) NULL; i++) ;
+  if (i != (long) GetNumberOfEntriesInHashmap(hashmap_info))
+    {
+      (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
+      (*fail)++;
+    }
+  else
     (void) fprintf(stdout,"... pass.\n");
+  (void) fprintf(stdout,"  test %lu: %d lookups",test++,HashmapLookups);
+  timer=AcquireTimerInfo();
+  for (i=0; i < HashmapLookups; i++)
+    value=GetValueFromHashmap(hashmap_info,keys[i % HashmapEntries]);
+  elapsed_time=GetElapsedTime(timer);
+  timer=DestroyTimerInfo(timer);
+  (void) fprintf(stdout,"... pass, %g lookups per second.\n",elapsed_time <
+    MagickEpsilon ? 0.0 : HashmapLookups/elapsed_time);
+  hashmap_info=DestroyHashmap(hashmap_info);
+  (void) fprintf(stdout,"  test %lu: string info keys",test++);
+  hashmap_info=NewHashmap(SmallHashmapSize,HashStringInfoType,
+    CompareHashmapStringInfo,(void *(*)(void *)) DestroyStringInfo,
+    (void *(*)(void *)) NULL);
+  for (i=0; i < HashmapEntries; i++)
+  {
+    (void) FormatMagickString(key,MaxTextExtent,"key-%ld",i);
+    (void) PutEntryInHashmap(hashmap_info,StringToStringInfo(key),
+      (void *) (size_t) (i+1));
   }
+  for (i=0; i < HashmapEntries; i++)
+  {
+    (void) FormatMagickString(key,MaxTextExtent,"key-%ld",i);
+    string_info=StringToStringInfo(key);
+    value=GetValueFromHashmap(hashmap_info,string_info);
+    string_info=DestroyStringInfo(string_info);
+    if (value != (void *) (size_t) (i+1))
+      break;
+  }
+  hashmap_info=DestroyHashmap(hashmap_info);
+  if (i < HashmapEntries)
+    {
+      (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
+      (*fail)++;
+    }
+  else
+    (void) fprintf(stdout,"... pass.\n");
+  (void) fprintf(stdout,"  test %lu: pointer keys",test++);
+  hashmap_info=NewHashmap(SmallHashmapSize,(size_t (*)(const void *)) NULL,
+    (MagickBooleanType (*)(const void *,const void *)) NULL,
+    (void *(*)(void *)) NULL,(void *(*)(void *)) NULL);
+  for (i=0; i < HashmapEntries; i++)
+    (void) PutEntryInHashmap(hashmap_info,keys[i],(void *) (size_t) (i+1));
+  for (i=0; i < HashmapEntries; i++)
+    if (GetValueFromHashmap(hashmap_info,keys[i]) != (void *) (size_t) (i+1))
+      break;
+  hashmap_info=DestroyHashmap(hashmap_info);
+  for (i=0; i < HashmapEntries; i++)
+    keys[i]=DestroyString(keys[i]);
+  keys=(char **) RelinquishMagickMemory(keys);
+  if (i < HashmapEntries)
+    {
+      (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
+      (*fail)++;
+    }
+  else
+    (void) fprintf(stdout,"... pass.\n");
   (void) fprintf(stdout,"  summary: %lu subtests; %lu passed; %lu failed.\n",
     test,test-(*fail),*fail);
   return(test);
@@ -401,120 +762,393 @@ static unsigned long ValidateIdentifyCommand(ImageInfo *image_info,
 %                                                                             %
 %                                                                             %
 %                                                                             %
-%   V a l i d a t e I m a g e F o r m a t s I n M e m o r y                   %
+%   V a l i d a t e S t r i n g M a p                                         %
 %                                                                             %
 %                                                                             %
 %                                                                             %
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 %
-%  ValidateImageFormatsInMemory() validates the ImageMagick image formats in
-%  memory and returns the number of validation tests that passed and failed.
+%  ValidateStringMap() validates the string-map methods: put, replace and
+%  remove, the key order of the iterator, and that copies made by
+%  CloneStringMap() or CloneImage() do not see each other's updates.  It
+%  returns the number of validation tests that passed and failed.
 %
-%  The format of the ValidateImageFormatsInMemory method is:
+%  The format of the ValidateStringMap method is:
 %
-%      unsigned long ValidateImageFormatsInMemory(ImageInfo *image_info,
-%        const char *reference_filename,const char *output_filename,
+%      unsigned long ValidateStringMap(ImageInfo *image_info,
 %        unsigned long *fail,ExceptionInfo *exception)
 %
 %  A description of each parameter follows:
 %
 %    o image_info: the image info.
 %
-%    o reference_filename: the reference image filename.
-%
-%    o output_filename: the output image filename.
-%
 %    o fail: return the number of validation tests that pass.
 %
 %    o exception: return any errors or warnings in this structure.
 %
 */
-static unsigned long ValidateImageFormatsInMemory(ImageInfo *image_info,
-  const char *reference_filename,const char *output_filename,
-  unsigned long *fail,ExceptionInfo *exception)
+
+static MagickBooleanType IsStringMapValue(const char *value,
+  const char *expected)
 {
-  char
-    size[MaxTextExtent];
+  if (expected == (const char *) NULL)
+    return(value == (const char *) NULL ? MagickTrue : MagickFalse);
+  if (value == (const char *) NULL)
+    return(MagickFalse);
+  return(strcmp(value,expected) == 0 ? MagickTrue : MagickFalse);
+}
 
-  const MagickInfo
-    *magick_info;
+static unsigned long ValidateStringMap(ImageInfo *image_info,
+  unsigned long *fail,ExceptionInfo *exception)
+{
+  static const char
+    *keys[] = { "alpha", "bravo", "delta", (const char *) NULL },
+    *values[] = { "one", "2", "4", (const char *) NULL };
 
-  double
-    distortion,
-    fuzz;
+  char
+    *value;
 
   Image
-    *difference_image,
-    *reference_image,
-    *reconstruct_image;
+    *clone_image,
+    *image;
 
   MagickBooleanType
     status;
 
   register long
-    i,
-    j;
-
-  size_t
-    length;
+    i;
 
-  unsigned char
-    *blob;
+  StringMapInfo
+    *clone_map,
+    *string_map;
 
   unsigned long
     test;
 
   test=0;
-  (void) fprintf(stdout,"validate image formats in memory:\n");
-  for (i=0; reference_formats[i].magick != (char *) NULL; i++)
-  {
-    magick_info=GetMagickInfo(reference_formats[i].magick,exception);
-    if ((magick_info == (const MagickInfo *) NULL) ||
-        (magick_info->decoder == (DecodeImageHandler *) NULL) ||
-        (magick_info->encoder == (EncodeImageHandler *) NULL))
-      continue;
-    for (j=0; reference_types[j].type != UndefinedType; j++)
+  (void) fprintf(stdout,"validate string-map methods:\n");
+  CatchException(exception);
+  (void) fprintf(stdout,"  test %lu: put, replace and remove",test++);
+  string_map=NewStringMap();
+  status=PutEntryInStringMap(string_map,"delta","4");
+  status&=PutEntryInStringMap(string_map,"alpha","1");
+  status&=PutEntryInStringMap(string_map,"Charlie","3");
+  status&=PutEntryInStringMap(string_map,"bravo","2");
+  status&=PutEntryInStringMap(string_map,"ALPHA","one");
+  if (GetNumberOfEntriesInStringMap(string_map) != 4)
+    status=MagickFalse;
+  status&=IsStringMapValue(GetValueFromStringMap(string_map,"alpha"),"one");
+  value=RemoveEntryFromStringMap(string_map,"charlie");
+  status&=IsStringMapValue(value,"3");
+  if (value != (char *) NULL)
+    value=DestroyString(value);
+  status&=IsStringMapValue(GetValueFromStringMap(string_map,"Charlie"),
+    (const char *) NULL);
+  if (DeleteEntryFromStringMap(string_map,"missing") != MagickFalse)
+    status=MagickFalse;
+  if (GetNumberOfEntriesInStringMap(string_map) != 3)
+    status=MagickFalse;
+  if (status == MagickFalse)
     {
-      /*
-        Generate reference image.
-      */
-      CatchException(exception);
-      (void) fprintf(stdout,"  test %lu: %s/%s/%s/%lu-bits",test++,
-        reference_formats[i].magick,MagickOptionToMnemonic(
-        MagickCompressOptions,reference_formats[i].compression),
-        MagickOptionToMnemonic(MagickTypeOptions,reference_types[j].type),
-        reference_types[j].depth);
-      (void) CopyMagickString(image_info->filename,reference_filename,
-        MaxTextExtent);
-      reference_image=ReadImage(image_info,exception);
-      if (reference_image == (Image *) NULL)
-        {
-          (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
-          (*fail)++;
-          continue;
-        }
-      /*
-        Write reference image.
-      */
-      (void) FormatMagickString(size,MaxTextExtent,"%lux%lu",
-        reference_image->columns,reference_image->rows);
-      (void) CloneString(&image_info->size,size);
-      image_info->depth=reference_types[j].depth;
-      (void) FormatMagickString(reference_image->filename,MaxTextExtent,"%s:%s",
-        reference_formats[i].magick,output_filename);
-      status=SetImageType(reference_image,reference_types[j].type);
-      InheritException(exception,&reference_image->exception);
-      if (status == MagickFalse)
-        {
-          (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
-          (*fail)++;
-          reference_image=DestroyImage(reference_image);
-          continue;
-        }
-      status=SetImageDepth(reference_image,reference_types[j].depth);
-      InheritException(exception,&reference_image->exception);
-      if (status == MagickFalse)
-        {
+      (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
+      (*fail)++;
+    }
+  else
+    (void) fprintf(stdout,"... pass.\n");
+  (void) fprintf(stdout,"  test %lu: iterator order",test++);
+  status=MagickTrue;
+  ResetStringMapIterator(string_map);
+  for (i=0; keys[i] != (const char *) NULL; i++)
+    status&=IsStringMapValue(GetNextKeyInStringMap(string_map),keys[i]);
+  status&=IsStringMapValue(GetNextKeyInStringMap(string_map),
+    (const char *) NULL);
+  ResetStringMapIterator(string_map);
+  for (i=0; values[i] != (const char *) NULL; i++)
+    status&=IsStringMapValue(GetNextValueInStringMap(string_map),values[i]);
+  ResetStringMapIterator(string_map);
+  status&=IsStringMapValue(GetNextKeyInStringMap(string_map),"alpha");
+  status&=PutEntryInStringMap(string_map,"able","0");
+  (void) DeleteEntryFromStringMap(string_map,"bravo");
+  status&=IsStringMapValue(GetNextKeyInStringMap(string_map),"delta");
+  (void) DeleteEntryFromStringMap(string_map,"able");
+  status&=PutEntryInStringMap(string_map,"bravo","2");
+  if (status == MagickFalse)
+    {
+      (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
+      (*fail)++;
+    }
+  else
+    (void) fprintf(stdout,"... pass.\n");
+  (void) fprintf(stdout,"  test %lu: copy-on-write clones",test++);
+  clone_map=CloneStringMap(string_map);
+  status=PutEntryInStringMap(clone_map,"echo","5");
+  status&=PutEntryInStringMap(clone_map,"bravo","two");
+  (void) DeleteEntryFromStringMap(string_map,"delta");
+  status&=IsStringMapValue(GetValueFromStringMap(string_map,"bravo"),"2");
+  status&=IsStringMapValue(GetValueFromStringMap(string_map,"echo"),
+    (const char *) NULL);
+  status&=IsStringMapValue(GetValueFromStringMap(string_map,"delta"),
+    (const char *) NULL);
+  status&=IsStringMapValue(GetValueFromStringMap(clone_map,"bravo"),"two");
+  status&=IsStringMapValue(GetValueFromStringMap(clone_map,"echo"),"5");
+  status&=IsStringMapValue(GetValueFromStringMap(clone_map,"delta"),"4");
+  if ((GetNumberOfEntriesInStringMap(string_map) != 2) ||
+      (GetNumberOfEntriesInStringMap(clone_map) != 4))
+    status=MagickFalse;
+  clone_map=DestroyStringMap(clone_map);
+  status&=IsStringMapValue(GetValueFromStringMap(string_map,"alpha"),"one");
+  string_map=DestroyStringMap(string_map);
+  if (status == MagickFalse)
+    {
+      (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
+      (*fail)++;
+    }
+  else
+    (void) fprintf(stdout,"... pass.\n");
+  (void) fprintf(stdout,"  test %lu: clone image artifacts and properties",
+    test++);
+  status=MagickFalse;
+  image=AcquireImage(image_info);
+  (void) SetImageArtifact(image,"validate:artifact","1");
+  (void) SetImageProperty(image,"validate:property","1");
+  clone_image=CloneImage(image,0,0,MagickTrue,exception);
+  if (clone_image != (Image *) NULL)
+    {
+      status=SetImageArtifact(clone_image,"validate:artifact","2");
+      status&=SetImageProperty(clone_image,"validate:clone","2");
+      status&=DeleteImageProperty(image,"validate:property");
+      status&=IsStringMapValue(GetImageArtifact(image,"validate:artifact"),
+        "1");
+      status&=IsStringMapValue(GetImageArtifact(clone_image,
+        "validate:artifact"),"2");
+      status&=IsStringMapValue(GetImageProperty(image,"validate:property"),
+        (const char *) NULL);
+      status&=IsStringMapValue(GetImageProperty(clone_image,
+        "validate:property"),"1");
+      status&=IsStringMapValue(GetImageProperty(image,"validate:clone"),
+        (const char *) NULL);
+      clone_image=DestroyImage(clone_image);
+      status&=IsStringMapValue(GetImageArtifact(image,"validate:artifact"),
+        "1");
+    }
+  image=DestroyImage(image);
+  if (status == MagickFalse)
+    {
+      (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
+      (*fail)++;
+    }
+  else
+    (void) fprintf(stdout,"... pass.\n");
+  return(test);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   V a l i d a t e I d e n t i f y C o m m a n d                             %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  ValidateIdentifyCommand() validates the ImageMagick identify command line
+%  program and returns the number of validation tests that passed and failed.
+%
+%  The format of the ValidateIdentifyCommand method is:
+%
+%      unsigned long ValidateIdentifyCommand(ImageInfo *image_info,
+%        const char *reference_filename,const char *output_filename,
+%        unsigned long *fail,ExceptionInfo *exception)
+%
+%  A description of each parameter follows:
+%
+%    o image_info: the image info.
+%
+%    o reference_filename: the reference image filename.
+%
+%    o output_filename: the output image filename.
+%
+%    o fail: return the number of validation tests that pass.
+%
+%    o exception: return any errors or warnings in this structure.
+%
+*/
+static unsigned long ValidateIdentifyCommand(ImageInfo *image_info,
+  const char *reference_filename,const char *output_filename,
+  unsigned long *fail,ExceptionInfo *exception)
+{
+  char
+    **arguments,
+    command[MaxTextExtent];
+
+  int
+    number_arguments;
+
+  MagickBooleanType
+    status;
+
+  register long
+    i,
+    j;
+
+  unsigned long
+    test;
+
+  (void) output_filename;
+  test=0;
+  (void) fprintf(stdout,"validate identify command line program:\n");
+  for (i=0; identify_options[i] != (char *) NULL; i++)
+  {
+    CatchException(exception);
+    (void) fprintf(stdout,"  test %lu: %s",test++,identify_options[i]);
+    (void) FormatMagickString(command,MaxTextExtent,"%s %s",
+      identify_options[i],reference_filename);
+    arguments=StringToArgv(command,&number_arguments);
+    if (arguments == (char **) NULL)
+      {
+        (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
+        (*fail)++;
+        continue;
+      }
+    status=IdentifyImageCommand(image_info,number_arguments,arguments,
+      (char **) NULL,exception);
+    for (j=0; j < number_arguments; j++)
+      arguments[j]=DestroyString(arguments[j]);
+    arguments=(char **) RelinquishMagickMemory(arguments);
+    if (status != MagickFalse)
+      {
+        (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
+        (*fail)++;
+        continue;
+      }
+    (void) fprintf(stdout,"... pass.\n");
+  }
+  (void) fprintf(stdout,"  summary: %lu subtests; %lu passed; %lu failed.\n",
+    test,test-(*fail),*fail);
+  return(test);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   V a l i d a t e I m a g e F o r m a t s I n M e m o r y                   %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  ValidateImageFormatsInMemory() validates the ImageMagick image formats in
+%  memory and returns the number of validation tests that passed and failed.
+%
+%  The format of the ValidateImageFormatsInMemory method is:
+%
+%      unsigned long ValidateImageFormatsInMemory(ImageInfo *image_info,
+%        const char *reference_filename,const char *output_filename,
+%        unsigned long *fail,ExceptionInfo *exception)
+%
+%  A description of each parameter follows:
+%
+%    o image_info: the image info.
+%
+%    o reference_filename: the reference image filename.
+%
+%    o output_filename: the output image filename.
+%
+%    o fail: return the number of validation tests that pass.
+%
+%    o exception: return any errors or warnings in this structure.
+%
+*/
+static unsigned long ValidateImageFormatsInMemory(ImageInfo *image_info,
+  const char *reference_filename,const char *output_filename,
+  unsigned long *fail,ExceptionInfo *exception)
+{
+  char
+    size[MaxTextExtent];
+
+  const MagickInfo
+    *magick_info;
+
+  double
+    distortion,
+    fuzz;
+
+  Image
+    *difference_image,
+    *reference_image,
+    *reconstruct_image;
+
+  MagickBooleanType
+    status;
+
+  register long
+    i,
+    j;
+
+  size_t
+    length;
+
+  unsigned char
+    *blob;
+
+  unsigned long
+    test;
+
+  test=0;
+  (void) fprintf(stdout,"validate image formats in memory:\n");
+  for (i=0; reference_formats[i].magick != (char *) NULL; i++)
+  {
+    magick_info=GetMagickInfo(reference_formats[i].magick,exception);
+    if ((magick_info == (const MagickInfo *) NULL) ||
+        (magick_info->decoder == (DecodeImageHandler *) NULL) ||
+        (magick_info->encoder == (EncodeImageHandler *) NULL))
+      continue;
+    for (j=0; reference_types[j].type != UndefinedType; j++)
+    {
+      /*
+        Generate reference image.
+      */
+      CatchException(exception);
+      (void) fprintf(stdout,"  test %lu: %s/%s/%s/%lu-bits",test++,
+        reference_formats[i].magick,MagickOptionToMnemonic(
+        MagickCompressOptions,reference_formats[i].compression),
+        MagickOptionToMnemonic(MagickTypeOptions,reference_types[j].type),
+        reference_types[j].depth);
+      (void) CopyMagickString(image_info->filename,reference_filename,
+        MaxTextExtent);
+      reference_image=ReadImage(image_info,exception);
+      if (reference_image == (Image *) NULL)
+        {
+          (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
+          (*fail)++;
+          continue;
+        }
+      /*
+        Write reference image.
+      */
+      (void) FormatMagickString(size,MaxTextExtent,"%lux%lu",
+        reference_image->columns,reference_image->rows);
+      (void) CloneString(&image_info->size,size);
+      image_info->depth=reference_types[j].depth;
+      (void) FormatMagickString(reference_image->filename,MaxTextExtent,"%s:%s",
+        reference_formats[i].magick,output_filename);
+      status=SetImageType(reference_image,reference_types[j].type);
+      InheritException(exception,&reference_image->exception);
+      if (status == MagickFalse)
+        {
+          (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
+          (*fail)++;
+          reference_image=DestroyImage(reference_image);
+          continue;
+        }
+      status=SetImageDepth(reference_image,reference_types[j].depth);
+      InheritException(exception,&reference_image->exception);
+      if (status == MagickFalse)
+        {
           (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
           (*fail)++;
           reference_image=DestroyImage(reference_image);
@@ -955,37 +1589,2010 @@ static unsigned long ValidateImportExportPixels(ImageInfo *image_info,
       pixels=(unsigned char *) RelinquishMagickMemory(pixels);
       if (status == MagickFalse)
         {
-          (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
-          (*fail)++;
-          reference_image=DestroyImage(reference_image);
-          continue;
+          (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
+          (*fail)++;
+          reference_image=DestroyImage(reference_image);
+          continue;
+        }
+      /*
+        Compare reference to reconstruct image.
+      */
+      difference_image=CompareImageChannels(reference_image,reconstruct_image,
+        AllChannels,MeanSquaredErrorMetric,&distortion,exception);
+      reconstruct_image=DestroyImage(reconstruct_image);
+      reference_image=DestroyImage(reference_image);
+      if (difference_image == (Image *) NULL)
+        {
+          (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
+          (*fail)++;
+          continue;
+        }
+      difference_image=DestroyImage(difference_image);
+      if ((distortion/QuantumRange) > 0.0)
+        {
+          (void) fprintf(stdout,"... fail (with distortion %g).\n",distortion/
+            QuantumRange);
+          (*fail)++;
+          continue;
+        }
+      (void) fprintf(stdout,"... pass.\n");
+    }
+  }
+  (void) fprintf(stdout,"  summary: %lu subtests; %lu passed; %lu failed.\n",
+    test,test-(*fail),*fail);
+  return(test);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   V a l i d a t e M o n t a g e C o m m a n d                               %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  ValidateMontageCommand() validates the ImageMagick montage command line
+%  program and returns the number of validation tests that passed and failed.
+%
+%  The format of the ValidateMontageCommand method is:
+%
+%      unsigned long ValidateMontageCommand(ImageInfo *image_info,
+%        const char *reference_filename,const char *output_filename,
+%        unsigned long *fail,ExceptionInfo *exception)
+%
+%  A description of each parameter follows:
+%
+%    o image_info: the image info.
+%
+%    o reference_filename: the reference image filename.
+%
+%    o output_filename: the output image filename.
+%
+%    o fail: return the number of validation tests that pass.
+%
+%    o exception: return any errors or warnings in this structure.
+%
+*/
+static unsigned long ValidateMontageCommand(ImageInfo *image_info,
+  const char *reference_filename,const char *output_filename,
+  unsigned long *fail,ExceptionInfo *exception)
+{
+  char
+    **arguments,
+    command[MaxTextExtent];
+
+  int
+    number_arguments;
+
+  MagickBooleanType
+    status;
+
+  register long
+    i,
+    j;
+
+  unsigned long
+    test;
+
+  test=0;
+  (void) fprintf(stdout,"validate montage command line program:\n");
+  for (i=0; montage_options[i] != (char *) NULL; i++)
+  {
+    CatchException(exception);
+    (void) fprintf(stdout,"  test %lu: %s",test++,montage_options[i]);
+    (void) FormatMagickString(command,MaxTextExtent,"%s %s %s %s",
+      reference_filename,montage_options[i],reference_filename,
+      output_filename);
+    arguments=StringToArgv(command,&number_arguments);
+    if (arguments == (char **) NULL)
+      {
+        (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
+        (*fail)++;
+        continue;
+      }
+    status=MontageImageCommand(image_info,number_arguments,arguments,
+      (char **) NULL,exception);
+    for (j=0; j < number_arguments; j++)
+      arguments[j]=DestroyString(arguments[j]);
+    arguments=(char **) RelinquishMagickMemory(arguments);
+    if (status != MagickFalse)
+      {
+        (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
+        (*fail)++;
+        continue;
+      }
+    (void) fprintf(stdout,"... pass.\n");
+  }
+  (void) fprintf(stdout,"  summary: %lu subtests; %lu passed; %lu failed.\n",
+    test,test-(*fail),*fail);
+  return(test);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   V a l i d a t e O p e r a t i o n s                                       %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  ValidateOperations() validates that running a chain of deferred operations
+%  returns the same pixels and page geometry as running each operation on its
+%  own, and reports the time of each.  It also checks that a wand flushes its
+%  deferred operations before compositing and before returning its image.  It returns the number of
+%  validation tests that passed and failed.
+%
+%  The format of the ValidateOperations method is:
+%
+%      unsigned long ValidateOperations(unsigned long *fail,
+%        ExceptionInfo *exception)
+%
+%  A description of each parameter follows:
+%
+%    o fail: return the number of validation tests that pass.
+%
+%    o exception: return any errors or warnings in this structure.
+%
+*/
+
+static Image *AcquireOperationsImage(ExceptionInfo *exception)
+{
+#define OperationsColumns  1200
+#define OperationsRows  800
+
+  Image
+    *image;
+
+  register long
+    i;
+
+  unsigned char
+    *pixels;
+
+  unsigned long
+    x,
+    y;
+
+  pixels=(unsigned char *) AcquireQuantumMemory(OperationsColumns,
+    3*OperationsRows*sizeof(*pixels));
+  if (pixels == (unsigned char *) NULL)
+    return((Image *) NULL);
+  for (i=0; i < (long) (3*OperationsColumns*OperationsRows); i++)
+  {
+    x=(unsigned long) (i/3) % OperationsColumns;
+    y=(unsigned long) (i/3)/OperationsColumns;
+    pixels[i]=(unsigned char) ((3*x+5*y+40*(i % 3)+9*((x*y) % 17)) & 0xff);
+  }
+  image=ConstituteImage(OperationsColumns,OperationsRows,"RGB",CharPixel,
+    pixels,exception);
+  pixels=(unsigned char *) RelinquishMagickMemory(pixels);
+  return(image);
+}
+
+static Image *RunOperations(const Image *image,const char *chain,
+  OperationInfo *operations,ExceptionInfo *exception)
+{
+  char
+    **arguments;
+
+  double
+    gamma,
+    white_point;
+
+  GeometryInfo
+    geometry_info;
+
+  Image
+    *clone_image,
+    *operation_image;
+
+  int
+    number_arguments;
+
+  MagickStatusType
+    flags;
+
+  RectangleInfo
+    geometry;
+
+  register long
+    i;
+
+  /*
+    Run each operation of the chain, or record it if operations is not NULL.
+  */
+  arguments=StringToArgv(chain,&number_arguments);
+  if (arguments == (char **) NULL)
+    return((Image *) NULL);
+  clone_image=(Image *) NULL;
+  if (operations == (OperationInfo *) NULL)
+    clone_image=CloneImage(image,0,0,MagickTrue,exception);
+  for (i=1; i < (long) number_arguments; i+=2)
+  {
+    operation_image=(Image *) NULL;
+    flags=ParseGeometry(arguments[i+1],&geometry_info);
+    switch (*arguments[i])
+    {
+      case 'c':
+      {
+        (void) ParseAbsoluteGeometry(arguments[i+1],&geometry);
+        if (operations != (OperationInfo *) NULL)
+          (void) AppendCropOperation(operations,&geometry);
+        else
+          if (clone_image != (Image *) NULL)
+            operation_image=CropImage(clone_image,&geometry,exception);
+        break;
+      }
+      case 'g':
+      {
+        if (operations != (OperationInfo *) NULL)
+          (void) AppendGammaOperation(operations,DefaultChannels,
+            geometry_info.rho);
+        else
+          if (clone_image != (Image *) NULL)
+            (void) GammaImageChannel(clone_image,DefaultChannels,
+              geometry_info.rho);
+        break;
+      }
+      case 'l':
+      {
+        white_point=(double) QuantumRange;
+        if ((flags & SigmaValue) != 0)
+          white_point=geometry_info.sigma;
+        gamma=1.0;
+        if ((flags & XiValue) != 0)
+          gamma=geometry_info.xi;
+        if (operations != (OperationInfo *) NULL)
+          (void) AppendLevelOperation(operations,DefaultChannels,
+            geometry_info.rho,white_point,gamma);
+        else
+          if (clone_image != (Image *) NULL)
+            (void) LevelImageChannel(clone_image,DefaultChannels,
+              geometry_info.rho,white_point,gamma);
+        break;
+      }
+      case 'n':
+      {
+        if (operations != (OperationInfo *) NULL)
+          (void) AppendNegateOperation(operations,DefaultChannels,MagickFalse);
+        else
+          if (clone_image != (Image *) NULL)
+            (void) NegateImageChannel(clone_image,DefaultChannels,
+              MagickFalse);
+        break;
+      }
+      case 'r':
+      {
+        if (operations != (OperationInfo *) NULL)
+          (void) AppendResizeOperation(operations,(unsigned long)
+            geometry_info.rho,(unsigned long) geometry_info.sigma,
+            UndefinedFilter,1.0);
+        else
+          if (clone_image != (Image *) NULL)
+            operation_image=ResizeImage(clone_image,(unsigned long)
+              geometry_info.rho,(unsigned long) geometry_info.sigma,
+              UndefinedFilter,1.0,exception);
+        break;
+      }
+      case 's':
+      {
+        if (operations != (OperationInfo *) NULL)
+          (void) AppendSharpenOperation(operations,DefaultChannels,
+            geometry_info.rho,geometry_info.sigma);
+        else
+          if (clone_image != (Image *) NULL)
+            operation_image=SharpenImage(clone_image,geometry_info.rho,
+              geometry_info.sigma,exception);
+        break;
+      }
+      default:
+        break;
+    }
+    if ((operation_image != (Image *) NULL) &&
+        (clone_image != (Image *) NULL))
+      {
+        clone_image=DestroyImage(clone_image);
+        clone_image=operation_image;
+      }
+  }
+  for (i=0; i < (long) number_arguments; i++)
+    arguments[i]=DestroyString(arguments[i]);
+  arguments=(char **) RelinquishMagickMemory(arguments);
+  if (operations != (OperationInfo *) NULL)
+    return(ApplyImageOperations(image,operations,exception));
+  return(clone_image);
+}
+
+static MagickBooleanType RunDeferredComposite(void)
+{
+  Image
+    *image;
+
+  MagickBooleanType
+    status;
+
+  MagickWand
+    *composite_wand,
+    *wand;
+
+  PixelPacket
+    color;
+
+  PixelWand
+    *pixel;
+
+  /*
+    Negate a red image in deferred mode, then composite a blue tile on it: the
+    negate must run before the composite, leaving a blue pixel at 0,0.
+  */
+  wand=NewMagickWand();
+  composite_wand=NewMagickWand();
+  pixel=NewPixelWand();
+  status=MagickSetSize(wand,20,20);
+  status&=MagickReadImage(wand,"xc:red");
+  status&=MagickSetSize(composite_wand,5,5);
+  status&=MagickReadImage(composite_wand,"xc:blue");
+  status&=MagickSetDeferredMode(wand,MagickTrue);
+  status&=MagickNegateImage(wand,MagickFalse);
+  status&=MagickCompositeImage(wand,composite_wand,OverCompositeOp,0,0);
+  status&=MagickGetImagePixelColor(wand,0,0,pixel);
+  if ((PixelGetRedQuantum(pixel) != 0) ||
+      (PixelGetGreenQuantum(pixel) != 0) ||
+      (PixelGetBlueQuantum(pixel) != QuantumRange))
+    status=MagickFalse;
+  /*
+    GetImageFromMagickWand() must return the negated image.
+  */
+  status&=MagickNegateImage(wand,MagickFalse);
+  image=GetImageFromMagickWand(wand);
+  if ((image == (Image *) NULL) ||
+      (GetOneVirtualPixel(image,0,0,&color,&image->exception) ==
+       MagickFalse) ||
+      (color.red != QuantumRange) || (color.green != QuantumRange) ||
+      (color.blue != 0))
+    status=MagickFalse;
+  pixel=DestroyPixelWand(pixel);
+  composite_wand=DestroyMagickWand(composite_wand);
+  wand=DestroyMagickWand(wand);
+  return(status != MagickFalse ? MagickTrue : MagickFalse);
+}
+
+static unsigned long ValidateOperations(unsigned long *fail,
+  ExceptionInfo *exception)
+{
+  static const char
+    *chains[] =
+    {
+      "c 400x300+100+50 g 1.4 l 10%,90%,1.2 n",
+      "g 1.4 l 10%,90%,1.2 n c 400x300+100+50",
+      "s 0x1.5 c 400x300+100+50",
+      "s 0x1.5 c 400x300+0+0",
+      "r 600x400 c 200x150+100+50",
+      "r 2400x1600 c 300x200+333+217",
+      "l 5%,95%,1.0 s 0x1 r 600x400 g 0.8 c 200x150+300+200 n",
+      "c 1000x700+10+10 c 200x200+50+50",
+      "g 1.2 g 0.7 n",
+      "r 120x80 r 1200x800",
+      (const char *) NULL
+    };
+
+  double
+    deferred_time,
+    immediate_time;
+
+  Image
+    *deferred_image,
+    *image,
+    *reference_image;
+
+  MagickBooleanType
+    status;
+
+  OperationInfo
+    *operations;
+
+  register long
+    i;
+
+  TimerInfo
+    *timer;
+
+  unsigned long
+    test;
+
+  test=0;
+  (void) fprintf(stdout,"validate deferred operations:\n");
+  CatchException(exception);
+  image=AcquireOperationsImage(exception);
+  if (image == (Image *) NULL)
+    {
+      (void) fprintf(stdout,"  test %lu: acquire image",test++);
+      (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
+      (*fail)++;
+      return(test);
+    }
+  for (i=0; chains[i] != (const char *) NULL; i++)
+  {
+    (void) fprintf(stdout,"  test %lu: %s",test++,chains[i]);
+    timer=AcquireTimerInfo();
+    reference_image=RunOperations(image,chains[i],(OperationInfo *) NULL,
+      exception);
+    immediate_time=GetElapsedTime(timer);
+    operations=AcquireOperationInfo();
+    StartTimer(timer,MagickTrue);
+    deferred_image=RunOperations(image,chains[i],operations,exception);
+    deferred_time=GetElapsedTime(timer);
+    timer=DestroyTimerInfo(timer);
+    operations=DestroyOperationInfo(operations);
+    status=MagickFalse;
+    if ((reference_image != (Image *) NULL) &&
+        (deferred_image != (Image *) NULL))
+      {
+        status=IsImagesEqual(reference_image,deferred_image);
+        if (reference_image->error.normalized_maximum_error != 0.0)
+          status=MagickFalse;
+        if ((reference_image->page.width != deferred_image->page.width) ||
+            (reference_image->page.height != deferred_image->page.height) ||
+            (reference_image->page.x != deferred_image->page.x) ||
+            (reference_image->page.y != deferred_image->page.y))
+          status=MagickFalse;
+      }
+    if (deferred_image != (Image *) NULL)
+      deferred_image=DestroyImage(deferred_image);
+    if (reference_image != (Image *) NULL)
+      reference_image=DestroyImage(reference_image);
+    if (status == MagickFalse)
+      {
+        (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
+        (*fail)++;
+      }
+    else
+      (void) fprintf(stdout,"... pass, %g ms immediate, %g ms deferred.\n",
+        1000.0*immediate_time,1000.0*deferred_time);
+    CatchException(exception);
+  }
+  image=DestroyImage(image);
+  (void) fprintf(stdout,"  test %lu: deferred negate before composite and "
+    "image access",test++);
+  if (RunDeferredComposite() == MagickFalse)
+    {
+      (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
+      (*fail)++;
+    }
+  else
+    (void) fprintf(stdout,"... pass.\n");
+  return(test);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   V a l i d a t e P i x e l C a c h e                                       %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  ValidatePixelCache() validates that operators with a planar fast path
+%  give the same pixels whether the pixel cache is planar or packed.  Each
+%  operator runs on two clones of one image, one with -define cache:planar
+%  true and one with false, so the clones are converted between layouts.
+%  It returns the number of validation tests that passed and failed.
+%
+%  The format of the ValidatePixelCache method is:
+%
+%      unsigned long ValidatePixelCache(ImageInfo *image_info,
+%        unsigned long *fail,ExceptionInfo *exception)
+%
+%  A description of each parameter follows:
+%
+%    o image_info: the image info.
+%
+%    o fail: return the number of validation tests that pass.
+%
+%    o exception: return any errors or warnings in this structure.
+%
+*/
+
+static Image *ApplyCacheOperation(Image *image,const unsigned long operation,
+  const ChannelType channel,ExceptionInfo *exception)
+{
+  Image
+    *blur_image;
+
+  MagickBooleanType
+    status;
+
+  status=MagickFalse;
+  switch (operation)
+  {
+    case 0:
+    {
+      blur_image=BlurImageChannel(image,channel,0.0,2.0,exception);
+      image=DestroyImage(image);
+      return(blur_image);
+    }
+    case 1:
+    {
+      status=GammaImageChannel(image,channel,1.6);
+      break;
+    }
+    case 2:
+    {
+      status=NegateImageChannel(image,channel,MagickFalse);
+      break;
+    }
+    case 3:
+    {
+      status=EvaluateImageChannel(image,channel,MultiplyEvaluateOperator,0.7,
+        exception);
+      break;
+    }
+    default:
+      break;
+  }
+  if (status == MagickFalse)
+    image=DestroyImage(image);
+  return(image);
+}
+
+static unsigned long ValidatePixelCache(ImageInfo *image_info,
+  unsigned long *fail,ExceptionInfo *exception)
+{
+  static const struct
+  {
+    const char
+      *description;
+
+    ColorspaceType
+      colorspace;
+
+    ChannelType
+      channel;
+
+    unsigned long
+      operation;
+  } operations[] =
+  {
+    { "-channel R -blur 0x2", RGBColorspace, RedChannel, 0 },
+    { "-gamma 1.6", RGBColorspace, DefaultChannels, 1 },
+    { "-negate", RGBColorspace, DefaultChannels, 2 },
+    { "-evaluate multiply 0.7", RGBColorspace, DefaultChannels, 3 },
+    { "-colorspace CMYK -channel K -negate", CMYKColorspace, BlackChannel, 2 },
+    { "-colorspace CMYK -channel C -blur 0x2", CMYKColorspace, CyanChannel, 0 }
+  };
+
+  Image
+    *image,
+    *packed_image,
+    *planar_image;
+
+  ImageInfo
+    *canvas_info;
+
+  MagickBooleanType
+    status;
+
+  register long
+    i;
+
+  unsigned long
+    test;
+
+  test=0;
+  (void) fprintf(stdout,"validate pixel cache:\n");
+  CatchException(exception);
+  canvas_info=CloneImageInfo(image_info);
+  (void) CopyMagickString(canvas_info->filename,"plasma:",MaxTextExtent);
+  (void) CloneString(&canvas_info->size,"97x61");
+  image=ReadImage(canvas_info,exception);
+  canvas_info=DestroyImageInfo(canvas_info);
+  for (i=0; i < (long) (sizeof(operations)/sizeof(*operations)); i++)
+  {
+    (void) fprintf(stdout,"  test %lu: planar and packed %s",test++,
+      operations[i].description);
+    status=MagickFalse;
+    packed_image=(Image *) NULL;
+    planar_image=(Image *) NULL;
+    if (image != (Image *) NULL)
+      {
+        packed_image=CloneImage(image,0,0,MagickTrue,exception);
+        planar_image=CloneImage(image,0,0,MagickTrue,exception);
+      }
+    if ((packed_image != (Image *) NULL) && (planar_image != (Image *) NULL))
+      {
+        (void) SetImageArtifact(packed_image,"cache:planar","false");
+        (void) SetImageArtifact(planar_image,"cache:planar","true");
+        if (operations[i].colorspace != image->colorspace)
+          {
+            (void) TransformImageColorspace(packed_image,
+              operations[i].colorspace);
+            (void) TransformImageColorspace(planar_image,
+              operations[i].colorspace);
+          }
+        /*
+          Only the planar clone hands out planes.
+        */
+        if ((GetAuthenticPixelPlane(packed_image,RedChannel,exception) ==
+             (Quantum *) NULL) &&
+            (GetAuthenticPixelPlane(planar_image,RedChannel,exception) !=
+             (Quantum *) NULL))
+          status=MagickTrue;
+        packed_image=ApplyCacheOperation(packed_image,operations[i].operation,
+          operations[i].channel,exception);
+        planar_image=ApplyCacheOperation(planar_image,operations[i].operation,
+          operations[i].channel,exception);
+        if ((packed_image == (Image *) NULL) ||
+            (planar_image == (Image *) NULL) ||
+            (IsImagesEqual(packed_image,planar_image) == MagickFalse))
+          status=MagickFalse;
+      }
+    if (packed_image != (Image *) NULL)
+      packed_image=DestroyImage(packed_image);
+    if (planar_image != (Image *) NULL)
+      planar_image=DestroyImage(planar_image);
+    if (status == MagickFalse)
+      {
+        (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
+        (*fail)++;
+      }
+    else
+      (void) fprintf(stdout,"... pass.\n");
+    CatchException(exception);
+  }
+  if (image != (Image *) NULL)
+    image=DestroyImage(image);
+  return(test);
+}
+
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   V a l i d a t e R a s t e r i z e r                                       %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  ValidateRasterizer() validates the coverage rasterizer against pinned
+%  amounts of ink for antialiased fills, and validates that strokes draw the
+%  same pixels as -define draw:rasterizer=legacy.  It returns the number of
+%  validation tests that passed and failed.
+%
+%  The format of the ValidateRasterizer method is:
+%
+%      unsigned long ValidateRasterizer(ImageInfo *image_info,
+%        unsigned long *fail,ExceptionInfo *exception)
+%
+%  A description of each parameter follows:
+%
+%    o image_info: the image info.
+%
+%    o fail: return the number of validation tests that pass.
+%
+%    o exception: return any errors or warnings in this structure.
+%
+*/
+
+static Image *DrawCanvas(const ImageInfo *image_info,DrawInfo *draw_info,
+  const char *primitive,const char *rasterizer,ExceptionInfo *exception)
+{
+  Image
+    *image;
+
+  image=AcquireCanvas(image_info,exception);
+  if (image == (Image *) NULL)
+    return((Image *) NULL);
+  if (rasterizer != (const char *) NULL)
+    (void) SetImageArtifact(image,"draw:rasterizer",rasterizer);
+  (void) CloneString(&draw_info->primitive,primitive);
+  if (DrawImage(image,draw_info) == MagickFalse)
+    image=DestroyImage(image);
+  return(image);
+}
+
+static double GetImageInk(const Image *image,unsigned long *partial,
+  ExceptionInfo *exception)
+{
+  double
+    ink;
+
+  long
+    y;
+
+  register const PixelPacket
+    *p;
+
+  register long
+    x;
+
+  /*
+    Sum the coverage of a black drawing on a white canvas.
+  */
+  ink=0.0;
+  *partial=0;
+  for (y=0; y < (long) image->rows; y++)
+  {
+    p=GetVirtualPixels(image,0,y,image->columns,1,exception);
+    if (p == (const PixelPacket *) NULL)
+      break;
+    for (x=0; x < (long) image->columns; x++)
+    {
+      ink+=(double) (QuantumRange-p->red)/QuantumRange;
+      if ((p->red != 0) && (p->red != QuantumRange))
+        (*partial)++;
+      p++;
+    }
+  }
+  return(ink);
+}
+
+static unsigned long ValidateRasterizer(ImageInfo *image_info,
+  unsigned long *fail,ExceptionInfo *exception)
+{
+  static const struct
+  {
+    const char
+      *primitive;
+
+    double
+      ink;
+  } fills[] =
+  {
+    { "fill black rectangle 20,30 80,70", 2501.0 },
+    { "fill black polygon 10,10 150,30 60,110", 6666.75 },
+    { "fill black path 'M 10,100 C 40,20 120,140 150,60 Z'", 2016.63 },
+    { "fill black fill-rule nonzero "
+      "polygon 80,5 110,110 20,40 140,40 50,110", 4240.16 },
+    { "fill black fill-rule evenodd "
+      "polygon 80,5 110,110 20,40 140,40 50,110", 3091.05 },
+    { "fill black stroke-antialias false "
+      "polygon 10,10 150,30 60,110", 6711.0 },
+    { (const char *) NULL, 0.0 }
+  };
+
+  static const char
+    *strokes[] =
+    {
+      "fill none stroke black stroke-width 3 polygon 20,20 140,40 90,110",
+      "fill none stroke black stroke-width 5 "
+        "polyline 10,10 50,110 100,20 150,100",
+      "stroke black stroke-width 4 line 10,10 150,110",
+      "fill none stroke black stroke-width 2.5 "
+        "path 'M 10,100 C 40,40 120,160 150,60'",
+      "fill gray stroke black stroke-width 6 stroke-linejoin round "
+        "ellipse 80,60 60,40 0,360",
+      (const char *) NULL
+    };
+
+  double
+    ink;
+
+  DrawInfo
+    *draw_info;
+
+  Image
+    *image,
+    *reference_image;
+
+  MagickBooleanType
+    status;
+
+  register long
+    i;
+
+  unsigned long
+    partial,
+    test;
+
+  test=0;
+  (void) fprintf(stdout,"validate rasterizer:\n");
+  CatchException(exception);
+  draw_info=CloneDrawInfo(image_info,(DrawInfo *) NULL);
+  for (i=0; fills[i].primitive != (const char *) NULL; i++)
+  {
+    (void) fprintf(stdout,"  test %lu: fill `%.24s...'",test++,
+      fills[i].primitive);
+    image=DrawCanvas(image_info,draw_info,fills[i].primitive,(char *) NULL,
+      exception);
+    if (image == (Image *) NULL)
+      {
+        (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
+        (*fail)++;
+        continue;
+      }
+    ink=GetImageInk(image,&partial,exception);
+    image=DestroyImage(image);
+    status=fabs(ink-fills[i].ink) <= 0.5 ? MagickTrue : MagickFalse;
+    if ((strstr(fills[i].primitive,"antialias false") != (char *) NULL) ||
+        (strstr(fills[i].primitive,"rectangle") != (char *) NULL))
+      {
+        if (partial != 0)
+          status=MagickFalse;
+      }
+    else
+      if (partial == 0)
+        status=MagickFalse;
+    if (status == MagickFalse)
+      {
+        (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
+        (*fail)++;
+      }
+    else
+      (void) fprintf(stdout,"... pass.\n");
+    CatchException(exception);
+  }
+  for (i=0; strokes[i] != (const char *) NULL; i++)
+  {
+    (void) fprintf(stdout,"  test %lu: stroke `%.24s...'",test++,strokes[i]);
+    reference_image=DrawCanvas(image_info,draw_info,strokes[i],"legacy",
+      exception);
+    image=DrawCanvas(image_info,draw_info,strokes[i],(char *) NULL,exception);
+    status=MagickFalse;
+    if ((reference_image != (Image *) NULL) && (image != (Image *) NULL))
+      {
+        status=IsImagesEqual(reference_image,image);
+        if (reference_image->error.normalized_maximum_error != 0.0)
+          status=MagickFalse;
+      }
+    if (image != (Image *) NULL)
+      image=DestroyImage(image);
+    if (reference_image != (Image *) NULL)
+      reference_image=DestroyImage(reference_image);
+    if (status == MagickFalse)
+      {
+        (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
+        (*fail)++;
+      }
+    else
+      (void) fprintf(stdout,"... pass.\n");
+    CatchException(exception);
+  }
+  draw_info=DestroyDrawInfo(draw_info);
+  return(test);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   V a l i d a t e R e g i s t r i e s                                       %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  ValidateRegistries() validates lookups in the color, type, magic, and
+%  image format registries, and that image format info outlives its
+%  registration.  It reports the throughput of QueryColorDatabase() and
+%  SetImageInfo() when called from many threads at once.  It returns the
+%  number of validation tests that passed and failed.
+%
+%  The format of the ValidateRegistries method is:
+%
+%      unsigned long ValidateRegistries(ImageInfo *image_info,
+%        unsigned long *fail,ExceptionInfo *exception)
+%
+%  A description of each parameter follows:
+%
+%    o image_info: the image info.
+%
+%    o fail: return the number of validation tests that pass.
+%
+%    o exception: return any errors or warnings in this structure.
+%
+*/
+static unsigned long ValidateRegistries(ImageInfo *image_info,
+  unsigned long *fail,ExceptionInfo *exception)
+{
+#define RegistryLookups  200000
+
+  static const char
+    *colors[] =
+    {
+      "red", "Alice Blue", "LightGoldenrodYellow", "gray50", "none", "navy",
+      "#fff", "rgb(10,20,30)", "WhiteSmoke", "cornsilk3", (char *) NULL
+    };
+
+  static const char
+    *formats[] =
+    {
+      "GIF", "PNG", "JPEG", "TIFF", "PNM", "BMP", "PDF", "8BIMWTEXT"
+    },
+    headers[8][MaxTextExtent/8] =
+    {
+      "GIF89a", "\211PNG\r\n\032\n", "\377\330\377\340", "MM\000*",
+      "P6\n640 480\n255\n", "BM6", "%PDF-1.4", "8\000B\000I\000M\000#"
+    };
+
+  static const unsigned char
+    gif[] = "GIF89a\001\000\001\000\000\000\000;";
+
+  const MagickInfo
+    *magick_info;
+
+  const MagicInfo
+    **magic_list,
+    *magic_info;
+
+  const TypeInfo
+    **type_info;
+
+  double
+    elapsed_time;
+
+  ExceptionInfo
+    *sans_exception;
+
+  long
+    failures;
+
+  MagickBooleanType
+    status;
+
+  PixelPacket
+    color,
+    target;
+
+  register long
+    i;
+
+  TimerInfo
+    *timer;
+
+  unsigned long
+    number_magic,
+    number_types,
+    test;
+
+  test=0;
+  (void) fprintf(stdout,"validate registry lookups:\n");
+  CatchException(exception);
+  sans_exception=AcquireExceptionInfo();
+  (void) fprintf(stdout,"  test %lu: color names",test++);
+  status=QueryColorDatabase("#f0f8ff",&target,exception);
+  status&=QueryColorDatabase("ALICEBLUE",&color,exception);
+  if ((status == MagickFalse) || (color.red != target.red) ||
+      (color.green != target.green) || (color.blue != target.blue) ||
+      (QueryColorDatabase("alice blue",&color,exception) == MagickFalse) ||
+      (color.red != target.red) || (color.green != target.green) ||
+      (GetColorInfo("NoSuchColor",sans_exception) !=
+       (const ColorInfo *) NULL))
+    {
+      (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
+      (*fail)++;
+    }
+  else
+    (void) fprintf(stdout,"... pass.\n");
+  CatchException(exception);
+  (void) fprintf(stdout,"  test %lu: type names",test++);
+  type_info=GetTypeInfoList("*",&number_types,exception);
+  for (i=0; i < (long) number_types; i++)
+  {
+    char
+      name[MaxTextExtent];
+
+    (void) CopyMagickString(name,type_info[i]->name,MaxTextExtent);
+    LocaleUpper(name);
+    if (GetTypeInfo(name,exception) != type_info[i])
+      break;
+  }
+  if (type_info != (const TypeInfo **) NULL)
+    type_info=(const TypeInfo **) RelinquishMagickMemory((void *) type_info);
+  if (i < (long) number_types)
+    {
+      (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
+      (*fail)++;
+    }
+  else
+    (void) fprintf(stdout,"... pass.\n");
+  (void) fprintf(stdout,"  test %lu: image format names",test++);
+  magick_info=GetMagickInfo("gif",exception);
+  if ((magick_info == (const MagickInfo *) NULL) ||
+      (GetMagickInfo("GIF",exception) != magick_info) ||
+      (GetMagickInfo("NoSuchFormat",sans_exception) !=
+       (const MagickInfo *) NULL))
+    {
+      (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
+      (*fail)++;
+    }
+  else
+    (void) fprintf(stdout,"... pass.\n");
+  CatchException(exception);
+  (void) fprintf(stdout,"  test %lu: replace and unregister image formats",
+    test++);
+  {
+    const MagickInfo
+      *replaced_info;
+
+    MagickInfo
+      *entry;
+
+    /*
+      Callers keep the info of a format after it is replaced or unregistered.
+    */
+    entry=SetMagickInfo("VALIDATE");
+    entry->description=ConstantString("first");
+    (void) RegisterMagickInfo(entry);
+    replaced_info=GetMagickInfo("VALIDATE",exception);
+    entry=SetMagickInfo("VALIDATE");
+    entry->description=ConstantString("second");
+    (void) RegisterMagickInfo(entry);
+    magick_info=GetMagickInfo("validate",exception);
+    status=UnregisterMagickInfo("VALIDATE");
+    if ((status == MagickFalse) || (replaced_info == magick_info) ||
+        (replaced_info == (const MagickInfo *) NULL) ||
+        (magick_info == (const MagickInfo *) NULL) ||
+        (GetMagickInfo("VALIDATE",sans_exception) !=
+         (const MagickInfo *) NULL) ||
+        (UnregisterMagickInfo("VALIDATE") != MagickFalse) ||
+        (strcmp(replaced_info->name,"VALIDATE") != 0) ||
+        (strcmp(replaced_info->description,"first") != 0) ||
+        (strcmp(magick_info->name,"VALIDATE") != 0) ||
+        (strcmp(magick_info->description,"second") != 0))
+      {
+        (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
+        (*fail)++;
+      }
+    else
+      (void) fprintf(stdout,"... pass.\n");
+  }
+  CatchException(exception);
+  (void) fprintf(stdout,"  test %lu: magic bytes",test++);
+  magic_info=GetMagicInfo(gif,sizeof(gif),exception);
+  if ((magic_info == (const MagicInfo *) NULL) ||
+      (LocaleCompare(GetMagicName(magic_info),"GIF") != 0))
+    {
+      (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
+      (*fail)++;
+    }
+  else
+    (void) fprintf(stdout,"... pass.\n");
+  (void) fprintf(stdout,"  test %lu: magic signatures",test++);
+  magic_list=GetMagicInfoList("*",&number_magic,exception);
+  for (i=0; i < (long) number_magic; i++)
+  {
+    unsigned char
+      header[MaxTextExtent];
+
+    /*
+      Each signature must select an entry whose signature it contains.
+    */
+    if ((size_t) (magic_list[i]->offset+magic_list[i]->length) > MaxTextExtent)
+      continue;
+    (void) ResetMagickMemory(header,0xff,sizeof(header));
+    (void) CopyMagickMemory(header+magic_list[i]->offset,magic_list[i]->magic,
+      magic_list[i]->length);
+    magic_info=GetMagicInfo(header,(size_t) (magic_list[i]->offset+
+      magic_list[i]->length),exception);
+    if ((magic_info == (const MagicInfo *) NULL) ||
+        (memcmp(header+magic_info->offset,magic_info->magic,
+         magic_info->length) != 0))
+      break;
+  }
+  if (magic_list != (const MagicInfo **) NULL)
+    magic_list=(const MagicInfo **) RelinquishMagickMemory((void *)
+      magic_list);
+  if ((i < (long) number_magic) ||
+      (GetMagicInfo((const unsigned char *) "\377\377\377\377",4,exception) !=
+       (const MagicInfo *) NULL))
+    {
+      (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
+      (*fail)++;
+    }
+  else
+    (void) fprintf(stdout,"... pass.\n");
+  sans_exception=DestroyExceptionInfo(sans_exception);
+  (void) fprintf(stdout,"  test %lu: %d magic detections",test++,
+    10*RegistryLookups);
+  failures=0;
+  timer=AcquireTimerInfo();
+  for (i=0; i < (10*RegistryLookups); i++)
+  {
+    magic_info=GetMagicInfo((const unsigned char *) headers[i % 8],
+      MaxTextExtent/8,exception);
+    if ((magic_info == (const MagicInfo *) NULL) ||
+        (LocaleCompare(GetMagicName(magic_info),formats[i % 8]) != 0))
+      failures++;
+  }
+  elapsed_time=GetElapsedTime(timer);
+  timer=DestroyTimerInfo(timer);
+  if (failures != 0)
+    {
+      (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
+      (*fail)++;
+    }
+  else
+    (void) fprintf(stdout,"... pass, %g detections per second.\n",
+      elapsed_time < MagickEpsilon ? 0.0 : 10*RegistryLookups/elapsed_time);
+  (void) fprintf(stdout,"  test %lu: %d threaded color queries",test++,
+    RegistryLookups);
+  failures=0;
+  timer=AcquireTimerInfo();
+#if defined(_OPENMP) && (_OPENMP >= 200203)
+  #pragma omp parallel for schedule(static,256) reduction(+:failures)
+#endif
+  for (i=0; i < RegistryLookups; i++)
+  {
+    ExceptionInfo
+      *sans_exception;
+
+    PixelPacket
+      pixel;
+
+    sans_exception=AcquireExceptionInfo();
+    if (QueryColorDatabase(colors[i % 10],&pixel,sans_exception) == MagickFalse)
+      failures++;
+    sans_exception=DestroyExceptionInfo(sans_exception);
+  }
+  elapsed_time=GetElapsedTime(timer);
+  timer=DestroyTimerInfo(timer);
+  if (failures != 0)
+    {
+      (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
+      (*fail)++;
+    }
+  else
+    (void) fprintf(stdout,"... pass, %g queries per second.\n",elapsed_time <
+      MagickEpsilon ? 0.0 : RegistryLookups/elapsed_time);
+  (void) fprintf(stdout,"  test %lu: %d threaded image format detections",
+    test++,RegistryLookups);
+  failures=0;
+  timer=AcquireTimerInfo();
+#if defined(_OPENMP) && (_OPENMP >= 200203)
+  #pragma omp parallel for schedule(static,256) reduction(+:failures)
+#endif
+  for (i=0; i < RegistryLookups; i++)
+  {
+    ExceptionInfo
+      *sans_exception;
+
+    ImageInfo
+      *clone_info;
+
+    clone_info=CloneImageInfo(image_info);
+    (void) CopyMagickString(clone_info->filename,"registry",MaxTextExtent);
+    SetImageInfoBlob(clone_info,gif,sizeof(gif));
+    sans_exception=AcquireExceptionInfo();
+    if ((SetImageInfo(clone_info,MagickFalse,sans_exception) == MagickFalse) ||
+        (LocaleCompare(clone_info->magick,"GIF") != 0))
+      failures++;
+    sans_exception=DestroyExceptionInfo(sans_exception);
+    clone_info=DestroyImageInfo(clone_info);
+  }
+  elapsed_time=GetElapsedTime(timer);
+  timer=DestroyTimerInfo(timer);
+  if (failures != 0)
+    {
+      (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
+      (*fail)++;
+    }
+  else
+    (void) fprintf(stdout,"... pass, %g detections per second.\n",
+      elapsed_time < MagickEpsilon ? 0.0 : RegistryLookups/elapsed_time);
+  (void) fprintf(stdout,"  summary: %lu subtests; %lu passed; %lu failed.\n",
+    test,test-(*fail),*fail);
+  return(test);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   V a l i d a t e R e s o u r c e C o n t e x t s                           %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  ValidateResourceContexts() validates that a resource context charges and
+%  releases the resources of the requests it is attached to, enforces its
+%  memory, area, and time limits, and is inherited by cloned image info.  It
+%  returns the number of validation tests that passed and failed.
+%
+%  The format of the ValidateResourceContexts method is:
+%
+%      unsigned long ValidateResourceContexts(ImageInfo *image_info,
+%        unsigned long *fail,ExceptionInfo *exception)
+%
+%  A description of each parameter follows:
+%
+%    o image_info: the image info.
+%
+%    o fail: return the number of validation tests that pass.
+%
+%    o exception: return any errors or warnings in this structure.
+%
+*/
+static unsigned long ValidateResourceContexts(ImageInfo *image_info,
+  unsigned long *fail,ExceptionInfo *exception)
+{
+#define ResourceCharges  100000
+
+  char
+    filename[MaxTextExtent];
+
+  Image
+    *image;
+
+  ImageInfo
+    *canvas_info,
+    *clone_info;
+
+  long
+    failures;
+
+  MagickBooleanType
+    status;
+
+  MagickSizeType
+    disk,
+    memory;
+
+  register long
+    i;
+
+  ResourceContext
+    *bound_context,
+    *resource_context;
+
+  unsigned long
+    test;
+
+  test=0;
+  (void) fprintf(stdout,"validate resource contexts:\n");
+  CatchException(exception);
+  canvas_info=CloneImageInfo(image_info);
+  (void) CopyMagickString(canvas_info->filename,"xc:red",MaxTextExtent);
+  (void) CloneString(&canvas_info->size,"64x64");
+  disk=GetMagickResource(DiskResource);
+  memory=GetMagickResource(MemoryResource);
+  /*
+    A context counts its own charges, fails the charge that reaches its limit,
+    and passes every charge on to the process-wide pool.
+  */
+  (void) fprintf(stdout,"  test %lu: charge and release a context",test++);
+  resource_context=AcquireResourceContext();
+  (void) SetResourceContextLimit(resource_context,MemoryResource,1000);
+  status=AcquireResourceContextResource(resource_context,MemoryResource,400);
+  status&=AcquireResourceContextResource(resource_context,MemoryResource,400);
+  if ((AcquireResourceContextResource(resource_context,MemoryResource,400) !=
+       MagickFalse) ||
+      (GetResourceContextResource(resource_context,MemoryResource) != 1200) ||
+      (GetMagickResource(MemoryResource) != (memory+1200)))
+    status=MagickFalse;
+  for (i=0; i < 3; i++)
+    RelinquishResourceContextResource(resource_context,MemoryResource,400);
+  if ((GetResourceContextResource(resource_context,MemoryResource) != 0) ||
+      (GetMagickResource(MemoryResource) != memory))
+    status=MagickFalse;
+  resource_context=DestroyResourceContext(resource_context);
+  if (status == MagickFalse)
+    {
+      (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
+      (*fail)++;
+    }
+  else
+    (void) fprintf(stdout,"... pass.\n");
+  CatchException(exception);
+  (void) fprintf(stdout,"  test %lu: count concurrent charges",test++);
+  resource_context=AcquireResourceContext();
+  failures=0;
+#if defined(_OPENMP) && (_OPENMP >= 200203)
+  #pragma omp parallel for schedule(static,256) reduction(+:failures)
+#endif
+  for (i=0; i < ResourceCharges; i++)
+    if (AcquireResourceContextResource(resource_context,MapResource,1) ==
+        MagickFalse)
+      failures++;
+  if (GetResourceContextResource(resource_context,MapResource) !=
+      ResourceCharges)
+    failures++;
+#if defined(_OPENMP) && (_OPENMP >= 200203)
+  #pragma omp parallel for schedule(static,256)
+#endif
+  for (i=0; i < ResourceCharges; i++)
+    RelinquishResourceContextResource(resource_context,MapResource,1);
+  if (GetResourceContextResource(resource_context,MapResource) != 0)
+    failures++;
+  resource_context=DestroyResourceContext(resource_context);
+  if (failures != 0)
+    {
+      (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
+      (*fail)++;
+    }
+  else
+    (void) fprintf(stdout,"... pass.\n");
+  CatchException(exception);
+  (void) fprintf(stdout,"  test %lu: inherit the context of an image info",
+    test++);
+  resource_context=AcquireResourceContext();
+  (void) SetResourceContextLimit(resource_context,AreaResource,4096);
+  (void) SetResourceContextLimit(resource_context,MemoryResource,8192);
+  (void) SetResourceContextLimit(resource_context,TimeResource,60);
+  canvas_info->resource_context=resource_context;
+  clone_info=CloneImageInfo(canvas_info);
+  status=clone_info->resource_context == resource_context ? MagickTrue :
+    MagickFalse;
+  if ((GetResourceContextLimit(clone_info->resource_context,AreaResource) !=
+       4096) ||
+      (GetResourceContextLimit(clone_info->resource_context,MemoryResource) !=
+       8192) ||
+      (GetResourceContextLimit(clone_info->resource_context,TimeResource) !=
+       60))
+    status=MagickFalse;
+  clone_info=DestroyImageInfo(clone_info);
+  canvas_info->resource_context=DestroyResourceContext(resource_context);
+  if (status == MagickFalse)
+    {
+      (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
+      (*fail)++;
+    }
+  else
+    (void) fprintf(stdout,"... pass.\n");
+  CatchException(exception);
+  /*
+    ReadImage() charges the request's context, not the one bound to the
+    calling thread, and binds the thread's context again when it returns.
+  */
+  (void) fprintf(stdout,"  test %lu: charge a read to its context",test++);
+  bound_context=AcquireResourceContext();
+  (void) SetThreadResourceContext(bound_context);
+  clone_info=CloneImageInfo(canvas_info);
+  clone_info->resource_context=AcquireResourceContext();
+  image=ReadImage(clone_info,exception);
+  status=image != (Image *) NULL ? MagickTrue : MagickFalse;
+  if ((GetThreadResourceContext() != bound_context) ||
+      (GetResourceContextResource(clone_info->resource_context,
+         MemoryResource) == 0) ||
+      (GetResourceContextResource(bound_context,MemoryResource) != 0))
+    status=MagickFalse;
+  if (image != (Image *) NULL)
+    image=DestroyImage(image);
+  if (GetResourceContextResource(clone_info->resource_context,
+        MemoryResource) != 0)
+    status=MagickFalse;
+  clone_info=DestroyImageInfo(clone_info);
+  (void) SetThreadResourceContext((ResourceContext *) NULL);
+  bound_context=DestroyResourceContext(bound_context);
+  if (status == MagickFalse)
+    {
+      (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
+      (*fail)++;
+    }
+  else
+    (void) fprintf(stdout,"... pass.\n");
+  CatchException(exception);
+  /*
+    Without disk to fall back on, a read over the memory or area limit of its
+    context fails and hands back whatever it charged.
+  */
+  (void) fprintf(stdout,"  test %lu: enforce a context memory limit",test++);
+  clone_info=CloneImageInfo(canvas_info);
+  clone_info->resource_context=AcquireResourceContext();
+  (void) SetResourceContextLimit(clone_info->resource_context,MemoryResource,
+    1024);
+  (void) SetResourceContextLimit(clone_info->resource_context,DiskResource,0);
+  image=ReadImage(clone_info,exception);
+  status=exception->severity == CacheError ? MagickTrue : MagickFalse;
+  if (image != (Image *) NULL)
+    image=DestroyImage(image);
+  if ((GetResourceContextResource(clone_info->resource_context,
+         MemoryResource) != 0) ||
+      (GetResourceContextResource(clone_info->resource_context,
+         DiskResource) != 0))
+    status=MagickFalse;
+  clone_info=DestroyImageInfo(clone_info);
+  if ((GetMagickResource(MemoryResource) != memory) ||
+      (GetMagickResource(DiskResource) != disk))
+    status=MagickFalse;
+  if (status == MagickFalse)
+    {
+      (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
+      (*fail)++;
+    }
+  else
+    (void) fprintf(stdout,"... pass.\n");
+  CatchException(exception);
+  (void) fprintf(stdout,"  test %lu: enforce a context area limit",test++);
+  clone_info=CloneImageInfo(canvas_info);
+  clone_info->resource_context=AcquireResourceContext();
+  (void) SetResourceContextLimit(clone_info->resource_context,AreaResource,
+    1024);
+  (void) SetResourceContextLimit(clone_info->resource_context,DiskResource,0);
+  image=ReadImage(clone_info,exception);
+  status=exception->severity == CacheError ? MagickTrue : MagickFalse;
+  if (image != (Image *) NULL)
+    image=DestroyImage(image);
+  if ((GetResourceContextResource(clone_info->resource_context,
+         MemoryResource) != 0) ||
+      (GetResourceContextResource(clone_info->resource_context,
+         DiskResource) != 0))
+    status=MagickFalse;
+  clone_info=DestroyImageInfo(clone_info);
+  if ((GetMagickResource(MemoryResource) != memory) ||
+      (GetMagickResource(DiskResource) != disk))
+    status=MagickFalse;
+  if (status == MagickFalse)
+    {
+      (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
+      (*fail)++;
+    }
+  else
+    (void) fprintf(stdout,"... pass.\n");
+  CatchException(exception);
+  /*
+    A request past its time limit fails with an error, not a fatal error.
+  */
+  (void) fprintf(stdout,"  test %lu: enforce a context time limit",test++);
+  clone_info=CloneImageInfo(canvas_info);
+  clone_info->resource_context=AcquireResourceContext();
+  (void) SetResourceContextLimit(clone_info->resource_context,TimeResource,0);
+  image=AcquireImage(clone_info);
+  image->columns=64;
+  image->rows=64;
+  status=GetAuthenticPixels(image,0,0,image->columns,1,exception) ==
+    (PixelPacket *) NULL ? MagickTrue : MagickFalse;
+  if (exception->severity != ResourceLimitError)
+    status=MagickFalse;
+  image=DestroyImage(image);
+  clone_info=DestroyImageInfo(clone_info);
+  if (status == MagickFalse)
+    {
+      (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
+      (*fail)++;
+    }
+  else
+    (void) fprintf(stdout,"... pass.\n");
+  CatchException(exception);
+  /*
+    The histogram coder draws into a clone of the image it writes, which is
+    charged to the context WriteImage() binds to the thread.
+  */
+  (void) fprintf(stdout,"  test %lu: bind the context of a write",test++);
+  status=MagickFalse;
+  image=ReadImage(canvas_info,exception);
+  if (image != (Image *) NULL)
+    {
+      clone_info=CloneImageInfo(canvas_info);
+      clone_info->resource_context=AcquireResourceContext();
+      (void) SetResourceContextLimit(clone_info->resource_context,
+        TimeResource,0);
+      (void) AcquireUniqueFilename(filename);
+      (void) FormatMagickString(image->filename,MaxTextExtent,
+        "histogram:%s.miff",filename);
+      (void) WriteImage(clone_info,image);
+      if ((image->exception.severity == ResourceLimitError) &&
+          (GetThreadResourceContext() == (ResourceContext *) NULL))
+        status=MagickTrue;
+      (void) FormatMagickString(image->filename,MaxTextExtent,"%s.miff",
+        filename);
+      (void) remove(image->filename);
+      (void) RelinquishUniqueFileResource(filename);
+      clone_info=DestroyImageInfo(clone_info);
+      image=DestroyImage(image);
+    }
+  if (status == MagickFalse)
+    {
+      (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
+      (*fail)++;
+    }
+  else
+    (void) fprintf(stdout,"... pass.\n");
+  CatchException(exception);
+  canvas_info=DestroyImageInfo(canvas_info);
+  return(test);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   V a l i d a t e S t a r t u p                                             %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  ValidateStartup() validates the configure snapshot named by
+%  MAGICK_CONFIGURE_CACHE and reports how long the configure files read at
+%  startup take to load and parse, averaged over several passes, with and
+%  without it.  It returns the number
+%  of validation tests that passed and failed.
+%
+%  The format of the ValidateStartup method is:
+%
+%      unsigned long ValidateStartup(unsigned long *fail,
+%        ExceptionInfo *exception)
+%
+%  A description of each parameter follows:
+%
+%    o fail: return the number of validation tests that pass.
+%
+%    o exception: return any errors or warnings in this structure.
+%
+*/
+
+static void SetConfigureCache(const char *cache)
+{
+#if defined(_WIN32)
+  (void) _putenv_s("MAGICK_CONFIGURE_CACHE",cache != (const char *) NULL ?
+    cache : "");
+#else
+  if (cache == (const char *) NULL)
+    (void) unsetenv("MAGICK_CONFIGURE_CACHE");
+  else
+    (void) setenv("MAGICK_CONFIGURE_CACHE",cache,1);
+#endif
+}
+
+static MagickBooleanType CompareConfigureOptions(LinkedListInfo *options,
+  LinkedListInfo *reference)
+{
+  const StringInfo
+    *option,
+    *target;
+
+  if (GetNumberOfElementsInLinkedList(options) !=
+      GetNumberOfElementsInLinkedList(reference))
+    return(MagickFalse);
+  ResetLinkedListIterator(options);
+  ResetLinkedListIterator(reference);
+  option=(const StringInfo *) GetNextValueInLinkedList(options);
+  target=(const StringInfo *) GetNextValueInLinkedList(reference);
+  while (option != (const StringInfo *) NULL)
+  {
+    if ((CompareStringInfo(option,target) != 0) ||
+        (strcmp(GetStringInfoPath(option),GetStringInfoPath(target)) != 0) ||
+        (GetStringInfoDatum(option)[GetStringInfoLength(option)] != '\0'))
+      return(MagickFalse);
+    option=(const StringInfo *) GetNextValueInLinkedList(options);
+    target=(const StringInfo *) GetNextValueInLinkedList(reference);
+  }
+  return(MagickTrue);
+}
+
+static double LoadConfigureFiles(const char **filenames,
+  const unsigned long iterations,LinkedListInfo **options,
+  ExceptionInfo *exception)
+{
+  const StringInfo
+    *option;
+
+  double
+    elapsed_time;
+
+  register long
+    i;
+
+  TimerInfo
+    *timer;
+
+  unsigned long
+    j;
+
+  XMLTreeInfo
+    *xml_info;
+
+  /*
+    Load and parse each configure file as the first lookup of its list would;
+    the options of the final iteration are returned.
+  */
+  timer=AcquireTimerInfo();
+  for (j=0; j < iterations; j++)
+  {
+    for (i=0; filenames[i] != (const char *) NULL; i++)
+    {
+      if (j != 0)
+        options[i]=DestroyConfigureOptions(options[i]);
+      options[i]=GetConfigureOptions(filenames[i],exception);
+      option=(const StringInfo *) GetNextValueInLinkedList(options[i]);
+      while (option != (const StringInfo *) NULL)
+      {
+        xml_info=NewXMLTree((const char *) GetStringInfoDatum(option),
+          exception);
+        if (xml_info != (XMLTreeInfo *) NULL)
+          xml_info=DestroyXMLTree(xml_info);
+        option=(const StringInfo *) GetNextValueInLinkedList(options[i]);
+      }
+    }
+  }
+  elapsed_time=GetElapsedTime(timer);
+  timer=DestroyTimerInfo(timer);
+  return(elapsed_time/iterations);
+}
+
+static unsigned long ValidateStartup(unsigned long *fail,
+  ExceptionInfo *exception)
+{
+#define StartupFiles  11
+#define StartupIterations  50
+
+  static const char
+    *filenames[StartupFiles+1] =
+    {
+      "coder.xml", "colors.xml", "configure.xml", "delegates.xml",
+      "english.xml", "locale.xml", "log.xml", "magic.xml", "mime.xml",
+      "policy.xml", "type.xml", (char *) NULL
+    };
+
+  char
+    cache[MaxTextExtent],
+    filename[MaxTextExtent];
+
+  const char
+    *configure_files[2];
+
+  double
+    cache_time,
+    elapsed_time;
+
+  FILE
+    *file;
+
+  LinkedListInfo
+    *options[StartupFiles],
+    *reference[StartupFiles];
+
+  MagickBooleanType
+    status;
+
+  register long
+    i;
+
+  unsigned long
+    test;
+
+  test=0;
+  (void) fprintf(stdout,"validate startup:\n");
+  CatchException(exception);
+  (void) AcquireUniqueFilename(cache);
+  (void) AcquireUniqueFilename(filename);
+  (void) fprintf(stdout,"  test %lu: load configure files",test++);
+  SetConfigureCache((const char *) NULL);
+  elapsed_time=LoadConfigureFiles(filenames,StartupIterations,reference,
+    exception);
+  for (i=0; i < StartupFiles; i++)
+    if (GetNumberOfElementsInLinkedList(reference[i]) == 0)
+      break;
+  if (i < StartupFiles)
+    {
+      (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
+      (*fail)++;
+    }
+  else
+    (void) fprintf(stdout,"... pass, %g ms.\n",1000.0*elapsed_time);
+  CatchException(exception);
+  (void) fprintf(stdout,"  test %lu: write configure snapshot",test++);
+  SetConfigureCache(cache);
+  cache_time=LoadConfigureFiles(filenames,StartupIterations,options,
+    exception);
+  status=MagickTrue;
+  for (i=0; i < StartupFiles; i++)
+  {
+    status&=CompareConfigureOptions(options[i],reference[i]);
+    options[i]=DestroyConfigureOptions(options[i]);
+  }
+  if ((status == MagickFalse) || (IsPathAccessible(cache) == MagickFalse))
+    {
+      (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
+      (*fail)++;
+    }
+  else
+    (void) fprintf(stdout,"... pass, %g ms.\n",1000.0*cache_time);
+  CatchException(exception);
+  (void) fprintf(stdout,"  test %lu: read configure snapshot",test++);
+  cache_time=LoadConfigureFiles(filenames,StartupIterations,options,
+    exception);
+  status=MagickTrue;
+  for (i=0; i < StartupFiles; i++)
+  {
+    status&=CompareConfigureOptions(options[i],reference[i]);
+    options[i]=DestroyConfigureOptions(options[i]);
+  }
+  if (status == MagickFalse)
+    {
+      (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
+      (*fail)++;
+    }
+  else
+    (void) fprintf(stdout,"... pass, %g ms.\n",1000.0*cache_time);
+  for (i=0; i < StartupFiles; i++)
+    reference[i]=DestroyConfigureOptions(reference[i]);
+  CatchException(exception);
+  (void) fprintf(stdout,"  test %lu: stale configure snapshot",test++);
+  configure_files[0]=filename;
+  configure_files[1]=(const char *) NULL;
+  status=MagickFalse;
+  file=fopen(filename,"wb");
+  if (file != (FILE *) NULL)
+    {
+      (void) fprintf(file,"<?xml version=\"1.0\"?>\n<startup version=\"1\"/>\n");
+      status=fclose(file) == 0 ? MagickTrue : MagickFalse;
+    }
+  (void) LoadConfigureFiles(configure_files,1,options,exception);
+  options[0]=DestroyConfigureOptions(options[0]);
+  file=fopen(filename,"wb");
+  if (file != (FILE *) NULL)
+    {
+      (void) fprintf(file,"<?xml version=\"1.0\"?>\n<startup version=\"22\"/>\n");
+      if (fclose(file) != 0)
+        status=MagickFalse;
+    }
+  (void) LoadConfigureFiles(configure_files,1,options,exception);
+  if ((status == MagickFalse) ||
+      (GetNumberOfElementsInLinkedList(options[0]) != 1) ||
+      (strstr((const char *) GetStringInfoDatum((const StringInfo *)
+        GetValueFromLinkedList(options[0],0)),"\"22\"") == (char *) NULL))
+    {
+      (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
+      (*fail)++;
+    }
+  else
+    (void) fprintf(stdout,"... pass.\n");
+  options[0]=DestroyConfigureOptions(options[0]);
+  SetConfigureCache((const char *) NULL);
+  (void) RelinquishUniqueFileResource(filename);
+  (void) RelinquishUniqueFileResource(cache);
+  (void) fprintf(stdout,"  summary: %lu subtests; %lu passed; %lu failed.\n",
+    test,test-(*fail),*fail);
+  return(test);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   V a l i d a t e S t r e a m C o m m a n d                                 %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  ValidateStreamCommand() validates the ImageMagick stream command line
+%  program and returns the number of validation tests that passed and failed.
+%
+%  The format of the ValidateStreamCommand method is:
+%
+%      unsigned long ValidateStreamCommand(ImageInfo *image_info,
+%        const char *reference_filename,const char *output_filename,
+%        unsigned long *fail,ExceptionInfo *exception)
+%
+%  A description of each parameter follows:
+%
+%    o image_info: the image info.
+%
+%    o reference_filename: the reference image filename.
+%
+%    o output_filename: the output image filename.
+%
+%    o fail: return the number of validation tests that pass.
+%
+%    o exception: return any errors or warnings in this structure.
+%
+*/
+static unsigned long ValidateStreamCommand(ImageInfo *image_info,
+  const char *reference_filename,const char *output_filename,
+  unsigned long *fail,ExceptionInfo *exception)
+{
+  char
+    **arguments,
+    command[MaxTextExtent];
+
+  int
+    number_arguments;
+
+  MagickBooleanType
+    status;
+
+  register long
+    i,
+    j;
+
+  unsigned long
+    test;
+
+  test=0;
+  (void) fprintf(stdout,"validate stream command line program:\n");
+  for (i=0; stream_options[i] != (char *) NULL; i++)
+  {
+    CatchException(exception);
+    (void) fprintf(stdout,"  test %lu: %s",test++,stream_options[i]);
+    (void) FormatMagickString(command,MaxTextExtent,"%s %s %s",
+      stream_options[i],reference_filename,output_filename);
+    arguments=StringToArgv(command,&number_arguments);
+    if (arguments == (char **) NULL)
+      {
+        (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
+        (*fail)++;
+        continue;
+      }
+    status=StreamImageCommand(image_info,number_arguments,arguments,
+      (char **) NULL,exception);
+    for (j=0; j < number_arguments; j++)
+      arguments[j]=DestroyString(arguments[j]);
+    arguments=(char **) RelinquishMagickMemory(arguments);
+    if (status != MagickFalse)
+      {
+        (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
+        (*fail)++;
+        continue;
+      }
+    (void) fprintf(stdout,"... pass.\n");
+  }
+  (void) fprintf(stdout,"  summary: %lu subtests; %lu passed; %lu failed.\n",
+    test,test-(*fail),*fail);
+  return(test);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   V a l i d a t e S t r e a m R e s i z e                                   %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  ValidateStreamResize() validates that StreamResizeImage() agrees with
+%  ResizeImage() to within one quantum, for reductions and enlargements and
+%  for filters with and without negative lobes.  It returns the number of
+%  validation tests that passed and failed.
+%
+%  The format of the ValidateStreamResize method is:
+%
+%      unsigned long ValidateStreamResize(ImageInfo *image_info,
+%        const char *reference_filename,unsigned long *fail,
+%        ExceptionInfo *exception)
+%
+%  A description of each parameter follows:
+%
+%    o image_info: the image info.
+%
+%    o reference_filename: the reference image filename.
+%
+%    o fail: return the number of validation tests that pass.
+%
+%    o exception: return any errors or warnings in this structure.
+%
+*/
+
+static double GetMaximumPixelDifference(Image *image,
+  Image *reconstruct_image,ExceptionInfo *exception)
+{
+  double
+    difference[4],
+    distortion;
+
+  long
+    y;
+
+  register const PixelPacket
+    *p,
+    *q;
+
+  register long
+    i,
+    x;
+
+  /*
+    Return the largest difference of any channel of any pixel.
+  */
+  if ((image->columns != reconstruct_image->columns) ||
+      (image->rows != reconstruct_image->rows))
+    return((double) QuantumRange);
+  distortion=0.0;
+  for (y=0; y < (long) image->rows; y++)
+  {
+    p=GetVirtualPixels(image,0,y,image->columns,1,exception);
+    q=GetVirtualPixels(reconstruct_image,0,y,reconstruct_image->columns,1,
+      exception);
+    if ((p == (const PixelPacket *) NULL) || (q == (const PixelPacket *) NULL))
+      return((double) QuantumRange);
+    for (x=0; x < (long) image->columns; x++)
+    {
+      difference[0]=fabs((double) p->red-q->red);
+      difference[1]=fabs((double) p->green-q->green);
+      difference[2]=fabs((double) p->blue-q->blue);
+      difference[3]=fabs((double) p->opacity-q->opacity);
+      for (i=0; i < 4; i++)
+        if (difference[i] > distortion)
+          distortion=difference[i];
+      p++;
+      q++;
+    }
+  }
+  return(distortion);
+}
+
+static unsigned long ValidateStreamResize(ImageInfo *image_info,
+  const char *reference_filename,unsigned long *fail,
+  ExceptionInfo *exception)
+{
+  static const char
+    *geometries[] = { "13%", "50%", "170%", "23x61!", (const char *) NULL };
+
+  static const FilterTypes
+    filters[] =
+    {
+      UndefinedFilter, LanczosFilter, MitchellFilter, CatromFilter,
+      TriangleFilter, GaussianFilter, BoxFilter
+    };
+
+  double
+    distortion;
+
+  Image
+    *image,
+    *reference_image,
+    *resize_image;
+
+  ImageInfo
+    *read_info;
+
+  register long
+    i,
+    j;
+
+  unsigned long
+    test;
+
+  test=0;
+  (void) fprintf(stdout,"validate stream resize:\n");
+  read_info=CloneImageInfo(image_info);
+  (void) CopyMagickString(read_info->filename,reference_filename,
+    MaxTextExtent);
+  for (i=0; geometries[i] != (const char *) NULL; i++)
+    for (j=0; j < (long) (sizeof(filters)/sizeof(*filters)); j++)
+    {
+      CatchException(exception);
+      (void) fprintf(stdout,"  test %lu: %s %s",test++,geometries[i],
+        MagickOptionToMnemonic(MagickFilterOptions,(long) filters[j]));
+      distortion=(double) QuantumRange;
+      image=StreamResizeImage(read_info,geometries[i],filters[j],1.0,
+        exception);
+      reference_image=ReadImage(read_info,exception);
+      if ((image != (Image *) NULL) && (reference_image != (Image *) NULL))
+        {
+          resize_image=ResizeImage(reference_image,image->columns,image->rows,
+            filters[j],1.0,exception);
+          if (resize_image != (Image *) NULL)
+            {
+              distortion=GetMaximumPixelDifference(image,resize_image,
+                exception);
+              resize_image=DestroyImage(resize_image);
+            }
         }
-      /*
-        Compare reference to reconstruct image.
-      */
-      difference_image=CompareImageChannels(reference_image,reconstruct_image,
-        AllChannels,MeanSquaredErrorMetric,&distortion,exception);
-      reconstruct_image=DestroyImage(reconstruct_image);
-      reference_image=DestroyImage(reference_image);
-      if (difference_image == (Image *) NULL)
+      if (reference_image != (Image *) NULL)
+        reference_image=DestroyImage(reference_image);
+      if (image != (Image *) NULL)
+        image=DestroyImage(image);
+      if (distortion > 1.0)
         {
           (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
           (*fail)++;
           continue;
         }
-      difference_image=DestroyImage(difference_image);
-      if ((distortion/QuantumRange) > 0.0)
-        {
-          (void) fprintf(stdout,"... fail (with distortion %g).\n",distortion/
-            QuantumRange);
-          (*fail)++;
-          continue;
-        }
       (void) fprintf(stdout,"... pass.\n");
     }
-  }
-  (void) fprintf(stdout,"  summary: %lu subtests; %lu passed; %lu failed.\n",
-    test,test-(*fail),*fail);
+  read_info=DestroyImageInfo(read_info);
   return(test);
 }
 
@@ -994,86 +3601,145 @@ static unsigned long ValidateImportExportPixels(ImageInfo *image_info,
 %                                                                             %
 %                                                                             %
 %                                                                             %
-%   V a l i d a t e M o n t a g e C o m m a n d                               %
+%   V a l i d a t e T h r e a d s                                             %
 %                                                                             %
 %                                                                             %
 %                                                                             %
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 %
-%  ValidateMontageCommand() validates the ImageMagick montage command line
-%  program and returns the number of validation tests that passed and failed.
+%  ValidateThreads() validates that parallel loops leave the OpenMP schedule
+%  of the calling thread as they found it, and that binding the pixel cache
+%  to NUMA nodes never binds memory outside the cache.  It returns the number
+%  of validation tests that passed and failed.
 %
-%  The format of the ValidateMontageCommand method is:
+%  The format of the ValidateThreads method is:
 %
-%      unsigned long ValidateMontageCommand(ImageInfo *image_info,
-%        const char *reference_filename,const char *output_filename,
+%      unsigned long ValidateThreads(ImageInfo *image_info,
 %        unsigned long *fail,ExceptionInfo *exception)
 %
 %  A description of each parameter follows:
 %
 %    o image_info: the image info.
 %
-%    o reference_filename: the reference image filename.
-%
-%    o output_filename: the output image filename.
-%
 %    o fail: return the number of validation tests that pass.
 %
 %    o exception: return any errors or warnings in this structure.
 %
 */
-static unsigned long ValidateMontageCommand(ImageInfo *image_info,
-  const char *reference_filename,const char *output_filename,
+static unsigned long ValidateThreads(ImageInfo *image_info,
   unsigned long *fail,ExceptionInfo *exception)
 {
-  char
-    **arguments,
-    command[MaxTextExtent];
+  Image
+    *image;
 
-  int
-    number_arguments;
+  ImageInfo
+    *canvas_info;
 
   MagickBooleanType
     status;
 
-  register long
-    i,
-    j;
-
   unsigned long
     test;
 
   test=0;
-  (void) fprintf(stdout,"validate montage command line program:\n");
-  for (i=0; montage_options[i] != (char *) NULL; i++)
+  (void) fprintf(stdout,"validate threads:\n");
+  CatchException(exception);
+  canvas_info=CloneImageInfo(image_info);
+  (void) CopyMagickString(canvas_info->filename,"gradient:",MaxTextExtent);
+  (void) CloneString(&canvas_info->size,"1024x768");
+#if defined(_OPENMP) && (_OPENMP >= 200805)
   {
-    CatchException(exception);
-    (void) fprintf(stdout,"  test %lu: %s",test++,montage_options[i]);
-    (void) FormatMagickString(command,MaxTextExtent,"%s %s %s %s",
-      reference_filename,montage_options[i],reference_filename,
-      output_filename);
-    arguments=StringToArgv(command,&number_arguments);
-    if (arguments == (char **) NULL)
+    Image
+      *blur_image;
+
+    int
+      chunk,
+      modifier;
+
+    omp_sched_t
+      kind,
+      schedule;
+
+    /*
+      Run point, neighborhood, and intensive operators under an application
+      schedule.
+    */
+    (void) fprintf(stdout,"  test %lu: preserve the OpenMP schedule",test++);
+    omp_get_schedule(&schedule,&modifier);
+    omp_set_schedule(omp_sched_guided,7);
+    status=MagickFalse;
+    image=ReadImage(canvas_info,exception);
+    if (image != (Image *) NULL)
+      {
+        status=NegateImage(image,MagickFalse);
+        blur_image=BlurImage(image,0.0,1.0,exception);
+        if (blur_image == (Image *) NULL)
+          status=MagickFalse;
+        else
+          blur_image=DestroyImage(blur_image);
+        status&=EvaluateImage(image,MultiplyEvaluateOperator,0.5,exception);
+        image=DestroyImage(image);
+      }
+    omp_get_schedule(&kind,&chunk);
+    if ((kind != omp_sched_guided) || (chunk != 7))
+      status=MagickFalse;
+    omp_set_schedule(schedule,modifier);
+    if (status == MagickFalse)
       {
         (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
         (*fail)++;
-        continue;
       }
-    status=MontageImageCommand(image_info,number_arguments,arguments,
-      (char **) NULL,exception);
-    for (j=0; j < number_arguments; j++)
-      arguments[j]=DestroyString(arguments[j]);
-    arguments=(char **) RelinquishMagickMemory(arguments);
-    if (status != MagickFalse)
+    else
+      (void) fprintf(stdout,"... pass.\n");
+    CatchException(exception);
+  }
+#endif
+#if defined(__linux__) && defined(SYS_get_mempolicy)
+  {
+    int
+      mode,
+      reference_mode;
+
+    PixelPacket
+      *pixels;
+
+    void
+      *memory;
+
+    /*
+      The page holding the first pixel may be shared with the heap, so it
+      must keep the policy of any other heap memory.
+    */
+    (void) fprintf(stdout,"  test %lu: bind only pixel cache pages",test++);
+    status=MagickFalse;
+    memory=AcquireMagickMemory(1);
+    image=ReadImage(canvas_info,exception);
+    if ((memory != (void *) NULL) && (image != (Image *) NULL))
+      {
+        pixels=GetAuthenticPixels(image,0,0,image->columns,1,exception);
+        if ((pixels != (PixelPacket *) NULL) &&
+            (syscall(SYS_get_mempolicy,&reference_mode,(unsigned long *) NULL,
+              0UL,memory,2) == 0) &&
+            (syscall(SYS_get_mempolicy,&mode,(unsigned long *) NULL,0UL,
+              (char *) pixels-1,2) == 0) &&
+            (mode == reference_mode))
+          status=MagickTrue;
+      }
+    if (image != (Image *) NULL)
+      image=DestroyImage(image);
+    if (memory != (void *) NULL)
+      memory=RelinquishMagickMemory(memory);
+    if (status == MagickFalse)
       {
         (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
         (*fail)++;
-        continue;
       }
-    (void) fprintf(stdout,"... pass.\n");
+    else
+      (void) fprintf(stdout,"... pass.\n");
+    CatchException(exception);
   }
-  (void) fprintf(stdout,"  summary: %lu subtests; %lu passed; %lu failed.\n",
-    test,test-(*fail),*fail);
+#endif
+  canvas_info=DestroyImageInfo(canvas_info);
   return(test);
 }
 
@@ -1082,85 +3748,484 @@ static unsigned long ValidateMontageCommand(ImageInfo *image_info,
 %                                                                             %
 %                                                                             %
 %                                                                             %
-%   V a l i d a t e S t r e a m C o m m a n d                                 %
+%   V a l i d a t e T r a c e                                                 %
 %                                                                             %
 %                                                                             %
 %                                                                             %
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 %
-%  ValidateStreamCommand() validates the ImageMagick stream command line
-%  program and returns the number of validation tests that passed and failed.
+%  ValidateTrace() validates that the trace written by WriteMagickTrace() is
+%  well-formed JSON whose begin and end events pair up within each thread,
+%  also after a trace buffer wraps, and that threads that exit hand their
+%  trace buffer on.  It returns the number of validation tests that passed
+%  and failed.
 %
-%  The format of the ValidateStreamCommand method is:
+%  The format of the ValidateTrace method is:
 %
-%      unsigned long ValidateStreamCommand(ImageInfo *image_info,
-%        const char *reference_filename,const char *output_filename,
-%        unsigned long *fail,ExceptionInfo *exception)
+%      unsigned long ValidateTrace(ImageInfo *image_info,unsigned long *fail,
+%        ExceptionInfo *exception)
 %
 %  A description of each parameter follows:
 %
 %    o image_info: the image info.
 %
-%    o reference_filename: the reference image filename.
-%
-%    o output_filename: the output image filename.
-%
 %    o fail: return the number of validation tests that pass.
 %
 %    o exception: return any errors or warnings in this structure.
 %
 */
-static unsigned long ValidateStreamCommand(ImageInfo *image_info,
-  const char *reference_filename,const char *output_filename,
-  unsigned long *fail,ExceptionInfo *exception)
+
+#define MaxTraceDepth  64
+#define MaxTraceName  64
+#define MaxTraceThreads  256
+
+typedef struct _TraceThreadInfo
 {
+  double
+    timestamp;
+
+  unsigned long
+    depth;
+
+  MagickBooleanType
+    named;
+
   char
-    **arguments,
-    command[MaxTextExtent];
+    spans[MaxTraceDepth][MaxTraceName];
+} TraceThreadInfo;
 
-  int
-    number_arguments;
+static const char *SkipTraceSpace(const char *p)
+{
+  while ((*p == ' ') || (*p == '\t') || (*p == '\n') || (*p == '\r'))
+    p++;
+  return(p);
+}
+
+static const char *ParseTraceString(const char *p,char *string,
+  const size_t extent)
+{
+  size_t
+    length;
+
+  /*
+    Escapes are kept as written; names only need to compare equal.
+  */
+  p=SkipTraceSpace(p);
+  if (*p != '"')
+    return((const char *) NULL);
+  length=0;
+  for (p++; *p != '"'; p++)
+  {
+    if ((unsigned char) *p < 0x20)
+      return((const char *) NULL);
+    if (*p == '\\')
+      {
+        if (length < (extent-1))
+          string[length++]=(*p);
+        p++;
+        if (*p == '\0')
+          return((const char *) NULL);
+      }
+    if (length < (extent-1))
+      string[length++]=(*p);
+  }
+  string[length]='\0';
+  return(p+1);
+}
+
+static const char *ParseTraceValue(const char *p)
+{
+  char
+    *q,
+    string[MaxTextExtent];
+
+  p=SkipTraceSpace(p);
+  switch (*p)
+  {
+    case '"':
+      return(ParseTraceString(p,string,MaxTextExtent));
+    case '{':
+    case '[':
+    {
+      char
+        close;
+
+      close=(*p == '{') ? '}' : ']';
+      p=SkipTraceSpace(p+1);
+      if (*p == close)
+        return(p+1);
+      for ( ; ; )
+      {
+        if (close == '}')
+          {
+            p=ParseTraceString(p,string,MaxTextExtent);
+            if (p == (const char *) NULL)
+              return(p);
+            p=SkipTraceSpace(p);
+            if (*p != ':')
+              return((const char *) NULL);
+            p++;
+          }
+        p=ParseTraceValue(p);
+        if (p == (const char *) NULL)
+          return(p);
+        p=SkipTraceSpace(p);
+        if (*p == close)
+          return(p+1);
+        if (*p != ',')
+          return((const char *) NULL);
+        p++;
+      }
+    }
+    case 't':
+      return(LocaleNCompare(p,"true",4) == 0 ? p+4 : (const char *) NULL);
+    case 'f':
+      return(LocaleNCompare(p,"false",5) == 0 ? p+5 : (const char *) NULL);
+    case 'n':
+      return(LocaleNCompare(p,"null",4) == 0 ? p+4 : (const char *) NULL);
+    default:
+      break;
+  }
+  (void) strtod(p,&q);
+  return(q != p ? (const char *) q : (const char *) NULL);
+}
+
+static const char *ParseTraceEvent(const char *p,TraceThreadInfo *threads,
+  const char *name,unsigned long *events)
+{
+  char
+    event[MaxTraceName],
+    key[MaxTextExtent],
+    phase[MaxTextExtent];
+
+  double
+    timestamp;
+
+  register TraceThreadInfo
+    *thread;
+
+  unsigned long
+    tid;
+
+  /*
+    Parse one event object, then check its timestamp and nesting against the
+    events of its thread so far.
+  */
+  p=SkipTraceSpace(p);
+  if (*p != '{')
+    return((const char *) NULL);
+  *event='\0';
+  *phase='\0';
+  timestamp=(-1.0);
+  tid=MaxTraceThreads;
+  p++;
+  for ( ; ; )
+  {
+    p=ParseTraceString(p,key,MaxTextExtent);
+    if (p == (const char *) NULL)
+      return(p);
+    p=SkipTraceSpace(p);
+    if (*p != ':')
+      return((const char *) NULL);
+    p=SkipTraceSpace(p+1);
+    if (LocaleCompare(key,"name") == 0)
+      p=ParseTraceString(p,event,MaxTraceName);
+    else
+      if (LocaleCompare(key,"ph") == 0)
+        p=ParseTraceString(p,phase,MaxTextExtent);
+      else
+        {
+          if (LocaleCompare(key,"tid") == 0)
+            tid=strtoul(p,(char **) NULL,10);
+          if (LocaleCompare(key,"ts") == 0)
+            timestamp=strtod(p,(char **) NULL);
+          p=ParseTraceValue(p);
+        }
+    if (p == (const char *) NULL)
+      return(p);
+    p=SkipTraceSpace(p);
+    if (*p == '}')
+      break;
+    if (*p != ',')
+      return((const char *) NULL);
+    p++;
+  }
+  if ((*event == '\0') || (timestamp < 0.0) || (tid >= MaxTraceThreads))
+    return((const char *) NULL);
+  thread=threads+tid;
+  if (timestamp < thread->timestamp)
+    return((const char *) NULL);
+  thread->timestamp=timestamp;
+  if (LocaleCompare(event,name) == 0)
+    thread->named=MagickTrue;
+  if (LocaleCompare(phase,"B") == 0)
+    {
+      if (thread->depth >= MaxTraceDepth)
+        return((const char *) NULL);
+      (void) CopyMagickString(thread->spans[thread->depth++],event,
+        MaxTraceName);
+    }
+  else
+    if (LocaleCompare(phase,"E") == 0)
+      {
+        if ((thread->depth == 0) ||
+            (LocaleCompare(thread->spans[--thread->depth],event) != 0))
+          return((const char *) NULL);
+      }
+    else
+      if ((LocaleCompare(phase,"i") != 0) && (LocaleCompare(phase,"C") != 0))
+        return((const char *) NULL);
+  (*events)++;
+  return(p+1);
+}
+
+static MagickBooleanType ParseTraceFile(const char *filename,const char *name,
+  unsigned long *events,unsigned long *number_threads,ExceptionInfo *exception)
+{
+  char
+    *trace,
+    key[MaxTextExtent];
+
+  const char
+    *p;
+
+  register long
+    i;
+
+  TraceThreadInfo
+    *threads;
+
+  /*
+    The trace must be a single JSON object whose traceEvents member holds the
+    events; number_threads counts the threads that recorded the named event.
+  */
+  *events=0;
+  *number_threads=0;
+  trace=FileToString(filename,~0UL,exception);
+  if (trace == (char *) NULL)
+    return(MagickFalse);
+  threads=(TraceThreadInfo *) AcquireQuantumMemory(MaxTraceThreads,
+    sizeof(*threads));
+  if (threads == (TraceThreadInfo *) NULL)
+    {
+      trace=DestroyString(trace);
+      return(MagickFalse);
+    }
+  (void) ResetMagickMemory(threads,0,MaxTraceThreads*sizeof(*threads));
+  p=SkipTraceSpace(trace);
+  if (*p != '{')
+    p=(const char *) NULL;
+  else
+    p++;
+  while (p != (const char *) NULL)
+  {
+    p=ParseTraceString(p,key,MaxTextExtent);
+    if (p == (const char *) NULL)
+      break;
+    p=SkipTraceSpace(p);
+    if (*p != ':')
+      {
+        p=(const char *) NULL;
+        break;
+      }
+    p=SkipTraceSpace(p+1);
+    if (LocaleCompare(key,"traceEvents") != 0)
+      p=ParseTraceValue(p);
+    else
+      {
+        if (*p != '[')
+          {
+            p=(const char *) NULL;
+            break;
+          }
+        p=SkipTraceSpace(p+1);
+        if (*p == ']')
+          p++;
+        else
+          for ( ; ; )
+          {
+            p=ParseTraceEvent(p,threads,name,events);
+            if (p == (const char *) NULL)
+              break;
+            p=SkipTraceSpace(p);
+            if (*p == ']')
+              {
+                p++;
+                break;
+              }
+            if (*p != ',')
+              {
+                p=(const char *) NULL;
+                break;
+              }
+            p++;
+          }
+      }
+    if (p == (const char *) NULL)
+      break;
+    p=SkipTraceSpace(p);
+    if (*p == '}')
+      {
+        p=SkipTraceSpace(p+1);
+        if (*p != '\0')
+          p=(const char *) NULL;
+        break;
+      }
+    if (*p != ',')
+      p=(const char *) NULL;
+    else
+      p++;
+  }
+  for (i=0; i < MaxTraceThreads; i++)
+    if (threads[i].named != MagickFalse)
+      (*number_threads)++;
+  threads=(TraceThreadInfo *) RelinquishMagickMemory(threads);
+  trace=DestroyString(trace);
+  return(p != (const char *) NULL ? MagickTrue : MagickFalse);
+}
+
+#if defined(MAGICKCORE_HAVE_PTHREAD)
+static void *TraceThread(void *context)
+{
+  TraceMagickEvent(OperatorTrace,InstantTracePhase,"ValidateTrace","thread",
+    0);
+  return(context);
+}
+#endif
+
+static unsigned long ValidateTrace(ImageInfo *image_info,unsigned long *fail,
+  ExceptionInfo *exception)
+{
+#define TraceIterations  3000
+
+  char
+    filename[MaxTextExtent];
+
+  Image
+    *blur_image,
+    *image;
+
+  ImageInfo
+    *canvas_info;
 
   MagickBooleanType
     status;
 
   register long
-    i,
-    j;
+    i;
 
   unsigned long
+    events,
+    number_threads,
     test;
 
   test=0;
-  (void) fprintf(stdout,"validate stream command line program:\n");
-  for (i=0; stream_options[i] != (char *) NULL; i++)
+  (void) fprintf(stdout,"validate trace:\n");
+  CatchException(exception);
+  (void) AcquireUniqueFilename(filename);
+  (void) fprintf(stdout,"  test %lu: write a trace",test++);
+  (void) SetMagickTraceMask("All");
+  ResetMagickTrace();
+  canvas_info=CloneImageInfo(image_info);
+  (void) CopyMagickString(canvas_info->filename,"gradient:",MaxTextExtent);
+  (void) CloneString(&canvas_info->size,"256x256");
+  image=ReadImage(canvas_info,exception);
+  canvas_info=DestroyImageInfo(canvas_info);
+  if (image != (Image *) NULL)
+    {
+      blur_image=BlurImage(image,0.0,1.0,exception);
+      if (blur_image != (Image *) NULL)
+        blur_image=DestroyImage(blur_image);
+      image=DestroyImage(image);
+    }
+  status=WriteMagickTrace(filename,exception);
+  if ((status == MagickFalse) ||
+      (ParseTraceFile(filename,"ReadImage GRADIENT",&events,&number_threads,
+        exception) == MagickFalse) ||
+      (events == 0) || (number_threads != 1))
+    status=MagickFalse;
+  if (status == MagickFalse)
+    {
+      (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
+      (*fail)++;
+    }
+  else
+    (void) fprintf(stdout,"... pass.\n");
+  CatchException(exception);
+  /*
+    Five events per iteration never line up with the ring, so once it wraps
+    its oldest event is the end of a span whose begin was overwritten.
+  */
+  (void) fprintf(stdout,"  test %lu: pair begin and end after the ring wraps",
+    test++);
+  (void) SetMagickTraceMask("Operator");
+  ResetMagickTrace();
+  for (i=0; i < TraceIterations; i++)
   {
-    CatchException(exception);
-    (void) fprintf(stdout,"  test %lu: %s",test++,stream_options[i]);
-    (void) FormatMagickString(command,MaxTextExtent,"%s %s %s",
-      stream_options[i],reference_filename,output_filename);
-    arguments=StringToArgv(command,&number_arguments);
-    if (arguments == (char **) NULL)
-      {
-        (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
-        (*fail)++;
-        continue;
-      }
-    status=StreamImageCommand(image_info,number_arguments,arguments,
-      (char **) NULL,exception);
-    for (j=0; j < number_arguments; j++)
-      arguments[j]=DestroyString(arguments[j]);
-    arguments=(char **) RelinquishMagickMemory(arguments);
-    if (status != MagickFalse)
+    TraceMagickEvent(OperatorTrace,BeginTracePhase,"ValidateTrace","outer",0);
+    TraceMagickEvent(OperatorTrace,BeginTracePhase,"ValidateTrace","inner",0);
+    TraceMagickEvent(OperatorTrace,EndTracePhase,"ValidateTrace","inner",0);
+    TraceMagickEvent(OperatorTrace,EndTracePhase,"ValidateTrace","outer",0);
+    TraceMagickEvent(OperatorTrace,InstantTracePhase,"ValidateTrace","mark",
+      (MagickSizeType) i);
+  }
+  status=WriteMagickTrace(filename,exception);
+  if ((status == MagickFalse) ||
+      (ParseTraceFile(filename,"ValidateTrace mark",&events,&number_threads,
+        exception) == MagickFalse) ||
+      (events == 0) || (events >= (5*TraceIterations)) ||
+      (number_threads != 1))
+    status=MagickFalse;
+  if (status == MagickFalse)
+    {
+      (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
+      (*fail)++;
+    }
+  else
+    (void) fprintf(stdout,"... pass.\n");
+  CatchException(exception);
+#if defined(MAGICKCORE_HAVE_PTHREAD)
+  {
+    pthread_t
+      thread;
+
+    /*
+      Each thread exits before the next starts, so all of them record into
+      the same buffer.
+    */
+    (void) fprintf(stdout,"  test %lu: reuse the buffers of exited threads",
+      test++);
+    ResetMagickTrace();
+    status=MagickTrue;
+    for (i=0; i < 8; i++)
+    {
+      if (pthread_create(&thread,(pthread_attr_t *) NULL,TraceThread,
+            (void *) NULL) != 0)
+        {
+          status=MagickFalse;
+          break;
+        }
+      (void) pthread_join(thread,(void **) NULL);
+    }
+    if ((status == MagickFalse) ||
+        (WriteMagickTrace(filename,exception) == MagickFalse) ||
+        (ParseTraceFile(filename,"ValidateTrace thread",&events,
+          &number_threads,exception) == MagickFalse) ||
+        (events != 8) || (number_threads != 1))
+      status=MagickFalse;
+    if (status == MagickFalse)
       {
         (void) fprintf(stdout,"... fail @ %s/%s/%lu.\n",GetMagickModule());
         (*fail)++;
-        continue;
       }
-    (void) fprintf(stdout,"... pass.\n");
+    else
+      (void) fprintf(stdout,"... pass.\n");
+    CatchException(exception);
   }
-  (void) fprintf(stdout,"  summary: %lu subtests; %lu passed; %lu failed.\n",
-    test,test-(*fail),*fail);
+#endif
+  (void) SetMagickTraceMask("None");
+  ResetMagickTrace();
+  (void) RelinquishUniqueFileResource(filename);
   return(test);
 }
 
@@ -1397,6 +4462,8 @@ int main(int argc,char **argv)
             GetMagickCopyright());
           (void) fprintf(stdout,"ImageMagick Validation Suite (%s)\n\n",
             MagickOptionToMnemonic(MagickValidateOptions,(long) type));
+          if ((type & CacheValidate) != 0)
+            tests+=ValidatePixelCache(image_info,&fail,exception);
           if ((type & CompareValidate) != 0)
             tests+=ValidateCompareCommand(image_info,reference_filename,
               output_filename,&fail,exception);
@@ -1406,12 +4473,22 @@ int main(int argc,char **argv)
           if ((type & ConvertValidate) != 0)
             tests+=ValidateConvertCommand(image_info,reference_filename,
               output_filename,&fail,exception);
+          if ((type & DrawValidate) != 0)
+            {
+              tests+=ValidateDisplayLists(image_info,&fail,exception);
+              tests+=ValidateRasterizer(image_info,&fail,exception);
+            }
           if ((type & FormatsInMemoryValidate) != 0)
             tests+=ValidateImageFormatsInMemory(image_info,reference_filename,
               output_filename,&fail,exception);
           if ((type & FormatsOnDiskValidate) != 0)
             tests+=ValidateImageFormatsOnDisk(image_info,reference_filename,
               output_filename,&fail,exception);
+          if ((type & HashmapValidate) != 0)
+            {
+              tests+=ValidateHashmap(&fail,exception);
+              tests+=ValidateStringMap(image_info,&fail,exception);
+            }
           if ((type & IdentifyValidate) != 0)
             tests+=ValidateIdentifyCommand(image_info,reference_filename,
               output_filename,&fail,exception);
@@ -1421,9 +4498,25 @@ int main(int argc,char **argv)
           if ((type & MontageValidate) != 0)
             tests+=ValidateMontageCommand(image_info,reference_filename,
               output_filename,&fail,exception);
+          if ((type & OperationValidate) != 0)
+            tests+=ValidateOperations(&fail,exception);
+          if ((type & RegistryValidate) != 0)
+            tests+=ValidateRegistries(image_info,&fail,exception);
+          if ((type & ResourceValidate) != 0)
+            tests+=ValidateResourceContexts(image_info,&fail,exception);
+          if ((type & StartupValidate) != 0)
+            tests+=ValidateStartup(&fail,exception);
           if ((type & StreamValidate) != 0)
-            tests+=ValidateStreamCommand(image_info,reference_filename,
-              output_filename,&fail,exception);
+            {
+              tests+=ValidateStreamCommand(image_info,reference_filename,
+                output_filename,&fail,exception);
+              tests+=ValidateStreamResize(image_info,reference_filename,&fail,
+                exception);
+            }
+          if ((type & ThreadValidate) != 0)
+            tests+=ValidateThreads(image_info,&fail,exception);
+          if ((type & TraceValidate) != 0)
+            tests+=ValidateTrace(image_info,&fail,exception);
           (void) fprintf(stdout,"validation suite: %lu tests; %lu passed; "
             "%lu failed.\n",tests,tests-fail,fail);
         }
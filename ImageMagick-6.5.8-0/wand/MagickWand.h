@@ -146,6 +146,7 @@ typedef struct _MagickWand
 
 #include "magick/MagickCore.h"
 #include "wand/animate.h"
+#include "wand/batch.h"
 #include "wand/compare.h"
 #include "wand/composite.h"
 #include "wand/conjure.h"
@@ -0,0 +1,351 @@
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%                       BBBB    AAA   TTTTT   CCCC  H   H                     %
+%                       B   B  A   A    T    C      H   H                     %
+%                       BBBB   AAAAA    T    C      HHHHH                     %
+%                       B   B  A   A    T    C      H   H                     %
+%                       BBBB   A   A    T     CCCC  H   H                     %
+%                                                                             %
+%                                                                             %
+%                     MagickWand Batch Conversion Methods                     %
+%                                                                             %
+%                              Software Design                                %
+%                                John Cristy                                  %
+%                               November 2009                                 %
+%                                                                             %
+%                                                                             %
+%  Copyright 1999-2009 ImageMagick Studio LLC, a non-profit organization      %
+%  dedicated to making software imaging solutions freely available.           %
+%                                                                             %
+%  You may not use this file except in compliance with the License.  You may  %
+%  obtain a copy of the License at                                            %
+%                                                                             %
+%    http://www.imagemagick.org/script/license.php                            %
+%                                                                             %
+%  Unless required by applicable law or agreed to in writing, software        %
+%  distributed under the License is distributed on an "AS IS" BASIS,          %
+%  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   %
+%  See the License for the specific language governing permissions and        %
+%  limitations under the License.                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  A batch runs the same pipeline (read, transform, write) over many files.
+%  Each image operator already runs its rows in parallel, but a small image
+%  gives each parallel region too little work to keep the processors busy.
+%  Here the files themselves are spread over the threads instead: each thread
+%  takes the next file as soon as it is done with the last, and the OpenMP
+%  threads available to each image are set from its area, so a large image
+%  still uses several processors while small ones run one to a thread.  The
+%  pixels of the images in flight are bounded by the memory resource limit.
+%
+*/
+
+/*
+  Include declarations.
+*/
+#include "wand/studio.h"
+#include "wand/MagickWand.h"
+#include "wand/magick-wand-private.h"
+#include "wand/wand.h"
+#include "magick/thread-private.h"
+
+/*
+  Define declarations.
+*/
+#define BatchProcessTag  "Batch/Process"
+#define BatchThreadArea  262144UL
+
+/*
+  Typedef declarations.
+*/
+typedef struct _BatchInfo
+{
+  MagickSizeType
+    extent,
+    limit;
+
+  unsigned long
+    in_flight,
+    maximum_threads;
+} BatchInfo;
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   M a g i c k B a t c h P r o c e s s                                       %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  MagickBatchProcess() calls the batch method once for each file in the
+%  list.  Several files are processed at once, each by its own thread and
+%  with its own wand; the settings of each wand are cloned from the given
+%  wand.  The method typically reads the file into the wand, transforms it,
+%  and writes it.  The exceptions of every file are returned in the given
+%  wand.
+%
+%  MagickBatchProcess() returns MagickFalse if the method fails for any file.
+%  The remaining files are processed regardless, unless the progress monitor
+%  of the wand cancels the batch.
+%
+%  The format of the MagickBatchProcess method is:
+%
+%      MagickBooleanType MagickBatchProcess(MagickWand *wand,
+%        const char **filenames,const unsigned long number_files,
+%        const unsigned long parallel_files,MagickBatchMethod method,
+%        void *context)
+%
+%  A description of each parameter follows:
+%
+%    o wand: the magick wand.
+%
+%    o filenames: the files to process.
+%
+%    o number_files: the number of files.
+%
+%    o parallel_files: the number of files to process at once, or 0 for one
+%      per available thread.
+%
+%    o method: the batch method, called with a wand for the file, the file
+%      name, its index in the list, and the context.
+%
+%    o context: the user defined context.
+%
+*/
+
+static MagickWand *AcquireBatchWand(const MagickWand *wand)
+{
+  MagickWand
+    *batch_wand;
+
+  batch_wand=(MagickWand *) AcquireMagickMemory(sizeof(*batch_wand));
+  if (batch_wand == (MagickWand *) NULL)
+    return((MagickWand *) NULL);
+  (void) ResetMagickMemory(batch_wand,0,sizeof(*batch_wand));
+  batch_wand->id=AcquireWandId();
+  (void) FormatMagickString(batch_wand->name,MaxTextExtent,"%s-%lu",
+    MagickWandId,batch_wand->id);
+  batch_wand->exception=AcquireExceptionInfo();
+  batch_wand->image_info=CloneImageInfo(wand->image_info);
+  batch_wand->quantize_info=CloneQuantizeInfo(wand->quantize_info);
+  batch_wand->images=NewImageList();
+  if (wand->operations != (OperationInfo *) NULL)
+    batch_wand->operations=AcquireOperationInfo();
+  batch_wand->debug=IsEventLogging();
+  batch_wand->signature=WandSignature;
+  return(batch_wand);
+}
+
+static MagickSizeType GetBatchArea(const ImageInfo *image_info,
+  const char *filename)
+{
+  ExceptionInfo
+    *exception;
+
+  Image
+    *images;
+
+  ImageInfo
+    *ping_info;
+
+  MagickSizeType
+    area;
+
+  register const Image
+    *p;
+
+  /*
+    Ping the file for the area of its images; 0 if it cannot be pinged.
+  */
+  if ((LocaleCompare(filename,"-") == 0) ||
+      (IsPathAccessible(filename) == MagickFalse))
+    return(0);
+  ping_info=CloneImageInfo(image_info);
+  (void) CopyMagickString(ping_info->filename,filename,MaxTextExtent);
+  exception=AcquireExceptionInfo();
+  images=PingImage(ping_info,exception);
+  exception=DestroyExceptionInfo(exception);
+  ping_info=DestroyImageInfo(ping_info);
+  area=0;
+  for (p=images; p != (Image *) NULL; p=GetNextImageInList(p))
+    area+=(MagickSizeType) p->columns*p->rows;
+  if (images != (Image *) NULL)
+    images=DestroyImageList(images);
+  return(area);
+}
+
+static unsigned long ReserveBatchMemory(BatchInfo *batch_info,
+  const MagickSizeType area,const MagickSizeType extent)
+{
+  MagickBooleanType
+    reserved;
+
+  unsigned long
+    threads;
+
+  /*
+    Wait until the pixels of the image fit with those already in flight; an
+    image runs regardless when nothing else is in flight.  Return the number
+    of OpenMP threads the image may use.
+  */
+  for ( ; ; )
+  {
+    reserved=MagickFalse;
+    threads=1;
+#if defined(MAGICKCORE_OPENMP_SUPPORT) && (_OPENMP >= 200203)
+  #pragma omp critical (MagickWand_ReserveBatchMemory)
+#endif
+    {
+      if ((batch_info->in_flight == 0) ||
+          ((batch_info->extent+extent) <= batch_info->limit))
+        {
+          batch_info->extent+=extent;
+          batch_info->in_flight++;
+          threads=(unsigned long) ((area+BatchThreadArea-1)/BatchThreadArea);
+          if (threads > (batch_info->maximum_threads/batch_info->in_flight))
+            threads=batch_info->maximum_threads/batch_info->in_flight;
+          reserved=MagickTrue;
+        }
+    }
+    if (reserved != MagickFalse)
+      break;
+#if defined(__WINDOWS__)
+    Sleep(1);
+#elif defined(MAGICKCORE_HAVE_USLEEP)
+    (void) usleep(1000);
+#endif
+  }
+  return(threads == 0 ? 1UL : threads);
+}
+
+static void RelinquishBatchMemory(BatchInfo *batch_info,
+  const MagickSizeType extent)
+{
+#if defined(MAGICKCORE_OPENMP_SUPPORT) && (_OPENMP >= 200203)
+  #pragma omp critical (MagickWand_ReserveBatchMemory)
+#endif
+  {
+    batch_info->extent-=extent;
+    batch_info->in_flight--;
+  }
+}
+
+WandExport MagickBooleanType MagickBatchProcess(MagickWand *wand,
+  const char **filenames,const unsigned long number_files,
+  const unsigned long parallel_files,MagickBatchMethod method,void *context)
+{
+  BatchInfo
+    batch_info;
+
+  int
+    nested;
+
+  long
+    progress;
+
+  MagickBooleanType
+    proceed,
+    status;
+
+  register long
+    i;
+
+  unsigned long
+    number_threads;
+
+  assert(wand != (MagickWand *) NULL);
+  assert(wand->signature == WandSignature);
+  if (wand->debug != MagickFalse)
+    (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  if (method == (MagickBatchMethod) NULL)
+    return(MagickFalse);
+  (void) ResetMagickMemory(&batch_info,0,sizeof(batch_info));
+  batch_info.maximum_threads=GetOpenMPMaximumThreads();
+  batch_info.limit=GetMagickResourceLimit(MemoryResource);
+  if (wand->image_info->resource_context != (ResourceContext *) NULL)
+    batch_info.limit=GetResourceContextLimit(
+      wand->image_info->resource_context,MemoryResource);
+  number_threads=parallel_files;
+  if ((number_threads == 0) || (number_threads > batch_info.maximum_threads))
+    number_threads=batch_info.maximum_threads;
+  if (number_threads > number_files)
+    number_threads=number_files;
+  if (number_threads == 0)
+    number_threads=1;
+  /*
+    Each file runs on its own thread; its operators run nested within it.
+  */
+  nested=0;
+#if defined(MAGICKCORE_OPENMP_SUPPORT) && (_OPENMP >= 200203)
+  nested=omp_get_nested();
+#endif
+  SetOpenMPNested(1);
+  status=MagickTrue;
+  proceed=MagickTrue;
+  progress=0;
+#if defined(MAGICKCORE_OPENMP_SUPPORT) && (_OPENMP >= 200203)
+  #pragma omp parallel for schedule(dynamic,1) \
+    shared(proceed,progress,status) \
+    num_threads((int) number_threads)
+#endif
+  for (i=0; i < (long) number_files; i++)
+  {
+    MagickBooleanType
+      processed;
+
+    MagickSizeType
+      area,
+      extent;
+
+    MagickWand
+      *batch_wand;
+
+    if (proceed == MagickFalse)
+      continue;
+    batch_wand=AcquireBatchWand(wand);
+    if (batch_wand == (MagickWand *) NULL)
+      {
+        status=MagickFalse;
+        proceed=MagickFalse;
+        continue;
+      }
+    area=GetBatchArea(batch_wand->image_info,filenames[i]);
+    extent=2*area*sizeof(PixelPacket);
+    SetOpenMPMaximumThreads(ReserveBatchMemory(&batch_info,area,extent));
+    /*
+      The method runs in a team of its own, so it is thread 0 of a team sized
+      for this image, just as when it runs outside a batch.
+    */
+#if defined(MAGICKCORE_OPENMP_SUPPORT) && (_OPENMP >= 200203)
+  #pragma omp parallel num_threads(1)
+#endif
+    processed=method(batch_wand,filenames[i],(unsigned long) i,context);
+    RelinquishBatchMemory(&batch_info,extent);
+#if defined(MAGICKCORE_OPENMP_SUPPORT) && (_OPENMP >= 200203)
+  #pragma omp critical (MagickWand_MagickBatchProcess)
+#endif
+    {
+      if (batch_wand->exception->severity != UndefinedException)
+        InheritException(wand->exception,batch_wand->exception);
+      if (processed == MagickFalse)
+        status=MagickFalse;
+      if (wand->image_info->progress_monitor != (MagickProgressMonitor) NULL)
+        if (wand->image_info->progress_monitor(BatchProcessTag,progress++,
+              number_files,wand->image_info->client_data) == MagickFalse)
+          {
+            status=MagickFalse;
+            proceed=MagickFalse;
+          }
+    }
+    batch_wand=DestroyMagickWand(batch_wand);
+  }
+  SetOpenMPNested(nested);
+  return(status);
+}
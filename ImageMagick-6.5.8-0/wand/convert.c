@@ -376,6 +376,8 @@ static MagickBooleanType ConvertUsage(void)
       "-scene value         image scene number",
       "-seed value          seed a new sequence of pseudo-random numbers",
       "-size geometry       width and height of image",
+      "-stream-resize geometry",
+      "                     resize the image as it is read, in bounded memory",
       "-stretch type        render text with this font stretch",
       "-stroke color        graphic primitive stroke color",
       "-strokewidth value   graphic primitive stroke width",
@@ -574,7 +576,7 @@ WandExport MagickBooleanType ConvertImageCommand(ImageInfo *image_info,
         if (image_info->ping != MagickFalse)
           images=PingImages(image_info,exception);
         else
-          images=ReadImages(image_info,exception);
+          images=StreamResizeImages(image_info,exception);
         status&=(images != (Image *) NULL) &&
           (exception->severity < ErrorException);
         if (images == (Image *) NULL)
@@ -2471,6 +2473,17 @@ WandExport MagickBooleanType ConvertImageCommand(ImageInfo *image_info,
               ThrowConvertException(OptionError,"MissingArgument",option);
             break;
           }
+        if (LocaleCompare("stream-resize",option+1) == 0)
+          {
+            if (*option == '+')
+              break;
+            i++;
+            if (i == (long) (argc-1))
+              ThrowConvertException(OptionError,"MissingArgument",option);
+            if (IsGeometry(argv[i]) == MagickFalse)
+              ThrowConvertInvalidArgumentException(option,argv[i]);
+            break;
+          }
         if (LocaleCompare("stretch",option+1) == 0)
           {
             long
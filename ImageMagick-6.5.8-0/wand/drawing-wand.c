@@ -4264,6 +4264,60 @@ WandExport MagickBooleanType DrawRender(DrawingWand *wand)
 %                                                                             %
 %                                                                             %
 %                                                                             %
+%   D r a w R e n d e r D i s p l a y L i s t                                 %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  DrawRenderDisplayList() renders all preceding drawing commands onto the
+%  image, binding the fill and stroke parameters to the given colors.  The
+%  drawing commands are parsed once and cached, so rendering the same drawing
+%  again with other parameters does not parse it again.
+%
+%  The format of the DrawRenderDisplayList method is:
+%
+%      MagickBooleanType DrawRenderDisplayList(DrawingWand *wand,
+%        const char **parameters)
+%
+%  A description of each parameter follows:
+%
+%    o wand: the drawing wand.
+%
+%    o parameters: a NULL terminated list of parameter name and color pairs.
+%
+*/
+WandExport MagickBooleanType DrawRenderDisplayList(DrawingWand *wand,
+  const char **parameters)
+{
+  DisplayListInfo
+    *display_list;
+
+  MagickBooleanType
+    status;
+
+  assert(wand != (const DrawingWand *) NULL);
+  assert(wand->signature == WandSignature);
+  if (wand->debug != MagickFalse)
+    (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  if (wand->image == (Image *) NULL)
+    ThrowDrawException(WandError,"ContainsNoImages",wand->name);
+  CurrentContext->primitive=wand->mvg;
+  display_list=AcquireDisplayList(wand->image,CurrentContext,wand->exception);
+  CurrentContext->primitive=(char *) NULL;
+  if (display_list == (DisplayListInfo *) NULL)
+    return(MagickFalse);
+  status=DrawDisplayList(wand->image,display_list,parameters);
+  InheritException(wand->exception,&wand->image->exception);
+  display_list=DestroyDisplayList(display_list);
+  return(status);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
 %   D r a w R e s e t V e c t o r G r a p h i c s                             %
 %                                                                             %
 %                                                                             %
@@ -4775,6 +4829,41 @@ WandExport void DrawSetOpacity(DrawingWand *wand,const double opacity)
 %                                                                             %
 %                                                                             %
 %                                                                             %
+%   D r a w S e t F i l l P a r a m e t e r                                   %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  DrawSetFillParameter() sets the fill color to the named parameter.  The
+%  color is bound when the drawing is rendered with DrawRenderDisplayList().
+%
+%  The format of the DrawSetFillParameter method is:
+%
+%      void DrawSetFillParameter(DrawingWand *wand,const char *name)
+%
+%  A description of each parameter follows:
+%
+%    o wand: the drawing wand.
+%
+%    o name: the parameter name.
+%
+*/
+WandExport void DrawSetFillParameter(DrawingWand *wand,const char *name)
+{
+  assert(wand != (DrawingWand *) NULL);
+  assert(wand->signature == WandSignature);
+  if (wand->debug != MagickFalse)
+    (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",name);
+  assert(name != (const char *) NULL);
+  (void) MvgPrintf(wand,"fill '$%s'\n",name);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
 %   D r a w S e t F i l l P a t t e r n U R L                                 %
 %                                                                             %
 %                                                                             %
@@ -5221,6 +5310,41 @@ WandExport void DrawSetStrokeColor(DrawingWand *wand,
 %                                                                             %
 %                                                                             %
 %                                                                             %
+%   D r a w S e t S t r o k e P a r a m e t e r                               %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  DrawSetStrokeParameter() sets the stroke color to the named parameter.  The
+%  color is bound when the drawing is rendered with DrawRenderDisplayList().
+%
+%  The format of the DrawSetStrokeParameter method is:
+%
+%      void DrawSetStrokeParameter(DrawingWand *wand,const char *name)
+%
+%  A description of each parameter follows:
+%
+%    o wand: the drawing wand.
+%
+%    o name: the parameter name.
+%
+*/
+WandExport void DrawSetStrokeParameter(DrawingWand *wand,const char *name)
+{
+  assert(wand != (DrawingWand *) NULL);
+  assert(wand->signature == WandSignature);
+  if (wand->debug != MagickFalse)
+    (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",name);
+  assert(name != (const char *) NULL);
+  (void) MvgPrintf(wand,"stroke '$%s'\n",name);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
 %   D r a w S e t S t r o k e P a t t e r n U R L                             %
 %                                                                             %
 %                                                                             %
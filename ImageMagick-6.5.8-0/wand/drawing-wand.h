@@ -91,6 +91,7 @@ extern WandExport MagickBooleanType
   DrawPushPattern(DrawingWand *,const char *,const double,const double,
     const double,const double),
   DrawRender(DrawingWand *),
+  DrawRenderDisplayList(DrawingWand *,const char **),
   DrawSetClipPath(DrawingWand *,const char *),
   DrawSetFillPatternURL(DrawingWand *,const char *),
   DrawSetFont(DrawingWand *,const char *),
@@ -184,6 +185,7 @@ extern WandExport void
   DrawSetClipUnits(DrawingWand *,const ClipPathUnits),
   DrawSetFillColor(DrawingWand *,const PixelWand *),
   DrawSetFillOpacity(DrawingWand *,const double),
+  DrawSetFillParameter(DrawingWand *,const char *),
   DrawSetFillRule(DrawingWand *,const FillRule),
   DrawSetFontSize(DrawingWand *,const double),
   DrawSetFontStretch(DrawingWand *,const StretchType),
@@ -198,6 +200,7 @@ extern WandExport void
   DrawSetStrokeLineJoin(DrawingWand *,const LineJoin),
   DrawSetStrokeMiterLimit(DrawingWand *,const unsigned long),
   DrawSetStrokeOpacity(DrawingWand *, const double),
+  DrawSetStrokeParameter(DrawingWand *,const char *),
   DrawSetStrokeWidth(DrawingWand *,const double),
   DrawSetTextAlignment(DrawingWand *,const AlignType),
   DrawSetTextAntialias(DrawingWand *,const MagickBooleanType),
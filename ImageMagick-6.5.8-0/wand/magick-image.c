@@ -131,6 +131,7 @@ static MagickWand *CloneMagickWandFromImages(const MagickWand *wand,
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 %
 %  GetImageFromMagickWand() returns the current image from the magick wand.
+%  In deferred mode, the recorded operations are applied first.
 %
 %  The format of the GetImageFromMagickWand method is:
 %
@@ -147,6 +148,7 @@ WandExport Image *GetImageFromMagickWand(const MagickWand *wand)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations((MagickWand *) wand);
   if (wand->images == (Image *) NULL)
     {
       (void) ThrowMagickException(wand->exception,GetMagickModule(),WandError,
@@ -214,6 +216,7 @@ WandExport MagickBooleanType MagickAdaptiveBlurImageChannel(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   sharp_image=AdaptiveBlurImageChannel(wand->images,channel,radius,sigma,
@@ -260,6 +263,7 @@ WandExport MagickBooleanType MagickAdaptiveResizeImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   resize_image=AdaptiveResizeImage(wand->images,columns,rows,wand->exception);
@@ -327,6 +331,7 @@ WandExport MagickBooleanType MagickAdaptiveSharpenImageChannel(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   sharp_image=AdaptiveSharpenImageChannel(wand->images,channel,radius,sigma,
@@ -379,6 +384,7 @@ WandExport MagickBooleanType MagickAdaptiveThresholdImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   threshold_image=AdaptiveThresholdImage(wand->images,width,height,offset,
@@ -422,6 +428,7 @@ static inline MagickBooleanType InsertImageInWand(MagickWand *wand,
   Image
     *sentinel;
 
+  (void) MagickApplyDeferredOperations(wand);
   sentinel=wand->images;
   if (sentinel == (Image *) NULL)
     {
@@ -519,6 +526,7 @@ WandExport MagickBooleanType MagickAddNoiseImageChannel(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   noise_image=AddNoiseImageChannel(wand->images,channel,noise_type,
@@ -568,6 +576,7 @@ WandExport MagickBooleanType MagickAffineTransformImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   draw_info=PeekDrawingWand(drawing_wand);
@@ -633,6 +642,7 @@ WandExport MagickBooleanType MagickAnnotateImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   draw_info=PeekDrawingWand(drawing_wand);
@@ -687,6 +697,7 @@ WandExport MagickBooleanType MagickAnimateImages(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   (void) CloneString(&wand->image_info->server_name,server_name);
   status=AnimateImages(wand->image_info,wand->images);
   if (status == MagickFalse)
@@ -730,6 +741,7 @@ WandExport MagickWand *MagickAppendImages(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     return((MagickWand *) NULL);
   append_image=AppendImages(wand->images,stack,wand->exception);
@@ -743,6 +755,56 @@ WandExport MagickWand *MagickAppendImages(MagickWand *wand,
 %                                                                             %
 %                                                                             %
 %                                                                             %
+%   M a g i c k A p p l y D e f e r r e d O p e r a t i o n s                 %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  MagickApplyDeferredOperations() runs the operations recorded for the
+%  current image since MagickSetDeferredMode() enabled deferred mode, and
+%  replaces the image with the result.  The wand stays in deferred mode.
+%
+%  The format of the MagickApplyDeferredOperations method is:
+%
+%      MagickBooleanType MagickApplyDeferredOperations(MagickWand *wand)
+%
+%  A description of each parameter follows:
+%
+%    o wand: the magick wand.
+%
+*/
+WandExport MagickBooleanType MagickApplyDeferredOperations(MagickWand *wand)
+{
+  Image
+    *operation_image;
+
+  assert(wand != (MagickWand *) NULL);
+  assert(wand->signature == WandSignature);
+  if ((wand->operations == (OperationInfo *) NULL) ||
+      (GetNumberOfOperations(wand->operations) == 0))
+    return(MagickTrue);
+  if (wand->debug != MagickFalse)
+    (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  if (wand->images == (Image *) NULL)
+    {
+      ResetOperationInfo(wand->operations);
+      ThrowWandException(WandError,"ContainsNoImages",wand->name);
+    }
+  operation_image=ApplyImageOperations(wand->images,wand->operations,
+    wand->exception);
+  ResetOperationInfo(wand->operations);
+  if (operation_image == (Image *) NULL)
+    return(MagickFalse);
+  ReplaceImageInList(&wand->images,operation_image);
+  return(MagickTrue);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
 %   M a g i c k A u t o G a m m a I m a g e                                   %
 %                                                                             %
 %                                                                             %
@@ -784,6 +846,7 @@ WandExport MagickBooleanType MagickAutoGammaImageChannel(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   status=AutoGammaImageChannel(wand->images,channel);
@@ -838,6 +901,7 @@ WandExport MagickBooleanType MagickAutoLevelImageChannel(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   status=AutoLevelImageChannel(wand->images,channel);
@@ -877,6 +941,7 @@ WandExport MagickWand *MagickAverageImages(MagickWand *wand)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     return((MagickWand *) NULL);
   average_image=AverageImages(wand->images,wand->exception);
@@ -925,6 +990,7 @@ WandExport MagickBooleanType MagickBlackThresholdImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   (void) FormatMagickString(thresholds,MaxTextExtent,
@@ -973,6 +1039,7 @@ WandExport MagickBooleanType MagickBlueShiftImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   shift_image=BlueShiftImage(wand->images,factor,wand->exception);
@@ -1038,6 +1105,7 @@ WandExport MagickBooleanType MagickBlurImageChannel(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   blur_image=BlurImageChannel(wand->images,channel,radius,sigma,
@@ -1093,6 +1161,7 @@ WandExport MagickBooleanType MagickBorderImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   border_info.width=width;
@@ -1145,6 +1214,7 @@ WandExport MagickBooleanType MagickCharcoalImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   charcoal_image=CharcoalImage(wand->images,radius,sigma,wand->exception);
@@ -1202,6 +1272,7 @@ WandExport MagickBooleanType MagickChopImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   chop.width=width;
@@ -1261,6 +1332,7 @@ WandExport MagickBooleanType MagickClampImageChannel(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   status=ClampImageChannel(wand->images,channel);
@@ -1301,6 +1373,7 @@ WandExport MagickBooleanType MagickClipImage(MagickWand *wand)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   status=ClipImage(wand->images);
@@ -1351,6 +1424,7 @@ WandExport MagickBooleanType MagickClipImagePath(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   status=ClipImagePath(wand->images,pathname,inside);
@@ -1407,6 +1481,7 @@ WandExport MagickBooleanType MagickClutImageChannel(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if ((wand->images == (Image *) NULL) || (clut_wand->images == (Image *) NULL))
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   status=ClutImageChannel(wand->images,channel,clut_wand->images);
@@ -1451,6 +1526,7 @@ WandExport MagickWand *MagickCoalesceImages(MagickWand *wand)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     return((MagickWand *) NULL);
   coalesce_image=CoalesceImages(wand->images,wand->exception);
@@ -1512,6 +1588,7 @@ WandExport MagickBooleanType MagickColorDecisionListImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   status=ColorDecisionListImage(wand->images,color_correction_collection);
@@ -1563,6 +1640,7 @@ WandExport MagickBooleanType MagickColorizeImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   (void) FormatMagickString(percent_opaque,MaxTextExtent,"%g,%g,%g,%g",
@@ -1617,6 +1695,7 @@ WandExport MagickWand *MagickCombineImages(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     return((MagickWand *) NULL);
   combine_image=CombineImages(wand->images,channel,wand->exception);
@@ -1660,6 +1739,7 @@ WandExport MagickBooleanType MagickCommentImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   status=SetImageProperty(wand->images,"comment",comment);
@@ -1712,6 +1792,7 @@ WandExport MagickWand *MagickCompareImageChannels(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if ((wand->images == (Image *) NULL) || (reference->images == (Image *) NULL))
     {
       (void) ThrowMagickException(wand->exception,GetMagickModule(),WandError,
@@ -1762,6 +1843,7 @@ WandExport MagickWand *MagickCompareImageLayers(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     return((MagickWand *) NULL);
   layers_image=CompareImageLayers(wand->images,method,wand->exception);
@@ -1892,6 +1974,7 @@ WandExport MagickBooleanType MagickCompositeImageChannel(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if ((wand->images == (Image *) NULL) ||
       (composite_wand->images == (Image *) NULL))
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
@@ -1940,6 +2023,7 @@ WandExport MagickBooleanType MagickContrastImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   status=ContrastImage(wand->images,sharpen);
@@ -2005,6 +2089,7 @@ WandExport MagickBooleanType MagickContrastStretchImageChannel(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   status=ContrastStretchImageChannel(wand->images,channel,black_point,
@@ -2069,6 +2154,7 @@ WandExport MagickBooleanType MagickConvolveImageChannel(MagickWand *wand,
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
   if (kernel == (const double *) NULL)
     return(MagickFalse);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   convolve_image=ConvolveImageChannel(wand->images,channel,order,kernel,
@@ -2131,6 +2217,8 @@ WandExport MagickBooleanType MagickCropImage(MagickWand *wand,
   crop.height=height;
   crop.x=x;
   crop.y=y;
+  if (wand->operations != (OperationInfo *) NULL)
+    return(AppendCropOperation(wand->operations,&crop));
   crop_image=CropImage(wand->images,&crop,wand->exception);
   if (crop_image == (Image *) NULL)
     return(MagickFalse);
@@ -2175,6 +2263,7 @@ WandExport MagickBooleanType MagickCycleColormapImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   status=CycleColormapImage(wand->images,displace);
@@ -2284,6 +2373,7 @@ WandExport MagickBooleanType MagickDecipherImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   return(DecipherImage(wand->images,passphrase,&wand->images->exception));
@@ -2322,6 +2412,7 @@ WandExport MagickWand *MagickDeconstructImages(MagickWand *wand)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     return((MagickWand *) NULL);
   deconstruct_image=DeconstructImages(wand->images,wand->exception);
@@ -2368,6 +2459,7 @@ WandExport MagickBooleanType MagickDeskewImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   sepia_image=DeskewImage(wand->images,threshold,wand->exception);
@@ -2409,6 +2501,7 @@ WandExport MagickBooleanType MagickDespeckleImage(MagickWand *wand)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   despeckle_image=DespeckleImage(wand->images,wand->exception);
@@ -2484,6 +2577,7 @@ WandExport MagickBooleanType MagickDisplayImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   image=CloneImage(wand->images,0,0,MagickTrue,wand->exception);
@@ -2532,6 +2626,7 @@ WandExport MagickBooleanType MagickDisplayImages(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   (void) CloneString(&wand->image_info->server_name,server_name);
   status=DisplayImages(wand->image_info,wand->images);
   if (status == MagickFalse)
@@ -2610,6 +2705,7 @@ WandExport MagickBooleanType MagickDistortImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   distort_image=DistortImage(wand->images,method,number_arguments,arguments,
@@ -2661,6 +2757,7 @@ WandExport MagickBooleanType MagickDrawImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   draw_info=PeekDrawingWand(drawing_wand);
@@ -2714,6 +2811,7 @@ WandExport MagickBooleanType MagickEdgeImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   edge_image=EdgeImage(wand->images,radius,wand->exception);
@@ -2765,6 +2863,7 @@ WandExport MagickBooleanType MagickEmbossImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   emboss_image=EmbossImage(wand->images,radius,sigma,wand->exception);
@@ -2806,6 +2905,7 @@ WandExport MagickBooleanType MagickEncipherImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   return(EncipherImage(wand->images,passphrase,&wand->images->exception));
@@ -2843,6 +2943,7 @@ WandExport MagickBooleanType MagickEnhanceImage(MagickWand *wand)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   enhance_image=EnhanceImage(wand->images,wand->exception);
@@ -2898,6 +2999,7 @@ WandExport MagickBooleanType MagickEqualizeImageChannel(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   status=EqualizeImageChannel(wand->images,channel);
@@ -2952,6 +3054,7 @@ WandExport MagickBooleanType MagickEvaluateImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   status=EvaluateImage(wand->images,op,value,&wand->images->exception);
@@ -2970,6 +3073,7 @@ WandExport MagickBooleanType MagickEvaluateImageChannel(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   status=EvaluateImageChannel(wand->images,channel,op,value,
@@ -3040,6 +3144,7 @@ WandExport MagickBooleanType MagickExportImagePixels(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   status=ExportImagePixels(wand->images,x,y,columns,rows,map,
@@ -3097,6 +3202,7 @@ WandExport MagickBooleanType MagickExtentImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   extent.width=width;
@@ -3142,6 +3248,7 @@ WandExport MagickBooleanType MagickFlipImage(MagickWand *wand)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   flip_image=FlipImage(wand->images,wand->exception);
@@ -3214,6 +3321,7 @@ WandExport MagickBooleanType MagickFloodfillPaintImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   draw_info=CloneDrawInfo(wand->image_info,(DrawInfo *) NULL);
@@ -3263,6 +3371,7 @@ WandExport MagickBooleanType MagickFlopImage(MagickWand *wand)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   flop_image=FlopImage(wand->images,wand->exception);
@@ -3310,6 +3419,7 @@ WandExport MagickBooleanType MagickForwardFourierTransformImage(
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   forward_image=ForwardFourierTransformImage(wand->images,magnitude,
@@ -3372,6 +3482,7 @@ WandExport MagickBooleanType MagickFrameImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   (void) ResetMagickMemory(&frame_info,0,sizeof(frame_info));
@@ -3439,6 +3550,7 @@ WandExport MagickBooleanType MagickFunctionImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   status=FunctionImage(wand->images,function,number_arguments,arguments,
@@ -3459,6 +3571,7 @@ WandExport MagickBooleanType MagickFunctionImageChannel(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   status=FunctionImageChannel(wand->images,channel,function,number_arguments,
@@ -3514,6 +3627,7 @@ WandExport MagickWand *MagickFxImageChannel(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     return((MagickWand *) NULL);
   fx_image=FxImageChannel(wand->images,channel,expression,wand->exception);
@@ -3580,6 +3694,8 @@ WandExport MagickBooleanType MagickGammaImageChannel(MagickWand *wand,
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
+  if (wand->operations != (OperationInfo *) NULL)
+    return(AppendGammaOperation(wand->operations,channel,gamma));
   status=GammaImageChannel(wand->images,channel,gamma);
   if (status == MagickFalse)
     InheritException(wand->exception,&wand->images->exception);
@@ -3642,6 +3758,7 @@ WandExport MagickBooleanType MagickGaussianBlurImageChannel(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   blur_image=GaussianBlurImageChannel(wand->images,channel,radius,sigma,
@@ -3683,6 +3800,7 @@ WandExport MagickWand *MagickGetImage(MagickWand *wand)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     {
       (void) ThrowMagickException(wand->exception,GetMagickModule(),WandError,
@@ -3725,6 +3843,7 @@ WandExport MagickBooleanType MagickGetImageAlphaChannel(MagickWand *wand)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   return(GetImageAlphaChannel(wand->images));
@@ -3761,6 +3880,7 @@ WandExport MagickWand *MagickGetImageClipMask(MagickWand *wand)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     {
       (void) ThrowMagickException(wand->exception,GetMagickModule(),WandError,
@@ -3805,6 +3925,7 @@ WandExport MagickBooleanType MagickGetImageBackgroundColor(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   PixelSetQuantumColor(background_color,&wand->images->background_color);
@@ -3845,6 +3966,7 @@ WandExport unsigned char *MagickGetImageBlob(MagickWand *wand,size_t *length)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     {
       (void) ThrowMagickException(wand->exception,GetMagickModule(),WandError,
@@ -3894,6 +4016,7 @@ WandExport unsigned char *MagickGetImagesBlob(MagickWand *wand,size_t *length)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     {
       (void) ThrowMagickException(wand->exception,GetMagickModule(),WandError,
@@ -3940,6 +4063,7 @@ WandExport MagickBooleanType MagickGetImageBluePrimary(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   *x=wand->images->chromaticity.blue_primary.x;
@@ -3979,6 +4103,7 @@ WandExport MagickBooleanType MagickGetImageBorderColor(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   PixelSetQuantumColor(border_color,&wand->images->border_color);
@@ -4017,6 +4142,7 @@ WandExport unsigned long MagickGetImageChannelDepth(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   return(GetImageChannelDepth(wand->images,channel,wand->exception));
@@ -4068,6 +4194,7 @@ WandExport MagickBooleanType MagickGetImageChannelDistortion(MagickWand *wand,
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
   assert(reference != (MagickWand *) NULL);
   assert(reference->signature == WandSignature);
+  (void) MagickApplyDeferredOperations(wand);
   if ((wand->images == (Image *) NULL) || (reference->images == (Image *) NULL))
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   status=GetImageChannelDistortion(wand->images,reference->images,channel,
@@ -4168,6 +4295,7 @@ WandExport MagickBooleanType MagickGetImageChannelMean(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   status=GetImageChannelMean(wand->images,channel,mean,standard_deviation,
@@ -4215,6 +4343,7 @@ WandExport MagickBooleanType MagickGetImageChannelKurtosis(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   status=GetImageChannelKurtosis(wand->images,channel,kurtosis,skewness,
@@ -4261,6 +4390,7 @@ WandExport MagickBooleanType MagickGetImageChannelRange(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   status=GetImageChannelRange(wand->images,channel,minima,maxima,
@@ -4304,6 +4434,7 @@ WandExport ChannelStatistics *MagickGetImageChannelStatistics(MagickWand *wand)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     {
       (void) ThrowMagickException(wand->exception,GetMagickModule(),WandError,
@@ -4348,6 +4479,7 @@ WandExport MagickBooleanType MagickGetImageColormapColor(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   if ((wand->images->colormap == (PixelPacket *) NULL) ||
@@ -4389,6 +4521,7 @@ WandExport unsigned long MagickGetImageColors(MagickWand *wand)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     {
       (void) ThrowMagickException(wand->exception,GetMagickModule(),WandError,
@@ -4426,6 +4559,7 @@ WandExport ColorspaceType MagickGetImageColorspace(MagickWand *wand)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     {
       (void) ThrowMagickException(wand->exception,GetMagickModule(),WandError,
@@ -4464,6 +4598,7 @@ WandExport CompositeOperator MagickGetImageCompose(MagickWand *wand)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     {
       (void) ThrowMagickException(wand->exception,GetMagickModule(),WandError,
@@ -4501,6 +4636,7 @@ WandExport CompressionType MagickGetImageCompression(MagickWand *wand)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     {
       (void) ThrowMagickException(wand->exception,GetMagickModule(),WandError,
@@ -4538,6 +4674,7 @@ WandExport unsigned long MagickGetImageCompressionQuality(MagickWand *wand)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     {
       (void) ThrowMagickException(wand->exception,GetMagickModule(),WandError,
@@ -4575,6 +4712,7 @@ WandExport unsigned long MagickGetImageDelay(MagickWand *wand)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   return(wand->images->delay);
@@ -4608,6 +4746,7 @@ WandExport unsigned long MagickGetImageDepth(MagickWand *wand)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   return(wand->images->depth);
@@ -4655,6 +4794,7 @@ WandExport MagickBooleanType MagickGetImageDistortion(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if ((wand->images == (Image *) NULL) || (reference->images == (Image *) NULL))
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   status=GetImageDistortion(wand->images,reference->images,metric,distortion,
@@ -4690,6 +4830,7 @@ WandExport DisposeType MagickGetImageDispose(MagickWand *wand)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     {
       (void) ThrowMagickException(wand->exception,GetMagickModule(),WandError,
@@ -4728,6 +4869,7 @@ WandExport char *MagickGetImageFilename(MagickWand *wand)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     {
       (void) ThrowMagickException(wand->exception,GetMagickModule(),WandError,
@@ -4766,6 +4908,7 @@ WandExport char *MagickGetImageFormat(MagickWand *wand)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     {
       (void) ThrowMagickException(wand->exception,GetMagickModule(),WandError,
@@ -4803,6 +4946,7 @@ WandExport double MagickGetImageFuzz(MagickWand *wand)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     {
       (void) ThrowMagickException(wand->exception,GetMagickModule(),WandError,
@@ -4840,6 +4984,7 @@ WandExport double MagickGetImageGamma(MagickWand *wand)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     {
       (void) ThrowMagickException(wand->exception,GetMagickModule(),WandError,
@@ -4877,6 +5022,7 @@ WandExport GravityType MagickGetImageGravity(MagickWand *wand)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     {
       (void) ThrowMagickException(wand->exception,GetMagickModule(),WandError,
@@ -4920,6 +5066,7 @@ WandExport MagickBooleanType MagickGetImageGreenPrimary(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   *x=wand->images->chromaticity.green_primary.x;
@@ -4955,6 +5102,7 @@ WandExport unsigned long MagickGetImageHeight(MagickWand *wand)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   return(wand->images->rows);
@@ -5003,6 +5151,7 @@ WandExport PixelWand **MagickGetImageHistogram(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     {
       (void) ThrowMagickException(wand->exception,GetMagickModule(),WandError,
@@ -5051,6 +5200,7 @@ WandExport InterlaceType MagickGetImageInterlaceScheme(MagickWand *wand)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     {
       (void) ThrowMagickException(wand->exception,GetMagickModule(),WandError,
@@ -5090,6 +5240,7 @@ WandExport InterpolatePixelMethod MagickGetImageInterpolateMethod(
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     {
       (void) ThrowMagickException(wand->exception,GetMagickModule(),WandError,
@@ -5127,6 +5278,7 @@ WandExport unsigned long MagickGetImageIterations(MagickWand *wand)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   return(wand->images->iterations);
@@ -5164,6 +5316,7 @@ WandExport MagickBooleanType MagickGetImageLength(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   *length=GetBlobSize(wand->images);
@@ -5202,6 +5355,7 @@ WandExport MagickBooleanType MagickGetImageMatteColor(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   PixelSetQuantumColor(matte_color,&wand->images->matte_color);
@@ -5236,6 +5390,7 @@ WandExport OrientationType MagickGetImageOrientation(MagickWand *wand)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     {
       (void) ThrowMagickException(wand->exception,GetMagickModule(),WandError,
@@ -5283,6 +5438,7 @@ WandExport MagickBooleanType MagickGetImagePage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   *width=wand->images->page.width;
@@ -5335,6 +5491,7 @@ WandExport MagickBooleanType MagickGetImagePixelColor(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   image_view=AcquireCacheView(wand->images);
@@ -5392,6 +5549,7 @@ WandExport MagickBooleanType MagickGetImageRange(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   status=GetImageRange(wand->images,minima,maxima,wand->exception);
@@ -5432,6 +5590,7 @@ WandExport MagickBooleanType MagickGetImageRedPrimary(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   *x=wand->images->chromaticity.red_primary.x;
@@ -5486,6 +5645,7 @@ WandExport MagickWand *MagickGetImageRegion(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     return((MagickWand *) NULL);
   region.width=width;
@@ -5526,6 +5686,7 @@ WandExport RenderingIntent MagickGetImageRenderingIntent(MagickWand *wand)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     {
       (void) ThrowMagickException(wand->exception,GetMagickModule(),WandError,
@@ -5569,6 +5730,7 @@ WandExport MagickBooleanType MagickGetImageResolution(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   *x=wand->images->x_resolution;
@@ -5604,6 +5766,7 @@ WandExport unsigned long MagickGetImageScene(MagickWand *wand)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   return(wand->images->scene);
@@ -5644,6 +5807,7 @@ WandExport char *MagickGetImageSignature(MagickWand *wand)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     {
       (void) ThrowMagickException(wand->exception,GetMagickModule(),WandError,
@@ -5688,6 +5852,7 @@ WandExport unsigned long MagickGetImageTicksPerSecond(MagickWand *wand)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   return((unsigned long) wand->images->ticks_per_second);
@@ -5729,6 +5894,7 @@ WandExport ImageType MagickGetImageType(MagickWand *wand)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     {
       (void) ThrowMagickException(wand->exception,GetMagickModule(),WandError,
@@ -5766,6 +5932,7 @@ WandExport ResolutionType MagickGetImageUnits(MagickWand *wand)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     {
       (void) ThrowMagickException(wand->exception,GetMagickModule(),WandError,
@@ -5804,6 +5971,7 @@ WandExport VirtualPixelMethod MagickGetImageVirtualPixelMethod(MagickWand *wand)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     {
       (void) ThrowMagickException(wand->exception,GetMagickModule(),WandError,
@@ -5847,6 +6015,7 @@ WandExport MagickBooleanType MagickGetImageWhitePoint(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   *x=wand->images->chromaticity.white_point.x;
@@ -5882,6 +6051,7 @@ WandExport unsigned long MagickGetImageWidth(MagickWand *wand)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   return(wand->images->columns);
@@ -5947,6 +6117,7 @@ WandExport double MagickGetImageTotalInkDensity(MagickWand *wand)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     {
       (void) ThrowMagickException(wand->exception,GetMagickModule(),WandError,
@@ -6008,6 +6179,7 @@ WandExport MagickBooleanType MagickHaldClutImageChannel(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if ((wand->images == (Image *) NULL) || (hald_wand->images == (Image *) NULL))
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   status=HaldClutImageChannel(wand->images,channel,hald_wand->images);
@@ -6045,6 +6217,7 @@ WandExport MagickBooleanType MagickHasNextImage(MagickWand *wand)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   if (GetNextImageInList(wand->images) == (Image *) NULL)
@@ -6081,6 +6254,7 @@ WandExport MagickBooleanType MagickHasPreviousImage(MagickWand *wand)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   if (GetPreviousImageInList(wand->images) == (Image *) NULL)
@@ -6127,6 +6301,7 @@ WandExport char *MagickIdentifyImage(MagickWand *wand)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     {
       (void) ThrowMagickException(wand->exception,GetMagickModule(),WandError,
@@ -6189,6 +6364,7 @@ WandExport MagickBooleanType MagickImplodeImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   implode_image=ImplodeImage(wand->images,amount,wand->exception);
@@ -6261,6 +6437,7 @@ WandExport MagickBooleanType MagickImportImagePixels(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   status=ImportImagePixels(wand->images,x,y,columns,rows,map,storage,pixels);
@@ -6316,6 +6493,7 @@ WandExport MagickBooleanType MagickInverseFourierTransformImage(
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",
       magnitude_wand->name);
   wand=magnitude_wand;
+  (void) MagickApplyDeferredOperations(wand);
   if (magnitude_wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",
       magnitude_wand->name);
@@ -6363,6 +6541,7 @@ WandExport MagickBooleanType MagickLabelImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   status=SetImageProperty(wand->images,"label",label);
@@ -6437,6 +6616,9 @@ WandExport MagickBooleanType MagickLevelImageChannel(MagickWand *wand,
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
+  if (wand->operations != (OperationInfo *) NULL)
+    return(AppendLevelOperation(wand->operations,channel,black_point,
+      white_point,gamma));
   status=LevelImageChannel(wand->images,channel,black_point,white_point,gamma);
   if (status == MagickFalse)
     InheritException(wand->exception,&wand->images->exception);
@@ -6483,6 +6665,7 @@ WandExport MagickBooleanType MagickLinearStretchImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   status=LinearStretchImage(wand->images,black_point,white_point);
@@ -6532,6 +6715,7 @@ WandExport MagickBooleanType MagickLiquidRescaleImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   rescale_image=LiquidRescaleImage(wand->images,columns,rows,delta_x,
@@ -6574,6 +6758,7 @@ WandExport MagickBooleanType MagickMagnifyImage(MagickWand *wand)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   magnify_image=MagnifyImage(wand->images,wand->exception);
@@ -6620,6 +6805,7 @@ WandExport MagickBooleanType MagickMedianFilterImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   median_image=MedianFilterImage(wand->images,radius,wand->exception);
@@ -6682,6 +6868,7 @@ WandExport MagickWand *MagickMergeImageLayers(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     return((MagickWand *) NULL);
   mosaic_image=MergeImageLayers(wand->images,method,wand->exception);
@@ -6722,6 +6909,7 @@ WandExport MagickBooleanType MagickMinifyImage(MagickWand *wand)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   minify_image=MinifyImage(wand->images,wand->exception);
@@ -6780,6 +6968,7 @@ WandExport MagickBooleanType MagickModulateImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   (void) FormatMagickString(modulate,MaxTextExtent,"%g,%g,%g",brightness,
@@ -6850,6 +7039,7 @@ WandExport MagickWand *MagickMontageImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     return((MagickWand *) NULL);
   montage_info=CloneMontageInfo(wand->image_info,(MontageInfo *) NULL);
@@ -6940,6 +7130,7 @@ WandExport MagickWand *MagickMorphImages(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     return((MagickWand *) NULL);
   morph_image=MorphImages(wand->images,number_frames,wand->exception);
@@ -7009,6 +7200,7 @@ WandExport MagickBooleanType MagickMotionBlurImageChannel(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   blur_image=MotionBlurImageChannel(wand->images,channel,radius,sigma,angle,
@@ -7076,6 +7268,8 @@ WandExport MagickBooleanType MagickNegateImageChannel(MagickWand *wand,
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
+  if (wand->operations != (OperationInfo *) NULL)
+    return(AppendNegateOperation(wand->operations,channel,gray));
   status=NegateImageChannel(wand->images,channel,gray);
   if (status == MagickFalse)
     InheritException(wand->exception,&wand->images->exception);
@@ -7165,6 +7359,7 @@ WandExport MagickBooleanType MagickNextImage(MagickWand *wand)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   if (wand->pend != MagickFalse)
@@ -7231,6 +7426,7 @@ WandExport MagickBooleanType MagickNormalizeImageChannel(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   status=NormalizeImageChannel(wand->images,channel);
@@ -7276,6 +7472,7 @@ WandExport MagickBooleanType MagickOilPaintImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   paint_image=OilPaintImage(wand->images,radius,wand->exception);
@@ -7356,6 +7553,7 @@ WandExport MagickBooleanType MagickOpaquePaintImageChannel(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   PixelGetMagickColor(target,&target_pixel);
@@ -7402,6 +7600,7 @@ WandExport MagickWand *MagickOptimizeImageLayers(MagickWand *wand)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     return((MagickWand *) NULL);
   optimize_image=OptimizeImageLayers(wand->images,wand->exception);
@@ -7480,6 +7679,7 @@ WandExport MagickBooleanType MagickOrderedPosterizeImageChannel(
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   status=OrderedPosterizeImageChannel(wand->images,channel,threshold_map,
@@ -7673,6 +7873,7 @@ WandExport MagickBooleanType MagickPolaroidImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   draw_info=PeekDrawingWand(drawing_wand);
@@ -7724,6 +7925,7 @@ WandExport MagickBooleanType MagickPosterizeImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   status=PosterizeImage(wand->images,levels,dither);
@@ -7770,6 +7972,7 @@ WandExport MagickWand *MagickPreviewImages(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     return((MagickWand *) NULL);
   preview_image=PreviewImage(wand->images,preview,wand->exception);
@@ -7807,6 +8010,7 @@ WandExport MagickBooleanType MagickPreviousImage(MagickWand *wand)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   if (wand->pend != MagickFalse)
@@ -7889,6 +8093,7 @@ WandExport MagickBooleanType MagickQuantizeImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   quantize_info=CloneQuantizeInfo((QuantizeInfo *) NULL);
@@ -7970,6 +8175,7 @@ WandExport MagickBooleanType MagickQuantizeImages(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   quantize_info=CloneQuantizeInfo((QuantizeInfo *) NULL);
@@ -8034,6 +8240,7 @@ WandExport MagickBooleanType MagickRadialBlurImageChannel(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   blur_image=RadialBlurImageChannel(wand->images,channel,angle,
@@ -8090,6 +8297,7 @@ WandExport MagickBooleanType MagickRaiseImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   raise_info.width=width;
@@ -8159,6 +8367,7 @@ WandExport MagickBooleanType MagickRandomThresholdImageChannel(
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   (void) FormatMagickString(threshold,MaxTextExtent,"%gx%g",low,high);
@@ -8352,6 +8561,7 @@ WandExport MagickBooleanType MagickRecolorImage(MagickWand *wand,
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
   if (color_matrix == (const double *) NULL)
     return(MagickFalse);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   transform_image=RecolorImage(wand->images,order,color_matrix,
@@ -8400,6 +8610,7 @@ WandExport MagickBooleanType MagickReduceNoiseImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   noise_image=ReduceNoiseImage(wand->images,radius,wand->exception);
@@ -8451,6 +8662,7 @@ WandExport MagickBooleanType MagickRemapImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if ((wand->images == (Image *) NULL) ||
       (remap_wand->images == (Image *) NULL))
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
@@ -8495,6 +8707,7 @@ WandExport MagickBooleanType MagickRemoveImage(MagickWand *wand)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   DeleteImageFromList(&wand->images);
@@ -8554,6 +8767,7 @@ WandExport MagickBooleanType MagickResampleImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   resample_image=ResampleImage(wand->images,x_resolution,y_resolution,filter,
@@ -8596,6 +8810,7 @@ WandExport MagickBooleanType MagickResetImagePage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   if ((page == (char *) NULL) || (*page == '\0'))
@@ -8662,6 +8877,8 @@ WandExport MagickBooleanType MagickResizeImage(MagickWand *wand,
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
+  if (wand->operations != (OperationInfo *) NULL)
+    return(AppendResizeOperation(wand->operations,columns,rows,filter,blur));
   resize_image=ResizeImage(wand->images,columns,rows,filter,blur,
     wand->exception);
   if (resize_image == (Image *) NULL)
@@ -8708,6 +8925,7 @@ WandExport MagickBooleanType MagickRollImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   roll_image=RollImage(wand->images,x,y,wand->exception);
@@ -8757,6 +8975,7 @@ WandExport MagickBooleanType MagickRotateImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   PixelGetQuantumColor(background,&wand->images->background_color);
@@ -8807,6 +9026,7 @@ WandExport MagickBooleanType MagickSampleImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   sample_image=SampleImage(wand->images,columns,rows,wand->exception);
@@ -8854,6 +9074,7 @@ WandExport MagickBooleanType MagickScaleImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   scale_image=ScaleImage(wand->images,columns,rows,wand->exception);
@@ -8983,6 +9204,7 @@ WandExport MagickBooleanType MagickSelectiveBlurImageChannel(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   blur_image=SelectiveBlurImageChannel(wand->images,channel,radius,sigma,
@@ -9030,6 +9252,7 @@ WandExport MagickBooleanType MagickSeparateImageChannel(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   status=SeparateImageChannel(wand->images,channel);
@@ -9076,6 +9299,7 @@ WandExport MagickBooleanType MagickSepiaToneImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   sepia_image=SepiaToneImage(wand->images,threshold,wand->exception);
@@ -9126,6 +9350,7 @@ WandExport MagickBooleanType MagickSetImage(MagickWand *wand,
   assert(set_wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",set_wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (set_wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   images=CloneImageList(set_wand->images,wand->exception);
@@ -9169,6 +9394,7 @@ WandExport MagickBooleanType MagickSetImageAlphaChannel(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   return(SetImageAlphaChannel(wand->images,alpha_type));
@@ -9206,6 +9432,7 @@ WandExport MagickBooleanType MagickSetImageBackgroundColor(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   PixelGetQuantumColor(background,&wand->images->background_color);
@@ -9245,6 +9472,7 @@ WandExport MagickBooleanType MagickSetImageBias(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   wand->images->bias=bias;
@@ -9285,6 +9513,7 @@ WandExport MagickBooleanType MagickSetImageBluePrimary(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   wand->images->chromaticity.blue_primary.x=x;
@@ -9324,6 +9553,7 @@ WandExport MagickBooleanType MagickSetImageBorderColor(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   PixelGetQuantumColor(border,&wand->images->border_color);
@@ -9364,6 +9594,7 @@ WandExport MagickBooleanType MagickSetImageChannelDepth(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   return(SetImageChannelDepth(wand->images,channel,depth));
@@ -9401,6 +9632,7 @@ WandExport MagickBooleanType MagickSetImageClipMask(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   assert(clip_mask != (MagickWand *) NULL);
   assert(clip_mask->signature == WandSignature);
   if (wand->debug != MagickFalse)
@@ -9445,6 +9677,7 @@ WandExport MagickBooleanType MagickSetImageColormapColor(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   if ((wand->images->colormap == (PixelPacket *) NULL) ||
@@ -9490,6 +9723,7 @@ WandExport MagickBooleanType MagickSetImageColorspace(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   return(SetImageColorspace(wand->images,colorspace));
@@ -9529,6 +9763,7 @@ WandExport MagickBooleanType MagickSetImageCompose(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   wand->images->compose=compose;
@@ -9567,6 +9802,7 @@ WandExport MagickBooleanType MagickSetImageCompression(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   wand->images->compression=compression;
@@ -9605,6 +9841,7 @@ WandExport MagickBooleanType MagickSetImageCompressionQuality(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   wand->images->quality=quality;
@@ -9643,6 +9880,7 @@ WandExport MagickBooleanType MagickSetImageDelay(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   wand->images->delay=delay;
@@ -9681,6 +9919,7 @@ WandExport MagickBooleanType MagickSetImageDepth(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   wand->images->depth=depth;
@@ -9719,6 +9958,7 @@ WandExport MagickBooleanType MagickSetImageDispose(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   wand->images->dispose=dispose;
@@ -9759,6 +9999,7 @@ WandExport MagickBooleanType MagickSetImageExtent(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   return(SetImageExtent(wand->images,columns,rows));
@@ -9797,6 +10038,7 @@ WandExport MagickBooleanType MagickSetImageFilename(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   if (filename != (const char *) NULL)
@@ -9840,6 +10082,7 @@ WandExport MagickBooleanType MagickSetImageFormat(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   if ((format == (char *) NULL) || (*format == '\0'))
@@ -9887,6 +10130,7 @@ WandExport MagickBooleanType MagickSetImageFuzz(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   wand->images->fuzz=fuzz;
@@ -9925,6 +10169,7 @@ WandExport MagickBooleanType MagickSetImageGamma(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   wand->images->gamma=gamma;
@@ -9964,6 +10209,7 @@ WandExport MagickBooleanType MagickSetImageGravity(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   wand->images->gravity=gravity;
@@ -10006,6 +10252,7 @@ WandExport MagickBooleanType MagickSetImageGreenPrimary(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   wand->images->chromaticity.green_primary.x=x;
@@ -10046,6 +10293,7 @@ WandExport MagickBooleanType MagickSetImageInterlaceScheme(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   wand->images->interlace=interlace;
@@ -10085,6 +10333,7 @@ WandExport MagickBooleanType MagickSetImageInterpolateMethod(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   wand->images->interpolate=method;
@@ -10123,6 +10372,7 @@ WandExport MagickBooleanType MagickSetImageIterations(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   wand->images->iterations=iterations;
@@ -10162,6 +10412,7 @@ WandExport MagickBooleanType MagickSetImageMatte(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   if ((wand->images->matte == MagickFalse) && (matte != MagickFalse))
@@ -10202,6 +10453,7 @@ WandExport MagickBooleanType MagickSetImageMatteColor(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   PixelGetQuantumColor(matte,&wand->images->matte_color);
@@ -10244,6 +10496,7 @@ WandExport MagickBooleanType MagickSetImageOpacity(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   status=SetImageOpacity(wand->images,RoundToQuantum((MagickRealType)
@@ -10285,6 +10538,7 @@ WandExport MagickBooleanType MagickSetImageOrientation(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   wand->images->orientation=orientation;
@@ -10331,6 +10585,7 @@ WandExport MagickBooleanType MagickSetImagePage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   wand->images->page.width=width;
@@ -10387,6 +10642,7 @@ WandExport MagickProgressMonitor MagickSetImageProgressMonitor(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     {
       (void) ThrowMagickException(wand->exception,GetMagickModule(),WandError,
@@ -10432,6 +10688,7 @@ WandExport MagickBooleanType MagickSetImageRedPrimary(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   wand->images->chromaticity.red_primary.x=x;
@@ -10472,6 +10729,7 @@ WandExport MagickBooleanType MagickSetImageRenderingIntent(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   wand->images->rendering_intent=rendering_intent;
@@ -10512,6 +10770,7 @@ WandExport MagickBooleanType MagickSetImageResolution(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   wand->images->x_resolution=x_resolution;
@@ -10551,6 +10810,7 @@ WandExport MagickBooleanType MagickSetImageScene(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   wand->images->scene=scene;
@@ -10589,6 +10849,7 @@ WandExport MagickBooleanType MagickSetImageTicksPerSecond(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   wand->images->ticks_per_second=ticks_per_second;
@@ -10630,6 +10891,7 @@ WandExport MagickBooleanType MagickSetImageType(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   return(SetImageType(wand->images,image_type));
@@ -10668,6 +10930,7 @@ WandExport MagickBooleanType MagickSetImageUnits(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   wand->images->units=units;
@@ -10708,6 +10971,7 @@ WandExport VirtualPixelMethod MagickSetImageVirtualPixelMethod(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     return(UndefinedVirtualPixelMethod);
   return(SetImageVirtualPixelMethod(wand->images,method));
@@ -10747,6 +11011,7 @@ WandExport MagickBooleanType MagickSetImageWhitePoint(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   wand->images->chromaticity.white_point.x=x;
@@ -10795,6 +11060,7 @@ WandExport MagickBooleanType MagickShadeImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   shade_image=ShadeImage(wand->images,gray,asimuth,elevation,wand->exception);
@@ -10845,6 +11111,7 @@ WandExport MagickBooleanType MagickShadowImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   shadow_image=ShadowImage(wand->images,opacity,sigma,x,y,wand->exception);
@@ -10912,6 +11179,8 @@ WandExport MagickBooleanType MagickSharpenImageChannel(MagickWand *wand,
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
+  if (wand->operations != (OperationInfo *) NULL)
+    return(AppendSharpenOperation(wand->operations,channel,radius,sigma));
   sharp_image=SharpenImageChannel(wand->images,channel,radius,sigma,
     wand->exception);
   if (sharp_image == (Image *) NULL)
@@ -10963,6 +11232,7 @@ WandExport MagickBooleanType MagickShaveImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   shave_info.width=columns;
@@ -11021,6 +11291,7 @@ WandExport MagickBooleanType MagickShearImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   PixelGetQuantumColor(background,&wand->images->background_color);
@@ -11095,6 +11366,7 @@ WandExport MagickBooleanType MagickSigmoidalContrastImageChannel(
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   status=SigmoidalContrastImageChannel(wand->images,channel,sharpen,alpha,beta);
@@ -11145,6 +11417,7 @@ WandExport MagickWand *MagickSimilarityImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if ((wand->images == (Image *) NULL) || (reference->images == (Image *) NULL))
     {
       (void) ThrowMagickException(wand->exception,GetMagickModule(),WandError,
@@ -11202,6 +11475,7 @@ WandExport MagickBooleanType MagickSketchImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   sketch_image=SketchImage(wand->images,radius,sigma,angle,wand->exception);
@@ -11249,6 +11523,7 @@ WandExport MagickBooleanType MagickSolarizeImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   status=SolarizeImage(wand->images,threshold);
@@ -11319,6 +11594,7 @@ WandExport MagickBooleanType MagickSparseColorImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   sparse_image=SparseColorImage(wand->images,channel,method,number_arguments,
@@ -11375,6 +11651,7 @@ WandExport MagickBooleanType MagickSpliceImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   splice.width=width;
@@ -11423,6 +11700,7 @@ WandExport MagickBooleanType MagickSpreadImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   spread_image=SpreadImage(wand->images,radius,wand->exception);
@@ -11472,6 +11750,7 @@ WandExport MagickWand *MagickSteganoImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if ((wand->images == (Image *) NULL) ||
       (watermark_wand->images == (Image *) NULL))
     {
@@ -11523,6 +11802,7 @@ WandExport MagickWand *MagickStereoImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if ((wand->images == (Image *) NULL) ||
       (offset_wand->images == (Image *) NULL))
     {
@@ -11541,6 +11821,72 @@ WandExport MagickWand *MagickStereoImage(MagickWand *wand,
 %                                                                             %
 %                                                                             %
 %                                                                             %
+%   M a g i c k S t r e a m R e s i z e I m a g e                             %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  MagickStreamResizeImage() reads an image and scales it to the desired
+%  dimensions as its scanlines are decoded, so the full-size image is never
+%  held in memory.  The resized image is inserted at the current image pointer
+%  position, as with MagickReadImage().
+%
+%  The format of the MagickStreamResizeImage method is:
+%
+%      MagickBooleanType MagickStreamResizeImage(MagickWand *wand,
+%        const char *filename,const unsigned long columns,
+%        const unsigned long rows,const FilterTypes filter,const double blur)
+%
+%  A description of each parameter follows:
+%
+%    o wand: the magick wand.
+%
+%    o filename: the image filename.
+%
+%    o columns: the number of columns in the scaled image.
+%
+%    o rows: the number of rows in the scaled image.
+%
+%    o filter: Image filter to use.
+%
+%    o blur: the blur factor where > 1 is blurry, < 1 is sharp.
+%
+*/
+WandExport MagickBooleanType MagickStreamResizeImage(MagickWand *wand,
+  const char *filename,const unsigned long columns,const unsigned long rows,
+  const FilterTypes filter,const double blur)
+{
+  char
+    geometry[MaxTextExtent];
+
+  Image
+    *resize_image;
+
+  ImageInfo
+    *read_info;
+
+  assert(wand != (MagickWand *) NULL);
+  assert(wand->signature == WandSignature);
+  if (wand->debug != MagickFalse)
+    (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  read_info=CloneImageInfo(wand->image_info);
+  if (filename != (const char *) NULL)
+    (void) CopyMagickString(read_info->filename,filename,MaxTextExtent);
+  (void) FormatMagickString(geometry,MaxTextExtent,"%lux%lu!",columns,rows);
+  resize_image=StreamResizeImage(read_info,geometry,filter,blur,
+    wand->exception);
+  read_info=DestroyImageInfo(read_info);
+  if (resize_image == (Image *) NULL)
+    return(MagickFalse);
+  return(InsertImageInWand(wand,resize_image));
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
 %   M a g i c k S t r i p I m a g e                                           %
 %                                                                             %
 %                                                                             %
@@ -11567,6 +11913,7 @@ WandExport MagickBooleanType MagickStripImage(MagickWand *wand)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   status=StripImage(wand->images);
@@ -11611,6 +11958,7 @@ WandExport MagickBooleanType MagickSwirlImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   swirl_image=SwirlImage(wand->images,degrees,wand->exception);
@@ -11659,6 +12007,7 @@ WandExport MagickWand *MagickTextureImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if ((wand->images == (Image *) NULL) ||
       (texture_wand->images == (Image *) NULL))
     {
@@ -11730,6 +12079,7 @@ WandExport MagickBooleanType MagickThresholdImageChannel(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   status=BilevelImageChannel(wand->images,channel,threshold);
@@ -11777,6 +12127,7 @@ WandExport MagickBooleanType MagickThumbnailImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   thumbnail_image=ThumbnailImage(wand->images,columns,rows,wand->exception);
@@ -11832,6 +12183,7 @@ WandExport MagickBooleanType MagickTintImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   (void) FormatMagickString(percent_opaque,MaxTextExtent,"%g,%g,%g,%g",
@@ -11892,6 +12244,7 @@ WandExport MagickWand *MagickTransformImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     return((MagickWand *) NULL);
   transform_image=CloneImage(wand->images,0,0,MagickTrue,wand->exception);
@@ -11943,6 +12296,7 @@ WandExport MagickBooleanType MagickTransformImageColorspace(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   return(TransformImageColorspace(wand->images,colorspace));
@@ -12002,6 +12356,7 @@ WandExport MagickBooleanType MagickTransparentPaintImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   PixelGetMagickColor(target,&target_pixel);
@@ -12045,6 +12400,7 @@ WandExport MagickBooleanType MagickTransposeImage(MagickWand *wand)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   transpose_image=TransposeImage(wand->images,wand->exception);
@@ -12086,6 +12442,7 @@ WandExport MagickBooleanType MagickTransverseImage(MagickWand *wand)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   transverse_image=TransverseImage(wand->images,wand->exception);
@@ -12133,6 +12490,7 @@ WandExport MagickBooleanType MagickTrimImage(MagickWand *wand,const double fuzz)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   wand->images->fuzz=fuzz;
@@ -12174,6 +12532,7 @@ WandExport MagickBooleanType MagickUniqueImageColors(MagickWand *wand)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   unique_image=UniqueImageColors(wand->images,wand->exception);
@@ -12249,6 +12608,7 @@ WandExport MagickBooleanType MagickUnsharpMaskImageChannel(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   unsharp_image=UnsharpMaskImageChannel(wand->images,channel,radius,sigma,
@@ -12299,6 +12659,7 @@ WandExport MagickBooleanType MagickVignetteImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   vignette_image=VignetteImage(wand->images,black_point,white_point,x,y,
@@ -12347,6 +12708,7 @@ WandExport MagickBooleanType MagickWaveImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   wave_image=WaveImage(wand->images,amplitude,wave_length,wand->exception);
@@ -12396,6 +12758,7 @@ WandExport MagickBooleanType MagickWhiteThresholdImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   (void) FormatMagickString(thresholds,MaxTextExtent,
@@ -12452,6 +12815,7 @@ WandExport MagickBooleanType MagickWriteImage(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   if (filename != (const char *) NULL)
@@ -12510,6 +12874,7 @@ WandExport MagickBooleanType MagickWriteImageFile(MagickWand *wand,FILE *file)
   assert(file != (FILE *) NULL);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   image=CloneImage(wand->images,0,0,MagickTrue,wand->exception);
@@ -12566,6 +12931,7 @@ WandExport MagickBooleanType MagickWriteImages(MagickWand *wand,
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   write_info=CloneImageInfo(wand->image_info);
@@ -12613,6 +12979,7 @@ WandExport MagickBooleanType MagickWriteImagesFile(MagickWand *wand,FILE *file)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   if (wand->images == (Image *) NULL)
     ThrowWandException(WandError,"ContainsNoImages",wand->name);
   write_info=CloneImageInfo(wand->image_info);
@@ -85,6 +85,7 @@ extern WandExport MagickBooleanType
   MagickAnnotateImage(MagickWand *,const DrawingWand *,const double,
     const double,const double,const char *),
   MagickAnimateImages(MagickWand *,const char *),
+  MagickApplyDeferredOperations(MagickWand *),
   MagickAutoGammaImage(MagickWand *),
   MagickAutoGammaImageChannel(MagickWand *,const ChannelType),
   MagickAutoLevelImage(MagickWand *),
@@ -330,6 +331,8 @@ extern WandExport MagickBooleanType
   MagickSpliceImage(MagickWand *,const unsigned long,const unsigned long,
     const long,const long),
   MagickSpreadImage(MagickWand *,const double),
+  MagickStreamResizeImage(MagickWand *,const char *,const unsigned long,
+    const unsigned long,const FilterTypes,const double),
   MagickStripImage(MagickWand *),
   MagickSwirlImage(MagickWand *,const double),
   MagickTintImage(MagickWand *,const PixelWand *,const PixelWand *),
@@ -368,6 +368,40 @@ WandExport const char *MagickGetCopyright(void)
 %                                                                             %
 %                                                                             %
 %                                                                             %
+%   M a g i c k G e t D e f e r r e d M o d e                                 %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  MagickGetDeferredMode() returns MagickTrue if the wand records crop,
+%  resize, sharpen, level, gamma, and negate operations instead of running
+%  them.
+%
+%  The format of the MagickGetDeferredMode method is:
+%
+%      MagickBooleanType MagickGetDeferredMode(const MagickWand *wand)
+%
+%  A description of each parameter follows:
+%
+%    o wand: the magick wand.
+%
+*/
+WandExport MagickBooleanType MagickGetDeferredMode(const MagickWand *wand)
+{
+  assert(wand != (const MagickWand *) NULL);
+  assert(wand->signature == WandSignature);
+  if (wand->debug != MagickFalse)
+    (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  return(wand->operations != (OperationInfo *) NULL ? MagickTrue :
+    MagickFalse);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
 %   M a g i c k G e t F i l e n a m e                                         %
 %                                                                             %
 %                                                                             %
@@ -1398,6 +1432,39 @@ WandExport MagickSizeType MagickGetResource(const ResourceType type)
 %                                                                             %
 %                                                                             %
 %                                                                             %
+%   M a g i c k G e t R e s o u r c e C o n t e x t                           %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  MagickGetResourceContext() returns the resource context the wand charges
+%  its images to, or NULL if there is none.  The context remains owned by the
+%  wand.
+%
+%  The format of the MagickGetResourceContext method is:
+%
+%      ResourceContext *MagickGetResourceContext(const MagickWand *wand)
+%
+%  A description of each parameter follows:
+%
+%    o wand: the magick wand.
+%
+*/
+WandExport ResourceContext *MagickGetResourceContext(const MagickWand *wand)
+{
+  assert(wand != (const MagickWand *) NULL);
+  assert(wand->signature == WandSignature);
+  if (wand->debug != MagickFalse)
+    (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  return(wand->image_info->resource_context);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
 %   M a g i c k G e t R e s o u r c e L i m i t                               %
 %                                                                             %
 %                                                                             %
@@ -1932,6 +1999,62 @@ WandExport MagickBooleanType MagickSetCompressionQuality(MagickWand *wand,
 %                                                                             %
 %                                                                             %
 %                                                                             %
+%   M a g i c k S e t D e f e r r e d M o d e                                 %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  MagickSetDeferredMode() selects whether the wand runs crop, resize,
+%  sharpen, level, gamma, and negate operations on the current image when
+%  they are called, or records them and runs them together, reordered so that
+%  crops come as early as possible and consecutive level, gamma, and negate
+%  operations share one pass over the pixels.  The recorded operations run
+%  when another wand method needs the current image, when the iterator moves,
+%  or when you call MagickApplyDeferredOperations().  Images taken from other
+%  wands, such as a composite source, are used without their recorded
+%  operations.
+%
+%  The format of the MagickSetDeferredMode method is:
+%
+%      MagickBooleanType MagickSetDeferredMode(MagickWand *wand,
+%        const MagickBooleanType deferred)
+%
+%  A description of each parameter follows:
+%
+%    o wand: the magick wand.
+%
+%    o deferred: MagickTrue to record operations, MagickFalse to run them
+%      immediately.  Operations recorded so far run first.
+%
+*/
+WandExport MagickBooleanType MagickSetDeferredMode(MagickWand *wand,
+  const MagickBooleanType deferred)
+{
+  MagickBooleanType
+    status;
+
+  assert(wand != (MagickWand *) NULL);
+  assert(wand->signature == WandSignature);
+  if (wand->debug != MagickFalse)
+    (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  if (deferred != MagickFalse)
+    {
+      if (wand->operations == (OperationInfo *) NULL)
+        wand->operations=AcquireOperationInfo();
+      return(MagickTrue);
+    }
+  status=MagickApplyDeferredOperations(wand);
+  if (wand->operations != (OperationInfo *) NULL)
+    wand->operations=DestroyOperationInfo(wand->operations);
+  return(status);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
 %   M a g i c k S e t D e p t h                                               %
 %                                                                             %
 %                                                                             %
@@ -2637,6 +2760,53 @@ WandExport MagickProgressMonitor MagickSetProgressMonitor(MagickWand *wand,
 %                                                                             %
 %                                                                             %
 %                                                                             %
+%   M a g i c k S e t R e s o u r c e C o n t e x t                           %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  MagickSetResourceContext() charges the area, memory, map, disk and file
+%  resources of images the wand subsequently reads or creates to a resource
+%  context, in addition to the process-wide pool, and caps the OpenMP team
+%  size while they are read or written.  The wand takes a reference to the
+%  context; pass NULL to detach it.  To hold image operators to the context's
+%  thread limit as well, bind it to the calling thread with
+%  SetThreadResourceContext().
+%
+%  The format of the MagickSetResourceContext method is:
+%
+%      MagickBooleanType MagickSetResourceContext(MagickWand *wand,
+%        ResourceContext *resource_context)
+%
+%  A description of each parameter follows:
+%
+%    o wand: the magick wand.
+%
+%    o resource_context: the resource context.
+%
+*/
+WandExport MagickBooleanType MagickSetResourceContext(MagickWand *wand,
+  ResourceContext *resource_context)
+{
+  assert(wand != (MagickWand *) NULL);
+  assert(wand->signature == WandSignature);
+  if (wand->debug != MagickFalse)
+    (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  if (resource_context != (ResourceContext *) NULL)
+    resource_context=ReferenceResourceContext(resource_context);
+  if (wand->image_info->resource_context != (ResourceContext *) NULL)
+    wand->image_info->resource_context=DestroyResourceContext(
+      wand->image_info->resource_context);
+  wand->image_info->resource_context=resource_context;
+  return(MagickTrue);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
 %   M a g i c k S e t R e s o u r c e L i m i t                               %
 %                                                                             %
 %                                                                             %
@@ -81,6 +81,7 @@ extern WandExport MagickBooleanType
   MagickDeleteImageProperty(MagickWand *,const char *),
   MagickDeleteOption(MagickWand *,const char *),
   MagickGetAntialias(const MagickWand *),
+  MagickGetDeferredMode(const MagickWand *),
   MagickGetPage(const MagickWand *,unsigned long *,unsigned long *,long *,
     long *),
   MagickGetSize(const MagickWand *,unsigned long *,unsigned long *),
@@ -91,6 +92,7 @@ extern WandExport MagickBooleanType
   MagickSetColorspace(MagickWand *,const ColorspaceType),
   MagickSetCompression(MagickWand *,const CompressionType),
   MagickSetCompressionQuality(MagickWand *,const unsigned long),
+  MagickSetDeferredMode(MagickWand *,const MagickBooleanType),
   MagickSetDepth(MagickWand *,const unsigned long),
   MagickSetExtract(MagickWand *,const char *),
   MagickSetFilename(MagickWand *,const char *),
@@ -109,6 +111,7 @@ extern WandExport MagickBooleanType
   MagickSetPassphrase(MagickWand *,const char *),
   MagickSetPointsize(MagickWand *,const double),
   MagickSetResolution(MagickWand *,const double,const double),
+  MagickSetResourceContext(MagickWand *,ResourceContext *),
   MagickSetResourceLimit(const ResourceType type,const MagickSizeType limit),
   MagickSetSamplingFactors(MagickWand *,const unsigned long,const double *),
   MagickSetSize(MagickWand *,const unsigned long,const unsigned long),
@@ -126,6 +129,9 @@ extern WandExport MagickSizeType
 extern WandExport PixelWand
   *MagickGetBackgroundColor(MagickWand *);
 
+extern WandExport ResourceContext
+  *MagickGetResourceContext(const MagickWand *);
+
 extern WandExport OrientationType
   MagickGetOrientationType(MagickWand *);
 
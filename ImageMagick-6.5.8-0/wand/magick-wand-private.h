@@ -51,6 +51,9 @@ struct _MagickWand
   Image
     *images;
 
+  OperationInfo
+    *operations;
+
   MagickBooleanType
     active,
     pend,
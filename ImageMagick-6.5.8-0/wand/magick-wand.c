@@ -92,6 +92,8 @@ WandExport void ClearMagickWand(MagickWand *wand)
   wand->quantize_info=DestroyQuantizeInfo(wand->quantize_info);
   wand->image_info=DestroyImageInfo(wand->image_info);
   wand->images=DestroyImageList(wand->images);
+  if (wand->operations != (OperationInfo *) NULL)
+    wand->operations=DestroyOperationInfo(wand->operations);
   wand->quantize_info=CloneQuantizeInfo((QuantizeInfo *) NULL);
   wand->image_info=AcquireImageInfo();
   ClearMagickException(wand->exception);
@@ -142,6 +144,8 @@ WandExport MagickWand *CloneMagickWand(const MagickWand *wand)
   clone_wand->image_info=CloneImageInfo(wand->image_info);
   clone_wand->quantize_info=CloneQuantizeInfo(wand->quantize_info);
   clone_wand->images=CloneImageList(wand->images,clone_wand->exception);
+  if (wand->operations != (OperationInfo *) NULL)
+    clone_wand->operations=CloneOperationInfo(wand->operations);
   clone_wand->debug=IsEventLogging();
   if (clone_wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",clone_wand->name);
@@ -180,6 +184,8 @@ WandExport MagickWand *DestroyMagickWand(MagickWand *wand)
   wand->quantize_info=DestroyQuantizeInfo(wand->quantize_info);
   wand->image_info=DestroyImageInfo(wand->image_info);
   wand->images=DestroyImageList(wand->images);
+  if (wand->operations != (OperationInfo *) NULL)
+    wand->operations=DestroyOperationInfo(wand->operations);
   wand->exception=DestroyExceptionInfo(wand->exception);
   RelinquishWandId(wand->id);
   wand->signature=(~WandSignature);
@@ -827,6 +833,7 @@ WandExport void MagickResetIterator(MagickWand *wand)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   wand->active=MagickFalse;
   wand->pend=MagickTrue;
   wand->images=GetFirstImageInList(wand->images);
@@ -860,6 +867,7 @@ WandExport void MagickSetFirstIterator(MagickWand *wand)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   wand->active=MagickTrue;
   wand->pend=MagickFalse;
   wand->images=GetFirstImageInList(wand->images);
@@ -903,6 +911,7 @@ WandExport MagickBooleanType MagickSetIteratorIndex(MagickWand *wand,
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
   if (wand->images == (Image *) NULL)
     return(MagickFalse);
+  (void) MagickApplyDeferredOperations(wand);
   image=GetImageFromList(wand->images,index);
   if (image == (Image *) NULL)
     {
@@ -942,6 +951,7 @@ WandExport void MagickSetLastIterator(MagickWand *wand)
   assert(wand->signature == WandSignature);
   if (wand->debug != MagickFalse)
     (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",wand->name);
+  (void) MagickApplyDeferredOperations(wand);
   wand->active=MagickFalse;
   wand->pend=MagickTrue;
   wand->images=GetLastImageInList(wand->images);
@@ -170,6 +170,30 @@ static inline Quantum PixelIntensityToQuantum(const PixelPacket *pixel)
 #endif
 }
 
+static inline Image *StreamResizeImages(const ImageInfo *image_info,
+  ExceptionInfo *exception)
+{
+  const char
+    *geometry,
+    *option;
+
+  FilterTypes
+    filter;
+
+  /*
+    With -stream-resize, scale the image as it is read; else read it whole.
+  */
+  geometry=GetImageOption(image_info,"stream-resize");
+  if (geometry == (const char *) NULL)
+    return(ReadImages(image_info,exception));
+  filter=UndefinedFilter;
+  option=GetImageOption(image_info,"filter");
+  if (option != (const char *) NULL)
+    filter=(FilterTypes) ParseMagickOption(MagickFilterOptions,MagickFalse,
+      option);
+  return(StreamResizeImage(image_info,geometry,filter,1.0,exception));
+}
+
 static inline void SetMagickPixelPacket(const Image *image,
   const PixelPacket *color,const IndexPacket *index,MagickPixelPacket *pixel)
 {
@@ -46,6 +46,7 @@
 */
 #include "wand/studio.h"
 #include "wand/MagickWand.h"
+#include "wand/magick-wand-private.h"
 #include "wand/mogrify-private.h"
 #include "magick/thread-private.h"
 
@@ -54,6 +55,23 @@
 */
 #define UndefinedCompressionQuality  0UL
 
+/*
+  Typedef declarations.
+*/
+typedef struct _MogrifyBatchInfo
+{
+  const char
+    **argv,
+    *format,
+    *path;
+
+  int
+    argc;
+
+  MagickBooleanType
+    global_colormap;
+} MogrifyBatchInfo;
+
 /*
   Constant declaration.
 */
@@ -657,6 +675,8 @@ WandExport MagickBooleanType MogrifyImage(ImageInfo *image_info,const int argc,
     if ((i+count) >= argc)
       break;
     status=MogrifyImageInfo(image_info,count+1,argv+i,exception);
+    TraceMagickEvent(OperatorTrace,BeginTracePhase,"MogrifyImage",option,
+      (MagickSizeType) (*image)->columns*(*image)->rows);
     switch (*(option+1))
     {
       case 'a':
@@ -3507,6 +3527,8 @@ WandExport MagickBooleanType MogrifyImage(ImageInfo *image_info,const int argc,
       default:
         break;
     }
+    TraceMagickEvent(OperatorTrace,EndTracePhase,"MogrifyImage",option,
+      (MagickSizeType) (*image)->columns*(*image)->rows);
     i+=count;
   }
   if (region_image != (Image *) NULL)
@@ -3801,6 +3823,8 @@ static MagickBooleanType MogrifyUsage(void)
       "-monitor             monitor progress",
       "-orient type         image orientation",
       "-page geometry       size and location of an image canvas (setting)",
+      "-parallel-files value",
+      "                     process this many files at once",
       "-ping                efficiently determine image attributes",
       "-pointsize value     font point size",
       "-preview type        image preview type",
@@ -3815,6 +3839,8 @@ static MagickBooleanType MogrifyUsage(void)
       "-scene value         image scene number",
       "-seed value          seed a new sequence of pseudo-random numbers",
       "-size geometry       width and height of image",
+      "-stream-resize geometry",
+      "                     resize the image as it is read, in bounded memory",
       "-stretch type        render text with this font stretch",
       "-stroke color        graphic primitive stroke color",
       "-strokewidth value   graphic primitive stroke width",
@@ -3880,6 +3906,125 @@ static MagickBooleanType MogrifyUsage(void)
   return(MagickFalse);
 }
 
+static MagickBooleanType WriteMogrifyImages(ImageInfo *image_info,
+  Image *images,ExceptionInfo *exception)
+{
+  char
+    backup_filename[MaxTextExtent];
+
+  MagickBooleanType
+    status;
+
+  register long
+    i;
+
+  *backup_filename='\0';
+  if ((LocaleCompare(images->filename,"-") != 0) &&
+      (IsPathWritable(images->filename) != MagickFalse))
+    {
+      /*
+        Rename image file as backup.
+      */
+      (void) CopyMagickString(backup_filename,images->filename,MaxTextExtent);
+      for (i=0; i < 6; i++)
+      {
+        (void) ConcatenateMagickString(backup_filename,"~",MaxTextExtent);
+        if (IsPathAccessible(backup_filename) == MagickFalse)
+          break;
+      }
+      if ((IsPathAccessible(backup_filename) != MagickFalse) ||
+          (rename(images->filename,backup_filename) != 0))
+        *backup_filename='\0';
+    }
+  /*
+    Write transmogrified image to disk.
+  */
+  image_info->synchronize=MagickTrue;
+  status=WriteImages(image_info,images,images->filename,exception);
+  if ((status == MagickFalse) && (*backup_filename != '\0'))
+    (void) remove(backup_filename);
+  return(status);
+}
+
+static MagickBooleanType MogrifyBatchImage(MagickWand *wand,
+  const char *filename,const unsigned long wand_unused(index),void *context)
+{
+  char
+    tail[MaxTextExtent];
+
+  Image
+    *images;
+
+  MogrifyBatchInfo
+    *batch_info;
+
+  MagickStatusType
+    status;
+
+  /*
+    Read, transmogrify, and write one file of a batch.
+  */
+  batch_info=(MogrifyBatchInfo *) context;
+  (void) CopyMagickString(wand->image_info->filename,filename,MaxTextExtent);
+  images=StreamResizeImages(wand->image_info,wand->exception);
+  if (images == (Image *) NULL)
+    return(MagickFalse);
+  status=wand->exception->severity < ErrorException ? MagickTrue : MagickFalse;
+  if (batch_info->path != (const char *) NULL)
+    {
+      GetPathComponent(filename,TailPath,tail);
+      (void) FormatMagickString(images->filename,MaxTextExtent,"%s%c%s",
+        batch_info->path,*DirectorySeparator,tail);
+    }
+  if (batch_info->format != (const char *) NULL)
+    AppendImageFormat(batch_info->format,images->filename);
+  (void) SyncImagesSettings(wand->image_info,images);
+  ResetImageOptions(wand->image_info);
+  status&=MogrifyImages(wand->image_info,MagickTrue,batch_info->argc,
+    batch_info->argv,&images,wand->exception);
+  if (images == (Image *) NULL)
+    return(MagickFalse);
+  InheritException(wand->exception,&images->exception);
+  (void) SyncImagesSettings(wand->image_info,images);
+  if (batch_info->global_colormap != MagickFalse)
+    {
+      QuantizeInfo
+        *quantize_info;
+
+      quantize_info=AcquireQuantizeInfo(wand->image_info);
+      (void) RemapImages(quantize_info,images,(Image *) NULL);
+      quantize_info=DestroyQuantizeInfo(quantize_info);
+    }
+  status&=WriteMogrifyImages(wand->image_info,images,wand->exception);
+  images=DestroyImageList(images);
+  return(status != 0 ? MagickTrue : MagickFalse);
+}
+
+static MagickBooleanType MogrifyImageFiles(ImageInfo *image_info,
+  const MogrifyBatchInfo *batch_info,const char **filenames,
+  const unsigned long number_files,const unsigned long parallel_files,
+  ExceptionInfo *exception)
+{
+  MagickBooleanType
+    status;
+
+  MagickWand
+    *wand;
+
+  /*
+    Transmogrify a run of files at once, each with the current settings.
+  */
+  wand=NewMagickWand();
+  wand->image_info=DestroyImageInfo(wand->image_info);
+  wand->image_info=CloneImageInfo(image_info);
+  status=MagickBatchProcess(wand,filenames,number_files,parallel_files,
+    MogrifyBatchImage,(void *) batch_info);
+  InheritException(exception,wand->exception);
+  wand=DestroyMagickWand(wand);
+  ResetImageOptions(image_info);
+  return(status);
+}
+
 WandExport MagickBooleanType MogrifyImageCommand(ImageInfo *image_info,
   int argc,char **argv,char **wand_unused(metadata),ExceptionInfo *exception)
 {
@@ -3937,6 +4082,10 @@ WandExport MagickBooleanType MogrifyImageCommand(ImageInfo *image_info,
   MagickStatusType
     status;
 
+  unsigned long
+    number_files,
+    parallel_files;
+
   /*
     Set defaults.
   */
@@ -3966,6 +4115,7 @@ WandExport MagickBooleanType MogrifyImageCommand(ImageInfo *image_info,
   format=(char *) NULL;
   path=(char *) NULL;
   global_colormap=MagickFalse;
+  parallel_files=1;
   k=0;
   j=1;
   NewImageStack();
@@ -4003,7 +4153,6 @@ WandExport MagickBooleanType MogrifyImageCommand(ImageInfo *image_info,
     if (IsMagickOption(option) == MagickFalse)
       {
         char
-          backup_filename[MaxTextExtent],
           *filename;
 
         Image
@@ -4013,11 +4162,39 @@ WandExport MagickBooleanType MogrifyImageCommand(ImageInfo *image_info,
           Option is a file name: begin by reading image from specified file.
         */
         FireImageStack(MagickFalse,MagickFalse,pend);
+        for (number_files=0; (i+(long) number_files) < argc; number_files++)
+        {
+          filename=argv[i+number_files];
+          if ((IsMagickOption(filename) != MagickFalse) ||
+              (LocaleCompare(filename,"(") == 0) ||
+              (LocaleCompare(filename,")") == 0) ||
+              (LocaleCompare(filename,"-") == 0) ||
+              (LocaleCompare(filename,"--") == 0))
+            break;
+        }
+        if ((parallel_files != 1) && (k == 0) && (number_files > 1))
+          {
+            MogrifyBatchInfo
+              batch_info;
+
+            /*
+              Transmogrify consecutive file names in parallel.
+            */
+            batch_info.argc=(int) (i-j+1);
+            batch_info.argv=(const char **) (argv+j);
+            batch_info.format=format;
+            batch_info.path=path;
+            batch_info.global_colormap=global_colormap;
+            status&=MogrifyImageFiles(image_info,&batch_info,(const char **)
+              (argv+i),number_files,parallel_files,exception);
+            i+=(long) number_files-1;
+            continue;
+          }
         filename=argv[i];
         if ((LocaleCompare(filename,"--") == 0) && (i < (argc-1)))
           filename=argv[++i];
         (void) CopyMagickString(image_info->filename,filename,MaxTextExtent);
-        images=ReadImages(image_info,exception);
+        images=StreamResizeImages(image_info,exception);
         status&=(images != (Image *) NULL) &&
           (exception->severity < ErrorException);
         if (images == (Image *) NULL)
@@ -4041,35 +4218,7 @@ WandExport MagickBooleanType MogrifyImageCommand(ImageInfo *image_info,
             (void) RemapImages(quantize_info,images,(Image *) NULL);
             quantize_info=DestroyQuantizeInfo(quantize_info);
           }
-        *backup_filename='\0';
-        if ((LocaleCompare(image->filename,"-") != 0) &&
-            (IsPathWritable(image->filename) != MagickFalse))
-          {
-            register long
-              i;
-
-            /*
-              Rename image file as backup.
-            */
-            (void) CopyMagickString(backup_filename,image->filename,
-              MaxTextExtent);
-            for (i=0; i < 6; i++)
-            {
-              (void) ConcatenateMagickString(backup_filename,"~",MaxTextExtent);
-              if (IsPathAccessible(backup_filename) == MagickFalse)
-                break;
-            }
-            if ((IsPathAccessible(backup_filename) != MagickFalse) ||
-                (rename(image->filename,backup_filename) != 0))
-              *backup_filename='\0';
-          }
-        /*
-          Write transmogrified image to disk.
-        */
-        image_info->synchronize=MagickTrue;
-        status&=WriteImages(image_info,image,image->filename,exception);
-        if ((status == MagickFalse) && (*backup_filename != '\0'))
-          (void) remove(backup_filename);
+        status&=WriteMogrifyImages(image_info,image,exception);
         RemoveAllImageStack();
         continue;
       }
@@ -5389,6 +5538,19 @@ WandExport MagickBooleanType MogrifyImageCommand(ImageInfo *image_info,
               ThrowMogrifyInvalidArgumentException(option,argv[i]);
             break;
           }
+        if (LocaleCompare("parallel-files",option+1) == 0)
+          {
+            parallel_files=1;
+            if (*option == '+')
+              break;
+            i++;
+            if (i == (long) argc)
+              ThrowMogrifyException(OptionError,"MissingArgument",option);
+            if (IsGeometry(argv[i]) == MagickFalse)
+              ThrowMogrifyInvalidArgumentException(option,argv[i]);
+            parallel_files=(unsigned long) atol(argv[i]);
+            break;
+          }
         if (LocaleCompare("path",option+1) == 0)
           {
             (void) CloneString(&path,(char *) NULL);
@@ -5826,6 +5988,17 @@ WandExport MagickBooleanType MogrifyImageCommand(ImageInfo *image_info,
               ThrowMogrifyInvalidArgumentException(option,argv[i]);
             break;
           }
+        if (LocaleCompare("stream-resize",option+1) == 0)
+          {
+            if (*option == '+')
+              break;
+            i++;
+            if (i == (long) argc)
+              ThrowMogrifyException(OptionError,"MissingArgument",option);
+            if (IsGeometry(argv[i]) == MagickFalse)
+              ThrowMogrifyInvalidArgumentException(option,argv[i]);
+            break;
+          }
         if (LocaleCompare("stretch",option+1) == 0)
           {
             long
@@ -7131,6 +7304,16 @@ WandExport MagickBooleanType MogrifyImageInfo(ImageInfo *image_info,
             (void) CloneString(&image_info->size,argv[i+1]);
             break;
           }
+        if (LocaleCompare("stream-resize",option+1) == 0)
+          {
+            if (*option == '+')
+              {
+                (void) DeleteImageOption(image_info,option+1);
+                break;
+              }
+            (void) SetImageOption(image_info,option+1,argv[i+1]);
+            break;
+          }
         if (LocaleCompare("stroke",option+1) == 0)
           {
             if (*option == '+')
@@ -7386,6 +7569,8 @@ WandExport MagickBooleanType MogrifyImageList(ImageInfo *image_info,
     if ((i+count) >= argc)
       break;
     status=MogrifyImageInfo(image_info,count+1,argv+i,exception);
+    TraceMagickEvent(OperatorTrace,BeginTracePhase,"MogrifyImageList",option,
+      0);
     switch (*(option+1))
     {
       case 'a':
@@ -8151,6 +8336,8 @@ WandExport MagickBooleanType MogrifyImageList(ImageInfo *image_info,
       default:
         break;
     }
+    TraceMagickEvent(OperatorTrace,EndTracePhase,"MogrifyImageList",option,
+      0);
     i+=count;
   }
   quantize_info=DestroyQuantizeInfo(quantize_info);
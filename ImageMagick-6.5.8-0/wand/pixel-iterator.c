@@ -306,6 +306,7 @@ WandExport PixelIterator *NewPixelIterator(MagickWand *wand)
   if (depth != MAGICKCORE_QUANTUM_DEPTH)
     ThrowWandFatalException(WandError,"QuantumDepthMismatch",quantum);
   assert(wand != (MagickWand *) NULL);
+  (void) MagickApplyDeferredOperations(wand);
   image=GetImageFromMagickWand(wand);
   if (image == (Image *) NULL)
     return((PixelIterator *) NULL);
@@ -421,6 +422,7 @@ WandExport PixelIterator *NewPixelRegionIterator(MagickWand *wand,const long x,
     ThrowWandFatalException(WandError,"QuantumDepthMismatch",quantum);
   if ((width == 0) || (width == 0))
     ThrowWandFatalException(WandError,"ZeroRegionSize",quantum);
+  (void) MagickApplyDeferredOperations(wand);
   image=GetImageFromMagickWand(wand);
   if (image == (Image *) NULL)
     return((PixelIterator *) NULL);
@@ -56,10 +56,45 @@
  Define declarations.
 */
 #define PixelViewId  "PixelView"
+#if defined(MAGICKCORE_WORDS_BIGENDIAN)
+#define PixelViewDirectMap  "RGBO"
+#else
+#define PixelViewDirectMap  "BGRO"
+#endif
 
 /*
   Typedef declarations.
 */
+typedef struct _RowInfo
+{
+  char
+    map[MaxTextExtent];
+
+  StorageType
+    storage;
+
+  PixelFormatInfo
+    *format_info;
+
+  MagickBooleanType
+    direct;
+
+  PixelPacket
+    *pixels;
+
+  IndexPacket
+    *indexes;
+
+  unsigned long
+    number_pixels;
+
+  void
+    *buffer;
+
+  size_t
+    extent;
+} RowInfo;
+
 struct _PixelView
 {
   unsigned long
@@ -86,6 +121,9 @@ struct _PixelView
   PixelWand
     ***pixel_wands;
 
+  RowInfo
+    *row_info;
+
   MagickBooleanType
     debug;
 
@@ -115,6 +153,19 @@ struct _PixelView
 %    o pixel_view: the pixel view.
 %
 */
+
+static RowInfo *AcquireRowInfoThreadSet(const unsigned long number_threads)
+{
+  RowInfo
+    *row_info;
+
+  row_info=(RowInfo *) AcquireAlignedMemory(number_threads,sizeof(*row_info));
+  if (row_info == (RowInfo *) NULL)
+    return((RowInfo *) NULL);
+  (void) ResetMagickMemory(row_info,0,number_threads*sizeof(*row_info));
+  return(row_info);
+}
+
 WandExport PixelView *ClonePixelView(const PixelView *pixel_view)
 {
   PixelView
@@ -140,6 +191,13 @@ WandExport PixelView *ClonePixelView(const PixelView *pixel_view)
   clone_view->view=CloneCacheView(pixel_view->view);
   clone_view->region=pixel_view->region;
   clone_view->number_threads=pixel_view->number_threads;
+  clone_view->pixel_wands=(PixelWand ***) AcquireAlignedMemory(
+    pixel_view->number_threads,sizeof(*clone_view->pixel_wands));
+  clone_view->row_info=AcquireRowInfoThreadSet(pixel_view->number_threads);
+  if ((clone_view->pixel_wands == (PixelWand ***) NULL) ||
+      (clone_view->row_info == (RowInfo *) NULL))
+    ThrowWandFatalException(ResourceLimitFatalError,"MemoryAllocationFailed",
+      pixel_view->name);
   for (i=0; i < (long) pixel_view->number_threads; i++)
     clone_view->pixel_wands[i]=ClonePixelWands((const PixelWand **)
       pixel_view->pixel_wands[i],pixel_view->region.width);
@@ -192,12 +250,32 @@ static PixelWand ***DestroyPixelsThreadSet(PixelWand ***pixel_wands,
   return(pixel_wands);
 }
 
+static RowInfo *DestroyRowInfoThreadSet(RowInfo *row_info,
+  const unsigned long number_threads)
+{
+  register long
+    i;
+
+  assert(row_info != (RowInfo *) NULL);
+  for (i=0; i < (long) number_threads; i++)
+  {
+    if (row_info[i].format_info != (PixelFormatInfo *) NULL)
+      row_info[i].format_info=DestroyPixelFormatInfo(row_info[i].format_info);
+    if (row_info[i].buffer != (void *) NULL)
+      row_info[i].buffer=RelinquishMagickMemory(row_info[i].buffer);
+  }
+  row_info=(RowInfo *) RelinquishAlignedMemory(row_info);
+  return(row_info);
+}
+
 WandExport PixelView *DestroyPixelView(PixelView *pixel_view)
 {
   assert(pixel_view != (PixelView *) NULL);
   assert(pixel_view->signature == WandSignature);
   pixel_view->pixel_wands=DestroyPixelsThreadSet(pixel_view->pixel_wands,
     pixel_view->region.width,pixel_view->number_threads);
+  pixel_view->row_info=DestroyRowInfoThreadSet(pixel_view->row_info,
+    pixel_view->number_threads);
   pixel_view->view=DestroyCacheView(pixel_view->view);
   pixel_view->exception=DestroyExceptionInfo(pixel_view->exception);
   pixel_view->signature=(~WandSignature);
@@ -401,6 +479,157 @@ WandExport MagickBooleanType DuplexTransferPixelViewIterator(
 %                                                                             %
 %                                                                             %
 %                                                                             %
+%   G e t P i x e l V i e w A u t h e n t i c R o w s                         %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  GetPixelViewAuthenticRows() returns the pixels of one or more rows of the
+%  pixel view, spanning the width of the view, as a contiguous array laid out
+%  as defined by map and storage.  Unlike the pixel view iterators, no pixel
+%  wands are involved: the pixels are converted in bulk, or when map is "BGRO"
+%  (little endian) or "RGBO" (big endian) and storage is QuantumPixel, the
+%  PixelPacket pixels of the pixel cache are returned directly.  The
+%  conversion is done by ExportPixelFormatPackets() and
+%  ImportPixelFormatPackets() with a pixel format compiled once per thread.  Call
+%  SyncPixelViewAuthenticRows() to write your changes back to the image.  The
+%  returned pointer remains valid until the next call to one of the pixel view
+%  row methods from the same thread.  The rows must be confined to the image
+%  canvas.
+%
+%  Each OpenMP thread has its own pixels so it is safe to call this method
+%  from within a parallel region once the image is DirectClass.
+%
+%  The format of the GetPixelViewAuthenticRows method is:
+%
+%      void *GetPixelViewAuthenticRows(PixelView *pixel_view,const long y,
+%        const unsigned long rows,const char *map,const StorageType storage)
+%
+%  A description of each parameter follows:
+%
+%    o pixel_view: the pixel view.
+%
+%    o y: the first image row.
+%
+%    o rows: the number of rows.
+%
+%    o map:  This string reflects the expected ordering of the pixel array.
+%      It can be any combination or order of R = red, G = green, B = blue,
+%      A = alpha (0 is transparent), O = opacity (0 is opaque), C = cyan,
+%      Y = yellow, M = magenta, K = black, I = intensity (for grayscale),
+%      P = pad.
+%
+%    o storage: Define the data type of the pixels.  Float and double types
+%      are normalized to [0..1] otherwise [0..QuantumRange].  Choose from these
+%      types: CharPixel, DoublePixel, FloatPixel, IntegerPixel, LongPixel,
+%      QuantumPixel, or ShortPixel.
+%
+*/
+
+static MagickBooleanType AcquireRowBuffer(RowInfo *row_info)
+{
+  size_t
+    extent;
+
+  extent=row_info->number_pixels*GetPixelFormatExtent(row_info->format_info);
+  if (extent <= row_info->extent)
+    return(MagickTrue);
+  if (row_info->buffer != (void *) NULL)
+    row_info->buffer=RelinquishMagickMemory(row_info->buffer);
+  row_info->extent=0;
+  row_info->buffer=AcquireMagickMemory(extent);
+  if (row_info->buffer == (void *) NULL)
+    return(MagickFalse);
+  row_info->extent=extent;
+  return(MagickTrue);
+}
+
+static MagickBooleanType SetRowInfoMap(PixelView *pixel_view,
+  RowInfo *row_info,const char *map,const StorageType storage)
+{
+  if ((pixel_view->wand->images->colorspace != CMYKColorspace) &&
+      (strpbrk(map,"CcKkMmYy") != (char *) NULL))
+    {
+      (void) ThrowMagickException(pixel_view->exception,GetMagickModule(),
+        ImageError,"ColorSeparatedImageRequired","`%s'",map);
+      return(MagickFalse);
+    }
+  if ((row_info->format_info != (PixelFormatInfo *) NULL) &&
+      (row_info->storage == storage) && (strcmp(row_info->map,map) == 0))
+    return(MagickTrue);
+  if (row_info->format_info != (PixelFormatInfo *) NULL)
+    row_info->format_info=DestroyPixelFormatInfo(row_info->format_info);
+  row_info->format_info=AcquirePixelFormatInfo(map,storage,
+    pixel_view->exception);
+  if (row_info->format_info == (PixelFormatInfo *) NULL)
+    return(MagickFalse);
+  (void) CopyMagickString(row_info->map,map,MaxTextExtent);
+  row_info->storage=storage;
+  row_info->direct=((storage == QuantumPixel) &&
+    (LocaleCompare(map,PixelViewDirectMap) == 0)) ? MagickTrue : MagickFalse;
+  return(MagickTrue);
+}
+
+WandExport void *GetPixelViewAuthenticRows(PixelView *pixel_view,
+  const long y,const unsigned long rows,const char *map,
+  const StorageType storage)
+{
+  Image
+    *image;
+
+  long
+    id;
+
+  PixelPacket
+    *pixels;
+
+  RowInfo
+    *row_info;
+
+  assert(pixel_view != (PixelView *) NULL);
+  assert(pixel_view->signature == WandSignature);
+  assert(map != (const char *) NULL);
+  if (pixel_view->debug != MagickFalse)
+    (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",pixel_view->name);
+  id=GetOpenMPThreadId();
+  row_info=pixel_view->row_info+id;
+  row_info->pixels=(PixelPacket *) NULL;
+  if (SetRowInfoMap(pixel_view,row_info,map,storage) == MagickFalse)
+    return((void *) NULL);
+  image=pixel_view->wand->images;
+  if (image->storage_class == PseudoClass)
+    if (SetImageStorageClass(image,DirectClass) == MagickFalse)
+      {
+        InheritException(pixel_view->exception,&image->exception);
+        return((void *) NULL);
+      }
+  pixels=GetCacheViewAuthenticPixels(pixel_view->view,pixel_view->region.x,y,
+    pixel_view->region.width,rows,pixel_view->exception);
+  if (pixels == (PixelPacket *) NULL)
+    return((void *) NULL);
+  row_info->pixels=pixels;
+  row_info->indexes=GetCacheViewAuthenticIndexQueue(pixel_view->view);
+  row_info->number_pixels=pixel_view->region.width*rows;
+  if (row_info->direct != MagickFalse)
+    return((void *) pixels);
+  if (AcquireRowBuffer(row_info) == MagickFalse)
+    {
+      row_info->pixels=(PixelPacket *) NULL;
+      (void) ThrowMagickException(pixel_view->exception,GetMagickModule(),
+        ResourceLimitError,"MemoryAllocationFailed","`%s'",pixel_view->name);
+      return((void *) NULL);
+    }
+  ExportPixelFormatPackets(row_info->format_info,pixels,row_info->indexes,
+    row_info->number_pixels,row_info->buffer);
+  return(row_info->buffer);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
 %   G e t P i x e l V i e w E x c e p t i o n                                 %
 %                                                                             %
 %                                                                             %
@@ -545,7 +774,9 @@ WandExport MagickBooleanType GetPixelViewIterator(PixelView *source,
   status=MagickTrue;
   progress=0;
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(NeighborhoodThreadCost,source->region.width, \
+      source->region.height)
 #endif
   for (y=source->region.y; y < (long) source->region.height; y++)
   {
@@ -635,6 +866,202 @@ WandExport PixelWand **GetPixelViewPixels(const PixelView *pixel_view)
 %                                                                             %
 %                                                                             %
 %                                                                             %
+%   G e t P i x e l V i e w R o w s I t e r a t o r                           %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  GetPixelViewRowsIterator() iterates over the pixel view in parallel and
+%  calls your get method for each band of rows of the view.  The pixels are
+%  handed to your method as returned by GetPixelViewVirtualRows() so no pixel
+%  wands are involved.  The pixel region is not confined to the image canvas--
+%  that is you can include negative offsets or widths or heights that exceed
+%  the image dimension.  Any updates to the pixels in your callback are
+%  ignored.
+%
+%  Use this pragma:
+%
+%    #pragma omp critical
+%
+%  to define a section of code in your callback get method that must be
+%  executed by a single thread at a time.
+%
+%  The format of the GetPixelViewRowsIterator method is:
+%
+%      MagickBooleanType GetPixelViewRowsIterator(PixelView *source,
+%        const char *map,const StorageType storage,const unsigned long rows,
+%        GetPixelViewRowsMethod get,void *context)
+%
+%  A description of each parameter follows:
+%
+%    o source: the source pixel view.
+%
+%    o map: the ordering of the pixel array (see GetPixelViewAuthenticRows()).
+%
+%    o storage: the data type of the pixels.
+%
+%    o rows: the number of rows handed to each call of your get method.
+%
+%    o get: the get callback method.
+%
+%    o context: the user defined context.
+%
+*/
+WandExport MagickBooleanType GetPixelViewRowsIterator(PixelView *source,
+  const char *map,const StorageType storage,const unsigned long rows,
+  GetPixelViewRowsMethod get,void *context)
+{
+#define GetPixelViewRowsTag  "PixelView/GetRows"
+
+  Image
+    *source_image;
+
+  long
+    progress,
+    y;
+
+  MagickBooleanType
+    status;
+
+  unsigned long
+    band;
+
+  assert(source != (PixelView *) NULL);
+  assert(source->signature == WandSignature);
+  if (get == (GetPixelViewRowsMethod) NULL)
+    return(MagickFalse);
+  source_image=source->wand->images;
+  band=rows == 0 ? 1UL : rows;
+  status=MagickTrue;
+  progress=0;
+#if defined(MAGICKCORE_OPENMP_SUPPORT)
+  #pragma omp parallel for schedule(dynamic,1) shared(progress,status)
+#endif
+  for (y=source->region.y; y < (long) (source->region.y+source->region.height);
+       y+=(long) band)
+  {
+    const void
+      *pixels;
+
+    unsigned long
+      height;
+
+    if (status == MagickFalse)
+      continue;
+    height=band;
+    if ((y+(long) height) > (long) (source->region.y+source->region.height))
+      height=(unsigned long) (source->region.y+source->region.height-y);
+    pixels=GetPixelViewVirtualRows(source,y,height,map,storage);
+    if (pixels == (const void *) NULL)
+      {
+        status=MagickFalse;
+        continue;
+      }
+    if (get(source,y,height,pixels,context) == MagickFalse)
+      status=MagickFalse;
+    if (source_image->progress_monitor != (MagickProgressMonitor) NULL)
+      {
+        MagickBooleanType
+          proceed;
+
+#if defined(MAGICKCORE_OPENMP_SUPPORT)
+  #pragma omp critical (MagickWand_GetPixelViewRowsIterator)
+#endif
+        {
+          progress+=(long) height;
+          proceed=SetImageProgress(source_image,GetPixelViewRowsTag,progress,
+            source->region.height);
+        }
+        if (proceed == MagickFalse)
+          status=MagickFalse;
+      }
+  }
+  return(status);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   G e t P i x e l V i e w V i r t u a l R o w s                             %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  GetPixelViewVirtualRows() returns read-only pixels of one or more rows of
+%  the pixel view laid out as defined by map and storage, just like
+%  GetPixelViewAuthenticRows() except that the rows are not confined to the
+%  image canvas and any changes to the pixels are ignored.
+%
+%  The format of the GetPixelViewVirtualRows method is:
+%
+%      const void *GetPixelViewVirtualRows(PixelView *pixel_view,
+%        const long y,const unsigned long rows,const char *map,
+%        const StorageType storage)
+%
+%  A description of each parameter follows:
+%
+%    o pixel_view: the pixel view.
+%
+%    o y: the first image row.
+%
+%    o rows: the number of rows.
+%
+%    o map: the ordering of the pixel array (see GetPixelViewAuthenticRows()).
+%
+%    o storage: the data type of the pixels.
+%
+*/
+WandExport const void *GetPixelViewVirtualRows(PixelView *pixel_view,
+  const long y,const unsigned long rows,const char *map,
+  const StorageType storage)
+{
+  const PixelPacket
+    *pixels;
+
+  long
+    id;
+
+  RowInfo
+    *row_info;
+
+  assert(pixel_view != (PixelView *) NULL);
+  assert(pixel_view->signature == WandSignature);
+  assert(map != (const char *) NULL);
+  if (pixel_view->debug != MagickFalse)
+    (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",pixel_view->name);
+  id=GetOpenMPThreadId();
+  row_info=pixel_view->row_info+id;
+  row_info->pixels=(PixelPacket *) NULL;
+  if (SetRowInfoMap(pixel_view,row_info,map,storage) == MagickFalse)
+    return((const void *) NULL);
+  pixels=GetCacheViewVirtualPixels(pixel_view->view,pixel_view->region.x,y,
+    pixel_view->region.width,rows,pixel_view->exception);
+  if (pixels == (const PixelPacket *) NULL)
+    return((const void *) NULL);
+  if (row_info->direct != MagickFalse)
+    return((const void *) pixels);
+  row_info->number_pixels=pixel_view->region.width*rows;
+  if (AcquireRowBuffer(row_info) == MagickFalse)
+    {
+      (void) ThrowMagickException(pixel_view->exception,GetMagickModule(),
+        ResourceLimitError,"MemoryAllocationFailed","`%s'",pixel_view->name);
+      return((const void *) NULL);
+    }
+  ExportPixelFormatPackets(row_info->format_info,pixels,
+    GetCacheViewVirtualIndexQueue(pixel_view->view),row_info->number_pixels,
+    row_info->buffer);
+  return((const void *) row_info->buffer);
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
 %   G e t P i x e l V i e w W a n d                                           %
 %                                                                             %
 %                                                                             %
@@ -838,6 +1265,7 @@ WandExport PixelView *NewPixelView(MagickWand *wand)
 
   assert(wand != (MagickWand *) NULL);
   assert(wand->signature == MagickSignature);
+  (void) MagickApplyDeferredOperations(wand);
   pixel_view=(PixelView *) AcquireMagickMemory(sizeof(*pixel_view));
   if (pixel_view == (PixelView *) NULL)
     ThrowWandFatalException(ResourceLimitFatalError,"MemoryAllocationFailed",
@@ -854,7 +1282,9 @@ WandExport PixelView *NewPixelView(MagickWand *wand)
   pixel_view->number_threads=GetOpenMPMaximumThreads();
   pixel_view->pixel_wands=AcquirePixelsThreadSet(pixel_view->region.width,
     pixel_view->number_threads);
-  if (pixel_view->pixel_wands == (PixelWand ***) NULL)
+  pixel_view->row_info=AcquireRowInfoThreadSet(pixel_view->number_threads);
+  if ((pixel_view->pixel_wands == (PixelWand ***) NULL) ||
+      (pixel_view->row_info == (RowInfo *) NULL))
     ThrowWandFatalException(ResourceLimitFatalError,"MemoryAllocationFailed",
       GetExceptionMessage(errno));
   pixel_view->debug=IsEventLogging();
@@ -897,6 +1327,7 @@ WandExport PixelView *NewPixelViewRegion(MagickWand *wand,const long x,
 
   assert(wand != (MagickWand *) NULL);
   assert(wand->signature == MagickSignature);
+  (void) MagickApplyDeferredOperations(wand);
   pixel_view=(PixelView *) AcquireMagickMemory(sizeof(*pixel_view));
   if (pixel_view == (PixelView *) NULL)
     ThrowWandFatalException(ResourceLimitFatalError,"MemoryAllocationFailed",
@@ -906,8 +1337,8 @@ WandExport PixelView *NewPixelViewRegion(MagickWand *wand,const long x,
   (void) FormatMagickString(pixel_view->name,MaxTextExtent,"%s-%lu",
     PixelViewId,pixel_view->id);
   pixel_view->exception=AcquireExceptionInfo();
-  pixel_view->view=AcquireCacheView(pixel_view->wand->images);
   pixel_view->wand=wand;
+  pixel_view->view=AcquireCacheView(pixel_view->wand->images);
   pixel_view->region.width=width;
   pixel_view->region.height=height;
   pixel_view->region.x=x;
@@ -915,7 +1346,9 @@ WandExport PixelView *NewPixelViewRegion(MagickWand *wand,const long x,
   pixel_view->number_threads=GetOpenMPMaximumThreads();
   pixel_view->pixel_wands=AcquirePixelsThreadSet(pixel_view->region.width,
     pixel_view->number_threads);
-  if (pixel_view->pixel_wands == (PixelWand ***) NULL)
+  pixel_view->row_info=AcquireRowInfoThreadSet(pixel_view->number_threads);
+  if ((pixel_view->pixel_wands == (PixelWand ***) NULL) ||
+      (pixel_view->row_info == (RowInfo *) NULL))
     ThrowWandFatalException(ResourceLimitFatalError,"MemoryAllocationFailed",
       GetExceptionMessage(errno));
   pixel_view->debug=IsEventLogging();
@@ -991,7 +1424,9 @@ WandExport MagickBooleanType SetPixelViewIterator(PixelView *destination,
   progress=0;
   exception=destination->exception;
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(NeighborhoodThreadCost,destination->region.width, \
+      destination->region.height)
 #endif
   for (y=destination->region.y; y < (long) destination->region.height; y++)
   {
@@ -1057,6 +1492,52 @@ WandExport MagickBooleanType SetPixelViewIterator(PixelView *destination,
 %                                                                             %
 %                                                                             %
 %                                                                             %
+%   S y n c P i x e l V i e w A u t h e n t i c R o w s                       %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  SyncPixelViewAuthenticRows() writes the rows last returned to this thread
+%  by GetPixelViewAuthenticRows() back to the image.
+%
+%  The format of the SyncPixelViewAuthenticRows method is:
+%
+%      MagickBooleanType SyncPixelViewAuthenticRows(PixelView *pixel_view)
+%
+%  A description of each parameter follows:
+%
+%    o pixel_view: the pixel view.
+%
+*/
+WandExport MagickBooleanType SyncPixelViewAuthenticRows(PixelView *pixel_view)
+{
+  long
+    id;
+
+  RowInfo
+    *row_info;
+
+  assert(pixel_view != (PixelView *) NULL);
+  assert(pixel_view->signature == WandSignature);
+  if (pixel_view->debug != MagickFalse)
+    (void) LogMagickEvent(WandEvent,GetMagickModule(),"%s",pixel_view->name);
+  id=GetOpenMPThreadId();
+  row_info=pixel_view->row_info+id;
+  if (row_info->pixels == (PixelPacket *) NULL)
+    return(MagickFalse);
+  if (row_info->direct == MagickFalse)
+    ImportPixelFormatPackets(row_info->format_info,row_info->buffer,
+      row_info->number_pixels,row_info->pixels,row_info->indexes);
+  row_info->pixels=(PixelPacket *) NULL;
+  return(SyncCacheViewAuthenticPixels(pixel_view->view,pixel_view->exception));
+}
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
 %   T r a n s f e r P i x e l V i e w I t e r a t o r                         %
 %                                                                             %
 %                                                                             %
@@ -1125,7 +1606,9 @@ WandExport MagickBooleanType TransferPixelViewIterator(PixelView *source,
   progress=0;
   exception=destination->exception;
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(NeighborhoodThreadCost,source->region.width, \
+      source->region.height)
 #endif
   for (y=source->region.y; y < (long) source->region.height; y++)
   {
@@ -1283,7 +1766,9 @@ WandExport MagickBooleanType UpdatePixelViewIterator(PixelView *source,
   progress=0;
   exception=source->exception;
 #if defined(MAGICKCORE_OPENMP_SUPPORT)
-  #pragma omp parallel for schedule(dynamic,4) shared(progress,status)
+  #pragma omp parallel for shared(progress,status) \
+    magick_schedule(NeighborhoodThreadCost,source->region.width, \
+      source->region.height)
 #endif
   for (y=source->region.y; y < (long) source->region.height; y++)
   {
@@ -1343,3 +1828,126 @@ WandExport MagickBooleanType UpdatePixelViewIterator(PixelView *source,
   }
   return(status);
 }
+
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%   U p d a t e P i x e l V i e w R o w s I t e r a t o r                     %
+%                                                                             %
+%                                                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+%  UpdatePixelViewRowsIterator() iterates over the pixel view in parallel and
+%  calls your update method for each band of rows of the view.  The pixels
+%  are handed to your method as returned by GetPixelViewAuthenticRows() and
+%  any changes you make are synced back to the image when your method
+%  returns.  The pixel region is confined to the image canvas-- that is no
+%  negative offsets or widths or heights that exceed the image dimension are
+%  permitted.
+%
+%  Use this pragma:
+%
+%    #pragma omp critical
+%
+%  to define a section of code in your callback update method that must be
+%  executed by a single thread at a time.
+%
+%  The format of the UpdatePixelViewRowsIterator method is:
+%
+%      MagickBooleanType UpdatePixelViewRowsIterator(PixelView *source,
+%        const char *map,const StorageType storage,const unsigned long rows,
+%        UpdatePixelViewRowsMethod update,void *context)
+%
+%  A description of each parameter follows:
+%
+%    o source: the source pixel view.
+%
+%    o map: the ordering of the pixel array (see GetPixelViewAuthenticRows()).
+%
+%    o storage: the data type of the pixels.
+%
+%    o rows: the number of rows handed to each call of your update method.
+%
+%    o update: the update callback method.
+%
+%    o context: the user defined context.
+%
+*/
+WandExport MagickBooleanType UpdatePixelViewRowsIterator(PixelView *source,
+  const char *map,const StorageType storage,const unsigned long rows,
+  UpdatePixelViewRowsMethod update,void *context)
+{
+#define UpdatePixelViewRowsTag  "PixelView/UpdateRows"
+
+  Image
+    *source_image;
+
+  long
+    progress,
+    y;
+
+  MagickBooleanType
+    status;
+
+  unsigned long
+    band;
+
+  assert(source != (PixelView *) NULL);
+  assert(source->signature == WandSignature);
+  if (update == (UpdatePixelViewRowsMethod) NULL)
+    return(MagickFalse);
+  source_image=source->wand->images;
+  if (SetImageStorageClass(source_image,DirectClass) == MagickFalse)
+    return(MagickFalse);
+  band=rows == 0 ? 1UL : rows;
+  status=MagickTrue;
+  progress=0;
+#if defined(MAGICKCORE_OPENMP_SUPPORT)
+  #pragma omp parallel for schedule(dynamic,1) shared(progress,status)
+#endif
+  for (y=source->region.y; y < (long) (source->region.y+source->region.height);
+       y+=(long) band)
+  {
+    unsigned long
+      height;
+
+    void
+      *pixels;
+
+    if (status == MagickFalse)
+      continue;
+    height=band;
+    if ((y+(long) height) > (long) (source->region.y+source->region.height))
+      height=(unsigned long) (source->region.y+source->region.height-y);
+    pixels=GetPixelViewAuthenticRows(source,y,height,map,storage);
+    if (pixels == (void *) NULL)
+      {
+        status=MagickFalse;
+        continue;
+      }
+    if (update(source,y,height,pixels,context) == MagickFalse)
+      status=MagickFalse;
+    if (SyncPixelViewAuthenticRows(source) == MagickFalse)
+      status=MagickFalse;
+    if (source_image->progress_monitor != (MagickProgressMonitor) NULL)
+      {
+        MagickBooleanType
+          proceed;
+
+#if defined(MAGICKCORE_OPENMP_SUPPORT)
+  #pragma omp critical (MagickWand_UpdatePixelViewRowsIterator)
+#endif
+        {
+          progress+=(long) height;
+          proceed=SetImageProgress(source_image,UpdatePixelViewRowsTag,
+            progress,source->region.height);
+        }
+        if (proceed == MagickFalse)
+          status=MagickFalse;
+      }
+  }
+  return(status);
+}
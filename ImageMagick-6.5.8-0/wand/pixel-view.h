@@ -29,13 +29,21 @@ typedef MagickBooleanType
   (*DuplexTransferPixelViewMethod)(const PixelView *,const PixelView *,
     PixelView *,void *),
   (*GetPixelViewMethod)(const PixelView *,void *),
+  (*GetPixelViewRowsMethod)(const PixelView *,const long,const unsigned long,
+    const void *,void *),
   (*SetPixelViewMethod)(PixelView *,void *),
   (*TransferPixelViewMethod)(const PixelView *,PixelView *,void *),
-  (*UpdatePixelViewMethod)(PixelView *,void *);
+  (*UpdatePixelViewMethod)(PixelView *,void *),
+  (*UpdatePixelViewRowsMethod)(PixelView *,const long,const unsigned long,
+    void *,void *);
 
 extern WandExport char
   *GetPixelViewException(const PixelView *,ExceptionType *);
 
+extern WandExport const void
+  *GetPixelViewVirtualRows(PixelView *,const long,const unsigned long,
+    const char *,const StorageType);
+
 extern WandExport long
   GetPixelViewX(const PixelView *),
   GetPixelViewY(const PixelView *);
@@ -44,11 +52,16 @@ extern WandExport MagickBooleanType
   DuplexTransferPixelViewIterator(PixelView *,PixelView *,PixelView *,
     DuplexTransferPixelViewMethod,void *),
   GetPixelViewIterator(PixelView *,GetPixelViewMethod,void *),
+  GetPixelViewRowsIterator(PixelView *,const char *,const StorageType,
+    const unsigned long,GetPixelViewRowsMethod,void *),
   IsPixelView(const PixelView *),
   SetPixelViewIterator(PixelView *,SetPixelViewMethod,void *),
+  SyncPixelViewAuthenticRows(PixelView *),
   TransferPixelViewIterator(PixelView *,PixelView *,TransferPixelViewMethod,
     void *),
-  UpdatePixelViewIterator(PixelView *,UpdatePixelViewMethod,void *);
+  UpdatePixelViewIterator(PixelView *,UpdatePixelViewMethod,void *),
+  UpdatePixelViewRowsIterator(PixelView *,const char *,const StorageType,
+    const unsigned long,UpdatePixelViewRowsMethod,void *);
 
 extern WandExport MagickWand
   *GetPixelViewWand(const PixelView *);
@@ -67,6 +80,10 @@ extern WandExport unsigned long
   GetPixelViewHeight(const PixelView *),
   GetPixelViewWidth(const PixelView *);
 
+extern WandExport void
+  *GetPixelViewAuthenticRows(PixelView *,const long,const unsigned long,
+    const char *,const StorageType);
+
 #if defined(__cplusplus) || defined(c_plusplus)
 }
 #endif
@@ -62,6 +62,23 @@
 
 #define WandDelay   3
 
+static MagickBooleanType NegateRows(PixelView *pixel_view,const long y,
+  const unsigned long rows,void *pixels,void *context)
+{
+  register size_t
+    i;
+
+  register unsigned char
+    *p;
+
+  (void) y;
+  (void) context;
+  p=(unsigned char *) pixels;
+  for (i=0; i < (size_t) (3*rows*GetPixelViewWidth(pixel_view)); i++)
+    p[i]=(unsigned char) (255-p[i]);
+  return(MagickTrue);
+}
+
 int main(int argc,char **argv)
 {
 #define ThrowAPIException(wand) \
@@ -578,6 +595,37 @@ int main(int argc,char **argv)
   }
   (void) PixelSyncIterator(iterator);
   iterator=DestroyPixelIterator(iterator);
+  (void) fprintf(stdout,"Utilitize pixel view rows to negate image...\n");
+  {
+    const unsigned char
+      *row;
+
+    PixelView
+      *pixel_view;
+
+    unsigned char
+      pixel[3];
+
+    status=MagickExportImagePixels(magick_wand,7,5,1,1,"RGB",CharPixel,pixel);
+    if (status == MagickFalse)
+      ThrowAPIException(magick_wand);
+    pixel_view=NewPixelView(magick_wand);
+    status=UpdatePixelViewRowsIterator(pixel_view,"RGB",CharPixel,8,NegateRows,
+      (void *) NULL);
+    if (status == MagickFalse)
+      ThrowAPIException(magick_wand);
+    row=(const unsigned char *) GetPixelViewVirtualRows(pixel_view,5,1,"RGB",
+      CharPixel);
+    if (row == (const unsigned char *) NULL)
+      ThrowAPIException(magick_wand);
+    for (i=0; i < 3; i++)
+      if (row[3*7+i] != (unsigned char) (255-pixel[i]))
+        {
+          (void) fprintf(stderr,"Pixel view rows do not match negated pixels\n");
+          exit(1);
+        }
+    pixel_view=DestroyPixelView(pixel_view);
+  }
   (void) fprintf(stdout,"Write to wandtest_out.miff...\n");
   status=MagickWriteImages(magick_wand,"wandtest_out.miff",MagickTrue);
   if (status == MagickFalse)
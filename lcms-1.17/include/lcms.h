@@ -1135,6 +1135,11 @@ LCMSAPI void         LCMSEXPORT cmsGetAlarmCodes(int *r, int *g, int *b);
 LCMSAPI double       LCMSEXPORT cmsSetAdaptationState(double d);
 
 
+// Number of threads cmsDoTransform may split large buffers across (needs USE_PTHREADS)
+
+LCMSAPI int          LCMSEXPORT cmsSetWorkerThreads(int n);
+
+
 // Primary preservation strategy
 
 #define LCMS_PRESERVE_PURE_K    0
@@ -1541,6 +1546,14 @@ typedef void (* _cms3DLERP)(WORD Input[],
                             WORD LutTable[],
                             struct _lcms_l16params_struc* p);
 
+// Same, but on a block of nPixels interleaved pixels
+
+typedef void (* _cms3DLERPMULTI)(WORD Input[],
+                                 WORD Output[],
+                                 unsigned int nPixels,
+                                 WORD LutTable[],
+                                 struct _lcms_l16params_struc* p);
+
 
 
 typedef struct _lcms_l8opt_struc {      // Used on 8 bit interpolations
@@ -1564,6 +1577,7 @@ typedef struct _lcms_l16params_struc {    // Used on 16 bits interpolations
                int opta7, opta8;
 
                _cms3DLERP Interp3D; // The interpolation routine
+               _cms3DLERPMULTI InterpMulti3D; // Block version, NULL if none
                 
                 LPL8PARAMS p8;      // Points to some tables for 8-bit speedup              
 
@@ -1592,6 +1606,18 @@ void cdecl cmsTetrahedralInterp8(WORD Input[],
                                  WORD Output[],
                                  WORD LutTable[],  LPL16PARAMS p);
 
+void cdecl cmsTrilinearInterp16Multi(WORD Input[],
+                                     WORD Output[], unsigned int nPixels,
+                                     WORD LutTable[], LPL16PARAMS p);
+
+void cdecl cmsTetrahedralInterp16Multi(WORD Input[],
+                                       WORD Output[], unsigned int nPixels,
+                                       WORD LutTable[], LPL16PARAMS p);
+
+void cdecl cmsTetrahedralInterp8Multi(WORD Input[],
+                                      WORD Output[], unsigned int nPixels,
+                                      WORD LutTable[], LPL16PARAMS p);
+
 // LUT handling
 
 #define LUT_HASMATRIX       0x0001        // Do-op Flags
@@ -1867,6 +1893,12 @@ typedef LPBYTE (* _cmsFIXFN)(register struct _cmstransform_struct *info,
                              register WORD ToUnroll[],
                              register LPBYTE Buffer);
 
+// Same, on n pixels. WORD buffer holds exactly the color channels, interleaved
+
+typedef LPBYTE (* _cmsFIXBLOCKFN)(register struct _cmstransform_struct *info,
+                                  register WORD ToUnroll[],
+                                  register LPBYTE Buffer, unsigned int n);
+
 
 
 // Transformation
@@ -1904,6 +1936,11 @@ typedef struct _cmstransform_struct {
                     _cmsTRANSFN ToDevice;
                     _cmsFIXFN   ToOutput;
 
+                    // Block packers for common layouts, NULL if none
+
+                    _cmsFIXBLOCKFN FromInputBlock;
+                    _cmsFIXBLOCKFN ToOutputBlock;
+
                     // LUTs
 
                     LPLUT Device2PCS;
@@ -1951,6 +1988,9 @@ typedef struct _cmstransform_struct {
 _cmsFIXFN cdecl _cmsIdentifyInputFormat(_LPcmsTRANSFORM xform,  DWORD dwInput);
 _cmsFIXFN cdecl _cmsIdentifyOutputFormat(_LPcmsTRANSFORM xform, DWORD dwOutput);
 
+_cmsFIXBLOCKFN cdecl _cmsIdentifyInputBlockFormat(_LPcmsTRANSFORM xform,  DWORD dwInput);
+_cmsFIXBLOCKFN cdecl _cmsIdentifyOutputBlockFormat(_LPcmsTRANSFORM xform, DWORD dwOutput);
+
 
 // Conversion
 
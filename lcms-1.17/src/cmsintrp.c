@@ -264,6 +264,8 @@ void cmsCalcCLUT16ParamsEx(int nSamples, int InputChan, int OutputChan,
 
        clutPoints = p -> Domain + 1;
 
+       p -> InterpMulti3D = NULL;
+
        p -> opta1 = p -> nOutputs;              // Z
        p -> opta2 = p -> opta1 * clutPoints;    // Y
        p -> opta3 = p -> opta2 * clutPoints;    // X
@@ -285,9 +287,12 @@ void cmsCalcCLUT16ParamsEx(int nSamples, int InputChan, int OutputChan,
            case 3:  // RGB et al               
                if (lUseTetrahedral) {                   
                    p ->Interp3D = cmsTetrahedralInterp16;                   
+                   p ->InterpMulti3D = cmsTetrahedralInterp16Multi;
                }
-               else
+               else {
                    p ->Interp3D = cmsTrilinearInterp16;   
+                   p ->InterpMulti3D = cmsTrilinearInterp16Multi;
+               }
                break;
 
            case 4:  // CMYK LUT             
@@ -1103,3 +1108,273 @@ void cmsTetrahedralInterp8(WORD Input[],
 
 #undef DENS
 
+
+
+// Block (multi-pixel) interpolation. Input holds nPixels interleaved triplets,
+// Output receives p -> nOutputs words per pixel. The whole block is consumed
+// in a single call, so the per-pixel function pointer indirection is gone and
+// the inner evaluation is straight-line code the compiler can keep in registers
+// and vectorize across output channels.
+
+#ifdef USE_FLOAT
+
+void cmsTrilinearInterp16Multi(WORD Input[], WORD Output[], unsigned int nPixels,
+                                WORD LutTable[], LPL16PARAMS p)
+{
+    unsigned int i;
+    int TotalOut = p -> nOutputs;
+
+    for (i=0; i < nPixels; i++) {
+
+        cmsTrilinearInterp16(Input, Output, LutTable, p);
+        Input  += 3;
+        Output += TotalOut;
+    }
+}
+
+
+void cmsTetrahedralInterp16Multi(WORD Input[], WORD Output[], unsigned int nPixels,
+                                 WORD LutTable[], LPL16PARAMS p)
+{
+    unsigned int i;
+    int TotalOut = p -> nOutputs;
+
+    for (i=0; i < nPixels; i++) {
+
+        cmsTetrahedralInterp16(Input, Output, LutTable, p);
+        Input  += 3;
+        Output += TotalOut;
+    }
+}
+
+#else
+
+// Trilinear, block version
+
+void cmsTrilinearInterp16Multi(WORD Input[], WORD Output[], unsigned int nPixels,
+                                WORD LutTable1[], LPL16PARAMS p)
+{
+#define DENS(i,j,k) (LutTable[(i)+(j)+(k)+OutChan])
+#define LERP(a,l,h)     (WORD) (l+ ROUND_FIXED_TO_INT(((h-l)*a)))
+
+           unsigned int i;
+           int        OutChan, TotalOut;
+           Fixed32    fx, fy, fz;
+  register int        rx, ry, rz;
+  register int        X1, Y1, Z1;
+           int        d000, d001, d010, d011,
+                      d100, d101, d110, d111,
+                      dx00, dx01, dx10, dx11,
+                      dxy0, dxy1;
+           LPWORD     LutTable;
+
+
+    TotalOut   = p -> nOutputs;
+
+    for (i=0; i < nPixels; i++) {
+
+        fx = ToFixedDomain((int) Input[0] * p -> Domain);
+        fy = ToFixedDomain((int) Input[1] * p -> Domain);
+        fz = ToFixedDomain((int) Input[2] * p -> Domain);
+
+        rx = FIXED_REST_TO_INT(fx);
+        ry = FIXED_REST_TO_INT(fy);
+        rz = FIXED_REST_TO_INT(fz);
+
+        // Corner (X0, Y0, Z0) is folded into the table base
+
+        LutTable = LutTable1 + p -> opta3 * FIXED_TO_INT(fx) 
+                             + p -> opta2 * FIXED_TO_INT(fy) 
+                             + p -> opta1 * FIXED_TO_INT(fz);
+
+        X1 = (Input[0] == 0xFFFFU ? 0 : p->opta3);
+        Y1 = (Input[1] == 0xFFFFU ? 0 : p->opta2);
+        Z1 = (Input[2] == 0xFFFFU ? 0 : p->opta1);
+
+        for (OutChan = 0; OutChan < TotalOut; OutChan++) {
+
+            d000 = DENS(0,  0,  0);
+            d001 = DENS(0,  0,  Z1);
+            d010 = DENS(0,  Y1, 0);
+            d011 = DENS(0,  Y1, Z1);
+
+            d100 = DENS(X1, 0,  0);
+            d101 = DENS(X1, 0,  Z1);
+            d110 = DENS(X1, Y1, 0);
+            d111 = DENS(X1, Y1, Z1);
+
+            dx00 = LERP(rx, d000, d100);
+            dx01 = LERP(rx, d001, d101);
+            dx10 = LERP(rx, d010, d110);
+            dx11 = LERP(rx, d011, d111);
+
+            dxy0 = LERP(ry, dx00, dx10);
+            dxy1 = LERP(ry, dx01, dx11);
+
+            Output[OutChan] = LERP(rz, dxy0, dxy1);
+        }
+
+        Input  += 3;
+        Output += TotalOut;
+    }
+
+#   undef LERP
+#   undef DENS
+}
+
+#endif
+
+
+// The six tetrahedra of the Sakamoto algorithm are walks from the (0,0,0) corner to
+// (1,1,1), taking the axis with the larger rest first. The three vertices of
+// the walk and their weights are selected once per pixel; evaluation then
+// becomes the same branch-free expression for every output channel.
+
+static
+void TetrahedralPath(Fixed32 rx, Fixed32 ry, Fixed32 rz,
+                     int X1, int Y1, int Z1,
+                     int V[3], Fixed32 w[3])
+{
+    if (rx >= ry && ry >= rz) {
+
+        V[0] = X1;      V[1] = X1 + Y1; w[0] = rx; w[1] = ry; w[2] = rz;
+    }
+    else
+    if (rx >= rz && rz >= ry) {
+
+        V[0] = X1;      V[1] = X1 + Z1; w[0] = rx; w[1] = rz; w[2] = ry;
+    }
+    else
+    if (rz >= rx && rx >= ry) {
+
+        V[0] = Z1;      V[1] = X1 + Z1; w[0] = rz; w[1] = rx; w[2] = ry;
+    }
+    else
+    if (ry >= rx && rx >= rz) {
+
+        V[0] = Y1;      V[1] = X1 + Y1; w[0] = ry; w[1] = rx; w[2] = rz;
+    }
+    else
+    if (ry >= rz && rz >= rx) {
+
+        V[0] = Y1;      V[1] = Y1 + Z1; w[0] = ry; w[1] = rz; w[2] = rx;
+    }
+    else {
+
+        V[0] = Z1;      V[1] = Y1 + Z1; w[0] = rz; w[1] = ry; w[2] = rx;
+    }
+
+    V[2] = X1 + Y1 + Z1;
+}
+
+
+// LutTable points to the (X0, Y0, Z0) corner
+
+#define TETRA_CHANNEL(n) {                                                  \
+        c0 = LutTable[(n)];                                                 \
+        c1 = LutTable[V[0]+(n)];                                            \
+        c2 = LutTable[V[1]+(n)];                                            \
+        c3 = LutTable[V[2]+(n)];                                            \
+        Rest = (c1 - c0) * w[0] + (c2 - c1) * w[1] + (c3 - c2) * w[2];      \
+        Output[(n)] = (WORD) (c0 + ((Rest + 0x7FFF) / 0xFFFF)); }
+
+static
+void TetrahedralEval(LPWORD LutTable, int V[3], Fixed32 w[3], WORD Output[], int TotalOut)
+{
+    Fixed32 c0, c1, c2, c3, Rest;
+    int OutChan;
+
+    switch (TotalOut) {
+
+    case 3:  // RGB, Lab
+             TETRA_CHANNEL(0);
+             TETRA_CHANNEL(1);
+             TETRA_CHANNEL(2);
+             break;
+
+    case 4:  // CMYK
+             TETRA_CHANNEL(0);
+             TETRA_CHANNEL(1);
+             TETRA_CHANNEL(2);
+             TETRA_CHANNEL(3);
+             break;
+
+    default:
+             for (OutChan=0; OutChan < TotalOut; OutChan++)
+                  TETRA_CHANNEL(OutChan);
+    }
+}
+
+#undef TETRA_CHANNEL
+
+
+#ifndef USE_FLOAT
+
+// Tetrahedral, block version. Gives same results as cmsTetrahedralInterp16
+
+void cmsTetrahedralInterp16Multi(WORD Input[], WORD Output[], unsigned int nPixels,
+                                 WORD LutTable[], LPL16PARAMS p)
+{
+       unsigned int i;
+       Fixed32    fx, fy, fz;
+       int        X1, Y1, Z1;
+       int        V[3];
+       Fixed32    w[3];
+       int        TotalOut = p -> nOutputs;
+
+
+    for (i=0; i < nPixels; i++) {
+
+        fx  = ToFixedDomain((int) Input[0] * p -> Domain);
+        fy  = ToFixedDomain((int) Input[1] * p -> Domain);
+        fz  = ToFixedDomain((int) Input[2] * p -> Domain);
+
+        X1 = (Input[0] == 0xFFFFU ? 0 : p->opta3);
+        Y1 = (Input[1] == 0xFFFFU ? 0 : p->opta2);
+        Z1 = (Input[2] == 0xFFFFU ? 0 : p->opta1);
+
+        TetrahedralPath(FIXED_REST_TO_INT(fx), FIXED_REST_TO_INT(fy), FIXED_REST_TO_INT(fz),
+                        X1, Y1, Z1, V, w);
+
+        TetrahedralEval(LutTable + p -> opta3 * FIXED_TO_INT(fx)
+                                 + p -> opta2 * FIXED_TO_INT(fy)
+                                 + p -> opta1 * FIXED_TO_INT(fz), V, w, Output, TotalOut);
+
+        Input  += 3;
+        Output += TotalOut;
+    }
+}
+
+#endif
+
+
+// 8-bit input, block version. Gives same results as cmsTetrahedralInterp8
+
+void cmsTetrahedralInterp8Multi(WORD Input[], WORD Output[], unsigned int nPixels,
+                                WORD LutTable[], LPL16PARAMS p)
+{
+       unsigned int i;
+       int        r, g, b;
+       int        V[3];
+       Fixed32    w[3];
+       int        TotalOut = p -> nOutputs;
+       register   LPL8PARAMS p8 = p ->p8;
+
+
+    for (i=0; i < nPixels; i++) {
+
+        r = Input[0] >> 8;
+        g = Input[1] >> 8;
+        b = Input[2] >> 8;
+
+        TetrahedralPath(p8 ->rx[r], p8 ->ry[g], p8 ->rz[b],
+                        (r == 255) ? 0 : p ->opta3,
+                        (g == 255) ? 0 : p ->opta2,
+                        (b == 255) ? 0 : p ->opta1, V, w);
+
+        TetrahedralEval(LutTable + p8->X0[r] + p8->Y0[g] + p8->Z0[b], V, w, Output, TotalOut);
+
+        Input  += 3;
+        Output += TotalOut;
+    }
+}
@@ -598,6 +598,7 @@ LPLUT _cmsBlessLUT8(LPLUT Lut)
 
    Lut -> CLut16params.p8 = p8;
    Lut -> CLut16params.Interp3D = cmsTetrahedralInterp8;
+   Lut -> CLut16params.InterpMulti3D = cmsTetrahedralInterp8Multi;
 
    return Lut;
 
@@ -2020,6 +2020,195 @@ _cmsFIXFN _cmsIdentifyOutputFormat(_LPcmsTRANSFORM xform, DWORD dwOutput)
               return ToOutput;
 }
 
+// Block formatters. These cover the RGB and CMYK layouts seen on almost every
+// image pipeline, and handle a whole run of pixels per call. Only color
+// channels are stored in the WORD buffer, extra channels are skipped.
+
+static
+LPBYTE Unroll3BytesBlock(register _LPcmsTRANSFORM info, register WORD wIn[], register LPBYTE accum, unsigned int n)
+{
+       register unsigned int i;
+
+       for (i=0; i < n; i++) {
+
+              wIn[0] = RGB_8_TO_16(accum[0]);     // R
+              wIn[1] = RGB_8_TO_16(accum[1]);     // G
+              wIn[2] = RGB_8_TO_16(accum[2]);     // B
+              wIn += 3; accum += 3;
+       }
+
+       return accum;
+}
+
+static
+LPBYTE Unroll3BytesSwapBlock(register _LPcmsTRANSFORM info, register WORD wIn[], register LPBYTE accum, unsigned int n)
+{
+       register unsigned int i;
+
+       for (i=0; i < n; i++) {
+
+              wIn[2] = RGB_8_TO_16(accum[0]);     // B
+              wIn[1] = RGB_8_TO_16(accum[1]);     // G
+              wIn[0] = RGB_8_TO_16(accum[2]);     // R
+              wIn += 3; accum += 3;
+       }
+
+       return accum;
+}
+
+static
+LPBYTE Unroll3BytesSkip1Block(register _LPcmsTRANSFORM info, register WORD wIn[], register LPBYTE accum, unsigned int n)
+{
+       register unsigned int i;
+
+       for (i=0; i < n; i++) {
+
+              wIn[0] = RGB_8_TO_16(accum[0]);     // R
+              wIn[1] = RGB_8_TO_16(accum[1]);     // G
+              wIn[2] = RGB_8_TO_16(accum[2]);     // B
+              wIn += 3; accum += 4;               // A
+       }
+
+       return accum;
+}
+
+static
+LPBYTE Unroll3WordsBlock(register _LPcmsTRANSFORM info, register WORD wIn[], register LPBYTE accum, unsigned int n)
+{
+       CopyMemory(wIn, accum, n * 3 * sizeof(WORD));
+       return accum + n * 3 * sizeof(WORD);
+}
+
+
+static
+LPBYTE Pack3BytesBlock(register _LPcmsTRANSFORM info, register WORD wOut[], register LPBYTE output, unsigned int n)
+{
+       register unsigned int i;
+
+       for (i=0; i < n; i++) {
+
+              output[0] = RGB_16_TO_8(wOut[0]);
+              output[1] = RGB_16_TO_8(wOut[1]);
+              output[2] = RGB_16_TO_8(wOut[2]);
+              wOut += 3; output += 3;
+       }
+
+       return output;
+}
+
+static
+LPBYTE Pack3BytesSwapBlock(register _LPcmsTRANSFORM info, register WORD wOut[], register LPBYTE output, unsigned int n)
+{
+       register unsigned int i;
+
+       for (i=0; i < n; i++) {
+
+              output[0] = RGB_16_TO_8(wOut[2]);
+              output[1] = RGB_16_TO_8(wOut[1]);
+              output[2] = RGB_16_TO_8(wOut[0]);
+              wOut += 3; output += 3;
+       }
+
+       return output;
+}
+
+static
+LPBYTE Pack3BytesAndSkip1Block(register _LPcmsTRANSFORM info, register WORD wOut[], register LPBYTE output, unsigned int n)
+{
+       register unsigned int i;
+
+       for (i=0; i < n; i++) {
+
+              output[0] = RGB_16_TO_8(wOut[0]);
+              output[1] = RGB_16_TO_8(wOut[1]);
+              output[2] = RGB_16_TO_8(wOut[2]);
+              wOut += 3; output += 4;
+       }
+
+       return output;
+}
+
+static
+LPBYTE Pack4BytesBlock(register _LPcmsTRANSFORM info, register WORD wOut[], register LPBYTE output, unsigned int n)
+{
+       register unsigned int i;
+
+       for (i=0; i < n; i++) {
+
+              output[0] = RGB_16_TO_8(wOut[0]);
+              output[1] = RGB_16_TO_8(wOut[1]);
+              output[2] = RGB_16_TO_8(wOut[2]);
+              output[3] = RGB_16_TO_8(wOut[3]);
+              wOut += 4; output += 4;
+       }
+
+       return output;
+}
+
+static
+LPBYTE Pack3WordsBlock(register _LPcmsTRANSFORM info, register WORD wOut[], register LPBYTE output, unsigned int n)
+{
+       CopyMemory(output, wOut, n * 3 * sizeof(WORD));
+       return output + n * 3 * sizeof(WORD);
+}
+
+static
+LPBYTE Pack4WordsBlock(register _LPcmsTRANSFORM info, register WORD wOut[], register LPBYTE output, unsigned int n)
+{
+       CopyMemory(output, wOut, n * 4 * sizeof(WORD));
+       return output + n * 4 * sizeof(WORD);
+}
+
+
+// Only plain layouts are taken: no planar, no flavor reversal, no endian swap
+// and no Lab v2 encoding. Everything else goes through the per-pixel formatters.
+
+#define BLOCK_FORMAT_MASK   (COLORSPACE_SH(31))
+
+static
+LCMSBOOL IsPlainFormat(DWORD dwFormat)
+{
+       if (T_PLANAR(dwFormat) || T_FLAVOR(dwFormat) || T_ENDIAN16(dwFormat) || T_SWAPFIRST(dwFormat))
+              return FALSE;
+
+       return T_COLORSPACE(dwFormat) != PT_Lab;
+}
+
+_cmsFIXBLOCKFN _cmsIdentifyInputBlockFormat(_LPcmsTRANSFORM xform, DWORD dwInput)
+{
+       if (!IsPlainFormat(dwInput)) return NULL;
+
+       switch (dwInput & ~BLOCK_FORMAT_MASK) {
+
+       case (TYPE_RGB_8  & ~BLOCK_FORMAT_MASK): return Unroll3BytesBlock;
+       case (TYPE_BGR_8  & ~BLOCK_FORMAT_MASK): return Unroll3BytesSwapBlock;
+       case (TYPE_RGBA_8 & ~BLOCK_FORMAT_MASK): return Unroll3BytesSkip1Block;
+       case (TYPE_RGB_16 & ~BLOCK_FORMAT_MASK): return Unroll3WordsBlock;
+
+       default: return NULL;
+       }
+}
+
+_cmsFIXBLOCKFN _cmsIdentifyOutputBlockFormat(_LPcmsTRANSFORM xform, DWORD dwOutput)
+{
+       if (!IsPlainFormat(dwOutput)) return NULL;
+
+       switch (dwOutput & ~BLOCK_FORMAT_MASK) {
+
+       case (TYPE_RGB_8   & ~BLOCK_FORMAT_MASK): return Pack3BytesBlock;
+       case (TYPE_BGR_8   & ~BLOCK_FORMAT_MASK): return Pack3BytesSwapBlock;
+       case (TYPE_RGBA_8  & ~BLOCK_FORMAT_MASK): return Pack3BytesAndSkip1Block;
+       case (TYPE_CMYK_8  & ~BLOCK_FORMAT_MASK): return Pack4BytesBlock;
+       case (TYPE_RGB_16  & ~BLOCK_FORMAT_MASK): return Pack3WordsBlock;
+       case (TYPE_CMYK_16 & ~BLOCK_FORMAT_MASK): return Pack4WordsBlock;
+
+       default: return NULL;
+       }
+}
+
+#undef BLOCK_FORMAT_MASK
+
+
 // User formatters for (weird) cases not already included
 
 void LCMSEXPORT cmsSetUserFormatters(cmsHTRANSFORM hTransform, DWORD dwInput,  cmsFORMATTER Input,
@@ -2029,11 +2218,13 @@ void LCMSEXPORT cmsSetUserFormatters(cmsHTRANSFORM hTransform, DWORD dwInput,  c
     
     if (Input != NULL) {
         xform ->FromInput = (_cmsFIXFN) Input;
+        xform ->FromInputBlock = NULL;
         xform ->InputFormat = dwInput;
     }
 
     if (Output != NULL) {
         xform ->ToOutput  = (_cmsFIXFN) Output;
+        xform ->ToOutputBlock = NULL;
         xform ->OutputFormat = dwOutput;
     }
 
@@ -2064,4 +2255,7 @@ void LCMSEXPORT cmsChangeBuffersFormat(cmsHTRANSFORM hTransform,
                         (cmsFORMATTER) _cmsIdentifyInputFormat((_LPcmsTRANSFORM) hTransform, dwInputFormat),
                         dwOutputFormat,
                         (cmsFORMATTER) _cmsIdentifyOutputFormat((_LPcmsTRANSFORM) hTransform, dwOutputFormat));
+
+    ((_LPcmsTRANSFORM) hTransform) ->FromInputBlock = _cmsIdentifyInputBlockFormat((_LPcmsTRANSFORM) hTransform, dwInputFormat);
+    ((_LPcmsTRANSFORM) hTransform) ->ToOutputBlock  = _cmsIdentifyOutputBlockFormat((_LPcmsTRANSFORM) hTransform, dwOutputFormat);
 }
@@ -89,6 +89,10 @@ static icTagSignature Preview[]    = {icSigPreview0Tag,
 
 static volatile double GlobalAdaptationState = 0;
 
+// Worker threads used by cmsDoTransform on large buffers
+
+static volatile int GlobalWorkerThreads = 1;
+
 // --------------------------------Stages--------------------------------------
 
 // Following routines does implement several kind of steps inside 
@@ -322,6 +326,87 @@ void PrecalculatedXFORM(_LPcmsTRANSFORM p,
        }
 }
 
+// Using precalculated 3D grid, a block at time. Pixels are unpacked to a
+// WORD buffer, interpolated in one call and packed back. Runs of identical 
+// pixels reuse the previous result, which replaces the 1-pixel cache.
+
+#define XFORM_BLOCK     256
+
+static
+void PrecalculatedBlockXFORM(_LPcmsTRANSFORM p,
+                             LPVOID in,
+                             LPVOID out, unsigned int Size)
+{
+       register LPBYTE accum;
+       register LPBYTE output;
+       WORD wIn[MAXCHANNELS], wOut[MAXCHANNELS];
+       WORD BlockIn[XFORM_BLOCK * 3], BlockOut[XFORM_BLOCK * MAXCHANNELS];
+       LPL16PARAMS p16 = &p ->DeviceLink ->CLut16params;
+       int nOut = p16 ->nOutputs;
+       unsigned int i, j, n;
+       LPWORD In, Out;
+
+
+       accum  = (LPBYTE) in;
+       output = (LPBYTE) out;
+
+       ZeroMemory(wOut, sizeof(WORD) * MAXCHANNELS);
+
+       for (i=0; i < Size; i += n) {
+
+           n = Size - i;
+           if (n > XFORM_BLOCK) n = XFORM_BLOCK;
+
+           if (p ->FromInputBlock)
+               accum = p ->FromInputBlock(p, BlockIn, accum, n);
+           else 
+               for (j=0; j < n; j++) {
+
+                   accum = p -> FromInput(p, wIn, accum);
+                   CopyMemory(BlockIn + 3*j, wIn, 3 * sizeof(WORD));
+               }
+
+           // Interpolate only the pixels that differ from their left neighbour
+
+           In  = BlockIn;
+           Out = BlockOut;
+           for (j=0; j < n; ) {
+
+               unsigned int Run = 1;
+
+               while ((j + Run < n) && 
+                      ((In[3*Run] != In[3*Run-3]) || (In[3*Run+1] != In[3*Run-2]) || (In[3*Run+2] != In[3*Run-1])))
+                      Run++;
+
+               p16 ->InterpMulti3D(In, Out, Run, p ->DeviceLink ->T, p16);
+
+               In  += 3 * Run;
+               Out += nOut * Run;
+               j   += Run;
+
+               while ((j < n) && (In[0] == In[-3]) && (In[1] == In[-2]) && (In[2] == In[-1])) {
+
+                   CopyMemory(Out, Out - nOut, nOut * sizeof(WORD));
+                   In  += 3;
+                   Out += nOut;
+                   j++;
+               }
+           }
+
+           if (p ->ToOutputBlock)
+               output = p ->ToOutputBlock(p, BlockOut, output, n);
+           else 
+               for (j=0; j < n; j++) {
+
+                   CopyMemory(wOut, BlockOut + nOut*j, nOut * sizeof(WORD));
+                   output = p -> ToOutput(p, wOut, output);
+               }
+       }
+}
+
+#undef XFORM_BLOCK
+
+
 // Auxiliar: Handle precalculated gamut check
 
 static
@@ -1086,6 +1171,16 @@ void SetPrecalculatedTransform(_LPcmsTRANSFORM p)
             cmsEvalLUT(p ->DeviceLink, p->CacheIn, p ->CacheOut);        
             p ->xform = CachedXFORM;        
         }
+
+        // Plain 3D grids on 3 channels can go a block at time
+
+        if (p ->DeviceLink ->wFlags == LUT_HAS3DGRID &&
+            p ->DeviceLink ->CLut16params.nInputs == 3 &&
+            p ->DeviceLink ->CLut16params.InterpMulti3D != NULL &&
+            T_CHANNELS(p ->InputFormat) == 3) {
+
+            p ->xform = PrecalculatedBlockXFORM;
+        }
     }
 }
 
@@ -1137,6 +1232,7 @@ cmsHPROFILE CreateDeviceLinkTransform(_LPcmsTRANSFORM p)
         p ->EntryColorSpace == icSigCmyData) {
                    
                     p->DeviceLink -> CLut16params.Interp3D = cmsTetrahedralInterp16;
+                    p->DeviceLink -> CLut16params.InterpMulti3D = cmsTetrahedralInterp16Multi;
     }
                
     // Precalculated device-link profile is ready
@@ -1590,6 +1686,9 @@ cmsHTRANSFORM LCMSEXPORT cmsCreateProofingTransform(cmsHPROFILE InputProfile,
        p -> FromInput = _cmsIdentifyInputFormat(p, InputFormat);
        p -> ToOutput  = _cmsIdentifyOutputFormat(p, OutputFormat);
 
+       p -> FromInputBlock = _cmsIdentifyInputBlockFormat(p, InputFormat);
+       p -> ToOutputBlock  = _cmsIdentifyOutputBlockFormat(p, OutputFormat);
+
 	 
        return p;
 }
@@ -1646,6 +1745,105 @@ void LCMSEXPORT cmsDeleteTransform(cmsHTRANSFORM hTransform)
 }
 
 
+#ifdef USE_PTHREADS
+
+// Bytes to skip in a buffer to advance one pixel. On planar formats,
+// that is a single sample since each plane is StrideIn apart.
+
+static
+size_t PixelSize(DWORD dwFormat)
+{
+       size_t BytesPerSample = T_BYTES(dwFormat);
+
+       if (BytesPerSample == 0) BytesPerSample = sizeof(double);
+
+       if (T_PLANAR(dwFormat)) return BytesPerSample;
+
+       return BytesPerSample * (T_CHANNELS(dwFormat) + T_EXTRA(dwFormat));
+}
+
+
+// Minimum amount of pixels a worker should get
+
+#define MIN_PIXELS_PER_WORKER   (64 * 1024)
+#define MAX_WORKERS             16
+
+typedef struct {
+
+       _LPcmsTRANSFORM p;
+       LPBYTE In, Out;
+       unsigned int Size;
+
+       } XFORMWORKER, FAR* LPXFORMWORKER;
+
+static
+void* TransformWorker(void* Cargo)
+{
+       LPXFORMWORKER w = (LPXFORMWORKER) Cargo;
+
+       w ->p ->xform(w ->p, w ->In, w ->Out, w ->Size);
+       return NULL;
+}
+
+
+// Split the buffer in as many slices as workers. Strides are set for the
+// whole buffer, so planar formats do work as well. Returns FALSE if
+// the buffer is not worth splitting or threads cannot be created.
+
+static
+LCMSBOOL DoTransformThreaded(_LPcmsTRANSFORM p,
+                             LPBYTE InputBuffer,
+                             LPBYTE OutputBuffer, unsigned int Size)
+{
+       XFORMWORKER Workers[MAX_WORKERS];
+       pthread_t Threads[MAX_WORKERS];
+       unsigned int nWorkers, Slice, Start, i, nStarted;
+       size_t InSize, OutSize;
+
+       nWorkers = (unsigned int) GlobalWorkerThreads;
+       if (nWorkers > MAX_WORKERS) nWorkers = MAX_WORKERS;
+       if (Size / MIN_PIXELS_PER_WORKER < nWorkers) 
+              nWorkers = Size / MIN_PIXELS_PER_WORKER;
+
+       if (nWorkers <= 1) return FALSE;
+
+       InSize  = PixelSize(p ->InputFormat);
+       OutSize = PixelSize(p ->OutputFormat);
+       Slice   = Size / nWorkers;
+
+       for (i=0, Start=0; i < nWorkers; i++, Start += Slice) {
+
+              Workers[i].p    = p;
+              Workers[i].In   = InputBuffer  + Start * InSize;
+              Workers[i].Out  = OutputBuffer + Start * OutSize;
+              Workers[i].Size = (i == nWorkers - 1) ? Size - Start : Slice;
+       }
+
+       // First slice goes on the calling thread 
+
+       for (nStarted = 1; nStarted < nWorkers; nStarted++) 
+              if (pthread_create(&Threads[nStarted], NULL, TransformWorker, &Workers[nStarted]) != 0) 
+                     break;
+
+       TransformWorker(&Workers[0]);
+
+       // Whatever could not be started runs here as well
+
+       for (i = nStarted; i < nWorkers; i++) 
+              TransformWorker(&Workers[i]);
+
+       for (i = 1; i < nStarted; i++) 
+              pthread_join(Threads[i], NULL);
+
+       return TRUE;
+}
+
+#undef MIN_PIXELS_PER_WORKER
+#undef MAX_WORKERS
+
+#endif
+
+
 // Apply transform code
 void LCMSEXPORT cmsDoTransform(cmsHTRANSFORM Transform,
                     LPVOID InputBuffer,
@@ -1656,6 +1854,12 @@ void LCMSEXPORT cmsDoTransform(cmsHTRANSFORM Transform,
             _LPcmsTRANSFORM p = (_LPcmsTRANSFORM) (LPSTR) Transform;
 
             p -> StrideIn = p -> StrideOut = Size;
+
+#ifdef USE_PTHREADS
+            if (GlobalWorkerThreads > 1 &&
+                DoTransformThreaded(p, (LPBYTE) InputBuffer, (LPBYTE) OutputBuffer, Size))
+                    return;
+#endif
             
             p -> xform(p, InputBuffer, OutputBuffer, Size);
 
@@ -1979,6 +2183,7 @@ cmsHTRANSFORM LCMSEXPORT cmsCreateMultiprofileTransform(cmsHPROFILE hProfiles[],
         p ->EntryColorSpace == icSigCmyData) {
                    
                     p->DeviceLink -> CLut16params.Interp3D = cmsTetrahedralInterp16;
+                    p->DeviceLink -> CLut16params.InterpMulti3D = cmsTetrahedralInterp16Multi;
     }
 	
 
@@ -2008,3 +2213,16 @@ double LCMSEXPORT cmsSetAdaptationState(double d)
     return OldVal;
     
 }
+
+
+// Only meaningful if compiled with USE_PTHREADS. Negative values just query.
+
+int LCMSEXPORT cmsSetWorkerThreads(int n)
+{
+    int OldVal = GlobalWorkerThreads;
+
+    if (n > 0) 
+            GlobalWorkerThreads = n;
+
+    return OldVal;
+}
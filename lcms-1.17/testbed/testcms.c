@@ -1939,6 +1939,75 @@ void SpeedTest2(void)
 
 }
 
+
+// Block transforms on common layouts, MPixel/s
+
+static
+double WallClock(void)
+{
+#ifdef USE_PTHREADS
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1.0e9;
+#else
+    return (double) clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+static
+void SpeedTestFormat(const char* Name, DWORD dwIn, int InBytes, DWORD dwOut, int OutBytes, int nThreads)
+{
+    cmsHPROFILE hlcmsProfileIn, hlcmsProfileOut;
+    cmsHTRANSFORM hlcmsxform;
+    LPBYTE In, Out;
+    unsigned int i, Size = 256*256*256;
+    double seconds;
+
+    hlcmsProfileIn  = cmsOpenProfileFromFile("sRGB Color Space Profile.icm", "r");
+    hlcmsProfileOut = cmsOpenProfileFromFile("sRGBSpac.icm", "r");
+
+    hlcmsxform  = cmsCreateTransform(hlcmsProfileIn, dwIn, hlcmsProfileOut, dwOut, INTENT_PERCEPTUAL, 0);
+
+    In  = (LPBYTE) _cmsMalloc(Size * InBytes);
+    Out = (LPBYTE) _cmsMalloc(Size * OutBytes);
+
+    for (i=0; i < Size * InBytes; i++)
+        In[i] = (BYTE) (i * 2654435761U >> 24);
+
+    cmsSetWorkerThreads(nThreads);
+
+    printf("%-22s %d thread(s)...", Name, nThreads);
+
+    seconds = WallClock();
+    cmsDoTransform(hlcmsxform, In, Out, Size);
+    seconds = WallClock() - seconds;
+
+    printf("%g MPixel/s\n", Size / (1024.0 * 1024.0 * seconds));
+
+    cmsSetWorkerThreads(1);
+    _cmsFree(In);
+    _cmsFree(Out);
+    cmsDeleteTransform(hlcmsxform);
+    cmsCloseProfile(hlcmsProfileIn);
+    cmsCloseProfile(hlcmsProfileOut);
+}
+
+static
+void SpeedTest3(void)
+{
+    int nThreads;
+
+    printf("\nBlock transforms:\n");
+
+    for (nThreads = 1; nThreads <= 4; nThreads *= 2) {
+
+        SpeedTestFormat("RGB 8 -> RGB 8",     TYPE_RGB_8,  3, TYPE_RGB_8,  3, nThreads);
+        SpeedTestFormat("BGR 8 -> RGBA 8",    TYPE_BGR_8,  3, TYPE_RGBA_8, 4, nThreads);
+        SpeedTestFormat("RGB 16 -> RGB 16",   TYPE_RGB_16, 6, TYPE_RGB_16, 6, nThreads);
+    }
+}
+
 #endif
 
 
@@ -2122,6 +2191,75 @@ int TestColorantTableTag()
 
 }
 
+// Block interpolation must give same results as pixel-by-pixel one
+
+static
+int RandomSampler(register WORD In[], register WORD Out[], register LPVOID Cargo)
+{
+    int i;
+
+    for (i=0; i < 4; i++)
+        Out[i] = (WORD) ((In[0] * 7 + In[1] * 3 + In[2] + rand()) & 0xFFFF);
+
+    return TRUE;
+}
+
+static
+int CheckBlockInterp(LPLUT Lut, int nOutputs, LCMSBOOL lUseTetrahedral)
+{
+    WORD In[256 * 3], Out[256 * 4], OutBlk[256 * 4];
+    LPL16PARAMS p = &Lut ->CLut16params;
+    int i, j, n;
+
+    cmsCalcCLUT16ParamsEx(p ->nSamples, 3, nOutputs, lUseTetrahedral, p);
+
+    for (n=0; n < 256; n++) {
+
+        for (i=0; i < 256 * 3; i++)
+            In[i] = (WORD) ((i & 15) == 0 ? 0xFFFF : rand() & 0xFFFF);
+
+        for (i=0; i < 256; i++)
+            p ->Interp3D(In + i * 3, Out + i * nOutputs, Lut ->T, p);
+
+        p ->InterpMulti3D(In, OutBlk, 256, Lut ->T, p);
+
+        for (j=0; j < 256 * nOutputs; j++) {
+
+            if (Out[j] != OutBlk[j]) {
+                printf("Failed! (%s %d) \n", lUseTetrahedral ? "tetrahedral" : "trilinear", nOutputs);
+                return 0;
+            }
+        }
+    }
+
+    return 1;
+}
+
+static
+int TestBlockInterpolation(void)
+{
+    LPLUT Lut;
+    int nOutputs, rc = 1;
+
+    printf("Testing block interpolation ...");
+
+    for (nOutputs = 3; nOutputs <= 4 && rc; nOutputs++) {
+
+        Lut = cmsAllocLUT();
+        cmsAlloc3DGrid(Lut, 33, 3, nOutputs);
+        cmsSample3DGrid(Lut, RandomSampler, NULL, 0);
+
+        rc = CheckBlockInterp(Lut, nOutputs, TRUE) && 
+             CheckBlockInterp(Lut, nOutputs, FALSE);
+
+        cmsFreeLUT(Lut);
+    }
+
+    if (rc) printf("pass.\n");
+    return rc;
+}
+
+
 // New to 1.13 -- CGATS/IT8.7
 
 
@@ -2346,6 +2484,7 @@ int main(int argc, char *argv[])
 	  
 
        if (!TestInkLimiting()) return 1;
+       if (!TestBlockInterpolation()) return 1;
        if (!TestSaveToMem()) return 1;
        if (!TestNamedColor()) return 1;  
        if (!TestIT8()) return 1;
@@ -2362,6 +2501,7 @@ int main(int argc, char *argv[])
 #ifdef CHECK_SPEED    
        SpeedTest();
 	   SpeedTest2();
+       SpeedTest3();
 #endif
 
        printf("\nSuccess.\n");